@@ -0,0 +1,83 @@
+/**
+ * \file benchmark_filters.cpp
+ *
+ * Time the filters propagation, update and stacked update steps.
+ */
+
+#include "benchmark_models.h"
+
+using namespace kalmanif;
+using namespace kalmanif::benchmark;
+
+template <typename Filter>
+static void BM_Propagate(::benchmark::State& state) {
+  const Models<Filter> models;
+  Filter filter = models.makeFilter();
+
+  for (auto _ : state) {
+    models.propagate(filter);
+    ::benchmark::DoNotOptimize(filter.getState());
+  }
+}
+
+template <typename Filter>
+static void BM_Update(::benchmark::State& state) {
+  const Models<Filter> models;
+  Filter filter = models.makeFilter();
+
+  for (auto _ : state) {
+    models.update(filter, 0);
+    ::benchmark::DoNotOptimize(filter.getState());
+  }
+}
+
+template <typename Filter>
+static void BM_StackedUpdate(::benchmark::State& state) {
+  using Model = Models<Filter>;
+  using MeasurementModel = typename Model::MeasurementModel;
+
+  const Model models;
+  Filter filter = models.makeFilter();
+
+  const std::array<MeasurementModel, Model::NumLandmarks> measurement_models{{
+    models.measurement_models[0],
+    models.measurement_models[1],
+    models.measurement_models[2]
+  }};
+
+  for (auto _ : state) {
+    filter.update(measurement_models, models.measurements);
+    ::benchmark::DoNotOptimize(filter.getState());
+  }
+}
+
+template <typename Filter>
+static void BM_Step(::benchmark::State& state) {
+  const Models<Filter> models;
+  Filter filter = models.makeFilter();
+
+  for (auto _ : state) {
+    models.step(filter);
+    ::benchmark::DoNotOptimize(filter.getState());
+  }
+}
+
+KALMANIF_BENCHMARK_FILTER(BM_Propagate, ExtendedKalmanFilter);
+KALMANIF_BENCHMARK_FILTER(BM_Propagate, SquareRootExtendedKalmanFilter);
+KALMANIF_BENCHMARK_FILTER(BM_Propagate, InvariantExtendedKalmanFilter);
+KALMANIF_BENCHMARK_FILTER(BM_Propagate, UnscentedKalmanFilterManifolds);
+
+KALMANIF_BENCHMARK_FILTER(BM_Update, ExtendedKalmanFilter);
+KALMANIF_BENCHMARK_FILTER(BM_Update, SquareRootExtendedKalmanFilter);
+KALMANIF_BENCHMARK_FILTER(BM_Update, InvariantExtendedKalmanFilter);
+KALMANIF_BENCHMARK_FILTER(BM_Update, UnscentedKalmanFilterManifolds);
+
+// The UKFM has no stacked update
+KALMANIF_BENCHMARK_FILTER(BM_StackedUpdate, ExtendedKalmanFilter);
+KALMANIF_BENCHMARK_FILTER(BM_StackedUpdate, SquareRootExtendedKalmanFilter);
+KALMANIF_BENCHMARK_FILTER(BM_StackedUpdate, InvariantExtendedKalmanFilter);
+
+KALMANIF_BENCHMARK_FILTER(BM_Step, ExtendedKalmanFilter);
+KALMANIF_BENCHMARK_FILTER(BM_Step, SquareRootExtendedKalmanFilter);
+KALMANIF_BENCHMARK_FILTER(BM_Step, InvariantExtendedKalmanFilter);
+KALMANIF_BENCHMARK_FILTER(BM_Step, UnscentedKalmanFilterManifolds);
@@ -0,0 +1,104 @@
+/**
+ * \file benchmark_kernels.cpp
+ *
+ * Time the closed-form kernels of the small states (SO2, SE2, SO3)
+ * against the generic Eigen decompositions they replace:
+ * the Cholesky decomposition and solve, the inverse
+ * and the eigen-decomposition of 2x2 and 3x3 covariances.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace kalmanif;
+
+namespace {
+
+// A well-conditioned covariance, varied at each iteration
+// so that the kernel is not hoisted out of the loop
+template <typename MatrixType>
+struct Covariances {
+  using Scalar = typename MatrixType::Scalar;
+  using Vector = Eigen::Matrix<Scalar, MatrixType::RowsAtCompileTime, 1>;
+
+  Covariances() {
+    const MatrixType B = MatrixType::Random();
+    A = B * B.transpose() + MatrixType::Identity();
+  }
+
+  const MatrixType& next() {
+    A.diagonal().array() += Scalar(1e-6);
+    return A;
+  }
+
+  MatrixType A;
+  const Vector b = Vector::Random();
+};
+
+} // namespace
+
+template <typename LLT>
+static void BM_LLTSolve(::benchmark::State& state) {
+  using MatrixType = typename LLT::MatrixType;
+  Covariances<MatrixType> covariances;
+
+  for (auto _ : state) {
+    const LLT llt(covariances.next());
+    auto x = llt.solve(covariances.b).eval();
+    ::benchmark::DoNotOptimize(x);
+  }
+}
+
+template <typename LLT>
+static void BM_Inverse(::benchmark::State& state) {
+  using MatrixType = typename LLT::MatrixType;
+  Covariances<MatrixType> covariances;
+
+  for (auto _ : state) {
+    const LLT llt(covariances.next());
+    MatrixType inverse = llt.solve(MatrixType::Identity());
+    ::benchmark::DoNotOptimize(inverse);
+  }
+}
+
+template <typename MatrixType, bool ClosedForm>
+static void BM_Eigen(::benchmark::State& state) {
+  Covariances<MatrixType> covariances;
+  Eigen::SelfAdjointEigenSolver<MatrixType> eigensolver;
+
+  for (auto _ : state) {
+    if constexpr (ClosedForm) {
+      eigensolver.computeDirect(covariances.next());
+    } else {
+      eigensolver.compute(covariances.next());
+    }
+    ::benchmark::DoNotOptimize(eigensolver.eigenvalues());
+  }
+}
+
+/**
+ * @brief Register a kernel benchmark, generic and closed-form,
+ * for 2x2 and 3x3 matrices in single and double precision.
+ */
+#define KALMANIF_BENCHMARK_KERNEL(func)                                   \
+  BENCHMARK_TEMPLATE(func, Eigen::LLT<Eigen::Matrix2f>);                 \
+  BENCHMARK_TEMPLATE(func, internal::ClosedFormLLT<Eigen::Matrix2f>);    \
+  BENCHMARK_TEMPLATE(func, Eigen::LLT<Eigen::Matrix2d>);                 \
+  BENCHMARK_TEMPLATE(func, internal::ClosedFormLLT<Eigen::Matrix2d>);    \
+  BENCHMARK_TEMPLATE(func, Eigen::LLT<Eigen::Matrix3f>);                 \
+  BENCHMARK_TEMPLATE(func, internal::ClosedFormLLT<Eigen::Matrix3f>);    \
+  BENCHMARK_TEMPLATE(func, Eigen::LLT<Eigen::Matrix3d>);                 \
+  BENCHMARK_TEMPLATE(func, internal::ClosedFormLLT<Eigen::Matrix3d>)
+
+KALMANIF_BENCHMARK_KERNEL(BM_LLTSolve);
+KALMANIF_BENCHMARK_KERNEL(BM_Inverse);
+
+BENCHMARK_TEMPLATE(BM_Eigen, Eigen::Matrix2f, false);
+BENCHMARK_TEMPLATE(BM_Eigen, Eigen::Matrix2f, true);
+BENCHMARK_TEMPLATE(BM_Eigen, Eigen::Matrix2d, false);
+BENCHMARK_TEMPLATE(BM_Eigen, Eigen::Matrix2d, true);
+BENCHMARK_TEMPLATE(BM_Eigen, Eigen::Matrix3f, false);
+BENCHMARK_TEMPLATE(BM_Eigen, Eigen::Matrix3f, true);
+BENCHMARK_TEMPLATE(BM_Eigen, Eigen::Matrix3d, false);
+BENCHMARK_TEMPLATE(BM_Eigen, Eigen::Matrix3d, true);
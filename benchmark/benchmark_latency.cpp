@@ -0,0 +1,74 @@
+/**
+ * \file benchmark_latency.cpp
+ *
+ * Measure the worst-case latency of the filters steps in real-time mode,
+ * see KALMANIF_REALTIME. Each step, a propagation and an update
+ * per landmark, is timed individually and the maximum and 99.9th
+ * percentile latencies are reported as counters, in nanoseconds.
+ */
+
+#include "benchmark_models.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace kalmanif;
+using namespace kalmanif::benchmark;
+
+#ifndef KALMANIF_REALTIME
+#error "The latency benchmarks must be built in real-time mode."
+#endif
+
+template <typename Filter>
+static void BM_StepLatency(::benchmark::State& state) {
+  using Clock = std::chrono::steady_clock;
+
+  const Models<Filter> models;
+  Filter filter = models.makeFilter();
+
+  // Reserved ahead so that recording a sample does not allocate
+  std::vector<double> latencies;
+  latencies.reserve(std::size_t(state.max_iterations));
+
+  clearLastError();
+
+  for (auto _ : state) {
+    const auto start = Clock::now();
+    models.step(filter);
+    const auto end = Clock::now();
+
+    ::benchmark::DoNotOptimize(filter.getState());
+    latencies.push_back(
+      std::chrono::duration<double, std::nano>(end - start).count()
+    );
+  }
+
+  if (getLastError()) {
+    state.SkipWithError(getLastError().what);
+    return;
+  }
+
+  if (latencies.empty()) {
+    return;
+  }
+
+  const auto p999 = latencies.begin() + std::ptrdiff_t(
+    std::ceil(0.999 * double(latencies.size())) - 1
+  );
+  std::nth_element(latencies.begin(), p999, latencies.end());
+
+  state.counters["p99.9_ns"] = *p999;
+  state.counters["max_ns"] = *std::max_element(p999, latencies.end());
+}
+
+// Enough steps for a meaningful 99.9th percentile
+#define KALMANIF_BENCHMARK_LATENCY(Filter)                 \
+  KALMANIF_BENCHMARK_FILTER_OPTIONS(                       \
+    BM_StepLatency, Filter, ->Iterations(100000)           \
+  )
+
+KALMANIF_BENCHMARK_LATENCY(ExtendedKalmanFilter);
+KALMANIF_BENCHMARK_LATENCY(SquareRootExtendedKalmanFilter);
+KALMANIF_BENCHMARK_LATENCY(InvariantExtendedKalmanFilter);
+KALMANIF_BENCHMARK_LATENCY(UnscentedKalmanFilterManifolds);
@@ -0,0 +1,117 @@
+#ifndef _KALMANIF_BENCHMARK_BENCHMARK_MODELS_H_
+#define _KALMANIF_BENCHMARK_BENCHMARK_MODELS_H_
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/SE3.h>
+#include <manif/SE_2_3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <vector>
+
+namespace kalmanif {
+namespace benchmark {
+
+/**
+ * @brief The system and measurement models of the benchmarks
+ * for a given filter, a random walk observing a few landmarks.
+ *
+ * @tparam Filter The filter type
+ */
+template <typename Filter>
+struct Models {
+
+  using State = typename Filter::State;
+  using Scalar = typename State::Scalar;
+  using StateCovariance = Covariance<State>;
+  using SystemModel = LieSystemModel<State>;
+  using Control = typename SystemModel::Control;
+  using MeasurementModel = std::conditional_t<
+    State::Dim == 2,
+    Landmark2DMeasurementModel<State>,
+    Landmark3DMeasurementModel<State>
+  >;
+  using Landmark = typename MeasurementModel::Landmark;
+  using Measurement = typename MeasurementModel::Measurement;
+
+  static constexpr bool Invariant =
+    std::is_same<Filter, InvariantExtendedKalmanFilter<State>>::value;
+
+  static constexpr std::size_t NumLandmarks = 3;
+
+  Models() {
+    for (std::size_t i = 0; i < NumLandmarks; ++i) {
+      measurement_models.emplace_back(Landmark::Random() * Scalar(5), R);
+      measurements[i] = measurement_models[i](X_true);
+    }
+  }
+
+  //! A filter at its initial state
+  Filter makeFilter() const {
+    return Filter(State::Identity(), StateCovariance::Identity() * Scalar(0.1));
+  }
+
+  template <typename F>
+  void propagate(F& filter) const {
+    if constexpr (Invariant) {
+      filter.propagate(system_model, u, dt);
+    } else {
+      filter.propagate(system_model, u);
+    }
+  }
+
+  //! Update with the measurement of the i-th landmark
+  template <typename F>
+  void update(F& filter, const std::size_t i) const {
+    filter.update(measurement_models[i], measurements[i]);
+  }
+
+  //! One step, a propagation and an update per landmark
+  template <typename F>
+  void step(F& filter) const {
+    propagate(filter);
+    for (std::size_t i = 0; i < NumLandmarks; ++i) {
+      update(filter, i);
+    }
+  }
+
+  const Scalar dt = Scalar(0.01);
+
+  const SystemModel system_model{StateCovariance::Identity() * Scalar(1e-4)};
+  const Control u = Control::Random() * Scalar(0.01);
+
+  Covariance<Measurement> R =
+    Covariance<Measurement>::Identity() * Scalar(1e-2);
+  const State X_true = State::Random();
+
+  std::vector<MeasurementModel> measurement_models;
+  std::array<Measurement, NumLandmarks> measurements;
+};
+
+} // namespace benchmark
+} // namespace kalmanif
+
+/**
+ * @brief Register a benchmark for a filter on SE2, SE3 and SE_2_3
+ * in single and double precision, with the given benchmark options,
+ * e.g. '->Arg(100)'.
+ */
+#define KALMANIF_BENCHMARK_FILTER_OPTIONS(func, Filter, options)   \
+  BENCHMARK_TEMPLATE(func, Filter<manif::SE2f>) options;           \
+  BENCHMARK_TEMPLATE(func, Filter<manif::SE2d>) options;           \
+  BENCHMARK_TEMPLATE(func, Filter<manif::SE3f>) options;           \
+  BENCHMARK_TEMPLATE(func, Filter<manif::SE3d>) options;           \
+  BENCHMARK_TEMPLATE(func, Filter<manif::SE_2_3f>) options;        \
+  BENCHMARK_TEMPLATE(func, Filter<manif::SE_2_3d>) options
+
+/**
+ * @brief Register a benchmark for a filter on SE2, SE3 and SE_2_3
+ * in single and double precision.
+ */
+#define KALMANIF_BENCHMARK_FILTER(func, Filter) \
+  KALMANIF_BENCHMARK_FILTER_OPTIONS(func, Filter, )
+
+#endif // _KALMANIF_BENCHMARK_BENCHMARK_MODELS_H_
@@ -0,0 +1,128 @@
+/**
+ * \file benchmark_smoothers.cpp
+ *
+ * Time the Rauch-Tung-Striebel smoothers over a fixed number of epochs,
+ * and the memory saved by the compressed storages vs their accuracy.
+ */
+
+#include "benchmark_models.h"
+
+using namespace kalmanif;
+using namespace kalmanif::benchmark;
+
+template <typename Filter>
+static void BM_Smooth(::benchmark::State& state) {
+  const Models<Filter> models;
+  RauchTungStriebelSmoother<Filter> smoother(
+    models.makeFilter().getState(), models.makeFilter().getCovariance()
+  );
+
+  const int epochs = int(state.range(0));
+  smoother.reserve(epochs);
+  for (int k = 0; k < epochs; ++k) {
+    models.step(smoother);
+  }
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(smoother.smooth().data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * epochs);
+}
+
+template <typename Filter>
+static void BM_SmoothParallel(::benchmark::State& state) {
+  const Models<Filter> models;
+  ParallelRauchTungStriebelSmoother<Filter> smoother(
+    models.makeFilter().getState(), models.makeFilter().getCovariance()
+  );
+
+  const int epochs = int(state.range(0));
+  for (int k = 0; k < epochs; ++k) {
+    models.step(smoother);
+  }
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(smoother.smooth().data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * epochs);
+}
+
+/**
+ * Smooth with compressed covariances, reporting the memory of an epoch
+ * and of a smoothed estimate and the largest errors of the smoothed
+ * sequence w.r.t. the uncompressed smoother.
+ */
+template <typename Codec>
+static void BM_SmoothCompressed(::benchmark::State& state) {
+  using Filter = ExtendedKalmanFilter<manif::SE_2_3d>;
+  using State = Filter::State;
+  using Storage = CompressedStorage<Codec::value>;
+
+  const Models<Filter> models;
+  RauchTungStriebelSmoother<Filter> reference(
+    models.makeFilter().getState(), models.makeFilter().getCovariance()
+  );
+  RauchTungStriebelSmoother<Filter, Storage> smoother(
+    models.makeFilter().getState(), models.makeFilter().getCovariance()
+  );
+
+  const int epochs = int(state.range(0));
+  smoother.reserve(epochs);
+  for (int k = 0; k < epochs; ++k) {
+    models.step(reference);
+    models.step(smoother);
+  }
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(smoother.smooth().data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * epochs);
+
+  const auto& Xs = reference.smooth();
+  double state_error = 0, covariance_error = 0;
+  for (std::size_t k = 0; k < Xs.size(); ++k) {
+    const Covariance<State>& P = reference.getCovariances()[k];
+    state_error = std::max(
+      state_error, double((smoother.getStates()[k] - Xs[k]).coeffs().norm())
+    );
+    covariance_error = std::max(
+      covariance_error,
+      double(
+        (smoother.getCovariances()[k].unpack() - P).norm() / P.norm()
+      )
+    );
+  }
+
+  using Epoch = internal::SmootherEpoch<
+    State, typename Storage::template covariance<State>
+  >;
+  state.counters["epoch_bytes"] = double(sizeof(Epoch));
+  state.counters["dense_epoch_bytes"] =
+    double(sizeof(internal::SmootherEpoch<State>));
+  state.counters["state_error"] = state_error;
+  state.counters["covariance_rel_error"] = covariance_error;
+}
+
+template <CovarianceCodec Codec>
+using codec_t = std::integral_constant<CovarianceCodec, Codec>;
+
+BENCHMARK_TEMPLATE(BM_SmoothCompressed, codec_t<CovarianceCodec::Float>)
+  ->Arg(1000);
+BENCHMARK_TEMPLATE(BM_SmoothCompressed, codec_t<CovarianceCodec::Cholesky>)
+  ->Arg(1000);
+BENCHMARK_TEMPLATE(BM_SmoothCompressed, codec_t<CovarianceCodec::Cholesky16>)
+  ->Arg(1000);
+
+#define KALMANIF_BENCHMARK_SMOOTHER(func, Filter) \
+  KALMANIF_BENCHMARK_FILTER_OPTIONS(func, Filter, ->Arg(100)->Arg(1000))
+
+// ERTS / SERTS / IERTS / URTS-M
+KALMANIF_BENCHMARK_SMOOTHER(BM_Smooth, ExtendedKalmanFilter);
+KALMANIF_BENCHMARK_SMOOTHER(BM_Smooth, SquareRootExtendedKalmanFilter);
+KALMANIF_BENCHMARK_SMOOTHER(BM_Smooth, InvariantExtendedKalmanFilter);
+KALMANIF_BENCHMARK_SMOOTHER(BM_Smooth, UnscentedKalmanFilterManifolds);
+
+KALMANIF_BENCHMARK_SMOOTHER(BM_SmoothParallel, ExtendedKalmanFilter);
@@ -245,7 +245,7 @@ int main (int argc, char* argv[]) {
 
     /// then we measure all landmarks - - - - - - - - - - - - - - - - - - - -
     for (std::size_t i = 0; i < measurement_models.size(); ++i) {
-      auto measurement_model = measurement_models[i];
+      const auto& measurement_model = measurement_models[i];
 
       y = measurement_model(X_simulation);            // landmark measurement, before adding noise
 
@@ -284,7 +284,7 @@ int main (int argc, char* argv[]) {
       // for (std::size_t i = 0; i < measurement_models.size(); ++i) {
 
       //   // landmark
-      //   auto measurement_model = measurement_models[i];
+      //   const auto& measurement_model = measurement_models[i];
 
       //   // measurement
       //   y = measurements[i];
@@ -0,0 +1,265 @@
+/**
+ * \file monte_carlo_se2.cpp
+ *
+ *  ---------------------------------------------------------
+ *  Monte-Carlo evaluation of the filters on the demo_se2 scenario:
+ *
+ *  2D Robot localization based on fixed beacons and gps.
+ *
+ *  See demo_se2.cpp for the description of the scenario.
+ *  ---------------------------------------------------------
+ *
+ *  M independent trials are run in parallel, each with its own
+ *  random generator seeded deterministically from the trial index,
+ *  so that a trial can be reproduced on its own.
+ *  The noise of a whole trial is drawn at once before it is run.
+ *
+ *  The metrics of each trial (RMSE, ATE, AOE and the average NEES)
+ *  are accumulated along the trajectory, and their mean and
+ *  standard deviation over the trials are aggregated incrementally,
+ *  so that the memory used does not depend on the number of trials
+ *  nor on their length.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include "utils/rand.h"
+#include "utils/monte_carlo.h"
+#include "utils/utils.h"
+
+#include <manif/SE2.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+using GPSMeasurementModel = DummyGPSMeasurementModel<State>;
+
+// Filters
+using EKF = ExtendedKalmanFilter<State>;
+using SEKF = SquareRootExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+using UKFM = UnscentedKalmanFilterManifolds<State>;
+
+namespace {
+
+void show_usage(const std::string& name) {
+  std::cerr << "Usage: " << name << " <option(s)>\n"
+            << "E.g. " << name << " -n 1000 -j 8\n"
+            << "Options:\n"
+            << "\t-h, --help\t\tShow this helper\n"
+            << "\t-n, --trials N\t\tNumber of trials (default 100)\n"
+            << "\t-s, --seed SEED\t\tSeed of the first trial (default 0)\n"
+            << "\t-j, --jobs J\t\tNumber of threads (default all cores)\n"
+            << "\t-d, --duration T\tDuration of a trial in s (default 30)"
+            << std::endl;
+}
+
+/**
+ * @brief Run a trial of the demo_se2 scenario
+ * and add its metrics to the statistics.
+ *
+ * @param seed The seed of the trial
+ * @param eot The duration of the trial
+ * @param statistics The statistics to add the trial to
+ */
+void trial(
+  const std::uint64_t seed, const double eot, MonteCarloStatistics& statistics
+) {
+  Xoshiro256 generator(seed);
+
+  // START CONFIGURATION
+
+  constexpr double dt = 0.01;                 // s
+  const double sqrtdt = std::sqrt(dt);
+
+  constexpr double var_gyro = 1e-3;           // (rad/s)^2
+  constexpr double var_wheel_odometry = 9e-5; // (m/s)^2
+  constexpr double var_gps = 6e-3;
+
+  State X_simulation = State::Identity();
+
+  Control u_simu, u_est;
+  Eigen::Vector3d u_nom = Eigen::Vector3d::Zero(), u_noisy;
+  Eigen::Array3d u_sigmas;
+  u_sigmas << std::sqrt(var_wheel_odometry), std::sqrt(var_wheel_odometry), std::sqrt(var_gyro);
+  const Eigen::Matrix3d U = (u_sigmas * u_sigmas * 1./dt).matrix().asDiagonal();
+
+  const Eigen::Array2d y_sigmas(0.01, 0.01);
+  Eigen::Matrix2d R = (y_sigmas * y_sigmas).matrix().asDiagonal();
+
+  const std::vector<MeasurementModel> measurement_models = {
+    MeasurementModel(Landmark(2.0,  0.0), R),
+    MeasurementModel(Landmark(2.0,  1.0), R),
+    MeasurementModel(Landmark(2.0, -1.0), R)
+  };
+  std::vector<Measurement> measurements(measurement_models.size());
+
+  const Eigen::Array2d y_gps_sigmas(std::sqrt(var_gps), std::sqrt(var_gps));
+  Eigen::Matrix2d R_gps = (y_gps_sigmas * y_gps_sigmas).matrix().asDiagonal();
+  const GPSMeasurementModel gps_measurement_model(R_gps);
+
+  SystemModel system_model;
+  system_model.setCovariance(U);
+
+  StateCovariance state_cov_init = StateCovariance::Zero();
+  state_cov_init(0, 0) = 1;
+  state_cov_init(1, 1) = 1;
+  state_cov_init(2, 2) = MANIF_PI_4;
+
+  const Eigen::Vector3d X_init_coeffs =
+    state_cov_init.cwiseSqrt() * randn<Eigen::Array3d>(
+      Eigen::Array3d::Ones(), generator
+    ).matrix();
+  const State X_init(X_init_coeffs(0), X_init_coeffs(1), X_init_coeffs(2));
+
+  EKF ekf(X_init, state_cov_init);
+  SEKF sekf(X_init, state_cov_init);
+  IEKF iekf(X_init, state_cov_init);
+  UKFM ukfm(X_init, state_cov_init);
+
+  TrajectoryMetrics<State> m_ekf, m_sekf, m_iekf, m_ukfm;
+
+  // END CONFIGURATION
+
+  // Draw the noise of the whole trial at once,
+  // one column per time step
+  const Eigen::Index steps = Eigen::Index(std::ceil(eot / dt));
+
+  Eigen::Array3Xd u_noise(3, steps);
+  Eigen::Array2Xd y_noise(2, steps * Eigen::Index(measurement_models.size()));
+  Eigen::Array2Xd y_gps_noise(2, steps);
+
+  fillRandn(u_noise, generator);
+  fillRandn(y_noise, generator);
+  fillRandn(y_gps_noise, generator);
+
+  u_noise.colwise() *= u_sigmas / sqrtdt;
+  y_noise.colwise() *= y_sigmas;
+  y_gps_noise.colwise() *= y_gps_sigmas;
+
+  for (Eigen::Index k = 0; k < steps; ++k) {
+    const double t = double(k) * dt;
+
+    //// I. Simulation
+
+    u_noisy = u_nom + u_noise.col(k).matrix();
+
+    u_simu = u_nom * dt;
+    u_est  = u_noisy * dt;
+
+    X_simulation = system_model(X_simulation, u_simu);
+
+    for (std::size_t i = 0; i < measurement_models.size(); ++i) {
+      measurements[i] = measurement_models[i](X_simulation) +
+        y_noise.col(k * Eigen::Index(measurement_models.size()) + Eigen::Index(i)).matrix();
+    }
+
+    const Eigen::Vector2d y_gps = gps_measurement_model(X_simulation) +
+      y_gps_noise.col(k).matrix();
+
+    //// II. Estimation
+
+    ekf.propagate(system_model, u_est);
+    sekf.propagate(system_model, u_est);
+    iekf.propagate(system_model, u_est, dt);
+    ukfm.propagate(system_model, u_est);
+
+    for (std::size_t i = 0; i < measurement_models.size(); ++i) {
+      ekf.update(measurement_models[i], measurements[i]);
+      sekf.update(measurement_models[i], measurements[i]);
+      iekf.update(measurement_models[i], measurements[i]);
+      ukfm.update(measurement_models[i], measurements[i]);
+    }
+
+    ekf.update(gps_measurement_model, y_gps);
+    sekf.update(gps_measurement_model, y_gps);
+    iekf.update(gps_measurement_model, y_gps);
+    ukfm.update(gps_measurement_model, y_gps);
+
+    //// III. Next iteration
+
+    u_nom << 0.1 * std::cos(t) + 10.0,
+             0.0,
+             std::exp(-0.03 * (t)) * std::cos(t);
+
+    //// IV. Results
+
+    m_ekf.collect(X_simulation, ekf, t);
+    m_sekf.collect(X_simulation, sekf, t);
+    m_iekf.collect(X_simulation, iekf, t);
+    m_ukfm.collect(X_simulation, ukfm, t);
+  }
+
+  statistics.add("EKF", m_ekf);
+  statistics.add("SEKF", m_sekf);
+  statistics.add("IEKF", m_iekf);
+  statistics.add("UKFM", m_ukfm);
+}
+
+} // namespace
+
+int main (int argc, char* argv[]) {
+
+  int trials = 100;
+  std::uint64_t seed = 0;
+  unsigned int jobs = std::thread::hardware_concurrency();
+  double eot = 30;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if ((arg == "-h") || (arg == "--help")) {
+      show_usage(argv[0]);
+      return EXIT_SUCCESS;
+    } else if ((arg == "-q") || (arg == "--quiet")) {
+      // nothing is printed per trial anyway
+    } else if (i + 1 >= argc) {
+      std::cerr << "Option '" << arg << "' requires one argument.\n";
+      return EXIT_FAILURE;
+    } else if ((arg == "-n") || (arg == "--trials")) {
+      trials = std::stoi(argv[++i]);
+    } else if ((arg == "-s") || (arg == "--seed")) {
+      seed = std::stoull(argv[++i]);
+    } else if ((arg == "-j") || (arg == "--jobs")) {
+      jobs = unsigned(std::stoul(argv[++i]));
+    } else if ((arg == "-d") || (arg == "--duration")) {
+      eot = std::stod(argv[++i]);
+    } else {
+      std::cerr << "Unknow option '" << argv[i] << "'.\n";
+    }
+  }
+
+  KALMANIF_DEMO_PRETTY_PRINT();
+
+  MonteCarloStatistics statistics;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  // The trials are independent, spread them over the threads
+  ThreadPoolExecutor executor(jobs);
+  executor(trials, [&](const int i) {
+    trial(seed + std::uint64_t(i), eot, statistics);
+  });
+
+  const std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+
+  std::cout << trials << " trials on " << executor.size() << " threads in "
+            << elapsed.count() << "s\n\n";
+
+  statistics.print();
+
+  return EXIT_SUCCESS;
+}
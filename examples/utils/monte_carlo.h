@@ -0,0 +1,68 @@
+#ifndef _KALMANIF_EXAMPLES_UTILS_MONTE_CARLO_H_
+#define _KALMANIF_EXAMPLES_UTILS_MONTE_CARLO_H_
+
+#include <kalmanif/metrics.h>
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace kalmanif {
+
+/**
+ * @brief The statistics over the trials, per filter.
+ *
+ * Trials may be added concurrently. Only the running statistics
+ * are kept, so that the memory does not grow with the number of trials.
+ */
+struct MonteCarloStatistics {
+
+  struct Metrics {
+    RunningStatistics rmse, ate, aoe, nees;
+  };
+
+  template <typename LieGroup>
+  void add(const std::string& filter, const TrajectoryMetrics<LieGroup>& trial) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Metrics& m = metrics_[filter];
+    m.rmse.add(trial.rmse());
+    m.ate.add(trial.ate());
+    m.aoe.add(trial.aoe());
+    m.nees.add(trial.nees());
+  }
+
+  void print() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::cout << "\tRMSE\t\t\tATE\t\t\tAOE\t\t\tNEES\n";
+
+    const auto print = [](const RunningStatistics& s) {
+      std::cout << s.mean << " +- " << s.stddev() << "\t";
+    };
+
+    for (const auto& f : metrics_) {
+      std::cout << f.first << "\t";
+      print(f.second.rmse);
+      print(f.second.ate);
+      print(f.second.aoe);
+      print(f.second.nees);
+      std::cout << "\n";
+    }
+    std::cout << "\n----------------------------------\n";
+  }
+
+  const std::map<std::string, Metrics>& metrics() const {
+    return metrics_;
+  }
+
+protected:
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Metrics> metrics_;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_EXAMPLES_UTILS_MONTE_CARLO_H_
@@ -5,9 +5,10 @@
   #include <sciplot/sciplot.hpp>
 #endif
 
+#include <kalmanif/metrics.h>
+
 #include <iostream>
 #include <map>
-#include <numeric>
 #include <unordered_map>
 #include <Eigen/StdVector>
 
@@ -46,73 +47,6 @@ template <typename Scalar> struct Labeler<manif::SE_2_3<Scalar>> {
     }
 };
 
-template <typename Scalar, typename T> struct RMSE {
-  Scalar operator()(
-    const Scalar& lhs, const typename T::Tangent& rhs
-  ) const {
-    return lhs + rhs.squaredWeightedNorm();
-  }
-};
-
-template <typename Scalar, typename T> struct ATE;
-
-template <typename Scalar>
-struct ATE<Scalar, manif::SE2<Scalar>> {
-  Scalar operator()(
-    const Scalar& lhs, const typename manif::SE2<Scalar>::Tangent& rhs
-  ) const {
-    return lhs + rhs.coeffs().template head<2>().squaredNorm();
-  }
-};
-
-template <typename Scalar>
-struct ATE<Scalar, manif::SE3<Scalar>> {
-  Scalar operator()(
-    const Scalar& lhs, const typename manif::SE3<Scalar>::Tangent& rhs
-  ) const {
-    return lhs + rhs.coeffs().template head<3>().squaredNorm();
-  }
-};
-
-template <typename Scalar> struct ATE<Scalar, manif::SE_2_3<Scalar>> {
-  Scalar operator()(
-    const Scalar& lhs, const typename manif::SE_2_3<Scalar>::Tangent& rhs
-  ) const {
-    return lhs + rhs.coeffs().template head<3>().squaredNorm();
-  }
-};
-
-template <typename Scalar, typename T> struct AOE;
-
-template <typename Scalar>
-struct AOE<Scalar, manif::SE2<Scalar>> {
-  Scalar operator()(
-    const Scalar& lhs, const typename manif::SE2<Scalar>::Tangent& rhs
-  ) const {
-    using std::abs;
-    return lhs + abs(rhs.angle());
-  }
-};
-
-template <typename Scalar>
-struct AOE<Scalar, manif::SE3<Scalar>> {
-  Scalar operator()(
-    const Scalar& lhs, const typename manif::SE3<Scalar>::Tangent& rhs
-  ) const {
-    static const auto QI = Eigen::Quaternion<Scalar>::Identity();
-    return lhs + rhs.exp().quat().angularDistance(QI);
-  }
-};
-
-template <typename Scalar> struct AOE<Scalar, manif::SE_2_3<Scalar>> {
-  Scalar operator()(
-    const Scalar& lhs, const typename manif::SE_2_3<Scalar>::Tangent& rhs
-  ) const {
-    static const auto QI = Eigen::Quaternion<Scalar>::Identity();
-    return lhs + rhs.exp().quat().angularDistance(QI);
-  }
-};
-
 template <typename LieGroup>
 struct DataCollector {
 
@@ -188,15 +122,17 @@ protected:
   Collectors collectors_;
 };
 
+/**
+ * @brief The RMSE/RRMSE/ATE/RTE/AOE/ROE/FPE of the collected estimates,
+ * accumulated sample by sample, see TrajectoryMetrics.
+ */
 template <typename LieGroup>
 struct DemoDataProcessor {
 protected:
 
-  using Scalar = typename LieGroup::Scalar;
-  using Tangent = typename LieGroup::Tangent;
-
   using Collector = DataCollector<LieGroup>;
   using Collectors = DemoDataCollector<LieGroup>;
+  using Metrics = TrajectoryMetrics<LieGroup>;
 
 public:
 
@@ -209,19 +145,27 @@ public:
     return *this;
   }
 
+  /**
+   * @brief Add metrics accumulated elsewhere, e.g. while filtering
+   */
+  DemoDataProcessor& process(const std::string& filter, const Metrics& m) {
+    metrics[filter].merge(m);
+    return *this;
+  }
+
   void print() const {
     std::cout << "\tRMSE\t\tRRMSE\t\tATE\t\tRTE\t\tAOE\t\tROE\t\tFPE\n";
 
     for (const auto& f : metrics) {
       std::cout
         << f.first << "\t"
-        << f.second.at("RMSE")   << "\t"
-        << f.second.at("RRMSE")  << "\t"
-        << f.second.at("ATE")    << "\t"
-        << f.second.at("RTE")    << "\t"
-        << f.second.at("AOE")    << "\t"
-        << f.second.at("ROE")    << "\t"
-        << f.second.at("FPE")    << "\t"
+        << f.second.rmse()   << "\t"
+        << f.second.rrmse()  << "\t"
+        << f.second.ate()    << "\t"
+        << f.second.rte()    << "\t"
+        << f.second.aoe()    << "\t"
+        << f.second.roe()    << "\t"
+        << f.second.fpe()    << "\t"
         << "\n";
     }
     std::cout << "\n----------------------------------\n";
@@ -229,105 +173,14 @@ public:
 
 protected:
 
-  std::map<std::string, std::unordered_map<std::string, Scalar>> metrics;
+  std::map<std::string, Metrics> metrics;
 
   void process(const Collector& collector_true, const Collector& collector_est) {
-
-    const auto& filter = collector_est.name;
-
-    {
-      const auto dXs = computedXs(collector_true.Xs, collector_est.Xs);
-
-      metrics[filter]["RMSE"] = computeRMSE(dXs);
-      metrics[filter]["ATE"]  = computeATE(dXs);
-      metrics[filter]["AOE"]  = computeAOE(dXs);
-    }
-
-    {
-      const auto dXs_rel = computeReldXs(
-        collector_true.Xs, collector_est.Xs, collector_est.time
-      );
-
-      metrics[filter]["RRMSE"] = computeRMSE(dXs_rel);
-      metrics[filter]["RTE"]   = computeATE(dXs_rel);
-      metrics[filter]["ROE"]   = computeAOE(dXs_rel);
-    }
-
-    metrics[filter]["FPE"] = computeFPE(collector_true.Xs, collector_est.Xs);
-  }
-
-  vector_t<Tangent> computedXs(
-    const vector_t<LieGroup>& Xs_true, const vector_t<LieGroup>& Xs_est
-  ) const {
-    KALMANIF_CHECK(Xs_true.size() == Xs_est.size());
-    vector_t<Tangent> dXs;
-    for (std::size_t i=0; i<Xs_true.size(); ++i) {
-        const auto& X_true = Xs_true[i];
-        const auto& X_est = Xs_est[i];
-        dXs.push_back(X_est - X_true);
-    }
-
-    return dXs;
-  }
-
-  Scalar computeRMSE(const vector_t<Tangent>& dXs) const {
-    return std::sqrt(
-      std::accumulate(
-        dXs.begin(), dXs.end(), Scalar(0), RMSE<Scalar, LieGroup>()
-      ) / Scalar(dXs.size())
-    );
-  }
-
-  Scalar computeATE(const vector_t<Tangent>& dXs) const {
-    return std::sqrt(
-      std::accumulate(
-        dXs.begin(), dXs.end(), Scalar(0), ATE<Scalar, LieGroup>()
-      ) / Scalar(dXs.size())
-    );
-  }
-
-  Scalar computeAOE(const vector_t<Tangent>& dXs) const {
-    return std::accumulate(
-      dXs.begin(), dXs.end(), Scalar(0), AOE<Scalar, LieGroup>()
-    ) / Scalar(dXs.size());
-  }
-
-  vector_t<Tangent> computeReldXs(
-    const vector_t<LieGroup>& Xs_true,
-    const vector_t<LieGroup>& Xs_est,
-    const std::vector<double>& time,
-    Scalar dt = 1
-  ) const {
-
-    KALMANIF_CHECK(Xs_true.size() == Xs_est.size());
-    KALMANIF_CHECK(Xs_true.size() == time.size());
-    KALMANIF_CHECK(dt >= 0);
-
-    LieGroup X_true_o = Xs_true.front();
-    LieGroup X_est_o = Xs_est.front();
-    Scalar time_old = time.front();
-
-    vector_t<Tangent> rel;
-
-    for (std::size_t i=1; i<Xs_true.size(); ++i) {
-
-      if ((time[i] - time_old) > dt) {
-        X_true_o = Xs_true[i];
-        X_est_o = Xs_est[i];
-        time_old = time[i];
-        continue;
-      }
-
-      rel.push_back(X_est_o.between(Xs_est[i]) - X_true_o.between(Xs_true[i]));
+    Metrics m;
+    for (std::size_t i=0; i<collector_true.Xs.size(); ++i) {
+      m.add(collector_true.Xs[i], collector_est.Xs[i], collector_est.time[i]);
     }
-
-    return rel;
-  }
-
-  Scalar computeFPE(
-    const vector_t<LieGroup>& Xs_true, const vector_t<LieGroup>& Xs_est
-  ) const {
-    return (Xs_est.back() - Xs_true.back()).weightedNorm();
+    process(collector_est.name, m);
   }
 };
 
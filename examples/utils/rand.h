@@ -1,36 +1,167 @@
 #ifndef _KALMANIF_EXAMPLES_RAND_H_
 #define _KALMANIF_EXAMPLES_RAND_H_
 
-#include <random>
+#include <Eigen/Core>
+
 #include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace kalmanif {
+
+/**
+ * @brief The xoshiro256++ random number generator
+ * (Blackman & Vigna), small and fast.
+ *
+ * It models UniformRandomBitGenerator, so it can be used
+ * with the std distributions as well.
+ */
+struct Xoshiro256 {
+
+  using result_type = std::uint64_t;
+
+  explicit Xoshiro256(const std::uint64_t seed = 0) {
+    this->seed(seed);
+  }
+
+  /**
+   * @brief Seed the generator, the state is expanded with splitmix64.
+   */
+  void seed(std::uint64_t seed) {
+    for (auto& s : s_) {
+      std::uint64_t z = (seed += 0x9e3779b97f4a7c15ull);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      s = z ^ (z >> 31);
+    }
+  }
+
+  result_type operator ()() {
+    const std::uint64_t result = rotl(s_[0] + s_[3], 23) + s_[0];
+    const std::uint64_t t = s_[1] << 17;
 
-namespace {
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
 
-static std::default_random_engine __generator{
-  static_cast<unsigned int>(std::chrono::high_resolution_clock::now().time_since_epoch().count())
+    s_[2] ^= t;
+    s_[3] = rotl(s_[3], 45);
+
+    return result;
+  }
+
+  static constexpr result_type min() {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  //! Uniform in [0, 1)
+  double uniform() {
+    return double((*this)() >> 11) * 0x1.0p-53;
+  }
+
+protected:
+
+  static std::uint64_t rotl(const std::uint64_t x, const int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  std::uint64_t s_[4];
 };
 
-static std::normal_distribution<> __distribution{0, 1};
+/**
+ * @brief The generator of the calling thread.
+ *
+ * Each thread has its own generator, seeded from the clock
+ * and the thread id unless seeded with seedThreadGenerator.
+ */
+inline Xoshiro256& threadGenerator() {
+  thread_local Xoshiro256 generator(
+    std::uint64_t(
+      std::chrono::high_resolution_clock::now().time_since_epoch().count()
+    ) ^ std::hash<std::thread::id>()(std::this_thread::get_id())
+  );
+  return generator;
+}
 
-// Random double in N(0, 1)
-auto __randn = [] (auto) {return __distribution(__generator);};
+/**
+ * @brief Seed the generator of the calling thread.
+ */
+inline void seedThreadGenerator(const std::uint64_t seed) {
+  threadGenerator().seed(seed);
+}
 
-} // namespace
+/**
+ * @brief Fill an Eigen object with entries in N(0, 1).
+ *
+ * The entries are drawn in a batch with the Box-Muller transform,
+ * whose log, sqrt, cos and sin are vectorized by Eigen.
+ *
+ * @param [out] out The Eigen object to fill, e.g. the noise of a whole trajectory.
+ * @param [in] generator The random number generator.
+ */
+template <typename Derived>
+void fillRandn(Eigen::PlainObjectBase<Derived>& out, Xoshiro256& generator) {
+  using Scalar = typename Derived::Scalar;
+  constexpr int Size = Derived::SizeAtCompileTime;
+  constexpr int MaxSize = Derived::MaxSizeAtCompileTime;
+  constexpr int MaxHalf = (MaxSize == Eigen::Dynamic) ? Eigen::Dynamic : (MaxSize + 1) / 2;
+  // runtime sized, on the stack for fixed-size objects
+  using Halves = Eigen::Array<Scalar, Eigen::Dynamic, 1, 0, MaxHalf, 1>;
 
-namespace kalmanif {
+  const Eigen::Index n = out.size();
+  const Eigen::Index m = (n + 1) / 2;
+
+  Halves r(m), theta(m);
+  for (Eigen::Index i = 0; i < m; ++i) {
+    // in (0, 1] for the log
+    r(i) = Scalar(1. - generator.uniform());
+    theta(i) = Scalar(generator.uniform());
+  }
+
+  r = (Scalar(-2) * r.log()).sqrt();
+  theta *= Scalar(2 * EIGEN_PI);
+
+  Eigen::Map<Eigen::Array<Scalar, Size, 1, 0, MaxSize, 1>> flat(out.data(), n);
+  flat.head(m) = r * theta.cos();
+  flat.tail(n - m) = (r * theta.sin()).head(n - m);
+}
+
+/**
+ * @brief Random Eigen object with entries in weight * N(0, 1),
+ * drawn from the given generator.
+ *
+ * @tparam EigenType The Eigen type to create.
+ * @return An EigenType object randomly filled.
+ */
+template <typename EigenType>
+EigenType randn(const EigenType& weights, Xoshiro256& generator) {
+  EigenType n(weights.rows(), weights.cols());
+  fillRandn(n, generator);
+  return weights * n;
+}
 
 /**
- * @brief Random Eigen object with entries in weight * N(0, 1).
+ * @brief Random Eigen object with entries in weight * N(0, 1),
+ * drawn from the generator of the calling thread.
  *
  * @tparam EigenType The Eigen type to create.
  * @return An EigenType object randomly filled.
+ *
+ * @see threadGenerator
  */
 template <typename EigenType>
 EigenType randn(const EigenType& weights = EigenType::Constant(1)) {
-  return weights * EigenType::Zero().unaryExpr(__randn);
+  return randn(weights, threadGenerator());
 }
 
 } // namespace kalmanif
 
 
-#endif // _KALMANIF_EXAMPLES_RAND_H_
\ No newline at end of file
+#endif // _KALMANIF_EXAMPLES_RAND_H_
@@ -0,0 +1,13 @@
+#ifndef _KALMANIF_KALMANIF_AUTODIFF_H_
+#define _KALMANIF_KALMANIF_AUTODIFF_H_
+
+// Eigen's unsupported AutoDiff module, not included by kalmanif.h
+
+#include <Eigen/Core>
+#include <unsupported/Eigen/AutoDiff>
+
+#include "kalmanif/kalmanif.h"
+
+#include "kalmanif/impl/autodiff.h"
+
+#endif // _KALMANIF_KALMANIF_AUTODIFF_H_
@@ -0,0 +1,12 @@
+#ifndef _KALMANIF_KALMANIF_COVARIANCE_INTERSECTION_H_
+#define _KALMANIF_KALMANIF_COVARIANCE_INTERSECTION_H_
+
+#include <array>
+#include <cstdint>
+#include <cstring> // for std::memcpy
+
+#include "kalmanif/extended_kalman_filter.h"
+
+#include "kalmanif/impl/covariance_intersection.h"
+
+#endif // _KALMANIF_KALMANIF_COVARIANCE_INTERSECTION_H_
@@ -0,0 +1,38 @@
+#ifndef _KALMANIF_KALMANIF_DYNAMIC_EXTENDED_KALMAN_FILTER_H_
+#define _KALMANIF_KALMANIF_DYNAMIC_EXTENDED_KALMAN_FILTER_H_
+
+#include <stdexcept> // for std::runtime_error
+#include <type_traits>
+
+#include "kalmanif/impl/macro.h"
+#include "kalmanif/impl/traits.h"
+#include "kalmanif/impl/crtp.h"
+#include "kalmanif/impl/eigen.h"
+#include "kalmanif/impl/validation.h"
+#include "kalmanif/impl/instrumentation.h"
+#include "kalmanif/impl/cholesky.h"
+#include "kalmanif/impl/types.h"
+#include "kalmanif/impl/range.h"
+
+#include "kalmanif/impl/covariance_base.h"
+#include "kalmanif/impl/workspace.h"
+#include "kalmanif/impl/augmented_state.h"
+#include "kalmanif/impl/calibrated_state.h"
+
+#include "kalmanif/system_models/system_model_base.h"
+
+#include "kalmanif/measurement_models/measurement_model_base.h"
+
+#include "kalmanif/impl/linearized.h"
+#include "kalmanif/impl/linearized_invariant.h"
+
+#include "kalmanif/impl/snapshot.h"
+#include "kalmanif/impl/strand.h"
+#include "kalmanif/impl/kalman_filter_base.h"
+#include "kalmanif/impl/dynamic_extended_kalman_filter.h"
+
+#include "kalmanif/system_models/augmented_system_model.h"
+#include "kalmanif/measurement_models/augmented_measurement_model.h"
+#include "kalmanif/measurement_models/calibrated_measurement_model.h"
+
+#endif // _KALMANIF_KALMANIF_DYNAMIC_EXTENDED_KALMAN_FILTER_H_
@@ -0,0 +1,31 @@
+#ifndef _KALMANIF_KALMANIF_ENSEMBLE_KALMAN_FILTER_MANIFOLDS_H_
+#define _KALMANIF_KALMANIF_ENSEMBLE_KALMAN_FILTER_MANIFOLDS_H_
+
+#include <stdexcept> // for std::runtime_error
+#include <type_traits>
+
+#include "kalmanif/impl/macro.h"
+#include "kalmanif/impl/traits.h"
+#include "kalmanif/impl/crtp.h"
+#include "kalmanif/impl/eigen.h"
+#include "kalmanif/impl/block_sparsity.h"
+#include "kalmanif/impl/validation.h"
+#include "kalmanif/impl/instrumentation.h"
+#include "kalmanif/impl/cholesky.h"
+#include "kalmanif/impl/types.h"
+#include "kalmanif/impl/range.h"
+#include "kalmanif/impl/invariance.h"
+#include "kalmanif/impl/executor.h"
+
+#include "kalmanif/impl/covariance_base.h"
+
+#include "kalmanif/system_models/system_model_base.h"
+
+#include "kalmanif/measurement_models/measurement_model_base.h"
+
+#include "kalmanif/impl/snapshot.h"
+#include "kalmanif/impl/strand.h"
+#include "kalmanif/impl/kalman_filter_base.h"
+#include "kalmanif/impl/ensemble_kalman_filter_manifolds.h"
+
+#endif // _KALMANIF_KALMANIF_ENSEMBLE_KALMAN_FILTER_MANIFOLDS_H_
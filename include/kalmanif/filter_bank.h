@@ -0,0 +1,11 @@
+#ifndef _KALMANIF_KALMANIF_FILTER_BANK_H_
+#define _KALMANIF_KALMANIF_FILTER_BANK_H_
+
+#include "kalmanif/extended_kalman_filter.h"
+#include "kalmanif/invariant_extended_kalman_filter.h"
+
+#include "kalmanif/impl/executor.h"
+#include "kalmanif/impl/packed_covariance.h"
+#include "kalmanif/impl/filter_bank.h"
+
+#endif // _KALMANIF_KALMANIF_FILTER_BANK_H_
@@ -0,0 +1,9 @@
+#ifndef _KALMANIF_KALMANIF_FILTER_ENSEMBLE_H_
+#define _KALMANIF_KALMANIF_FILTER_ENSEMBLE_H_
+
+#include "kalmanif/extended_kalman_filter.h"
+
+#include "kalmanif/impl/executor.h"
+#include "kalmanif/impl/filter_ensemble.h"
+
+#endif // _KALMANIF_KALMANIF_FILTER_ENSEMBLE_H_
@@ -0,0 +1,14 @@
+#ifndef _KALMANIF_KALMANIF_FIXED_LAG_SMOOTHER_H_
+#define _KALMANIF_KALMANIF_FIXED_LAG_SMOOTHER_H_
+
+#include "kalmanif/impl/macro.h"
+#include "kalmanif/impl/traits.h"
+#include "kalmanif/impl/crtp.h"
+#include "kalmanif/impl/eigen.h"
+#include "kalmanif/impl/block_sparsity.h"
+
+#include "kalmanif/impl/packed_covariance.h"
+#include "kalmanif/impl/rauch_tung_striebel_smoother.h"
+#include "kalmanif/impl/fixed_lag_smoother.h"
+
+#endif // _KALMANIF_KALMANIF_FIXED_LAG_SMOOTHER_H_
@@ -0,0 +1,6 @@
+#ifndef _KALMANIF_KALMANIF_FOOTPRINT_H_
+#define _KALMANIF_KALMANIF_FOOTPRINT_H_
+
+#include "kalmanif/impl/footprint.h"
+
+#endif // _KALMANIF_KALMANIF_FOOTPRINT_H_
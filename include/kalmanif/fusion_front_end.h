@@ -0,0 +1,10 @@
+#ifndef _KALMANIF_KALMANIF_FUSION_FRONT_END_H_
+#define _KALMANIF_KALMANIF_FUSION_FRONT_END_H_
+
+#include "kalmanif/invariant_extended_kalman_filter.h"
+#include "kalmanif/covariance_intersection.h"
+
+#include "kalmanif/impl/lock_free.h"
+#include "kalmanif/impl/fusion_front_end.h"
+
+#endif // _KALMANIF_KALMANIF_FUSION_FRONT_END_H_
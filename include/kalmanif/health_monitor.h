@@ -0,0 +1,12 @@
+#ifndef _KALMANIF_KALMANIF_HEALTH_MONITOR_H_
+#define _KALMANIF_KALMANIF_HEALTH_MONITOR_H_
+
+#include <stdexcept> // for std::runtime_error
+
+#include "kalmanif/impl/macro.h"
+#include "kalmanif/impl/traits.h"
+#include "kalmanif/impl/eigen.h"
+
+#include "kalmanif/impl/health_monitor.h"
+
+#endif // _KALMANIF_KALMANIF_HEALTH_MONITOR_H_
@@ -0,0 +1,374 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_ADAPTIVE_NOISE_H_
+#define _KALMANIF_KALMANIF_IMPL_ADAPTIVE_NOISE_H_
+
+namespace kalmanif {
+
+/**
+ * @brief The options of the adaptive noise estimators.
+ */
+struct AdaptiveNoiseOptions {
+  //! The forgetting factor b of the estimate, in (0, 1),
+  //! a sample weighing (1 - b) and the estimate b
+  double forgetting = 0.98;
+  //! The relative change of the estimate (in Frobenius norm)
+  //! past which the covariance of the model is replaced
+  double threshold = 0.1;
+};
+
+namespace internal {
+
+/**
+ * @brief An exponentially weighted covariance estimate,
+ * \f$ C \leftarrow b C + (1 - b) C_k \f$.
+ *
+ * Only the estimate and the last covariance handed to the model
+ * are stored, so that adding a sample is O(1) in time and memory.
+ *
+ * @tparam _Covariance The covariance type
+ */
+template <typename _Covariance>
+struct ExponentialCovariance {
+
+  using Covariance = _Covariance;
+  using Scalar = typename Covariance::Scalar;
+
+  explicit ExponentialCovariance(const AdaptiveNoiseOptions& options)
+    : forgetting_(Scalar(options.forgetting))
+    , threshold_(Scalar(options.threshold)) {
+    KALMANIF_CHECK(
+      options.forgetting > 0 && options.forgetting < 1,
+      "AdaptiveNoise: The forgetting factor must be in (0, 1)!",
+      kalmanif::invalid_argument
+    );
+    KALMANIF_CHECK(
+      options.threshold >= 0,
+      "AdaptiveNoise: The threshold must be positive!",
+      kalmanif::invalid_argument
+    );
+  }
+
+  /**
+   * @brief Start from the covariance C of the model,
+   * if not started already.
+   */
+  template <typename _Derived>
+  void start(const Eigen::MatrixBase<_Derived>& C) {
+    if (!started_) {
+      estimate_ = C;
+      applied_ = C;
+      started_ = true;
+    }
+  }
+
+  /**
+   * @brief Add a covariance sample, symmetrized.
+   * @return Whether the estimate moved past the threshold
+   * and is a covariance, that is, whether it should be applied.
+   */
+  template <typename _Derived>
+  bool add(const Eigen::MatrixBase<_Derived>& C) {
+    const Covariance Ck = C;
+    estimate_ *= forgetting_;
+    estimate_ += (Scalar(1) - forgetting_) * Scalar(0.5) *
+                 (Ck + Ck.transpose());
+    ++count_;
+
+    return (estimate_ - applied_).norm() > threshold_ * applied_.norm() &&
+           isCovariance(estimate_);
+  }
+
+  //! Record the estimate as the covariance of the model
+  const Covariance& apply() {
+    applied_ = estimate_;
+    ++apply_count_;
+    return applied_;
+  }
+
+  const Covariance& getEstimate() const {
+    return estimate_;
+  }
+
+  std::size_t getCount() const {
+    return count_;
+  }
+
+  std::size_t getApplyCount() const {
+    return apply_count_;
+  }
+
+  void reset() {
+    started_ = false;
+    count_ = apply_count_ = 0;
+  }
+
+protected:
+
+  Covariance estimate_, applied_;
+  Scalar forgetting_, threshold_;
+  bool started_ = false;
+  std::size_t count_ = 0, apply_count_ = 0;
+};
+
+/**
+ * @brief The covariance P of the filter in the right tangent space
+ * of its state x, that is, mapped by \f$ Ad_{x^{-1}} \f$ for the
+ * right-invariant filters whose error lives in the left tangent space.
+ */
+template <typename Filter, typename State, typename _Derived>
+auto localCovariance(const State& x, const Eigen::MatrixBase<_Derived>& P) {
+  using Scalar = typename State::Scalar;
+  using Matrix = Eigen::Matrix<Scalar, State::DoF, State::DoF>;
+  if constexpr (is_right_invariant<Filter>{}) {
+    const Matrix Ad = x.inverse().adj();
+    return Matrix(Ad * P * Ad.transpose());
+  } else {
+    return Matrix(P);
+  }
+}
+
+} // namespace internal
+
+/**
+ * @brief An online estimate of the measurement noise R of a model
+ * by covariance matching of its residuals.
+ *
+ * After each update, the residual \f$ r = y - h(x^+) \f$ at the
+ * updated state gives the sample
+ * \f$ R_k = V^{-1} (r r^T + H P^+ H^T) V^{-T} \f$
+ * (Mohamed & Schwarz), always positive semi-definite, which is
+ * averaged with the forgetting factor b (Sage-Husa),
+ * \f$ \hat{R} \leftarrow b \hat{R} + (1 - b) R_k \f$.
+ *
+ * The covariance of the model, and thus its cached square root,
+ * is only replaced once the estimate moved past the threshold
+ * relatively to the covariance last set.
+ *
+ * @code
+ * AdaptiveMeasurementNoise<MeasurementModel> adaptive_R;
+ * adaptive_R.update(ekf, h, y); // ekf.update(h, y) and adapt h
+ * @endcode
+ *
+ * @tparam _MeasurementModel The measurement model, linearized
+ * (see Linearized<MeasurementModelBase<Derived>>).
+ */
+template <typename _MeasurementModel>
+struct AdaptiveMeasurementNoise {
+
+  using MeasurementModel = _MeasurementModel;
+  using State = typename internal::traits<MeasurementModel>::State;
+  using Measurement = typename internal::traits<MeasurementModel>::Measurement;
+  using Scalar = typename State::Scalar;
+
+  explicit AdaptiveMeasurementNoise(
+    const AdaptiveNoiseOptions& options = AdaptiveNoiseOptions()
+  ) : R_(options) {}
+
+  /**
+   * @brief Update the filter then adapt the noise of the model
+   * @return Whether the covariance of the model was replaced
+   */
+  template <typename Filter>
+  bool update(Filter& filter, MeasurementModel& h, const Measurement& y) {
+    filter.update(h, y);
+    return add(filter, h, y);
+  }
+
+  /**
+   * @brief Adapt the noise of the model to the residual of the update
+   * the filter just performed with h and y
+   * @return Whether the covariance of the model was replaced
+   */
+  template <typename Filter>
+  bool add(const Filter& filter, MeasurementModel& h, const Measurement& y) {
+    R_.start(h.getCovariance());
+
+    const State& x = filter.getState();
+    const Covariance<State> P =
+      internal::localCovariance<Filter>(x, filter.getCovariance());
+
+    Jacobian<Measurement, State> H;
+    Jacobian<Measurement, Measurement> V;
+    const Linearized<MeasurementModelBase<MeasurementModel>>& h_lin = h;
+    const Measurement r = y - h_lin(x, H, V);
+
+    Covariance<Measurement> C = r * r.transpose();
+    C.noalias() += H * P * H.transpose();
+
+    const Jacobian<Measurement, Measurement> Vi = V.inverse();
+
+    if (!R_.add(Vi * C * Vi.transpose())) {
+      return false;
+    }
+
+    h.setCovariance(R_.apply());
+    return true;
+  }
+
+  //! The current estimate of R
+  const Covariance<Measurement>& getEstimate() const {
+    return R_.getEstimate();
+  }
+
+  //! The number of residuals added
+  std::size_t getCount() const {
+    return R_.getCount();
+  }
+
+  //! The number of times the covariance of the model was replaced
+  std::size_t getApplyCount() const {
+    return R_.getApplyCount();
+  }
+
+  //! Forget the estimate, restarted from the model on the next update
+  void reset() {
+    R_.reset();
+  }
+
+protected:
+
+  internal::ExponentialCovariance<Covariance<Measurement>> R_;
+};
+
+/**
+ * @brief An online estimate of the process noise Q of a model
+ * by covariance matching of the state corrections.
+ *
+ * Over each interval between two propagations, the correction
+ * \f$ \delta = x^+ \ominus x^- \f$ brought by the updates to the
+ * predicted state \f$ x^- \f$ gives the sample (Sage-Husa)
+ * \f$ Q^x_k = \delta \delta^T + P^+ - P^- + W Q W^T \f$
+ * in the state tangent space, mapped to the control space by the
+ * least-squares inverse of the noise jacobian W,
+ * \f$ Q_k = W^+ Q^x_k W^{+T} \f$, and averaged with the
+ * forgetting factor b, \f$ \hat{Q} \leftarrow b \hat{Q} + (1 - b) Q_k \f$.
+ *
+ * The covariance of the model, and thus its cached square root,
+ * is only replaced once the estimate moved past the threshold
+ * relatively to the covariance last set, and is a covariance.
+ *
+ * @code
+ * AdaptiveProcessNoise<SystemModel> adaptive_Q;
+ * adaptive_Q.propagate(ekf, f, u); // adapt f then ekf.propagate(f, u)
+ * ekf.update(h, y);
+ * @endcode
+ *
+ * @note The noise jacobian W is obtained from one more linearization
+ * of the model at each propagation.
+ *
+ * @tparam _SystemModel The system model, linearized
+ * (see Linearized<SystemModelBase<Derived>>),
+ * its noise jacobian W being full column rank.
+ */
+template <typename _SystemModel>
+struct AdaptiveProcessNoise {
+
+  using SystemModel = _SystemModel;
+  using State = typename internal::traits<SystemModel>::State;
+  using Control = typename internal::traits<SystemModel>::Control;
+  using Scalar = typename State::Scalar;
+
+  explicit AdaptiveProcessNoise(
+    const AdaptiveNoiseOptions& options = AdaptiveNoiseOptions()
+  ) : Q_(options) {}
+
+  /**
+   * @brief Adapt the noise of the model to the corrections since
+   * the last propagation, then propagate the filter.
+   * @return Whether the covariance of the model was replaced
+   */
+  template <typename Filter, typename... Args>
+  bool propagate(
+    Filter& filter, SystemModel& f, const Control& u, Args&&... args
+  ) {
+    const bool applied = add(filter, f);
+
+    Jacobian<State, State> F;
+    Jacobian<State, Control> W;
+    const Linearized<SystemModelBase<SystemModel>>& f_lin = f;
+    f_lin(filter.getState(), u, F, W, args...);
+
+    filter.propagate(f, u, std::forward<Args>(args)...);
+
+    x_pred_ = filter.getState();
+    P_pred_ = filter.getCovariance();
+    if constexpr (internal::is_right_invariant<Filter>{}) {
+      W_.noalias() = x_pred_.adj() * W;
+    } else {
+      W_ = W;
+    }
+    has_prediction_ = true;
+
+    return applied;
+  }
+
+  /**
+   * @brief Adapt the noise of the model to the corrections
+   * the filter brought since the last propagate call
+   * @return Whether the covariance of the model was replaced
+   */
+  template <typename Filter>
+  bool add(const Filter& filter, SystemModel& f) {
+    Q_.start(f.getCovariance());
+
+    if (!has_prediction_) {
+      return false;
+    }
+    has_prediction_ = false;
+
+    const State& x = filter.getState();
+    const auto d = internal::is_right_invariant<Filter>{} ?
+      x.lminus(x_pred_) : x.rminus(x_pred_);
+
+    Covariance<State> C = filter.getCovariance();
+    C -= P_pred_;
+    C.noalias() += d.coeffs() * d.coeffs().transpose();
+    C.noalias() += W_ * f.getCovariance() * W_.transpose();
+
+    // W^+ = (W^T W)^{-1} W^T
+    const Jacobian<Control, State> Wi =
+      (W_.transpose() * W_).ldlt().solve(W_.transpose());
+
+    if (!Q_.add(Wi * C * Wi.transpose())) {
+      return false;
+    }
+
+    f.setCovariance(Q_.apply());
+    return true;
+  }
+
+  //! The current estimate of Q
+  const Covariance<Control>& getEstimate() const {
+    return Q_.getEstimate();
+  }
+
+  //! The number of intervals added
+  std::size_t getCount() const {
+    return Q_.getCount();
+  }
+
+  //! The number of times the covariance of the model was replaced
+  std::size_t getApplyCount() const {
+    return Q_.getApplyCount();
+  }
+
+  //! Forget the estimate, restarted from the model on the next propagation
+  void reset() {
+    Q_.reset();
+    has_prediction_ = false;
+  }
+
+protected:
+
+  internal::ExponentialCovariance<Covariance<Control>> Q_;
+
+  //! The predicted state and covariance, and the noise jacobian,
+  //! of the last propagation
+  State x_pred_;
+  Covariance<State> P_pred_;
+  Jacobian<State, Control> W_;
+  bool has_prediction_ = false;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_ADAPTIVE_NOISE_H_
@@ -0,0 +1,140 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_AUGMENTED_STATE_H_
+#define _KALMANIF_KALMANIF_IMPL_AUGMENTED_STATE_H_
+
+#include <vector>
+
+namespace kalmanif {
+
+/**
+ * @brief A dynamic-size state made of a Lie group pose
+ * augmented with a varying number of Euclidean landmarks,
+ * e.g. the state of an EKF-SLAM.
+ *
+ * Its tangent is \f$ [\tau_{pose}, \delta l_0, ..., \delta l_{n-1}] \f$
+ * and its dimension changes as landmarks are added or removed.
+ * The landmarks are stored contiguously, adding landmarks does not
+ * allocate as long as their number stays within the reserved capacity.
+ *
+ * @tparam _Group The pose Lie group type
+ * @tparam _LandmarkDim The landmark dimension
+ */
+template <typename _Group, int _LandmarkDim = _Group::Dim>
+struct AugmentedState {
+
+  using Group = _Group;
+  using Scalar = typename Group::Scalar;
+
+  static constexpr int PoseDoF = Group::DoF;
+  static constexpr int LandmarkDim = _LandmarkDim;
+
+  using Landmark = Eigen::Matrix<Scalar, LandmarkDim, 1>;
+  using Landmarks = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+  AugmentedState() = default;
+  AugmentedState(const Group& pose) : pose_(pose) {}
+
+  /**
+   * @brief The state with an identity pose and no landmark.
+   */
+  static AugmentedState Identity() {
+    return AugmentedState(Group::Identity());
+  }
+
+  //! The tangent dimension
+  int dim() const {
+    return PoseDoF + int(landmarks_.size());
+  }
+
+  int numLandmarks() const {
+    return int(landmarks_.size()) / LandmarkDim;
+  }
+
+  const Group& pose() const {
+    return pose_;
+  }
+
+  void setPose(const Group& pose) {
+    pose_ = pose;
+  }
+
+  Eigen::Map<const Landmark> landmark(const int i) const {
+    return Eigen::Map<const Landmark>(landmarks_.data() + i * LandmarkDim);
+  }
+
+  Eigen::Map<Landmark> landmark(const int i) {
+    return Eigen::Map<Landmark>(landmarks_.data() + i * LandmarkDim);
+  }
+
+  //! All landmarks, stacked
+  Eigen::Map<const Landmarks> landmarks() const {
+    return Eigen::Map<const Landmarks>(
+      landmarks_.data(), Eigen::Index(landmarks_.size())
+    );
+  }
+
+  /**
+   * @brief Reserve the storage of a number of landmarks.
+   */
+  void reserve(const int num_landmarks) {
+    landmarks_.reserve(std::size_t(num_landmarks * LandmarkDim));
+  }
+
+  /**
+   * @brief Append a landmark.
+   * @return The index of the new landmark
+   */
+  int addLandmark(const Landmark& landmark) {
+    landmarks_.insert(
+      landmarks_.end(), landmark.data(), landmark.data() + LandmarkDim
+    );
+    return numLandmarks() - 1;
+  }
+
+  /**
+   * @brief Remove the i-th landmark, the following ones are shifted.
+   */
+  void removeLandmark(const int i) {
+    const auto begin = landmarks_.begin() + i * LandmarkDim;
+    landmarks_.erase(begin, begin + LandmarkDim);
+  }
+
+  /**
+   * @brief Retract a tangent increment \f$ x = x \oplus dx \f$.
+   *
+   * @param [in] dx The increment, of size dim()
+   */
+  template <typename _Derived>
+  AugmentedState& operator +=(const Eigen::MatrixBase<_Derived>& dx) {
+    KALMANIF_ASSERT(
+      dx.size() == dim(),
+      "AugmentedState: Increment size mismatch!"
+    );
+    pose_ += typename Group::Tangent(dx.template head<PoseDoF>());
+    Eigen::Map<Landmarks>(
+      landmarks_.data(), Eigen::Index(landmarks_.size())
+    ) += dx.tail(landmarks_.size());
+    return *this;
+  }
+
+protected:
+
+  Group pose_ = Group::Identity();
+  std::vector<Scalar> landmarks_;
+};
+
+namespace internal {
+
+/**
+ * @brief traits specialization for AugmentedState,
+ * whose size is only known at run time.
+ */
+template <typename Group, int LandmarkDim>
+struct traits<AugmentedState<Group, LandmarkDim>> {
+  using Scalar = typename Group::Scalar;
+  static constexpr auto Size = Eigen::Dynamic;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_AUGMENTED_STATE_H_
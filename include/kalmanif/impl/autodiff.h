@@ -0,0 +1,196 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_AUTODIFF_H_
+#define _KALMANIF_KALMANIF_IMPL_AUTODIFF_H_
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief The forward-mode dual number carrying N derivatives,
+ * of fixed size thus allocation-free.
+ */
+template <typename Scalar, int N>
+using Dual = Eigen::AutoDiffScalar<Eigen::Matrix<Scalar, N, 1>>;
+
+/**
+ * @brief The vector of dual numbers of value zero seeding
+ * the derivatives [Offset, Offset + Size) of the dual number T.
+ */
+template <typename T, int Size, int Offset>
+Eigen::Matrix<T, Size, 1> dualSeed() {
+  using Derivatives = typename T::DerType;
+  using Real = typename Derivatives::Scalar;
+  constexpr int N = Derivatives::RowsAtCompileTime;
+
+  Eigen::Matrix<T, Size, 1> seed;
+  for (int i = 0; i < Size; ++i) {
+    seed(i) = T(Real(0), N, Offset + i);
+  }
+  return seed;
+}
+
+//! The values of a vector of dual numbers
+template <typename _Derived>
+auto dualValue(const Eigen::MatrixBase<_Derived>& v) {
+  using T = typename _Derived::Scalar;
+  return v.unaryExpr([](const T& t) { return t.value(); }).eval();
+}
+
+/**
+ * @brief The derivatives of a vector of dual numbers,
+ * one row per coefficient.
+ */
+template <typename _Derived, typename _DerivedJ>
+void dualJacobian(
+  const Eigen::MatrixBase<_Derived>& v,
+  Eigen::MatrixBase<_DerivedJ> const& J_
+) {
+  // Eigen's const-cast trick to write through a block expression
+  auto& J = const_cast<Eigen::MatrixBase<_DerivedJ>&>(J_);
+  for (Eigen::Index i = 0; i < v.size(); ++i) {
+    J.row(i) = v(i).derivatives().transpose();
+  }
+}
+
+/**
+ * @brief The system model f evaluated once on dual numbers at
+ * \f$ x \oplus \delta, u + \omega \f$, and the jacobians of the right plus,
+ * \f$ F = \frac{D f(x \oplus \delta, u)}{D\delta} \f$
+ * and \f$ W = \frac{D f(x, u + \omega)}{D\omega} \f$.
+ */
+template <typename Model, typename State, typename Control, typename... Args>
+State autoDiffSystem(
+  const Model& f,
+  const State& x,
+  const Control& u,
+  Eigen::Ref<Jacobian<State, State>> F,
+  Eigen::Ref<Jacobian<State, Control>> W,
+  const Args&... args
+) {
+  using Scalar = typename traits<State>::Scalar;
+  constexpr int StateSize = traits<State>::Size;
+  constexpr int ControlSize = traits<Control>::Size;
+  using T = Dual<Scalar, StateSize + ControlSize>;
+  using StateT = decltype(x.template cast<T>());
+  using TangentT = typename StateT::Tangent;
+
+  const StateT x_new = f.run(
+    x.template cast<T>() + TangentT(dualSeed<T, StateSize, 0>()),
+    u.template cast<T>() + dualSeed<T, ControlSize, StateSize>(),
+    args...
+  );
+
+  State x_value;
+  x_value.coeffs() = dualValue(x_new.coeffs());
+
+  // the derivatives of x_new - x_value at delta, omega = 0
+  Eigen::Matrix<Scalar, StateSize, StateSize + ControlSize> J;
+  dualJacobian(x_new.rminus(x_value.template cast<T>()).coeffs(), J);
+
+  F = J.template leftCols<StateSize>();
+  W = J.template rightCols<ControlSize>();
+
+  return x_value;
+}
+
+/**
+ * @brief The measurement model h evaluated once on dual numbers at
+ * \f$ x \oplus \delta \f$, the jacobian of the right plus
+ * \f$ H = \frac{D h(x \oplus \delta)}{D\delta} \f$
+ * and that of an additive noise \f$ V = I \f$.
+ */
+template <typename Measurement, typename Model, typename State>
+Measurement autoDiffMeasurement(
+  const Model& h,
+  const State& x,
+  Eigen::Ref<Jacobian<Measurement, State>> H,
+  Eigen::Ref<Jacobian<Measurement, Measurement>> V
+) {
+  using Scalar = typename traits<State>::Scalar;
+  constexpr int StateSize = traits<State>::Size;
+  using T = Dual<Scalar, StateSize>;
+  using StateT = decltype(x.template cast<T>());
+  using TangentT = typename StateT::Tangent;
+
+  const auto y = h.run(
+    x.template cast<T>() + TangentT(dualSeed<T, StateSize, 0>())
+  );
+
+  dualJacobian(y, H);
+  V.setIdentity();
+
+  return dualValue(y);
+}
+
+} // namespace internal
+
+/**
+ * @brief Base class for models deriving 'run_linearized'
+ * by forward-mode automatic differentiation.
+ *
+ * The model defines 'run' as a template over the state (and control)
+ * types, which is evaluated once on dual numbers carrying all
+ * the derivatives at once, of sizes known at compile time.
+ *
+ * @tparam Derived The model type
+ *
+ * @see Linearized
+ */
+template <typename Derived> struct AutoDiffLinearized;
+
+/**
+ * @brief Specialization for system models on Lie group states
+ *
+ * @tparam Derived The system model, defining
+ * 'template <typename State, typename Control>
+ *  State run(const State&, const Control&, Args...) const'
+ *
+ * @see internal::autoDiffSystem
+ */
+template <typename Derived>
+struct AutoDiffLinearized<SystemModelBase<Derived>> {
+private:
+
+  inline const Derived &derived() const & noexcept {
+    return *static_cast<Derived const *>(this);
+  }
+
+public:
+
+  template <typename... Args>
+  auto run_linearized(Args&&... args) const {
+    return internal::autoDiffSystem(derived(), std::forward<Args>(args)...);
+  }
+};
+
+/**
+ * @brief Specialization for measurement models on Lie group states,
+ * of additive noise
+ *
+ * @tparam Derived The measurement model, defining
+ * 'template <typename State>
+ *  Eigen::Matrix<State::Scalar, M, 1> run(const State&) const'
+ *
+ * @see internal::autoDiffMeasurement
+ */
+template <typename Derived>
+struct AutoDiffLinearized<MeasurementModelBase<Derived>> {
+private:
+
+  inline const Derived &derived() const & noexcept {
+    return *static_cast<Derived const *>(this);
+  }
+
+public:
+
+  template <typename... Args>
+  auto run_linearized(Args&&... args) const {
+    using Measurement = typename internal::traits<Derived>::Measurement;
+    return internal::autoDiffMeasurement<Measurement>(
+      derived(), std::forward<Args>(args)...
+    );
+  }
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_AUTODIFF_H_
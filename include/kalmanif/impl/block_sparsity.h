@@ -0,0 +1,227 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_BLOCK_SPARSITY_H_
+#define _KALMANIF_KALMANIF_IMPL_BLOCK_SPARSITY_H_
+
+#include <cstdint>
+
+namespace kalmanif {
+
+/**
+ * @brief The default, dense, jacobian structure.
+ */
+struct DenseJacobian {};
+
+/**
+ * @brief A compile-time block sparsity pattern of a jacobian.
+ *
+ * The jacobian is split in BlockRows x BlockCols blocks of size
+ * RowsPerBlock x ColsPerBlock. The bit (i * BlockCols + j) of NonZeros
+ * is set if the block (i, j) may be non-zero, and that of Identities
+ * if it is the identity (thus non-zero).
+ *
+ * A model declares the pattern of its jacobians through its traits,
+ * e.g. for an SE_2_3 (position, rotation, velocity) state
+ *
+ * @code
+ * // | I 0 X |
+ * // | 0 I 0 |
+ * // | 0 X I |
+ * using InvariantJacobianSparsity =
+ *   BlockSparsity<3, 3, 3, 3, 0b110'010'101, 0b100'010'001>;
+ * @endcode
+ *
+ * @see internal::jacobian_sparsity
+ * @see internal::invariant_jacobian_sparsity
+ */
+template <
+  int RowsPerBlock, int ColsPerBlock,
+  int BlockRows, int BlockCols,
+  std::uint64_t NonZeros, std::uint64_t Identities = 0
+>
+struct BlockSparsity {
+
+  static_assert(
+    BlockRows * BlockCols <= 64,
+    "BlockSparsity: Too many blocks."
+  );
+  static_assert(
+    (Identities & ~NonZeros) == 0,
+    "BlockSparsity: Identity blocks must be non-zero."
+  );
+  static_assert(
+    Identities == 0 || RowsPerBlock == ColsPerBlock,
+    "BlockSparsity: Identity blocks must be square."
+  );
+
+  static constexpr int BlockRowSize = RowsPerBlock;
+  static constexpr int BlockColSize = ColsPerBlock;
+  static constexpr int Rows = BlockRows;
+  static constexpr int Cols = BlockCols;
+
+  static constexpr bool isNonZero(const int i, const int j) {
+    return (NonZeros >> (i * BlockCols + j)) & 1u;
+  }
+
+  static constexpr bool isIdentity(const int i, const int j) {
+    return (Identities >> (i * BlockCols + j)) & 1u;
+  }
+};
+
+namespace internal {
+
+/**
+ * @brief The sparsity of a model's jacobian,
+ * traits<T>::JacobianSparsity if it exists, DenseJacobian otherwise.
+ */
+template <typename T, class Enable = void>
+struct jacobian_sparsity {
+  using type = DenseJacobian;
+};
+
+template <typename T>
+struct jacobian_sparsity<
+  T, std::void_t<typename traits<T>::JacobianSparsity>
+> {
+  using type = typename traits<T>::JacobianSparsity;
+};
+
+/**
+ * @brief The sparsity of a model's invariant jacobian,
+ * traits<T>::InvariantJacobianSparsity if it exists,
+ * DenseJacobian otherwise.
+ */
+template <typename T, class Enable = void>
+struct invariant_jacobian_sparsity {
+  using type = DenseJacobian;
+};
+
+template <typename T>
+struct invariant_jacobian_sparsity<
+  T, std::void_t<typename traits<T>::InvariantJacobianSparsity>
+> {
+  using type = typename traits<T>::InvariantJacobianSparsity;
+};
+
+/**
+ * @brief Compute the product \f$ A B \f$ of a block sparse A,
+ * skipping its zero blocks and its identity blocks' products.
+ *
+ * @tparam Sparsity The sparsity of A, a BlockSparsity or DenseJacobian
+ */
+template <typename Sparsity, typename _DerivedA, typename _DerivedB>
+typename Eigen::Product<_DerivedA, _DerivedB>::PlainObject
+sparseProduct(
+  const Eigen::MatrixBase<_DerivedA>& A,
+  const Eigen::MatrixBase<_DerivedB>& B
+) {
+  using Result = typename Eigen::Product<_DerivedA, _DerivedB>::PlainObject;
+
+  if constexpr (std::is_same<Sparsity, DenseJacobian>{}) {
+    return A * B;
+  } else {
+    constexpr int R = Sparsity::BlockRowSize;
+    constexpr int C = Sparsity::BlockColSize;
+
+    KALMANIF_ASSERT(
+      A.rows() == R * Sparsity::Rows && A.cols() == C * Sparsity::Cols,
+      "sparseProduct: The sparsity does not match the matrix size."
+    );
+
+    Result AB = Result::Zero(A.rows(), B.cols());
+
+    for (int i = 0; i < Sparsity::Rows; ++i) {
+      for (int j = 0; j < Sparsity::Cols; ++j) {
+        if (Sparsity::isIdentity(i, j)) {
+          AB.template middleRows<R>(i * R) +=
+            B.template middleRows<C>(j * C);
+        } else if (Sparsity::isNonZero(i, j)) {
+          AB.template middleRows<R>(i * R).noalias() +=
+            A.template block<R, C>(i * R, j * C) *
+            B.template middleRows<C>(j * C);
+        }
+      }
+    }
+    return AB;
+  }
+}
+
+/**
+ * @brief Compute \f$ A P A^T + B Q B^T \f$ for a block sparse A,
+ * accumulated in the accumulator scalar type.
+ *
+ * @tparam Sparsity The sparsity of A, a BlockSparsity or DenseJacobian
+ * @see accumulator
+ */
+template <
+  typename Sparsity,
+  typename _DerivedA, typename _DerivedP, typename _DerivedB, typename _DerivedQ
+>
+typename _DerivedP::PlainObject
+sparseCovarianceProduct(
+  const Eigen::MatrixBase<_DerivedA>& A,
+  const Eigen::MatrixBase<_DerivedP>& P,
+  const Eigen::MatrixBase<_DerivedB>& B,
+  const Eigen::MatrixBase<_DerivedQ>& Q
+) {
+  if constexpr (std::is_same<Sparsity, DenseJacobian>{}) {
+    return covarianceProduct(A, P, B, Q);
+  } else {
+    using Scalar = typename _DerivedP::Scalar;
+    using Acc = typename accumulator<Scalar>::type;
+
+    const auto Aa = A.template cast<Acc>();
+    const auto Ba = B.template cast<Acc>();
+
+    // A.P.A^T = A.(A.P)^T with P symmetric
+    const auto AP = sparseProduct<Sparsity>(Aa, P.template cast<Acc>());
+
+    SymmetricProduct<_DerivedA, Acc> C =
+      sparseProduct<Sparsity>(Aa, AP.transpose());
+    lowerProduct<true>(C, Ba, Q.template cast<Acc>());
+    mirrorLower(C);
+
+    return C.template cast<Scalar>();
+  }
+}
+
+/**
+ * @brief Compute \f$ A P A^T + N \f$ for a block sparse A
+ * given a precomputed noise N,
+ * accumulated in the accumulator scalar type.
+ *
+ * @tparam Sparsity The sparsity of A, a BlockSparsity or DenseJacobian
+ * @see accumulator
+ */
+template <
+  typename Sparsity,
+  typename _DerivedA, typename _DerivedP, typename _DerivedN
+>
+typename _DerivedP::PlainObject
+sparseCovarianceProduct(
+  const Eigen::MatrixBase<_DerivedA>& A,
+  const Eigen::MatrixBase<_DerivedP>& P,
+  const Eigen::MatrixBase<_DerivedN>& N
+) {
+  if constexpr (std::is_same<Sparsity, DenseJacobian>{}) {
+    return covarianceProduct(A, P, N);
+  } else {
+    using Scalar = typename _DerivedP::Scalar;
+    using Acc = typename accumulator<Scalar>::type;
+
+    const auto Aa = A.template cast<Acc>();
+
+    // A.P.A^T = A.(A.P)^T with P symmetric
+    const auto AP = sparseProduct<Sparsity>(Aa, P.template cast<Acc>());
+
+    SymmetricProduct<_DerivedA, Acc> C =
+      sparseProduct<Sparsity>(Aa, AP.transpose());
+    C += N.template cast<Acc>();
+    mirrorLower(C);
+
+    return C.template cast<Scalar>();
+  }
+}
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_BLOCK_SPARSITY_H_
@@ -0,0 +1,134 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_CALIBRATED_STATE_H_
+#define _KALMANIF_KALMANIF_IMPL_CALIBRATED_STATE_H_
+
+#include <vector>
+
+namespace kalmanif {
+
+/**
+ * @brief A dynamic-size bundle of a Lie group pose and the
+ * calibration groups of a varying number of sensors,
+ * e.g. the extrinsics \f$ T_i \f$ of sensors mounted on a body,
+ * the pose of the i-th sensor being \f$ X T_i \f$.
+ *
+ * Its tangent is \f$ [\tau_{pose}, \tau_{T_0}, ..., \tau_{T_{k-1}}] \f$,
+ * each calibration being retracted on its own group,
+ * \f$ T_i \leftarrow T_i \oplus \tau_{T_i} \f$.
+ *
+ * Used with a DynamicExtendedKalmanFilter, the calibrations have
+ * identity dynamics (see CalibratedSystemModel) and each sensor only
+ * observes the pose and its own calibration (see
+ * CalibratedMeasurementModel), so that the filter keeps their
+ * cross-covariances while only touching the relevant blocks.
+ *
+ * @tparam _Group The pose Lie group type
+ * @tparam _Calibration The calibration Lie group type
+ */
+template <typename _Group, typename _Calibration = _Group>
+struct CalibratedState {
+
+  using Group = _Group;
+  using Calibration = _Calibration;
+  using Scalar = typename Group::Scalar;
+
+  static constexpr int PoseDoF = Group::DoF;
+  static constexpr int CalibrationDoF = Calibration::DoF;
+
+  CalibratedState() = default;
+  CalibratedState(const Group& pose) : pose_(pose) {}
+
+  /**
+   * @brief The state with an identity pose and no sensor.
+   */
+  static CalibratedState Identity() {
+    return CalibratedState(Group::Identity());
+  }
+
+  //! The tangent dimension
+  int dim() const {
+    return PoseDoF + numSensors() * CalibrationDoF;
+  }
+
+  int numSensors() const {
+    return int(calibrations_.size());
+  }
+
+  const Group& pose() const {
+    return pose_;
+  }
+
+  void setPose(const Group& pose) {
+    pose_ = pose;
+  }
+
+  const Calibration& calibration(const int i) const {
+    return calibrations_[std::size_t(i)];
+  }
+
+  void setCalibration(const int i, const Calibration& calibration) {
+    calibrations_[std::size_t(i)] = calibration;
+  }
+
+  //! The first tangent column of the i-th calibration
+  static constexpr int column(const int i) {
+    return PoseDoF + i * CalibrationDoF;
+  }
+
+  /**
+   * @brief Reserve the storage of a number of sensors.
+   */
+  void reserve(const int num_sensors) {
+    calibrations_.reserve(std::size_t(num_sensors));
+  }
+
+  /**
+   * @brief Append the calibration of a sensor.
+   * @return The index of the new sensor
+   */
+  int addSensor(const Calibration& calibration) {
+    calibrations_.push_back(calibration);
+    return numSensors() - 1;
+  }
+
+  /**
+   * @brief Retract a tangent increment \f$ x = x \oplus dx \f$.
+   *
+   * @param [in] dx The increment, of size dim()
+   */
+  template <typename _Derived>
+  CalibratedState& operator +=(const Eigen::MatrixBase<_Derived>& dx) {
+    KALMANIF_ASSERT(
+      dx.size() == dim(),
+      "CalibratedState: Increment size mismatch!"
+    );
+    pose_ += typename Group::Tangent(dx.template head<PoseDoF>());
+    for (int i = 0; i < numSensors(); ++i) {
+      calibrations_[std::size_t(i)] += typename Calibration::Tangent(
+        dx.template segment<CalibrationDoF>(column(i))
+      );
+    }
+    return *this;
+  }
+
+protected:
+
+  Group pose_ = Group::Identity();
+  std::vector<Calibration, Eigen::aligned_allocator<Calibration>> calibrations_;
+};
+
+namespace internal {
+
+/**
+ * @brief traits specialization for CalibratedState,
+ * whose size is only known at run time.
+ */
+template <typename Group, typename Calibration>
+struct traits<CalibratedState<Group, Calibration>> {
+  using Scalar = typename Group::Scalar;
+  static constexpr auto Size = Eigen::Dynamic;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_CALIBRATED_STATE_H_
@@ -0,0 +1,498 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_CHECKPOINT_H_
+#define _KALMANIF_KALMANIF_IMPL_CHECKPOINT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace kalmanif {
+
+/**
+ * @brief The header of a filter checkpoint.
+ *
+ * A checkpoint is this header followed by the filter record:
+ * the state coefficients, the covariance (its lower Cholesky factor
+ * for the SquareRootExtendedKalmanFilter)
+ * and, for the UKFM, its unscented parameters alpha;
+ * all column-major in the host byte order.
+ *
+ * The checkpoint of a RauchTungStriebelSmoother is the record of its
+ * filter followed by its epochs, each the predicted and estimated
+ * states coefficients, then the predicted and estimated covariances
+ * and the transition.
+ */
+struct CheckpointHeader {
+
+  char magic[8];
+  std::uint32_t version;
+  //! The filter type, see internal::checkpoint_kind
+  std::uint32_t kind;
+  //! The size in bytes of a scalar
+  std::uint32_t scalar_size;
+  //! The number of state coefficients
+  std::uint32_t rep_size;
+  //! The state degrees of freedom
+  std::uint32_t dof;
+  std::uint32_t reserved0;
+  //! The size in bytes of the checkpoint, header included
+  std::uint64_t size;
+  //! The number of smoother epochs
+  std::uint64_t epochs;
+  char reserved[16];
+};
+
+static_assert(
+  sizeof(CheckpointHeader) == 64, "Unexpected CheckpointHeader padding!"
+);
+
+namespace internal {
+
+/**
+ * @brief The checkpoint tag of a filter type.
+ */
+template <typename>
+struct checkpoint_kind;
+
+template <typename T, InnovationSolver Solver>
+struct checkpoint_kind<ExtendedKalmanFilter<T, Solver>>
+  : std::integral_constant<std::uint32_t, 1> {};
+
+template <typename T>
+struct checkpoint_kind<SquareRootExtendedKalmanFilter<T>>
+  : std::integral_constant<std::uint32_t, 2> {};
+
+template <typename T, Invariance Iv, InnovationSolver Solver>
+struct checkpoint_kind<InvariantExtendedKalmanFilter<T, Iv, Solver>>
+  : std::integral_constant<std::uint32_t, Iv == Invariance::Right ? 3 : 4> {};
+
+template <typename T, Invariance Iv, typename E, typename S>
+struct checkpoint_kind<UnscentedKalmanFilterManifolds<T, Iv, E, S>>
+  : std::integral_constant<std::uint32_t, Iv == Invariance::Right ? 5 : 7> {};
+
+template <typename T>
+struct checkpoint_kind<InformationKalmanFilter<T>>
+  : std::integral_constant<std::uint32_t, 6> {};
+
+template <typename Filter, typename Storage>
+struct checkpoint_kind<RauchTungStriebelSmoother<Filter, Storage>>
+  : std::integral_constant<
+      std::uint32_t, 0x100 | checkpoint_kind<Filter>::value
+    > {};
+
+//! Sequential writes to a checkpoint buffer
+struct CheckpointWriter {
+
+  template <typename _Derived>
+  void write(const Eigen::MatrixBase<_Derived>& m) {
+    using Plain = typename _Derived::PlainObject;
+    const Plain p = m;
+    const std::size_t bytes = p.size() * sizeof(typename Plain::Scalar);
+    std::memcpy(data, p.data(), bytes);
+    data += bytes;
+  }
+
+  template <typename T>
+  void writeValue(const T value) {
+    std::memcpy(data, &value, sizeof(T));
+    data += sizeof(T);
+  }
+
+  std::uint8_t* data;
+};
+
+//! Sequential zero-copy reads of a checkpoint buffer
+struct CheckpointReader {
+
+  template <typename Matrix>
+  Eigen::Map<const Matrix, Eigen::Unaligned> map() {
+    const Eigen::Map<const Matrix, Eigen::Unaligned> m(
+      reinterpret_cast<const typename Matrix::Scalar*>(data)
+    );
+    data += sizeof(typename Matrix::Scalar) * Matrix::SizeAtCompileTime;
+    return m;
+  }
+
+  template <typename T>
+  T readValue() {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return value;
+  }
+
+  const std::uint8_t* data;
+};
+
+template <typename Filter>
+CheckpointHeader makeCheckpointHeader(
+  const std::size_t size, const std::size_t epochs
+) {
+  using State = typename Filter::State;
+
+  CheckpointHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, "KALMANIF", sizeof(header.magic));
+  header.version = 3;
+  header.kind = checkpoint_kind<Filter>::value;
+  header.scalar_size = sizeof(typename traits<State>::Scalar);
+  header.rep_size = State::RepSize;
+  header.dof = State::DoF;
+  header.size = size;
+  header.epochs = epochs;
+  return header;
+}
+
+} // namespace internal
+
+/**
+ * @brief The checkpoint record of a filter.
+ *
+ * The lazy propagations pending in the filter are materialized,
+ * the filter restored from the checkpoint has none.
+ *
+ * @tparam Filter The filter type
+ */
+template <typename Filter>
+struct FilterCheckpoint {
+
+  using State = typename Filter::State;
+  using Scalar = typename internal::traits<State>::Scalar;
+  using Matrix = Covariance<State>;
+  using Coefficients = Eigen::Matrix<Scalar, State::RepSize, 1>;
+
+  static constexpr bool IsSquareRoot =
+    internal::checkpoint_kind<Filter>::value == 2;
+  static constexpr bool IsUnscented = internal::is_unscented<Filter>::value;
+
+  //! The size in bytes of the record
+  static constexpr std::size_t Size = sizeof(Scalar) * (
+    State::RepSize + State::DoF * State::DoF + (IsUnscented ? 3 : 0)
+  );
+
+  static std::size_t size(const Filter&) {
+    return Size;
+  }
+
+  static std::size_t epochs(const Filter&) {
+    return 0;
+  }
+
+  static void save(const Filter& filter, internal::CheckpointWriter& writer) {
+    writer.write(filter.getState().coeffs());
+    if constexpr (IsSquareRoot) {
+      writer.write(filter.getCovarianceSquareRoot().matrixL().toDenseMatrix());
+    } else {
+      writer.write(filter.getCovariance());
+    }
+    if constexpr (IsUnscented) {
+      writer.writeValue(filter.alpha_d);
+      writer.writeValue(filter.alpha_q);
+      writer.writeValue(filter.alpha_u);
+    }
+  }
+
+  static void load(Filter& filter, internal::CheckpointReader& reader) {
+    State state;
+    state.coeffs() = reader.map<Coefficients>();
+    filter.setState(state);
+    if constexpr (IsSquareRoot) {
+      filter.setCovarianceSquareRoot(reader.map<Matrix>());
+    } else {
+      filter.setCovariance(reader.map<Matrix>());
+    }
+    if constexpr (IsUnscented) {
+      const Scalar alpha_d = reader.template readValue<Scalar>();
+      const Scalar alpha_q = reader.template readValue<Scalar>();
+      const Scalar alpha_u = reader.template readValue<Scalar>();
+      filter.setSigmaPoints(alpha_d, alpha_q, alpha_u);
+    }
+  }
+};
+
+/**
+ * @brief The checkpoint record of a smoother,
+ * its filter followed by its filtering epochs.
+ *
+ * The smoothed sequence is not recorded, it is recomputed by smooth().
+ */
+template <typename Filter, typename Storage>
+struct FilterCheckpoint<RauchTungStriebelSmoother<Filter, Storage>> {
+
+  using Smoother = RauchTungStriebelSmoother<Filter, Storage>;
+  using State = typename Filter::State;
+  using Scalar = typename internal::traits<State>::Scalar;
+  using Matrix = Covariance<State>;
+  using Coefficients = Eigen::Matrix<Scalar, State::RepSize, 1>;
+
+  //! The size in bytes of an epoch
+  static constexpr std::size_t EpochSize = sizeof(Scalar) * (
+    2 * State::RepSize + 3 * State::DoF * State::DoF
+  );
+
+  //! The size in bytes of the smoother bookkeeping
+  static constexpr std::size_t FlagsSize = 3 * sizeof(std::uint64_t);
+
+  static std::size_t size(const Smoother& smoother) {
+    return FlagsSize + FilterCheckpoint<Filter>::Size +
+      smoother.epochs_.size() * EpochSize;
+  }
+
+  static std::size_t epochs(const Smoother& smoother) {
+    return smoother.epochs_.size();
+  }
+
+  static void save(const Smoother& smoother, internal::CheckpointWriter& writer) {
+    writer.writeValue(std::uint64_t(smoother.estimated_));
+    writer.writeValue(std::uint64_t(smoother.propagated_));
+    writer.writeValue(std::uint64_t(smoother.updated_));
+
+    FilterCheckpoint<Filter>::save(smoother.filter_, writer);
+
+    for (std::size_t k = 0; k < smoother.epochs_.size(); ++k) {
+      const auto& epoch = smoother.epochs_[k];
+      writer.write(epoch.x_pred.coeffs());
+      writer.write(epoch.x_est.coeffs());
+      writer.write(internal::unpacked(epoch.P_pred));
+      writer.write(internal::unpacked(epoch.P_est));
+      writer.write(epoch.A);
+    }
+  }
+
+  static void load(
+    Smoother& smoother, internal::CheckpointReader& reader,
+    const std::size_t epochs
+  ) {
+    smoother.clear();
+
+    smoother.estimated_ = std::size_t(reader.readValue<std::uint64_t>());
+    smoother.propagated_ = reader.readValue<std::uint64_t>() != 0;
+    smoother.updated_ = reader.readValue<std::uint64_t>() != 0;
+
+    FilterCheckpoint<Filter>::load(smoother.filter_, reader);
+
+    smoother.epochs_.reserve(epochs);
+    for (std::size_t k = 0; k < epochs; ++k) {
+      smoother.epochs_.emplace_back();
+      auto& epoch = smoother.epochs_.back();
+      epoch.x_pred.coeffs() = reader.map<Coefficients>();
+      epoch.x_est.coeffs() = reader.map<Coefficients>();
+      epoch.P_pred = reader.map<Matrix>();
+      epoch.P_est = reader.map<Matrix>();
+      epoch.A = reader.map<Matrix>();
+      if constexpr (internal::has_predicted_square_root<Filter>{}) {
+        epoch.S_pred.compute(internal::unpacked(epoch.P_pred));
+      }
+    }
+  }
+};
+
+/**
+ * @brief The size in bytes of the checkpoint of a filter (or smoother).
+ */
+template <typename Filter>
+std::size_t checkpointSize(const Filter& filter) {
+  return sizeof(CheckpointHeader) + FilterCheckpoint<Filter>::size(filter);
+}
+
+/**
+ * @brief Save the checkpoint of a filter (or smoother), in place.
+ *
+ * @param [in] filter The filter
+ * @param [out] data The buffer to save to, of at least checkpointSize bytes,
+ * aligned for the scalar type.
+ *
+ * @see CheckpointHeader
+ */
+template <typename Filter>
+void saveCheckpoint(const Filter& filter, std::uint8_t* data) {
+  const CheckpointHeader header = internal::makeCheckpointHeader<Filter>(
+    checkpointSize(filter), FilterCheckpoint<Filter>::epochs(filter)
+  );
+  std::memcpy(data, &header, sizeof(header));
+
+  internal::CheckpointWriter writer{data + sizeof(header)};
+  FilterCheckpoint<Filter>::save(filter, writer);
+}
+
+/**
+ * @brief Save the checkpoint of a filter (or smoother).
+ *
+ * @see CheckpointHeader
+ */
+template <typename Filter>
+std::vector<std::uint8_t> saveCheckpoint(const Filter& filter) {
+  std::vector<std::uint8_t> buffer(checkpointSize(filter));
+  saveCheckpoint(filter, buffer.data());
+  return buffer;
+}
+
+/**
+ * @brief A read-only view of a checkpoint, e.g. of a mapped file,
+ * validated but not decoded.
+ *
+ * The checkpointed estimate can be inspected in place and the filter
+ * is restored directly from the viewed memory.
+ *
+ * @tparam Filter The filter (or smoother) type
+ */
+template <typename Filter>
+class CheckpointView {
+
+public:
+
+  using State = typename Filter::State;
+  using Scalar = typename internal::traits<State>::Scalar;
+
+  /**
+   * @brief Construct a view of a checkpoint
+   * @param data The checkpoint, aligned for the scalar type
+   * @param size The size in bytes of data
+   * @throw kalmanif::invalid_argument if data is not a checkpoint
+   * of a Filter
+   */
+  CheckpointView(const std::uint8_t* data, const std::size_t size)
+    : data_(data) {
+    KALMANIF_ENSURE(
+      data != nullptr && size >= sizeof(CheckpointHeader),
+      "CheckpointView: Not a checkpoint!",
+      kalmanif::invalid_argument
+    );
+
+    std::memcpy(&header_, data, sizeof(header_));
+
+    const CheckpointHeader expected =
+      internal::makeCheckpointHeader<Filter>(0, 0);
+    KALMANIF_ENSURE(
+      std::memcmp(header_.magic, expected.magic, sizeof(header_.magic)) == 0 &&
+      header_.version == expected.version,
+      "CheckpointView: Not a checkpoint!",
+      kalmanif::invalid_argument
+    );
+    KALMANIF_ENSURE(
+      header_.kind == expected.kind &&
+      header_.scalar_size == expected.scalar_size &&
+      header_.rep_size == expected.rep_size &&
+      header_.dof == expected.dof,
+      "CheckpointView: The checkpoint was not saved from this filter type!",
+      kalmanif::invalid_argument
+    );
+    KALMANIF_ENSURE(
+      header_.size == expectedSize() && size >= header_.size,
+      "CheckpointView: Truncated checkpoint!",
+      kalmanif::invalid_argument
+    );
+  }
+
+  const CheckpointHeader& getHeader() const {
+    return header_;
+  }
+
+  /**
+   * @brief Get the number of checkpointed smoother epochs
+   */
+  std::size_t getEpochCount() const {
+    return std::size_t(header_.epochs);
+  }
+
+  /**
+   * @brief Get the checkpointed state
+   */
+  State getState() const {
+    State state;
+    state.coeffs() = filterReader().template map<
+      Eigen::Matrix<Scalar, State::RepSize, 1>
+    >();
+    return state;
+  }
+
+  /**
+   * @brief Get the checkpointed covariance
+   */
+  Covariance<State> getCovariance() const {
+    auto reader = filterReader();
+    reader.data += sizeof(Scalar) * State::RepSize;
+    const auto m = reader.template map<Covariance<State>>();
+    if constexpr (FilterCheckpoint<Inner>::IsSquareRoot) {
+      return m * m.transpose();
+    } else {
+      return m;
+    }
+  }
+
+  /**
+   * @brief Restore a filter from the checkpoint
+   */
+  void restore(Filter& filter) const {
+    internal::CheckpointReader reader{data_ + sizeof(CheckpointHeader)};
+    if constexpr (IsSmoother) {
+      FilterCheckpoint<Filter>::load(filter, reader, getEpochCount());
+    } else {
+      FilterCheckpoint<Filter>::load(filter, reader);
+    }
+  }
+
+protected:
+
+  template <typename T>
+  struct inner { using type = T; static constexpr bool smoother = false; };
+
+  template <typename F, typename S>
+  struct inner<RauchTungStriebelSmoother<F, S>> {
+    using type = F;
+    static constexpr bool smoother = true;
+  };
+
+  //! The filter type, of the smoother if any
+  using Inner = typename inner<Filter>::type;
+  static constexpr bool IsSmoother = inner<Filter>::smoother;
+
+  std::size_t expectedSize() const {
+    if constexpr (IsSmoother) {
+      using Checkpoint = FilterCheckpoint<Filter>;
+      return sizeof(CheckpointHeader) + Checkpoint::FlagsSize +
+        FilterCheckpoint<Inner>::Size + getEpochCount() * Checkpoint::EpochSize;
+    } else {
+      return sizeof(CheckpointHeader) + FilterCheckpoint<Filter>::Size;
+    }
+  }
+
+  //! A reader at the filter record
+  internal::CheckpointReader filterReader() const {
+    std::size_t offset = sizeof(CheckpointHeader);
+    if constexpr (IsSmoother) {
+      offset += FilterCheckpoint<Filter>::FlagsSize;
+    }
+    return internal::CheckpointReader{data_ + offset};
+  }
+
+  const std::uint8_t* data_;
+  CheckpointHeader header_;
+};
+
+/**
+ * @brief Restore a filter (or smoother) from its checkpoint.
+ *
+ * @param [out] filter The filter
+ * @param [in] data The checkpoint, aligned for the scalar type
+ * @param [in] size The size in bytes of data
+ * @throw kalmanif::invalid_argument if data is not a checkpoint
+ * of a Filter
+ */
+template <typename Filter>
+void loadCheckpoint(
+  Filter& filter, const std::uint8_t* data, const std::size_t size
+) {
+  CheckpointView<Filter>(data, size).restore(filter);
+}
+
+/**
+ * @brief Restore a filter (or smoother) from its checkpoint.
+ */
+template <typename Filter>
+void loadCheckpoint(Filter& filter, const std::vector<std::uint8_t>& buffer) {
+  loadCheckpoint(filter, buffer.data(), buffer.size());
+}
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_CHECKPOINT_H_
@@ -60,6 +60,25 @@ public:
     return *this;
   }
 
+  /**
+   * @brief Set the decomposition of a matrix from its lower factor
+   * computed elsewhere, e.g. in closed form.
+   * @param [in] matrix The lower part stored in a full matrix
+   * @param [in] l1_norm The l1 norm of the decomposed matrix, see rcond()
+   */
+  template <typename Derived>
+  Cholesky& setDecomposition(
+    const Eigen::MatrixBase <Derived>& matrix,
+    const typename Eigen::NumTraits<
+      typename _MatrixType::Scalar
+    >::Real l1_norm
+  ) {
+    setL(matrix);
+    this->m_l1_norm = l1_norm;
+    this->m_info = Eigen::Success;
+    return *this;
+  }
+
   /**
    * @brief Set upper triangular part of the decomposition
    * @param [in] matrix The upper part stored in a full matrix
@@ -70,6 +89,76 @@ public:
     this->m_isInitialized = true;
     return *this;
   }
+
+  /**
+   * @brief Rank-one update of the decomposition, to that of
+   * \f$ LL^T + \sigma vv^T \f$, a downdate if sigma is negative.
+   *
+   * The algorithm of Eigen::LLT::rankUpdate, but for its temporary
+   * of the size of the matrix rather than dynamic.
+   *
+   * @param [in] v The vector
+   * @param [in] sigma The scale of the update
+   * @return true on success, false if the downdated matrix is not
+   * positive definite, the decomposition is then partially updated
+   */
+  template <typename Derived>
+  bool rankOneUpdate(
+    const Eigen::MatrixBase<Derived>& v,
+    const typename Eigen::NumTraits<
+      typename _MatrixType::Scalar
+    >::Real sigma
+  ) {
+    static_assert(
+      _UpLo == Eigen::Lower,
+      "Cholesky: The rank-one update is of the lower factor!"
+    );
+    using std::sqrt;
+    using RealScalar =
+      typename Eigen::NumTraits<typename _MatrixType::Scalar>::Real;
+    using Vector = Eigen::Matrix<
+      typename _MatrixType::Scalar, _MatrixType::RowsAtCompileTime, 1,
+      Eigen::ColMajor, _MatrixType::MaxRowsAtCompileTime, 1
+    >;
+
+    eigen_assert(this->m_isInitialized && "LLT is not initialized.");
+
+    auto& L = this->m_matrix;
+    const Eigen::Index n = L.cols();
+
+    Vector w = v;
+    RealScalar beta = 1;
+    for (Eigen::Index j = 0; j < n; ++j) {
+      const RealScalar Ljj = L(j, j);
+      const RealScalar dj = Ljj * Ljj;
+      const RealScalar wj = w(j);
+      const RealScalar swj2 = sigma * wj * wj;
+      const RealScalar gamma = dj * beta + swj2;
+
+      const RealScalar d = dj + swj2 / beta;
+      if (d <= RealScalar(0)) {
+        this->m_info = Eigen::NumericalIssue;
+        return false;
+      }
+
+      const RealScalar nLjj = sqrt(d);
+      L(j, j) = nLjj;
+      beta += swj2 / dj;
+
+      const Eigen::Index rs = n - j - 1;
+      if (rs > 0) {
+        w.tail(rs) -= (wj / Ljj) * L.col(j).tail(rs);
+        if (gamma != RealScalar(0)) {
+          L.col(j).tail(rs) =
+            (nLjj / Ljj) * L.col(j).tail(rs) +
+            (nLjj * sigma * wj / gamma) * w.tail(rs);
+        }
+      }
+    }
+
+    this->m_info = Eigen::Success;
+    return true;
+  }
 };
 
 } // namespace kalmanif
@@ -0,0 +1,238 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_CLOSED_FORM_H_
+#define _KALMANIF_KALMANIF_IMPL_CLOSED_FORM_H_
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief Whether a matrix type is small enough for the closed-form
+ * kernels, that is, a fixed-size square matrix of size 1 to 3.
+ */
+template <typename MatrixType>
+constexpr bool is_closed_form_size =
+  MatrixType::RowsAtCompileTime != Eigen::Dynamic &&
+  MatrixType::RowsAtCompileTime == MatrixType::ColsAtCompileTime &&
+  MatrixType::RowsAtCompileTime >= 1 &&
+  MatrixType::RowsAtCompileTime <= 3;
+
+/**
+ * @brief Whether the filters of the state T decompose the matrices
+ * of type MatrixType with the closed-form kernels, that is,
+ * T has closed-form kernels and MatrixType is small enough.
+ *
+ * @see has_closed_form_kernels
+ */
+template <typename T, typename MatrixType>
+constexpr bool use_closed_form =
+  has_closed_form_kernels<T>::value && is_closed_form_size<MatrixType>;
+
+/**
+ * @brief Closed-form Cholesky decomposition of a small fixed-size
+ * symmetric positive-definite matrix.
+ *
+ * The factor is computed by the explicit, fully unrolled,
+ * Cholesky-Banachiewicz recurrence and the solves by forward and
+ * back substitutions with the stored inverse of its diagonal,
+ * avoiding the generic blocked code paths of Eigen::LLT which
+ * dominate at these sizes.
+ *
+ * It provides the subset of the Eigen::LLT interface used
+ * by the filters. As Eigen::LLT, only the lower triangular part
+ * of the decomposed matrix is read.
+ *
+ * @tparam _MatrixType The matrix type, of size 1 to 3
+ *
+ * @see use_closed_form
+ */
+template <typename _MatrixType>
+class ClosedFormLLT {
+
+  static_assert(
+    is_closed_form_size<_MatrixType>,
+    "ClosedFormLLT: Only for fixed-size matrices of size 1 to 3!"
+  );
+
+public:
+
+  using MatrixType = _MatrixType;
+  using Scalar = typename MatrixType::Scalar;
+
+  static constexpr int Size = MatrixType::RowsAtCompileTime;
+
+  ClosedFormLLT() = default;
+  ~ClosedFormLLT() = default;
+
+  /**
+   * @brief Construct the decomposition of a matrix
+   * @param [in] A The matrix to be decomposed
+   */
+  template <typename _Derived>
+  explicit ClosedFormLLT(const Eigen::MatrixBase<_Derived>& A) {
+    compute(A);
+  }
+
+  /**
+   * @brief Decompose a matrix
+   * @param [in] A The matrix to be decomposed
+   */
+  template <typename _Derived>
+  ClosedFormLLT& compute(const Eigen::MatrixBase<_Derived>& A) {
+    using std::sqrt;
+
+    // evaluated first, e.g. the coefficients of a product
+    const MatrixType M = A;
+
+    L_.setZero();
+    info_ = Eigen::Success;
+
+    for (int j = 0; j < Size; ++j) {
+      Scalar d = M(j, j);
+      for (int k = 0; k < j; ++k) {
+        d -= L_(j, k) * L_(j, k);
+      }
+
+      // also rejects NaNs
+      if (!(d > Scalar(0))) {
+        info_ = Eigen::NumericalIssue;
+        return *this;
+      }
+
+      L_(j, j) = sqrt(d);
+      inv_diag_(j) = Scalar(1) / L_(j, j);
+
+      for (int i = j + 1; i < Size; ++i) {
+        Scalar s = M(i, j);
+        for (int k = 0; k < j; ++k) {
+          s -= L_(i, k) * L_(j, k);
+        }
+        L_(i, j) = s * inv_diag_(j);
+      }
+    }
+
+    return *this;
+  }
+
+  /**
+   * @brief Solve \f$ A X = B \f$
+   * @param [in] B The right-hand side
+   * @return The solution X
+   */
+  template <typename _Derived>
+  typename _Derived::PlainObject
+  solve(const Eigen::MatrixBase<_Derived>& B) const {
+    eigen_assert(info_ == Eigen::Success && "LLT did not succeed.");
+
+    typename _Derived::PlainObject X = B;
+    for (Eigen::Index c = 0; c < X.cols(); ++c) {
+      // L.y = b
+      for (int i = 0; i < Size; ++i) {
+        Scalar s = X(i, c);
+        for (int k = 0; k < i; ++k) {
+          s -= L_(i, k) * X(k, c);
+        }
+        X(i, c) = s * inv_diag_(i);
+      }
+      // L^T.x = y
+      for (int i = Size - 1; i >= 0; --i) {
+        Scalar s = X(i, c);
+        for (int k = i + 1; k < Size; ++k) {
+          s -= L_(k, i) * X(k, c);
+        }
+        X(i, c) = s * inv_diag_(i);
+      }
+    }
+    return X;
+  }
+
+  /**
+   * @brief Get the inverse of the decomposed matrix
+   */
+  MatrixType inverse() const {
+    return solve(MatrixType::Identity());
+  }
+
+  /**
+   * @brief Get the lower triangular factor L
+   */
+  auto matrixL() const {
+    return L_.template triangularView<Eigen::Lower>();
+  }
+
+  /**
+   * @brief Get the upper triangular factor \f$ U = L^T \f$
+   */
+  auto matrixU() const {
+    return L_.transpose().template triangularView<Eigen::Upper>();
+  }
+
+  /**
+   * @brief Get the lower triangular factor L, stored in a full matrix
+   * whose strictly upper part is zero
+   */
+  const MatrixType& matrixLLT() const {
+    return L_;
+  }
+
+  /**
+   * @brief Get the decomposed matrix \f$ L L^T \f$
+   */
+  MatrixType reconstructedMatrix() const {
+    return L_ * L_.transpose();
+  }
+
+  /**
+   * @brief Get the decomposition status, Eigen::NumericalIssue
+   * if the matrix is not positive definite
+   */
+  Eigen::ComputationInfo info() const {
+    return info_;
+  }
+
+protected:
+
+  MatrixType L_ = MatrixType::Zero();
+  Eigen::Matrix<Scalar, Size, 1> inv_diag_ =
+    Eigen::Matrix<Scalar, Size, 1>::Zero();
+  Eigen::ComputationInfo info_ = Eigen::InvalidInput;
+};
+
+/**
+ * @brief The Cholesky decomposition the filters of the state
+ * StateType use for the matrices of type MatrixType.
+ *
+ * @see use_closed_form
+ */
+template <typename StateType, typename MatrixType>
+using StateLLT = typename std::conditional<
+  use_closed_form<StateType, MatrixType>,
+  ClosedFormLLT<MatrixType>,
+  Eigen::LLT<MatrixType>
+>::type;
+
+/**
+ * @brief Compute the eigen-decomposition of a symmetric matrix,
+ * in closed form (the roots of the characteristic polynomial)
+ * if the filters of the state StateType use the closed-form kernels
+ * for the matrices of type MatrixType.
+ *
+ * @note The closed form is less accurate on ill-conditioned 3x3
+ * matrices, it is therefore only opted in through the state traits.
+ *
+ * @see use_closed_form
+ */
+template <typename StateType, typename MatrixType, typename _Derived>
+void computeEigen(
+  Eigen::SelfAdjointEigenSolver<MatrixType>& eigensolver,
+  const Eigen::MatrixBase<_Derived>& A
+) {
+  if constexpr (use_closed_form<StateType, MatrixType>) {
+    eigensolver.computeDirect(A);
+  } else {
+    eigensolver.compute(A);
+  }
+}
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_CLOSED_FORM_H_
@@ -0,0 +1,231 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_COMPRESSED_COVARIANCE_H_
+#define _KALMANIF_KALMANIF_IMPL_COMPRESSED_COVARIANCE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace kalmanif {
+
+/**
+ * @brief The encodings of a CompressedCovariance.
+ */
+enum class CovarianceCodec {
+  Float,     // The packed upper triangle, in single precision
+  Cholesky,  // The packed Cholesky factor, scaled, in single precision
+  Cholesky16 // The packed Cholesky factor, scaled, quantized to 16 bits
+};
+
+namespace internal {
+
+template <CovarianceCodec Codec>
+struct covariance_codec_traits;
+
+template <>
+struct covariance_codec_traits<CovarianceCodec::Float> {
+  using Coefficient = float;
+  // float rounding
+  static constexpr double ErrorBound = 6e-8;
+};
+
+template <>
+struct covariance_codec_traits<CovarianceCodec::Cholesky> {
+  using Coefficient = float;
+  static constexpr double ErrorBound = 6e-8;
+};
+
+template <>
+struct covariance_codec_traits<CovarianceCodec::Cholesky16> {
+  using Coefficient = std::int16_t;
+  // half a quantization step
+  static constexpr double ErrorBound = 0.5 / 32767;
+};
+
+} // namespace internal
+
+/**
+ * @brief A covariance stored lossily in a reduced precision,
+ * e.g. to keep very long smoother histories, see CompressedStorage.
+ *
+ * Either the packed upper triangle is kept in single precision
+ * (CovarianceCodec::Float), or the packed Cholesky factor
+ * \f$ P = s^2 L L^T \f$, scaled by the largest standard deviation s so
+ * that its coefficients are in [-1, 1], in single precision
+ * (CovarianceCodec::Cholesky) or quantized to 16 bits
+ * (CovarianceCodec::Cholesky16). The Cholesky codecs decode to
+ * a covariance positive semi-definite whatever the rounding.
+ *
+ * The coefficients of the factor are decoded within ErrorBound of s,
+ * so that the decoded covariance is within about
+ * \f$ 2 n \cdot ErrorBound \f$ of its largest variance.
+ * It is decoded to a dense covariance for any computation.
+ *
+ * @tparam _State The state type, of fixed size
+ * @tparam Codec The encoding
+ */
+template <typename _State, CovarianceCodec Codec = CovarianceCodec::Cholesky>
+class CompressedCovariance {
+
+  using codec_traits = internal::covariance_codec_traits<Codec>;
+
+public:
+
+  using State = _State;
+  using Scalar = typename internal::traits<State>::Scalar;
+  using Coefficient = typename codec_traits::Coefficient;
+
+  static constexpr int Size = internal::traits<State>::Size;
+  static constexpr int PackedSize = Size * (Size + 1) / 2;
+
+  //! The error of a decoded coefficient relative to the scale
+  static constexpr double ErrorBound = codec_traits::ErrorBound;
+
+  static_assert(
+    Size != Eigen::Dynamic,
+    "CompressedCovariance: The state must be of fixed size!"
+  );
+
+  using Coefficients = Eigen::Matrix<Coefficient, PackedSize, 1>;
+
+  CompressedCovariance() = default;
+
+  /**
+   * @brief Encode a symmetric positive semi-definite matrix
+   */
+  template <typename _Derived>
+  CompressedCovariance(const Eigen::MatrixBase<_Derived>& P) {
+    encode(P);
+  }
+
+  template <typename _Derived>
+  CompressedCovariance& operator =(const Eigen::MatrixBase<_Derived>& P) {
+    encode(P);
+    return *this;
+  }
+
+  template <typename _Derived>
+  void encode(const Eigen::MatrixBase<_Derived>& P) {
+    if constexpr (Codec == CovarianceCodec::Float) {
+      scale_ = 1.f;
+      for (int j = 0, k = 0; j < Size; ++j) {
+        coeffs_.segment(k, j + 1) =
+          P.col(j).head(j + 1).template cast<Coefficient>();
+        k += j + 1;
+      }
+    } else {
+      using std::sqrt;
+
+      const Covariance<State> M = P;
+      const Scalar max_var = M.diagonal().maxCoeff();
+
+      scale_ = float(sqrt(std::max(max_var, Scalar(0))));
+      if (!(scale_ > 0)) {
+        scale_ = 0.f;
+        coeffs_.setZero();
+        return;
+      }
+
+      // A semi-definite matrix is perturbed within the codec error
+      Eigen::LLT<Covariance<State>> llt(M);
+      if (llt.info() != Eigen::Success) {
+        llt.compute(
+          M + Covariance<State>::Identity() * (max_var * Scalar(ErrorBound))
+        );
+      }
+
+      KALMANIF_ASSERT(
+        llt.info() == Eigen::Success,
+        "CompressedCovariance: The covariance is not positive semi-definite."
+      );
+
+      const Covariance<State> L = llt.matrixL();
+      const Scalar inv_scale = Scalar(1) / Scalar(scale_);
+
+      for (int j = 0, k = 0; j < Size; ++j) {
+        for (int i = j; i < Size; ++i, ++k) {
+          coeffs_(k) = quantize(L(i, j) * inv_scale);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Decode to a dense symmetric matrix
+   */
+  template <typename _Derived>
+  void unpack(Eigen::MatrixBase<_Derived>& P) const {
+    if constexpr (Codec == CovarianceCodec::Float) {
+      for (int j = 0, k = 0; j < Size; ++j) {
+        P.col(j).head(j + 1) =
+          coeffs_.segment(k, j + 1).template cast<Scalar>();
+        k += j + 1;
+      }
+      internal::mirrorUpper(P);
+    } else {
+      Covariance<State> L = Covariance<State>::Zero();
+      for (int j = 0, k = 0; j < Size; ++j) {
+        for (int i = j; i < Size; ++i, ++k) {
+          L(i, j) = dequantize(coeffs_(k));
+        }
+      }
+      P = internal::covarianceProduct(
+        (L * Scalar(scale_)).eval(), Covariance<State>::Identity()
+      );
+    }
+  }
+
+  Covariance<State> unpack() const {
+    Covariance<State> P;
+    unpack(P);
+    return P;
+  }
+
+  const Coefficients& coeffs() const {
+    return coeffs_;
+  }
+
+  float scale() const {
+    return scale_;
+  }
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+protected:
+
+  static Coefficient quantize(const Scalar c) {
+    if constexpr (Codec == CovarianceCodec::Cholesky16) {
+      using std::lround;
+      // |c| <= 1 but for rounding
+      const double clamped = std::min(std::max(double(c), -1.), 1.);
+      return Coefficient(lround(clamped * 32767));
+    } else {
+      return Coefficient(c);
+    }
+  }
+
+  static Scalar dequantize(const Coefficient q) {
+    if constexpr (Codec == CovarianceCodec::Cholesky16) {
+      return Scalar(q) / Scalar(32767);
+    } else {
+      return Scalar(q);
+    }
+  }
+
+  Coefficients coeffs_;
+  float scale_ = 0.f;
+};
+
+namespace internal {
+
+/**
+ * @brief A compressed covariance decoded to a dense one.
+ */
+template <typename State, CovarianceCodec Codec>
+Covariance<State> unpacked(const CompressedCovariance<State, Codec>& P) {
+  return P.unpack();
+}
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_COMPRESSED_COVARIANCE_H_
@@ -0,0 +1,95 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_CONSIDER_STATES_H_
+#define _KALMANIF_KALMANIF_IMPL_CONSIDER_STATES_H_
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief Base class for filters with a Schmidt (consider-state) mode.
+ *
+ * A contiguous block of the state tangent space is 'considered':
+ * its uncertainty is propagated and accounted for in the updates,
+ * but neither its mean nor its own covariance block are corrected.
+ * Only the cross-covariances with the estimated states are updated.
+ *
+ * This is achieved by zeroing the considered rows of the Kalman gain
+ * and updating the covariance with the Joseph form,
+ * which holds for any gain.
+ *
+ * @tparam StateType The state type
+ */
+template <typename StateType>
+struct ConsiderBase {
+
+  /**
+   * @brief Consider the tangent space block [start, start + size).
+   *
+   * @param [in] start The first considered tangent index
+   * @param [in] size The number of considered tangent indices
+   * @throw kalmanif::invalid_argument if the block is out of the state
+   */
+  void setConsideredStates(const int start, const int size) {
+    const bool in_state =
+      start >= 0 && size >= 0 && start + size <= traits<StateType>::Size;
+    KALMANIF_CHECK(
+      in_state,
+      "ConsiderBase::setConsideredStates: Block out of the state!",
+      kalmanif::invalid_argument
+    );
+
+    // In real-time mode the check does not throw
+    if (!in_state) {
+      return;
+    }
+
+    consider_start_ = start;
+    consider_size_ = size;
+  }
+
+  /**
+   * @brief Estimate all states again.
+   */
+  void clearConsideredStates() {
+    consider_start_ = 0;
+    consider_size_ = 0;
+  }
+
+  /**
+   * @brief Whether a block of the state is considered.
+   */
+  bool hasConsideredStates() const {
+    return consider_size_ > 0;
+  }
+
+  //! The first considered tangent index
+  int getConsideredStart() const {
+    return consider_start_;
+  }
+
+  //! The number of considered tangent indices
+  int getConsideredSize() const {
+    return consider_size_;
+  }
+
+protected:
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(ConsiderBase);
+
+  /**
+   * @brief Zero the considered rows of a Kalman gain.
+   */
+  template <typename _DerivedK>
+  void considerGain(Eigen::MatrixBase<_DerivedK>& K) const {
+    if (hasConsideredStates()) {
+      K.middleRows(consider_start_, consider_size_).setZero();
+    }
+  }
+
+  int consider_start_ = 0;
+  int consider_size_ = 0;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_CONSIDER_STATES_H_
@@ -0,0 +1,273 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_CONSISTENCY_MONITOR_H_
+#define _KALMANIF_KALMANIF_IMPL_CONSISTENCY_MONITOR_H_
+
+#include <cmath>
+#include <vector>
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief The quantile of the standard normal distribution
+ * (Abramowitz & Stegun 26.2.23, absolute error below 4.5e-4).
+ *
+ * @param p The probability, in (0, 1)
+ */
+inline double normalQuantile(const double p) {
+  const double q = p < 0.5 ? p : 1. - p;
+  const double t = std::sqrt(-2. * std::log(q));
+  const double z = t - (2.515517 + t * (0.802853 + t * 0.010328)) /
+                       (1. + t * (1.432788 + t * (0.189269 + t * 0.001308)));
+  return p < 0.5 ? -z : z;
+}
+
+/**
+ * @brief The quantile of the chi-squared distribution
+ * (Wilson-Hilferty approximation).
+ *
+ * @param p The probability, in (0, 1)
+ * @param dof The degrees of freedom
+ */
+inline double chiSquaredQuantile(const double p, const double dof) {
+  const double a = 2. / (9. * dof);
+  const double c = 1. - a + normalQuantile(p) * std::sqrt(a);
+  return c > 0 ? dof * c * c * c : 0.;
+}
+
+} // namespace internal
+
+/**
+ * @brief The consistency statistics of a normalized squared error,
+ * e.g. the NIS or the NEES.
+ *
+ * For a consistent filter, the sum of the errors over the window
+ * is chi-squared distributed with the sum of their degrees of freedom.
+ * Dividing by the window size gives the bounds of the window mean.
+ */
+struct ConsistencyStatistics {
+  //! The number of errors since the last reset
+  std::size_t count = 0;
+  //! The mean of the errors since the last reset
+  double mean = 0;
+  //! The number of errors in the window
+  std::size_t window = 0;
+  //! The mean of the errors in the window
+  double window_mean = 0;
+  //! The mean of the degrees of freedom in the window
+  double window_dof = 0;
+  //! The two-sided chi-squared bounds of the window mean
+  double lower = 0, upper = 0;
+
+  /**
+   * @brief Whether the window mean lies within its bounds
+   */
+  bool isConsistent() const {
+    return !(window_mean < lower) && !(window_mean > upper);
+  }
+};
+
+/**
+ * @brief A windowed consistency test of a normalized squared error.
+ *
+ * The errors of the last window are kept in a ring buffer
+ * allocated once, along with their running sums, so that
+ * adding an error is O(1) and the memory does not grow with time.
+ * The chi-squared bounds are only evaluated on query.
+ */
+struct ConsistencyTest {
+
+  /**
+   * @brief Construct a consistency test
+   * @param window The number of errors averaged
+   * @param confidence The probability of the two-sided bounds
+   * @throw kalmanif::invalid_argument if window is zero
+   * or confidence not in (0, 1)
+   */
+  explicit ConsistencyTest(
+    const std::size_t window = 100, const double confidence = 0.95
+  ) : values_(window), dofs_(window), confidence_(confidence) {
+    KALMANIF_CHECK(
+      window > 0,
+      "ConsistencyTest: The window must not be empty!",
+      kalmanif::invalid_argument
+    );
+    KALMANIF_CHECK(
+      confidence > 0 && confidence < 1,
+      "ConsistencyTest: The confidence must be in (0, 1)!",
+      kalmanif::invalid_argument
+    );
+  }
+
+  /**
+   * @brief Add an error
+   * @param value The normalized squared error
+   * @param dof Its degrees of freedom
+   */
+  void add(const double value, const int dof) {
+    ++count_;
+    mean_ += (value - mean_) / double(count_);
+
+    if (size_ == values_.size()) {
+      sum_ -= values_[next_];
+      sum_dof_ -= dofs_[next_];
+    } else {
+      ++size_;
+    }
+
+    values_[next_] = value;
+    dofs_[next_] = dof;
+    sum_ += value;
+    sum_dof_ += dof;
+
+    next_ = (next_ + 1) % values_.size();
+  }
+
+  /**
+   * @brief Get the current statistics
+   */
+  ConsistencyStatistics getStatistics() const {
+    ConsistencyStatistics statistics;
+    statistics.count = count_;
+    statistics.mean = mean_;
+    statistics.window = size_;
+
+    if (size_ == 0) {
+      return statistics;
+    }
+
+    const double n = double(size_);
+    statistics.window_mean = sum_ / n;
+    statistics.window_dof = double(sum_dof_) / n;
+
+    const double alpha = (1. - confidence_) / 2.;
+    statistics.lower =
+      internal::chiSquaredQuantile(alpha, double(sum_dof_)) / n;
+    statistics.upper =
+      internal::chiSquaredQuantile(1. - alpha, double(sum_dof_)) / n;
+
+    return statistics;
+  }
+
+  /**
+   * @brief Forget all errors
+   */
+  void reset() {
+    count_ = size_ = next_ = 0;
+    mean_ = sum_ = 0;
+    sum_dof_ = 0;
+  }
+
+protected:
+
+  std::vector<double> values_;
+  std::vector<int> dofs_;
+  double confidence_;
+
+  std::size_t count_ = 0, size_ = 0, next_ = 0;
+  double mean_ = 0, sum_ = 0;
+  long sum_dof_ = 0;
+};
+
+/**
+ * @brief An online consistency monitor of a filter.
+ *
+ * The Normalized Innovation Squared (NIS) is read from the filter
+ * after each update, where it is computed anyway from the
+ * decomposed innovation covariance.
+ * The Normalized Estimation Error Squared (NEES) is computed when
+ * the ground truth is available, reusing the cached square root
+ * of the filter covariance.
+ *
+ * @code
+ * ConsistencyMonitor monitor(100);
+ * ekf.update(h, y);
+ * monitor.addNIS(ekf);
+ * monitor.addNEES(ekf, X_true);
+ * if (!monitor.getNIS().isConsistent()) { ... }
+ * @endcode
+ *
+ * @see ConsistencyTest
+ */
+struct ConsistencyMonitor {
+
+  /**
+   * @brief Construct a consistency monitor
+   * @param window The number of errors averaged
+   * @param confidence The probability of the two-sided bounds
+   */
+  explicit ConsistencyMonitor(
+    const std::size_t window = 100, const double confidence = 0.95
+  ) : nis_(window, confidence), nees_(window, confidence) {}
+
+  /**
+   * @brief Add the NIS of the last update of a filter.
+   *
+   * The filter must expose getNormalizedInnovationSquared,
+   * e.g. the ExtendedKalmanFilter or InvariantExtendedKalmanFilter.
+   *
+   * @note The innovation of a sequential update
+   * (see internal::has_diagonal_noise) is not stored by the filter.
+   */
+  template <typename Filter>
+  void addNIS(const Filter& filter) {
+    addNIS(
+      double(filter.getNormalizedInnovationSquared()),
+      int(filter.getInnovation().size())
+    );
+  }
+
+  void addNIS(const double nis, const int dof) {
+    nis_.add(nis, dof);
+  }
+
+  /**
+   * @brief Add the NEES of the current estimate of a filter
+   *
+   * The error is expressed in the tangent space of the filter
+   * covariance, i.e. left for the right-invariant filters.
+   *
+   * @param filter The filter
+   * @param X_true The ground truth state
+   */
+  template <typename Filter>
+  void addNEES(
+    const Filter& filter, const typename internal::traits<Filter>::State& X_true
+  ) {
+    using State = typename internal::traits<Filter>::State;
+    using Tangent = typename State::Tangent;
+
+    const State& X_est = filter.getState();
+    Tangent e = internal::is_right_invariant<Filter>::value ?
+      X_est.lminus(X_true) : X_est.rminus(X_true);
+
+    // e^T.P^{-1}.e = |L^{-1}.e|^2 with P = L.L^T
+    filter.getCovarianceSquareRoot().matrixL().solveInPlace(e.coeffs());
+
+    addNEES(double(e.coeffs().squaredNorm()), int(State::DoF));
+  }
+
+  void addNEES(const double nees, const int dof) {
+    nees_.add(nees, dof);
+  }
+
+  ConsistencyStatistics getNIS() const {
+    return nis_.getStatistics();
+  }
+
+  ConsistencyStatistics getNEES() const {
+    return nees_.getStatistics();
+  }
+
+  void reset() {
+    nis_.reset();
+    nees_.reset();
+  }
+
+protected:
+
+  ConsistencyTest nis_, nees_;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_CONSISTENCY_MONITOR_H_
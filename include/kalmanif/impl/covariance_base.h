@@ -7,12 +7,26 @@ namespace internal {
 /**
  * @brief Base class for objects with Covariance
  *
+ * The covariance square root is cached. It is computed at
+ * setCovariance time and recomputed lazily only if the covariance
+ * was modified in the meantime (see invalidateCovarianceSquareRoot).
+ *
  * @tparam StateType The state type
  */
 template <typename StateType>
 struct CovarianceBase {
 public:
 
+  /**
+   * @brief The covariance recorded by a filter snapshot,
+   * with its cached square root
+   */
+  struct CovarianceSnapshot {
+    Covariance<StateType> P;
+    CovarianceSquareRoot<StateType> S;
+    bool is_sqrt_valid = false;
+  };
+
   /**
    * @brief Get covariance
    */
@@ -34,14 +48,23 @@ public:
       "CovarianceBase: Not a covariance matrix!"
     );
     P = covariance;
+    S_.compute(P);
+    is_sqrt_valid_ = true;
     return true;
   }
 
   /**
    * @brief Get covariance (as square root)
+   *
+   * @note The decomposition is only computed
+   * if the covariance changed since the last call.
    */
-  CovarianceSquareRoot<StateType> getCovarianceSquareRoot() const {
-    return CovarianceSquareRoot<StateType>(P);
+  const CovarianceSquareRoot<StateType>& getCovarianceSquareRoot() const {
+    if (!is_sqrt_valid_) {
+      S_.compute(P);
+      is_sqrt_valid_ = true;
+    }
+    return S_;
   }
 
   /**
@@ -55,7 +78,9 @@ public:
   ) {
     CovarianceSquareRoot<StateType> S;
     S.setL(covariance_square_root);
-    return setCovariance(S.reconstructedMatrix());
+    setCovariance(S.reconstructedMatrix());
+    S_ = S;
+    return true;
   }
 
 protected:
@@ -64,8 +89,51 @@ protected:
   CovarianceBase(const Eigen::Ref<const Covariance<StateType>>& covariance)
     : P(covariance) {}
 
+  /**
+   * @brief Invalidate the cached covariance square root.
+   * Must be called whenever the covariance P is modified directly.
+   */
+  void invalidateCovarianceSquareRoot() {
+    is_sqrt_valid_ = false;
+  }
+
+  /**
+   * @brief Repair the covariance P in place at a bounded cost.
+   * The Cholesky decomposition of the repair is kept
+   * as the cached covariance square root.
+   *
+   * @return The repair that was needed
+   * @see kalmanif::repairCovariance
+   */
+  CovarianceRepair repairCovariance() {
+    const CovarianceRepair repair = kalmanif::repairCovariance(P, S_);
+    is_sqrt_valid_ = repair != CovarianceRepair::Failed;
+    return repair;
+  }
+
+  void snapshotCovariance(CovarianceSnapshot& snapshot) const {
+    snapshot.P = P;
+    snapshot.is_sqrt_valid = is_sqrt_valid_;
+    if (is_sqrt_valid_) {
+      snapshot.S = S_;
+    }
+  }
+
+  void rollbackCovariance(const CovarianceSnapshot& snapshot) {
+    P = snapshot.P;
+    is_sqrt_valid_ = snapshot.is_sqrt_valid;
+    if (is_sqrt_valid_) {
+      S_ = snapshot.S;
+    }
+  }
+
   //! Covariance
-  Covariance<StateType> P = Covariance<StateType>::Identity() * 1e3;
+  Covariance<StateType> P =
+    Covariance<StateType>::Identity() * typename StateType::Scalar(1e3);
+
+  //! Cached covariance square root
+  mutable CovarianceSquareRoot<StateType> S_;
+  mutable bool is_sqrt_valid_ = false;
 };
 
 } // internal
@@ -0,0 +1,379 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_COVARIANCE_INTERSECTION_H_
+#define _KALMANIF_KALMANIF_IMPL_COVARIANCE_INTERSECTION_H_
+
+namespace kalmanif {
+
+/**
+ * @brief A state estimate, its mean and covariance.
+ *
+ * The covariance is expressed in the (right) tangent space at the mean.
+ *
+ * @tparam StateType The state type
+ */
+template <typename StateType>
+struct Estimate {
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  using State = StateType;
+
+  State state;
+  Covariance<State> covariance;
+};
+
+/**
+ * @brief A state estimate fused by split covariance intersection.
+ *
+ * Its covariance is the sum of a part correlated with other
+ * estimates (dependent) and of an independent one.
+ *
+ * @tparam StateType The state type
+ */
+template <typename StateType>
+struct SplitEstimate : Estimate<StateType> {
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  using typename Estimate<StateType>::State;
+
+  //! The independent part of the covariance
+  Covariance<State> independent;
+};
+
+namespace internal {
+
+/**
+ * @brief Express the covariance of an estimate in the tangent space
+ * at a reference state.
+ *
+ * @param [in] x The estimate mean
+ * @param [in] P The covariance at x
+ * @param [in] x_ref The reference state
+ * @param [out] e The tangent error x - x_ref
+ * @return The covariance of e
+ */
+template <typename State>
+Covariance<State> transportCovariance(
+  const State& x,
+  const Eigen::Ref<const Covariance<State>>& P,
+  const State& x_ref,
+  typename State::Tangent& e
+) {
+  e = x.rminus(x_ref);
+  const Jacobian<State, State> J = e.rjacinv();
+  return J * P * J.transpose();
+}
+
+/**
+ * @brief Invert a covariance, i.e. compute an information matrix.
+ *
+ * @throw kalmanif::runtime_error if the covariance is not positive definite
+ */
+template <typename _Derived>
+typename _Derived::PlainObject
+informationFromCovariance(const Eigen::MatrixBase<_Derived>& P) {
+  using Matrix = typename _Derived::PlainObject;
+
+  const Eigen::LLT<Matrix> llt(P);
+
+  KALMANIF_CHECK(
+    llt.info() == Eigen::Success,
+    "CovarianceIntersection: Covariance is not positive definite!",
+    kalmanif::runtime_error
+  );
+
+  return llt.solve(Matrix::Identity(P.rows(), P.cols()));
+}
+
+/**
+ * @brief The log-determinant of a positive definite matrix.
+ */
+template <typename _Derived>
+typename _Derived::Scalar
+logDeterminant(const Eigen::MatrixBase<_Derived>& A) {
+  const Eigen::LLT<typename _Derived::PlainObject> llt(A);
+  return 2 * llt.matrixLLT().diagonal().array().log().sum();
+}
+
+} // namespace internal
+
+/**
+ * @brief The closed-form covariance intersection weight
+ * of the 'improved fast CI' (Franken & Hupper, 2005),
+ * \f$ \omega = \frac{1}{2} + \frac{|I_a| - |I_b|}{2|I_a + I_b|} \f$,
+ * where \f$ I_a, I_b \f$ are the informations of the estimates.
+ *
+ * The determinant ratios are evaluated from log-determinants.
+ *
+ * @param [in] I_a The information of the first estimate
+ * @param [in] I_b The information of the second estimate
+ * @return The weight of the first estimate in [0, 1]
+ */
+template <typename _DerivedA, typename _DerivedB>
+typename _DerivedA::Scalar fastIntersectionWeight(
+  const Eigen::MatrixBase<_DerivedA>& I_a,
+  const Eigen::MatrixBase<_DerivedB>& I_b
+) {
+  using std::exp;
+
+  using Scalar = typename _DerivedA::Scalar;
+
+  const Scalar log_det_ab = internal::logDeterminant(I_a + I_b);
+  const Scalar r_a = exp(internal::logDeterminant(I_a) - log_det_ab);
+  const Scalar r_b = exp(internal::logDeterminant(I_b) - log_det_ab);
+
+  const Scalar w = Scalar(0.5) * (1 + r_a - r_b);
+
+  return std::min(Scalar(1), std::max(Scalar(0), w));
+}
+
+/**
+ * @brief Fuse two estimates with unknown correlations
+ * by covariance intersection,
+ * \f$ P^{-1} = \omega P_a^{-1} + (1 - \omega) P_b^{-1} \f$.
+ *
+ * The fusion is performed in the tangent space at the first estimate:
+ * the covariance of b is transported there,
+ * the fused correction \f$ \delta \f$ is applied with
+ * \f$ x = x_a \oplus \delta \f$ and the fused covariance
+ * is then transported to x.
+ *
+ * @param [in] a The first estimate, the fusion reference
+ * @param [in] b The second estimate
+ * @param [in] omega The weight of a in [0, 1],
+ * a negative value selects fastIntersectionWeight
+ * @return The fused estimate
+ * @throw kalmanif::invalid_argument if omega is greater than 1
+ *
+ * @see fastIntersectionWeight
+ */
+template <typename State>
+Estimate<State> covarianceIntersection(
+  const Estimate<State>& a,
+  const Estimate<State>& b,
+  double omega = -1
+) {
+  using Scalar = typename internal::traits<State>::Scalar;
+  using Tangent = typename State::Tangent;
+
+  Tangent e;
+  const Covariance<State> P_b =
+    internal::transportCovariance(b.state, b.covariance, a.state, e);
+
+  const Covariance<State> I_a =
+    internal::informationFromCovariance(a.covariance);
+  const Covariance<State> I_b =
+    internal::informationFromCovariance(P_b);
+
+  const Scalar w = omega < 0 ?
+    fastIntersectionWeight(I_a, I_b) : Scalar(omega);
+
+  KALMANIF_CHECK(
+    w <= 1,
+    "covarianceIntersection: omega must be in [0, 1]!",
+    kalmanif::invalid_argument
+  );
+
+  const Eigen::LLT<Covariance<State>> llt(w * I_a + (1 - w) * I_b);
+
+  const Covariance<State> P = llt.solve(Covariance<State>::Identity());
+  const Tangent dx(llt.solve((1 - w) * I_b * e.coeffs()));
+
+  const Jacobian<State, State> J = dx.rjacinv();
+
+  Estimate<State> fused;
+  fused.state = a.state + dx;
+  fused.covariance = J * P * J.transpose();
+
+  return fused;
+}
+
+/**
+ * @brief Fuse two estimates by split covariance intersection.
+ *
+ * Each covariance is the sum of a dependent part, of unknown correlation
+ * with the other estimate, and of an independent part.
+ * The dependent parts are inflated as in covariance intersection,
+ * \f$ P_a' = P_{a,d} / \omega + P_{a,i} \f$,
+ * \f$ P_b' = P_{b,d} / (1 - \omega) + P_{b,i} \f$,
+ * and the estimates are then fused as independent ones.
+ *
+ * @param [in] a The first estimate, the fusion reference
+ * @param [in] P_a_independent The independent part of a's covariance
+ * @param [in] b The second estimate
+ * @param [in] P_b_independent The independent part of b's covariance
+ * @param [in] omega The weight of a in (0, 1),
+ * a negative value selects fastIntersectionWeight on the full covariances
+ * @throw kalmanif::invalid_argument if omega is not in (0, 1)
+ * @return The fused estimate and the independent part of its covariance
+ */
+template <typename State>
+SplitEstimate<State> splitCovarianceIntersection(
+  const Estimate<State>& a,
+  const Eigen::Ref<const Covariance<State>>& P_a_independent,
+  const Estimate<State>& b,
+  const Eigen::Ref<const Covariance<State>>& P_b_independent,
+  double omega = -1
+) {
+  using Scalar = typename internal::traits<State>::Scalar;
+  using Tangent = typename State::Tangent;
+
+  Tangent e;
+  const Covariance<State> P_b =
+    internal::transportCovariance(b.state, b.covariance, a.state, e);
+  const Covariance<State> P_bi =
+    internal::transportCovariance(b.state, P_b_independent, a.state, e);
+
+  // Keep the automatic weight off the bounds
+  const Scalar eps = std::sqrt(Eigen::NumTraits<Scalar>::epsilon());
+  const Scalar w = omega < 0 ? std::min(Scalar(1) - eps, std::max(eps,
+    fastIntersectionWeight(
+      internal::informationFromCovariance(a.covariance),
+      internal::informationFromCovariance(P_b)
+    )
+  )) : Scalar(omega);
+
+  KALMANIF_CHECK(
+    w > 0 && w < 1,
+    "splitCovarianceIntersection: omega must be in (0, 1)!",
+    kalmanif::invalid_argument
+  );
+
+  const Covariance<State> I_a = internal::informationFromCovariance(
+    (a.covariance - P_a_independent) / w + P_a_independent
+  );
+  const Covariance<State> I_b = internal::informationFromCovariance(
+    (P_b - P_bi) / (1 - w) + P_bi
+  );
+
+  const Eigen::LLT<Covariance<State>> llt(I_a + I_b);
+
+  const Covariance<State> P = llt.solve(Covariance<State>::Identity());
+  const Tangent dx(llt.solve(I_b * e.coeffs()));
+
+  // Independent part, P.(I_a.P_ai.I_a + I_b.P_bi.I_b).P
+  const Covariance<State> P_i = P * (
+    I_a * P_a_independent * I_a + I_b * P_bi * I_b
+  ) * P;
+
+  const Jacobian<State, State> J = dx.rjacinv();
+
+  SplitEstimate<State> fused;
+  fused.state = a.state + dx;
+  fused.covariance = J * P * J.transpose();
+  fused.independent = J * P_i * J.transpose();
+
+  return fused;
+}
+
+/**
+ * @brief The size in bytes of an encoded Estimate, its state coefficients
+ * followed by the upper triangle of its covariance.
+ */
+template <typename State>
+constexpr std::size_t encodedEstimateSize() {
+  constexpr std::size_t DoF = State::DoF;
+  return (State::RepSize + DoF * (DoF + 1) / 2) *
+    sizeof(typename internal::traits<State>::Scalar);
+}
+
+/**
+ * @brief The compact wire format of an Estimate.
+ *
+ * The state coefficients followed by the column-major upper triangle
+ * of the covariance, in the host byte order.
+ */
+template <typename State>
+using EncodedEstimate = std::array<std::uint8_t, encodedEstimateSize<State>()>;
+
+/**
+ * @brief Encode a state and its covariance in the compact wire format
+ * of an Estimate, in place.
+ *
+ * @param [in] state The state
+ * @param [in] covariance The state covariance
+ * @param [out] data The buffer to encode to,
+ * of at least encodedEstimateSize bytes.
+ *
+ * @see EncodedEstimate
+ */
+template <typename State>
+void encodeEstimate(
+  const State& state, const Covariance<State>& covariance, std::uint8_t* data
+) {
+  using Scalar = typename internal::traits<State>::Scalar;
+
+  std::size_t bytes = State::RepSize * sizeof(Scalar);
+  std::memcpy(data, state.coeffs().data(), bytes);
+  data += bytes;
+
+  for (int c = 0; c < State::DoF; ++c) {
+    bytes = (c + 1) * sizeof(Scalar);
+    std::memcpy(data, covariance.col(c).data(), bytes);
+    data += bytes;
+  }
+}
+
+/**
+ * @brief Encode an estimate in its compact wire format.
+ *
+ * @see EncodedEstimate
+ */
+template <typename State>
+EncodedEstimate<State> encodeEstimate(const Estimate<State>& estimate) {
+  EncodedEstimate<State> buffer;
+  encodeEstimate(estimate.state, estimate.covariance, buffer.data());
+  return buffer;
+}
+
+/**
+ * @brief Decode an estimate from its compact wire format.
+ *
+ * @param [in] data The encoded estimate
+ * @param [in] size The size in bytes of data
+ * @throw kalmanif::invalid_argument if size is not encodedEstimateSize
+ *
+ * @see EncodedEstimate
+ */
+template <typename State>
+Estimate<State> decodeEstimate(
+  const std::uint8_t* data, const std::size_t size
+) {
+  using Scalar = typename internal::traits<State>::Scalar;
+
+  KALMANIF_ENSURE(
+    size == encodedEstimateSize<State>(),
+    "decodeEstimate: Wrong encoded estimate size!",
+    kalmanif::invalid_argument
+  );
+
+  Estimate<State> estimate;
+
+  std::size_t bytes = State::RepSize * sizeof(Scalar);
+  std::memcpy(estimate.state.coeffs().data(), data, bytes);
+  data += bytes;
+
+  for (int c = 0; c < State::DoF; ++c) {
+    bytes = (c + 1) * sizeof(Scalar);
+    std::memcpy(estimate.covariance.col(c).data(), data, bytes);
+    data += bytes;
+  }
+
+  estimate.covariance.template triangularView<Eigen::StrictlyLower>() =
+    estimate.covariance.template triangularView<Eigen::StrictlyUpper>()
+      .transpose();
+
+  return estimate;
+}
+
+/**
+ * @brief Decode an estimate from its compact wire format.
+ */
+template <typename State>
+Estimate<State> decodeEstimate(const EncodedEstimate<State>& buffer) {
+  return decodeEstimate<State>(buffer.data(), buffer.size());
+}
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_COVARIANCE_INTERSECTION_H_
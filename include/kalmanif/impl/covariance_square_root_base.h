@@ -14,6 +14,13 @@ struct CovarianceSquareRootBase {
 
 public:
 
+  /**
+   * @brief The covariance square root recorded by a filter snapshot
+   */
+  struct CovarianceSnapshot {
+    CovarianceSquareRoot<StateType> S;
+  };
+
   /**
    * @brief Get the reconstructed covariance matrix
    */
@@ -52,7 +59,6 @@ public:
   bool setCovarianceSquareRoot(
     const Covariance<StateType>& covariance_square_root
   ) {
-    CovarianceSquareRoot<StateType> S;
     S.setL(covariance_square_root);
 
     KALMANIF_ASSERT(isCovariance(S.reconstructedMatrix()));
@@ -64,6 +70,14 @@ protected:
 
   KALMANIF_DEFAULT_CONSTRUCTOR(CovarianceSquareRootBase);
 
+  void snapshotCovariance(CovarianceSnapshot& snapshot) const {
+    snapshot.S = S;
+  }
+
+  void rollbackCovariance(const CovarianceSnapshot& snapshot) {
+    S = snapshot.S;
+  }
+
   //! Covariance square root
   CovarianceSquareRoot<StateType> S =
     CovarianceSquareRoot<StateType>::Identity();
@@ -0,0 +1,544 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_DYNAMIC_EXTENDED_KALMAN_FILTER_H_
+#define _KALMANIF_KALMANIF_IMPL_DYNAMIC_EXTENDED_KALMAN_FILTER_H_
+
+namespace kalmanif {
+
+// Forward declaration
+template <typename Derived> struct SystemModelBase;
+
+/**
+ * @brief The DynamicExtendedKalmanFilter
+ *
+ * An Extended Kalman Filter on a state whose size is only known at
+ * run time and may change, e.g. an AugmentedState.
+ *
+ * The covariance and all temporaries live in buffers allocated once
+ * at a given capacity (see Workspace and reserve), the filter working
+ * on their top-left corner of the current state dimension.
+ * A steady-state step thus does not allocate, even when the state
+ * dimension changes, as long as it stays within the capacity.
+ *
+ * The system and measurement models are called with jacobians
+ * that are views on the workspace, i.e.
+ * - Eigen::Ref<Jacobian<State, State>> F, with State::dim() columns,
+ * - Eigen::Ref<Jacobian<State, Control>> W,
+ * - Eigen::Ref<Jacobian<Measurement, State>> H.
+ *
+ * Models declaring a block-sparse jacobian on an AugmentedState,
+ * e.g. an EKF-SLAM whose propagation only moves the pose and whose
+ * updates only observe the pose and one landmark, are only asked
+ * for their non-zero blocks. The filter then only touches the
+ * corresponding rows and columns of the covariance, propagating in
+ * \f$ O(p^2 n) \f$ and updating in \f$ O(m n^2) \f$ rather than
+ * \f$ O(n^3) \f$, with p the pose dimension.
+ * The same holds on a CalibratedState, whose sensor calibrations
+ * are static and each only observed by its own sensor.
+ *
+ * @see internal::has_pose_block_jacobian
+ * @see internal::has_landmark_block_jacobian
+ *
+ * @tparam StateType The dynamic-size state type
+ */
+template <typename StateType>
+struct DynamicExtendedKalmanFilter
+  : public internal::KalmanFilterBase<DynamicExtendedKalmanFilter<StateType>> {
+
+  using Base =
+    internal::KalmanFilterBase<DynamicExtendedKalmanFilter<StateType>>;
+
+  using typename Base::State;
+  using typename Base::Scalar;
+  using Base::getState;
+  using Base::setValidation;
+  using Base::getValidation;
+  using Base::getValidationPeriod;
+
+  using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+  using CovarianceView = Eigen::Block<const Matrix>;
+
+  static_assert(
+    internal::traits<State>::Size == Eigen::Dynamic,
+    "DynamicExtendedKalmanFilter: The state must be dynamic-size."
+  );
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(DynamicExtendedKalmanFilter);
+
+  /**
+   * @brief Construct a new Dynamic Extended Kalman Filter object given
+   * an initial state and state covariance, and the workspace capacities.
+   *
+   * @param state_init The initial state
+   * @param cov_init The initial state covariance
+   * @param state_capacity The maximum state dimension
+   * @param measurement_capacity The maximum measurement dimension
+   * @param control_capacity The maximum control dimension
+   */
+  DynamicExtendedKalmanFilter(
+    const State& state_init,
+    const Eigen::Ref<const Matrix>& cov_init,
+    const int state_capacity,
+    const int measurement_capacity,
+    const int control_capacity
+  ) {
+    reserve(state_capacity, measurement_capacity, control_capacity);
+    setState(state_init);
+    setCovariance(cov_init);
+  }
+
+  /**
+   * @brief Grow the covariance and workspace capacities.
+   *
+   * @note This is the only function that allocates,
+   * apart from addLandmark beyond the capacity.
+   */
+  void reserve(
+    const int state_capacity,
+    const int measurement_capacity,
+    const int control_capacity
+  ) {
+    workspace_.reserve(
+      state_capacity, measurement_capacity, control_capacity
+    );
+
+    const int capacity = workspace_.stateCapacity();
+    if (P_.rows() < capacity) {
+      P_.conservativeResize(capacity, capacity);
+    }
+  }
+
+  const Workspace<Scalar>& getWorkspace() const {
+    return workspace_;
+  }
+
+  /**
+   * @brief Set the state.
+   *
+   * @note The covariance must then be set to the new state dimension.
+   */
+  void setState(const State& state) {
+    Base::setState(state);
+  }
+
+  /**
+   * @brief Get the covariance, a view of the current state dimension.
+   */
+  CovarianceView getCovariance() const {
+    const int n = x.dim();
+    return CovarianceView(P_, 0, 0, n, n);
+  }
+
+  /**
+   * @brief Set the covariance
+   * @param [in] covariance The input covariance, of the state dimension
+   */
+  bool setCovariance(const Eigen::Ref<const Matrix>& covariance) {
+    const int n = x.dim();
+    const bool sizes_match = covariance.rows() == n && covariance.cols() == n;
+    KALMANIF_CHECK(
+      sizes_match,
+      "DEKF: Covariance size mismatch!",
+      kalmanif::invalid_argument
+    );
+
+    // In real-time mode the check does not throw
+    if (!sizes_match) {
+      return false;
+    }
+
+    KALMANIF_ASSERT(
+      isCovariance(covariance),
+      "DEKF: Not a covariance matrix!"
+    );
+    if (P_.rows() < n) {
+      reserve(n, workspace_.measurementCapacity(), workspace_.controlCapacity());
+    }
+    P_.topLeftCorner(n, n) = covariance;
+    return true;
+  }
+
+  /**
+   * @brief Append a landmark to the state, initializing its covariance
+   * \f$ P_{ll} = G P G^T + R \f$ and its cross-covariance
+   * \f$ P_{xl} = P G^T \f$ with the state.
+   *
+   * @param [in] landmark The landmark
+   * @param [in] G The jacobian of the landmark wrt the state,
+   * zero for a landmark independent of the state
+   * @param [in] R The landmark initialization noise
+   * @return The index of the new landmark,
+   * -1 if the sizes mismatch in real-time mode
+   */
+  template <typename _DerivedL, typename _DerivedG, typename _DerivedR>
+  int addLandmark(
+    const Eigen::MatrixBase<_DerivedL>& landmark,
+    const Eigen::MatrixBase<_DerivedG>& G,
+    const Eigen::MatrixBase<_DerivedR>& R
+  ) {
+    constexpr int D = State::LandmarkDim;
+    const int n = x.dim();
+
+    const bool sizes_match = G.rows() == D && G.cols() == n;
+    KALMANIF_CHECK(
+      sizes_match,
+      "DEKF::addLandmark: Jacobian size mismatch!",
+      kalmanif::invalid_argument
+    );
+
+    // In real-time mode the check does not throw
+    if (!sizes_match) {
+      return -1;
+    }
+
+    if (P_.rows() < n + D) {
+      reserve(
+        n + D, workspace_.measurementCapacity(), workspace_.controlCapacity()
+      );
+    }
+
+    const auto P = P_.topLeftCorner(n, n);
+    auto P_xl = P_.block(0, n, n, D);
+
+    P_xl.noalias() = P * G.transpose();
+    P_.block(n, 0, D, n) = P_xl.transpose();
+    P_.block(n, n, D, D) = R;
+    P_.block(n, n, D, D).noalias() += G * P_xl;
+
+    return x.addLandmark(landmark);
+  }
+
+  /**
+   * @brief Remove the i-th landmark from the state and its covariance.
+   */
+  void removeLandmark(const int i) {
+    constexpr int D = State::LandmarkDim;
+    const int n = x.dim();
+    const int b = State::PoseDoF + i * D;
+    const int tail = n - b - D;
+
+    // Shift the following rows and columns in place.
+    // Copying forward to a lower address never reads overwritten data.
+    for (int j = 0; j < tail; ++j) {
+      P_.col(b + j).head(n) = P_.col(b + D + j).head(n);
+    }
+    for (int j = 0; j < n - D; ++j) {
+      auto col = P_.col(j);
+      for (int k = 0; k < tail; ++k) {
+        col(b + k) = col(b + D + k);
+      }
+    }
+
+    x.removeLandmark(i);
+  }
+
+protected:
+
+  using Base::x;
+  using Base::validateCovariance;
+
+  friend Base;
+
+  /**
+   * @brief Perform filter propagation step using the input control \f$u\f$
+   * and corresponding system model \f$f\f$
+   *
+   * @tparam SystemModelDerived The derived system model
+   * @tparam Args Variadic list of input arguments for the system model
+   * @param [in] f The linearized system model
+   * @param [in] u The input control
+   * @param [in] args input arguments for the system model
+   * @return The propagated state
+   */
+  template <class SystemModelDerived, typename... Args>
+  const State& propagate_impl(
+    const Linearized<SystemModelBase<SystemModelDerived>>& f,
+    const typename internal::traits<SystemModelDerived>::Control& u,
+    Args&&... args
+  ) {
+    if constexpr (internal::has_pose_block_jacobian<SystemModelDerived>{}) {
+      return propagatePoseBlock(f, u, std::forward<Args>(args)...);
+    } else {
+      using Control = typename internal::traits<SystemModelDerived>::Control;
+      constexpr int C = internal::traits<Control>::Size;
+
+      const int n = x.dim();
+
+      auto F = workspace_.F(n);
+      auto W = workspace_.W(n, C);
+
+      // propagate state, in place
+      f.into(x, u, x, F, W, std::forward<Args>(args)...);
+
+      // propagate covariance
+      // P = F.P.F^T + W.Q.W^T
+      auto P = P_.topLeftCorner(n, n);
+      auto FP = workspace_.NN(n);
+      auto WQ = workspace_.NC(n, C);
+
+      FP.noalias() = F * P;
+      P.noalias() = FP * F.transpose();
+      WQ.noalias() = W * f.getCovariance();
+      P.noalias() += WQ * W.transpose();
+
+      validateCovariance(
+        P,
+        "DEKF::propagate: Updated matrix P is not a covariance."
+      );
+
+      return getState();
+    }
+  }
+
+  /**
+   * @brief Propagation with a system model whose jacobians are
+   * \f$ F = diag(F_{pose}, I) \f$ and \f$ W = [W_{pose}; 0] \f$.
+   *
+   * Only the pose rows and columns of the covariance change,
+   * \f$ P_{pp} = F_p P_{pp} F_p^T + W_p Q W_p^T \f$ and
+   * \f$ P_{pl} = F_p P_{pl} \f$.
+   */
+  template <class SystemModelDerived, typename... Args>
+  const State& propagatePoseBlock(
+    const Linearized<SystemModelBase<SystemModelDerived>>& f,
+    const typename internal::traits<SystemModelDerived>::Control& u,
+    Args&&... args
+  ) {
+    using Control = typename internal::traits<SystemModelDerived>::Control;
+    constexpr int C = internal::traits<Control>::Size;
+    constexpr int p = State::PoseDoF;
+
+    const int n = x.dim();
+    const int l = n - p;
+
+    auto F = workspace_.F(p);
+    auto W = workspace_.W(p, C);
+
+    // propagate state, in place
+    f.pose_into(x, u, x, F, W, std::forward<Args>(args)...);
+
+    // propagate covariance
+    auto P = P_.topLeftCorner(n, n);
+    auto FP = workspace_.NN(p, n);
+    auto WQ = workspace_.NC(p, C);
+
+    FP.noalias() = F * P.topRows(p);
+    P.topRightCorner(p, l) = FP.rightCols(l);
+    P.bottomLeftCorner(l, p) = FP.rightCols(l).transpose();
+    P.topLeftCorner(p, p).noalias() = FP.leftCols(p) * F.transpose();
+    WQ.noalias() = W * f.getCovariance();
+    P.topLeftCorner(p, p).noalias() += WQ * W.transpose();
+
+    validateCovariance(
+      P,
+      "DEKF::propagate: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform filter update step using measurement \f$y\f$
+   * and corresponding measurement model
+   *
+   * @tparam MeasurementModelDerived
+   * @param [in] h The linearized measurement model
+   * @param [in] y The measurement vector
+   * @return The updated state estimate
+   */
+  template <class MeasurementModelDerived>
+  const State& update_impl(
+    const Linearized<MeasurementModelBase<MeasurementModelDerived>>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y
+  ) {
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+    constexpr int M = internal::traits<Measurement>::Size;
+
+    constexpr int p = State::PoseDoF;
+
+    const int n = x.dim();
+
+    Jacobian<Measurement, Measurement> V;
+
+    if constexpr (
+      internal::has_landmark_block_jacobian<MeasurementModelDerived>{}
+    ) {
+      constexpr int D =
+        internal::jacobian_block_size<MeasurementModelDerived, State>::value;
+
+      auto H = workspace_.H(M, p + D);
+      auto H_pose = H.leftCols(p);
+      auto H_landmark = H.rightCols(D);
+
+      const Measurement z =
+        y - h.run_linearized_blocks(x, H_pose, H_landmark, V);
+
+      const Covariance<Measurement> MRMt =
+        V * h.getCovariance() * V.transpose();
+
+      correctBlocks(H_pose, H_landmark, h.getColumn(), MRMt, z);
+    } else if constexpr (
+      internal::has_pose_block_jacobian<MeasurementModelDerived>{}
+    ) {
+      auto H = workspace_.H(M, p);
+
+      const Measurement z = y - h.run_linearized_pose(x, H, V);
+
+      const Covariance<Measurement> MRMt =
+        V * h.getCovariance() * V.transpose();
+
+      correctBlocks(H, H.rightCols(0), p, MRMt, z);
+    } else {
+      auto H = workspace_.H(M, n);
+
+      // compute expectation and innovation
+      const Measurement z = y - h(x, H, V);
+
+      const Covariance<Measurement> MRMt =
+        V * h.getCovariance() * V.transpose();
+
+      correct(H, MRMt, z);
+    }
+
+    validateCovariance(
+      P_.topLeftCorner(n, n),
+      "DEKF::update: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Correct the state estimate and its covariance
+   * given an innovation, its jacobian and noise.
+   *
+   * @param [in] H The measurement jacobian, a workspace view
+   * @param [in] MRMt The measurement noise covariance
+   * @param [in] z The innovation
+   */
+  template <typename _DerivedH, typename _DerivedR, typename _DerivedZ>
+  void correct(
+    const Eigen::MatrixBase<_DerivedH>& H,
+    const Eigen::MatrixBase<_DerivedR>& MRMt,
+    const Eigen::MatrixBase<_DerivedZ>& z
+  ) {
+    using Innovation = typename _DerivedZ::PlainObject;
+    constexpr int M = Innovation::RowsAtCompileTime;
+
+    const int n = x.dim();
+
+    auto P = P_.topLeftCorner(n, n);
+    auto HP = workspace_.MN(M, n);
+    auto K = workspace_.K(n, M);
+
+    // S = H.(H.P)^T + R with P symmetric
+    HP.noalias() = H * P;
+    SquareMatrix<Scalar, M> S = MRMt;
+    S.noalias() += HP * H.transpose();
+
+    // compute kalman gain, solve using the decomposition
+    // S.K^T = H.P with S = H.P.H^T + R symmetric
+    const Eigen::LLT<SquareMatrix<Scalar, M>> llt(S);
+    llt.solveInPlace(HP);
+    K = HP.transpose();
+
+    // Update state using computed kalman gain and innovation
+    auto dx = workspace_.dx(n);
+    dx.noalias() = K * z;
+    x += dx;
+
+    // Update covariance
+    // Use the 'Joseph' equation which is numerically more stable
+    // P = (I - K.H).P.(I - K.H)^T + K.R.K^T
+    auto IKH = workspace_.NN(n);
+    auto IKHP = workspace_.F(n);
+    auto RKt = workspace_.MN(M, n);
+
+    IKH.noalias() = -K * H;
+    IKH.diagonal().array() += Scalar(1);
+    IKHP.noalias() = IKH * P;
+    P.noalias() = IKHP * IKH.transpose();
+    RKt.noalias() = MRMt * K.transpose();
+    P.noalias() += K * RKt;
+  }
+
+  /**
+   * @brief Correct the state estimate and its covariance given
+   * an innovation whose jacobian \f$ H = [H_p, 0, H_b, 0] \f$ is only
+   * non-zero in the pose columns and a block of columns.
+   *
+   * With \f$ S = L L^T \f$ and \f$ B = L^{-1} H P \f$, the update is
+   * \f$ dx = B^T L^{-1} z \f$ and \f$ P = P - B^T B \f$. H.P is built
+   * from the relevant rows of P only, and the covariance update stays
+   * symmetric without the (dense) 'Joseph' form.
+   *
+   * @param [in] H_pose The pose columns of H, a workspace view
+   * @param [in] H_block The other non-zero columns of H, a workspace view
+   * @param [in] column The first state column of H_block
+   * @param [in] MRMt The measurement noise covariance
+   * @param [in] z The innovation
+   */
+  template <
+    typename _DerivedHp, typename _DerivedHb,
+    typename _DerivedR, typename _DerivedZ
+  >
+  void correctBlocks(
+    const Eigen::MatrixBase<_DerivedHp>& H_pose,
+    const Eigen::MatrixBase<_DerivedHb>& H_block,
+    const int column,
+    const Eigen::MatrixBase<_DerivedR>& MRMt,
+    const Eigen::MatrixBase<_DerivedZ>& z
+  ) {
+    using Innovation = typename _DerivedZ::PlainObject;
+    constexpr int M = Innovation::RowsAtCompileTime;
+    constexpr int p = State::PoseDoF;
+
+    const int n = x.dim();
+    const int b = int(H_block.cols());
+
+    auto P = P_.topLeftCorner(n, n);
+    auto B = workspace_.MN(M, n);
+
+    // H.P from the pose and block rows of P, P being symmetric
+    B.noalias() = H_pose * P.topRows(p);
+    B.noalias() += H_block * P.middleRows(column, b);
+
+    // S = H.P.H^T + R
+    SquareMatrix<Scalar, M> S = MRMt;
+    S.noalias() += B.leftCols(p) * H_pose.transpose();
+    S.noalias() += B.middleCols(column, b) * H_block.transpose();
+
+    const Eigen::LLT<SquareMatrix<Scalar, M>> llt(S);
+    llt.matrixL().solveInPlace(B);
+
+    Innovation w = z;
+    llt.matrixL().solveInPlace(w);
+
+    // Update state, K.z = B^T.L^-1.z
+    auto dx = workspace_.dx(n);
+    dx.noalias() = B.transpose() * w;
+    x += dx;
+
+    // Update covariance, K.S.K^T = B^T.B
+    P.noalias() -= B.transpose() * B;
+  }
+
+  //! The covariance, stored at the workspace capacity
+  Matrix P_;
+
+  Workspace<Scalar> workspace_;
+};
+
+namespace internal {
+
+/**
+ * @brief traits specialization for DynamicExtendedKalmanFilter
+ */
+template <class StateType>
+struct traits<DynamicExtendedKalmanFilter<StateType>> {
+  using State = StateType;
+};
+
+} // namespace internal
+} // kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_DYNAMIC_EXTENDED_KALMAN_FILTER_H_
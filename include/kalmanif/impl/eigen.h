@@ -3,8 +3,232 @@
 
 #include <Eigen/Dense>
 
+#include <algorithm>
+
 namespace kalmanif {
 
+/**
+ * @brief Scalar dependent default constants.
+ *
+ * @tparam Scalar The scalar type
+ */
+template <typename Scalar>
+struct Constants {
+  //! Default tolerance of the covariance tests
+  static constexpr Scalar eps = Scalar(1e-8);
+  //! Default spread of the UKFM sigma points
+  static constexpr Scalar ukfm_alpha = Scalar(1e-3);
+};
+
+template <>
+struct Constants<float> {
+  static constexpr float eps = 1e-5f;
+  static constexpr float ukfm_alpha = 1e-1f;
+};
+
+namespace internal {
+
+/**
+ * @brief The scalar type the covariance products are accumulated in.
+ *
+ * Defining KALMANIF_MIXED_PRECISION before including kalmanif headers
+ * makes the filters on float states accumulate the covariance
+ * propagation and 'Joseph' update products in double,
+ * while still storing the covariance in float.
+ *
+ * @tparam Scalar The storage scalar type
+ */
+template <typename Scalar>
+struct accumulator {
+  using type = Scalar;
+};
+
+#ifdef KALMANIF_MIXED_PRECISION
+template <>
+struct accumulator<float> {
+  using type = double;
+};
+#endif
+
+/**
+ * @brief The size from which the symmetric products only compute
+ * the lower triangle of their result.
+ *
+ * Below it, the full fixed-size (vectorized) product is faster
+ * than the triangular one. Either way only the lower triangle
+ * is kept and mirrored so that the result is exactly symmetric.
+ */
+constexpr int SymmetricProductMinSize = 24;
+
+/**
+ * @brief The type of \f$ A P A^T \f$.
+ */
+template <typename _DerivedA, typename Scalar>
+using SymmetricProduct = Eigen::Matrix<
+  Scalar,
+  _DerivedA::RowsAtCompileTime, _DerivedA::RowsAtCompileTime,
+  Eigen::ColMajor,
+  _DerivedA::MaxRowsAtCompileTime, _DerivedA::MaxRowsAtCompileTime
+>;
+
+/**
+ * @brief Mirror the strictly lower triangle of a square matrix
+ * into its strictly upper triangle.
+ */
+template <typename _Derived>
+void mirrorLower(Eigen::MatrixBase<_Derived>& M) {
+  M.template triangularView<Eigen::StrictlyUpper>() = M.transpose();
+}
+
+/**
+ * @brief Mirror the strictly upper triangle of a square matrix
+ * into its strictly lower triangle.
+ */
+template <typename _Derived>
+void mirrorUpper(Eigen::MatrixBase<_Derived>& M) {
+  M.template triangularView<Eigen::StrictlyLower>() = M.transpose();
+}
+
+/**
+ * @brief Assign (or add) \f$ A P A^T \f$ to C, with P symmetric.
+ * Only the lower triangle of C is meaningful afterwards.
+ *
+ * @see SymmetricProductMinSize
+ */
+template <
+  bool Add, typename _DerivedC, typename _DerivedA, typename _DerivedP
+>
+void lowerProduct(
+  Eigen::MatrixBase<_DerivedC>& C,
+  const Eigen::MatrixBase<_DerivedA>& A,
+  const Eigen::MatrixBase<_DerivedP>& P
+) {
+  const auto AP = (A * P).eval();
+  if (C.rows() >= SymmetricProductMinSize) {
+    if constexpr (Add) {
+      C.template triangularView<Eigen::Lower>() += AP * A.transpose();
+    } else {
+      C.template triangularView<Eigen::Lower>() = AP * A.transpose();
+    }
+  } else {
+    if constexpr (Add) {
+      C.noalias() += AP * A.transpose();
+    } else {
+      C.noalias() = AP * A.transpose();
+    }
+  }
+}
+
+/**
+ * @brief Compute \f$ A P A^T \f$, P symmetric,
+ * accumulated in the accumulator scalar type.
+ *
+ * The result is exactly symmetric.
+ *
+ * @see accumulator
+ */
+template <typename _DerivedA, typename _DerivedP>
+SymmetricProduct<_DerivedA, typename _DerivedP::Scalar>
+covarianceProduct(
+  const Eigen::MatrixBase<_DerivedA>& A,
+  const Eigen::MatrixBase<_DerivedP>& P
+) {
+  using Scalar = typename _DerivedP::Scalar;
+  using Acc = typename accumulator<Scalar>::type;
+
+  // The casts are no-op if Acc is Scalar
+  SymmetricProduct<_DerivedA, Acc> C(A.rows(), A.rows());
+  lowerProduct<false>(C, A.template cast<Acc>(), P.template cast<Acc>());
+  mirrorLower(C);
+
+  return C.template cast<Scalar>();
+}
+
+/**
+ * @brief Compute \f$ A P A^T + B Q B^T \f$, P and Q symmetric,
+ * accumulated in the accumulator scalar type.
+ *
+ * The result is exactly symmetric.
+ *
+ * @see accumulator
+ */
+template <
+  typename _DerivedA, typename _DerivedP, typename _DerivedB, typename _DerivedQ
+>
+SymmetricProduct<_DerivedA, typename _DerivedP::Scalar>
+covarianceProduct(
+  const Eigen::MatrixBase<_DerivedA>& A,
+  const Eigen::MatrixBase<_DerivedP>& P,
+  const Eigen::MatrixBase<_DerivedB>& B,
+  const Eigen::MatrixBase<_DerivedQ>& Q
+) {
+  using Scalar = typename _DerivedP::Scalar;
+  using Acc = typename accumulator<Scalar>::type;
+
+  SymmetricProduct<_DerivedA, Acc> C(A.rows(), A.rows());
+  lowerProduct<false>(C, A.template cast<Acc>(), P.template cast<Acc>());
+  lowerProduct<true>(C, B.template cast<Acc>(), Q.template cast<Acc>());
+  mirrorLower(C);
+
+  return C.template cast<Scalar>();
+}
+
+/**
+ * @brief Compute \f$ A P A^T + N \f$ given a symmetric
+ * (e.g. precomputed noise) N, accumulated in the accumulator scalar type.
+ *
+ * The result is exactly symmetric.
+ *
+ * @see accumulator
+ */
+template <typename _DerivedA, typename _DerivedP, typename _DerivedN>
+SymmetricProduct<_DerivedA, typename _DerivedP::Scalar>
+covarianceProduct(
+  const Eigen::MatrixBase<_DerivedA>& A,
+  const Eigen::MatrixBase<_DerivedP>& P,
+  const Eigen::MatrixBase<_DerivedN>& N
+) {
+  using Scalar = typename _DerivedP::Scalar;
+  using Acc = typename accumulator<Scalar>::type;
+
+  SymmetricProduct<_DerivedA, Acc> C = N.template cast<Acc>();
+  lowerProduct<true>(C, A.template cast<Acc>(), P.template cast<Acc>());
+  mirrorLower(C);
+
+  return C.template cast<Scalar>();
+}
+
+/**
+ * @brief Forbid Eigen heap allocations within a scope.
+ *
+ * Only effective in real-time mode and with EIGEN_RUNTIME_NO_MALLOC,
+ * an allocation then triggers an Eigen assertion.
+ * The previous permission is restored on exit, so that scopes nest.
+ */
+struct NoMallocScope {
+#if defined(KALMANIF_REALTIME) && defined(EIGEN_RUNTIME_NO_MALLOC)
+  NoMallocScope() noexcept
+    : allowed_(Eigen::internal::is_malloc_allowed()) {
+    Eigen::internal::set_is_malloc_allowed(false);
+  }
+
+  ~NoMallocScope() {
+    Eigen::internal::set_is_malloc_allowed(allowed_);
+  }
+
+private:
+
+  bool allowed_;
+#else
+  NoMallocScope() noexcept {}
+#endif
+
+  NoMallocScope(const NoMallocScope&) = delete;
+  NoMallocScope& operator =(const NoMallocScope&) = delete;
+};
+
+} // namespace internal
+
 /**
  * @brief Check if the input (square) matrix is symmetric
  *
@@ -17,7 +241,8 @@ namespace kalmanif {
 template <typename _EigenDerived>
 bool isSymmetric(
   const Eigen::MatrixBase<_EigenDerived>& M,
-  const typename _EigenDerived::Scalar eps = 1e-8
+  const typename _EigenDerived::Scalar eps =
+    Constants<typename _EigenDerived::Scalar>::eps
 ) {
   // @todo assert square
   return M.isApprox(M.transpose(), eps);
@@ -34,11 +259,13 @@ bool isSymmetric(
 template <typename _EigenDerived>
 bool enforceSymmetric(
   Eigen::MatrixBase<_EigenDerived>& M,
-  const typename _EigenDerived::Scalar eps = 1e-8
+  const typename _EigenDerived::Scalar eps =
+    Constants<typename _EigenDerived::Scalar>::eps
 ) {
   // @todo assert square
   using Scalar = typename _EigenDerived::Scalar;
-  M = Scalar(0.5) * (M + M.transpose());
+  // evaluated first, M + M^T aliases
+  M = (Scalar(0.5) * (M + M.transpose())).eval();
   return isSymmetric(M, eps);
 }
 
@@ -54,9 +281,11 @@ bool enforceSymmetric(
 template <typename _EigenDerived>
 bool isPositiveDefinite(
   const Eigen::MatrixBase<_EigenDerived>& M,
-  const typename _EigenDerived::Scalar eps = 1e-8
+  const typename _EigenDerived::Scalar eps =
+    Constants<typename _EigenDerived::Scalar>::eps
 ) {
-  Eigen::SelfAdjointEigenSolver<_EigenDerived> eigensolver(M);
+  Eigen::SelfAdjointEigenSolver<typename _EigenDerived::PlainObject>
+    eigensolver(M);
   KALMANIF_ASSERT(eigensolver.info() == Eigen::Success);
   if (eigensolver.info() == Eigen::Success) {
     // All eigenvalues must be >= 0:
@@ -71,13 +300,17 @@ bool isPositiveDefinite(
  * @tparam _EigenDerived The EigenDerived type of the matrix
  * @param M The matrix to force for positive definite
  * @param eps The test tolerance
+ * @param max_iterations The maximum number of eigenvalues clamping,
+ * capped to KALMANIF_REALTIME_MAX_ITERATIONS in real-time mode
  * @return true if enforcing positive definite is successful, false otherwise
  */
 template <typename _EigenDerived>
 bool enforcePositiveDefinite(
   Eigen::MatrixBase<_EigenDerived>& M,
-  const typename _EigenDerived::Scalar eps = 1e-8
-) {
+  const typename _EigenDerived::Scalar eps =
+    Constants<typename _EigenDerived::Scalar>::eps,
+  const int max_iterations = 10
+) KALMANIF_NOEXCEPT {
   Eigen::SelfAdjointEigenSolver<_EigenDerived> eigensolver(M);
   KALMANIF_ASSERT(eigensolver.info() == Eigen::Success);
 
@@ -85,7 +318,12 @@ bool enforcePositiveDefinite(
     // All eigenvalues must be >= 0:
     using Scalar = typename _EigenDerived::Scalar;
     Scalar epsilon = eps;
-    while ((eigensolver.eigenvalues().array() < eps).any()) {
+    const int iterations = detail::realtime ?
+      std::min(max_iterations, KALMANIF_REALTIME_MAX_ITERATIONS) :
+      max_iterations;
+    for (int i = 0;
+         i < iterations && (eigensolver.eigenvalues().array() < eps).any();
+         ++i) {
       M.noalias() = eigensolver.eigenvectors() *
                     eigensolver.eigenvalues().cwiseMax(epsilon).asDiagonal() *
                     eigensolver.eigenvectors().transpose();
@@ -119,7 +357,8 @@ bool enforcePositiveDefinite(
 template <typename _EigenDerived>
 bool isCovariance(
   const Eigen::MatrixBase<_EigenDerived>& M,
-  const typename _EigenDerived::Scalar eps = 1e-8
+  const typename _EigenDerived::Scalar eps =
+    Constants<typename _EigenDerived::Scalar>::eps
 ) {
   return isSymmetric(M, eps) && isPositiveDefinite(M, eps);
 }
@@ -139,11 +378,108 @@ bool isCovariance(
 template <typename _EigenDerived>
 bool enforceCovariance(
   Eigen::MatrixBase<_EigenDerived>& M,
-  const typename _EigenDerived::Scalar eps = 1e-8
+  const typename _EigenDerived::Scalar eps =
+    Constants<typename _EigenDerived::Scalar>::eps
 ) {
   return enforceSymmetric(M, eps) && enforcePositiveDefinite(M, eps);
 }
 
+/**
+ * @brief Enum for the outcome of a covariance repair
+ */
+enum class CovarianceRepair : char {
+  None = 0, // No repair needed, the matrix is only symmetrized
+  Jitter,   // A diagonal jitter was added
+  Eigen,    // The eigenvalues were clamped
+  Failed    // The matrix could not be repaired (e.g. not finite)
+};
+
+/**
+ * @brief Repair a matrix to be a covariance matrix
+ * (symmetric positive definite matrix) at a bounded cost.
+ *
+ * The matrix is first symmetrized and its Cholesky decomposition
+ * attempted. If it fails, a diagonal jitter growing tenfold is added
+ * at most max_jitter times. Only then the eigenvalues are clamped,
+ * with a single eigen-decomposition.
+ * The worst case thus costs max_jitter + 2 Cholesky decompositions
+ * and one eigen-decomposition.
+ *
+ * @tparam _EigenDerived The EigenDerived type of the matrix
+ * @param M The matrix to repair
+ * @param llt The Cholesky decomposition of the repaired matrix
+ * @param eps The jitter and eigenvalues tolerance
+ * @param max_jitter The maximum number of jitter attempts
+ * @return The repair that was needed
+ *
+ * @see enforceCovariance
+ */
+template <typename _EigenDerived, typename _MatrixType, int _UpLo>
+CovarianceRepair repairCovariance(
+  Eigen::MatrixBase<_EigenDerived>& M,
+  Eigen::LLT<_MatrixType, _UpLo>& llt,
+  const typename _EigenDerived::Scalar eps =
+    Constants<typename _EigenDerived::Scalar>::eps,
+  const int max_jitter = 3
+) {
+  using Scalar = typename _EigenDerived::Scalar;
+  using PlainObject = typename _EigenDerived::PlainObject;
+
+  if (!M.allFinite()) {
+    return CovarianceRepair::Failed;
+  }
+
+  // evaluated first, M + M^T aliases
+  M = (Scalar(0.5) * (M + M.transpose())).eval();
+
+  llt.compute(M);
+  if (llt.info() == Eigen::Success) {
+    return CovarianceRepair::None;
+  }
+
+  // Jitter relative to the matrix scale
+  using std::max;
+  Scalar jitter = eps * max(M.diagonal().cwiseAbs().maxCoeff(), Scalar(1));
+  for (int i = 0; i < max_jitter; ++i, jitter *= Scalar(10)) {
+    llt.compute(M + PlainObject::Identity(M.rows(), M.cols()) * jitter);
+    if (llt.info() == Eigen::Success) {
+      M.diagonal().array() += jitter;
+      return CovarianceRepair::Jitter;
+    }
+  }
+
+  Eigen::SelfAdjointEigenSolver<PlainObject> eigensolver(M);
+  if (eigensolver.info() != Eigen::Success) {
+    return CovarianceRepair::Failed;
+  }
+
+  M = eigensolver.eigenvectors() *
+      eigensolver.eigenvalues().cwiseMax(eps).asDiagonal() *
+      eigensolver.eigenvectors().transpose();
+  M = (Scalar(0.5) * (M + M.transpose())).eval();
+
+  llt.compute(M);
+  return llt.info() == Eigen::Success ?
+    CovarianceRepair::Eigen : CovarianceRepair::Failed;
+}
+
+/**
+ * @brief Repair a matrix to be a covariance matrix
+ * (symmetric positive definite matrix) at a bounded cost.
+ *
+ * @see repairCovariance
+ */
+template <typename _EigenDerived>
+CovarianceRepair repairCovariance(
+  Eigen::MatrixBase<_EigenDerived>& M,
+  const typename _EigenDerived::Scalar eps =
+    Constants<typename _EigenDerived::Scalar>::eps,
+  const int max_jitter = 3
+) {
+  Eigen::LLT<typename _EigenDerived::PlainObject> llt(M.rows());
+  return repairCovariance(M, llt, eps, max_jitter);
+}
+
 /**
  * @brief Return a 2x2 skew matrix given a scalar.
  * @note [s] = | 0 -s |
@@ -185,6 +521,51 @@ skew(const Eigen::MatrixBase<_Derived>& v)
   ).finished();
 }
 
+/**
+ * @brief Apply a linear measurement with diagonal noise
+ * sequentially, one scalar component at a time.
+ *
+ * Each component \f$i\f$ performs the rank-1 covariance update
+ * \f$ P = P - P h_i^T h_i P / (h_i P h_i^T + r_i) \f$
+ * so that no matrix inversion is involved.
+ *
+ * @param [in,out] P The covariance to update
+ * @param [in] H The measurement jacobian
+ * @param [in] r The diagonal of the measurement noise covariance
+ * @param [in] z The innovation
+ * @return The correction, i.e. \f$K z\f$
+ */
+template <
+  typename _DerivedP, typename _DerivedH, typename _DerivedR, typename _DerivedZ
+>
+Eigen::Matrix<typename _DerivedP::Scalar, _DerivedP::RowsAtCompileTime, 1>
+sequentialUpdate(
+  Eigen::MatrixBase<_DerivedP>& P,
+  const Eigen::MatrixBase<_DerivedH>& H,
+  const Eigen::MatrixBase<_DerivedR>& r,
+  const Eigen::MatrixBase<_DerivedZ>& z
+) {
+  using Scalar = typename _DerivedP::Scalar;
+  using Vector = Eigen::Matrix<Scalar, _DerivedP::RowsAtCompileTime, 1>;
+
+  Vector dx = Vector::Zero(P.rows());
+  Vector PHt(P.rows());
+
+  for (Eigen::Index i = 0; i < z.rows(); ++i) {
+    PHt.noalias() = P * H.row(i).transpose();
+
+    // scalar innovation covariance and innovation given
+    // the correction from the previous components
+    const Scalar s = H.row(i).dot(PHt) + r(i);
+    const Scalar zi = z(i) - H.row(i).dot(dx);
+
+    dx.noalias() += PHt * (zi / s);
+    P.noalias() -= (PHt / s) * PHt.transpose();
+  }
+
+  return dx;
+}
+
 namespace internal {
 
 template <typename Derived>
@@ -0,0 +1,401 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_ENSEMBLE_KALMAN_FILTER_MANIFOLDS_H_
+#define _KALMANIF_KALMANIF_IMPL_ENSEMBLE_KALMAN_FILTER_MANIFOLDS_H_
+
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace kalmanif {
+
+// Forward declaration
+template <typename Derived> struct SystemModelBase;
+
+/**
+ * @brief The Ensemble Kalman Filter on Manifolds
+ *
+ * The state uncertainty is represented by a fixed-size ensemble
+ * of perturbations (anomalies) a_i of the state estimate x,
+ * the members x_i = exp(a_i).x (right invariance) or x.exp(a_i)
+ * (left invariance), as the sigma points of the UKFM.
+ * Unlike the UKFM, whose 2N+1 sigma points grow with the state,
+ * the cost is set by the ensemble size, e.g. for large augmented states.
+ *
+ * The propagation runs the system model on each member with
+ * a sample of the control noise. The update is the deterministic
+ * EnKF (Sakov & Oke, 2008): the gain is computed in the ensemble
+ * space, K = A.(Y^T.S^-1) / (N-1) with S = Y.Y^T / (N-1) + R,
+ * without forming the state covariance, and the anomalies
+ * are updated as A = A - K.Y / 2.
+ *
+ * The member evaluations are independent, the executor may run
+ * them concurrently. Each member draws from its own random engine,
+ * seeded from the filter seed, the step and the member,
+ * so that the filter is reproducible whatever the executor.
+ *
+ * @tparam StateType The state type
+ * @tparam Iv The invariance of the filter
+ * @tparam Executor The executor evaluating the ensemble members
+ *
+ * @see SequentialExecutor
+ * @see ThreadPoolExecutor
+ */
+template <
+  typename StateType,
+  Invariance Iv = Invariance::Right,
+  typename Executor = SequentialExecutor
+>
+struct EnsembleKalmanFilterManifolds
+  : public internal::KalmanFilterBase<
+      EnsembleKalmanFilterManifolds<StateType, Iv, Executor>
+    > {
+
+  using Base = internal::KalmanFilterBase<
+    EnsembleKalmanFilterManifolds<StateType, Iv, Executor>
+  >;
+
+  using typename Base::Scalar;
+  using typename Base::State;
+  using Base::setState;
+  using Base::getState;
+
+  using Tangent = typename State::Tangent;
+
+  static constexpr int DoF = internal::traits<State>::Size;
+
+  //! The ensemble anomalies, one per column
+  using Anomalies = Eigen::Matrix<Scalar, DoF, Eigen::Dynamic>;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  /**
+   * @brief Construct a filter sampling its ensemble
+   * from the initial covariance.
+   *
+   * @param state_init The initial state
+   * @param cov_init The initial state covariance
+   * @param ensemble_size The number of ensemble members
+   * @param seed The seed of the random engines
+   * @param executor The executor evaluating the ensemble members
+   * @throw kalmanif::invalid_argument if ensemble_size is lower than 2
+   */
+  EnsembleKalmanFilterManifolds(
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const int ensemble_size,
+    const std::uint64_t seed = 0,
+    Executor executor = Executor()
+  ) : Base(), seed_(seed), executor_(std::move(executor)) {
+    KALMANIF_ENSURE(
+      ensemble_size > 1,
+      "EnKF: The ensemble needs at least 2 members!",
+      kalmanif::invalid_argument
+    );
+
+    setState(state_init);
+
+    const Covariance<State> L = cov_init.llt().matrixL();
+
+    Anomalies A(DoF, ensemble_size);
+    forEachMember(ensemble_size, [&](const int i, std::mt19937_64& rng){
+      std::normal_distribution<Scalar> normal;
+      Eigen::Matrix<Scalar, DoF, 1> n;
+      for (int d = 0; d < DoF; ++d) {
+        n(d) = normal(rng);
+      }
+      A.col(i) = L * n;
+    });
+
+    setAnomalies(A);
+  }
+
+  ~EnsembleKalmanFilterManifolds() = default;
+
+  /**
+   * @brief Set the ensemble anomalies, which are centered.
+   * @throw kalmanif::invalid_argument if there are fewer than 2 members
+   */
+  void setAnomalies(const Eigen::Ref<const Anomalies>& anomalies) {
+    KALMANIF_ENSURE(
+      anomalies.cols() > 1,
+      "EnKF: The ensemble needs at least 2 members!",
+      kalmanif::invalid_argument
+    );
+    A_ = anomalies;
+    A_.colwise() -= A_.rowwise().mean();
+    is_cov_valid_ = false;
+  }
+
+  /**
+   * @brief Get the ensemble anomalies, one per column
+   */
+  const Anomalies& getAnomalies() const {
+    return A_;
+  }
+
+  /**
+   * @brief Get the i-th ensemble member
+   */
+  State getMember(const int i) const {
+    return plus(x, Tangent(A_.col(i)));
+  }
+
+  /**
+   * @brief Get the ensemble size
+   */
+  int getEnsembleSize() const {
+    return int(A_.cols());
+  }
+
+  /**
+   * @brief Set the multiplicative inflation of the anomalies,
+   * applied at each propagation to counter the ensemble
+   * under-estimating its spread.
+   * @throw kalmanif::invalid_argument if inflation is lower than 1
+   */
+  void setInflation(const Scalar inflation) {
+    KALMANIF_CHECK(
+      inflation >= Scalar(1),
+      "EnKF: The inflation must be greater than 1!",
+      kalmanif::invalid_argument
+    );
+    inflation_ = inflation;
+  }
+
+  Scalar getInflation() const {
+    return inflation_;
+  }
+
+  /**
+   * @brief Get the ensemble covariance, A.A^T / (N-1)
+   *
+   * @note It is only formed on demand, the filter does not use it.
+   */
+  const Covariance<State>& getCovariance() const {
+    if (!is_cov_valid_) {
+      P_.noalias() = A_ * A_.transpose() / Scalar(getEnsembleSize() - 1);
+      is_cov_valid_ = true;
+    }
+    return P_;
+  }
+
+protected:
+
+  using Base::x;
+  using Base::instrument;
+
+  friend Base;
+
+  static State plus(const State& state, const Tangent& a) {
+    if constexpr (Iv == Invariance::Right) {
+      return a + state;
+    } else {
+      return state + a;
+    }
+  }
+
+  static Tangent minus(const State& state, const State& reference) {
+    if constexpr (Iv == Invariance::Right) {
+      return state.lminus(reference);
+    } else {
+      return state.rminus(reference);
+    }
+  }
+
+  //! The random engine of a member for the current step
+  std::mt19937_64 engine(const int member) const {
+    std::seed_seq seq{
+      std::uint32_t(seed_), std::uint32_t(seed_ >> 32),
+      std::uint32_t(step_), std::uint32_t(step_ >> 32),
+      std::uint32_t(member)
+    };
+    return std::mt19937_64(seq);
+  }
+
+  //! Run function(i, rng) on each member
+  template <typename Function>
+  void forEachMember(const int n, Function&& function) {
+    executor_(n, [&](const int i){
+      std::mt19937_64 rng = engine(i);
+      function(i, rng);
+    });
+    ++step_;
+  }
+
+  template <class SystemModelDerived, typename... Args>
+  const State& propagate_impl(
+    const SystemModelBase<SystemModelDerived>& f,
+    const typename internal::traits<SystemModelDerived>::Control& u,
+    Args&&... args
+  ) {
+    using Control = typename internal::traits<SystemModelDerived>::Control;
+    constexpr auto NoiseSize = internal::traits<Control>::Size;
+    using VectorCoF = Eigen::Matrix<Scalar, NoiseSize, 1>;
+
+    const State x_new = [&]() {
+      const auto stage = instrument(Stage::Model);
+      return f(x, u, args...);
+    }();
+
+    const Covariance<Control> L = f.getCovarianceSquareRoot().matrixL();
+
+    // the members propagated with samples of the control noise,
+    // the executor may run the evaluations concurrently
+    {
+      const auto stage = instrument(Stage::Model);
+      forEachMember(getEnsembleSize(), [&](const int i, std::mt19937_64& rng){
+        std::normal_distribution<Scalar> normal;
+        VectorCoF n;
+        for (int d = 0; d < NoiseSize; ++d) {
+          n(d) = normal(rng);
+        }
+        const VectorCoF w = L * n;
+        A_.col(i) = minus(
+          f(plus(x, Tangent(A_.col(i))), u + w, args...), x_new
+        ).coeffs();
+      });
+    }
+
+    // re-centered at the ensemble mean
+    {
+      const auto stage = instrument(Stage::Covariance);
+      const Tangent a_mean(A_.rowwise().mean());
+      A_.colwise() -= a_mean.coeffs();
+      A_ *= inflation_;
+      setState(plus(x_new, a_mean));
+    }
+
+    is_cov_valid_ = false;
+
+    return getState();
+  }
+
+  template <class MeasurementModelDerived>
+  const State& update_impl(
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y
+  ) {
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+    constexpr auto MeasSize = internal::traits<Measurement>::Size;
+
+    // the predicted measurements of the members
+    Eigen::Matrix<Scalar, MeasSize, Eigen::Dynamic> Y(MeasSize, getEnsembleSize());
+    {
+      const auto stage = instrument(Stage::Model);
+      executor_(getEnsembleSize(), [&](const int i){
+        Y.col(i) = h(plus(x, Tangent(A_.col(i))));
+      });
+    }
+
+    const Measurement y_mean = Y.rowwise().mean();
+    Y.colwise() -= y_mean;
+
+    return correct(Y, y - y_mean, h.getCovariance());
+  }
+
+  template <int Count, typename MeasurementModelIterator, typename MeasurementIterator>
+  const State& update_stacked_impl(
+    MeasurementModelIterator h_it, MeasurementIterator y_it, const int count
+  ) {
+    using MeasurementModel =
+      typename std::iterator_traits<MeasurementModelIterator>::value_type;
+    using Measurement = typename internal::traits<MeasurementModel>::Measurement;
+    constexpr auto MeasSize = internal::traits<Measurement>::Size;
+    constexpr auto StackedSize =
+      (Count == Eigen::Dynamic) ? Eigen::Dynamic : Count * MeasSize;
+
+    const int m = count * MeasSize;
+    const int n = getEnsembleSize();
+
+    // random access to the models
+    std::vector<const MeasurementModel*> hs(count);
+    Eigen::Matrix<Scalar, StackedSize, 1> r(m);
+    SquareMatrix<Scalar, StackedSize> R = SquareMatrix<Scalar, StackedSize>::Zero(m, m);
+
+    for (int k = 0; k < count; ++k, ++h_it, ++y_it) {
+      hs[k] = &*h_it;
+      r.template segment<MeasSize>(k * MeasSize) = *y_it;
+      R.template block<MeasSize, MeasSize>(k * MeasSize, k * MeasSize) =
+        h_it->getCovariance();
+    }
+
+    Eigen::Matrix<Scalar, StackedSize, Eigen::Dynamic> Y(m, n);
+    {
+      const auto stage = instrument(Stage::Model);
+      executor_(n, [&](const int i){
+        const State member = plus(x, Tangent(A_.col(i)));
+        for (int k = 0; k < count; ++k) {
+          Y.col(i).template segment<MeasSize>(k * MeasSize) = (*hs[k])(member);
+        }
+      });
+    }
+
+    const Eigen::Matrix<Scalar, StackedSize, 1> y_mean = Y.rowwise().mean();
+    Y.colwise() -= y_mean;
+
+    return correct(Y, r - y_mean, R);
+  }
+
+  /**
+   * @brief The ensemble-space correction
+   *
+   * @param Y The centered predicted measurements of the members
+   * @param z The innovation
+   * @param R The measurement covariance
+   */
+  template <typename MatrixY, typename VectorZ, typename MatrixR>
+  const State& correct(const MatrixY& Y, const VectorZ& z, const MatrixR& R) {
+    using MatrixS = SquareMatrix<Scalar, MatrixR::RowsAtCompileTime>;
+
+    const Scalar n_1 = Scalar(getEnsembleSize() - 1);
+
+    // K = A.G, G = Y^T.S^-1 / (N-1)
+    Eigen::Matrix<Scalar, DoF, MatrixR::RowsAtCompileTime> AG;
+    {
+      const auto stage = instrument(Stage::Gain);
+      const MatrixS S = Y * Y.transpose() / n_1 + R;
+      const Eigen::Matrix<Scalar, Eigen::Dynamic, MatrixR::RowsAtCompileTime> G =
+        S.llt().solve(Y).transpose() / n_1;
+      AG.noalias() = A_ * G;
+    }
+
+    setState(plus(x, Tangent(AG * z)));
+
+    {
+      const auto stage = instrument(Stage::Covariance);
+      A_.noalias() -= Scalar(0.5) * AG * Y;
+    }
+
+    is_cov_valid_ = false;
+
+    return getState();
+  }
+
+  //! The ensemble anomalies
+  Anomalies A_;
+
+  Scalar inflation_ = Scalar(1);
+
+  std::uint64_t seed_;
+  std::uint64_t step_ = 0;
+
+  //! The ensemble covariance, formed on demand
+  mutable Covariance<State> P_;
+  mutable bool is_cov_valid_ = false;
+
+  //! Ensemble members evaluation executor
+  Executor executor_;
+};
+
+namespace internal {
+
+template <class StateType, Invariance Iv, typename Executor>
+struct traits<EnsembleKalmanFilterManifolds<StateType, Iv, Executor>> {
+  using State = StateType;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_ENSEMBLE_KALMAN_FILTER_MANIFOLDS_H_
@@ -0,0 +1,221 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_EXECUTOR_H_
+#define _KALMANIF_KALMANIF_IMPL_EXECUTOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace kalmanif {
+
+/**
+ * @brief An executor running n independent tasks
+ * f(0), ..., f(n-1) sequentially in the calling thread.
+ *
+ * An executor is any copyable type providing
+ * 'void operator ()(int n, F&& f) const' which returns
+ * once all tasks are done.
+ */
+struct SequentialExecutor {
+
+  template <typename Function>
+  void operator ()(const int n, Function&& f) const {
+    for (int i = 0; i < n; ++i) {
+      f(i);
+    }
+  }
+};
+
+/**
+ * @brief An executor spreading n independent tasks
+ * f(0), ..., f(n-1) over a pool of threads.
+ *
+ * The calling thread takes part in the execution.
+ * Copies of the executor share the same pool.
+ * If a task throws, the first exception is rethrown
+ * in the calling thread once all tasks are done.
+ *
+ * @note Tasks must not call the executor they run on.
+ */
+struct ThreadPoolExecutor {
+
+  /**
+   * @brief Construct a thread pool executor
+   * @param num_threads The total number of threads,
+   * including the calling thread.
+   */
+  explicit ThreadPoolExecutor(
+    const unsigned int num_threads = std::thread::hardware_concurrency()
+  ) : pool_(std::make_shared<Pool>(std::max(num_threads, 1u) - 1)) {}
+
+  template <typename Function>
+  void operator ()(const int n, Function&& f) const {
+    // f outlives the call, it is referenced rather than wrapped
+    using F = std::remove_reference_t<Function>;
+    pool_->execute(n, Task{
+      const_cast<void*>(static_cast<const void*>(std::addressof(f))),
+      [](void* f, const int i) { (*static_cast<F*>(f))(i); }
+    });
+  }
+
+  /**
+   * @brief Get the total number of threads, including the calling thread.
+   */
+  unsigned int size() const {
+    return static_cast<unsigned int>(pool_->workers.size()) + 1u;
+  }
+
+protected:
+
+  //! A non-owning reference to the tasks, unlike a std::function not allocating
+  struct Task {
+    void* f = nullptr;
+    void (*call)(void*, int) = nullptr;
+
+    void operator ()(const int i) const {
+      call(f, i);
+    }
+  };
+
+  struct Pool {
+
+    struct Job {
+      const Task* f = nullptr;
+      int n = 0;
+      std::atomic<int> next{0};
+      int active = 0;
+      std::exception_ptr error;
+    };
+
+    explicit Pool(const unsigned int num_workers) {
+      workers.reserve(num_workers);
+      for (unsigned int i = 0; i < num_workers; ++i) {
+        workers.emplace_back([this](){ run(); });
+      }
+    }
+
+    ~Pool() {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+      }
+      job_cv.notify_all();
+      for (auto& worker : workers) {
+        worker.join();
+      }
+    }
+
+    static std::exception_ptr work(Job& job) noexcept {
+      try {
+        for (int i = job.next++; i < job.n; i = job.next++) {
+          (*job.f)(i);
+        }
+      } catch (...) {
+        // Drain the remaining tasks and report
+        job.next = job.n;
+        return std::current_exception();
+      }
+      return nullptr;
+    }
+
+    void run() {
+      std::size_t seen = 0;
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        job_cv.wait(lock, [&](){
+          return stop || (job != nullptr && generation != seen);
+        });
+
+        if (stop) return;
+
+        seen = generation;
+        Job* current = job;
+        ++current->active;
+
+        lock.unlock();
+        std::exception_ptr error = work(*current);
+        lock.lock();
+
+        if (error && !current->error) current->error = error;
+        if (--current->active == 0) done_cv.notify_all();
+      }
+    }
+
+    void execute(const int n, const Task& f) {
+      // one job at a time
+      std::lock_guard<std::mutex> call_lock(call_mutex);
+
+      Job current;
+      current.f = &f;
+      current.n = n;
+
+      if (!workers.empty() && n > 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &current;
+        ++generation;
+      }
+      job_cv.notify_all();
+
+      std::exception_ptr error = work(current);
+
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        job = nullptr;
+        done_cv.wait(lock, [&](){ return current.active == 0; });
+        if (error && !current.error) current.error = error;
+      }
+
+      if (current.error) std::rethrow_exception(current.error);
+    }
+
+    std::vector<std::thread> workers;
+
+    std::mutex call_mutex, mutex;
+    std::condition_variable job_cv, done_cv;
+
+    Job* job = nullptr;
+    std::size_t generation = 0;
+    bool stop = false;
+  };
+
+  std::shared_ptr<Pool> pool_;
+};
+
+namespace internal {
+
+//! Beyond this count the tasks run in a loop
+constexpr int MaxUnrolledTasks = 16;
+
+template <typename Function, int... I>
+void runUnrolled(Function& f, std::integer_sequence<int, I...>) {
+  (f(I), ...);
+}
+
+/**
+ * @brief Run N independent tasks f(0), ..., f(N-1) on an executor,
+ * fully unrolled in the calling thread for the sequential executor
+ * and a small N.
+ */
+template <int N, typename Executor, typename Function>
+void runTasks(const Executor& executor, Function&& f) {
+  if constexpr (
+    std::is_same<Executor, SequentialExecutor>::value &&
+    N <= MaxUnrolledTasks
+  ) {
+    runUnrolled(f, std::make_integer_sequence<int, N>{});
+  } else {
+    executor(N, std::forward<Function>(f));
+  }
+}
+
+} // namespace internal
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_EXECUTOR_H_
@@ -5,25 +5,53 @@ namespace kalmanif {
 
 // Forward declaration
 template <typename Derived> struct SystemModelBase;
-template <typename Filter> struct RauchTungStriebelSmoother;
+template <typename Filter, typename Storage> struct RauchTungStriebelSmoother;
+template <typename Filter, std::size_t Lag> struct FixedLagSmoother;
+template <typename Filter> struct FilterCheckpoint;
 
 /**
  * @brief The ExtendedKalmanFilter
  *
  * @tparam StateType The state type
+ * @tparam Solver The innovation covariance solver
  */
-template <typename StateType>
+template <
+  typename StateType, InnovationSolver Solver = InnovationSolver::LLT
+>
 struct ExtendedKalmanFilter
-  : public internal::KalmanFilterBase<ExtendedKalmanFilter<StateType>>
-  , public internal::CovarianceBase<StateType> {
-
-  using Base = internal::KalmanFilterBase<ExtendedKalmanFilter<StateType>>;
-  using CovarianceBase = internal::CovarianceBase<StateType>;
+  : public internal::KalmanFilterBase<ExtendedKalmanFilter<StateType, Solver>>
+  , public internal::LazyCovarianceBase<StateType>
+  , public internal::InnovationBase<StateType, Solver>
+  , public internal::IterationBase
+  , public internal::ConsiderBase<StateType>
+  , public internal::TransitionBase<StateType> {
+
+  using Base =
+    internal::KalmanFilterBase<ExtendedKalmanFilter<StateType, Solver>>;
+  using CovarianceBase = internal::LazyCovarianceBase<StateType>;
+  using InnovationBase = internal::InnovationBase<StateType, Solver>;
+  using ConsiderBase = internal::ConsiderBase<StateType>;
 
   using typename Base::State;
   using Base::setState;
   using CovarianceBase::setCovariance;
+  using CovarianceBase::getCovariance;
+  using CovarianceBase::setLazyPropagation;
+  using CovarianceBase::isLazyPropagation;
   using Base::getState;
+  using Base::setValidation;
+  using Base::getValidation;
+  using Base::getValidationPeriod;
+  using InnovationBase::getInnovation;
+  using InnovationBase::getInnovationDecomposition;
+  using InnovationBase::isInnovationFallback;
+  using InnovationBase::getNormalizedInnovationSquared;
+  using InnovationBase::isInnovationAccepted;
+  using InnovationBase::getInnovationWeight;
+  using internal::IterationBase::getIterationSummary;
+  using ConsiderBase::setConsideredStates;
+  using ConsiderBase::clearConsideredStates;
+  using ConsiderBase::hasConsideredStates;
 
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
 
@@ -47,17 +75,26 @@ struct ExtendedKalmanFilter
 protected:
 
   using Base::x;
+  using Base::validateCovariance;
+  using Base::instrument;
   using CovarianceBase::P;
+  using CovarianceBase::invalidateCovarianceSquareRoot;
+  using CovarianceBase::getPendingTransition;
+  using CovarianceBase::lazy_;
+  using InnovationBase::S_;
+  using InnovationBase::weight_;
+  using InnovationBase::setInnovation;
+  using InnovationBase::solveInnovation;
+  using InnovationBase::gateInnovation;
+  using internal::IterationBase::startIterations;
+  using internal::IterationBase::continueIterations;
+  using ConsiderBase::considerGain;
+  using internal::TransitionBase<StateType>::recordTransition;
 
   friend Base;
-  friend RauchTungStriebelSmoother<ExtendedKalmanFilter<StateType>>;
-
-  Jacobian<State, State> A_ = Jacobian<State, State>::Zero();
-
-  // @todo this definitely is an inelegant workaround
-  const Jacobian<State, State>& getA() const {
-    return A_;
-  }
+  template <typename, typename> friend struct RauchTungStriebelSmoother;
+  template <typename, std::size_t> friend struct FixedLagSmoother;
+  template <typename> friend struct FilterCheckpoint;
 
   /**
    * @brief Perform filter propagation step using the input control \f$u\f$
@@ -84,23 +121,77 @@ protected:
     // System model noise jacobian
     Jacobian<State, Control> W;
 
+    using Sparsity =
+      typename internal::jacobian_sparsity<SystemModelDerived>::type;
+
     // propagate state
-    x = f(x, u, F, W, std::forward<Args>(args)...);
+    {
+      const auto stage = instrument(Stage::Model);
+      f.into(x, u, x, F, W, args...);
+    }
 
     // propagate covariance
-    P = F * P * F.transpose();
-    P.noalias() += W * f.getCovariance() * W.transpose();
+    if constexpr (internal::has_constant_noise_jacobian<SystemModelDerived>{}) {
+      // with the model's precomputed noise
+      propagateCovariance<Sparsity>(F, f.getPropagatedNoise(args...));
+    } else {
+      propagateCovariance<Sparsity>(F, W, f.getCovariance());
+    }
+
+    return getState();
+  }
+
+  /**
+   * @brief Propagate the covariance,
+   * or only accumulate the propagation in lazy mode.
+   *
+   * The transposed transition A = F^T is recorded if a smoother asked
+   * for it, in lazy mode the transition since the last update.
+   *
+   * @tparam Sparsity The sparsity of the system model jacobian
+   * @param [in] F The system model jacobian
+   * @param [in] noise The system model noise jacobian W and covariance Q,
+   * or their precomputed product W.Q.W^T
+   */
+  template <typename Sparsity, typename _DerivedF, typename... Noise>
+  void propagateCovariance(
+    const Eigen::MatrixBase<_DerivedF>& F,
+    const Noise&... noise
+  ) {
+    if (lazy_) {
+      CovarianceBase::template deferPropagation<Sparsity>(F, noise...);
+      recordTransition(getPendingTransition().transpose());
+      return;
+    }
+
+    applyLazyPropagation();
 
-    A_ = F.transpose();
+    {
+      const auto stage = instrument(Stage::Covariance);
+      P = internal::sparseCovarianceProduct<Sparsity>(F, P, noise...);
+    }
+    invalidateCovarianceSquareRoot();
+
+    recordTransition(F.transpose());
 
     // enforceCovariance(P);
 
-    KALMANIF_ASSERT(
-      isCovariance(P),
+    validateCovariance(
+      P,
       "EKF::propagate: Updated matrix P is not a covariance."
     );
+  }
 
-    return getState();
+  /**
+   * @brief Apply the pending lazy propagations to the covariance, if any.
+   */
+  void applyLazyPropagation() {
+    if (CovarianceBase::applyPropagation()) {
+      validateCovariance(
+        P,
+        "EKF::propagate: Updated matrix P is not a covariance."
+      );
+    }
   }
 
   /**
@@ -117,6 +208,8 @@ protected:
     const Linearized<MeasurementModelBase<MeasurementModelDerived>>& h,
     const typename internal::traits<MeasurementModelDerived>::Measurement& y
   ) {
+    applyLazyPropagation();
+
     using Measurement =
       typename internal::traits<MeasurementModelDerived>::Measurement;
 
@@ -124,34 +217,464 @@ protected:
     Jacobian<Measurement, Measurement> M;
 
     // compute expectation
-    Measurement e = h(x, H, M);
+    const Measurement e = [&]() {
+      const auto stage = instrument(Stage::Model);
+      return h(x, H, M);
+    }();
+
+    Covariance<Measurement> MRMt = internal::covarianceProduct(M, h.getCovariance());
+
+    if constexpr (internal::has_diagonal_noise<MeasurementModelDerived>{}) {
+      correctSequential(H, MRMt, y - e);
+    } else {
+      correct<
+        typename internal::jacobian_sparsity<MeasurementModelDerived>::type
+      >(H, MRMt, y - e);
+    }
+
+    validateCovariance(
+      P,
+      "EKF::update: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform a gated filter update step using measurement \f$z\f$
+   * and corresponding measurement model
+   *
+   * The measurement is rejected, leaving the estimate untouched,
+   * if its NIS exceeds the gate threshold.
+   * The decomposition of the innovation covariance computed for
+   * the gate is then reused for the kalman gain.
+   *
+   * @tparam MeasurementModelDerived
+   * @param [in] h The linearized measurement model
+   * @param [in] y The measurement vector
+   * @param [in] gate The Mahalanobis gate
+   * @return The updated state estimate
+   *
+   * @see isInnovationAccepted
+   */
+  template <class MeasurementModelDerived>
+  const State& update_impl(
+    const Linearized<MeasurementModelBase<MeasurementModelDerived>>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    const MahalanobisGate& gate
+  ) {
+    applyLazyPropagation();
+
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+
+    Jacobian<Measurement, State> H;
+    Jacobian<Measurement, Measurement> M;
+
+    // compute expectation
+    const Measurement e = [&]() {
+      const auto stage = instrument(Stage::Model);
+      return h(x, H, M);
+    }();
+
+    Covariance<Measurement> MRMt = internal::covarianceProduct(M, h.getCovariance());
+
+    if (
+      !correct<
+        typename internal::jacobian_sparsity<MeasurementModelDerived>::type
+      >(H, MRMt, y - e, gate.threshold)
+    ) {
+      return getState();
+    }
+
+    validateCovariance(
+      P,
+      "EKF::update: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform a robust filter update step using measurement \f$z\f$
+   * and corresponding measurement model
+   *
+   * The measurement noise is down-weighted by the kernel
+   * at the residual of the update, see RobustKernel.
+   * The model is linearized once, the re-weighting iterations reuse
+   * its jacobian and a single factorization of the innovation covariance.
+   *
+   * @tparam MeasurementModelDerived
+   * @param [in] h The linearized measurement model
+   * @param [in] y The measurement vector
+   * @param [in] kernel The robust kernel
+   * @return The updated state estimate
+   *
+   * @see getInnovationWeight
+   */
+  template <class MeasurementModelDerived>
+  const State& update_impl(
+    const Linearized<MeasurementModelBase<MeasurementModelDerived>>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    const RobustKernel& kernel
+  ) {
+    applyLazyPropagation();
+
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+
+    Jacobian<Measurement, State> H;
+    Jacobian<Measurement, Measurement> M;
+
+    // compute expectation
+    const Measurement e = [&]() {
+      const auto stage = instrument(Stage::Model);
+      return h(x, H, M);
+    }();
+
+    Covariance<Measurement> MRMt = internal::covarianceProduct(M, h.getCovariance());
+
+    correctRobust<
+      typename internal::jacobian_sparsity<MeasurementModelDerived>::type
+    >(H, MRMt, y - e, kernel);
+
+    validateCovariance(
+      P,
+      "EKF::update: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform an iterated filter update step using measurement \f$z\f$
+   * and corresponding measurement model
+   *
+   * Gauss-Newton on the manifold: the measurement model is re-linearized
+   * at the current iterate \f$ x_i \f$ until the budget is met.
+   * With \f$ e = x_i \ominus x_0 \f$ the deviation from the prior
+   * and \f$ P_i = J_r(e) P J_r(e)^T \f$ the prior covariance at
+   * \f$ x_i \f$, the step is
+   * \f$ \delta = K (y - h(x_i) + H e) - e \f$.
+   *
+   * @tparam MeasurementModelDerived
+   * @param [in] h The linearized measurement model
+   * @param [in] y The measurement vector
+   * @param [in] budget The iterations budget
+   * @return The updated state estimate
+   *
+   * @note Falls back to a single linearization with considered states.
+   * @see IterationBudget
+   * @see getIterationSummary
+   */
+  template <class MeasurementModelDerived>
+  const State& update_impl(
+    const Linearized<MeasurementModelBase<MeasurementModelDerived>>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    const IterationBudget& budget
+  ) {
+    applyLazyPropagation();
+
+    // Schmidt mode, the iterates would move the considered states
+    // through e and J_r(e), stop at the usual (masked gain) update
+    IterationBudget iteration_budget = budget;
+    if (hasConsideredStates()) {
+      iteration_budget.max_iterations = 1;
+    }
+
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+    using Tangent = typename State::Tangent;
+
+    const auto start = startIterations();
+
+    const State x0 = x;
+    const Covariance<State> P0 = P;
+
+    Jacobian<Measurement, State> H;
+    Jacobian<Measurement, Measurement> M;
+    Covariance<Measurement> MRMt;
+    KalmanGain<State, Measurement> K;
+
+    Tangent e = Tangent::Zero();
+    double step_norm = 0;
+
+    do {
+      const Jacobian<State, State> J = e.rjac();
+      P = internal::covarianceProduct(J, P0);
+
+      // innovation at x_i, relative to the prior
+      const Measurement z = y - h(x, H, M) + H * e.coeffs();
+
+      MRMt = internal::covarianceProduct(M, h.getCovariance());
+
+      setInnovation(z, internal::covarianceProduct(H, P, MRMt));
+      solveInnovation(H * P, K.transpose());
+      considerGain(K);
+
+      const Tangent dx(K * z - e.coeffs());
+      x += dx;
+      e = x.rminus(x0);
+
+      step_norm = dx.coeffs().norm();
+    } while (continueIterations(step_norm, start, iteration_budget));
+
+    // Update covariance at the last linearization
+    const Covariance<State> IKH = Covariance<State>::Identity() - K * H;
+    P = internal::covarianceProduct(IKH, P, K, MRMt);
+    invalidateCovarianceSquareRoot();
+
+    validateCovariance(
+      P,
+      "EKF::update: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform a single filter update step using a stack of
+   * measurements \f$z_i\f$ and corresponding measurement models
+   *
+   * @tparam Count The number of measurements or Eigen::Dynamic
+   * @param [in] h_it Iterator to the first linearized measurement model
+   * @param [in] y_it Iterator to the first measurement vector
+   * @param [in] count The number of measurements
+   * @return The updated state estimate
+   */
+  template <
+    int Count, class MeasurementModelIterator, class MeasurementIterator
+  >
+  const State& update_stacked_impl(
+    MeasurementModelIterator h_it,
+    MeasurementIterator y_it,
+    const int count
+  ) {
+    applyLazyPropagation();
+
+    using MeasurementModelDerived =
+      typename std::iterator_traits<MeasurementModelIterator>::value_type;
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+    using Stacked = StackedMeasurement<Measurement, Count>;
+    constexpr auto MeasSize = internal::traits<Measurement>::Size;
+    constexpr auto StateSize = internal::traits<State>::Size;
+    const auto StackedSize = count * MeasSize;
+
+    Stacked z(StackedSize);
+    Jacobian<Stacked, State, 0, Stacked::MaxRowsAtCompileTime> H(
+      StackedSize, StateSize
+    );
+    StackedCovariance<Stacked> MRMt =
+      StackedCovariance<Stacked>::Zero(StackedSize, StackedSize);
+
+    Jacobian<Measurement, Measurement> M;
+
+    {
+      const auto stage = instrument(Stage::Model);
 
-    Covariance<Measurement> MRMt = M * h.getCovariance() * M.transpose();
+      for (int i = 0; i < count; ++i, ++h_it, ++y_it) {
+        const Linearized<MeasurementModelBase<MeasurementModelDerived>>& h = *h_it;
+        const auto b = i * MeasSize;
 
-    // compute kalman gain
-    KalmanGain<State, Measurement> K =
-      P * H.transpose() * (H * P * H.transpose() + MRMt).inverse();
+        // compute expectation and stack innovation
+        z.template segment<MeasSize>(b) =
+          *y_it - h(x, H.template middleRows<MeasSize>(b), M);
+
+        MRMt.template block<MeasSize, MeasSize>(b, b).noalias() =
+          internal::covarianceProduct(M, h.getCovariance());
+      }
+    }
+
+    if constexpr (internal::has_diagonal_noise<MeasurementModelDerived>{}) {
+      correctSequential(H, MRMt, z);
+    } else {
+      correct(H, MRMt, z);
+    }
+
+    validateCovariance(
+      P,
+      "EKF::update: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Correct the state estimate and its covariance
+   * given an innovation, its jacobian and noise.
+   *
+   * @tparam Sparsity The sparsity of the measurement jacobian
+   * @param [in] H The measurement jacobian
+   * @param [in] MRMt The measurement noise covariance
+   * @param [in] z The innovation
+   * @param [in] threshold The NIS above which the innovation is rejected
+   * @return Whether the innovation was accepted
+   */
+  template <
+    typename Sparsity = DenseJacobian,
+    typename _DerivedH, typename _DerivedR, typename _DerivedZ
+  >
+  bool correct(
+    const Eigen::MatrixBase<_DerivedH>& H,
+    const Eigen::MatrixBase<_DerivedR>& MRMt,
+    const Eigen::MatrixBase<_DerivedZ>& z,
+    const double threshold = std::numeric_limits<double>::infinity()
+  ) {
+    using Innovation = typename _DerivedZ::PlainObject;
+
+    KalmanGain<
+      State, Innovation, 0,
+      internal::traits<State>::Size, Innovation::MaxRowsAtCompileTime
+    > K;
+
+    {
+      const auto stage = instrument(Stage::Gain);
+
+      const auto HP = internal::sparseProduct<Sparsity>(H, P);
+
+      // compute and decompose the innovation covariance
+      // S = H.(H.P)^T + R with P symmetric
+      setInnovation(
+        z, internal::sparseProduct<Sparsity>(H, HP.transpose()) + MRMt
+      );
+
+      // gate before touching the estimate
+      if (!gateInnovation(threshold)) {
+        return false;
+      }
+
+      // compute kalman gain, solve using the decomposition
+      // S.K^T = H.P with S = H.P.H^T + R symmetric
+      solveInnovation(HP, K.transpose());
+    }
+
+    // Schmidt mode, do not correct the considered states
+    considerGain(K);
 
     // Update state using computed kalman gain and innovation
     // @todo Fix
-    x += typename State::Tangent(K * (y - e));
+    x += typename State::Tangent(K * z);
+
+    const auto stage = instrument(Stage::Covariance);
 
     Covariance<State> IKH = Covariance<State>::Identity() - K * H;
 
     // Update covariance
     // Use the 'Joseph' equation which is numerically more stable
+    // and valid for the suboptimal gain of the Schmidt mode
     // P = (I - K.H).P.(I - K.H)^T + K.R.K^T
-    P = IKH * P * IKH.transpose() + K * MRMt * K.transpose();
+    P = internal::covarianceProduct(IKH, P, K, MRMt);
     // P -= K * H * P;
+    invalidateCovarianceSquareRoot();
 
     // enforceCovariance(P);
 
+    return true;
+  }
+
+  /**
+   * @brief Correct the state estimate and its covariance
+   * given an innovation, its jacobian and a noise re-weighted
+   * by a robust kernel.
+   *
+   * @tparam Sparsity The sparsity of the measurement jacobian
+   * @param [in] H The measurement jacobian
+   * @param [in] MRMt The measurement noise covariance
+   * @param [in] z The innovation
+   * @param [in] kernel The robust kernel
+   *
+   * @note The innovation and its covariance returned by getInnovation()
+   * and getInnovationDecomposition() are the unweighted ones.
+   */
+  template <
+    typename Sparsity = DenseJacobian,
+    typename _DerivedH, typename _DerivedR, typename _DerivedZ
+  >
+  void correctRobust(
+    const Eigen::MatrixBase<_DerivedH>& H,
+    const Eigen::MatrixBase<_DerivedR>& MRMt,
+    const Eigen::MatrixBase<_DerivedZ>& z,
+    const RobustKernel& kernel
+  ) {
+    using Innovation = typename _DerivedZ::PlainObject;
+
+    KalmanGain<
+      State, Innovation, 0,
+      internal::traits<State>::Size, Innovation::MaxRowsAtCompileTime
+    > K;
+
+    {
+      const auto stage = instrument(Stage::Gain);
+
+      const auto HP = internal::sparseProduct<Sparsity>(H, P);
+      const auto HPHt = internal::sparseProduct<Sparsity>(H, HP.transpose());
+
+      setInnovation(z, HPHt + MRMt);
+
+      internal::RobustReweighting<State, _DerivedR> irls(
+        HPHt, MRMt, z
+      );
+      weight_ = irls.reweight(kernel);
+
+      // S_w.K^T = H.P with S_w = H.P.H^T + R/w
+      K.transpose() = irls.gain(HP);
+    }
+
+    // Schmidt mode, do not correct the considered states
+    considerGain(K);
+
+    x += typename State::Tangent(K * z);
+
+    const auto stage = instrument(Stage::Covariance);
+
+    Covariance<State> IKH = Covariance<State>::Identity() - K * H;
+
+    // The 'Joseph' equation with the weighted noise
+    P = internal::covarianceProduct(IKH, P, K, MRMt / weight_);
+    invalidateCovarianceSquareRoot();
+  }
+
+  /**
+   * @brief Correct the state estimate and its covariance
+   * processing the innovation one scalar component at a time.
+   *
+   * Used for measurement models with a diagonal noise
+   * (see internal::has_diagonal_noise).
+   *
+   * @param [in] H The measurement jacobian
+   * @param [in] MRMt The (diagonal) measurement noise covariance
+   * @param [in] z The innovation
+   *
+   * @note The innovation returned by getInnovation()
+   * is not updated in this mode.
+   * @note Falls back to correct() with considered states.
+   * @see sequentialUpdate
+   */
+  template <typename _DerivedH, typename _DerivedR, typename _DerivedZ>
+  void correctSequential(
+    const Eigen::MatrixBase<_DerivedH>& H,
+    const Eigen::MatrixBase<_DerivedR>& MRMt,
+    const Eigen::MatrixBase<_DerivedZ>& z
+  ) {
+    if (hasConsideredStates()) {
+      correct(H, MRMt, z);
+      return;
+    }
+
     KALMANIF_ASSERT(
-      isCovariance(P),
-      "EKF::update: Updated matrix P is not a covariance."
+      MRMt.isDiagonal(),
+      "EKF::update: Measurement noise is not diagonal."
     );
 
-    return getState();
+    const auto stage = instrument(Stage::Covariance);
+
+    // Update covariance and compute correction
+    const auto dx = sequentialUpdate(P, H, MRMt.diagonal(), z);
+    invalidateCovarianceSquareRoot();
+
+    // Update state using computed correction
+    x += typename State::Tangent(dx);
   }
 };
 
@@ -160,8 +683,8 @@ namespace internal {
 /**
  * @brief traits specialization for ExtendedKalmanFilter
  */
-template <class StateType>
-struct traits<ExtendedKalmanFilter<StateType>> {
+template <class StateType, InnovationSolver Solver>
+struct traits<ExtendedKalmanFilter<StateType, Solver>> {
   using State = StateType;
 };
 
@@ -0,0 +1,717 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_FILTER_BANK_H_
+#define _KALMANIF_KALMANIF_IMPL_FILTER_BANK_H_
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace kalmanif {
+
+/**
+ * @brief A bank of independent filters sharing
+ * the same state and model types.
+ *
+ * @tparam Filter The filter type
+ * @tparam Executor The executor the blocks of filters are processed on,
+ * see SequentialExecutor
+ *
+ * @note Only the ExtendedKalmanFilter and the
+ * InvariantExtendedKalmanFilter are currently supported.
+ */
+template <typename Filter, typename Executor = SequentialExecutor>
+struct FilterBank;
+
+namespace internal {
+
+/**
+ * @brief The structure-of-arrays storage and the coefficient-wise kernels
+ * shared by the filter banks.
+ *
+ * The covariances are stored in a structure-of-arrays layout,
+ * each coefficient of the packed upper triangle of the covariance
+ * (see PackedCovariance) being contiguous across the tracks.
+ * The models are evaluated track by track, but the covariance
+ * propagation and update products then run coefficient-wise
+ * over a block of tracks, which Eigen vectorizes across the tracks
+ * with the SIMD instruction set the code is compiled for.
+ * The blocks are independent and spread over the executor.
+ *
+ * The update whitens the innovation with the Cholesky factor of
+ * each track's measurement noise and processes it one scalar
+ * component at a time, see sequentialUpdate.
+ *
+ * @tparam StateType The state type
+ * @tparam Executor The executor type
+ */
+template <typename StateType, typename Executor>
+struct FilterBankBase {
+
+  using State = StateType;
+  using Scalar = typename internal::traits<State>::Scalar;
+  using Tangent = typename State::Tangent;
+
+  template <typename T>
+  using vector_t = std::vector<T, Eigen::aligned_allocator<T>>;
+
+  //! The number of tracks per block
+  static constexpr Eigen::Index BlockSize = 1024;
+
+  /**
+   * @brief The number of filters
+   */
+  std::size_t size() const {
+    return x_.size();
+  }
+
+  void setState(const std::size_t t, const State& state) {
+    x_[t] = state;
+  }
+
+  const State& getState(const std::size_t t) const {
+    return x_[t];
+  }
+
+  const vector_t<State>& getStates() const {
+    return x_;
+  }
+
+  void setCovariance(
+    const std::size_t t, const Eigen::Ref<const Covariance<State>>& P
+  ) {
+    KALMANIF_CHECK(
+      isCovariance(Covariance<State>(P)),
+      "FilterBank: Not a covariance matrix!",
+      kalmanif::invalid_argument
+    );
+    P_.row(t) = Packed(P).coeffs().transpose();
+  }
+
+  /**
+   * @brief Get the covariance of a filter,
+   * gathered from the structure-of-arrays storage.
+   */
+  Covariance<State> getCovariance(const std::size_t t) const {
+    Packed P;
+    P.coeffs() = P_.row(t).transpose();
+    return P.unpack();
+  }
+
+  void setExecutor(const Executor& executor) {
+    executor_ = executor;
+  }
+
+  const Executor& getExecutor() const {
+    return executor_;
+  }
+
+protected:
+
+  static constexpr int DoF = internal::traits<State>::Size;
+
+  using Lanes = Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+  using Array = Eigen::Array<Scalar, Eigen::Dynamic, 1>;
+  using Packed = PackedCovariance<State>;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(FilterBankBase);
+
+  FilterBankBase(
+    const std::size_t size,
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const Executor& executor
+  ) : x_(size, state_init), P_(size, Packed::PackedSize), executor_(executor) {
+    for (std::size_t t = 0; t < size; ++t) {
+      setCovariance(t, cov_init);
+    }
+  }
+
+  //! Column of the coefficient (i, j) of a DoF x DoF matrix
+  static constexpr int at(const int i, const int j) {
+    return i + j * DoF;
+  }
+
+  //! Column of the coefficient (i, j) of a packed covariance
+  static constexpr int packed(const int i, const int j) {
+    return Packed::index(i, j);
+  }
+
+  /**
+   * @brief Run f(begin, count) over the blocks of tracks, on the executor.
+   */
+  template <typename Function>
+  void forEachBlock(Function&& f) const {
+    const Eigen::Index n = Eigen::Index(size());
+    const int blocks = int((n + BlockSize - 1) / BlockSize);
+    executor_(blocks, [&](const int b) {
+      const Eigen::Index begin = b * BlockSize;
+      f(begin, std::min(BlockSize, n - begin));
+    });
+  }
+
+  /**
+   * @brief Set the per-track jacobian F, noise jacobian W,
+   * measurement jacobian H or whitened innovation Z of track t
+   */
+  template <typename _Derived>
+  static void setLane(
+    Lanes& lanes, const Eigen::Index t, const Eigen::MatrixBase<_Derived>& m
+  ) {
+    using Row = Eigen::Matrix<
+      Scalar, 1, _Derived::RowsAtCompileTime * _Derived::ColsAtCompileTime
+    >;
+    const typename _Derived::PlainObject plain = m;
+    lanes.row(t) = Eigen::Map<const Row>(plain.data());
+  }
+
+  /**
+   * @brief P = F.P.F^T + W.Q.W^T, coefficient-wise over a block,
+   * from the jacobians stored in F_ and W_.
+   */
+  template <int CoF, typename _DerivedQ>
+  void propagateCovariance(
+    const Eigen::Index begin, const Eigen::Index count,
+    const Eigen::MatrixBase<_DerivedQ>& Q
+  ) {
+    auto P = P_.middleRows(begin, count);
+    const auto F = F_.middleRows(begin, count);
+    const auto W = W_.middleRows(begin, count);
+
+    Lanes FP = Lanes::Zero(count, DoF * DoF);
+    for (int l = 0; l < DoF; ++l)
+      for (int k = 0; k < DoF; ++k)
+        for (int i = 0; i < DoF; ++i)
+          FP.col(at(i, l)) += F.col(at(i, k)) * P.col(packed(k, l));
+
+    Lanes WQ = Lanes::Zero(count, DoF * CoF);
+    for (int b = 0; b < CoF; ++b)
+      for (int a = 0; a < CoF; ++a)
+        if (Q(a, b) != Scalar(0))
+          for (int i = 0; i < DoF; ++i)
+            WQ.col(i + b * DoF) += W.col(i + a * DoF) * Q(a, b);
+
+    for (int j = 0; j < DoF; ++j) {
+      for (int i = 0; i <= j; ++i) {
+        auto Pij = P.col(packed(i, j));
+        Pij.setZero();
+        for (int l = 0; l < DoF; ++l)
+          Pij += FP.col(at(i, l)) * F.col(at(j, l));
+        for (int b = 0; b < CoF; ++b)
+          Pij += WQ.col(i + b * DoF) * W.col(j + b * DoF);
+      }
+    }
+  }
+
+  /**
+   * @brief Sequential update of the whitened components,
+   * coefficient-wise over a block, from the whitened jacobians
+   * stored in H_ and innovations stored in Z_.
+   *
+   * Inactive filters have a null jacobian and are left unchanged.
+   * The correction K.z is written to dx_.
+   */
+  template <int MeasSize>
+  void correct(const Eigen::Index begin, const Eigen::Index count) {
+    auto P = P_.middleRows(begin, count);
+    const auto H = H_.middleRows(begin, count);
+    const auto Z = Z_.middleRows(begin, count);
+    auto dx = dx_.middleRows(begin, count);
+
+    dx.setZero();
+    Lanes PHt(count, DoF);
+    Array Hdx(count), s(count), zi(count);
+
+    for (int m = 0; m < MeasSize; ++m) {
+      auto Hm = [&](const int k) { return H.col(m + k * MeasSize); };
+
+      PHt.setZero();
+      for (int l = 0; l < DoF; ++l)
+        for (int k = 0; k < DoF; ++k)
+          PHt.col(k) += P.col(packed(k, l)) * Hm(l);
+
+      s.setOnes();
+      Hdx.setZero();
+      for (int k = 0; k < DoF; ++k) {
+        s += Hm(k) * PHt.col(k);
+        Hdx += Hm(k) * dx.col(k);
+      }
+      zi = (Z.col(m) - Hdx) / s;
+
+      for (int k = 0; k < DoF; ++k)
+        dx.col(k) += PHt.col(k) * zi;
+
+      for (int l = 0; l < DoF; ++l)
+        for (int k = 0; k <= l; ++k)
+          P.col(packed(k, l)) -= PHt.col(k) * PHt.col(l) / s;
+    }
+  }
+
+  /**
+   * @brief Whiten the measurement jacobian H and innovation z
+   * of track t with the Cholesky factor of its measurement noise MRMt,
+   * into H_ and Z_.
+   */
+  template <typename _DerivedH, typename _DerivedR, typename _DerivedZ>
+  void whiten(
+    const Eigen::Index t,
+    const Eigen::MatrixBase<_DerivedH>& H,
+    const Eigen::MatrixBase<_DerivedR>& MRMt,
+    const Eigen::MatrixBase<_DerivedZ>& z
+  ) {
+    const Eigen::LLT<typename _DerivedR::PlainObject> llt(MRMt);
+
+    KALMANIF_CHECK(
+      llt.info() == Eigen::Success,
+      "FilterBank::update: Measurement noise is not positive definite."
+    );
+
+    const auto L = llt.matrixL();
+    setLane(H_, t, L.solve(H));
+    setLane(Z_, t, L.solve(z));
+  }
+
+  /**
+   * @brief Size the workspace for a propagation or an update
+   */
+  void resizeWorkspace(const int F_cols, const int W_cols) {
+    const Eigen::Index n = Eigen::Index(size());
+    F_.resize(n, F_cols);
+    W_.resize(n, W_cols);
+  }
+
+  //! States, one per filter
+  vector_t<State> x_;
+
+  //! Covariances, coefficient (i, j) of filter t at P_(t, packed(i, j))
+  Lanes P_;
+
+  Executor executor_;
+
+  //! Workspace, the per-track jacobians, innovations and corrections
+  Lanes F_, W_, H_, Z_, dx_;
+};
+
+} // namespace internal
+
+/**
+ * @brief A bank of independent Extended Kalman Filters,
+ * e.g. to track many objects with the same models.
+ *
+ * @tparam StateType The state type
+ * @tparam Solver Unused, the bank always updates sequentially
+ * @tparam Executor The executor type
+ *
+ * @see internal::FilterBankBase
+ */
+template <typename StateType, InnovationSolver Solver, typename Executor>
+struct FilterBank<ExtendedKalmanFilter<StateType, Solver>, Executor>
+  : internal::FilterBankBase<StateType, Executor> {
+
+  using Base = internal::FilterBankBase<StateType, Executor>;
+  using typename Base::State;
+  using typename Base::Scalar;
+  using typename Base::Tangent;
+
+  template <typename T>
+  using vector_t = typename Base::template vector_t<T>;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(FilterBank);
+
+  /**
+   * @brief Construct a bank of filters with the same initial estimate
+   * @param size The number of filters
+   * @param state_init The initial state
+   * @param cov_init The initial state covariance
+   * @param executor The executor
+   */
+  FilterBank(
+    const std::size_t size,
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const Executor& executor = Executor()
+  ) : Base(size, state_init, cov_init, executor) {}
+
+  using Base::size;
+
+  /**
+   * @brief Propagate all filters
+   * @param f The system model
+   * @param us The range of controls, one per filter
+   * @param args input arguments for the system model
+   */
+  template <class SystemModelDerived, class ControlRange, typename... Args>
+  void propagate(
+    const SystemModelBase<SystemModelDerived>& f,
+    const ControlRange& us,
+    Args&&... args
+  ) {
+    using Control = typename internal::traits<SystemModelDerived>::Control;
+    constexpr int CoF = internal::traits<Control>::Size;
+
+    const bool sizes_match = std::size_t(std::size(us)) == size();
+    KALMANIF_CHECK(
+      sizes_match,
+      "FilterBank::propagate: Controls size mismatch!",
+      kalmanif::invalid_argument
+    );
+
+    // In real-time mode the check does not throw
+    if (!sizes_match) {
+      return;
+    }
+
+    const Linearized<SystemModelBase<SystemModelDerived>>& fl =
+      static_cast<const SystemModelDerived&>(f);
+    const Covariance<Control> Q = fl.getCovariance();
+
+    this->resizeWorkspace(DoF * DoF, DoF * CoF);
+
+    this->forEachBlock([&](const Eigen::Index begin, const Eigen::Index count) {
+      if constexpr (
+        internal::has_linearized_batch_evaluation<SystemModelDerived>{}
+      ) {
+        // Evaluate the models of the block in a single call,
+        // see internal::has_linearized_batch_evaluation
+        vector_t<Control> ubs(std::size_t(count));
+        vector_t<State> xs_new(std::size_t(count));
+        vector_t<Jacobian<State, State>> Fs(std::size_t(count));
+        vector_t<Jacobian<State, Control>> Ws(std::size_t(count));
+
+        auto u = std::begin(us);
+        std::advance(u, begin);
+        std::copy_n(u, count, ubs.begin());
+
+        fl.batch(x_.data() + begin, ubs, xs_new, Fs, Ws, args...);
+
+        for (Eigen::Index c = 0; c < count; ++c) {
+          x_[begin + c] = xs_new[c];
+          this->setLane(F_, begin + c, Fs[c]);
+          this->setLane(W_, begin + c, Ws[c]);
+        }
+      } else {
+        Jacobian<State, State> Ft;
+        Jacobian<State, Control> Wt;
+
+        // Evaluate the models track by track
+        auto u = std::begin(us);
+        std::advance(u, begin);
+        for (Eigen::Index t = begin; t < begin + count; ++t, ++u) {
+          x_[t] = fl(x_[t], *u, Ft, Wt, args...);
+          this->setLane(F_, t, Ft);
+          this->setLane(W_, t, Wt);
+        }
+      }
+
+      this->template propagateCovariance<CoF>(begin, count, Q);
+    });
+  }
+
+  /**
+   * @brief Update all filters with the same measurement model
+   * @param h The measurement model
+   * @param ys The range of measurements, one per filter
+   */
+  template <class MeasurementModelDerived, class MeasurementRange>
+  void update(
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const MeasurementRange& ys
+  ) {
+    update(h, ys, std::vector<bool>(size(), true));
+  }
+
+  /**
+   * @brief Update the active filters with the same measurement model
+   * @param h The measurement model
+   * @param ys The range of measurements, one per filter
+   * @param active Whether each filter is updated
+   */
+  template <class MeasurementModelDerived, class MeasurementRange>
+  void update(
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const MeasurementRange& ys,
+    const std::vector<bool>& active
+  ) {
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+    constexpr int MeasSize = internal::traits<Measurement>::Size;
+
+    const bool sizes_match =
+      std::size_t(std::size(ys)) == size() && active.size() == size();
+    KALMANIF_CHECK(
+      sizes_match,
+      "FilterBank::update: Measurements size mismatch!",
+      kalmanif::invalid_argument
+    );
+
+    // In real-time mode the check does not throw
+    if (!sizes_match) {
+      return;
+    }
+
+    const Linearized<MeasurementModelBase<MeasurementModelDerived>>& hl =
+      static_cast<const MeasurementModelDerived&>(h);
+    const Covariance<Measurement> R = hl.getCovariance();
+
+    const Eigen::Index n = Eigen::Index(size());
+    H_.setZero(n, MeasSize * DoF);
+    Z_.setZero(n, MeasSize);
+    dx_.resize(n, DoF);
+
+    this->forEachBlock([&](const Eigen::Index begin, const Eigen::Index count) {
+      Jacobian<Measurement, State> Ht;
+      Jacobian<Measurement, Measurement> Mt;
+
+      // Evaluate and whiten the models track by track
+      auto y = std::begin(ys);
+      std::advance(y, begin);
+      for (Eigen::Index t = begin; t < begin + count; ++t, ++y) {
+        if (!active[t]) continue;
+
+        const Measurement e = hl(x_[t], Ht, Mt);
+        this->whiten(t, Ht, Mt * R * Mt.transpose(), *y - e);
+      }
+
+      this->template correct<MeasSize>(begin, count);
+
+      for (Eigen::Index t = begin; t < begin + count; ++t) {
+        if (active[t]) {
+          x_[t] += Tangent(dx_.row(t).matrix().transpose());
+        }
+      }
+    });
+  }
+
+protected:
+
+  using Base::DoF;
+  using Base::x_;
+  using Base::F_;
+  using Base::W_;
+  using Base::H_;
+  using Base::Z_;
+  using Base::dx_;
+};
+
+/**
+ * @brief A bank of independent Invariant Extended Kalman Filters,
+ * e.g. to track many objects with the same models.
+ *
+ * The covariances are right invariant.
+ * The measurement jacobians of left invariant models are mapped
+ * to the right invariant frame, so that every model shares the
+ * same coefficient-wise update.
+ *
+ * @tparam StateType The state type
+ * @tparam Iv The filter invariance, see InvariantExtendedKalmanFilter
+ * @tparam Solver Unused, the bank always updates sequentially
+ * @tparam Executor The executor type
+ *
+ * @see internal::FilterBankBase
+ */
+template <
+  typename StateType, Invariance Iv, InnovationSolver Solver, typename Executor
+>
+struct FilterBank<
+  InvariantExtendedKalmanFilter<StateType, Iv, Solver>, Executor
+> : internal::FilterBankBase<StateType, Executor> {
+
+  static_assert(
+    Iv == Invariance::Right,
+    "FilterBank: Only the right invariant IEKF is supported."
+  );
+
+  using Base = internal::FilterBankBase<StateType, Executor>;
+  using typename Base::State;
+  using typename Base::Scalar;
+  using typename Base::Tangent;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(FilterBank);
+
+  /**
+   * @brief Construct a bank of filters with the same initial estimate
+   * @param size The number of filters
+   * @param state_init The initial state
+   * @param cov_init The initial state covariance
+   * @param executor The executor
+   */
+  FilterBank(
+    const std::size_t size,
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const Executor& executor = Executor()
+  ) : Base(size, state_init, cov_init, executor) {}
+
+  using Base::size;
+
+  /**
+   * @brief Propagate all filters
+   * @param f The system model
+   * @param us The range of controls, one per filter
+   * @param dt The time step
+   */
+  template <class SystemModelDerived, class ControlRange>
+  void propagate(
+    const SystemModelBase<SystemModelDerived>& f,
+    const ControlRange& us,
+    const Scalar dt = 1
+  ) {
+    using Control = typename internal::traits<SystemModelDerived>::Control;
+    constexpr int CoF = internal::traits<Control>::Size;
+
+    const bool sizes_match = std::size_t(std::size(us)) == size();
+    KALMANIF_CHECK(
+      sizes_match,
+      "FilterBank::propagate: Controls size mismatch!",
+      kalmanif::invalid_argument
+    );
+
+    // In real-time mode the check does not throw
+    if (!sizes_match) {
+      return;
+    }
+
+    const LinearizedInvariant<SystemModelBase<SystemModelDerived>>& fl =
+      static_cast<const SystemModelDerived&>(f);
+    const Covariance<Control> Q = fl.getCovariance();
+
+    // Evaluate what the model caches for the time step on the calling
+    // thread, the blocks then only read it, see internal::prepareModel
+    fl.getCovarianceSquareRoot();
+    if constexpr (
+      internal::has_state_independent_invariant_jacobian<SystemModelDerived>{}
+    ) {
+      fl.getInvariantJacobian(dt);
+    }
+    if constexpr (
+      internal::has_constant_invariant_noise_jacobian<SystemModelDerived>{}
+    ) {
+      fl.getInvariantPropagatedNoise(dt);
+    }
+
+    this->resizeWorkspace(DoF * DoF, DoF * CoF);
+
+    this->forEachBlock([&](const Eigen::Index begin, const Eigen::Index count) {
+      Jacobian<State, State> Ft;
+      Jacobian<State, Control> Wt;
+
+      // Evaluate the models track by track
+      auto u = std::begin(us);
+      std::advance(u, begin);
+      for (Eigen::Index t = begin; t < begin + count; ++t, ++u) {
+        x_[t] = fl(x_[t], *u, Ft, Wt, dt);
+        this->setLane(F_, t, Ft);
+        this->setLane(W_, t, Wt);
+      }
+
+      this->template propagateCovariance<CoF>(begin, count, Q);
+    });
+  }
+
+  /**
+   * @brief Update all filters with the same measurement model
+   * @param h The measurement model
+   * @param ys The range of measurements, one per filter
+   */
+  template <class MeasurementModelDerived, class MeasurementRange>
+  void update(
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const MeasurementRange& ys
+  ) {
+    update(h, ys, std::vector<bool>(size(), true));
+  }
+
+  /**
+   * @brief Update the active filters with the same measurement model
+   * @param h The measurement model
+   * @param ys The range of measurements, one per filter
+   * @param active Whether each filter is updated
+   */
+  template <class MeasurementModelDerived, class MeasurementRange>
+  void update(
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const MeasurementRange& ys,
+    const std::vector<bool>& active
+  ) {
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+    constexpr int MeasSize = internal::traits<Measurement>::Size;
+    constexpr bool Left =
+      LinearizedInvariant<MeasurementModelBase<MeasurementModelDerived>>::
+        ModelInvariance == Invariance::Left;
+
+    const bool sizes_match =
+      std::size_t(std::size(ys)) == size() && active.size() == size();
+    KALMANIF_CHECK(
+      sizes_match,
+      "FilterBank::update: Measurements size mismatch!",
+      kalmanif::invalid_argument
+    );
+
+    // In real-time mode the check does not throw
+    if (!sizes_match) {
+      return;
+    }
+
+    const LinearizedInvariant<MeasurementModelBase<MeasurementModelDerived>>&
+      hl = static_cast<const MeasurementModelDerived&>(h);
+    const Covariance<Measurement> R = hl.getCovariance();
+
+    const Eigen::Index n = Eigen::Index(size());
+    H_.setZero(n, MeasSize * DoF);
+    Z_.setZero(n, MeasSize);
+    dx_.resize(n, DoF);
+
+    this->forEachBlock([&](const Eigen::Index begin, const Eigen::Index count) {
+      Jacobian<Measurement, State> Ht;
+      Jacobian<Measurement, Measurement> Mt;
+
+      // Evaluate and whiten the models track by track
+      auto y = std::begin(ys);
+      std::advance(y, begin);
+      for (Eigen::Index t = begin; t < begin + count; ++t, ++y) {
+        if (!active[t]) continue;
+
+        const Measurement e = hl(x_[t], Ht, Mt);
+        if constexpr (Left) {
+          // H.Ad(X^-1) maps the right invariant covariance
+          // to the left invariant frame of the model
+          Ht = Ht * x_[t].inverse().adj();
+        }
+        this->whiten(t, Ht, Mt * R * Mt.transpose(), Mt * (*y - e));
+      }
+
+      this->template correct<MeasSize>(begin, count);
+
+      for (Eigen::Index t = begin; t < begin + count; ++t) {
+        if (!active[t]) continue;
+
+        // Right invariant: Exp(-dx) * X
+        const Tangent dx(-dx_.row(t).matrix().transpose());
+        if constexpr (Left) {
+          // Map the covariance back at the updated state,
+          // Ad(X+).Ad(X^-1) = Ad(Exp(-dx))
+          const Jacobian<State, State> Ad = dx.exp().adj();
+          const Covariance<State> P = this->getCovariance(t);
+          P_.row(t) =
+            Packed(internal::covarianceProduct(Ad, P)).coeffs().transpose();
+        }
+        x_[t] = dx + x_[t];
+      }
+    });
+  }
+
+protected:
+
+  using Base::DoF;
+  using Base::x_;
+  using Base::P_;
+  using Base::F_;
+  using Base::W_;
+  using Base::H_;
+  using Base::Z_;
+  using Base::dx_;
+  using typename Base::Packed;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_FILTER_BANK_H_
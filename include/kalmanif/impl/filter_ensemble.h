@@ -0,0 +1,245 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_FILTER_ENSEMBLE_H_
+#define _KALMANIF_KALMANIF_IMPL_FILTER_ENSEMBLE_H_
+
+#include <array>
+#include <tuple>
+#include <utility>
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief Evaluate on the calling thread what the system model
+ * caches for a propagation, e.g. its noise square root or its
+ * state-independent invariant jacobian for the time step,
+ * so that concurrent filters then only read the shared cache.
+ *
+ * @param f The system model
+ * @param args The input arguments for the system model,
+ * the time step for the cached jacobians.
+ */
+template <class SystemModelDerived, typename... Args>
+void prepareModel(
+  const SystemModelBase<SystemModelDerived>& f, const Args&... args
+) {
+  const SystemModelDerived& model = static_cast<const SystemModelDerived&>(f);
+
+  model.getCovarianceSquareRoot();
+
+  if constexpr (sizeof...(Args) == 1) {
+    if constexpr (has_state_independent_invariant_jacobian<SystemModelDerived>{}) {
+      model.getInvariantJacobian(args...);
+    }
+    if constexpr (has_constant_invariant_noise_jacobian<SystemModelDerived>{}) {
+      model.getInvariantPropagatedNoise(args...);
+    }
+  }
+}
+
+/**
+ * @brief Evaluate on the calling thread what the measurement model caches.
+ *
+ * @param h The measurement model
+ */
+template <class MeasurementModelDerived>
+void prepareModel(const MeasurementModelBase<MeasurementModelDerived>& h) {
+  static_cast<const MeasurementModelDerived&>(h).getCovarianceSquareRoot();
+}
+
+} // namespace internal
+
+/**
+ * @brief An ensemble of heterogeneous filters run side by side
+ * on the same inputs.
+ *
+ * @tparam Filters A std::tuple of the filter types
+ * @tparam Executor The executor running the filters
+ */
+template <typename Filters, typename Executor = ThreadPoolExecutor>
+struct FilterEnsemble;
+
+/**
+ * @brief An ensemble of heterogeneous filters (or smoothers)
+ * of the same state, e.g. for redundancy or A/B monitoring.
+ *
+ * Each propagation and update is broadcast to all the filters,
+ * which run concurrently on the executor. The filters are dispatched
+ * through the tuple at compile time, without virtual calls.
+ *
+ * The models are shared by the filters: what they cache is evaluated
+ * once on the calling thread before the filters run
+ * (see internal::prepareModel), e.g. the noise square roots and the
+ * state-independent invariant jacobian of the time step.
+ * The models evaluations at the filters estimates are, by nature, not shared.
+ *
+ * @code
+ * FilterEnsemble<std::tuple<EKF, IEKF, UKFM>> ensemble(X0, P0);
+ * ensemble.propagate(imu, u, dt);
+ * ensemble.update(h, y);
+ * const auto& ukfm = ensemble.get<2>();
+ * @endcode
+ *
+ * @note A filter with a different propagation signature,
+ * e.g. taking a time step the others do not, is not supported.
+ *
+ * @tparam Filters The filter types
+ * @tparam Executor The executor running the filters,
+ * e.g. ThreadPoolExecutor or SequentialExecutor.
+ */
+template <typename... Filters, typename Executor>
+struct FilterEnsemble<std::tuple<Filters...>, Executor> {
+
+  static_assert(
+    sizeof...(Filters) > 0, "FilterEnsemble: At least one filter is required!"
+  );
+
+  using Tuple = std::tuple<Filters...>;
+  using State = typename std::tuple_element_t<0, Tuple>::State;
+
+  static_assert(
+    (std::is_same<typename Filters::State, State>::value && ...),
+    "FilterEnsemble: The filters must share the same state type!"
+  );
+
+  //! The number of filters
+  static constexpr std::size_t Size = sizeof...(Filters);
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  /**
+   * @brief Construct an ensemble from its filters
+   * @param filters The filters
+   * @param executor The executor running the filters
+   */
+  explicit FilterEnsemble(
+    const Tuple& filters, const Executor& executor = Executor()
+  ) : filters_(filters), executor_(executor) {}
+
+  /**
+   * @brief Construct an ensemble of filters with the same initial estimate
+   * @param state_init The initial state
+   * @param cov_init The initial state covariance
+   * @param executor The executor running the filters
+   */
+  FilterEnsemble(
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const Executor& executor = Executor()
+  ) : filters_(Filters(state_init, cov_init)...), executor_(executor) {}
+
+  /**
+   * @brief Perform the propagation of all filters
+   *
+   * @param [in] f The system model
+   * @param [in] u The input control
+   * @param [in] args input arguments for the system model
+   */
+  template <class SystemModelDerived, typename... Args>
+  void propagate(
+    const SystemModelBase<SystemModelDerived>& f,
+    const typename internal::traits<SystemModelDerived>::Control& u,
+    const Args&... args
+  ) {
+    const SystemModelDerived& model = static_cast<const SystemModelDerived&>(f);
+    internal::prepareModel(f, args...);
+    forEach([&](auto& filter){
+      filter.propagate(model, u, args...);
+    });
+  }
+
+  /**
+   * @brief Perform the update of all filters
+   *
+   * @param [in] h The measurement model
+   * @param [in] y The measurement vector
+   * @param [in] args input arguments for the measurement model
+   */
+  template <class MeasurementModelDerived, typename... Args>
+  void update(
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    const Args&... args
+  ) {
+    const MeasurementModelDerived& model =
+      static_cast<const MeasurementModelDerived&>(h);
+    internal::prepareModel(h);
+    forEach([&](auto& filter){
+      filter.update(model, y, args...);
+    });
+  }
+
+  /**
+   * @brief Perform the stacked update of all filters
+   *
+   * @param [in] hs The range of measurement models
+   * @param [in] ys The range of measurement vectors
+   */
+  template <
+    class MeasurementModelRange,
+    class MeasurementRange,
+    typename = internal::enable_if_is_measurement_model_range<
+      MeasurementModelRange
+    >
+  >
+  void update(const MeasurementModelRange& hs, const MeasurementRange& ys) {
+    for (const auto& h : hs) {
+      internal::prepareModel(h);
+    }
+    forEach([&](auto& filter){
+      filter.update(hs, ys);
+    });
+  }
+
+  /**
+   * @brief Run a function on each filter, concurrently
+   *
+   * @param function A function callable on every filter type,
+   * e.g. a generic lambda.
+   */
+  template <typename Function>
+  void forEach(Function&& function) {
+    executor_(int(Size), [&](const int i){
+      visit(i, function, std::index_sequence_for<Filters...>());
+    });
+  }
+
+  /**
+   * @brief Get the I-th filter
+   */
+  template <std::size_t I>
+  const std::tuple_element_t<I, Tuple>& get() const {
+    return std::get<I>(filters_);
+  }
+
+  template <std::size_t I>
+  std::tuple_element_t<I, Tuple>& get() {
+    return std::get<I>(filters_);
+  }
+
+  const Tuple& getFilters() const {
+    return filters_;
+  }
+
+  /**
+   * @brief Get the states of all filters
+   */
+  std::array<State, Size> getStates() const {
+    return std::apply([](const auto&... filter){
+      return std::array<State, Size>{filter.getState()...};
+    }, filters_);
+  }
+
+protected:
+
+  template <typename Function, std::size_t... Is>
+  void visit(const int i, Function& function, std::index_sequence<Is...>) {
+    ((i == int(Is) ? void(function(std::get<Is>(filters_))) : void()), ...);
+  }
+
+  Tuple filters_;
+  Executor executor_;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_FILTER_ENSEMBLE_H_
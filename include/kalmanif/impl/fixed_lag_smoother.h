@@ -0,0 +1,228 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_FIXED_LAG_SMOOTHER_H_
+#define _KALMANIF_KALMANIF_IMPL_FIXED_LAG_SMOOTHER_H_
+
+#include <array>
+
+namespace kalmanif {
+
+/**
+ * @brief The fixed-lag Rauch-Tung-Striebel Smoother
+ *
+ * A streaming smoother keeping the last Lag+1 epochs in a ring buffer.
+ * After each update, it emits the smoothed estimate of the epoch
+ * Lag steps ago. Its cost is O(Lag) per update and its memory
+ * is constant regardless of the run length.
+ *
+ * @note The smoothed estimate of an epoch k given the epochs up to k+Lag
+ * is the one the batch RauchTungStriebelSmoother
+ * would produce on the epochs up to k+Lag.
+ *
+ * @tparam Filter The underlying filter type.
+ * @tparam Lag The smoothing lag, in epochs.
+ *
+ * @see RauchTungStriebelSmoother
+ */
+template <typename Filter, std::size_t Lag>
+struct FixedLagSmoother {
+
+  static_assert(Lag > 0, "FixedLagSmoother: Lag must be positive.");
+
+  using State = typename Filter::State;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(FixedLagSmoother);
+
+  FixedLagSmoother(
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init
+  ) : filter_(state_init, cov_init) { }
+
+  /**
+   * @brief Performs the underlying filter's propagation.
+   */
+  template <class SystemModelDerived, typename... Args>
+  const State& propagate(
+    const SystemModelBase<SystemModelDerived>& f,
+    const typename internal::traits<SystemModelDerived>::Control& u,
+    Args&&... args
+  ) {
+
+    {
+      // The filter records its transition in our storage
+      const internal::ScopedOutput<Jacobian<State, State>> transition(
+        filter_.transition_, &Ak_
+      );
+      filter_.propagate(f, u, std::forward<Args>(args)...);
+    }
+    const State& xtmp = filter_.getState();
+    const Jacobian<State, State>& Aktmp = Ak_;
+
+    if (updated_) {
+      // Drop the oldest epoch
+      if (size_ == Size) {
+        first_ = (first_ + 1) % Size;
+        --size_;
+      }
+      ++size_;
+      back().A = Aktmp;
+      updated_ = false;
+    } else if (internal::isLazyPropagation(filter_)) {
+      // A lazy filter records the transition since the last update
+      back().A = Aktmp;
+    } else {
+      internal::composeTransition<Filter>(back(), Aktmp);
+    }
+
+    back().x_pred = xtmp;
+    back().P_pred = filter_.getCovariance();
+
+    if constexpr (internal::has_predicted_square_root<Filter>{}) {
+      back().S_pred = filter_.getCovarianceSquareRoot();
+    }
+
+    return filter_.getState();
+  }
+
+  /**
+   * @brief Performs the underlying filter's update
+   * and the backward pass over the lag.
+   */
+  template <typename MeasurementModelDerived, typename... Args>
+  const State& update(
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    Args&&... args
+  ) {
+
+    filter_.update(h, y, std::forward<Args>(args)...);
+
+    recordUpdate();
+
+    return filter_.getState();
+  }
+
+  /**
+   * @brief Performs the underlying filter's stacked update
+   * and the backward pass over the lag.
+   */
+  template <
+    class MeasurementModelRange,
+    class MeasurementRange,
+    typename = internal::enable_if_is_measurement_model_range<
+      MeasurementModelRange
+    >
+  >
+  const State& update(
+    const MeasurementModelRange& hs,
+    const MeasurementRange& ys
+  ) {
+
+    filter_.update(hs, ys);
+
+    recordUpdate();
+
+    return filter_.getState();
+  }
+
+  const State& getState() const {
+    return filter_.getState();
+  }
+
+  const Covariance<State>& getCovariance() const {
+    return filter_.getCovariance();
+  }
+
+  /**
+   * @brief Whether a smoothed estimate is available,
+   * i.e. whether Lag+1 epochs were recorded.
+   */
+  bool hasLaggedEstimate() const {
+    return has_lagged_;
+  }
+
+  /**
+   * @brief Get the smoothed state of the epoch Lag steps ago.
+   */
+  const State& getLaggedState() const {
+    return Xs_;
+  }
+
+  /**
+   * @brief Get the smoothed covariance of the epoch Lag steps ago.
+   */
+  const Covariance<State>& getLaggedCovariance() const {
+    return Ps_;
+  }
+
+  void clear() {
+    first_ = 0;
+    size_ = 0;
+    has_lagged_ = false;
+    updated_ = true;
+  }
+
+protected:
+
+  using Epoch = internal::SmootherEpoch<State>;
+
+  static constexpr std::size_t Size = Lag + 1;
+
+  Epoch& at(const std::size_t i) {
+    return epochs_[(first_ + i) % Size];
+  }
+
+  Epoch& back() {
+    return at(size_ - 1);
+  }
+
+  /**
+   * @brief Record the underlying filter's updated state and covariance,
+   * then smooth backward from the last epoch to the one Lag steps ago.
+   */
+  void recordUpdate() {
+    KALMANIF_ASSERT(
+      size_ > 0,
+      "FixedLagSmoother: update before any propagation!"
+    );
+
+    updated_ = true;
+
+    back().x_est = filter_.getState();
+    back().P_est = filter_.getCovariance();
+
+    if (size_ < Size) {
+      return;
+    }
+
+    Xs_ = back().x_est;
+    Ps_ = back().P_est;
+
+    for (std::size_t k = Lag; k-- > 0;) {
+      internal::smoothEpoch<Filter>(at(k), at(k+1), Xs_, Ps_);
+    }
+
+    has_lagged_ = true;
+  }
+
+  bool updated_ = true;
+
+  Filter filter_;
+
+  //! Ring buffer of the last Lag+1 epochs
+  std::array<Epoch, Size> epochs_;
+  std::size_t first_ = 0;
+  std::size_t size_ = 0;
+
+  //! Smoothed state and covariance Lag steps ago
+  State Xs_ = State::Identity();
+  Covariance<State> Ps_ = Covariance<State>::Identity();
+  bool has_lagged_ = false;
+
+  //! The transition of the last propagation, recorded by the filter
+  Jacobian<State, State> Ak_ = Jacobian<State, State>::Zero();
+};
+
+} // kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_FIXED_LAG_SMOOTHER_H_
@@ -0,0 +1,56 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_FOOTPRINT_H_
+#define _KALMANIF_KALMANIF_IMPL_FOOTPRINT_H_
+
+#include <cstddef>
+
+namespace kalmanif {
+
+/**
+ * @brief The memory footprint of a filter (or smoother) type,
+ * known at compile time, e.g. to size banks and arenas ahead of time.
+ *
+ * It is the footprint of the object itself. A filter of a fixed-size
+ * state holds its estimate and workspace inline, the footprint is then
+ * all its memory but for what its executor or instrumentation may own.
+ * The smoothers and the filters of a dynamic-size state also hold
+ * heap storage, growing with the epochs or the state.
+ *
+ * @tparam Filter The filter type
+ */
+template <typename Filter>
+struct FilterFootprint {
+
+  //! The size in bytes of a filter
+  static constexpr std::size_t Size = sizeof(Filter);
+
+  //! The alignment in bytes of a filter
+  static constexpr std::size_t Alignment = alignof(Filter);
+
+  /**
+   * @brief The size in bytes of an array of n filters.
+   */
+  static constexpr std::size_t bytes(const std::size_t n) {
+    return n * Size;
+  }
+
+  /**
+   * @brief The size in bytes of a buffer of any alignment
+   * holding n aligned filters.
+   */
+  static constexpr std::size_t arenaBytes(const std::size_t n) {
+    return n == 0 ? 0 : bytes(n) + Alignment - 1;
+  }
+};
+
+/**
+ * @brief The size in bytes of a filter type.
+ * @see FilterFootprint
+ */
+template <typename Filter>
+constexpr std::size_t footprint() {
+  return FilterFootprint<Filter>::Size;
+}
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_FOOTPRINT_H_
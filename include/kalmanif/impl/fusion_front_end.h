@@ -0,0 +1,452 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_FUSION_FRONT_END_H_
+#define _KALMANIF_KALMANIF_IMPL_FUSION_FRONT_END_H_
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief A stream of time-stamped inputs of the front end.
+ */
+template <typename Filter>
+struct FusionStreamBase {
+
+  virtual ~FusionStreamBase() = default;
+
+  /**
+   * @brief Get the time of the next input, from the filter thread only
+   * @return Whether there is an input
+   */
+  virtual bool peek(double& t) = 0;
+
+  /**
+   * @brief Apply the next input to the filter and pop it,
+   * from the filter thread only
+   * @param filter The filter
+   * @param dt The time elapsed since the last input
+   */
+  virtual void apply(Filter& filter, const double dt) = 0;
+};
+
+/**
+ * @brief The estimate published by the front end,
+ * trivially copyable for the SeqLock.
+ */
+template <typename State>
+struct PublishedEstimate {
+  using Scalar = typename internal::traits<State>::Scalar;
+
+  double t;
+  std::size_t steps;
+  Scalar coeffs[State::RepSize];
+  Scalar covariance[State::DoF * State::DoF];
+};
+
+} // namespace internal
+
+/**
+ * @brief A time-stamped estimate
+ */
+template <typename StateType>
+struct TimedEstimate : Estimate<StateType> {
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  //! The time of the last step
+  double t = 0;
+  //! The number of steps performed
+  std::size_t steps = 0;
+};
+
+/**
+ * @brief An asynchronous sensor-fusion front end owning a filter.
+ *
+ * Each sensor stream feeds a bounded lock-free queue,
+ * from any number of driver threads. A dedicated thread pops
+ * the inputs, the earliest available first, and runs the filter
+ * propagations and updates. The estimate is published after each
+ * step through a sequence lock.
+ * The drivers thus never block on the filter, nor the filter on
+ * the readers of its estimate.
+ *
+ * @code
+ * FusionFrontEnd<EKF> fusion(t0, X0, P0);
+ * auto& imu = fusion.addControlStream(system_model);
+ * auto& camera = fusion.addMeasurementStream(measurement_model);
+ * fusion.start();
+ * // in the drivers threads
+ * imu.push(t, u);
+ * camera.push(t, y);
+ * // anywhere
+ * const auto estimate = fusion.getEstimate();
+ * @endcode
+ *
+ * @note The inputs of different streams are only ordered among those
+ * available when a step is taken. Inputs older than the last step
+ * are still applied and counted as late, see getLateCount.
+ * A late control is applied over a zero time step, dt = 0,
+ * if its system model propagates over one.
+ * @note The models are held by reference for the front end lifetime.
+ *
+ * @tparam Filter The filter type
+ */
+template <typename Filter>
+class FusionFrontEnd {
+
+public:
+
+  using State = typename internal::traits<Filter>::State;
+
+  template <typename SystemModel> class ControlStream;
+  template <typename MeasurementModel> class MeasurementStream;
+
+  /**
+   * @brief Construct a front end
+   * @param t_init The time of the initial estimate
+   * @param args The arguments of the filter constructor,
+   * e.g. the initial state and covariance.
+   */
+  template <typename... Args>
+  explicit FusionFrontEnd(const double t_init, Args&&... args)
+    : filter_(std::forward<Args>(args)...), t_(t_init) {
+    publish();
+  }
+
+  FusionFrontEnd(const FusionFrontEnd&) = delete;
+  FusionFrontEnd& operator =(const FusionFrontEnd&) = delete;
+
+  ~FusionFrontEnd() {
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  /**
+   * @brief Add a stream of controls propagating the filter
+   *
+   * @param f The system model
+   * @param capacity The capacity of the stream queue
+   * @return The stream, to push the controls to
+   * @throw kalmanif::runtime_error if the front end is running
+   */
+  template <typename SystemModel>
+  ControlStream<SystemModel>& addControlStream(
+    const SystemModel& f, const std::size_t capacity = 1024
+  ) {
+    return addStream<ControlStream<SystemModel>>(f, capacity);
+  }
+
+  /**
+   * @brief Add a stream of measurements updating the filter
+   *
+   * @param h The measurement model
+   * @param capacity The capacity of the stream queue
+   * @return The stream, to push the measurements to
+   * @throw kalmanif::runtime_error if the front end is running
+   */
+  template <typename MeasurementModel>
+  MeasurementStream<MeasurementModel>& addMeasurementStream(
+    const MeasurementModel& h, const std::size_t capacity = 1024
+  ) {
+    return addStream<MeasurementStream<MeasurementModel>>(h, capacity);
+  }
+
+  /**
+   * @brief Start the filter thread
+   *
+   * @param idle_sleep How long the filter thread sleeps
+   * when it found no input after spinning a while.
+   */
+  void start(
+    const std::chrono::microseconds idle_sleep = std::chrono::microseconds(100)
+  ) {
+    KALMANIF_ENSURE(
+      !thread_.joinable(), "FusionFrontEnd: Already started!"
+    );
+    idle_sleep_ = idle_sleep;
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this](){ run(); });
+  }
+
+  /**
+   * @brief Stop the filter thread once the queued inputs are processed.
+   *
+   * @throw The exception that stopped the filter thread, if any.
+   */
+  void stop() {
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    if (error_) {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+  }
+
+  /**
+   * @brief Whether the filter thread is running
+   */
+  bool isRunning() const {
+    return running_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Get the last published estimate, from any thread
+   */
+  TimedEstimate<State> getEstimate() const {
+    const internal::PublishedEstimate<State> published = estimate_.load();
+
+    TimedEstimate<State> estimate;
+    estimate.t = published.t;
+    estimate.steps = published.steps;
+    estimate.state.coeffs() =
+      Eigen::Map<const typename State::DataType>(published.coeffs);
+    estimate.covariance =
+      Eigen::Map<const Covariance<State>>(published.covariance);
+    return estimate;
+  }
+
+  /**
+   * @brief Get the number of steps performed, from any thread
+   */
+  std::size_t getStepCount() const {
+    return steps_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Get the number of inputs older than the last step
+   * when they were processed, from any thread
+   */
+  std::size_t getLateCount() const {
+    return late_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Get the filter, only while stopped
+   */
+  const Filter& getFilter() const {
+    return filter_;
+  }
+
+protected:
+
+  using Stream = internal::FusionStreamBase<Filter>;
+
+  template <typename S, typename Model>
+  S& addStream(const Model& model, const std::size_t capacity) {
+    KALMANIF_ENSURE(
+      !thread_.joinable(), "FusionFrontEnd: Cannot add a stream once started!"
+    );
+    streams_.push_back(std::make_unique<S>(model, capacity));
+    return static_cast<S&>(*streams_.back());
+  }
+
+  void run() {
+    // spin a while before sleeping
+    constexpr int Spins = 64;
+    int idle = 0;
+
+    try {
+      while (true) {
+        if (step()) {
+          idle = 0;
+        } else if (!running_.load(std::memory_order_acquire)) {
+          // drained
+          break;
+        } else if (++idle < Spins) {
+          std::this_thread::yield();
+        } else {
+          std::this_thread::sleep_for(idle_sleep_);
+        }
+      }
+    } catch (...) {
+      error_ = std::current_exception();
+      running_.store(false, std::memory_order_release);
+    }
+  }
+
+  //! Apply the earliest available input, if any
+  bool step() {
+    Stream* next = nullptr;
+    double t_next = 0;
+    for (const auto& stream : streams_) {
+      double t;
+      if (stream->peek(t) && (next == nullptr || t < t_next)) {
+        next = stream.get();
+        t_next = t;
+      }
+    }
+
+    if (next == nullptr) {
+      return false;
+    }
+
+    if (t_next < t_) {
+      late_.fetch_add(1, std::memory_order_release);
+      next->apply(filter_, 0);
+    } else {
+      next->apply(filter_, t_next - t_);
+      t_ = t_next;
+    }
+
+    steps_.fetch_add(1, std::memory_order_release);
+    publish();
+
+    return true;
+  }
+
+  void publish() {
+    internal::PublishedEstimate<State> published;
+    published.t = t_;
+    published.steps = steps_.load(std::memory_order_relaxed);
+    Eigen::Map<typename State::DataType>(published.coeffs) =
+      filter_.getState().coeffs();
+    Eigen::Map<Covariance<State>>(published.covariance) =
+      filter_.getCovariance();
+    estimate_.store(published);
+  }
+
+  Filter filter_;
+  double t_;
+
+  std::vector<std::unique_ptr<Stream>> streams_;
+
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+  std::chrono::microseconds idle_sleep_{100};
+  std::exception_ptr error_;
+
+  std::atomic<std::size_t> steps_{0};
+  std::atomic<std::size_t> late_{0};
+
+  SeqLock<internal::PublishedEstimate<State>> estimate_;
+};
+
+/**
+ * @brief A stream of time-stamped controls
+ *
+ * The time elapsed since the last input is forwarded to the
+ * propagation if the system model propagates over a time step,
+ * see internal::has_time_step_evaluation, e.g. the
+ * SimpleImuSystemModel, whatever the filter; 0 for a late control.
+ *
+ * @tparam SystemModel The system model type
+ */
+template <typename Filter>
+template <typename SystemModel>
+class FusionFrontEnd<Filter>::ControlStream
+  : public internal::FusionStreamBase<Filter> {
+
+public:
+
+  using Control = typename internal::traits<SystemModel>::Control;
+
+  ControlStream(const SystemModel& f, const std::size_t capacity)
+    : f_(f), queue_(capacity) {}
+
+  /**
+   * @brief Push a control, from any thread
+   * @param t The time after the propagation
+   * @param u The control
+   * @return Whether it was pushed, false if the stream queue is full.
+   */
+  bool push(const double t, const Control& u) {
+    return queue_.push(Item{t, u});
+  }
+
+protected:
+
+  struct Item {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+    double t = 0;
+    Control u;
+  };
+
+  bool peek(double& t) override {
+    const Item* item = queue_.front();
+    if (item == nullptr) {
+      return false;
+    }
+    t = item->t;
+    return true;
+  }
+
+  void apply(Filter& filter, const double dt) override {
+    const Item& item = *queue_.front();
+    if constexpr (internal::has_time_step_evaluation<SystemModel>::value) {
+      filter.propagate(f_, item.u, dt);
+    } else {
+      (void)dt;
+      filter.propagate(f_, item.u);
+    }
+    queue_.pop();
+  }
+
+  const SystemModel& f_;
+  MpscQueue<Item> queue_;
+};
+
+/**
+ * @brief A stream of time-stamped measurements
+ *
+ * @tparam MeasurementModel The measurement model type
+ */
+template <typename Filter>
+template <typename MeasurementModel>
+class FusionFrontEnd<Filter>::MeasurementStream
+  : public internal::FusionStreamBase<Filter> {
+
+public:
+
+  using Measurement = typename internal::traits<MeasurementModel>::Measurement;
+
+  MeasurementStream(const MeasurementModel& h, const std::size_t capacity)
+    : h_(h), queue_(capacity) {}
+
+  /**
+   * @brief Push a measurement, from any thread
+   * @param t The measurement time
+   * @param y The measurement
+   * @return Whether it was pushed, false if the stream queue is full.
+   */
+  bool push(const double t, const Measurement& y) {
+    return queue_.push(Item{t, y});
+  }
+
+protected:
+
+  struct Item {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+    double t = 0;
+    Measurement y;
+  };
+
+  bool peek(double& t) override {
+    const Item* item = queue_.front();
+    if (item == nullptr) {
+      return false;
+    }
+    t = item->t;
+    return true;
+  }
+
+  void apply(Filter& filter, const double) override {
+    filter.update(h_, queue_.front()->y);
+    queue_.pop();
+  }
+
+  const MeasurementModel& h_;
+  MpscQueue<Item> queue_;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_FUSION_FRONT_END_H_
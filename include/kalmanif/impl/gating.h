@@ -0,0 +1,23 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_GATING_H_
+#define _KALMANIF_KALMANIF_IMPL_GATING_H_
+
+#include <limits>
+
+namespace kalmanif {
+
+/**
+ * @brief A Mahalanobis gate on the innovation.
+ *
+ * A measurement is rejected if its Normalized Innovation Squared
+ * \f$ z^T S^{-1} z \f$ exceeds the threshold, usually a chi-squared
+ * quantile with as many degrees of freedom as the measurement size,
+ * e.g. at 99%: 6.63 (1), 9.21 (2), 11.34 (3), 13.28 (4), 15.09 (5).
+ */
+struct MahalanobisGate {
+  //! The NIS above which a measurement is rejected
+  double threshold = std::numeric_limits<double>::infinity();
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_GATING_H_
@@ -0,0 +1,279 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_HEALTH_MONITOR_H_
+#define _KALMANIF_KALMANIF_IMPL_HEALTH_MONITOR_H_
+
+#include <array>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+namespace kalmanif {
+
+/**
+ * @brief Enum for the numerical health issues of a filter
+ */
+enum class HealthIssue : char {
+  CovarianceConditioning = 0, // The state covariance is ill-conditioned
+  InnovationConditioning,     // The innovation covariance is ill-conditioned
+  CovarianceRepairs           // The state covariance had to be repaired
+};
+
+/**
+ * @brief The thresholds of the numerical health of a filter
+ */
+struct HealthThresholds {
+  //! The state covariance condition number above which to raise an issue
+  double covariance_condition = 1e12;
+  //! The innovation covariance condition number above which to raise an issue
+  double innovation_condition = 1e12;
+  //! The number of repairs between two samples above which to raise an issue
+  std::size_t repairs = 0;
+};
+
+/**
+ * @brief A numerical health issue raised by the HealthMonitor
+ */
+struct HealthEvent {
+  HealthIssue issue;
+  //! The sampled value, a condition number or a number of repairs
+  double value;
+  //! The crossed threshold
+  double threshold;
+};
+
+/**
+ * @brief The numerical health statistics of a filter
+ */
+struct HealthStatistics {
+  //! The number of samples
+  std::size_t samples = 0;
+  //! The last and largest estimated condition numbers of the state covariance
+  double covariance_condition = 0, max_covariance_condition = 0;
+  //! The last and largest estimated condition numbers of the innovation covariance
+  double innovation_condition = 0, max_innovation_condition = 0;
+  //! The number of covariance repairs
+  std::size_t repairs = 0;
+};
+
+namespace internal {
+
+/**
+ * @brief Estimate the condition number of a matrix
+ * from its Cholesky decomposition, as the squared ratio of
+ * the largest to the smallest diagonal entry of the factor.
+ *
+ * @note This is a lower bound of the actual (2-norm)
+ * condition number, exact for diagonal matrices, obtained in O(n).
+ */
+template <typename _MatrixType, int _UpLo>
+double conditionEstimate(const Eigen::LLT<_MatrixType, _UpLo>& llt) {
+  const auto d = llt.matrixLLT().diagonal().cwiseAbs();
+  const double r = double(d.maxCoeff()) / double(d.minCoeff());
+  return r * r;
+}
+
+/**
+ * @brief Estimate the condition number of a matrix
+ * from its LDLT decomposition, as the ratio of the extremal
+ * absolute entries of D.
+ */
+template <typename _MatrixType, int _UpLo>
+double conditionEstimate(const Eigen::LDLT<_MatrixType, _UpLo>& ldlt) {
+  const auto d = ldlt.vectorD().cwiseAbs();
+  return double(d.maxCoeff()) / double(d.minCoeff());
+}
+
+/**
+ * @brief Estimate the condition number of a matrix
+ * from its column pivoting QR decomposition, as the ratio of
+ * the extremal absolute diagonal entries of R.
+ */
+template <typename _MatrixType>
+double conditionEstimate(
+  const Eigen::ColPivHouseholderQR<_MatrixType>& qr
+) {
+  const auto d = qr.matrixR().diagonal().cwiseAbs();
+  return double(d.maxCoeff()) / double(d.minCoeff());
+}
+
+template <typename T, class Enable = void>
+struct has_innovation_decomposition : std::false_type {};
+
+template <typename T>
+struct has_innovation_decomposition<
+  T, std::void_t<decltype(std::declval<const T&>().getInnovationDecomposition())>
+> : std::true_type {};
+
+template <typename T, class Enable = void>
+struct has_covariance_repair_count : std::false_type {};
+
+template <typename T>
+struct has_covariance_repair_count<
+  T, std::void_t<decltype(std::declval<const T&>().getCovarianceRepairCount())>
+> : std::true_type {};
+
+} // namespace internal
+
+/**
+ * @brief A sampled numerical health monitor of a filter.
+ *
+ * Every 'period' calls to check, the monitor samples
+ * - the condition number of the state covariance,
+ * estimated from its cached square root,
+ * - the condition number of the innovation covariance of the last update,
+ * estimated from its decomposition (if the filter exposes it),
+ * - the number of covariance repairs (if the filter counts them).
+ *
+ * No decomposition is computed for the estimates,
+ * but for a state covariance square root invalidated since the last
+ * update, which the filter would compute on demand anyway.
+ * A callback is raised when a threshold is crossed, and raised again
+ * only once the value went back below it, so that the filter
+ * may be reset before it diverges.
+ *
+ * @code
+ * HealthMonitor monitor(10);
+ * monitor.setCallback([&](const HealthEvent& e){ reset(ekf); });
+ * ekf.update(h, y);
+ * monitor.check(ekf);
+ * @endcode
+ */
+struct HealthMonitor {
+
+  using Callback = std::function<void(const HealthEvent&)>;
+
+  /**
+   * @brief Construct a health monitor
+   * @param period The number of checks between two samples
+   * @param thresholds The thresholds of the health issues
+   * @throw kalmanif::invalid_argument if period is zero
+   */
+  explicit HealthMonitor(
+    const std::size_t period = 1,
+    const HealthThresholds& thresholds = HealthThresholds()
+  ) : period_(period), thresholds_(thresholds) {
+    KALMANIF_CHECK(
+      period > 0,
+      "HealthMonitor: The sampling period must be positive!",
+      kalmanif::invalid_argument
+    );
+  }
+
+  /**
+   * @brief Set the callback raised when a threshold is crossed
+   */
+  void setCallback(Callback callback) {
+    callback_ = std::move(callback);
+  }
+
+  /**
+   * @brief Check the filter, sampling its health
+   * once every period calls.
+   *
+   * @return Whether the filter was sampled
+   */
+  template <typename Filter>
+  bool check(const Filter& filter) {
+    if (++calls_ < period_) {
+      return false;
+    }
+    calls_ = 0;
+    sample(filter);
+    return true;
+  }
+
+  /**
+   * @brief Sample the health of the filter now
+   */
+  template <typename Filter>
+  void sample(const Filter& filter) {
+    ++statistics_.samples;
+
+    statistics_.covariance_condition =
+      internal::conditionEstimate(filter.getCovarianceSquareRoot());
+    statistics_.max_covariance_condition = std::max(
+      statistics_.max_covariance_condition, statistics_.covariance_condition
+    );
+    raise(
+      HealthIssue::CovarianceConditioning,
+      statistics_.covariance_condition,
+      thresholds_.covariance_condition
+    );
+
+    if constexpr (internal::has_innovation_decomposition<Filter>::value) {
+      // nothing to sample before the first update
+      if (filter.getInnovation().size() > 0) {
+        statistics_.innovation_condition =
+          internal::conditionEstimate(filter.getInnovationDecomposition());
+        statistics_.max_innovation_condition = std::max(
+          statistics_.max_innovation_condition,
+          statistics_.innovation_condition
+        );
+        raise(
+          HealthIssue::InnovationConditioning,
+          statistics_.innovation_condition,
+          thresholds_.innovation_condition
+        );
+      }
+    }
+
+    if constexpr (internal::has_covariance_repair_count<Filter>::value) {
+      const std::size_t repairs = filter.getCovarianceRepairCount();
+      // the filter may have been reset in the meantime
+      const std::size_t new_repairs =
+        repairs >= last_repairs_ ? repairs - last_repairs_ : repairs;
+      last_repairs_ = repairs;
+      statistics_.repairs += new_repairs;
+      raise(
+        HealthIssue::CovarianceRepairs,
+        double(new_repairs),
+        double(thresholds_.repairs)
+      );
+    }
+  }
+
+  const HealthStatistics& getStatistics() const {
+    return statistics_;
+  }
+
+  const HealthThresholds& getThresholds() const {
+    return thresholds_;
+  }
+
+  /**
+   * @brief Reset the statistics and the raised issues
+   */
+  void reset() {
+    statistics_ = HealthStatistics();
+    raised_.fill(false);
+    calls_ = 0;
+  }
+
+protected:
+
+  void raise(const HealthIssue issue, const double value, const double threshold) {
+    bool& raised = raised_[static_cast<std::size_t>(issue)];
+
+    // a NaN is an issue too
+    if (!(value <= threshold)) {
+      if (!raised && callback_) {
+        callback_(HealthEvent{issue, value, threshold});
+      }
+      raised = true;
+    } else {
+      raised = false;
+    }
+  }
+
+  std::size_t period_;
+  HealthThresholds thresholds_;
+  Callback callback_;
+
+  std::size_t calls_ = 0;
+  std::size_t last_repairs_ = 0;
+  std::array<bool, 3> raised_{};
+  HealthStatistics statistics_;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_HEALTH_MONITOR_H_
@@ -0,0 +1,373 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_INFORMATION_KALMAN_FILTER_H_
+#define _KALMANIF_KALMANIF_IMPL_INFORMATION_KALMAN_FILTER_H_
+
+namespace kalmanif {
+
+// Forward declaration
+template <typename Derived> struct SystemModelBase;
+template <typename Filter, typename Storage> struct RauchTungStriebelSmoother;
+template <typename Filter, std::size_t Lag> struct FixedLagSmoother;
+template <typename Filter> struct FilterCheckpoint;
+
+/**
+ * @brief The InformationKalmanFilter
+ *
+ * An Extended Kalman Filter in information form.
+ * The update accumulates the information \f$ H^T R^{-1} H \f$
+ * of each measurement into the information matrix \f$ Y = P^{-1} \f$,
+ * so that updating with m measurements costs m small additive
+ * accumulations and a single solve in the state dimension,
+ * instead of a factorization in the stacked measurement dimension.
+ *
+ * The filter holds either form of the uncertainty and converts lazily:
+ * the propagation works on the covariance and the update
+ * on the information, the other form being materialized
+ * only when it is needed, e.g. on getCovariance().
+ *
+ * @tparam StateType The state type
+ */
+template <typename StateType>
+struct InformationKalmanFilter
+  : public internal::KalmanFilterBase<InformationKalmanFilter<StateType>>
+  , public internal::TransitionBase<StateType> {
+
+  using Base = internal::KalmanFilterBase<InformationKalmanFilter<StateType>>;
+
+  using typename Base::State;
+  using typename Base::Scalar;
+  using Base::setState;
+  using Base::getState;
+  using Base::setValidation;
+  using Base::getValidation;
+  using Base::getValidationPeriod;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(InformationKalmanFilter);
+
+  /**
+   * @brief Construct a new Information Kalman Filter object given
+   * an initial state and state covariance
+   *
+   * @param state_init The initial state
+   * @param cov_init The initial state covariance
+   */
+  InformationKalmanFilter(
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init
+  ) {
+    setState(state_init);
+    setCovariance(cov_init);
+  }
+
+  /**
+   * @brief The covariance and information matrices
+   * recorded by a filter snapshot, each if valid
+   */
+  struct CovarianceSnapshot {
+    Covariance<State> P, Y;
+    bool is_cov_valid = false;
+    bool is_info_valid = false;
+  };
+
+  /**
+   * @brief Get the covariance
+   *
+   * @note It is only materialized from the information
+   * if the latter changed since the last call.
+   */
+  const Covariance<State>& getCovariance() const {
+    if (!is_cov_valid_) {
+      P_ = invert(Y_, "IKF::getCovariance: Information is not invertible.");
+      is_cov_valid_ = true;
+    }
+    return P_;
+  }
+
+  /**
+   * @brief Set the covariance
+   * @param [in] covariance The input covariance
+   */
+  bool setCovariance(const Eigen::Ref<const Covariance<State>>& covariance) {
+    KALMANIF_ASSERT(
+      isCovariance(Covariance<State>(covariance)),
+      "IKF: Not a covariance matrix!"
+    );
+    P_ = covariance;
+    is_cov_valid_ = true;
+    is_info_valid_ = false;
+    return true;
+  }
+
+  /**
+   * @brief Get the information matrix \f$ Y = P^{-1} \f$
+   *
+   * @note It is only materialized from the covariance
+   * if the latter changed since the last call.
+   */
+  const Covariance<State>& getInformation() const {
+    if (!is_info_valid_) {
+      Y_ = invert(P_, "IKF::getInformation: Covariance is not invertible.");
+      is_info_valid_ = true;
+    }
+    return Y_;
+  }
+
+  /**
+   * @brief Set the information matrix \f$ Y = P^{-1} \f$
+   * @param [in] information The input information matrix
+   */
+  bool setInformation(const Eigen::Ref<const Covariance<State>>& information) {
+    KALMANIF_ASSERT(
+      isCovariance(Covariance<State>(information)),
+      "IKF: Not an information matrix!"
+    );
+    Y_ = information;
+    is_info_valid_ = true;
+    is_cov_valid_ = false;
+    return true;
+  }
+
+protected:
+
+  using Base::x;
+  using Base::validateCovariance;
+  using internal::TransitionBase<StateType>::recordTransition;
+
+  friend Base;
+  template <typename, typename> friend struct RauchTungStriebelSmoother;
+  template <typename, std::size_t> friend struct FixedLagSmoother;
+  template <typename> friend struct FilterCheckpoint;
+
+  using Tangent = typename State::Tangent;
+  using TangentVector = typename Tangent::DataType;
+
+  /**
+   * @brief Perform filter propagation step using the input control \f$u\f$
+   * and corresponding system model \f$f\f$
+   *
+   * @tparam SystemModelDerived The derived system model
+   * @tparam Args Variadic list of input arguments for the system model
+   * @param [in] f The linearized system model
+   * @param [in] u The input control
+   * @param [in] args input arguments for the system model
+   * @return The propagated state
+   */
+  template <class SystemModelDerived, typename... Args>
+  const State& propagate_impl(
+    const Linearized<SystemModelBase<SystemModelDerived>>& f,
+    const typename internal::traits<SystemModelDerived>::Control& u,
+    Args&&... args
+  ) {
+    using Control = typename internal::traits<SystemModelDerived>::Control;
+
+    // System model jacobian
+    Jacobian<State, State> F;
+
+    // System model noise jacobian
+    Jacobian<State, Control> W;
+
+    // propagate state
+    f.into(x, u, x, F, W, std::forward<Args>(args)...);
+
+    // propagate covariance
+    getCovariance();
+    P_ = internal::covarianceProduct(F, P_, W, f.getCovariance());
+    is_info_valid_ = false;
+
+    recordTransition(F.transpose());
+
+    validateCovariance(
+      P_,
+      "IKF::propagate: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform filter update step using measurement \f$z\f$
+   * and corresponding measurement model
+   *
+   * @tparam MeasurementModelDerived
+   * @param [in] h The linearized measurement model
+   * @param [in] y The measurement vector
+   * @return The updated state estimate
+   */
+  template <class MeasurementModelDerived>
+  const State& update_impl(
+    const Linearized<MeasurementModelBase<MeasurementModelDerived>>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y
+  ) {
+    TangentVector eta = TangentVector::Zero();
+
+    getInformation();
+    accumulate<MeasurementModelDerived>(h, y, eta);
+    correct(eta);
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform a single filter update step using a stack of
+   * measurements \f$z_i\f$ and corresponding measurement models
+   *
+   * The information of each measurement is accumulated in turn,
+   * nothing is stacked.
+   *
+   * @tparam Count The number of measurements or Eigen::Dynamic
+   * @param [in] h_it Iterator to the first linearized measurement model
+   * @param [in] y_it Iterator to the first measurement vector
+   * @param [in] count The number of measurements
+   * @return The updated state estimate
+   */
+  template <
+    int Count, class MeasurementModelIterator, class MeasurementIterator
+  >
+  const State& update_stacked_impl(
+    MeasurementModelIterator h_it,
+    MeasurementIterator y_it,
+    const int count
+  ) {
+    using MeasurementModelDerived =
+      typename std::iterator_traits<MeasurementModelIterator>::value_type;
+
+    TangentVector eta = TangentVector::Zero();
+
+    getInformation();
+    for (int i = 0; i < count; ++i, ++h_it, ++y_it) {
+      accumulate<MeasurementModelDerived>(*h_it, *y_it, eta);
+    }
+    correct(eta);
+
+    return getState();
+  }
+
+  /**
+   * @brief Accumulate the information of a measurement,
+   * all linearized at the current state.
+   *
+   * \f$ Y \mathrel{+}= H^T R^{-1} H \f$ and
+   * \f$ \eta \mathrel{+}= H^T R^{-1} (y - h(x)) \f$
+   *
+   * @param [in] h The linearized measurement model
+   * @param [in] y The measurement vector
+   * @param [in,out] eta The accumulated information vector
+   */
+  template <class MeasurementModelDerived>
+  void accumulate(
+    const Linearized<MeasurementModelBase<MeasurementModelDerived>>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    TangentVector& eta
+  ) {
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+
+    Jacobian<Measurement, State> H;
+    Jacobian<Measurement, Measurement> M;
+
+    // compute expectation
+    const Measurement z = y - h(x, H, M);
+
+    const Covariance<Measurement> MRMt = M * h.getCovariance() * M.transpose();
+
+    // R^-1.H
+    Jacobian<Measurement, State> RiH;
+    if constexpr (internal::has_diagonal_noise<MeasurementModelDerived>{}) {
+      KALMANIF_ASSERT(
+        MRMt.isDiagonal(),
+        "IKF::update: Measurement noise is not diagonal."
+      );
+      RiH = MRMt.diagonal().cwiseInverse().asDiagonal() * H;
+    } else {
+      const internal::StateLLT<State, Covariance<Measurement>> llt(MRMt);
+      KALMANIF_CHECK(
+        llt.info() == Eigen::Success,
+        "IKF::update: Measurement noise is not positive definite."
+      );
+      RiH = llt.solve(H);
+    }
+
+    Y_.noalias() += H.transpose() * RiH;
+    eta.noalias() += RiH.transpose() * z;
+  }
+
+  /**
+   * @brief Correct the state estimate given the accumulated information.
+   *
+   * \f$ x \leftarrow x \oplus Y^{-1} \eta \f$
+   *
+   * @param [in] eta The accumulated information vector
+   */
+  void correct(const TangentVector& eta) {
+    Y_ = Scalar(0.5) * (Y_ + Y_.transpose()).eval();
+    is_cov_valid_ = false;
+
+    const internal::StateLLT<State, Covariance<State>> llt(Y_);
+    KALMANIF_CHECK(
+      llt.info() == Eigen::Success,
+      "IKF::update: Updated matrix Y is not positive definite."
+    );
+
+    x += Tangent(llt.solve(eta));
+
+    validateCovariance(
+      Y_,
+      "IKF::update: Updated matrix Y is not an information matrix."
+    );
+  }
+
+  void snapshotCovariance(CovarianceSnapshot& snapshot) const {
+    snapshot.is_cov_valid = is_cov_valid_;
+    snapshot.is_info_valid = is_info_valid_;
+    if (is_cov_valid_) {
+      snapshot.P = P_;
+    }
+    if (is_info_valid_) {
+      snapshot.Y = Y_;
+    }
+  }
+
+  void rollbackCovariance(const CovarianceSnapshot& snapshot) {
+    is_cov_valid_ = snapshot.is_cov_valid;
+    is_info_valid_ = snapshot.is_info_valid;
+    if (is_cov_valid_) {
+      P_ = snapshot.P;
+    }
+    if (is_info_valid_) {
+      Y_ = snapshot.Y;
+    }
+  }
+
+  /**
+   * @brief Invert a symmetric positive definite matrix.
+   */
+  static Covariance<State> invert(const Covariance<State>& M, const char* msg) {
+    const internal::StateLLT<State, Covariance<State>> llt(M);
+    KALMANIF_CHECK(llt.info() == Eigen::Success, msg);
+    return llt.solve(Covariance<State>::Identity());
+  }
+
+  //! Covariance, valid if is_cov_valid_
+  mutable Covariance<State> P_ = Covariance<State>::Identity() * Scalar(1e3);
+  //! Information matrix, valid if is_info_valid_
+  mutable Covariance<State> Y_ = Covariance<State>::Identity() * Scalar(1e-3);
+
+  mutable bool is_cov_valid_ = true;
+  mutable bool is_info_valid_ = true;
+};
+
+namespace internal {
+
+/**
+ * @brief traits specialization for InformationKalmanFilter
+ */
+template <class StateType>
+struct traits<InformationKalmanFilter<StateType>> {
+  using State = StateType;
+};
+
+} // namespace internal
+} // kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_INFORMATION_KALMAN_FILTER_H_
@@ -0,0 +1,289 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_INNOVATION_SOLVER_H_
+#define _KALMANIF_KALMANIF_IMPL_INNOVATION_SOLVER_H_
+
+namespace kalmanif {
+
+/**
+ * @brief Enum for the decomposition used to solve
+ * for the innovation covariance
+ */
+enum class InnovationSolver : char {
+  LLT = 0,  // Cholesky, falling back to QR if it fails, see InnovationBase
+  LDLT,     // Robust Cholesky, positive or negative semidefinite
+  QR        // Column pivoting Householder QR, fallback for ill-conditioned
+};
+
+namespace internal {
+
+/**
+ * @brief The Eigen decomposition associated to an InnovationSolver
+ *
+ * @tparam Solver The innovation solver
+ * @tparam MatrixType The innovation covariance matrix type
+ */
+template <InnovationSolver Solver, typename MatrixType>
+struct innovation_decomposition;
+
+// An Eigen::LLT that may be set from a closed-form factor
+template <typename MatrixType>
+struct innovation_decomposition<InnovationSolver::LLT, MatrixType> {
+  using type = Cholesky<MatrixType>;
+};
+
+template <typename MatrixType>
+struct innovation_decomposition<InnovationSolver::LDLT, MatrixType> {
+  using type = Eigen::LDLT<MatrixType>;
+};
+
+template <typename MatrixType>
+struct innovation_decomposition<InnovationSolver::QR, MatrixType> {
+  using type = Eigen::ColPivHouseholderQR<MatrixType>;
+};
+
+//! No fallback decomposition, that of the LDLT and QR solvers
+struct NoInnovationFallback {};
+
+/**
+ * @brief Base class for filters exposing their last innovation
+ * and the decomposition of its covariance.
+ *
+ * @tparam StateType The state type
+ * @tparam Solver The innovation solver
+ *
+ * With the LLT solver, if the Cholesky decomposition of the innovation
+ * covariance fails, e.g. for an ill-conditioned covariance not
+ * numerically positive definite, the gain and NIS are solved with
+ * the column pivoting QR decomposition instead, see isInnovationFallback.
+ *
+ * @note Since the measurement type may change from one update
+ * to the next, both are stored as dynamic-size objects.
+ * They only allocate when the measurement size changes,
+ * unless bounded by KALMANIF_MAX_INNOVATION_SIZE (e.g. in real-time mode)
+ * in which case they never allocate.
+ */
+template <typename StateType, InnovationSolver Solver>
+struct InnovationBase {
+
+  using Scalar = typename internal::traits<StateType>::Scalar;
+
+  static constexpr int MaxInnovationSize = KALMANIF_MAX_INNOVATION_SIZE;
+
+  using Innovation = Eigen::Matrix<
+    Scalar, Eigen::Dynamic, 1, Eigen::ColMajor, MaxInnovationSize, 1
+  >;
+  using InnovationCovariance = Eigen::Matrix<
+    Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor,
+    MaxInnovationSize, MaxInnovationSize
+  >;
+  using InnovationDecomposition =
+    typename innovation_decomposition<Solver, InnovationCovariance>::type;
+  using InnovationFallback = std::conditional_t<
+    Solver == InnovationSolver::LLT,
+    typename innovation_decomposition<
+      InnovationSolver::QR, InnovationCovariance
+    >::type,
+    NoInnovationFallback
+  >;
+
+  /**
+   * @brief Get the innovation of the last update
+   */
+  const Innovation& getInnovation() const {
+    return z_;
+  }
+
+  /**
+   * @brief Get the decomposition of the innovation covariance
+   * of the last update
+   * @note Failed if the update fell back to QR, see isInnovationFallback.
+   */
+  const InnovationDecomposition& getInnovationDecomposition() const {
+    return S_;
+  }
+
+  /**
+   * @brief Whether the last update was solved with the QR fallback,
+   * the Cholesky decomposition of its innovation covariance having failed
+   */
+  bool isInnovationFallback() const {
+    return fallback_;
+  }
+
+  /**
+   * @brief Get the Normalized Innovation Squared (NIS)
+   * \f$ z^T S^{-1} z \f$ of the last update
+   */
+  Scalar getNormalizedInnovationSquared() const {
+    return nis_;
+  }
+
+  /**
+   * @brief Whether the measurement of the last gated update was accepted
+   * @see MahalanobisGate
+   */
+  bool isInnovationAccepted() const {
+    return accepted_;
+  }
+
+  /**
+   * @brief Get the weight of the measurement noise of the last update,
+   * below 1 if a robust update down-weighted the measurement
+   * @see RobustKernel
+   */
+  Scalar getInnovationWeight() const {
+    return weight_;
+  }
+
+protected:
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(InnovationBase);
+
+  /**
+   * @brief Store the innovation and decompose its covariance,
+   * in closed form for a small fixed-size innovation if the state
+   * has closed-form kernels (see has_closed_form_kernels).
+   *
+   * @param [in] z The innovation
+   * @param [in] S The innovation covariance
+   */
+  template <typename _DerivedZ, typename _DerivedS>
+  void setInnovation(
+    const Eigen::MatrixBase<_DerivedZ>& z,
+    const Eigen::MatrixBase<_DerivedS>& S
+  ) {
+    checkInnovationSize<_DerivedZ>();
+
+    z_ = z;
+    weight_ = Scalar(1);
+    fallback_ = false;
+
+    using FixedCovariance = Eigen::Matrix<
+      Scalar, _DerivedZ::RowsAtCompileTime, _DerivedZ::RowsAtCompileTime
+    >;
+
+    if constexpr (
+      Solver == InnovationSolver::LLT &&
+      use_closed_form<StateType, FixedCovariance>
+    ) {
+      const FixedCovariance S_fixed = S;
+      const ClosedFormLLT<FixedCovariance> llt(S_fixed);
+      if (llt.info() == Eigen::Success) {
+        S_.setDecomposition(
+          llt.matrixLLT(), S_fixed.cwiseAbs().colwise().sum().maxCoeff()
+        );
+        Sinv_z_ = llt.solve(z);
+        nis_ = z_.dot(Sinv_z_);
+        return;
+      }
+    }
+
+    S_.compute(S);
+
+    if constexpr (Solver == InnovationSolver::LLT) {
+      if (S_.info() != Eigen::Success) {
+        S_fallback_.compute(S);
+        fallback_ = true;
+      }
+    } else {
+      KALMANIF_ASSERT(
+        S_.info() == Eigen::Success,
+        "InnovationBase: Failed to decompose the innovation covariance."
+      );
+    }
+
+    // Solve into a member buffer, z^T.S^{-1}.z evaluated
+    // as a single expression would allocate a temporary
+    solveInnovation(z_, Sinv_z_);
+    nis_ = z_.dot(Sinv_z_);
+  }
+
+  /**
+   * @brief Store the innovation given the decomposition of its covariance,
+   * e.g. that of a previous update of the same covariance.
+   *
+   * @param [in] z The innovation
+   * @param [in] S The innovation covariance decomposition
+   */
+  template <typename _DerivedZ>
+  void setInnovation(
+    const Eigen::MatrixBase<_DerivedZ>& z,
+    const InnovationDecomposition& S
+  ) {
+    checkInnovationSize<_DerivedZ>();
+
+    z_ = z;
+    S_ = S;
+    fallback_ = false;
+    weight_ = Scalar(1);
+
+    Sinv_z_ = S_.solve(z_);
+    nis_ = z_.dot(Sinv_z_);
+  }
+
+  /**
+   * @brief Solve S.X = B for the innovation covariance S
+   * of the last update, with its QR fallback if any.
+   *
+   * @param [in] B The right-hand side
+   * @param [out] X The solution, e.g. the transposed gain
+   */
+  template <typename _DerivedB, typename _DerivedX>
+  void solveInnovation(
+    const Eigen::MatrixBase<_DerivedB>& B, _DerivedX&& X
+  ) const {
+    if constexpr (Solver == InnovationSolver::LLT) {
+      if (fallback_) {
+        X = S_fallback_.solve(B);
+        return;
+      }
+    }
+    X = S_.solve(B);
+  }
+
+  /**
+   * @brief Gate the stored innovation on its NIS,
+   * reusing the decomposition of its covariance.
+   *
+   * @param [in] threshold The NIS above which the innovation is rejected
+   * @return Whether the innovation is accepted
+   */
+  bool gateInnovation(const double threshold) {
+    accepted_ = !(getNormalizedInnovationSquared() > threshold);
+    return accepted_;
+  }
+
+  template <typename _DerivedZ>
+  static void checkInnovationSize() {
+    constexpr int Size = _DerivedZ::MaxRowsAtCompileTime;
+    static_assert(
+      MaxInnovationSize == Eigen::Dynamic ||
+      (Size != Eigen::Dynamic && Size <= MaxInnovationSize),
+      "InnovationBase: The innovation may exceed KALMANIF_MAX_INNOVATION_SIZE!"
+    );
+  }
+
+  //! Innovation
+  Innovation z_;
+
+  //! Innovation covariance decomposition
+  InnovationDecomposition S_;
+
+  //! Its QR fallback and whether the last update used it
+  InnovationFallback S_fallback_;
+  bool fallback_ = false;
+
+  //! The solution of S.x = z and the NIS z^T.S^{-1}.z
+  Innovation Sinv_z_;
+  Scalar nis_ = 0;
+
+  //! Whether the last gated innovation was accepted
+  bool accepted_ = true;
+
+  //! The weight of the measurement noise of the last robust update
+  Scalar weight_ = Scalar(1);
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_INNOVATION_SOLVER_H_
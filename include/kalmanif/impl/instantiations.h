@@ -0,0 +1,160 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_INSTANTIATIONS_H_
+#define _KALMANIF_KALMANIF_IMPL_INSTANTIATIONS_H_
+
+// The common instantiations of the filters, compiled once in the
+// kalmanif_instantiations library (cmake -DBUILD_INSTANTIATIONS=ON).
+//
+// Linking it defines KALMANIF_EXTERN_TEMPLATES, so that each filter header
+// declares its instantiations extern and the translation units including it
+// do not instantiate them again. That is, for the SE2, SE3 and SE_2_3 states
+// in single and double precision,
+// - the filter class and its base,
+// - the propagation with the LieSystemModel,
+// - the updates with the landmark and gps measurement models,
+// - the propagation with the SimpleImuSystemModel and a time step (SE_2_3).
+//
+// The library is compiled in the default configuration, the extern
+// declarations are thus disabled by any macro changing the filters,
+// KALMANIF_REALTIME, KALMANIF_MIXED_PRECISION, or
+// KALMANIF_INSTRUMENTATION, KALMANIF_MAX_INNOVATION_SIZE and
+// KALMANIF_MAX_STACKED_MEASUREMENTS defined before including kalmanif.
+
+#if defined(KALMANIF_EXTERN_TEMPLATES) && \
+    !defined(KALMANIF_REALTIME) && !defined(KALMANIF_MIXED_PRECISION) && \
+    defined(KALMANIF_DEFAULT_INSTRUMENTATION) && \
+    defined(KALMANIF_DEFAULT_MAX_INNOVATION_SIZE) && \
+    defined(KALMANIF_DEFAULT_MAX_STACKED_MEASUREMENTS)
+# define KALMANIF_HAS_EXTERN_TEMPLATES 1
+#else
+# define KALMANIF_HAS_EXTERN_TEMPLATES 0
+#endif
+
+#if KALMANIF_HAS_EXTERN_TEMPLATES || defined(KALMANIF_INSTANTIATING)
+
+#include "kalmanif/enable_manif.h"
+
+#include "kalmanif/measurement_models/landmark_measurement_model.h"
+#include "kalmanif/measurement_models/dummy_gps_measurement_model.h"
+#include "kalmanif/system_models/simple_imu_system_model.h"
+
+#include <manif/SE2.h>
+#include <manif/SE3.h>
+#include <manif/SE_2_3.h>
+
+// Apply MACRO(EXTERN, Filter, State, LandmarkDim) to each instantiated state
+#define KALMANIF_FOR_EACH_INSTANTIATED_STATE(MACRO, EXTERN, Filter) \
+  MACRO(EXTERN, Filter, manif::SE2d, 2)                             \
+  MACRO(EXTERN, Filter, manif::SE2f, 2)                             \
+  MACRO(EXTERN, Filter, manif::SE3d, 3)                             \
+  MACRO(EXTERN, Filter, manif::SE3f, 3)                             \
+  MACRO(EXTERN, Filter, manif::SE_2_3d, 3)                          \
+  MACRO(EXTERN, Filter, manif::SE_2_3f, 3)
+
+// The propagation of Filter<State> with Model
+#define KALMANIF_INSTANTIATE_PROPAGATE(EXTERN, Filter, State, Model)   \
+  EXTERN template const State&                                         \
+  kalmanif::internal::KalmanFilterBase<Filter<State>>::propagate<      \
+    Model                                                              \
+  >(                                                                   \
+    const kalmanif::SystemModelBase<Model>&,                           \
+    const typename kalmanif::internal::traits<Model>::Control&         \
+  );
+
+// The propagation of Filter<State> with Model and a time step
+// forwarded as Arg, i.e. passed as Param
+#define KALMANIF_INSTANTIATE_PROPAGATE_DT(                             \
+  EXTERN, Filter, State, Model, Arg, Param                             \
+)                                                                      \
+  EXTERN template const State&                                         \
+  kalmanif::internal::KalmanFilterBase<Filter<State>>::propagate<      \
+    Model, Arg                                                         \
+  >(                                                                   \
+    const kalmanif::SystemModelBase<Model>&,                           \
+    const typename kalmanif::internal::traits<Model>::Control&,        \
+    Param                                                              \
+  );
+
+// The propagations with a time step, a const lvalue, an lvalue or an rvalue
+#define KALMANIF_INSTANTIATE_PROPAGATE_TIME_STEP(                      \
+  EXTERN, Filter, State, Model                                         \
+)                                                                      \
+  KALMANIF_INSTANTIATE_PROPAGATE_DT(                                   \
+    EXTERN, Filter, State, Model,                                      \
+    const typename State::Scalar&, const typename State::Scalar&       \
+  )                                                                    \
+  KALMANIF_INSTANTIATE_PROPAGATE_DT(                                   \
+    EXTERN, Filter, State, Model,                                      \
+    typename State::Scalar&, typename State::Scalar&                   \
+  )                                                                    \
+  KALMANIF_INSTANTIATE_PROPAGATE_DT(                                   \
+    EXTERN, Filter, State, Model,                                      \
+    typename State::Scalar, typename State::Scalar&&                   \
+  )
+
+// The update of Filter<State> with Model
+#define KALMANIF_INSTANTIATE_UPDATE(EXTERN, Filter, State, Model)      \
+  EXTERN template const State&                                         \
+  kalmanif::internal::KalmanFilterBase<Filter<State>>::update<Model>(  \
+    const kalmanif::MeasurementModelBase<Model>&,                      \
+    const typename kalmanif::internal::traits<Model>::Measurement&     \
+  );
+
+#define KALMANIF_LANDMARK_MODEL(State, LandmarkDim) \
+  kalmanif::LandmarkMeasurementModel<State, LandmarkDim>
+
+// A filter on a state, with the LieSystemModel and
+// the landmark and gps measurement models
+#define KALMANIF_INSTANTIATE_FILTER_STATE(                                \
+  EXTERN, Filter, State, LandmarkDim                                      \
+)                                                                         \
+  EXTERN template struct kalmanif::internal::KalmanFilterBase<            \
+    Filter<State>                                                         \
+  >;                                                                      \
+  EXTERN template struct Filter<State>;                                   \
+  KALMANIF_INSTANTIATE_PROPAGATE(                                         \
+    EXTERN, Filter, State, kalmanif::LieSystemModel<State>                \
+  )                                                                       \
+  KALMANIF_INSTANTIATE_UPDATE(                                            \
+    EXTERN, Filter, State, KALMANIF_LANDMARK_MODEL(State, LandmarkDim)    \
+  )                                                                       \
+  KALMANIF_INSTANTIATE_UPDATE(                                            \
+    EXTERN, Filter, State, kalmanif::DummyGPSMeasurementModel<State>      \
+  )
+
+// The LieSystemModel propagations with a time step, of the invariant filter
+#define KALMANIF_INSTANTIATE_LIE_TIME_STEP(                               \
+  EXTERN, Filter, State, LandmarkDim                                      \
+)                                                                         \
+  KALMANIF_INSTANTIATE_PROPAGATE_TIME_STEP(                               \
+    EXTERN, Filter, State, kalmanif::LieSystemModel<State>                \
+  )
+
+/**
+ * @brief The instantiations of a filter, e.g.
+ * KALMANIF_INSTANTIATE_FILTER(extern, kalmanif::ExtendedKalmanFilter)
+ * to declare them, or with an empty EXTERN to define them.
+ */
+#define KALMANIF_INSTANTIATE_FILTER(EXTERN, Filter)                       \
+  KALMANIF_FOR_EACH_INSTANTIATED_STATE(                                   \
+    KALMANIF_INSTANTIATE_FILTER_STATE, EXTERN, Filter                     \
+  )                                                                       \
+  KALMANIF_INSTANTIATE_PROPAGATE_TIME_STEP(                               \
+    EXTERN, Filter, manif::SE_2_3d, kalmanif::SimpleImuSystemModel<double> \
+  )                                                                       \
+  KALMANIF_INSTANTIATE_PROPAGATE_TIME_STEP(                               \
+    EXTERN, Filter, manif::SE_2_3f, kalmanif::SimpleImuSystemModel<float> \
+  )
+
+/**
+ * @brief The instantiations of an invariant filter,
+ * also propagated with the LieSystemModel and a time step.
+ */
+#define KALMANIF_INSTANTIATE_INVARIANT_FILTER(EXTERN, Filter)             \
+  KALMANIF_INSTANTIATE_FILTER(EXTERN, Filter)                             \
+  KALMANIF_FOR_EACH_INSTANTIATED_STATE(                                   \
+    KALMANIF_INSTANTIATE_LIE_TIME_STEP, EXTERN, Filter                    \
+  )
+
+#endif // KALMANIF_HAS_EXTERN_TEMPLATES || KALMANIF_INSTANTIATING
+
+#endif // _KALMANIF_KALMANIF_IMPL_INSTANTIATIONS_H_
@@ -0,0 +1,377 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_INSTRUMENTATION_H_
+#define _KALMANIF_KALMANIF_IMPL_INSTRUMENTATION_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace kalmanif {
+
+/**
+ * @brief Enum for the instrumented stages of a filter step
+ */
+enum class Stage : char {
+  Propagation = 0, // A whole propagation step
+  Update,          // A whole update step
+  Model,           // Model evaluation and jacobians
+  Gain,            // Innovation covariance decomposition and gain solve
+  Covariance,      // Covariance propagation or update
+  Repair           // Covariance repair
+};
+
+//! The number of instrumented stages
+constexpr std::size_t NumStages = 6;
+
+/**
+ * @brief Get the name of a stage
+ */
+inline const char* toString(const Stage stage) {
+  switch (stage) {
+    case Stage::Propagation: return "propagation";
+    case Stage::Update:      return "update";
+    case Stage::Model:       return "model";
+    case Stage::Gain:        return "gain";
+    case Stage::Covariance:  return "covariance";
+    case Stage::Repair:      return "repair";
+  }
+  return "unknown";
+}
+
+/**
+ * @brief The default instrumentation, does nothing.
+ *
+ * An instrumentation is any default constructible type providing
+ * 'void begin(Stage)' and 'void end(Stage)', called by the filters
+ * at each stage boundary. Stages may nest, e.g. a Gain stage
+ * within an Update stage.
+ */
+struct NoInstrumentation {
+  void begin(const Stage) const noexcept {}
+  void end(const Stage) const noexcept {}
+};
+
+/**
+ * @brief An instrumentation calling user hooks at each stage boundary.
+ */
+struct HookInstrumentation {
+
+  using Hook = std::function<void(Stage)>;
+
+  /**
+   * @brief Set the hooks called when a stage begins and ends
+   * @param on_begin The hook called when a stage begins
+   * @param on_end The hook called when a stage ends
+   */
+  void setHooks(Hook on_begin, Hook on_end) {
+    on_begin_ = std::move(on_begin);
+    on_end_ = std::move(on_end);
+  }
+
+  void begin(const Stage stage) const {
+    if (on_begin_) on_begin_(stage);
+  }
+
+  void end(const Stage stage) const {
+    if (on_end_) on_end_(stage);
+  }
+
+protected:
+
+  Hook on_begin_, on_end_;
+};
+
+/**
+ * @brief The latency statistics of a stage
+ *
+ * The histogram bin i counts the durations d
+ * with 2^i <= d < 2^(i+1) nanoseconds.
+ */
+struct StageStatistics {
+
+  static constexpr std::size_t NumBins = 32;
+
+  std::uint64_t count = 0;
+  std::uint64_t total_ns = 0;
+  std::uint64_t max_ns = 0;
+  std::array<std::uint64_t, NumBins> histogram{};
+};
+
+//! The latency statistics of all stages, indexed by Stage
+using StagesStatistics = std::array<StageStatistics, NumStages>;
+
+namespace internal {
+
+/**
+ * @brief The latency counters of a thread.
+ *
+ * They are only written by their thread, with relaxed atomics
+ * so that they can be read concurrently without lock.
+ */
+struct ThreadStageCounters {
+
+  struct Counters {
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> total_ns{0};
+    std::atomic<std::uint64_t> max_ns{0};
+    std::array<std::atomic<std::uint64_t>, StageStatistics::NumBins> histogram{};
+  };
+
+  static void increment(std::atomic<std::uint64_t>& c, const std::uint64_t n) {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  void record(const Stage stage, const std::uint64_t ns) {
+    Counters& c = stages[static_cast<std::size_t>(stage)];
+
+    // floor(log2(ns)), clamped to the last bin
+    std::size_t bin = 0;
+    for (std::uint64_t d = ns >> 1; d != 0; d >>= 1) ++bin;
+    bin = std::min(bin, StageStatistics::NumBins - 1);
+
+    increment(c.count, 1);
+    increment(c.total_ns, ns);
+    increment(c.histogram[bin], 1);
+    if (ns > c.max_ns.load(std::memory_order_relaxed)) {
+      c.max_ns.store(ns, std::memory_order_relaxed);
+    }
+  }
+
+  std::array<Counters, NumStages> stages;
+};
+
+/**
+ * @brief The registry of the threads counters.
+ *
+ * The lock is only taken when a thread records its first duration
+ * and when the statistics are collected or reset.
+ * The counters of a thread outlive it.
+ */
+struct StageCountersRegistry {
+
+  static StageCountersRegistry& instance() {
+    static StageCountersRegistry registry;
+    return registry;
+  }
+
+  static ThreadStageCounters& local() {
+    thread_local ThreadStageCounters& counters = instance().add();
+    return counters;
+  }
+
+  ThreadStageCounters& add() {
+    std::lock_guard<std::mutex> lock(mutex);
+    threads.push_back(std::make_unique<ThreadStageCounters>());
+    return *threads.back();
+  }
+
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadStageCounters>> threads;
+};
+
+} // namespace internal
+
+/**
+ * @brief An instrumentation recording the stages latency
+ * in lock-free per-thread counters and histograms.
+ *
+ * The statistics of all threads are collected with
+ * collectStageStatistics and can be exported with writeJson.
+ */
+struct TimingInstrumentation {
+
+  using Clock = std::chrono::steady_clock;
+
+  void begin(const Stage stage) {
+    start_[static_cast<std::size_t>(stage)] = Clock::now();
+  }
+
+  void end(const Stage stage) {
+    const auto d = Clock::now() - start_[static_cast<std::size_t>(stage)];
+    internal::StageCountersRegistry::local().record(
+      stage,
+      std::uint64_t(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()
+      )
+    );
+  }
+
+protected:
+
+  std::array<Clock::time_point, NumStages> start_;
+};
+
+/**
+ * @brief Collect the stages latency statistics of all threads
+ * recorded by TimingInstrumentation.
+ */
+inline StagesStatistics collectStageStatistics() {
+  auto& registry = internal::StageCountersRegistry::instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  StagesStatistics statistics;
+  for (const auto& thread : registry.threads) {
+    for (std::size_t s = 0; s < NumStages; ++s) {
+      const auto& c = thread->stages[s];
+      auto& stats = statistics[s];
+      stats.count += c.count.load(std::memory_order_relaxed);
+      stats.total_ns += c.total_ns.load(std::memory_order_relaxed);
+      stats.max_ns = std::max<std::uint64_t>(
+        stats.max_ns, c.max_ns.load(std::memory_order_relaxed)
+      );
+      for (std::size_t b = 0; b < StageStatistics::NumBins; ++b) {
+        stats.histogram[b] += c.histogram[b].load(std::memory_order_relaxed);
+      }
+    }
+  }
+  return statistics;
+}
+
+/**
+ * @brief Reset the stages latency statistics of all threads.
+ *
+ * @note Durations recorded concurrently may be partially reset.
+ */
+inline void resetStageStatistics() {
+  auto& registry = internal::StageCountersRegistry::instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  for (const auto& thread : registry.threads) {
+    for (auto& c : thread->stages) {
+      c.count.store(0, std::memory_order_relaxed);
+      c.total_ns.store(0, std::memory_order_relaxed);
+      c.max_ns.store(0, std::memory_order_relaxed);
+      for (auto& b : c.histogram) b.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * @brief Write the stages latency statistics as json,
+ * e.g. {"update": {"count": 10, "total_ns": ..., "histogram": [...]}, ...}
+ *
+ * @param os The output stream
+ * @param statistics The statistics to write
+ * @return The output stream
+ */
+inline std::ostream& writeJson(
+  std::ostream& os, const StagesStatistics& statistics
+) {
+  os << "{";
+  for (std::size_t s = 0; s < NumStages; ++s) {
+    const auto& stats = statistics[s];
+    os << (s ? ", " : "") << "\"" << toString(static_cast<Stage>(s)) << "\": {"
+       << "\"count\": " << stats.count << ", "
+       << "\"total_ns\": " << stats.total_ns << ", "
+       << "\"max_ns\": " << stats.max_ns << ", "
+       << "\"histogram\": [";
+    for (std::size_t b = 0; b < StageStatistics::NumBins; ++b) {
+      os << (b ? ", " : "") << stats.histogram[b];
+    }
+    os << "]}";
+  }
+  return os << "}";
+}
+
+// The instrumentation of the filters.
+// It can be set by defining KALMANIF_INSTRUMENTATION to
+// e.g. kalmanif::TimingInstrumentation before including kalmanif headers.
+// It defaults to kalmanif::NoInstrumentation, which compiles to nothing.
+#ifndef KALMANIF_INSTRUMENTATION
+# define KALMANIF_INSTRUMENTATION kalmanif::NoInstrumentation
+// Defaulted, see kalmanif/impl/instantiations.h
+# define KALMANIF_DEFAULT_INSTRUMENTATION
+#endif
+
+namespace internal {
+
+/**
+ * @brief Scoped stage, begins on construction and ends on destruction.
+ */
+template <typename Instrumentation>
+struct StageScope {
+
+  StageScope(Instrumentation& instrumentation, const Stage stage)
+    : instrumentation_(instrumentation), stage_(stage) {
+    instrumentation_.begin(stage_);
+  }
+
+  ~StageScope() {
+    instrumentation_.end(stage_);
+  }
+
+  StageScope(const StageScope&) = delete;
+  StageScope& operator=(const StageScope&) = delete;
+
+protected:
+
+  Instrumentation& instrumentation_;
+  const Stage stage_;
+};
+
+template <>
+struct StageScope<NoInstrumentation> {
+  // user-provided to silence unused variable warnings
+  ~StageScope() {}
+};
+
+/**
+ * @brief Base class for instrumented filters.
+ */
+template <typename Instrumentation>
+struct InstrumentationBase {
+
+  /**
+   * @brief Get the instrumentation, e.g. to set its hooks
+   */
+  Instrumentation& getInstrumentation() {
+    return instrumentation_;
+  }
+
+  const Instrumentation& getInstrumentation() const {
+    return instrumentation_;
+  }
+
+protected:
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(InstrumentationBase);
+
+  /**
+   * @brief Instrument a stage until the end of the enclosing scope
+   */
+  StageScope<Instrumentation> instrument(const Stage stage) {
+    return StageScope<Instrumentation>(instrumentation_, stage);
+  }
+
+  Instrumentation instrumentation_;
+};
+
+/**
+ * @brief Base class for non-instrumented filters, takes no space.
+ */
+template <>
+struct InstrumentationBase<NoInstrumentation> {
+
+  NoInstrumentation getInstrumentation() const {
+    return {};
+  }
+
+protected:
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(InstrumentationBase);
+
+  StageScope<NoInstrumentation> instrument(const Stage) const {
+    return {};
+  }
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_INSTRUMENTATION_H_
@@ -0,0 +1,401 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_INTERACTING_MULTIPLE_MODEL_H_
+#define _KALMANIF_KALMANIF_IMPL_INTERACTING_MULTIPLE_MODEL_H_
+
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief The log-determinant of a matrix from its Cholesky decomposition.
+ */
+template <typename _MatrixType, int _UpLo>
+double logDeterminant(const Eigen::LLT<_MatrixType, _UpLo>& llt) {
+  return 2. * double(llt.matrixLLT().diagonal().array().log().sum());
+}
+
+/**
+ * @brief The log-determinant of a matrix from its LDLT decomposition.
+ */
+template <typename _MatrixType, int _UpLo>
+double logDeterminant(const Eigen::LDLT<_MatrixType, _UpLo>& ldlt) {
+  return double(ldlt.vectorD().array().abs().log().sum());
+}
+
+/**
+ * @brief The log-determinant of a matrix from its
+ * column pivoting QR decomposition.
+ */
+template <typename _MatrixType>
+double logDeterminant(const Eigen::ColPivHouseholderQR<_MatrixType>& qr) {
+  return double(qr.logAbsDeterminant());
+}
+
+} // namespace internal
+
+/**
+ * @brief The Interacting Multiple Model (IMM) estimator.
+ *
+ * A bank of filters, one per motion regime (mode), each propagated
+ * with its own system model. At each propagation, the mode-conditioned
+ * estimates are first mixed according to the mode transition
+ * probabilities, and the mode probabilities are updated
+ * with the likelihood of each measurement.
+ *
+ * The estimates are mixed (and combined) on the manifold by moment
+ * matching at a common tangent reference, the estimate of the
+ * most likely contributing mode. The covariances are transported to
+ * and from the reference tangent space with the Lie group jacobians,
+ * in the error convention of the filter (left for right-invariant
+ * filters, right otherwise).
+ *
+ * The system models are a compile-time list, so that each mode
+ * is propagated without virtual dispatch. The mode filters
+ * run concurrently on the executor, sequentially by default.
+ *
+ * @code
+ * InteractingMultipleModel<EKF, LieSystemModel<SE2d>, LieSystemModel<SE2d>>
+ *   imm(X0, P0, Pi, cruising, turning);
+ * imm.propagate(u);
+ * imm.update(h, y);
+ * imm.getModeProbabilities();
+ * @endcode
+ *
+ * @note Based on,
+ * "Estimation with Applications to Tracking and Navigation",
+ * Y. Bar-Shalom et al., 11.6.6
+ *
+ * @tparam Filter The mode filter type, providing the innovation
+ * of its updates, e.g. ExtendedKalmanFilter or InvariantExtendedKalmanFilter.
+ * @tparam Models The system model types, one per mode,
+ * all with the same control type.
+ */
+template <typename Filter, typename... Models>
+struct InteractingMultipleModel {
+
+  using State = typename Filter::State;
+  using Scalar = typename internal::traits<State>::Scalar;
+  using Tangent = typename State::Tangent;
+
+  //! The number of modes
+  static constexpr int Modes = int(sizeof...(Models));
+
+  using ModeVector = Eigen::Matrix<Scalar, Modes, 1>;
+  using TransitionMatrix = Eigen::Matrix<Scalar, Modes, Modes>;
+
+  using Control = typename internal::traits<
+    std::tuple_element_t<0, std::tuple<Models...>>
+  >::Control;
+
+  static_assert(Modes > 0, "IMM: At least one mode is required!");
+
+  static_assert(
+    (std::is_same<typename internal::traits<Models>::Control, Control>::value && ...),
+    "IMM: The system models must share the same control type!"
+  );
+
+  static_assert(
+    internal::has_innovation_decomposition<Filter>::value,
+    "IMM: The filter must provide the innovation of its updates!"
+  );
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  /**
+   * @brief Construct an IMM estimator
+   * @param state_init The initial state of all modes
+   * @param cov_init The initial state covariance of all modes
+   * @param transition The mode transition probabilities,
+   * transition(i, j) being the probability to switch from mode i to j
+   * @param models The system models, one per mode
+   * @throw kalmanif::invalid_argument if transition is not row stochastic
+   */
+  InteractingMultipleModel(
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const TransitionMatrix& transition,
+    const Models&... models
+  ) : filters_(Modes, Filter(state_init, cov_init))
+    , models_(models...)
+    , mu_(ModeVector::Constant(Scalar(1) / Scalar(Modes)))
+    , x_(state_init), P_(cov_init)
+    , mixed_x_(Modes, state_init), mixed_P_(Modes, cov_init)
+    , executor_(1) {
+    setTransitionMatrix(transition);
+  }
+
+  /**
+   * @brief Set the executor running the mode filters
+   */
+  void setExecutor(const ThreadPoolExecutor& executor) {
+    executor_ = executor;
+  }
+
+  /**
+   * @brief Set the mode transition probabilities
+   * @throw kalmanif::invalid_argument if transition is not row stochastic
+   */
+  void setTransitionMatrix(const TransitionMatrix& transition) {
+    KALMANIF_CHECK(
+      (transition.array() >= Scalar(0)).all() &&
+      ((transition.rowwise().sum().array() - Scalar(1)).abs() <
+        Scalar(1e-6)).all(),
+      "IMM: The transition matrix must be row stochastic!",
+      kalmanif::invalid_argument
+    );
+    Pi_ = transition;
+  }
+
+  const TransitionMatrix& getTransitionMatrix() const {
+    return Pi_;
+  }
+
+  /**
+   * @brief Set the mode probabilities
+   * @throw kalmanif::invalid_argument if mu is not a probability vector
+   */
+  void setModeProbabilities(const ModeVector& mu) {
+    KALMANIF_CHECK(
+      (mu.array() >= Scalar(0)).all() &&
+      std::abs(mu.sum() - Scalar(1)) < Scalar(1e-6),
+      "IMM: The mode probabilities must sum to one!",
+      kalmanif::invalid_argument
+    );
+    mu_ = mu;
+    combine();
+  }
+
+  const ModeVector& getModeProbabilities() const {
+    return mu_;
+  }
+
+  /**
+   * @brief Perform the mixing and the propagation of each mode
+   *
+   * @param [in] u The input control
+   * @param [in] args input arguments for the system models
+   * @return The combined state estimate
+   */
+  template <typename... Args>
+  const State& propagate(const Control& u, const Args&... args) {
+    mix();
+
+    executor_(Modes, [&](const int j){
+      Filter& filter = filters_[j];
+      filter.setState(mixed_x_[j]);
+      filter.setCovariance(mixed_P_[j]);
+      visit(j, [&](const auto& f){
+        filter.propagate(f, u, args...);
+      }, std::index_sequence_for<Models...>());
+    });
+
+    combine();
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform the update of each mode and update
+   * the mode probabilities with the measurement likelihoods.
+   *
+   * @param [in] h The measurement model
+   * @param [in] y The measurement vector
+   * @param [in] args input arguments for the measurement model
+   * @return The combined state estimate
+   */
+  template <class MeasurementModelDerived, typename... Args>
+  const State& update(
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    const Args&... args
+  ) {
+    static_assert(
+      !internal::has_diagonal_noise<MeasurementModelDerived>::value,
+      "IMM: The sequential updates do not provide their innovation!"
+    );
+
+    const MeasurementModelDerived& model =
+      static_cast<const MeasurementModelDerived&>(h);
+
+    // the model cache is filled before the concurrent updates
+    model.getCovarianceSquareRoot();
+
+    ModeVector log_likelihood;
+    executor_(Modes, [&](const int j){
+      Filter& filter = filters_[j];
+      filter.update(model, y, args...);
+      const auto m = filter.getInnovation().size();
+      log_likelihood(j) = Scalar(-0.5) * Scalar(
+        filter.getNormalizedInnovationSquared() +
+        internal::logDeterminant(filter.getInnovationDecomposition()) +
+        double(m) * std::log(2. * EIGEN_PI)
+      );
+    });
+
+    // mu_j = L_j.mu_j / sum_i(L_i.mu_i), in log space
+    const Scalar max = log_likelihood.maxCoeff();
+    const ModeVector mu = mu_.cwiseProduct(
+      (log_likelihood.array() - max).exp().matrix()
+    );
+
+    const Scalar sum = mu.sum();
+    if (sum > Scalar(0) && std::isfinite(sum)) {
+      mu_ = mu / sum;
+    }
+
+    combine();
+
+    return getState();
+  }
+
+  /**
+   * @brief Get the combined state estimate
+   */
+  const State& getState() const {
+    return x_;
+  }
+
+  /**
+   * @brief Get the combined state covariance, including
+   * the spread of the mode estimates
+   */
+  const Covariance<State>& getCovariance() const {
+    return P_;
+  }
+
+  /**
+   * @brief Get the filter of the j-th mode
+   */
+  const Filter& getFilter(const int j) const {
+    return filters_[j];
+  }
+
+  /**
+   * @brief Get the system model of the I-th mode
+   */
+  template <std::size_t I>
+  const std::tuple_element_t<I, std::tuple<Models...>>& getModel() const {
+    return std::get<I>(models_);
+  }
+
+protected:
+
+  template <typename T>
+  using vector_t = std::vector<T, Eigen::aligned_allocator<T>>;
+
+  template <typename Function, std::size_t... Is>
+  void visit(const int j, Function&& function, std::index_sequence<Is...>) const {
+    ((j == int(Is) ? void(function(std::get<Is>(models_))) : void()), ...);
+  }
+
+  /**
+   * @brief The tangent of x at the reference and its jacobian,
+   * in the filter error convention.
+   */
+  static Tangent minus(
+    const State& x, const State& ref, Jacobian<State, State>& J
+  ) {
+    if constexpr (internal::is_right_invariant<Filter>::value) {
+      const Tangent d = x.lminus(ref);
+      J = d.ljacinv();
+      return d;
+    } else {
+      const Tangent d = x.rminus(ref);
+      J = d.rjacinv();
+      return d;
+    }
+  }
+
+  /**
+   * @brief The reference moved by d and the jacobian,
+   * in the filter error convention.
+   */
+  static State plus(
+    const State& ref, const Tangent& d, Jacobian<State, State>& J
+  ) {
+    if constexpr (internal::is_right_invariant<Filter>::value) {
+      J = d.ljac();
+      return ref.lplus(d);
+    } else {
+      J = d.rjac();
+      return ref.rplus(d);
+    }
+  }
+
+  /**
+   * @brief Moment-match the weighted mode estimates
+   * at the tangent of the most weighted one.
+   *
+   * @param [in] w The weights of the modes, summing to one
+   * @param [out] x The matched state
+   * @param [out] P The matched covariance
+   */
+  void match(const ModeVector& w, State& x, Covariance<State>& P) const {
+    Eigen::Index r;
+    w.maxCoeff(&r);
+    const State& ref = filters_[r].getState();
+
+    Jacobian<State, State> J;
+    Tangent d[Modes];
+    Covariance<State> P_ref = Covariance<State>::Zero();
+
+    Tangent d_mean = Tangent::Zero();
+    for (int i = 0; i < Modes; ++i) {
+      d[i] = minus(filters_[i].getState(), ref, J);
+      d_mean += Tangent(w(i) * d[i].coeffs());
+      P_ref.noalias() += w(i) * J * filters_[i].getCovariance() * J.transpose();
+    }
+
+    for (int i = 0; i < Modes; ++i) {
+      const typename Tangent::DataType e = (d[i] - d_mean).coeffs();
+      P_ref.noalias() += w(i) * e * e.transpose();
+    }
+
+    x = plus(ref, d_mean, J);
+    P.noalias() = J * P_ref * J.transpose();
+  }
+
+  //! Mix the mode estimates before the propagation
+  void mix() {
+    // the predicted mode probabilities
+    const ModeVector c = Pi_.transpose() * mu_;
+
+    for (int j = 0; j < Modes; ++j) {
+      // mu_{i|j} = Pi_ij.mu_i / c_j
+      ModeVector w = Pi_.col(j).cwiseProduct(mu_);
+      w = c(j) > Scalar(0) ? ModeVector(w / c(j)) : mu_;
+      match(w, mixed_x_[j], mixed_P_[j]);
+    }
+
+    mu_ = c;
+  }
+
+  //! Combine the mode estimates into the output estimate
+  void combine() {
+    match(mu_, x_, P_);
+  }
+
+  vector_t<Filter> filters_;
+  std::tuple<Models...> models_;
+
+  TransitionMatrix Pi_;
+  ModeVector mu_;
+
+  //! The combined estimate
+  State x_;
+  Covariance<State> P_;
+
+  //! The mixed estimates of the modes
+  vector_t<State> mixed_x_;
+  vector_t<Covariance<State>> mixed_P_;
+
+  ThreadPoolExecutor executor_;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_INTERACTING_MULTIPLE_MODEL_H_
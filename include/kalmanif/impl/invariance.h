@@ -11,6 +11,26 @@ enum class Invariance : bool {
   Left
 };
 
+namespace internal {
+
+/**
+ * @brief The adjoint mapping the invariant errors of the invariance
+ * 'From' to those of the invariance 'To' about the state x,
+ * \f$ \xi_L = Ad_{x^{-1}} \xi_R \f$ and \f$ \xi_R = Ad_x \xi_L \f$,
+ * e.g. to map a covariance of the one to the other.
+ */
+template <Invariance From, Invariance To, typename State>
+auto invarianceAdjoint(const State& x) {
+  static_assert(From != To, "invarianceAdjoint: Same invariance!");
+  if constexpr (From == Invariance::Right) {
+    return x.inverse().adj();
+  } else {
+    return x.adj();
+  }
+}
+
+} // namespace internal
+
 } // namespace kalmanif
 
 #endif // _KALMANIF_KALMANIF_IMPL_INVARIANCE_H_
\ No newline at end of file
@@ -5,30 +5,73 @@ namespace kalmanif {
 
 // Forward declaration
 template <typename Derived> struct SystemModelBase;
-template <typename Filter> struct RauchTungStriebelSmoother;
-
-template <typename StateType, Invariance Iv = Invariance::Right>
+template <typename Filter, typename Storage> struct RauchTungStriebelSmoother;
+template <typename Filter, std::size_t Lag> struct FixedLagSmoother;
+template <typename Filter> struct FilterCheckpoint;
+template <typename Filter> struct OutOfSequenceFilter;
+
+/**
+ * @brief The Invariant Extended Kalman Filter
+ *
+ * The covariance is that of the invariant error of the filter invariance,
+ * right \f$ x = Exp(\xi) \hat{x} \f$ or left \f$ x = \hat{x} Exp(\xi) \f$.
+ * An update by a measurement model of the other invariance maps it
+ * through the adjoint, there and back. In lazy mode the map back is
+ * deferred, so that consecutive updates by such models only map it once,
+ * e.g. a left invariant filter for GPS-heavy setups, the other way round.
+ *
+ * For time-invariant configurations, the gains may be frozen once
+ * the covariance reached its steady state, see setSteadyStateGain.
+ *
+ * @tparam StateType The state type
+ * @tparam Iv The invariance of the filter
+ * @tparam Solver The innovation covariance decomposition
+ *
+ * @see setLazyPropagation
+ * @see setSteadyStateGain
+ */
+template <
+  typename StateType,
+  Invariance Iv = Invariance::Right,
+  InnovationSolver Solver = InnovationSolver::LLT
+>
 struct InvariantExtendedKalmanFilter
   : public internal::KalmanFilterBase<
-      InvariantExtendedKalmanFilter<StateType, Iv>
+      InvariantExtendedKalmanFilter<StateType, Iv, Solver>
     >
-  , public internal::CovarianceBase<StateType> {
-
-  static_assert(
-    Iv == Invariance::Right,
-    "IEKF: Only Right invariance supported at the moment."
-  );
+  , public internal::LazyCovarianceBase<StateType>
+  , public internal::InnovationBase<StateType, Solver>
+  , public internal::SteadyStateBase<StateType, Solver>
+  , public internal::IterationBase
+  , public internal::TransitionBase<StateType> {
 
   using Base = internal::KalmanFilterBase<
-    InvariantExtendedKalmanFilter<StateType, Iv>
+    InvariantExtendedKalmanFilter<StateType, Iv, Solver>
   >;
-  using CovarianceBase = internal::CovarianceBase<StateType>;
+  using CovarianceBase = internal::LazyCovarianceBase<StateType>;
+  using InnovationBase = internal::InnovationBase<StateType, Solver>;
+  using SteadyStateBase = internal::SteadyStateBase<StateType, Solver>;
 
   using typename Base::State;
   using typename Base::Scalar;
   using Base::setState;
-  using CovarianceBase::setCovariance;
+  using CovarianceBase::getCovariance;
+  using CovarianceBase::setLazyPropagation;
+  using CovarianceBase::isLazyPropagation;
   using Base::getState;
+  using Base::setValidation;
+  using Base::getValidation;
+  using Base::getValidationPeriod;
+  using InnovationBase::getInnovation;
+  using InnovationBase::getInnovationDecomposition;
+  using InnovationBase::isInnovationFallback;
+  using InnovationBase::getNormalizedInnovationSquared;
+  using InnovationBase::isInnovationAccepted;
+  using InnovationBase::getInnovationWeight;
+  using SteadyStateBase::setSteadyStateGain;
+  using SteadyStateBase::isSteadyStateGain;
+  using SteadyStateBase::isSteadyState;
+  using internal::IterationBase::getIterationSummary;
 
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
 
@@ -42,19 +85,67 @@ struct InvariantExtendedKalmanFilter
     setCovariance(cov_init);
   }
 
+  /**
+   * @brief Set the covariance, discarding the pending propagations
+   * and the recorded steady state.
+   * @param [in] covariance The input covariance
+   */
+  bool setCovariance(const Eigen::Ref<const Covariance<State>>& covariance) {
+    SteadyStateBase::resetSteadyState();
+    return CovarianceBase::setCovariance(covariance);
+  }
+
+  /**
+   * @brief Set the covariance square root, discarding the pending
+   * propagations and the recorded steady state.
+   */
+  bool setCovarianceSquareRoot(
+    const Covariance<State>& covariance_square_root
+  ) {
+    SteadyStateBase::resetSteadyState();
+    return CovarianceBase::setCovarianceSquareRoot(covariance_square_root);
+  }
+
 protected:
 
   using Base::x;
+  using Base::validateCovariance;
+  using Base::instrument;
   using CovarianceBase::P;
+  using CovarianceBase::invalidateCovarianceSquareRoot;
+  using CovarianceBase::getPendingTransition;
+  using CovarianceBase::getHeldCovariance;
+  using CovarianceBase::isReparametrized;
+  using CovarianceBase::lazy_;
+  using InnovationBase::S_;
+  using InnovationBase::weight_;
+  using InnovationBase::setInnovation;
+  using InnovationBase::solveInnovation;
+  using InnovationBase::gateInnovation;
+  using SteadyStateBase::steady_state_gain_;
+  using internal::IterationBase::startIterations;
+  using internal::IterationBase::continueIterations;
+  using internal::TransitionBase<StateType>::recordTransition;
 
   friend Base;
-  friend RauchTungStriebelSmoother<InvariantExtendedKalmanFilter<StateType, Iv>>;
+  template <typename, typename> friend struct RauchTungStriebelSmoother;
+  template <typename, std::size_t> friend struct FixedLagSmoother;
+  template <typename> friend struct FilterCheckpoint;
+  template <typename> friend struct OutOfSequenceFilter;
 
-  Jacobian<State, State> A_ = Jacobian<State, State>::Zero();
+  /**
+   * @brief Whether the steps are recorded for, or replayed from,
+   * the steady state. The lazy propagation takes precedence.
+   */
+  bool tracksSteadyState() const {
+    return steady_state_gain_ && !lazy_;
+  }
 
-  // @todo this definitely is an inelegant workaround
-  const Jacobian<State, State>& getA() const {
-    return A_;
+  void rollbackCovariance(
+    const typename CovarianceBase::CovarianceSnapshot& snapshot
+  ) {
+    CovarianceBase::rollbackCovariance(snapshot);
+    SteadyStateBase::resetSteadyState();
   }
 
   template <class SystemModelDerived>
@@ -65,29 +156,233 @@ protected:
   ) {
     using Control = typename internal::traits<SystemModelDerived>::Control;
 
-    //! System model jacobian
-    Jacobian<State, State> F;
-
     //! System model noise jacobian
     Jacobian<State, Control> W;
 
-    // propagate state
-    x = f(x, u, F, W, dt);
+    using Sparsity =
+      typename internal::invariant_jacobian_sparsity<SystemModelDerived>::type;
+
+    if constexpr (Iv == Invariance::Left) {
+      //! System model jacobian
+      Jacobian<State, State> F;
+
+      {
+        const auto stage = instrument(Stage::Model);
+        if constexpr (
+          internal::has_left_invariant_jacobian<SystemModelDerived>{}
+        ) {
+          x = f.runLeftInvariant(x, u, F, W, dt);
+        } else {
+          const State x0 = x;
+          f.into(x0, u, x, F, W, dt);
+
+          // map the right invariant jacobians,
+          // F_L = Ad_x^-1 F_R Ad_x0 and W_L = Ad_x^-1 W_R
+          const auto AdXinv =
+            internal::invarianceAdjoint<Invariance::Right, Iv>(x);
+          F = AdXinv * F * x0.adj();
+          W = AdXinv * W;
+        }
+      }
+
+      propagateCovariance<DenseJacobian>(F, W, f.getCovariance());
+    } else if constexpr (
+      internal::has_state_independent_invariant_jacobian<SystemModelDerived>{}
+    ) {
+      // propagate state, only the noise jacobian depends on it
+      {
+        const auto stage = instrument(Stage::Model);
+        f.into(x, u, x, W, dt);
+      }
+
+      // propagate covariance with the model's cached jacobian
+      propagateNoisyCovariance<SystemModelDerived, Sparsity>(
+        f, f.getInvariantJacobian(dt), W, dt
+      );
+    } else {
+      //! System model jacobian
+      Jacobian<State, State> F;
+
+      // propagate state
+      {
+        const auto stage = instrument(Stage::Model);
+        f.into(x, u, x, F, W, dt);
+      }
+
+      // propagate covariance
+      propagateNoisyCovariance<SystemModelDerived, Sparsity>(f, F, W, dt);
+    }
+
+    return getState();
+  }
+
+  /**
+   * @brief Propagate the covariance with the model's noise,
+   * precomputed if its invariant noise jacobian is constant.
+   *
+   * @see internal::has_constant_invariant_noise_jacobian
+   */
+  template <
+    class SystemModelDerived, typename Sparsity,
+    typename _DerivedF, typename _DerivedW
+  >
+  void propagateNoisyCovariance(
+    const LinearizedInvariant<SystemModelBase<SystemModelDerived>>& f,
+    const Eigen::MatrixBase<_DerivedF>& F,
+    const Eigen::MatrixBase<_DerivedW>& W,
+    const Scalar dt
+  ) {
+    if constexpr (
+      internal::has_constant_invariant_noise_jacobian<SystemModelDerived>{}
+    ) {
+      propagateCovariance<Sparsity>(F, f.getInvariantPropagatedNoise(dt));
+    } else {
+      propagateCovariance<Sparsity>(F, W, f.getCovariance());
+    }
+  }
+
+  /**
+   * @brief Propagate the covariance,
+   * or only accumulate the propagation in lazy mode.
+   *
+   * In lazy mode, A is then the transition since the last update.
+   *
+   * @tparam Sparsity The sparsity of the system model jacobian
+   * @param [in] F The system model jacobian
+   * @param [in] noise The system model noise jacobian W and covariance Q,
+   * or their precomputed product W.Q.W^T
+   */
+  template <typename Sparsity, typename _DerivedF, typename... Noise>
+  void propagateCovariance(
+    const Eigen::MatrixBase<_DerivedF>& F,
+    const Noise&... noise
+  ) {
+    if (tracksSteadyState()) {
+      propagateSteadyCovariance<Sparsity>(
+        F, internal::propagatedNoise(noise...)
+      );
+      return;
+    }
+
+    if (lazy_) {
+      CovarianceBase::template deferPropagation<Sparsity>(F, noise...);
+      recordTransition(getPendingTransition());
+      return;
+    }
+
+    applyLazyPropagation();
 
-    // propagate covariance
-    P = F * P * F.transpose();
-    P.noalias() += W * f.getCovariance() * W.transpose();
+    {
+      const auto stage = instrument(Stage::Covariance);
+      P = internal::sparseCovarianceProduct<Sparsity>(F, P, noise...);
+    }
+    invalidateCovarianceSquareRoot();
 
-    A_ = F;
+    recordTransition(F);
 
     // enforceCovariance(P);
 
-    KALMANIF_ASSERT(
-      isCovariance(P),
+    validateCovariance(
+      P,
       "IEKF::propagate: Updated matrix P is not a covariance."
     );
+  }
 
-    return getState();
+  /**
+   * @brief Propagate the covariance, or replay the propagation
+   * of the steady state if F and N match it.
+   *
+   * @tparam Sparsity The sparsity of the system model jacobian
+   * @param [in] F The system model jacobian
+   * @param [in] N The propagated noise W.Q.W^T
+   */
+  template <typename Sparsity, typename _DerivedF, typename _DerivedN>
+  void propagateSteadyCovariance(
+    const Eigen::MatrixBase<_DerivedF>& F,
+    const Eigen::MatrixBase<_DerivedN>& N
+  ) {
+    applyLazyPropagation();
+
+    if (const auto* step = SteadyStateBase::steadyPropagation(F, N)) {
+      P = step->P;
+    } else {
+      {
+        const auto stage = instrument(Stage::Covariance);
+        P = internal::sparseCovarianceProduct<Sparsity>(F, P, N);
+      }
+
+      validateCovariance(
+        P,
+        "IEKF::propagate: Updated matrix P is not a covariance."
+      );
+
+      SteadyStateBase::recordPropagation(F, N, P);
+    }
+    invalidateCovarianceSquareRoot();
+
+    recordTransition(F);
+  }
+
+  /**
+   * @brief Apply the pending lazy propagations to the covariance, if any.
+   */
+  void applyLazyPropagation() {
+    if (CovarianceBase::applyPropagation()) {
+      validateCovariance(
+        P,
+        "IEKF::propagate: Updated matrix P is not a covariance."
+      );
+    }
+  }
+
+  /**
+   * @brief Apply the pending lazy propagations before an update
+   * by a model of invariance ModelInvariance,
+   * but for a deferred map of the covariance to that invariance.
+   */
+  template <Invariance ModelInvariance>
+  void prepareCovariance() {
+    if (ModelInvariance == Iv || !isReparametrized()) {
+      applyLazyPropagation();
+    }
+  }
+
+  /**
+   * @brief The covariance of the invariant error of ModelInvariance
+   */
+  template <Invariance ModelInvariance>
+  Covariance<State> getInvariantCovariance() const {
+    if constexpr (ModelInvariance == Iv) {
+      return P;
+    } else {
+      if (isReparametrized()) {
+        return getHeldCovariance();
+      }
+      return internal::covarianceProduct(
+        internal::invarianceAdjoint<Iv, ModelInvariance>(x), P
+      );
+    }
+  }
+
+  /**
+   * @brief Set the corrected covariance of the invariant error of
+   * ModelInvariance, its map back to the filter invariance is deferred
+   * in lazy mode.
+   */
+  template <Invariance ModelInvariance, typename _Derived>
+  void setInvariantCovariance(const Eigen::MatrixBase<_Derived>& P_model) {
+    if constexpr (ModelInvariance == Iv) {
+      P = P_model;
+      invalidateCovarianceSquareRoot();
+    } else {
+      const auto Ad = internal::invarianceAdjoint<ModelInvariance, Iv>(x);
+      if (lazy_) {
+        CovarianceBase::deferReparametrization(P_model, Ad);
+      } else {
+        P = internal::covarianceProduct(Ad, P_model);
+        invalidateCovarianceSquareRoot();
+      }
+    }
   }
 
   /**
@@ -103,74 +398,613 @@ protected:
     const LinearizedInvariant<MeasurementModelBase<MeasurementModelDerived>>& h,
     const typename internal::traits<MeasurementModelDerived>::Measurement& y
   ) {
+    prepareCovariance<MeasurementModelDerived::ModelInvariance>();
+
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+
+    Jacobian<Measurement, State> H;
+    Jacobian<Measurement, Measurement> M;
+
+    // compute expectation
+    const Measurement e = [&]() {
+      const auto stage = instrument(Stage::Model);
+      return h(x, H, M);
+    }();
+
+    Covariance<Measurement> MRMt = internal::covarianceProduct(M, h.getCovariance());
+
+    // @todo Fix 'z = R * (y - e)'  with X = [R, t].
+    // This is the group action on vector!
+    if constexpr (internal::has_diagonal_noise<MeasurementModelDerived>{}) {
+      correctSequential<MeasurementModelDerived::ModelInvariance>(
+        H, MRMt, M * (y - e)
+      );
+    } else {
+      correct<
+        MeasurementModelDerived::ModelInvariance,
+        typename internal::invariant_jacobian_sparsity<
+          MeasurementModelDerived
+        >::type
+      >(H, MRMt, M * (y - e));
+    }
+
+    validateCovariance(
+      getHeldCovariance(),
+      "IEKF::update: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform a gated filter update step using measurement \f$z\f$
+   * and corresponding measurement model
+   *
+   * The measurement is rejected, leaving the estimate untouched,
+   * if its NIS exceeds the gate threshold.
+   * The decomposition of the innovation covariance computed for
+   * the gate is then reused for the kalman gain.
+   *
+   * @param [in] h The Measurement model
+   * @param [in] y The measurement vector
+   * @param [in] gate The Mahalanobis gate
+   * @return The updated state estimate
+   *
+   * @see isInnovationAccepted
+   */
+  template <typename MeasurementModelDerived>
+  const State& update_impl(
+    const LinearizedInvariant<MeasurementModelBase<MeasurementModelDerived>>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    const MahalanobisGate& gate
+  ) {
+    prepareCovariance<MeasurementModelDerived::ModelInvariance>();
+
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+
+    Jacobian<Measurement, State> H;
+    Jacobian<Measurement, Measurement> M;
+
+    // compute expectation
+    const Measurement e = [&]() {
+      const auto stage = instrument(Stage::Model);
+      return h(x, H, M);
+    }();
+
+    Covariance<Measurement> MRMt = internal::covarianceProduct(M, h.getCovariance());
+
+    if (
+      !correct<
+        MeasurementModelDerived::ModelInvariance,
+        typename internal::invariant_jacobian_sparsity<
+          MeasurementModelDerived
+        >::type
+      >(H, MRMt, M * (y - e), gate.threshold)
+    ) {
+      return getState();
+    }
+
+    validateCovariance(
+      getHeldCovariance(),
+      "IEKF::update: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform a robust filter update step using measurement \f$z\f$
+   * and corresponding measurement model
+   *
+   * The measurement noise is down-weighted by the kernel
+   * at the residual of the update, see RobustKernel.
+   * The model is linearized once, the re-weighting iterations reuse
+   * its jacobian and a single factorization of the innovation covariance.
+   *
+   * @param [in] h The Measurement model
+   * @param [in] y The measurement vector
+   * @param [in] kernel The robust kernel
+   * @return The updated state estimate
+   *
+   * @see getInnovationWeight
+   */
+  template <typename MeasurementModelDerived>
+  const State& update_impl(
+    const LinearizedInvariant<MeasurementModelBase<MeasurementModelDerived>>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    const RobustKernel& kernel
+  ) {
+    prepareCovariance<MeasurementModelDerived::ModelInvariance>();
+
     using Measurement =
       typename internal::traits<MeasurementModelDerived>::Measurement;
-    using Tangent = typename State::Tangent;
 
     Jacobian<Measurement, State> H;
     Jacobian<Measurement, Measurement> M;
 
     // compute expectation
-    Measurement e = h(x, H, M);
+    const Measurement e = [&]() {
+      const auto stage = instrument(Stage::Model);
+      return h(x, H, M);
+    }();
+
+    Covariance<Measurement> MRMt = internal::covarianceProduct(M, h.getCovariance());
+
+    correctRobust<
+      MeasurementModelDerived::ModelInvariance,
+      typename internal::invariant_jacobian_sparsity<
+        MeasurementModelDerived
+      >::type
+    >(H, MRMt, M * (y - e), kernel);
+
+    validateCovariance(
+      getHeldCovariance(),
+      "IEKF::update: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
 
-    const Covariance<State>& Ptmp = [&]() {
-      if constexpr (MeasurementModelDerived::ModelInvariance == Invariance::Right) {
-        return P;
+  /**
+   * @brief Perform an iterated filter update step using measurement \f$z\f$
+   * and corresponding measurement model
+   *
+   * Gauss-Newton on the manifold: the measurement model is re-linearized
+   * at the current iterate \f$ x_i \f$ until the budget is met.
+   * With \f$ e \f$ the invariant deviation of the prior \f$ x_0 \f$
+   * from \f$ x_i \f$, i.e. \f$ x_0 = Exp(e) x_i \f$ for a 'right' model
+   * and \f$ x_0 = x_i Exp(e) \f$ for a 'left' model,
+   * and \f$ P_i = J(e) P J(e)^T \f$ the prior covariance at \f$ x_i \f$,
+   * the correction is \f$ K (z_i + H e) - e \f$.
+   *
+   * @param [in] h The linearized measurement model
+   * @param [in] y The measurement vector
+   * @param [in] budget The iterations budget
+   * @return The updated state estimate
+   *
+   * @see IterationBudget
+   * @see getIterationSummary
+   */
+  template <typename MeasurementModelDerived>
+  const State& update_impl(
+    const LinearizedInvariant<MeasurementModelBase<MeasurementModelDerived>>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    const IterationBudget& budget
+  ) {
+    prepareCovariance<MeasurementModelDerived::ModelInvariance>();
+
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+    using Tangent = typename State::Tangent;
+    constexpr Invariance ModelInvariance =
+      MeasurementModelDerived::ModelInvariance;
+
+    const auto start = startIterations();
+
+    // the iterated gain depends on the state
+    SteadyStateBase::resetSteadyState();
+
+    const State x0 = x;
+
+    // Prior covariance in the measurement model invariance
+    const Covariance<State> P0 = getInvariantCovariance<ModelInvariance>();
+
+    Jacobian<Measurement, State> H;
+    Jacobian<Measurement, Measurement> M;
+    Covariance<Measurement> MRMt;
+    KalmanGain<State, Measurement> K;
+    Covariance<State> Ptmp;
+
+    Tangent e = Tangent::Zero();
+    double step_norm = 0;
+
+    do {
+      const Jacobian<State, State> J = [&]() {
+        if constexpr (ModelInvariance == Invariance::Right) {
+          return e.rjac();
+        } else {
+          return e.ljac();
+        }
+      }();
+      Ptmp = internal::covarianceProduct(J, P0);
+
+      // invariant innovation at x_i, relative to the prior
+      const Measurement ei = h(x, H, M);
+      const Measurement z = M * (y - ei) + H * e.coeffs();
+
+      MRMt = internal::covarianceProduct(M, h.getCovariance());
+
+      setInnovation(z, internal::covarianceProduct(H, Ptmp, MRMt));
+      solveInnovation(H * Ptmp, K.transpose());
+
+      const Tangent dx(e.coeffs() - K * z);
+
+      if constexpr (ModelInvariance == Invariance::Right) {
+        x = dx + x; // Right invariant: Exp(dx) * x
+        e = x0.lminus(x);
       } else {
-        // Map covariance to Left invariant (from Right thus)
-        auto AdXinv = x.inverse().adj();
-        return (AdXinv * P * AdXinv.transpose()).eval();
+        x += dx; // Left invariant: x * Exp(dx)
+        e = x0.rminus(x);
       }
-    }();
 
-    Covariance<Measurement> MRMt = M * h.getCovariance() * M.transpose();
+      step_norm = dx.coeffs().norm();
+    } while (continueIterations(step_norm, start, budget));
 
-    // compute kalman gain
-    KalmanGain<State, Measurement> K =
-      Ptmp * H.transpose() * (H * Ptmp * H.transpose() + MRMt).inverse();
+    const Covariance<State> IKH = Covariance<State>::Identity() - K * H;
+
+    // Update covariance at the last linearization
+    setInvariantCovariance<ModelInvariance>(
+      internal::covarianceProduct(IKH, Ptmp, K, MRMt)
+    );
+
+    validateCovariance(
+      getHeldCovariance(),
+      "IEKF::update: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform a single filter update step using a stack of
+   * measurements \f$z_i\f$ and corresponding measurement models
+   *
+   * @tparam Count The number of measurements or Eigen::Dynamic
+   * @param [in] h_it Iterator to the first linearized measurement model
+   * @param [in] y_it Iterator to the first measurement vector
+   * @param [in] count The number of measurements
+   * @return The updated state estimate
+   */
+  template <
+    int Count, class MeasurementModelIterator, class MeasurementIterator
+  >
+  const State& update_stacked_impl(
+    MeasurementModelIterator h_it,
+    MeasurementIterator y_it,
+    const int count
+  ) {
+    using MeasurementModelDerived =
+      typename std::iterator_traits<MeasurementModelIterator>::value_type;
+
+    prepareCovariance<MeasurementModelDerived::ModelInvariance>();
+
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+    using Stacked = StackedMeasurement<Measurement, Count>;
+    constexpr auto MeasSize = internal::traits<Measurement>::Size;
+    constexpr auto StateSize = internal::traits<State>::Size;
+    const auto StackedSize = count * MeasSize;
+
+    Stacked z(StackedSize);
+    Jacobian<Stacked, State, 0, Stacked::MaxRowsAtCompileTime> H(
+      StackedSize, StateSize
+    );
+    StackedCovariance<Stacked> MRMt =
+      StackedCovariance<Stacked>::Zero(StackedSize, StackedSize);
+
+    Jacobian<Measurement, Measurement> M;
+
+    {
+      const auto stage = instrument(Stage::Model);
+
+      for (int i = 0; i < count; ++i, ++h_it, ++y_it) {
+        const LinearizedInvariant<
+          MeasurementModelBase<MeasurementModelDerived>
+        >& h = *h_it;
+        const auto b = i * MeasSize;
+
+        // compute expectation and stack innovation
+        const Measurement e = h(x, H.template middleRows<MeasSize>(b), M);
+        z.template segment<MeasSize>(b).noalias() = M * (*y_it - e);
+
+        MRMt.template block<MeasSize, MeasSize>(b, b).noalias() =
+          internal::covarianceProduct(M, h.getCovariance());
+      }
+    }
+
+    if constexpr (internal::has_diagonal_noise<MeasurementModelDerived>{}) {
+      correctSequential<MeasurementModelDerived::ModelInvariance>(H, MRMt, z);
+    } else {
+      correct<MeasurementModelDerived::ModelInvariance>(H, MRMt, z);
+    }
+
+    validateCovariance(
+      getHeldCovariance(),
+      "IEKF::update: Updated matrix P is not a covariance."
+    );
+
+    return getState();
+  }
+
+  /**
+   * @brief Correct the state estimate and its covariance
+   * given an invariant innovation, its jacobian and noise.
+   *
+   * @tparam ModelInvariance The invariance of the measurement model
+   * @tparam Sparsity The sparsity of the measurement jacobian
+   * @param [in] H The measurement jacobian
+   * @param [in] MRMt The measurement noise covariance
+   * @param [in] z The invariant innovation
+   * @param [in] threshold The NIS above which the innovation is rejected
+   * @return Whether the innovation was accepted
+   */
+  template <
+    Invariance ModelInvariance,
+    typename Sparsity = DenseJacobian,
+    typename _DerivedH,
+    typename _DerivedR,
+    typename _DerivedZ
+  >
+  bool correct(
+    const Eigen::MatrixBase<_DerivedH>& H,
+    const Eigen::MatrixBase<_DerivedR>& MRMt,
+    const Eigen::MatrixBase<_DerivedZ>& z,
+    const double threshold = std::numeric_limits<double>::infinity()
+  ) {
+    using Tangent = typename State::Tangent;
+    using Innovation = typename _DerivedZ::PlainObject;
+
+    if constexpr (ModelInvariance == Iv) {
+      if (tracksSteadyState()) {
+        if (const auto* step = SteadyStateBase::steadyUpdate(H, MRMt)) {
+          return correctSteady<ModelInvariance>(*step, z, threshold);
+        }
+      }
+    } else {
+      // the adjoint map depends on the state
+      SteadyStateBase::resetSteadyState();
+    }
+
+    // Covariance in the measurement model invariance
+    const Covariance<State> Ptmp = getInvariantCovariance<ModelInvariance>();
+
+    KalmanGain<
+      State, Innovation, 0,
+      internal::traits<State>::Size, Innovation::MaxRowsAtCompileTime
+    > K;
+
+    {
+      const auto stage = instrument(Stage::Gain);
+
+      const auto HP = internal::sparseProduct<Sparsity>(H, Ptmp);
+
+      // compute and decompose the innovation covariance
+      // S = H.(H.P)^T + R with P symmetric
+      setInnovation(
+        z, internal::sparseProduct<Sparsity>(H, HP.transpose()) + MRMt
+      );
+
+      // gate before touching the estimate
+      if (!gateInnovation(threshold)) {
+        return false;
+      }
+
+      // compute kalman gain, solve using the decomposition
+      // S.K^T = H.P with S = H.P.H^T + R symmetric
+      solveInnovation(HP, K.transpose());
+    }
 
-    // @todo Fix 'z = R * (y - e)'  with X = [R, t].
-    // This is the group action on vector!
     // compute correction using computed kalman gain and innovation
-    Tangent dx(-(K * (M * (y - e))));
+    Tangent dx(-(K * z));
 
     // Update state using correction
-    if constexpr (MeasurementModelDerived::ModelInvariance == Invariance::Right) {
+    if constexpr (ModelInvariance == Invariance::Right) {
       x = dx + x; // Right invariant: Exp(-dx) * x
     } else {
-      x = x + dx; // Left invariant: x * Exp(-dx)
+      x += dx; // Left invariant: x * Exp(-dx)
     }
 
+    const auto stage = instrument(Stage::Covariance);
+
     Covariance<State> IKH = Covariance<State>::Identity() - K * H;
 
     // Update covariance
     // Use the 'Joseph' equation which is numerically more stable
     // P = (I - K.H).P.(I - K.H)^T + K.R.K^T
-    if constexpr (MeasurementModelDerived::ModelInvariance == Invariance::Right){
-      P = IKH * Ptmp * IKH.transpose();
-      P.noalias() += K * MRMt * K.transpose();
+    setInvariantCovariance<ModelInvariance>(
+      internal::covarianceProduct(IKH, Ptmp, K, MRMt)
+    );
+
+    // enforceCovariance(P);
+
+    if constexpr (ModelInvariance == Iv) {
+      if (tracksSteadyState()) {
+        if (isInnovationFallback()) {
+          // the failed decomposition can not be replayed
+          SteadyStateBase::resetSteadyState();
+        } else {
+          SteadyStateBase::recordUpdate(H, MRMt, K, S_, P);
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Correct the state estimate and its covariance
+   * given an invariant innovation, its jacobian and a noise re-weighted
+   * by a robust kernel.
+   *
+   * @tparam ModelInvariance The invariance of the measurement model
+   * @tparam Sparsity The sparsity of the measurement jacobian
+   * @param [in] H The measurement jacobian
+   * @param [in] MRMt The measurement noise covariance
+   * @param [in] z The invariant innovation
+   * @param [in] kernel The robust kernel
+   *
+   * @note The innovation and its covariance returned by getInnovation()
+   * and getInnovationDecomposition() are the unweighted ones.
+   */
+  template <
+    Invariance ModelInvariance,
+    typename Sparsity = DenseJacobian,
+    typename _DerivedH,
+    typename _DerivedR,
+    typename _DerivedZ
+  >
+  void correctRobust(
+    const Eigen::MatrixBase<_DerivedH>& H,
+    const Eigen::MatrixBase<_DerivedR>& MRMt,
+    const Eigen::MatrixBase<_DerivedZ>& z,
+    const RobustKernel& kernel
+  ) {
+    using Tangent = typename State::Tangent;
+    using Innovation = typename _DerivedZ::PlainObject;
+
+    // the weight depends on the measurement
+    SteadyStateBase::resetSteadyState();
+
+    // Covariance in the measurement model invariance
+    const Covariance<State> Ptmp = getInvariantCovariance<ModelInvariance>();
+
+    KalmanGain<
+      State, Innovation, 0,
+      internal::traits<State>::Size, Innovation::MaxRowsAtCompileTime
+    > K;
+
+    {
+      const auto stage = instrument(Stage::Gain);
+
+      const auto HP = internal::sparseProduct<Sparsity>(H, Ptmp);
+      const auto HPHt = internal::sparseProduct<Sparsity>(H, HP.transpose());
+
+      setInnovation(z, HPHt + MRMt);
+
+      internal::RobustReweighting<State, _DerivedR> irls(
+        HPHt, MRMt, z
+      );
+      weight_ = irls.reweight(kernel);
+
+      // S_w.K^T = H.P with S_w = H.P.H^T + R/w
+      K.transpose() = irls.gain(HP);
+    }
+
+    // compute correction using computed kalman gain and innovation
+    Tangent dx(-(K * z));
+
+    // Update state using correction
+    if constexpr (ModelInvariance == Invariance::Right) {
+      x = dx + x; // Right invariant: Exp(-dx) * x
     } else {
-      // Map covariance back to Right invariant (from Left thus)
-      auto AdX = x.adj();
-      P.noalias() = AdX * (IKH * Ptmp * IKH.transpose() +
-                           K * MRMt * K.transpose()      ) * AdX.transpose();
+      x += dx; // Left invariant: x * Exp(-dx)
     }
 
-    // enforceCovariance(P);
+    const auto stage = instrument(Stage::Covariance);
+
+    Covariance<State> IKH = Covariance<State>::Identity() - K * H;
+
+    // The 'Joseph' equation with the weighted noise
+    setInvariantCovariance<ModelInvariance>(
+      internal::covarianceProduct(IKH, Ptmp, K, MRMt / weight_)
+    );
+  }
+
+  /**
+   * @brief Correct the state estimate with the gain of the steady state,
+   * the covariance being that recorded after the update.
+   *
+   * @tparam ModelInvariance The invariance of the measurement model
+   * @param [in] step The recorded update
+   * @param [in] z The invariant innovation
+   * @param [in] threshold The NIS above which the innovation is rejected
+   * @return Whether the innovation was accepted
+   */
+  template <Invariance ModelInvariance, typename Step, typename _DerivedZ>
+  bool correctSteady(
+    const Step& step,
+    const Eigen::MatrixBase<_DerivedZ>& z,
+    const double threshold
+  ) {
+    using Tangent = typename State::Tangent;
+
+    {
+      const auto stage = instrument(Stage::Gain);
+
+      setInnovation(z, step.S);
+
+      if (!gateInnovation(threshold)) {
+        // the steady state expected this update
+        SteadyStateBase::resetSteadyState();
+        return false;
+      }
+    }
+
+    Tangent dx;
+    dx.coeffs() = -(step.K * z);
+
+    if constexpr (ModelInvariance == Invariance::Right) {
+      x = dx + x; // Right invariant: Exp(-dx) * x
+    } else {
+      x += dx; // Left invariant: x * Exp(-dx)
+    }
+
+    P = step.P;
+    invalidateCovarianceSquareRoot();
+
+    return true;
+  }
+
+  /**
+   * @brief Correct the state estimate and its covariance
+   * processing the invariant innovation one scalar component at a time.
+   *
+   * Used for measurement models with a diagonal noise
+   * (see internal::has_diagonal_noise).
+   *
+   * @tparam ModelInvariance The invariance of the measurement model
+   * @param [in] H The measurement jacobian
+   * @param [in] MRMt The (diagonal) measurement noise covariance
+   * @param [in] z The invariant innovation
+   *
+   * @note The innovation returned by getInnovation()
+   * is not updated in this mode.
+   * @see sequentialUpdate
+   */
+  template <
+    Invariance ModelInvariance,
+    typename _DerivedH,
+    typename _DerivedR,
+    typename _DerivedZ
+  >
+  void correctSequential(
+    const Eigen::MatrixBase<_DerivedH>& H,
+    const Eigen::MatrixBase<_DerivedR>& MRMt,
+    const Eigen::MatrixBase<_DerivedZ>& z
+  ) {
+    using Tangent = typename State::Tangent;
 
     KALMANIF_ASSERT(
-      isCovariance(P),
-      "IEKF::update: Updated matrix P is not a covariance."
+      MRMt.isDiagonal(),
+      "IEKF::update: Measurement noise is not diagonal."
     );
 
-    return getState();
+    const auto stage = instrument(Stage::Covariance);
+
+    // the scalar gains are not recorded
+    SteadyStateBase::resetSteadyState();
+
+    // Covariance in the measurement model invariance
+    Covariance<State> Ptmp = getInvariantCovariance<ModelInvariance>();
+
+    Tangent dx(-sequentialUpdate(Ptmp, H, MRMt.diagonal(), z));
+
+    if constexpr (ModelInvariance == Invariance::Right) {
+      x = dx + x; // Right invariant: Exp(-dx) * x
+    } else {
+      x += dx; // Left invariant: x * Exp(-dx)
+    }
+
+    setInvariantCovariance<ModelInvariance>(Ptmp);
   }
 };
 
 namespace internal {
 
-template <class StateType, Invariance Iv>
-struct traits<InvariantExtendedKalmanFilter<StateType, Iv>> {
+template <class StateType, Invariance Iv, InnovationSolver Solver>
+struct traits<InvariantExtendedKalmanFilter<StateType, Iv, Solver>> {
   using State = StateType;
 };
 
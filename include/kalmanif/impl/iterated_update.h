@@ -0,0 +1,128 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_ITERATED_UPDATE_H_
+#define _KALMANIF_KALMANIF_IMPL_ITERATED_UPDATE_H_
+
+#include <algorithm>
+#include <chrono>
+
+namespace kalmanif {
+
+/**
+ * @brief The budget of an iterated update.
+ *
+ * The update re-linearizes the measurement model at the current iterate
+ * until the first of the following is met:
+ * the step norm is below step_tolerance,
+ * max_iterations linearizations were performed, or
+ * the time spent in the update exceeds time_budget.
+ *
+ * The first linearization is always performed,
+ * so that max_iterations = 1 is the usual (non-iterated) update.
+ */
+struct IterationBudget {
+  //! The maximum number of linearizations
+  unsigned int max_iterations = 5;
+  //! The step norm below which the iterations have converged
+  double step_tolerance = 1e-8;
+  //! The wall-clock budget of the update
+  std::chrono::steady_clock::duration time_budget =
+    std::chrono::steady_clock::duration::max();
+};
+
+/**
+ * @brief Why an iterated update stopped
+ */
+enum class IterationStop : char {
+  Converged = 0, // The step norm is below the tolerance
+  MaxIterations, // The maximum number of linearizations was performed
+  TimeBudget     // The wall-clock budget was exhausted
+};
+
+/**
+ * @brief The summary of the last iterated update.
+ */
+struct IterationSummary {
+  //! The number of linearizations performed
+  unsigned int iterations = 0;
+  //! The norm of the last step
+  double step_norm = 0;
+  //! Why the iterations stopped
+  IterationStop stop = IterationStop::Converged;
+};
+
+namespace internal {
+
+/**
+ * @brief Base class for filters with an iterated update.
+ */
+struct IterationBase {
+
+  /**
+   * @brief Get the summary of the last iterated update.
+   */
+  const IterationSummary& getIterationSummary() const {
+    return iteration_summary_;
+  }
+
+protected:
+
+  using Clock = std::chrono::steady_clock;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(IterationBase);
+
+  /**
+   * @brief Start the iterations of an update.
+   * @return The update start time
+   */
+  Clock::time_point startIterations() {
+    iteration_summary_ = IterationSummary();
+    return Clock::now();
+  }
+
+  /**
+   * @brief Record an iteration and check whether to perform another one.
+   *
+   * @param [in] step_norm The norm of the step of this iteration
+   * @param [in] start The update start time
+   * @param [in] budget The iterations budget
+   * @return Whether to perform another iteration
+   */
+  bool continueIterations(
+    const double step_norm,
+    const Clock::time_point& start,
+    const IterationBudget& budget
+  ) {
+    IterationSummary& s = iteration_summary_;
+
+    ++s.iterations;
+    s.step_norm = step_norm;
+
+    if (step_norm <= budget.step_tolerance) {
+      s.stop = IterationStop::Converged;
+    } else if (s.iterations >= maxIterations(budget)) {
+      s.stop = IterationStop::MaxIterations;
+    } else if (Clock::now() - start >= budget.time_budget) {
+      s.stop = IterationStop::TimeBudget;
+    } else {
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief The maximum number of linearizations of a budget,
+   * capped to KALMANIF_REALTIME_MAX_ITERATIONS in real-time mode.
+   */
+  static unsigned int maxIterations(const IterationBudget& budget) {
+    return detail::realtime ?
+      std::min(
+        budget.max_iterations, (unsigned int)KALMANIF_REALTIME_MAX_ITERATIONS
+      ) : budget.max_iterations;
+  }
+
+  IterationSummary iteration_summary_;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_ITERATED_UPDATE_H_
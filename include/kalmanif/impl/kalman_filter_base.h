@@ -4,15 +4,30 @@
 namespace kalmanif {
 namespace internal {
 
-template <typename _Derived>
-struct KalmanFilterBase : crtp<_Derived> {
+/**
+ * @brief Base class of the filters
+ *
+ * @tparam _Derived The derived filter
+ * @tparam _Instrumentation The instrumentation of the filter stages,
+ * see KALMANIF_INSTRUMENTATION
+ */
+template <
+  typename _Derived, typename _Instrumentation = KALMANIF_INSTRUMENTATION
+>
+struct KalmanFilterBase
+  : crtp<_Derived>, ValidationBase, InstrumentationBase<_Instrumentation> {
 
   using State = typename internal::traits<_Derived>::State;
   using Scalar = typename internal::traits<State>::Scalar;
+  using Instrumentation = _Instrumentation;
+
+  //! A snapshot of the filter estimate, see snapshot
+  using Snapshot = internal::FilterSnapshot<_Derived>;
 
 protected:
 
   using crtp<_Derived>::derived;
+  using InstrumentationBase<_Instrumentation>::instrument;
 
   KALMANIF_DEFAULT_CONSTRUCTOR(KalmanFilterBase);
 
@@ -37,13 +52,20 @@ public:
    * @param [in] s The System model
    * @param [in] u The Control input vector
    * @return The updated state estimate
+   *
+   * @note Does not allocate for fixed-size states,
+   * see test/gtest_no_allocation.cpp
+   * @note noexcept in real-time mode, see KALMANIF_REALTIME
    */
   template<class SystemModelDerived, typename... Args>
   const State& propagate(
     const SystemModelBase<SystemModelDerived>& f,
     const typename internal::traits<SystemModelDerived>::Control& u,
     Args&&... args
-  ) {
+  ) KALMANIF_NOEXCEPT {
+    const NoMallocScope no_malloc;
+    step();
+    const auto stage = instrument(Stage::Propagation);
     return derived().propagate_impl(f.derived(), u, std::forward<Args>(args)...);
   }
 
@@ -54,16 +76,153 @@ public:
    * @param [in] m The Measurement model
    * @param [in] z The measurement vector
    * @return The updated state estimate
+   *
+   * @note Does not allocate for fixed-size states once an update
+   * of the same measurement size was performed, nor at all
+   * in real-time mode, see test/gtest_no_allocation.cpp
+   * @note noexcept in real-time mode, see KALMANIF_REALTIME
    */
   template <class MeasurementModelDerived, typename... Args>
   const State& update(
     const MeasurementModelBase<MeasurementModelDerived>& h,
     const typename internal::traits<MeasurementModelDerived>::Measurement& y,
     Args&&... args
-  ) {
+  ) KALMANIF_NOEXCEPT {
+    const NoMallocScope no_malloc;
+    step();
+    const auto stage = instrument(Stage::Update);
     return derived().update_impl(h.derived(), y, std::forward<Args>(args)...);
   }
 
+#if KALMANIF_HAS_COROUTINES
+
+  /**
+   * @brief An awaitable propagate, run on a strand.
+   *
+   * The awaiting coroutine is resumed on the strand with
+   * a copy of the propagated state. Operations awaited on the strand
+   * of a filter are serialized, e.g.
+   * @code
+   * Strand<Scheduler> strand(scheduler);
+   * const State x = co_await filter.propagateAsync(strand, f, u);
+   * @endcode
+   *
+   * @param [in] strand The strand of the filter, see Strand
+   * @param [in] f The System model, it must outlive the operation
+   * @param [in] u The Control input vector, copied
+   * @return An awaitable of the updated state estimate
+   *
+   * @note Requires C++20 coroutines, see KALMANIF_HAS_COROUTINES.
+   */
+  template <class Strand, class SystemModelDerived, typename... Args>
+  auto propagateAsync(
+    Strand& strand,
+    const SystemModelBase<SystemModelDerived>& f,
+    const typename internal::traits<SystemModelDerived>::Control& u,
+    Args... args
+  ) {
+    return internal::StrandAwaitable(
+      strand, [this, &f, u, args...]() -> State {
+        return propagate(f, u, args...);
+      }
+    );
+  }
+
+  /**
+   * @brief An awaitable update, run on a strand.
+   *
+   * @param [in] strand The strand of the filter, see Strand
+   * @param [in] h The Measurement model, it must outlive the operation
+   * @param [in] y The measurement vector, copied
+   * @return An awaitable of the updated state estimate
+   *
+   * @see propagateAsync
+   */
+  template <class Strand, class MeasurementModelDerived, typename... Args>
+  auto updateAsync(
+    Strand& strand,
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    Args... args
+  ) {
+    return internal::StrandAwaitable(
+      strand, [this, &h, y, args...]() -> State {
+        return update(h, y, args...);
+      }
+    );
+  }
+
+#endif // KALMANIF_HAS_COROUTINES
+
+  /**
+   * @brief Perform a single filter update step using a range of
+   * measurements \f$z_i\f$ and their corresponding measurement models.
+   *
+   * The measurements are stacked so that the gain and covariance
+   * are computed once for the whole range.
+   * If the range size is known at compile time (e.g. std::array),
+   * the stack is fixed-size. Otherwise it is bounded-dynamic and
+   * ranges larger than KALMANIF_MAX_STACKED_MEASUREMENTS are processed
+   * in successive stacks.
+   *
+   * @param [in] hs The range of measurement models
+   * @param [in] ys The range of measurement vectors
+   * @return The updated state estimate
+   *
+   * @note noexcept in real-time mode, see KALMANIF_REALTIME
+   */
+  template <
+    class MeasurementModelRange,
+    class MeasurementRange,
+    typename = internal::enable_if_is_measurement_model_range<
+      MeasurementModelRange
+    >
+  >
+  const State& update(
+    const MeasurementModelRange& hs,
+    const MeasurementRange& ys
+  ) KALMANIF_NOEXCEPT {
+    constexpr int Count =
+      internal::static_range_size<MeasurementModelRange>::value;
+
+    const std::size_t size = std::distance(std::begin(hs), std::end(hs));
+    const bool sizes_match =
+      size == std::size_t(std::distance(std::begin(ys), std::end(ys)));
+
+    KALMANIF_CHECK(
+      sizes_match,
+      "KalmanFilterBase::update: Ranges size mismatch!",
+      kalmanif::invalid_argument
+    );
+
+    // In real-time mode the check does not throw
+    if (!sizes_match) {
+      return getState();
+    }
+
+    const NoMallocScope no_malloc;
+    step();
+    const auto stage = instrument(Stage::Update);
+
+    if constexpr (Count != Eigen::Dynamic) {
+      return derived().template update_stacked_impl<Count>(
+        std::begin(hs), std::begin(ys), Count
+      );
+    } else {
+      auto h = std::begin(hs);
+      auto y = std::begin(ys);
+      for (std::size_t i = 0; i < size; i += KALMANIF_MAX_STACKED_MEASUREMENTS) {
+        const int count = int(std::min<std::size_t>(
+          size - i, KALMANIF_MAX_STACKED_MEASUREMENTS
+        ));
+        derived().template update_stacked_impl<Eigen::Dynamic>(h, y, count);
+        std::advance(h, count);
+        std::advance(y, count);
+      }
+      return getState();
+    }
+  }
+
   /**
    * @brief Initialize state
    * @param state The state of the system
@@ -79,6 +238,41 @@ public:
     return x;
   }
 
+  /**
+   * @brief Record the filter estimate, so that a tentative
+   * propagation or update can be rolled back.
+   *
+   * Only the state and the covariance (as the filter holds it,
+   * pending lazy propagations included) are recorded,
+   * at O(n^2) without allocation for fixed-size states.
+   *
+   * @param [out] snapshot The snapshot
+   * @see rollback, UndoBuffer
+   */
+  void snapshot(Snapshot& snapshot) const {
+    snapshot.x = x;
+    derived().snapshotCovariance(snapshot.covariance);
+  }
+
+  /**
+   * @brief Record the filter estimate
+   * @see snapshot(Snapshot&)
+   */
+  Snapshot snapshot() const {
+    Snapshot s;
+    snapshot(s);
+    return s;
+  }
+
+  /**
+   * @brief Roll the filter estimate back to a snapshot
+   * @param [in] snapshot The snapshot
+   */
+  void rollback(const Snapshot& snapshot) {
+    x = snapshot.x;
+    derived().rollbackCovariance(snapshot.covariance);
+  }
+
 protected:
 
   //! Estimated state
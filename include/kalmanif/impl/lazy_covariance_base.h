@@ -0,0 +1,253 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_LAZY_COVARIANCE_BASE_H_
+#define _KALMANIF_KALMANIF_IMPL_LAZY_COVARIANCE_BASE_H_
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief Base class for filters whose covariance propagation
+ * may be deferred until it is needed.
+ *
+ * In lazy mode (see setLazyPropagation), a propagation only accumulates
+ * the transition and the noise since the last materialized covariance
+ * \f$ P_0 \f$,
+ * \f$ \Phi_n = F_n \Phi_{n-1} \f$ and
+ * \f$ Q_n = F_n Q_{n-1} F_n^T + W_n Q W_n^T \f$.
+ * The covariance \f$ P = \Phi_n P_0 \Phi_n^T + Q_n \f$ is then
+ * computed on the next query (getCovariance) and applied
+ * on the next update.
+ *
+ * Querying the covariance does not end the accumulation,
+ * so that \f$ \Phi_n \f$ remains the transition since the last update.
+ *
+ * A change of parametrization of the covariance, e.g. of an invariant
+ * filter after an update by a model of the other invariance,
+ * may be deferred the same way, see deferReparametrization.
+ *
+ * @tparam StateType The state type
+ */
+template <typename StateType>
+struct LazyCovarianceBase : CovarianceBase<StateType> {
+
+  using Base = CovarianceBase<StateType>;
+
+  /**
+   * @brief The covariance recorded by a filter snapshot,
+   * with the pending propagations if any
+   */
+  struct CovarianceSnapshot : Base::CovarianceSnapshot {
+    Covariance<StateType> P0, Q;
+    Jacobian<StateType, StateType> Phi;
+    bool pending = false;
+    bool reparametrized = false;
+  };
+
+  /**
+   * @brief Enable or disable the lazy covariance propagation.
+   *
+   * @note Disabling it applies the pending propagations
+   * on the next propagation or update.
+   */
+  void setLazyPropagation(const bool lazy) {
+    lazy_ = lazy;
+  }
+
+  bool isLazyPropagation() const {
+    return lazy_;
+  }
+
+  /**
+   * @brief Get covariance
+   *
+   * @note The covariance of the pending propagations is only computed
+   * if they changed since the last call.
+   */
+  const Covariance<StateType>& getCovariance() const {
+    if (!pending_) {
+      return P;
+    }
+    if (!is_materialized_) {
+      P_ = internal::covarianceProduct(Phi_, P0_, Q_);
+      is_materialized_ = true;
+    }
+    return P_;
+  }
+
+  /**
+   * @brief Set the covariance, discarding the pending propagations.
+   * @param [in] covariance The input covariance
+   */
+  bool setCovariance(const Eigen::Ref<const Covariance<StateType>>& covariance) {
+    pending_ = false;
+    reparametrized_ = false;
+    return Base::setCovariance(covariance);
+  }
+
+  /**
+   * @brief Get covariance (as square root)
+   */
+  const CovarianceSquareRoot<StateType>& getCovarianceSquareRoot() const {
+    if (!is_sqrt_valid_) {
+      S_.compute(getCovariance());
+      is_sqrt_valid_ = true;
+    }
+    return S_;
+  }
+
+  /**
+   * @brief Set Covariance using Square Root,
+   * discarding the pending propagations.
+   */
+  bool setCovarianceSquareRoot(
+    const Covariance<StateType>& covariance_square_root
+  ) {
+    pending_ = false;
+    reparametrized_ = false;
+    return Base::setCovarianceSquareRoot(covariance_square_root);
+  }
+
+protected:
+
+  using Base::P;
+  using Base::S_;
+  using Base::is_sqrt_valid_;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(LazyCovarianceBase);
+
+  /**
+   * @brief Accumulate a propagation of the covariance.
+   *
+   * @tparam Sparsity The sparsity of the system model jacobian
+   * @param [in] F The system model jacobian
+   * @param [in] noise The system model noise jacobian and covariance,
+   * or their precomputed product
+   */
+  template <typename Sparsity, typename _DerivedF, typename... Noise>
+  void deferPropagation(
+    const Eigen::MatrixBase<_DerivedF>& F,
+    const Noise&... noise
+  ) {
+    if (reparametrized_) {
+      applyPropagation();
+    }
+
+    if (!pending_) {
+      P0_ = P;
+      Phi_.setIdentity();
+      Q_.setZero();
+      pending_ = true;
+    }
+
+    Phi_ = internal::sparseProduct<Sparsity>(F, Phi_);
+    Q_ = internal::sparseCovarianceProduct<Sparsity>(F, Q_, noise...);
+
+    is_materialized_ = false;
+    is_sqrt_valid_ = false;
+  }
+
+  /**
+   * @brief Apply the pending propagations to the covariance P.
+   * @return Whether there were pending propagations
+   */
+  bool applyPropagation() {
+    if (!pending_) {
+      return false;
+    }
+    P = getCovariance();
+    pending_ = false;
+    reparametrized_ = false;
+    return true;
+  }
+
+  /**
+   * @brief Defer a change of parametrization of the covariance,
+   * \f$ P = \Phi P_0 \Phi^T \f$, e.g. the adjoint map of an invariant
+   * filter, until the covariance is needed in the filter's parametrization.
+   *
+   * @param [in] P0 The covariance in the other parametrization
+   * @param [in] Phi The map to the filter's parametrization
+   *
+   * @see getHeldCovariance
+   */
+  template <typename _DerivedP, typename _DerivedPhi>
+  void deferReparametrization(
+    const Eigen::MatrixBase<_DerivedP>& P0,
+    const Eigen::MatrixBase<_DerivedPhi>& Phi
+  ) {
+    P0_ = P0;
+    Phi_ = Phi;
+    Q_.setZero();
+    pending_ = true;
+    reparametrized_ = true;
+
+    is_materialized_ = false;
+    is_sqrt_valid_ = false;
+  }
+
+  /**
+   * @brief Whether the covariance is held in the other parametrization,
+   * see deferReparametrization.
+   */
+  bool isReparametrized() const {
+    return reparametrized_;
+  }
+
+  /**
+   * @brief The covariance as it is held, P0 if reparametrized,
+   * P otherwise, without applying the pending propagations.
+   */
+  const Covariance<StateType>& getHeldCovariance() const {
+    return reparametrized_ ? P0_ : P;
+  }
+
+  void snapshotCovariance(CovarianceSnapshot& snapshot) const {
+    Base::snapshotCovariance(snapshot);
+    snapshot.pending = pending_;
+    snapshot.reparametrized = reparametrized_;
+    if (pending_) {
+      snapshot.P0 = P0_;
+      snapshot.Phi = Phi_;
+      snapshot.Q = Q_;
+    }
+  }
+
+  void rollbackCovariance(const CovarianceSnapshot& snapshot) {
+    Base::rollbackCovariance(snapshot);
+    pending_ = snapshot.pending;
+    reparametrized_ = snapshot.reparametrized;
+    if (pending_) {
+      P0_ = snapshot.P0;
+      Phi_ = snapshot.Phi;
+      Q_ = snapshot.Q;
+    }
+    is_materialized_ = false;
+  }
+
+  /**
+   * @brief Get the transition accumulated since
+   * the last materialized covariance.
+   */
+  const Jacobian<StateType, StateType>& getPendingTransition() const {
+    return Phi_;
+  }
+
+  bool lazy_ = false;
+  bool pending_ = false;
+  bool reparametrized_ = false;
+
+  //! The covariance the pending propagations start from
+  Covariance<StateType> P0_;
+
+  //! The pending transition and noise
+  Jacobian<StateType, StateType> Phi_;
+  Covariance<StateType> Q_;
+
+  //! The cached covariance of the pending propagations
+  mutable Covariance<StateType> P_;
+  mutable bool is_materialized_ = false;
+};
+
+} // internal
+} // kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_LAZY_COVARIANCE_BASE_H_
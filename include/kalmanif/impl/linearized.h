@@ -1,6 +1,8 @@
 #ifndef _KALMANIF_KALMANIF_IMPL_LINEARIZED_H_
 #define _KALMANIF_KALMANIF_IMPL_LINEARIZED_H_
 
+#include <iterator>
+
 namespace kalmanif {
 
 /**
@@ -30,13 +32,127 @@ public:
     return derived().run_linearized(std::forward<Args>(args)...);
   }
 
-  auto getCovariance() const {
+  decltype(auto) getCovariance() const {
     return derived().getCovariance();
   }
 
-  auto getCovarianceSquareRoot() const {
+  decltype(auto) getCovarianceSquareRoot() const {
     return derived().getCovarianceSquareRoot();
   }
+
+  /**
+   * @brief Get the precomputed noise W.Q.W^T
+   * @see internal::has_constant_noise_jacobian
+   */
+  template <typename... Args>
+  decltype(auto) getPropagatedNoise(Args&&... args) const {
+    return derived().getPropagatedNoise(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief The propagated state and the pose blocks of its jacobians
+   * @see internal::has_pose_block_jacobian
+   */
+  template <typename... Args>
+  auto run_linearized_pose(Args&&... args) const {
+    return derived().run_linearized_pose(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Propagate and linearize a state into x_new,
+   * x_new = f(x, u, F, W, args...).
+   *
+   * In place if the model evaluates in place,
+   * see internal::has_in_place_evaluation, by assignment otherwise.
+   *
+   * @param [in] x The state
+   * @param [in] u The control
+   * @param [out] x_new The propagated state, possibly x itself
+   * @param [out] F The state jacobian
+   * @param [out] W The control jacobian
+   * @param [in] args The other arguments of the model, e.g. dt
+   */
+  template <
+    typename State, typename Control,
+    typename StateJacobian, typename ControlJacobian, typename... Args
+  >
+  void into(
+    const State& x, const Control& u, State& x_new,
+    StateJacobian&& F, ControlJacobian&& W, Args&&... args
+  ) const {
+    if constexpr (internal::has_in_place_evaluation<Derived>{}) {
+      derived().run_linearized_into(
+        x, u, x_new, std::forward<StateJacobian>(F),
+        std::forward<ControlJacobian>(W), std::forward<Args>(args)...
+      );
+    } else {
+      x_new = derived().run_linearized(
+        x, u, std::forward<StateJacobian>(F),
+        std::forward<ControlJacobian>(W), std::forward<Args>(args)...
+      );
+    }
+  }
+
+  /**
+   * @brief The propagated state into x_new and the pose blocks
+   * of its jacobians, in place if the model evaluates in place.
+   * @see internal::has_pose_block_jacobian
+   * @see internal::has_in_place_evaluation
+   */
+  template <
+    typename State, typename Control,
+    typename StateJacobian, typename ControlJacobian, typename... Args
+  >
+  void pose_into(
+    const State& x, const Control& u, State& x_new,
+    StateJacobian&& F, ControlJacobian&& W, Args&&... args
+  ) const {
+    if constexpr (internal::has_in_place_evaluation<Derived>{}) {
+      derived().run_linearized_pose_into(
+        x, u, x_new, std::forward<StateJacobian>(F),
+        std::forward<ControlJacobian>(W), std::forward<Args>(args)...
+      );
+    } else {
+      x_new = derived().run_linearized_pose(
+        x, u, std::forward<StateJacobian>(F),
+        std::forward<ControlJacobian>(W), std::forward<Args>(args)...
+      );
+    }
+  }
+
+  /**
+   * @brief Propagate and linearize a batch of states,
+   * xs_new[j] = f(xs[j], us[j], Fs[j], Ws[j], args...).
+   *
+   * In a single run_linearized_batch call if the model linearizes batches,
+   * see internal::has_linearized_batch_evaluation,
+   * one state at a time otherwise.
+   *
+   * @param [in] xs A random access range of states
+   * @param [in] us A random access range of controls
+   * @param [out] xs_new The propagated states, its size being the batch size
+   * @param [out] Fs The state jacobians
+   * @param [out] Ws The control jacobians
+   * @param [in] args The other arguments of the model, e.g. dt
+   */
+  template <
+    typename States, typename Controls, typename NewStates,
+    typename StateJacobians, typename ControlJacobians, typename... Args
+  >
+  void batch(
+    const States& xs, const Controls& us, NewStates& xs_new,
+    StateJacobians& Fs, ControlJacobians& Ws, Args&&... args
+  ) const {
+    if constexpr (internal::has_linearized_batch_evaluation<Derived>{}) {
+      derived().run_linearized_batch(
+        xs, us, xs_new, Fs, Ws, std::forward<Args>(args)...
+      );
+    } else {
+      for (std::size_t j = 0; j < std::size(xs_new); ++j) {
+        xs_new[j] = derived().run_linearized(xs[j], us[j], Fs[j], Ws[j], args...);
+      }
+    }
+  }
 };
 
 /**
@@ -59,13 +175,36 @@ public:
     return derived().run_linearized(std::forward<Args>(args)...);
   }
 
-  auto getCovariance() const {
+  decltype(auto) getCovariance() const {
     return derived().getCovariance();
   }
 
-  auto getCovarianceSquareRoot() const {
+  decltype(auto) getCovarianceSquareRoot() const {
     return derived().getCovarianceSquareRoot();
   }
+
+  /**
+   * @brief The expected measurement and the pose block of its jacobian
+   * @see internal::has_pose_block_jacobian
+   */
+  template <typename... Args>
+  auto run_linearized_pose(Args&&... args) const {
+    return derived().run_linearized_pose(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief The expected measurement and the non-zero blocks of its jacobian
+   * @see internal::has_landmark_block_jacobian
+   */
+  template <typename... Args>
+  auto run_linearized_blocks(Args&&... args) const {
+    return derived().run_linearized_blocks(std::forward<Args>(args)...);
+  }
+
+  //! The first state column of the non-zero jacobian block
+  int getColumn() const {
+    return derived().getColumn();
+  }
 };
 
 } // namespace kalmanif
@@ -36,9 +36,63 @@ public:
     return derived().run_linearized_invariant(std::forward<Args>(args)...);
   }
 
-  auto getCovariance() const {
+  /**
+   * @brief The left invariant propagated state and jacobians
+   * @see internal::has_left_invariant_jacobian
+   */
+  template <typename... Args>
+  auto runLeftInvariant(Args&&... args) const {
+    return derived().template run_linearized_invariant<Invariance::Left>(
+      std::forward<Args>(args)...
+    );
+  }
+
+  /**
+   * @brief The right invariant propagated state into x_new and
+   * its jacobians, x_new = f(x, u, args...) with args the jacobians
+   * and dt, in place if the model evaluates in place.
+   * @see internal::has_in_place_evaluation
+   */
+  template <typename State, typename Control, typename... Args>
+  void into(
+    const State& x, const Control& u, State& x_new, Args&&... args
+  ) const {
+    if constexpr (internal::has_in_place_evaluation<Derived>{}) {
+      derived().run_linearized_invariant_into(
+        x, u, x_new, std::forward<Args>(args)...
+      );
+    } else {
+      x_new = derived().run_linearized_invariant(
+        x, u, std::forward<Args>(args)...
+      );
+    }
+  }
+
+  decltype(auto) getCovariance() const {
     return derived().getCovariance();
   }
+
+  decltype(auto) getCovarianceSquareRoot() const {
+    return derived().getCovarianceSquareRoot();
+  }
+
+  /**
+   * @brief Get the precomputed invariant noise W.Q.W^T
+   * @see internal::has_constant_invariant_noise_jacobian
+   */
+  template <typename... Args>
+  decltype(auto) getInvariantPropagatedNoise(Args&&... args) const {
+    return derived().getInvariantPropagatedNoise(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Get the state-independent invariant jacobian
+   * @see internal::has_state_independent_invariant_jacobian
+   */
+  template <typename... Args>
+  decltype(auto) getInvariantJacobian(Args&&... args) const {
+    return derived().getInvariantJacobian(std::forward<Args>(args)...);
+  }
 };
 
 /**
@@ -67,9 +121,13 @@ public:
     return derived().run_linearized_invariant(std::forward<Args>(args)...);
   }
 
-  auto getCovariance() const {
+  decltype(auto) getCovariance() const {
     return derived().getCovariance();
   }
+
+  decltype(auto) getCovarianceSquareRoot() const {
+    return derived().getCovarianceSquareRoot();
+  }
 };
 
 } // namespace kalmanif
@@ -0,0 +1,316 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_LOCK_FREE_H_
+#define _KALMANIF_KALMANIF_IMPL_LOCK_FREE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace kalmanif {
+namespace internal {
+
+//! The size assumed for a cache line, to avoid false sharing
+constexpr std::size_t CacheLineSize = 64;
+
+//! The smallest power of two greater or equal to n
+inline std::size_t nextPowerOfTwo(std::size_t n) {
+  std::size_t p = 1;
+  while (p < n) p <<= 1;
+  return p;
+}
+
+} // namespace internal
+
+/**
+ * @brief A bounded lock-free single-producer single-consumer queue.
+ *
+ * A ring buffer allocated once, the producer and the consumer
+ * each owning an index. Neither push nor pop ever blocks or allocates.
+ *
+ * @tparam T The element type, default constructible and assignable
+ */
+template <typename T>
+class SpscQueue {
+
+public:
+
+  /**
+   * @brief Construct a queue
+   * @param capacity The minimum number of elements the queue can hold,
+   * rounded up to a power of two.
+   */
+  explicit SpscQueue(const std::size_t capacity)
+    : buffer_(internal::nextPowerOfTwo(std::max<std::size_t>(capacity, 2)))
+    , mask_(buffer_.size() - 1) {}
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator =(const SpscQueue&) = delete;
+
+  /**
+   * @brief Push an element, from the producer thread only
+   * @return Whether it was pushed, false if the queue is full.
+   */
+  template <typename U>
+  bool push(U&& value) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == buffer_.size()) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == buffer_.size()) {
+        return false;
+      }
+    }
+    buffer_[tail & mask_] = std::forward<U>(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Get the next element, from the consumer thread only
+   * @return A pointer to the next element, nullptr if the queue is empty.
+   * It is valid until the next call to pop.
+   */
+  T* front() {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) {
+        return nullptr;
+      }
+    }
+    return &buffer_[head & mask_];
+  }
+
+  /**
+   * @brief Remove the next element, from the consumer thread only.
+   * The queue must not be empty, see front.
+   */
+  void pop() {
+    head_.store(
+      head_.load(std::memory_order_relaxed) + 1, std::memory_order_release
+    );
+  }
+
+  /**
+   * @brief Pop the next element into value, from the consumer thread only
+   * @return Whether an element was popped, false if the queue is empty.
+   */
+  bool pop(T& value) {
+    T* next = front();
+    if (next == nullptr) {
+      return false;
+    }
+    value = std::move(*next);
+    pop();
+    return true;
+  }
+
+  //! The number of elements the queue can hold
+  std::size_t capacity() const {
+    return buffer_.size();
+  }
+
+  //! An estimate of the number of elements, exact from the consumer thread
+  std::size_t size() const {
+    return tail_.load(std::memory_order_acquire) -
+      head_.load(std::memory_order_acquire);
+  }
+
+protected:
+
+  std::vector<T> buffer_;
+  const std::size_t mask_;
+
+  // the consumer index and its cache of the producer index
+  alignas(internal::CacheLineSize) std::atomic<std::size_t> head_{0};
+  std::size_t tail_cache_ = 0;
+
+  // the producer index and its cache of the consumer index
+  alignas(internal::CacheLineSize) std::atomic<std::size_t> tail_{0};
+  std::size_t head_cache_ = 0;
+};
+
+/**
+ * @brief A bounded lock-free multiple-producer single-consumer queue.
+ *
+ * A ring buffer allocated once whose cells carry a sequence number
+ * (D. Vyukov's bounded queue). The producers claim a cell
+ * with a compare-and-swap and publish it through its sequence number.
+ * Neither push nor pop ever blocks or allocates.
+ *
+ * @tparam T The element type, default constructible and assignable
+ */
+template <typename T>
+class MpscQueue {
+
+public:
+
+  /**
+   * @brief Construct a queue
+   * @param capacity The minimum number of elements the queue can hold,
+   * rounded up to a power of two.
+   */
+  explicit MpscQueue(const std::size_t capacity)
+    : cells_(internal::nextPowerOfTwo(std::max<std::size_t>(capacity, 2)))
+    , mask_(cells_.size() - 1) {
+    for (std::size_t i = 0; i < cells_.size(); ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator =(const MpscQueue&) = delete;
+
+  /**
+   * @brief Push an element, from any thread
+   * @return Whether it was pushed, false if the queue is full.
+   */
+  template <typename U>
+  bool push(U&& value) {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[tail & mask_];
+      const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = std::intptr_t(sequence) - std::intptr_t(tail);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(
+              tail, tail + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        tail = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::forward<U>(value);
+    cell->sequence.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Get the next element, from the consumer thread only
+   * @return A pointer to the next element, nullptr if the queue is empty.
+   * It is valid until the next call to pop.
+   */
+  T* front() {
+    Cell& cell = cells_[head_ & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) {
+      return nullptr;
+    }
+    return &cell.value;
+  }
+
+  /**
+   * @brief Remove the next element, from the consumer thread only.
+   * The queue must not be empty, see front.
+   */
+  void pop() {
+    cells_[head_ & mask_].sequence.store(
+      head_ + cells_.size(), std::memory_order_release
+    );
+    ++head_;
+  }
+
+  /**
+   * @brief Pop the next element into value, from the consumer thread only
+   * @return Whether an element was popped, false if the queue is empty.
+   */
+  bool pop(T& value) {
+    T* next = front();
+    if (next == nullptr) {
+      return false;
+    }
+    value = std::move(*next);
+    pop();
+    return true;
+  }
+
+  //! The number of elements the queue can hold
+  std::size_t capacity() const {
+    return cells_.size();
+  }
+
+protected:
+
+  struct Cell {
+    std::atomic<std::size_t> sequence{0};
+    T value;
+  };
+
+  std::vector<Cell> cells_;
+  const std::size_t mask_;
+
+  alignas(internal::CacheLineSize) std::atomic<std::size_t> tail_{0};
+  alignas(internal::CacheLineSize) std::size_t head_ = 0;
+};
+
+/**
+ * @brief A sequence lock publishing a value from a single writer
+ * to any number of readers.
+ *
+ * The writer never waits, the readers never block the writer:
+ * they retry their copy if it was overwritten in the meantime.
+ *
+ * @tparam T The value type, trivially copyable
+ */
+template <typename T>
+class SeqLock {
+
+  static_assert(
+    std::is_trivially_copyable<T>::value,
+    "SeqLock: The value must be trivially copyable!"
+  );
+
+public:
+
+  SeqLock() = default;
+
+  explicit SeqLock(const T& value) : value_(value) {}
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator =(const SeqLock&) = delete;
+
+  /**
+   * @brief Publish a value, from the writer thread only
+   */
+  void store(const T& value) {
+    const std::size_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    value_ = value;
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief Get the last published value, from any thread
+   */
+  T load() const {
+    T value;
+    std::size_t before, after;
+    do {
+      before = sequence_.load(std::memory_order_acquire);
+      value = value_;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence_.load(std::memory_order_relaxed);
+    } while (before != after || (before & 1));
+    return value;
+  }
+
+  //! The number of values published
+  std::size_t version() const {
+    return sequence_.load(std::memory_order_acquire) / 2;
+  }
+
+protected:
+
+  alignas(internal::CacheLineSize) std::atomic<std::size_t> sequence_{0};
+  T value_{};
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_LOCK_FREE_H_
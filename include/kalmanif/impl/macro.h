@@ -19,8 +19,98 @@ struct invalid_argument : std::invalid_argument {
   using std::invalid_argument::what;
 };
 
+/**
+ * @brief Enum for the error codes of the real-time mode,
+ * mirroring the exceptions thrown otherwise.
+ *
+ * @see KALMANIF_REALTIME, getLastError
+ */
+enum class ErrorCode : char {
+  None = 0,       // No error
+  RuntimeError,   // A kalmanif::runtime_error would have been thrown
+  InvalidArgument // A kalmanif::invalid_argument would have been thrown
+};
+
+/**
+ * @brief The first error recorded in real-time mode.
+ */
+struct Error {
+  ErrorCode code = ErrorCode::None;
+  //! The message of the failed check, a string literal
+  const char* what = "";
+
+  explicit operator bool() const noexcept {
+    return code != ErrorCode::None;
+  }
+};
+
 namespace detail {
 
+template <typename E>
+struct error_code {
+  static constexpr ErrorCode value = ErrorCode::RuntimeError;
+};
+
+template <>
+struct error_code<kalmanif::invalid_argument> {
+  static constexpr ErrorCode value = ErrorCode::InvalidArgument;
+};
+
+inline Error& lastError() noexcept {
+  static thread_local Error error;
+  return error;
+}
+
+inline const char* message(const char* what) noexcept {
+  return what;
+}
+
+// Composed messages are not kept, they would have to be allocated
+template <typename T>
+const char* message(const T&) noexcept {
+  return "kalmanif: check failed!";
+}
+
+// Throws whatever the mode, see KALMANIF_ENSURE
+template <typename E, typename... Args>
+void
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__(( noinline, cold, noreturn ))
+#elif defined(_MSC_VER)
+__declspec( noinline, noreturn )
+#else
+// nothing
+#endif
+raise_always(Args&&... args) {
+  throw E(std::forward<Args>(args)...);
+}
+
+#ifdef KALMANIF_REALTIME
+
+constexpr bool realtime = true;
+
+template <typename E, typename Arg>
+void
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__(( noinline, cold ))
+#elif defined(_MSC_VER)
+__declspec( noinline )
+#else
+// nothing
+#endif
+raise(const Arg& arg) noexcept {
+  // Later errors are often consequences of the first one
+  Error& error = lastError();
+  if (!error) {
+    error.code = error_code<E>::value;
+    error.what = message(arg);
+  }
+}
+
+#else
+
+constexpr bool realtime = false;
+
 template <typename E, typename... Args>
 void
 #if defined(__GNUC__) || defined(__clang__)
@@ -34,9 +124,36 @@ raise(Args&&... args) {
   throw E(std::forward<Args>(args)...);
 }
 
+#endif // KALMANIF_REALTIME
+
 template<typename T> void ignore_unused_variable(const T&) {}
 
 } // namespace detail
+
+/**
+ * @brief Get the first error recorded by the calling thread
+ * since the last call to clearLastError.
+ *
+ * In real-time mode (see KALMANIF_REALTIME) the failed checks
+ * record an error code instead of throwing, and the step proceeds,
+ * or returns early where proceeding would access memory out of bounds.
+ * The caller is expected to check it after each step,
+ * and e.g. reset the filter.
+ * The checks of KALMANIF_ENSURE, outside of the filter steps,
+ * throw in either mode.
+ * Otherwise, no error is ever recorded.
+ */
+inline const Error& getLastError() noexcept {
+  return detail::lastError();
+}
+
+/**
+ * @brief Clear the error recorded by the calling thread.
+ */
+inline void clearLastError() noexcept {
+  detail::lastError() = Error();
+}
+
 } // namespace kalmanif
 
 #define KALMANIF_UNUSED_VARIABLE(x) kalmanif::detail::ignore_unused_variable(x)
@@ -86,6 +203,27 @@ template<typename T> void ignore_unused_variable(const T&) {}
                         __KALMANIF_CHECK_MSG,           \
                         __KALMANIF_CHECK)(__VA_ARGS__) )
 
+// Unlike KALMANIF_CHECK, throws even in real-time mode.
+// For the APIs outside of the filter steps that cannot proceed
+// once a check failed, e.g. the file I/O or the thread management.
+#define __KALMANIF_ENSURE_MSG_EXCEPT(cond, msg, except) \
+ if (!(cond)) {kalmanif::detail::raise_always<except>(msg);}
+
+#define __KALMANIF_ENSURE_MSG(cond, msg) \
+ __KALMANIF_ENSURE_MSG_EXCEPT(cond, msg, kalmanif::runtime_error)
+
+#define __KALMANIF_ENSURE(cond)                                   \
+ __KALMANIF_ENSURE_MSG_EXCEPT(                                    \
+   cond, "Condition: '"#cond"' failed!", kalmanif::runtime_error  \
+ )
+
+#define KALMANIF_ENSURE(...)                            \
+ __KALMANIF_EXPAND(                                     \
+ __KALMANIF_GET_MACRO_3(__VA_ARGS__,                    \
+                        __KALMANIF_ENSURE_MSG_EXCEPT,   \
+                        __KALMANIF_ENSURE_MSG,          \
+                        __KALMANIF_ENSURE)(__VA_ARGS__) )
+
 // Assertions cost run time and can be turned off.
 // You can suppress KALMANIF_ASSERT by defining
 // KALMANIF_NO_DEBUG before including manif headers.
@@ -101,6 +239,60 @@ template<typename T> void ignore_unused_variable(const T&) {}
   #define KALMANIF_ASSERT(...) ((void)0)
 #endif
 
+// Defining KALMANIF_REALTIME before including kalmanif headers
+// bounds the execution time of the filter steps for hard real-time use:
+// - the failed checks record an error code rather than throwing,
+//   see kalmanif::getLastError,
+// - the iterative loops are capped, see KALMANIF_REALTIME_MAX_ITERATIONS,
+// - the filters do not allocate, their innovation storage is bounded,
+//   see KALMANIF_MAX_INNOVATION_SIZE,
+// - the filter steps are noexcept, see KALMANIF_NOEXCEPT.
+// Together with EIGEN_RUNTIME_NO_MALLOC, an Eigen allocation
+// within a filter step asserts.
+#ifdef KALMANIF_REALTIME
+  #define KALMANIF_NOEXCEPT noexcept
+#else
+  #define KALMANIF_NOEXCEPT
+#endif
+
+// In real-time mode, the maximum number of iterations of any loop
+// of a filter step, e.g. eigenvalue clamping or iterated update.
+#ifndef KALMANIF_REALTIME_MAX_ITERATIONS
+  #define KALMANIF_REALTIME_MAX_ITERATIONS 10
+#endif
+
+// The maximum number of measurements stacked in a single update
+// when their number is only known at run time.
+// Larger ranges are processed in successive stacks of this size.
+#ifndef KALMANIF_MAX_STACKED_MEASUREMENTS
+  #define KALMANIF_MAX_STACKED_MEASUREMENTS 16
+  // Defaulted, see kalmanif/impl/instantiations.h
+  #define KALMANIF_DEFAULT_MAX_STACKED_MEASUREMENTS
+#endif
+
+// The maximum size of the innovation stored by the filters.
+// Unbounded by default, the storage is then reallocated when
+// the measurement size changes. In real-time mode, it is bounded
+// by default to stacks of KALMANIF_MAX_STACKED_MEASUREMENTS 3D measurements
+// and never allocates.
+#ifndef KALMANIF_MAX_INNOVATION_SIZE
+  // Defaulted, see kalmanif/impl/instantiations.h
+  #define KALMANIF_DEFAULT_MAX_INNOVATION_SIZE
+  #ifdef KALMANIF_REALTIME
+    #define KALMANIF_MAX_INNOVATION_SIZE (3 * KALMANIF_MAX_STACKED_MEASUREMENTS)
+  #else
+    #define KALMANIF_MAX_INNOVATION_SIZE Eigen::Dynamic
+  #endif
+#endif
+
+// Whether the awaitable propagate/update (C++20 coroutines) are available.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L \
+  && __has_include(<coroutine>)
+  #define KALMANIF_HAS_COROUTINES 1
+#else
+  #define KALMANIF_HAS_COROUTINES 0
+#endif
+
 // Common macros
 
 #define KALMANIF_MAKE_ALIGNED_OPERATOR_NEW_COND                       \
@@ -47,6 +47,8 @@ template <typename LieGroup>
 struct traits<LieGroup, enable_if_is_manif_lie_group<LieGroup>> {
   using Scalar = typename LieGroup::Scalar;
   static constexpr auto Size = LieGroup::DoF;
+  // e.g. SO2, SE2 and SO3
+  static constexpr bool ClosedFormKernels = LieGroup::DoF <= 3;
 };
 
 } // namespace internal
@@ -0,0 +1,179 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_MAPPED_CHECKPOINT_H_
+#define _KALMANIF_KALMANIF_IMPL_MAPPED_CHECKPOINT_H_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kalmanif {
+
+/**
+ * @brief Write the checkpoint of a filter (or smoother) to a file.
+ *
+ * The checkpoint is written to a temporary file renamed over path
+ * once complete, so that a concurrent MappedCheckpoint never sees
+ * a partially written checkpoint.
+ *
+ * @param path The file path, created or replaced.
+ * @param filter The filter
+ * @param sync Whether to flush the file to the storage device
+ * before it replaces path.
+ */
+template <typename Filter>
+void writeCheckpoint(
+  const std::string& path, const Filter& filter, const bool sync = false
+) {
+  const std::vector<std::uint8_t> buffer = saveCheckpoint(filter);
+
+  const std::string tmp = path + ".tmp";
+  const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  KALMANIF_ENSURE(
+    fd >= 0,
+    "writeCheckpoint: cannot open '" + tmp + "': " + std::strerror(errno)
+  );
+
+  const std::uint8_t* data = buffer.data();
+  std::size_t bytes = buffer.size();
+  while (bytes > 0) {
+    const ssize_t written = ::write(fd, data, bytes);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      const int error = errno;
+      ::close(fd);
+      KALMANIF_THROW(
+        "writeCheckpoint: cannot write '" + tmp + "': " + std::strerror(error)
+      );
+    }
+    data += written;
+    bytes -= std::size_t(written);
+  }
+
+  const bool synced = !sync || ::fsync(fd) == 0;
+  ::close(fd);
+  KALMANIF_ENSURE(
+    synced,
+    "writeCheckpoint: cannot sync '" + tmp + "': " + std::strerror(errno)
+  );
+  KALMANIF_ENSURE(
+    std::rename(tmp.c_str(), path.c_str()) == 0,
+    "writeCheckpoint: cannot rename '" + tmp + "': " + std::strerror(errno)
+  );
+}
+
+/**
+ * @brief A memory-mapped checkpoint file.
+ *
+ * The checkpoint is validated on construction and the filter
+ * is restored directly from the mapped pages, without an intermediate
+ * copy, e.g. to warm start a standby filter.
+ *
+ * @tparam Filter The filter (or smoother) type
+ *
+ * @see writeCheckpoint
+ */
+template <typename Filter>
+class MappedCheckpoint {
+
+public:
+
+  /**
+   * @brief Map the checkpoint file at path
+   * @param path The file path
+   * @throw kalmanif::runtime_error if the file cannot be read
+   * @throw kalmanif::invalid_argument if the file is not
+   * a checkpoint of a Filter
+   */
+  explicit MappedCheckpoint(std::string path) : path_(std::move(path)) {
+    const int fd = ::open(path_.c_str(), O_RDONLY);
+    KALMANIF_ENSURE(
+      fd >= 0,
+      "MappedCheckpoint: cannot open '" + path_ + "': " + std::strerror(errno)
+    );
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+      ::close(fd);
+      KALMANIF_THROW("MappedCheckpoint: '" + path_ + "' is empty!");
+    }
+
+    mapped_bytes_ = std::size_t(st.st_size);
+    void* data = ::mmap(nullptr, mapped_bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping outlives the descriptor
+    ::close(fd);
+    KALMANIF_ENSURE(
+      data != MAP_FAILED,
+      "MappedCheckpoint: cannot map '" + path_ + "': " + std::strerror(errno)
+    );
+    data_ = static_cast<const std::uint8_t*>(data);
+
+    try {
+      view();
+    } catch (...) {
+      unmap();
+      throw;
+    }
+  }
+
+  MappedCheckpoint(const MappedCheckpoint&) = delete;
+  MappedCheckpoint& operator =(const MappedCheckpoint&) = delete;
+
+  MappedCheckpoint(MappedCheckpoint&& other) noexcept {
+    swap(other);
+  }
+
+  MappedCheckpoint& operator =(MappedCheckpoint&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~MappedCheckpoint() {
+    unmap();
+  }
+
+  //! A view of the mapped checkpoint
+  CheckpointView<Filter> view() const {
+    return CheckpointView<Filter>(data_, mapped_bytes_);
+  }
+
+  /**
+   * @brief Restore a filter from the mapped checkpoint
+   */
+  void restore(Filter& filter) const {
+    view().restore(filter);
+  }
+
+  const std::string& path() const { return path_; }
+
+protected:
+
+  void unmap() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<std::uint8_t*>(data_), mapped_bytes_);
+      data_ = nullptr;
+    }
+  }
+
+  void swap(MappedCheckpoint& other) noexcept {
+    std::swap(path_, other.path_);
+    std::swap(data_, other.data_);
+    std::swap(mapped_bytes_, other.mapped_bytes_);
+  }
+
+  std::string path_;
+  const std::uint8_t* data_ = nullptr;
+  std::size_t mapped_bytes_ = 0;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_MAPPED_CHECKPOINT_H_
@@ -0,0 +1,217 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_MAPPED_FILE_STORAGE_H_
+#define _KALMANIF_KALMANIF_IMPL_MAPPED_FILE_STORAGE_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace kalmanif {
+
+/**
+ * @brief A contiguous container of fixed-size records
+ * backed by a memory-mapped file.
+ *
+ * The records are stored in the file in their in-memory binary layout
+ * and paged in and out by the operating system, so that the container
+ * may grow well beyond the available RAM.
+ * It provides the subset of the std::vector interface used by the smoothers.
+ *
+ * @note T must be relocatable with memcpy and own no external resource,
+ * e.g. fixed-size Eigen matrices, manif groups and aggregates thereof.
+ *
+ * @tparam T The record type
+ */
+template <typename T>
+class MappedVector {
+
+public:
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  /**
+   * @brief Construct an empty container mapping the file at path.
+   * @param path The file path, created or truncated.
+   * @param keep_file Whether to keep the file once the container is destroyed.
+   */
+  explicit MappedVector(std::string path, const bool keep_file = false)
+    : path_(std::move(path)), keep_file_(keep_file) {
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    KALMANIF_ENSURE(
+      fd_ >= 0,
+      "MappedVector: cannot open '" + path_ + "': " + std::strerror(errno)
+    );
+  }
+
+  MappedVector(const MappedVector&) = delete;
+  MappedVector& operator =(const MappedVector&) = delete;
+
+  MappedVector(MappedVector&& other) noexcept {
+    swap(other);
+  }
+
+  MappedVector& operator =(MappedVector&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~MappedVector() {
+    clear();
+    if (data_ != nullptr) {
+      ::munmap(data_, capacity_ * sizeof(T));
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      if (!keep_file_) {
+        ::unlink(path_.c_str());
+      }
+    }
+  }
+
+  /**
+   * @brief Grow the file and its mapping to hold at least n records.
+   */
+  void reserve(const size_type n) {
+    if (n <= capacity_) {
+      return;
+    }
+
+    if (data_ != nullptr) {
+      KALMANIF_ENSURE(
+        ::msync(data_, size_ * sizeof(T), MS_ASYNC) == 0,
+        "MappedVector: msync failed: " + std::string(std::strerror(errno))
+      );
+      ::munmap(data_, capacity_ * sizeof(T));
+      data_ = nullptr;
+    }
+
+    KALMANIF_ENSURE(
+      ::ftruncate(fd_, off_t(n * sizeof(T))) == 0,
+      "MappedVector: cannot grow '" + path_ + "': " + std::strerror(errno)
+    );
+
+    void* data = ::mmap(
+      nullptr, n * sizeof(T), PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0
+    );
+    KALMANIF_ENSURE(
+      data != MAP_FAILED,
+      "MappedVector: cannot map '" + path_ + "': " + std::strerror(errno)
+    );
+
+    data_ = static_cast<T*>(data);
+    capacity_ = n;
+  }
+
+  void resize(const size_type n) {
+    if (n > capacity_) {
+      reserve(std::max(n, 2 * capacity_));
+    }
+    for (size_type i = size_; i < n; ++i) {
+      new (data_ + i) T();
+    }
+    for (size_type i = n; i < size_; ++i) {
+      data_[i].~T();
+    }
+    size_ = n;
+  }
+
+  T& emplace_back() {
+    if (size_ == capacity_) {
+      reserve(std::max(size_type(MinCapacity), 2 * capacity_));
+    }
+    new (data_ + size_) T();
+    return data_[size_++];
+  }
+
+  void clear() {
+    resize(0);
+  }
+
+  T& operator [](const size_type i) { return data_[i]; }
+  const T& operator [](const size_type i) const { return data_[i]; }
+
+  T& back() { return data_[size_ - 1]; }
+  const T& back() const { return data_[size_ - 1]; }
+
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+
+  iterator begin() { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+
+  size_type size() const { return size_; }
+  size_type capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+
+  const std::string& path() const { return path_; }
+
+protected:
+
+  //! The minimum number of records mapped at once
+  static constexpr size_type MinCapacity = 1024;
+
+  void swap(MappedVector& other) noexcept {
+    std::swap(path_, other.path_);
+    std::swap(keep_file_, other.keep_file_);
+    std::swap(fd_, other.fd_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  std::string path_;
+  bool keep_file_ = false;
+  int fd_ = -1;
+  T* data_ = nullptr;
+  size_type size_ = 0;
+  size_type capacity_ = 0;
+};
+
+/**
+ * @brief A smoother storage policy spilling the epochs
+ * and the smoothed sequence to memory-mapped files.
+ *
+ * For a file prefix 'run', the epochs are stored in 'run.epochs',
+ * the smoothed states in 'run.states' and
+ * the smoothed covariances in 'run.covariances'.
+ *
+ * @see InMemoryStorage
+ * @see RauchTungStriebelSmoother
+ */
+struct MappedFileStorage {
+
+  template <typename T>
+  using container = MappedVector<T>;
+
+  /**
+   * @brief Construct a mapped file storage policy
+   * @param prefix The prefix of the files paths
+   * @param keep_files Whether to keep the files once the smoother is destroyed.
+   */
+  explicit MappedFileStorage(std::string prefix, const bool keep_files = false)
+    : prefix_(std::move(prefix)), keep_files_(keep_files) {}
+
+  template <typename T>
+  container<T> make(const char* name) const {
+    return container<T>(prefix_ + "." + name, keep_files_);
+  }
+
+protected:
+
+  std::string prefix_;
+  bool keep_files_ = false;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_MAPPED_FILE_STORAGE_H_
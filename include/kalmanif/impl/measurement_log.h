@@ -0,0 +1,430 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_MEASUREMENT_LOG_H_
+#define _KALMANIF_KALMANIF_IMPL_MEASUREMENT_LOG_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kalmanif {
+
+/**
+ * @brief The header of a measurement log file.
+ *
+ * A measurement log is this header followed by fixed-size records,
+ * each one the time stamp (a double), the index of the stream
+ * the input belongs to and its number of coefficients (two uint32),
+ * then the coefficients of the input (a control or a measurement)
+ * padded to payload_size scalars, in the host byte order.
+ *
+ * @see MeasurementLogWriter
+ */
+struct MeasurementLogHeader {
+
+  char magic[8];
+  std::uint32_t version;
+  //! The size in bytes of a scalar
+  std::uint32_t scalar_size;
+  //! The maximum number of coefficients of an input
+  std::uint32_t payload_size;
+  std::uint32_t padding;
+  //! The size in bytes of a record
+  std::uint64_t record_size;
+  char reserved[32];
+};
+
+static_assert(
+  sizeof(MeasurementLogHeader) == 64, "Unexpected MeasurementLogHeader padding!"
+);
+
+namespace internal {
+
+template <typename Scalar>
+MeasurementLogHeader makeMeasurementLogHeader(const std::size_t payload_size) {
+  MeasurementLogHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, "KALMANIN", sizeof(header.magic));
+  header.version = 1;
+  header.scalar_size = sizeof(Scalar);
+  header.payload_size = std::uint32_t(payload_size);
+  header.record_size =
+    sizeof(double) + 2 * sizeof(std::uint32_t) + payload_size * sizeof(Scalar);
+  return header;
+}
+
+//! The coefficients of an input, an Eigen vector or a manif tangent
+template <typename T>
+decltype(auto) inputCoeffs(const T& input) {
+  if constexpr (is_eigen_matrix<T>::value) {
+    return input;
+  } else {
+    return input.coeffs();
+  }
+}
+
+} // namespace internal
+
+/**
+ * @brief A streaming writer of the inputs of a filter,
+ * e.g. to record a run and replay it offline.
+ *
+ * Each record is appended to a small buffer of fixed capacity,
+ * written to the file once full or on flush,
+ * so that the memory used does not grow with the log length.
+ * The inputs are expected in time order.
+ *
+ * @tparam _Scalar The scalar type of the inputs
+ *
+ * @see MeasurementLogReader
+ * @see ReplayEngine
+ */
+template <typename _Scalar>
+class MeasurementLogWriter {
+
+public:
+
+  using Scalar = _Scalar;
+
+  /**
+   * @brief Construct a writer to the file at path
+   * @param path The file path, created or truncated.
+   * @param payload_size The maximum number of coefficients of an input.
+   * @param buffered_records The number of records buffered
+   * before they are written to the file.
+   */
+  MeasurementLogWriter(
+    std::string path,
+    const std::size_t payload_size,
+    const std::size_t buffered_records = 64
+  ) : path_(std::move(path))
+    , header_(internal::makeMeasurementLogHeader<Scalar>(payload_size))
+    , buffer_(std::max<std::size_t>(buffered_records, 1) * header_.record_size) {
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    KALMANIF_ENSURE(
+      fd_ >= 0,
+      "MeasurementLogWriter: cannot open '" + path_ + "': " + std::strerror(errno)
+    );
+
+    writeAll(reinterpret_cast<const std::uint8_t*>(&header_), sizeof(header_));
+  }
+
+  MeasurementLogWriter(const MeasurementLogWriter&) = delete;
+  MeasurementLogWriter& operator =(const MeasurementLogWriter&) = delete;
+
+  MeasurementLogWriter(MeasurementLogWriter&& other) noexcept {
+    swap(other);
+  }
+
+  MeasurementLogWriter& operator =(MeasurementLogWriter&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~MeasurementLogWriter() {
+    if (fd_ < 0) {
+      return;
+    }
+    try {
+      flush();
+    } catch (...) {
+      // nothing to do about it here
+    }
+    ::close(fd_);
+  }
+
+  /**
+   * @brief Append an input
+   * @param t The time stamp
+   * @param stream The index of the stream of the input
+   * @param input The input, an Eigen vector or a manif tangent
+   * @throw kalmanif::invalid_argument if the input is larger
+   * than the payload size
+   */
+  template <typename Input>
+  void write(const double t, const std::uint32_t stream, const Input& input) {
+    const auto& coeffs = internal::inputCoeffs(input);
+    const std::uint32_t size = std::uint32_t(coeffs.size());
+
+    KALMANIF_ENSURE(
+      size <= header_.payload_size,
+      "MeasurementLogWriter: The input exceeds the payload size!",
+      kalmanif::invalid_argument
+    );
+
+    if (buffered_ == buffer_.size()) {
+      flush();
+    }
+
+    std::uint8_t* record = buffer_.data() + buffered_;
+    std::memset(record, 0, header_.record_size);
+    std::memcpy(record, &t, sizeof(double));
+    std::memcpy(record + sizeof(double), &stream, sizeof(std::uint32_t));
+    std::memcpy(
+      record + sizeof(double) + sizeof(std::uint32_t),
+      &size, sizeof(std::uint32_t)
+    );
+    Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, 1>>(
+      reinterpret_cast<Scalar*>(
+        record + sizeof(double) + 2 * sizeof(std::uint32_t)
+      ), Eigen::Index(size)
+    ) = coeffs.template cast<Scalar>();
+
+    buffered_ += header_.record_size;
+    ++size_;
+  }
+
+  /**
+   * @brief Write the buffered records to the file.
+   */
+  void flush() {
+    writeAll(buffer_.data(), buffered_);
+    buffered_ = 0;
+  }
+
+  //! The number of records written, including the buffered ones
+  std::size_t size() const { return size_; }
+
+  const std::string& path() const { return path_; }
+
+protected:
+
+  void writeAll(const std::uint8_t* data, std::size_t bytes) {
+    while (bytes > 0) {
+      const ssize_t written = ::write(fd_, data, bytes);
+      if (written < 0 && errno == EINTR) {
+        continue;
+      }
+      KALMANIF_ENSURE(
+        written > 0,
+        "MeasurementLogWriter: cannot write '" + path_ + "': " + std::strerror(errno)
+      );
+      data += written;
+      bytes -= std::size_t(written);
+    }
+  }
+
+  void swap(MeasurementLogWriter& other) noexcept {
+    std::swap(path_, other.path_);
+    std::swap(header_, other.header_);
+    std::swap(fd_, other.fd_);
+    std::swap(buffer_, other.buffer_);
+    std::swap(buffered_, other.buffered_);
+    std::swap(size_, other.size_);
+  }
+
+  std::string path_;
+  MeasurementLogHeader header_;
+  int fd_ = -1;
+  std::vector<std::uint8_t> buffer_;
+  std::size_t buffered_ = 0;
+  std::size_t size_ = 0;
+};
+
+/**
+ * @brief A memory-mapped reader of a measurement log.
+ *
+ * The records are decoded on access and paged in by the operating
+ * system, so that long logs are replayed without being loaded.
+ *
+ * @tparam _Scalar The scalar type of the inputs
+ *
+ * @see MeasurementLogWriter
+ */
+template <typename _Scalar>
+class MeasurementLogReader {
+
+public:
+
+  using Scalar = _Scalar;
+  using Payload = Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>>;
+
+  /**
+   * @brief Construct a reader of the file at path
+   * @param path The file path
+   * @throw kalmanif::runtime_error if the file cannot be read
+   * or was not written for Scalar.
+   */
+  explicit MeasurementLogReader(std::string path) : path_(std::move(path)) {
+    fd_ = ::open(path_.c_str(), O_RDONLY);
+    KALMANIF_ENSURE(
+      fd_ >= 0,
+      "MeasurementLogReader: cannot open '" + path_ + "': " + std::strerror(errno)
+    );
+
+    KALMANIF_ENSURE(
+      ::pread(fd_, &header_, sizeof(header_), 0) == ssize_t(sizeof(header_)),
+      "MeasurementLogReader: '" + path_ + "' has no header!"
+    );
+
+    const MeasurementLogHeader expected =
+      internal::makeMeasurementLogHeader<Scalar>(header_.payload_size);
+    KALMANIF_ENSURE(
+      std::memcmp(header_.magic, expected.magic, sizeof(header_.magic)) == 0 &&
+      header_.version == expected.version,
+      "MeasurementLogReader: '" + path_ + "' is not a measurement log!"
+    );
+    KALMANIF_ENSURE(
+      header_.scalar_size == expected.scalar_size &&
+      header_.record_size == expected.record_size,
+      "MeasurementLogReader: '" + path_ + "' was not written for this scalar type!"
+    );
+
+    refresh();
+  }
+
+  MeasurementLogReader(const MeasurementLogReader&) = delete;
+  MeasurementLogReader& operator =(const MeasurementLogReader&) = delete;
+
+  MeasurementLogReader(MeasurementLogReader&& other) noexcept {
+    swap(other);
+  }
+
+  MeasurementLogReader& operator =(MeasurementLogReader&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~MeasurementLogReader() {
+    unmap();
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  /**
+   * @brief Map the records appended since the last refresh.
+   *
+   * A partially written trailing record is ignored.
+   *
+   * @return The number of records
+   */
+  std::size_t refresh() {
+    struct stat st;
+    KALMANIF_ENSURE(
+      ::fstat(fd_, &st) == 0,
+      "MeasurementLogReader: cannot stat '" + path_ + "': " + std::strerror(errno)
+    );
+
+    const std::size_t size =
+      (std::size_t(st.st_size) - sizeof(MeasurementLogHeader)) /
+      header_.record_size;
+
+    if (size == size_) {
+      return size_;
+    }
+
+    unmap();
+
+    mapped_bytes_ = sizeof(MeasurementLogHeader) + size * header_.record_size;
+    void* data = ::mmap(
+      nullptr, mapped_bytes_, PROT_READ, MAP_SHARED, fd_, 0
+    );
+    KALMANIF_ENSURE(
+      data != MAP_FAILED,
+      "MeasurementLogReader: cannot map '" + path_ + "': " + std::strerror(errno)
+    );
+
+    data_ = static_cast<const std::uint8_t*>(data);
+    size_ = size;
+
+    return size_;
+  }
+
+  //! The time stamp of the ith record
+  double time(const std::size_t i) const {
+    double t;
+    std::memcpy(&t, record(i), sizeof(double));
+    return t;
+  }
+
+  //! The stream index of the ith record
+  std::uint32_t stream(const std::size_t i) const {
+    std::uint32_t s;
+    std::memcpy(&s, record(i) + sizeof(double), sizeof(std::uint32_t));
+    return s;
+  }
+
+  //! The coefficients of the input of the ith record, mapped
+  Payload payload(const std::size_t i) const {
+    std::uint32_t n;
+    std::memcpy(
+      &n, record(i) + sizeof(double) + sizeof(std::uint32_t),
+      sizeof(std::uint32_t)
+    );
+    return Payload(
+      reinterpret_cast<const Scalar*>(
+        record(i) + sizeof(double) + 2 * sizeof(std::uint32_t)
+      ), Eigen::Index(n)
+    );
+  }
+
+  /**
+   * @brief The input of the ith record
+   * @tparam Input The input type, an Eigen vector or a manif tangent
+   * @throw kalmanif::runtime_error if the record size does not match
+   */
+  template <typename Input>
+  Input input(const std::size_t i) const {
+    const Payload coeffs = payload(i);
+    KALMANIF_ENSURE(
+      coeffs.size() == internal::traits<Input>::Size,
+      "MeasurementLogReader: The record does not hold this input type!"
+    );
+
+    Input u;
+    if constexpr (internal::is_eigen_matrix<Input>::value) {
+      u = coeffs.template cast<typename Input::Scalar>();
+    } else {
+      u.coeffs() = coeffs.template cast<typename Input::Scalar>();
+    }
+    return u;
+  }
+
+  //! The maximum number of coefficients of an input
+  std::size_t payloadSize() const { return header_.payload_size; }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const std::string& path() const { return path_; }
+
+protected:
+
+  const std::uint8_t* record(const std::size_t i) const {
+    return data_ + sizeof(MeasurementLogHeader) + i * header_.record_size;
+  }
+
+  void unmap() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<std::uint8_t*>(data_), mapped_bytes_);
+      data_ = nullptr;
+    }
+  }
+
+  void swap(MeasurementLogReader& other) noexcept {
+    std::swap(path_, other.path_);
+    std::swap(header_, other.header_);
+    std::swap(fd_, other.fd_);
+    std::swap(data_, other.data_);
+    std::swap(mapped_bytes_, other.mapped_bytes_);
+    std::swap(size_, other.size_);
+  }
+
+  std::string path_;
+  MeasurementLogHeader header_;
+  int fd_ = -1;
+  const std::uint8_t* data_ = nullptr;
+  std::size_t mapped_bytes_ = 0;
+  std::size_t size_ = 0;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_MEASUREMENT_LOG_H_
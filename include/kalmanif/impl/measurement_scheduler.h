@@ -0,0 +1,437 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_MEASUREMENT_SCHEDULER_H_
+#define _KALMANIF_KALMANIF_IMPL_MEASUREMENT_SCHEDULER_H_
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief Whether the filter implements the stacked update
+ * of a range of measurements.
+ */
+template <typename>
+struct has_stacked_update : std::true_type {};
+
+template <typename T, Invariance Iv, typename Executor, typename SigmaPoints>
+struct has_stacked_update<
+  UnscentedKalmanFilterManifolds<T, Iv, Executor, SigmaPoints>
+> : std::false_type {};
+
+template <typename T, Invariance Iv, typename Executor, typename SigmaPoints>
+struct has_stacked_update<
+  SquareRootUnscentedKalmanFilterManifolds<T, Iv, Executor, SigmaPoints>
+> : std::false_type {};
+
+template <typename T>
+struct has_stacked_update<DynamicExtendedKalmanFilter<T>> : std::false_type {};
+
+/**
+ * @brief A buffered stream of time-stamped measurements of the scheduler.
+ */
+template <typename Filter>
+struct ScheduledStreamBase {
+
+  virtual ~ScheduledStreamBase() = default;
+
+  /**
+   * @brief Get the time of the earliest buffered measurement
+   * @return Whether there is a buffered measurement
+   */
+  virtual bool peek(double& t) const = 0;
+
+  /**
+   * @brief Update the filter with the buffered measurements
+   * of the time t and drop them.
+   * @return The number of measurements
+   */
+  virtual std::size_t apply(Filter& filter, const double t) = 0;
+};
+
+} // namespace internal
+
+/**
+ * @brief A scheduler merging sensor streams by timestamp
+ * before running the filter.
+ *
+ * The controls and measurements are buffered and only processed
+ * once they are older than the latest timestamp received minus a latency,
+ * so that the streams are merged in time order as long as they are not
+ * delayed longer than the latency. Inputs older than the processed time
+ * are dropped and counted.
+ *
+ * The filter is propagated to the time of each input, with a zero-order
+ * hold of the last control: the time step between two controls is split
+ * at the measurements in between. The system model thus takes
+ * the time step as its last argument, e.g. SimpleImuSystemModel.
+ * Until the first control, the measurements are applied without
+ * propagating the filter.
+ *
+ * The measurements of a stream sharing a timestamp are applied at once
+ * with the stacked update, if the filter implements it
+ * (see internal::has_stacked_update).
+ *
+ * @code
+ * MeasurementScheduler<EKF, SimpleImuSystemModel<double>> scheduler(
+ *   imu, t0, 0.05, X0, P0
+ * );
+ * auto& landmarks = scheduler.addMeasurementStream<Landmark3DMeasurementModel<SE_2_3d>>();
+ * scheduler.pushControl(t, u);
+ * landmarks.push(t, h, y);
+ * scheduler.process();
+ * @endcode
+ *
+ * @note The system and measurement models are held by reference
+ * for as long as their input is buffered.
+ * @note The scheduler is not thread-safe, it is meant to run
+ * on the filter thread, e.g. fed from the FusionFrontEnd queues.
+ *
+ * @tparam Filter The filter type
+ * @tparam SystemModel The system model type
+ */
+template <typename Filter, typename SystemModel>
+class MeasurementScheduler {
+
+public:
+
+  using State = typename internal::traits<Filter>::State;
+  using Scalar = typename internal::traits<State>::Scalar;
+  using Control = typename internal::traits<SystemModel>::Control;
+
+  template <typename MeasurementModel> class MeasurementStream;
+
+  /**
+   * @brief Construct a scheduler
+   * @param f The system model
+   * @param t_init The time of the initial estimate
+   * @param latency The time an input is buffered for,
+   * i.e. the tolerated delay of the streams w.r.t. one another.
+   * @param args The arguments of the filter constructor,
+   * e.g. the initial state and covariance.
+   * @throw kalmanif::invalid_argument if latency is negative
+   */
+  template <typename... Args>
+  MeasurementScheduler(
+    const SystemModel& f,
+    const double t_init,
+    const double latency,
+    Args&&... args
+  ) : filter_(std::forward<Args>(args)...)
+    , f_(f), t_(t_init), newest_(t_init), latency_(latency) {
+    KALMANIF_CHECK(
+      latency >= 0,
+      "MeasurementScheduler: The latency must be positive!",
+      kalmanif::invalid_argument
+    );
+  }
+
+  MeasurementScheduler(const MeasurementScheduler&) = delete;
+  MeasurementScheduler& operator =(const MeasurementScheduler&) = delete;
+
+  /**
+   * @brief Add a stream of measurements
+   *
+   * @tparam MeasurementModel The measurement model type of the stream
+   * @return The stream, to push the measurements to
+   */
+  template <typename MeasurementModel>
+  MeasurementStream<MeasurementModel>& addMeasurementStream() {
+    streams_.push_back(
+      std::make_unique<MeasurementStream<MeasurementModel>>(*this)
+    );
+    return static_cast<MeasurementStream<MeasurementModel>&>(*streams_.back());
+  }
+
+  /**
+   * @brief Buffer a control
+   * @param t The control time, from which it holds
+   * @param u The control
+   * @return Whether it was buffered, false if older than the processed time.
+   */
+  bool pushControl(const double t, const Control& u) {
+    if (!accept(t)) {
+      return false;
+    }
+    insert(controls_, ControlItem{t, u});
+    return true;
+  }
+
+  /**
+   * @brief Run the filter on the inputs older than
+   * the latest timestamp received minus the latency.
+   *
+   * @return The number of inputs processed
+   */
+  std::size_t process() {
+    return processUntil(newest_ - latency_);
+  }
+
+  /**
+   * @brief Run the filter on all the buffered inputs.
+   *
+   * @return The number of inputs processed
+   */
+  std::size_t flush() {
+    return processUntil(std::numeric_limits<double>::infinity());
+  }
+
+  /**
+   * @brief Propagate the filter up to the time t,
+   * after processing the inputs before it.
+   *
+   * @return The propagated state
+   */
+  const State& propagateTo(const double t) {
+    processUntil(t);
+    propagate(t);
+    newest_ = std::max(newest_, t);
+    return getState();
+  }
+
+  const State& getState() const {
+    return filter_.getState();
+  }
+
+  const Covariance<State>& getCovariance() const {
+    return filter_.getCovariance();
+  }
+
+  const Filter& getFilter() const {
+    return filter_;
+  }
+
+  /**
+   * @brief Get the time of the filter estimate
+   */
+  double getTime() const {
+    return t_;
+  }
+
+  /**
+   * @brief Get the number of buffered inputs
+   */
+  std::size_t size() const {
+    return buffered_;
+  }
+
+  /**
+   * @brief Get the number of inputs dropped as older than
+   * the processed time.
+   */
+  std::size_t getDroppedCount() const {
+    return dropped_;
+  }
+
+  /**
+   * @brief Get the number of filter updates, one per stacked group.
+   */
+  std::size_t getUpdateCount() const {
+    return updates_;
+  }
+
+  /**
+   * @brief Get the number of filter propagations.
+   */
+  std::size_t getPropagationCount() const {
+    return propagations_;
+  }
+
+protected:
+
+  using Stream = internal::ScheduledStreamBase<Filter>;
+
+  struct ControlItem {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+    double t = 0;
+    Control u;
+  };
+
+  template <typename Item>
+  using Buffer = std::deque<Item, Eigen::aligned_allocator<Item>>;
+
+  //! Insert in time order, after the items of the same time
+  template <typename Item>
+  void insert(Buffer<Item>& buffer, Item&& item) {
+    auto it = buffer.end();
+    // usually in order
+    while (it != buffer.begin() && std::prev(it)->t > item.t) --it;
+    buffer.insert(it, std::move(item));
+    ++buffered_;
+  }
+
+  bool accept(const double t) {
+    if (t < t_) {
+      ++dropped_;
+      return false;
+    }
+    newest_ = std::max(newest_, t);
+    return true;
+  }
+
+  std::size_t processUntil(const double horizon) {
+    std::size_t processed = 0;
+
+    while (true) {
+      // the earliest input, controls first at equal time
+      Stream* next = nullptr;
+      bool found = !controls_.empty();
+      double t_next = found ? controls_.front().t : 0;
+
+      for (const auto& stream : streams_) {
+        double t;
+        if (stream->peek(t) && (!found || t < t_next)) {
+          next = stream.get();
+          t_next = t;
+          found = true;
+        }
+      }
+
+      if (!found || t_next > horizon) {
+        break;
+      }
+
+      propagate(t_next);
+
+      std::size_t count = 1;
+      if (next == nullptr) {
+        u_ = controls_.front().u;
+        has_control_ = true;
+        controls_.pop_front();
+      } else {
+        count = next->apply(filter_, t_next);
+        ++updates_;
+      }
+
+      buffered_ -= count;
+      processed += count;
+    }
+
+    return processed;
+  }
+
+  //! Propagate the filter with the held control, if any
+  void propagate(const double t) {
+    if (t > t_) {
+      if (has_control_) {
+        filter_.propagate(f_, u_, Scalar(t - t_));
+        ++propagations_;
+      }
+      t_ = t;
+    }
+  }
+
+  Filter filter_;
+  const SystemModel& f_;
+
+  double t_;
+  double newest_;
+  double latency_;
+
+  Control u_;
+  bool has_control_ = false;
+
+  Buffer<ControlItem> controls_;
+  std::vector<std::unique_ptr<Stream>> streams_;
+
+  std::size_t buffered_ = 0;
+  std::size_t dropped_ = 0;
+  std::size_t updates_ = 0;
+  std::size_t propagations_ = 0;
+};
+
+/**
+ * @brief A buffered stream of time-stamped measurements
+ *
+ * @tparam MeasurementModel The measurement model type
+ */
+template <typename Filter, typename SystemModel>
+template <typename MeasurementModel>
+class MeasurementScheduler<Filter, SystemModel>::MeasurementStream
+  : public internal::ScheduledStreamBase<Filter> {
+
+public:
+
+  using Measurement = typename internal::traits<MeasurementModel>::Measurement;
+
+  explicit MeasurementStream(MeasurementScheduler& scheduler)
+    : scheduler_(scheduler) {}
+
+  /**
+   * @brief Buffer a measurement
+   * @param t The measurement time
+   * @param h The measurement model
+   * @param y The measurement
+   * @return Whether it was buffered, false if older than the processed time.
+   */
+  bool push(const double t, const MeasurementModel& h, const Measurement& y) {
+    if (!scheduler_.accept(t)) {
+      return false;
+    }
+    scheduler_.insert(items_, Item{t, &h, y});
+    return true;
+  }
+
+protected:
+
+  struct Item {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+    double t = 0;
+    const MeasurementModel* h = nullptr;
+    Measurement y;
+  };
+
+  bool peek(double& t) const override {
+    if (items_.empty()) {
+      return false;
+    }
+    t = items_.front().t;
+    return true;
+  }
+
+  std::size_t apply(Filter& filter, const double t) override {
+    hs_.clear();
+    ys_.clear();
+    for (auto it = items_.begin(); it != items_.end() && it->t == t; ++it) {
+      hs_.push_back(it->h);
+      ys_.push_back(&it->y);
+    }
+
+    const std::size_t count = hs_.size();
+
+    if constexpr (internal::has_stacked_update<Filter>::value) {
+      if (count > 1) {
+        filter.update(
+          internal::IndirectRange<MeasurementModel>{
+            hs_.data(), hs_.data() + count
+          },
+          internal::IndirectRange<Measurement>{ys_.data(), ys_.data() + count}
+        );
+      } else {
+        filter.update(*hs_.front(), *ys_.front());
+      }
+    } else {
+      for (std::size_t i = 0; i < count; ++i) {
+        filter.update(*hs_[i], *ys_[i]);
+      }
+    }
+
+    items_.erase(items_.begin(), items_.begin() + count);
+    return count;
+  }
+
+  MeasurementScheduler& scheduler_;
+  Buffer<Item> items_;
+
+  // the group of measurements of the same time
+  std::vector<const MeasurementModel*> hs_;
+  std::vector<const Measurement*> ys_;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_MEASUREMENT_SCHEDULER_H_
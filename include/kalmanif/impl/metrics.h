@@ -0,0 +1,272 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_METRICS_H_
+#define _KALMANIF_KALMANIF_IMPL_METRICS_H_
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace kalmanif {
+
+/**
+ * @brief Running mean and variance (Welford's algorithm),
+ * mergeable (Chan et al.) so that partial statistics
+ * can be computed in parallel and reduced.
+ */
+struct RunningStatistics {
+
+  void add(const double x) {
+    ++count;
+    const double delta = x - mean;
+    mean += delta / double(count);
+    m2 += delta * (x - mean);
+  }
+
+  void merge(const RunningStatistics& other) {
+    if (other.count == 0) return;
+    const std::size_t n = count + other.count;
+    const double delta = other.mean - mean;
+    mean += delta * double(other.count) / double(n);
+    m2 += other.m2 + delta * delta * double(count) * double(other.count) / double(n);
+    count = n;
+  }
+
+  //! The unbiased variance
+  double variance() const {
+    return count > 1 ? m2 / double(count - 1) : 0.;
+  }
+
+  double stddev() const {
+    return std::sqrt(variance());
+  }
+
+  void reset() {
+    *this = RunningStatistics();
+  }
+
+  std::size_t count = 0;
+  double mean = 0;
+  double m2 = 0;
+};
+
+namespace internal {
+
+/**
+ * @brief The translation and orientation parts of the error
+ * of a pose-like group, e.g. SE2, SE3 or SE_2_3,
+ * whose tangent is ordered translation first and rotation last.
+ *
+ * The orientation error is the norm of the rotation part,
+ * i.e. the angle of the rotation error.
+ */
+template <typename LieGroup>
+struct pose_error {
+
+  using Scalar = typename LieGroup::Scalar;
+  using Tangent = typename LieGroup::Tangent;
+
+  static constexpr int TranslationSize = LieGroup::Dim;
+  static constexpr int RotationSize = LieGroup::Dim == 2 ? 1 : 3;
+
+  static Scalar squaredTranslation(const Tangent& e) {
+    return e.coeffs().template head<TranslationSize>().squaredNorm();
+  }
+
+  static Scalar orientation(const Tangent& e) {
+    return e.coeffs().template tail<RotationSize>().norm();
+  }
+};
+
+} // namespace internal
+
+/**
+ * @brief The accuracy metrics of an estimated trajectory,
+ * updated sample by sample so that the trajectory is not stored.
+ *
+ * - RMSE:  the root mean squared (weighted) error,
+ * - ATE:   the absolute translation error (root mean squared),
+ * - AOE:   the absolute orientation error (mean),
+ * - RRMSE, RTE, ROE: the same for the relative errors, i.e. the errors
+ *   of the motion since a reference sample, renewed once older
+ *   than the window,
+ * - FPE:   the final (weighted) error,
+ * - NEES:  the mean normalized estimation error squared,
+ *   when collected from a filter.
+ *
+ * Each metric is a RunningStatistics, so that metrics accumulated
+ * separately, e.g. per Monte-Carlo trial in parallel, are reduced
+ * with merge, in any order.
+ * Once merged, the metrics pool the samples of all trajectories and
+ * the FPE is averaged over the trajectories.
+ *
+ * @code
+ * TrajectoryMetrics<SE2d> metrics;
+ * for (...) {
+ *   ekf.update(h, y);
+ *   metrics.collect(X_true, ekf, t);
+ * }
+ * std::cout << metrics.rmse() << "\n";
+ * @endcode
+ *
+ * @tparam _LieGroup The state type, see internal::pose_error
+ */
+template <typename _LieGroup>
+class TrajectoryMetrics {
+
+  using pose_error = internal::pose_error<_LieGroup>;
+
+public:
+
+  using LieGroup = _LieGroup;
+  using Scalar = typename LieGroup::Scalar;
+  using Tangent = typename LieGroup::Tangent;
+
+  /**
+   * @brief Construct the metrics
+   * @param window The time span of the relative errors
+   */
+  explicit TrajectoryMetrics(const double window = 1)
+    : window_(window) {
+    KALMANIF_CHECK(
+      window >= 0,
+      "TrajectoryMetrics: The window must be positive!",
+      invalid_argument
+    );
+  }
+
+  /**
+   * @brief Add a sample of the trajectory
+   * @param X_true The ground truth state
+   * @param X_est The estimated state
+   * @param t The time of the sample, increasing
+   */
+  void add(const LieGroup& X_true, const LieGroup& X_est, const double t) {
+    const Tangent dX = X_est - X_true;
+    squared_error_.add(double(dX.squaredWeightedNorm()));
+    translation_error_.add(double(pose_error::squaredTranslation(dX)));
+    orientation_error_.add(double(pose_error::orientation(dX)));
+
+    last_error_ = double(dX.weightedNorm());
+
+    if (!(t_ref_ == t_ref_) || (t - t_ref_) > window_) {
+      X_true_ref_ = X_true;
+      X_est_ref_ = X_est;
+      t_ref_ = t;
+      return;
+    }
+
+    const Tangent dX_rel =
+      X_est_ref_.between(X_est) - X_true_ref_.between(X_true);
+    relative_squared_error_.add(double(dX_rel.squaredWeightedNorm()));
+    relative_translation_error_.add(double(pose_error::squaredTranslation(dX_rel)));
+    relative_orientation_error_.add(double(pose_error::orientation(dX_rel)));
+  }
+
+  /**
+   * @brief Add the current estimate of a filter, along with its NEES
+   *
+   * The NEES error is expressed in the tangent space of the filter
+   * covariance, i.e. left for the right-invariant filters.
+   *
+   * @param X_true The ground truth state
+   * @param filter The filter
+   * @param t The time of the sample, increasing
+   */
+  template <typename Filter>
+  void collect(const LieGroup& X_true, const Filter& filter, const double t) {
+    const LieGroup& X_est = filter.getState();
+    add(X_true, X_est, t);
+
+    Tangent e = internal::is_right_invariant<Filter>::value ?
+      X_est.lminus(X_true) : X_est.rminus(X_true);
+
+    // e^T.P^{-1}.e = |L^{-1}.e|^2 with P = L.L^T
+    filter.getCovarianceSquareRoot().matrixL().solveInPlace(e.coeffs());
+    nees_.add(double(e.coeffs().squaredNorm()));
+  }
+
+  /**
+   * @brief Pool the metrics of another trajectory, or of other trajectories
+   */
+  void merge(const TrajectoryMetrics& other) {
+    squared_error_.merge(other.squared_error_);
+    translation_error_.merge(other.translation_error_);
+    orientation_error_.merge(other.orientation_error_);
+    relative_squared_error_.merge(other.relative_squared_error_);
+    relative_translation_error_.merge(other.relative_translation_error_);
+    relative_orientation_error_.merge(other.relative_orientation_error_);
+    nees_.merge(other.nees_);
+    final_error_.merge(other.finalError());
+  }
+
+  /**
+   * @brief End the current trajectory, e.g. to add the next one
+   */
+  void endTrajectory() {
+    final_error_ = finalError();
+    last_error_ = std::numeric_limits<double>::quiet_NaN();
+    t_ref_ = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  void reset() {
+    *this = TrajectoryMetrics(window_);
+  }
+
+  Scalar rmse() const { return Scalar(std::sqrt(squared_error_.mean)); }
+  Scalar ate() const { return Scalar(std::sqrt(translation_error_.mean)); }
+  Scalar aoe() const { return Scalar(orientation_error_.mean); }
+
+  Scalar rrmse() const { return Scalar(std::sqrt(relative_squared_error_.mean)); }
+  Scalar rte() const { return Scalar(std::sqrt(relative_translation_error_.mean)); }
+  Scalar roe() const { return Scalar(relative_orientation_error_.mean); }
+
+  Scalar fpe() const { return Scalar(finalError().mean); }
+
+  //! The NEES averaged over the trajectory
+  Scalar nees() const { return Scalar(nees_.mean); }
+
+  //! The number of samples
+  std::size_t count() const { return squared_error_.count; }
+
+  //! The statistics of the squared error
+  const RunningStatistics& squaredError() const { return squared_error_; }
+  //! The statistics of the squared translation error
+  const RunningStatistics& translationError() const { return translation_error_; }
+  //! The statistics of the orientation error
+  const RunningStatistics& orientationError() const { return orientation_error_; }
+  //! The statistics of the NEES
+  const RunningStatistics& neesStatistics() const { return nees_; }
+
+  //! The statistics of the final error, over the trajectories
+  RunningStatistics finalError() const {
+    RunningStatistics final_error = final_error_;
+    if (last_error_ == last_error_) final_error.add(last_error_);
+    return final_error;
+  }
+
+protected:
+
+  double window_;
+
+  RunningStatistics squared_error_;
+  RunningStatistics translation_error_;
+  RunningStatistics orientation_error_;
+  RunningStatistics relative_squared_error_;
+  RunningStatistics relative_translation_error_;
+  RunningStatistics relative_orientation_error_;
+  RunningStatistics nees_;
+  // Of the ended or merged trajectories
+  RunningStatistics final_error_;
+
+  // Of the current trajectory
+  double last_error_ = std::numeric_limits<double>::quiet_NaN();
+  LieGroup X_true_ref_, X_est_ref_;
+  double t_ref_ = std::numeric_limits<double>::quiet_NaN();
+
+public:
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_METRICS_H_
@@ -0,0 +1,313 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_OUT_OF_SEQUENCE_FILTER_H_
+#define _KALMANIF_KALMANIF_IMPL_OUT_OF_SEQUENCE_FILTER_H_
+
+#include <deque>
+#include <functional>
+#include <iterator>
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief Whether the filter's error propagation is independent
+ * of its estimate, so that the propagation jacobian stays valid
+ * when an earlier estimate is corrected.
+ *
+ * That is the case of the right-invariant IEKF for group-affine
+ * system models, e.g. LieSystemModel or SimpleImuSystemModel.
+ */
+template <typename>
+struct has_estimate_independent_propagation : std::false_type {};
+
+template <typename T, InnovationSolver Solver>
+struct has_estimate_independent_propagation<
+  InvariantExtendedKalmanFilter<T, Invariance::Right, Solver>
+> : std::true_type {};
+
+} // namespace internal
+
+/**
+ * @brief A filter accepting out-of-sequence measurements.
+ *
+ * It keeps a time-stamped buffer of the propagations and updates of the
+ * last 'horizon' seconds, each with the filter state and covariance
+ * it produced. A late measurement is inserted in the buffer after
+ * the last step preceding its timestamp, and the buffered steps
+ * that follow are then replayed.
+ *
+ * The replay of a propagation reuses its stored jacobian when the
+ * filter's error propagation is independent of its estimate
+ * (see internal::has_estimate_independent_propagation):
+ * the correction \f$ \delta \f$ of the preceding estimate is carried
+ * to the next as \f$ F \delta \f$ and the covariance as
+ * \f$ P_{k+1} + F (P'_k - P_k) F^T \f$, without evaluating the
+ * system model. Otherwise, it re-runs the propagation,
+ * re-linearizing the system model at the corrected estimate.
+ * The buffered updates are always re-run.
+ *
+ * @note The system and measurement models are held by reference
+ * for as long as their step is buffered.
+ *
+ * @tparam Filter The underlying filter type.
+ */
+template <typename Filter>
+struct OutOfSequenceFilter {
+
+  using State = typename Filter::State;
+  using Scalar = typename internal::traits<State>::Scalar;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(OutOfSequenceFilter);
+
+  /**
+   * @brief Construct a new out-of-sequence filter
+   * @param state_init The initial state
+   * @param cov_init The initial state covariance
+   * @param time_init The time of the initial state
+   * @param horizon The buffered time span, in seconds
+   */
+  OutOfSequenceFilter(
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const double time_init,
+    const double horizon
+  ) : filter_(state_init, cov_init), horizon_(horizon) {
+    KALMANIF_CHECK(
+      horizon >= 0,
+      "OutOfSequenceFilter: The horizon must be positive!",
+      kalmanif::invalid_argument
+    );
+    base_.t = time_init;
+    base_.x = state_init;
+    base_.P = cov_init;
+  }
+
+  /**
+   * @brief Perform the underlying filter's propagation
+   * to the time t.
+   *
+   * @param [in] t The time after the propagation
+   * @param [in] f The system model
+   * @param [in] u The input control
+   * @param [in] args input arguments for the system model
+   * @return The propagated state
+   * @throw kalmanif::invalid_argument if t is before the last propagation
+   */
+  template <class SystemModelDerived, typename... Args>
+  const State& propagate(
+    const double t,
+    const SystemModelBase<SystemModelDerived>& f,
+    const typename internal::traits<SystemModelDerived>::Control& u,
+    Args... args
+  ) {
+    KALMANIF_CHECK(
+      t >= getTime(),
+      "OutOfSequenceFilter::propagate: Propagations must be in sequence!",
+      kalmanif::invalid_argument
+    );
+
+    // In real-time mode the check does not throw,
+    // the records must stay sorted
+    if (t < getTime()) {
+      return getState();
+    }
+
+    Record& r = record(records_.end(), t, false);
+    r.step = [&f, u, args...](Filter& filter) {
+      filter.propagate(f, u, args...);
+    };
+    apply(r);
+
+    prune();
+
+    return getState();
+  }
+
+  /**
+   * @brief Perform the underlying filter's update at the time t.
+   *
+   * If t is before the last propagation, the filter
+   * is rewound to the time t, updated and replayed.
+   *
+   * @param [in] t The measurement time
+   * @param [in] h The measurement model
+   * @param [in] y The measurement vector
+   * @param [in] args input arguments for the measurement model
+   * @return Whether the measurement was applied,
+   * it is dropped if older than the buffered horizon.
+   */
+  template <typename MeasurementModelDerived, typename... Args>
+  bool update(
+    const double t,
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    Args... args
+  ) {
+    if (t < base_.t) {
+      return false;
+    }
+
+    // The first step after the time t
+    auto it = records_.begin();
+    while (it != records_.end() && it->t <= t) ++it;
+
+    const bool late = it != records_.end();
+    const auto index = std::distance(records_.begin(), it);
+
+    Record& r = record(it, t, true);
+    r.step = [&h, y, args...](Filter& filter) {
+      filter.update(h, y, args...);
+    };
+
+    if (late) {
+      replay(index);
+    } else {
+      apply(r);
+    }
+
+    return true;
+  }
+
+  const State& getState() const {
+    return filter_.getState();
+  }
+
+  const Covariance<State>& getCovariance() const {
+    return filter_.getCovariance();
+  }
+
+  /**
+   * @brief Get the time of the last step.
+   */
+  double getTime() const {
+    return records_.empty() ? base_.t : records_.back().t;
+  }
+
+  /**
+   * @brief Get the number of buffered steps.
+   */
+  std::size_t size() const {
+    return records_.size();
+  }
+
+  const Filter& getFilter() const {
+    return filter_;
+  }
+
+protected:
+
+  using Tangent = typename State::Tangent;
+
+  //! A buffered step and the estimate it produced
+  struct Record {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+    double t = 0;
+    bool is_update = false;
+    std::function<void(Filter&)> step;
+
+    State x = State::Identity();
+    Covariance<State> P = Covariance<State>::Identity();
+    Jacobian<State, State> F = Jacobian<State, State>::Identity();
+  };
+
+  using Records = std::deque<Record, Eigen::aligned_allocator<Record>>;
+
+  Record& record(
+    const typename Records::iterator& it,
+    const double t,
+    const bool is_update
+  ) {
+    Record& r = *records_.emplace(it);
+    r.t = t;
+    r.is_update = is_update;
+    return r;
+  }
+
+  /**
+   * @brief Run a step on the underlying filter and record its estimate.
+   */
+  void apply(Record& r) {
+    if constexpr (internal::has_estimate_independent_propagation<Filter>{}) {
+      // A propagation records its transition F
+      const internal::ScopedOutput<Jacobian<State, State>> transition(
+        filter_.transition_, r.is_update ? nullptr : &r.F
+      );
+      r.step(filter_);
+    } else {
+      r.step(filter_);
+    }
+    r.x = filter_.getState();
+    r.P = filter_.getCovariance();
+  }
+
+  /**
+   * @brief Rewind the underlying filter before the index-th step,
+   * the newly inserted one, and run the steps from there on.
+   */
+  void replay(const std::size_t index) {
+    const Record& prev = index == 0 ? base_ : records_[index - 1];
+
+    filter_.setState(prev.x);
+    filter_.setCovariance(prev.P);
+
+    // The previous estimate, as recorded before its correction
+    State x_prev = prev.x;
+    Covariance<State> P_prev = prev.P;
+
+    for (std::size_t i = index; i < records_.size(); ++i) {
+      Record& r = records_[i];
+
+      if constexpr (internal::has_estimate_independent_propagation<Filter>{}) {
+        if (!r.is_update) {
+          const State x_old = r.x;
+          const Covariance<State> P_old = r.P;
+
+          // Carry the correction of the previous estimate, right-invariant
+          const Tangent dx(r.F * filter_.getState().lminus(x_prev).coeffs());
+          r.x = dx + r.x;
+          r.P += r.F * (filter_.getCovariance() - P_prev) * r.F.transpose();
+
+          filter_.setState(r.x);
+          filter_.setCovariance(r.P);
+
+          x_prev = x_old;
+          P_prev = P_old;
+          continue;
+        }
+        if (i != index) {
+          x_prev = r.x;
+          P_prev = r.P;
+        }
+      }
+
+      apply(r);
+    }
+  }
+
+  /**
+   * @brief Drop the steps older than the horizon.
+   */
+  void prune() {
+    const double oldest = getTime() - horizon_;
+    while (!records_.empty() && records_.front().t < oldest) {
+      base_ = records_.front();
+      records_.pop_front();
+    }
+  }
+
+  Filter filter_;
+
+  double horizon_ = 0;
+
+  //! The estimate before the first buffered step
+  Record base_;
+
+  //! The buffered steps, in time order
+  Records records_;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_OUT_OF_SEQUENCE_FILTER_H_
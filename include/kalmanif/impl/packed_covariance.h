@@ -0,0 +1,142 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_PACKED_COVARIANCE_H_
+#define _KALMANIF_KALMANIF_IMPL_PACKED_COVARIANCE_H_
+
+namespace kalmanif {
+
+/**
+ * @brief A covariance stored as its packed upper triangle,
+ * i.e. n(n+1)/2 coefficients rather than n^2, e.g. to keep long
+ * histories of covariances.
+ *
+ * The coefficient (i, j), i <= j, is stored at i + j(j+1)/2,
+ * the column-major upper packed layout of LAPACK.
+ * It is unpacked to a dense fixed-size covariance for any computation.
+ *
+ * @tparam _State The state type, of fixed size
+ */
+template <typename _State>
+class PackedCovariance {
+
+public:
+
+  using State = _State;
+  using Scalar = typename internal::traits<State>::Scalar;
+
+  static constexpr int Size = internal::traits<State>::Size;
+  static constexpr int PackedSize = Size * (Size + 1) / 2;
+
+  static_assert(
+    Size != Eigen::Dynamic,
+    "PackedCovariance: The state must be of fixed size!"
+  );
+
+  using Coefficients = Eigen::Matrix<Scalar, PackedSize, 1>;
+
+  PackedCovariance() = default;
+
+  /**
+   * @brief Pack the upper triangle of a symmetric matrix
+   */
+  template <typename _Derived>
+  PackedCovariance(const Eigen::MatrixBase<_Derived>& P) {
+    pack(P);
+  }
+
+  template <typename _Derived>
+  PackedCovariance& operator =(const Eigen::MatrixBase<_Derived>& P) {
+    pack(P);
+    return *this;
+  }
+
+  /**
+   * @brief The index of the coefficient (i, j) in the packed storage
+   */
+  static constexpr int index(const int i, const int j) {
+    return i <= j ? i + j * (j + 1) / 2 : j + i * (i + 1) / 2;
+  }
+
+  template <typename _Derived>
+  void pack(const Eigen::MatrixBase<_Derived>& P) {
+    for (int j = 0, k = 0; j < Size; ++j) {
+      coeffs_.segment(k, j + 1) = P.col(j).head(j + 1);
+      k += j + 1;
+    }
+  }
+
+  /**
+   * @brief Unpack to a dense symmetric matrix
+   */
+  template <typename _Derived>
+  void unpack(Eigen::MatrixBase<_Derived>& P) const {
+    for (int j = 0, k = 0; j < Size; ++j) {
+      P.col(j).head(j + 1) = coeffs_.segment(k, j + 1);
+      k += j + 1;
+    }
+    internal::mirrorUpper(P);
+  }
+
+  Covariance<State> unpack() const {
+    Covariance<State> P;
+    unpack(P);
+    return P;
+  }
+
+  Scalar operator ()(const int i, const int j) const {
+    return coeffs_(index(i, j));
+  }
+
+  const Coefficients& coeffs() const {
+    return coeffs_;
+  }
+
+  Coefficients& coeffs() {
+    return coeffs_;
+  }
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+protected:
+
+  Coefficients coeffs_;
+};
+
+namespace internal {
+
+/**
+ * @brief A dense covariance as is.
+ */
+template <typename _Derived>
+const _Derived& unpacked(const Eigen::MatrixBase<_Derived>& P) {
+  return P.derived();
+}
+
+/**
+ * @brief A packed covariance unpacked to a dense one.
+ */
+template <typename State>
+Covariance<State> unpacked(const PackedCovariance<State>& P) {
+  return P.unpack();
+}
+
+/**
+ * @brief The type a storage policy keeps the covariances of a state in,
+ * 'Storage::covariance<State>' if it defines one,
+ * the dense Covariance<State> otherwise.
+ */
+template <typename Storage, typename State, typename = void>
+struct storage_covariance {
+  using type = Covariance<State>;
+};
+
+template <typename Storage, typename State>
+struct storage_covariance<
+  Storage, State,
+  std::void_t<typename Storage::template covariance<State>>
+> {
+  using type = typename Storage::template covariance<State>;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_PACKED_COVARIANCE_H_
@@ -0,0 +1,289 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_PARALLEL_RAUCH_TUNG_STRIEBEL_SMOOTHER_H_
+#define _KALMANIF_KALMANIF_IMPL_PARALLEL_RAUCH_TUNG_STRIEBEL_SMOOTHER_H_
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief An element of the parallel smoother scan.
+ *
+ * It is the affine map between the smoothed estimate at k+1 and the
+ * smoothed estimate at k, with the smoothed state expressed in the
+ * tangent space at the filtered estimate,
+ * \f$ \delta_k = A \delta_{k+1} + b \f$,
+ * \f$ P_k = C P_{k+1} C^T + L \f$.
+ *
+ * @tparam State The state type
+ */
+template <typename State>
+struct SmootherScanElement {
+  Jacobian<State, State> A, C;
+  Covariance<State> L;
+  Eigen::Matrix<typename State::Scalar, State::DoF, 1> b;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  /**
+   * @brief The element mapping everything to an epoch's filtered estimate.
+   */
+  void setConstant(const Covariance<State>& P) {
+    A.setZero();
+    C.setZero();
+    L = P;
+    b.setZero();
+  }
+
+  /**
+   * @brief Compose with the following element,
+   * i.e. this = this o next.
+   */
+  void compose(const SmootherScanElement& next) {
+    b += A * next.b;
+    A = A * next.A;
+    L += C * next.L * C.transpose();
+    C = C * next.C;
+  }
+};
+
+} // namespace internal
+
+/**
+ * @brief The parallel-in-time Rauch-Tung-Striebel Smoother
+ *
+ * The batch backward pass is computed as an associative scan
+ * of affine elements over an executor, in O(log T) span.
+ * Since the smoothed states live on a manifold, the backward recursion
+ * is linearized in the tangent space of the filtered estimates and
+ * the scan is iterated, relinearizing about the last smoothed states.
+ * The smoothed covariances are exact on the first iteration.
+ *
+ * @note Based on,
+ * "Temporal Parallelization of Bayesian Smoothers"
+ * S. Särkkä, Á. F. García-Fernández [3]
+ *
+ * @tparam Filter The underlying filter type.
+ * @tparam Executor The executor type the scan runs on.
+ *
+ * @see RauchTungStriebelSmoother
+ * @see ThreadPoolExecutor
+ */
+template <typename Filter, typename Executor = ThreadPoolExecutor>
+struct ParallelRauchTungStriebelSmoother
+  : RauchTungStriebelSmoother<Filter> {
+
+  using Base = RauchTungStriebelSmoother<Filter>;
+  using typename Base::State;
+  template <typename T> using vector_t = typename Base::template vector_t<T>;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(ParallelRauchTungStriebelSmoother);
+
+  /**
+   * @brief Construct a parallel smoother
+   * @param state_init The initial state
+   * @param cov_init The initial covariance
+   * @param iterations The number of relinearizations of the scan
+   * @param executor The executor the scan runs on
+   */
+  ParallelRauchTungStriebelSmoother(
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const int iterations = 3,
+    Executor executor = Executor()
+  ) : Base(state_init, cov_init)
+    , iterations_(iterations)
+    , executor_(std::move(executor)) {
+    KALMANIF_CHECK(
+      iterations > 0,
+      "ParallelRauchTungStriebelSmoother: iterations must be positive!",
+      kalmanif::invalid_argument
+    );
+  }
+
+  /**
+   * @brief Reserve the storage for n epochs.
+   * @param n The number of epochs
+   */
+  void reserve(const std::size_t n) {
+    Base::reserve(n);
+    elements_.reserve(n);
+    gains_.reserve(n);
+    deltas_.reserve(n);
+  }
+
+  /**
+   * @brief Run the parallel backward pass - the smoothing.
+   * @return The smoothed state sequence.
+   */
+  const vector_t<State>& smooth() {
+
+    const std::size_t n = estimated_;
+
+    Xsk_.resize(n);
+    Psk_.resize(n);
+    elements_.resize(n);
+    gains_.resize(n);
+    deltas_.resize(n);
+
+    if (n == 0)
+      return Xsk_;
+
+    // The smoother gains do not depend on the linearization point
+    executor_(int(n - 1), [&](const int k) {
+      gains_[k] = internal::smootherGain<Filter>(epochs_[k], epochs_[k+1]);
+    });
+
+    for (auto& delta : deltas_) {
+      delta.setZero();
+    }
+
+    for (int i = 0; i < iterations_; ++i) {
+      // Build the elements, linearized about the last smoothed states
+      elements_[n-1].setConstant(epochs_[n-1].P_est);
+      executor_(int(n - 1), [&](const int k) {
+        linearize(k, i == 0);
+      });
+
+      scan(i == 0);
+
+      if (i == 0) {
+        executor_(int(n), [&](const int k) {
+          Psk_[k] = elements_[k].L;
+        });
+      }
+
+      executor_(int(n), [&](const int k) {
+        deltas_[k] = elements_[k].b;
+      });
+    }
+
+    executor_(int(n), [&](const int k) {
+      Xsk_[k] = retract(epochs_[k].x_est, deltas_[k]);
+    });
+
+    return Xsk_;
+  }
+
+protected:
+
+  using Base::epochs_;
+  using Base::estimated_;
+  using Base::Xsk_;
+  using Base::Psk_;
+
+  using Epoch = internal::SmootherEpoch<State>;
+  using Element = internal::SmootherScanElement<State>;
+  using Tangent = typename State::Tangent;
+  using Vector = Eigen::Matrix<typename State::Scalar, State::DoF, 1>;
+
+  /**
+   * @brief The smoothed state from its tangent about the filtered estimate.
+   */
+  static State retract(const State& x_est, const Vector& delta) {
+    if constexpr (internal::is_right_invariant<Filter>{}) {
+      return x_est.lplus(Tangent(delta));
+    } else {
+      return x_est.rplus(Tangent(delta));
+    }
+  }
+
+  /**
+   * @brief Linearize the backward step k about the smoothed state k+1.
+   *
+   * @param k The epoch
+   * @param with_covariance Whether to also set the covariance part
+   */
+  void linearize(const int k, const bool with_covariance) {
+    const Epoch& e_next = epochs_[k+1];
+    const Jacobian<State, State>& Ks = gains_[k];
+    Element& element = elements_[k];
+
+    const Tangent delta(deltas_[k+1]);
+
+    // The step is delta_k = Ks * t(delta_{k+1}),
+    // J_t_d is the jacobian of t wrt delta_{k+1}
+    Tangent t;
+    Jacobian<State, State> J_t_d;
+    if constexpr (!internal::is_invariant<Filter>{}) {
+      // t = ( x_est + delta ) - x_pred
+      t = e_next.x_est.rplus(delta).rminus(e_next.x_pred);
+      J_t_d = t.rjacinv() * delta.rjac();
+    } else if (internal::is_right_invariant<Filter>{}) {
+      // t = -( x_pred.lminus( x_est.lplus(delta) ) )
+      const Tangent tl = e_next.x_pred.lminus(e_next.x_est.lplus(delta));
+      t = -tl;
+      J_t_d = tl.rjacinv() * delta.ljac();
+    } else {
+      // t = -( x_pred - ( x_est + delta ) )
+      const Tangent tl = e_next.x_pred.rminus(e_next.x_est.rplus(delta));
+      t = -tl;
+      J_t_d = tl.ljacinv() * delta.rjac();
+    }
+
+    element.A.noalias() = Ks * J_t_d;
+    element.b.noalias() = Ks * t.coeffs() - element.A * deltas_[k+1];
+
+    if (with_covariance) {
+      const Epoch& e = epochs_[k];
+      element.C = Ks;
+      element.L = e.P_est - Ks * e_next.P_pred * Ks.transpose();
+    }
+  }
+
+  /**
+   * @brief Suffix scan of the elements, in place,
+   * so that element k maps to the smoothed estimate at k.
+   *
+   * Work-efficient (Brent-Kung) inclusive scan over the reversed
+   * sequence, each level runs in parallel over the executor.
+   *
+   * @param with_covariance Whether to also scan the covariance part
+   */
+  void scan(const bool with_covariance) {
+    const std::size_t n = elements_.size();
+
+    // Element j of the reversed sequence
+    auto at = [&](const std::size_t j) -> Element& {
+      return elements_[n - 1 - j];
+    };
+
+    // combine(j, i): at(j) = at(j) o at(i), i < j
+    auto combine = [&](const std::size_t j, const std::size_t i) {
+      if (with_covariance) {
+        at(j).compose(at(i));
+      } else {
+        at(j).b += at(j).A * at(i).b;
+        at(j).A = at(j).A * at(i).A;
+      }
+    };
+
+    std::size_t d = 1;
+    for (; d < n; d *= 2) {
+      const int count = int(n / (2 * d));
+      executor_(count, [&](const int t) {
+        const std::size_t j = 2 * d - 1 + std::size_t(t) * 2 * d;
+        combine(j, j - d);
+      });
+    }
+
+    for (d /= 2; d >= 1; d /= 2) {
+      const int count = int((n - d) / (2 * d));
+      executor_(count, [&](const int t) {
+        const std::size_t j = 2 * d - 1 + std::size_t(t) * 2 * d;
+        combine(j + d, j);
+      });
+    }
+  }
+
+  int iterations_ = 3;
+  Executor executor_;
+
+  vector_t<Element> elements_;
+  vector_t<Jacobian<State, State>> gains_;
+  vector_t<Vector> deltas_;
+};
+
+} // kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_PARALLEL_RAUCH_TUNG_STRIEBEL_SMOOTHER_H_
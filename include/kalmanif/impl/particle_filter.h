@@ -0,0 +1,510 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_PARTICLE_FILTER_H_
+#define _KALMANIF_KALMANIF_IMPL_PARTICLE_FILTER_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace kalmanif {
+
+// Forward declaration
+template <typename Derived> struct SystemModelBase;
+template <typename Derived> struct MeasurementModelBase;
+
+/**
+ * @brief A particle filter on Lie groups, e.g. for global
+ * localization or multimodal initial estimates that the Gaussian
+ * filters cannot represent.
+ *
+ * The filter only evaluates the (non-linearized) models,
+ * as the UKFM does:
+ * - the propagation samples the control noise,
+ * of covariance the system model covariance, and runs the system model
+ * on each particle,
+ * - the update weighs each particle by the Gaussian likelihood
+ * of the measurement, of covariance the measurement model covariance.
+ *
+ * The particles are stored as the contiguous columns of their
+ * group coefficients. They are processed in fixed-size blocks which
+ * the executor may run concurrently. Each block draws from its own
+ * random engine, seeded from the filter seed, the step and the block,
+ * so that the filter is reproducible whatever the executor.
+ *
+ * The weights are resampled, systematically, when the effective sample size
+ * falls below a ratio of the number of particles. The cumulative
+ * weights are computed with a blocked prefix sum, and each particle
+ * then writes its own copies.
+ *
+ * The state estimate is the weighted mean on the group, computed
+ * iteratively, and its covariance is that of the (right) errors
+ * x_i - x at the mean, as for the ExtendedKalmanFilter.
+ *
+ * @code
+ * ParticleFilter<SE2d, ThreadPoolExecutor> pf(X0, P0, 10000);
+ * pf.propagate(f, u);
+ * pf.update(h, y);
+ * pf.getState();
+ * @endcode
+ *
+ * @tparam StateType The state type
+ * @tparam Executor The executor running the particle blocks
+ *
+ * @see SequentialExecutor
+ * @see ThreadPoolExecutor
+ */
+template <typename StateType, typename Executor = SequentialExecutor>
+struct ParticleFilter {
+
+  using State = StateType;
+  using Scalar = typename internal::traits<State>::Scalar;
+  using Tangent = typename State::Tangent;
+
+  static constexpr int DoF = internal::traits<State>::Size;
+  static constexpr int RepSize = State::RepSize;
+
+  //! The particles, one group coefficients vector per column
+  using Particles = Eigen::Matrix<Scalar, RepSize, Eigen::Dynamic>;
+  using Weights = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+  //! The number of particles per block of work
+  static constexpr int BlockSize = 256;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  /**
+   * @brief Construct a filter with all particles at the same state
+   * @param state_init The initial state
+   * @param num_particles The number of particles
+   * @param seed The seed of the random engines
+   * @param executor The executor running the particle blocks
+   * @throw kalmanif::invalid_argument if num_particles is not positive
+   */
+  ParticleFilter(
+    const State& state_init,
+    const int num_particles,
+    const std::uint64_t seed = 0,
+    Executor executor = Executor()
+  ) : seed_(seed), executor_(std::move(executor)) {
+    KALMANIF_ENSURE(
+      num_particles > 0,
+      "ParticleFilter: The number of particles must be positive!",
+      kalmanif::invalid_argument
+    );
+    setParticles(Particles(state_init.coeffs().replicate(1, num_particles)));
+  }
+
+  /**
+   * @brief Construct a filter sampling the particles
+   * from a Gaussian on the group, x = x_init + e, e ~ N(0, cov_init).
+   * @param state_init The initial state
+   * @param cov_init The initial state covariance
+   * @param num_particles The number of particles
+   * @param seed The seed of the random engines
+   * @param executor The executor running the particle blocks
+   * @throw kalmanif::invalid_argument if num_particles is not positive
+   */
+  ParticleFilter(
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const int num_particles,
+    const std::uint64_t seed = 0,
+    Executor executor = Executor()
+  ) : ParticleFilter(state_init, num_particles, seed, std::move(executor)) {
+    const Covariance<State> L = cov_init.llt().matrixL();
+
+    forEachBlock([&](const int begin, const int end, std::mt19937_64& rng){
+      std::normal_distribution<Scalar> normal;
+      for (int i = begin; i < end; ++i) {
+        Tangent e;
+        for (int d = 0; d < DoF; ++d) {
+          e.coeffs()(d) = normal(rng);
+        }
+        e.coeffs() = L * e.coeffs();
+        particles_.col(i) = particle(i).rplus(e).coeffs();
+      }
+    });
+    invalidateEstimate();
+  }
+
+  /**
+   * @brief Set the particles, with uniform weights
+   * @param particles The particles coefficients, one per column
+   * @throw kalmanif::invalid_argument if there is no particle
+   */
+  void setParticles(const Eigen::Ref<const Particles>& particles) {
+    KALMANIF_ENSURE(
+      particles.cols() > 0,
+      "ParticleFilter: The number of particles must be positive!",
+      kalmanif::invalid_argument
+    );
+    particles_ = particles;
+    resampled_.resize(RepSize, particles_.cols());
+    weights_ = Weights::Constant(size(), Scalar(1) / Scalar(size()));
+    cdf_.resize(size());
+    errors_.resize(DoF, size());
+    log_likelihoods_.resize(size());
+    invalidateEstimate();
+  }
+
+  /**
+   * @brief Set the effective sample size ratio below which
+   * the particles are resampled after an update.
+   * @param ratio The ratio, in [0, 1], 0 disables the resampling.
+   * @throw kalmanif::invalid_argument if ratio is not in [0, 1]
+   */
+  void setResamplingThreshold(const Scalar ratio) {
+    KALMANIF_CHECK(
+      ratio >= Scalar(0) && ratio <= Scalar(1),
+      "ParticleFilter: The resampling threshold must be in [0, 1]!",
+      kalmanif::invalid_argument
+    );
+    threshold_ = ratio;
+  }
+
+  Scalar getResamplingThreshold() const {
+    return threshold_;
+  }
+
+  /**
+   * @brief Propagate each particle with a sample of the control noise
+   *
+   * @param [in] f The system model
+   * @param [in] u The input control
+   * @param [in] args input arguments for the system model
+   * @return The state estimate
+   */
+  template <class SystemModelDerived, typename... Args>
+  const State& propagate(
+    const SystemModelBase<SystemModelDerived>& f,
+    const typename internal::traits<SystemModelDerived>::Control& u,
+    const Args&... args
+  ) {
+    using Control = typename internal::traits<SystemModelDerived>::Control;
+    constexpr auto NoiseSize = internal::traits<Control>::Size;
+    using VectorCoF = Eigen::Matrix<Scalar, NoiseSize, 1>;
+
+    const Covariance<Control> L = f.getCovarianceSquareRoot().matrixL();
+
+    forEachBlock([&](const int begin, const int end, std::mt19937_64& rng){
+      std::normal_distribution<Scalar> normal;
+      VectorCoF n;
+      for (int i = begin; i < end; ++i) {
+        for (int d = 0; d < NoiseSize; ++d) {
+          n(d) = normal(rng);
+        }
+        const VectorCoF w = L * n;
+        particles_.col(i) = f(particle(i), u + w, args...).coeffs();
+      }
+    });
+
+    invalidateEstimate();
+    return getState();
+  }
+
+  /**
+   * @brief Weigh each particle by the likelihood of the measurement,
+   * and resample if the effective sample size dropped
+   * below the threshold.
+   *
+   * @param [in] h The measurement model
+   * @param [in] y The measurement vector
+   * @param [in] args input arguments for the measurement model
+   * @return The state estimate
+   * @throw kalmanif::runtime_error if no particle explains the measurement
+   */
+  template <class MeasurementModelDerived, typename... Args>
+  const State& update(
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    const Args&... args
+  ) {
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+
+    // the decomposition is cached before the concurrent evaluations
+    const auto& R = h.getCovarianceSquareRoot();
+
+    forEachBlock([&](const int begin, const int end, std::mt19937_64&){
+      for (int i = begin; i < end; ++i) {
+        const Measurement z = R.matrixL().solve(y - h(particle(i), args...));
+        log_likelihoods_(i) = Scalar(-0.5) * z.squaredNorm();
+      }
+    });
+
+    // w_i = w_i.L_i / sum_j(w_j.L_j), in log space
+    const Scalar max = log_likelihoods_.maxCoeff();
+    KALMANIF_CHECK(
+      std::isfinite(max),
+      "ParticleFilter::update: No particle explains the measurement!",
+      kalmanif::runtime_error
+    );
+
+    // In real-time mode the check does not throw
+    if (!std::isfinite(max)) {
+      return getState();
+    }
+
+    weights_.array() *= (log_likelihoods_.array() - max).exp();
+    const Scalar sum = weights_.sum();
+    const bool normalizable = sum > Scalar(0) && std::isfinite(sum);
+    KALMANIF_CHECK(
+      normalizable,
+      "ParticleFilter::update: No particle explains the measurement!",
+      kalmanif::runtime_error
+    );
+
+    // In real-time mode the check does not throw,
+    // the weights are reset rather than resampled from
+    if (!normalizable) {
+      weights_.setConstant(Scalar(1) / Scalar(size()));
+      invalidateEstimate();
+      return getState();
+    }
+
+    weights_ /= sum;
+
+    // the log of the measurement density, up to a constant
+    log_likelihood_ = max + std::log(sum);
+
+    invalidateEstimate();
+
+    if (getEffectiveSampleSize() < threshold_ * Scalar(size())) {
+      resample();
+    }
+
+    return getState();
+  }
+
+  /**
+   * @brief Resample the particles, systematically,
+   * and reset the weights to uniform.
+   */
+  void resample() {
+    const int n = size();
+    const int blocks = numBlocks();
+
+    // the cumulative weights, a blocked prefix sum
+    std::vector<Scalar> offsets(blocks + 1, Scalar(0));
+    executor_(blocks, [&](const int b){
+      const int end = std::min(n, (b + 1) * BlockSize);
+      Scalar sum = 0;
+      for (int i = b * BlockSize; i < end; ++i) {
+        sum += weights_(i);
+        cdf_(i) = sum;
+      }
+      offsets[b + 1] = sum;
+    });
+
+    for (int b = 0; b < blocks; ++b) {
+      offsets[b + 1] += offsets[b];
+    }
+
+    // normalized so that the last one is exactly 1
+    const Scalar total = offsets[blocks];
+    executor_(blocks, [&](const int b){
+      const int end = std::min(n, (b + 1) * BlockSize);
+      for (int i = b * BlockSize; i < end; ++i) {
+        cdf_(i) = (cdf_(i) + offsets[b]) / total;
+      }
+    });
+    cdf_(n - 1) = Scalar(1);
+
+    // the particle i is copied to the positions k such that
+    // cdf_{i-1} <= (k + u) / n < cdf_i
+    std::mt19937_64 rng = engine(std::numeric_limits<int>::max());
+    const Scalar u = std::uniform_real_distribution<Scalar>()(rng);
+
+    executor_(blocks, [&](const int b){
+      const int end = std::min(n, (b + 1) * BlockSize);
+      for (int i = b * BlockSize; i < end; ++i) {
+        const Scalar lo = (i == 0) ? Scalar(0) : cdf_(i - 1);
+        const int first = std::max(0, int(std::ceil(lo * n - u)));
+        const int last = std::min(n, int(std::ceil(cdf_(i) * n - u)));
+        for (int k = first; k < last; ++k) {
+          resampled_.col(k) = particles_.col(i);
+        }
+      }
+    });
+
+    particles_.swap(resampled_);
+    weights_.setConstant(Scalar(1) / Scalar(n));
+
+    ++resample_count_;
+    invalidateEstimate();
+  }
+
+  /**
+   * @brief Get the state estimate, the weighted mean of the particles
+   */
+  const State& getState() const {
+    computeEstimate();
+    return x_;
+  }
+
+  /**
+   * @brief Get the covariance of the particles at the state estimate
+   */
+  const Covariance<State>& getCovariance() const {
+    computeEstimate();
+    return P_;
+  }
+
+  /**
+   * @brief Get the particles coefficients, one per column
+   */
+  const Particles& getParticles() const {
+    return particles_;
+  }
+
+  /**
+   * @brief Get the i-th particle
+   */
+  State getParticle(const int i) const {
+    return particle(i);
+  }
+
+  /**
+   * @brief Get the normalized weights
+   */
+  const Weights& getWeights() const {
+    return weights_;
+  }
+
+  /**
+   * @brief Get the effective sample size, 1 / sum(w_i^2)
+   */
+  Scalar getEffectiveSampleSize() const {
+    return Scalar(1) / weights_.squaredNorm();
+  }
+
+  /**
+   * @brief Get the log-likelihood of the last measurement,
+   * up to a constant
+   */
+  Scalar getLogLikelihood() const {
+    return log_likelihood_;
+  }
+
+  /**
+   * @brief Get the number of particles
+   */
+  int size() const {
+    return int(particles_.cols());
+  }
+
+  /**
+   * @brief Get the number of resamplings
+   */
+  std::size_t getResampleCount() const {
+    return resample_count_;
+  }
+
+protected:
+
+  int numBlocks() const {
+    return (size() + BlockSize - 1) / BlockSize;
+  }
+
+  //! The random engine of a block for the current step
+  std::mt19937_64 engine(const int block) const {
+    std::seed_seq seq{
+      std::uint32_t(seed_), std::uint32_t(seed_ >> 32),
+      std::uint32_t(step_), std::uint32_t(step_ >> 32),
+      std::uint32_t(block)
+    };
+    return std::mt19937_64(seq);
+  }
+
+  //! Run function(begin, end, rng) on each block of particles
+  template <typename Function>
+  void forEachBlock(Function&& function) {
+    const int n = size();
+    executor_(numBlocks(), [&](const int b){
+      std::mt19937_64 rng = engine(b);
+      function(b * BlockSize, std::min(n, (b + 1) * BlockSize), rng);
+    });
+    ++step_;
+  }
+
+  State particle(const int i) const {
+    State x;
+    x.coeffs() = particles_.col(i);
+    return x;
+  }
+
+  void invalidateEstimate() {
+    is_estimate_valid_ = false;
+  }
+
+  //! The weighted mean on the group and the covariance at the mean
+  void computeEstimate() const {
+    if (is_estimate_valid_) {
+      return;
+    }
+
+    const int n = size();
+    const int blocks = numBlocks();
+
+    // from the most likely particle
+    int best;
+    weights_.maxCoeff(&best);
+    x_ = particle(best);
+
+    const auto errors = [&](){
+      executor_(blocks, [&](const int b){
+        const int end = std::min(n, (b + 1) * BlockSize);
+        for (int i = b * BlockSize; i < end; ++i) {
+          errors_.col(i) = particle(i).rminus(x_).coeffs();
+        }
+      });
+    };
+
+    for (int iter = 0; iter < MeanIterations; ++iter) {
+      errors();
+      const Tangent dx(errors_ * weights_);
+      x_ = x_.rplus(dx);
+      if (dx.coeffs().norm() < Constants<Scalar>::eps) {
+        break;
+      }
+    }
+
+    errors();
+    P_.noalias() = errors_ * weights_.asDiagonal() * errors_.transpose();
+
+    is_estimate_valid_ = true;
+  }
+
+  //! The maximum number of iterations of the mean on the group
+  static constexpr int MeanIterations = 10;
+
+  Particles particles_;
+  Particles resampled_;
+  Weights weights_;
+
+  // workspaces
+  Weights cdf_;
+  Weights log_likelihoods_;
+  mutable Eigen::Matrix<Scalar, DoF, Eigen::Dynamic> errors_;
+
+  Scalar threshold_ = Scalar(0.5);
+  Scalar log_likelihood_ = Scalar(0);
+
+  std::uint64_t seed_;
+  std::uint64_t step_ = 0;
+
+  std::size_t resample_count_ = 0;
+
+  // the estimate, computed lazily
+  mutable State x_;
+  mutable Covariance<State> P_;
+  mutable bool is_estimate_valid_ = false;
+
+  Executor executor_;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_PARTICLE_FILTER_H_
@@ -0,0 +1,99 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_RANGE_H_
+#define _KALMANIF_KALMANIF_IMPL_RANGE_H_
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+namespace kalmanif {
+
+// Forward declaration
+template <typename _Derived> struct MeasurementModelBase;
+
+namespace internal {
+
+/**
+ * @brief The element type of a range
+ *
+ * @tparam Range The range type (anything with std::begin/std::end)
+ */
+template <typename Range>
+using range_value_t = typename std::decay<
+  decltype(*std::begin(std::declval<const Range&>()))
+>::type;
+
+template <class, typename T>
+struct is_measurement_model_range_impl : std::false_type {};
+
+template <typename T>
+struct is_measurement_model_range_impl<
+  std::void_t<
+    decltype(std::begin(std::declval<const T&>())),
+    decltype(std::end(std::declval<const T&>()))
+  >, T
+> : std::is_base_of<
+      MeasurementModelBase<range_value_t<T>>, range_value_t<T>
+    > {};
+
+/**
+ * @brief Whether T is a range of measurement models
+ */
+template <typename T>
+struct is_measurement_model_range
+  : is_measurement_model_range_impl<void, T> {};
+
+template <typename T>
+using enable_if_is_measurement_model_range =
+  typename std::enable_if<is_measurement_model_range<T>::value>::type;
+
+/**
+ * @brief The size of a range if known at compile time,
+ * Eigen::Dynamic otherwise.
+ */
+template <typename T>
+struct static_range_size : std::integral_constant<int, Eigen::Dynamic> {};
+
+template <typename T, std::size_t N>
+struct static_range_size<std::array<T, N>>
+  : std::integral_constant<int, int(N)> {};
+
+template <typename T, std::size_t N>
+struct static_range_size<T[N]> : std::integral_constant<int, int(N)> {};
+
+/**
+ * @brief A range over pointed-to elements,
+ * e.g. to stack the update of measurement models held by pointer.
+ *
+ * @tparam T The element type
+ */
+template <typename T>
+struct IndirectRange {
+
+  struct iterator {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    reference operator *() const { return **it; }
+    pointer operator ->() const { return *it; }
+    iterator& operator ++() { ++it; return *this; }
+    iterator operator ++(int) { iterator tmp = *this; ++it; return tmp; }
+    bool operator ==(const iterator& other) const { return it == other.it; }
+    bool operator !=(const iterator& other) const { return it != other.it; }
+
+    const T* const* it;
+  };
+
+  iterator begin() const { return {first}; }
+  iterator end() const { return {last}; }
+
+  const T* const* first;
+  const T* const* last;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_RANGE_H_
@@ -1,45 +1,359 @@
 #ifndef _KALMANIF_KALMANIF_IMPL_RAUCH_TUNG_STRIEBEL_SMOOTHER_H_
 #define _KALMANIF_KALMANIF_IMPL_RAUCH_TUNG_STRIEBEL_SMOOTHER_H_
 
-#include <deque>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
 
 namespace kalmanif {
 
 // Forward declaration
 template <typename Derived> struct SystemModelBase;
+template <typename Filter> struct FilterCheckpoint;
 
 namespace internal {
 
 template <typename>
 struct is_unscented : std::false_type {};
 
-template <typename T>
-struct is_unscented<UnscentedKalmanFilterManifolds<T>> : std::true_type {};
+template <typename T, Invariance Iv, typename E, typename S>
+struct is_unscented<UnscentedKalmanFilterManifolds<T, Iv, E, S>>
+  : std::true_type {};
+
+template <typename T, Invariance Iv, typename E, typename S>
+struct is_unscented<SquareRootUnscentedKalmanFilterManifolds<T, Iv, E, S>>
+  : std::true_type {};
 
 template <typename>
 struct is_invariant : std::false_type {};
 
-template <typename T>
-struct is_invariant<UnscentedKalmanFilterManifolds<T>> : std::true_type {};
+template <typename T, Invariance Iv, typename E, typename S>
+struct is_invariant<UnscentedKalmanFilterManifolds<T, Iv, E, S>>
+  : std::true_type {};
+
+template <typename T, Invariance Iv, typename E, typename S>
+struct is_invariant<SquareRootUnscentedKalmanFilterManifolds<T, Iv, E, S>>
+  : std::true_type {};
+
+template <typename T, Invariance Iv, InnovationSolver Solver>
+struct is_invariant<InvariantExtendedKalmanFilter<T, Iv, Solver>>
+  : std::true_type {};
+
+template <typename>
+struct is_right_invariant : std::false_type {};
+
+template <typename T, typename E, typename S>
+struct is_right_invariant<
+  UnscentedKalmanFilterManifolds<T, Invariance::Right, E, S>
+> : std::true_type {};
+
+template <typename T, typename E, typename S>
+struct is_right_invariant<
+  SquareRootUnscentedKalmanFilterManifolds<T, Invariance::Right, E, S>
+> : std::true_type {};
+
+template <typename T, InnovationSolver Solver>
+struct is_right_invariant<
+  InvariantExtendedKalmanFilter<T, Invariance::Right, Solver>
+> : std::true_type {};
+
+/**
+ * @brief Whether the filter holds the square root of its predicted
+ * covariance once propagated, so that it needs not be recomputed.
+ */
+template <typename>
+struct has_predicted_square_root : std::false_type {};
 
 template <typename T>
-struct is_invariant<
-  InvariantExtendedKalmanFilter<T, Invariance::Right>
+struct has_predicted_square_root<SquareRootExtendedKalmanFilter<T>>
+  : std::true_type {};
+
+template <typename T, Invariance Iv, typename E, typename S>
+struct has_predicted_square_root<UnscentedKalmanFilterManifolds<T, Iv, E, S>>
+  : std::true_type {};
+
+template <typename T, Invariance Iv, typename E, typename S>
+struct has_predicted_square_root<
+  SquareRootUnscentedKalmanFilterManifolds<T, Iv, E, S>
 > : std::true_type {};
 
+/**
+ * @brief Whether the filter records the transposed transition, A = F^T.
+ */
 template <typename>
-struct is_right_invariant : std::false_type {};
+struct has_transposed_transition : std::false_type {};
+
+template <typename T, InnovationSolver Solver>
+struct has_transposed_transition<ExtendedKalmanFilter<T, Solver>>
+  : std::true_type {};
 
 template <typename T>
-struct is_right_invariant<UnscentedKalmanFilterManifolds<T>> : std::true_type {};
+struct has_transposed_transition<SquareRootExtendedKalmanFilter<T>>
+  : std::true_type {};
 
 template <typename T>
-struct is_right_invariant<
-  InvariantExtendedKalmanFilter<T, Invariance::Right>
-> : std::true_type {};
+struct has_transposed_transition<InformationKalmanFilter<T>>
+  : std::true_type {};
+
+/**
+ * @brief The filtering quantities of an epoch,
+ * i.e. of a propagation followed by an update.
+ *
+ * @tparam State The state type
+ * @tparam StoredCovariance The type the covariances are kept in,
+ * Covariance<State> or PackedCovariance<State>
+ */
+template <typename State, typename StoredCovariance = Covariance<State>>
+struct SmootherEpoch {
+  State x_pred, x_est;
+  StoredCovariance P_pred, P_est;
+  Jacobian<State, State> A;
+
+  //! Square root of P_pred, if the filter provides it
+  CovarianceSquareRoot<State> S_pred;
+
+  //! Time of the update, if time-stamped
+  double t = std::numeric_limits<double>::quiet_NaN();
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  /**
+   * @brief Solve P_pred * X = B.
+   *
+   * Reuses S_pred if the filter provided it,
+   * factorizes P_pred otherwise.
+   */
+  template <typename Filter, typename Derived>
+  Jacobian<State, State> solvePredicted(
+    const Eigen::MatrixBase<Derived>& B
+  ) const {
+    if constexpr (has_predicted_square_root<Filter>{}) {
+      return S_pred.solve(B);
+    } else {
+      return unpacked(P_pred).llt().solve(B);
+    }
+  }
+};
+
+/**
+ * @brief Compose the transition A of an epoch, accumulated since
+ * the last update, with the transition of a new propagation,
+ * so that A is the transition of a single propagation over both.
+ *
+ * The unscented filters hold the cross-covariance C = P F^T of
+ * the errors before and after the propagation rather than
+ * the transition, it composes through the intermediate prediction,
+ * \f$ C_{02} = P_0 F_1^T F_2^T = C_{01} P_1^{-1} C_{12} \f$.
+ *
+ * @tparam Filter The underlying filter type
+ * @param [in,out] e The epoch, of prediction the one before
+ * the new propagation
+ * @param [in] A_next The transition of the new propagation
+ */
+template <
+  typename Filter, typename State, typename StoredCovariance,
+  typename _DerivedNext
+>
+void composeTransition(
+  SmootherEpoch<State, StoredCovariance>& e,
+  const Eigen::MatrixBase<_DerivedNext>& A_next
+) {
+  if constexpr (is_unscented<Filter>{}) {
+    e.A = e.A * e.template solvePredicted<Filter>(A_next);
+  } else if constexpr (has_transposed_transition<Filter>{}) {
+    // (F_next.F)^T = F^T.F_next^T
+    e.A = e.A * A_next;
+  } else {
+    e.A = A_next * e.A;
+  }
+}
+
+/**
+ * @brief The Rauch-Tung-Striebel smoother gain between epochs k and k+1,
+ * \f$ K_s = P_k F^T P_{k+1}^{-1} \f$ with F the transition
+ * of the propagations from k to k+1, held by the epoch k+1.
+ *
+ * @tparam Filter The underlying filter type
+ * @param [in] e The epoch k
+ * @param [in] e_next The epoch k+1
+ * @return The smoother gain
+ */
+template <typename Filter, typename State, typename StoredCovariance>
+Jacobian<State, State> smootherGain(
+  const SmootherEpoch<State, StoredCovariance>& e,
+  const SmootherEpoch<State, StoredCovariance>& e_next
+) {
+  // The covariances being symmetric, the gains are obtained
+  // from a Cholesky solve rather than from an explicit inverse,
+  // Ks = P F^T P_pred^-1 <=> Ks^T = P_pred^-1 F P
+  if constexpr (is_unscented<Filter>{}) {
+    // A = C = P F^T
+    return e_next.template solvePredicted<Filter>(
+      e_next.A.transpose()
+    ).transpose();
+  } else if constexpr (has_transposed_transition<Filter>{}) {
+    // A = F^T
+    return e_next.template solvePredicted<Filter>(
+      e_next.A.transpose() * unpacked(e.P_est)
+    ).transpose();
+  } else {
+    return e_next.template solvePredicted<Filter>(
+      e_next.A * unpacked(e.P_est)
+    ).transpose();
+  }
+}
+
+/**
+ * @brief A Rauch-Tung-Striebel backward step,
+ * from the smoothed estimate at k+1 to the smoothed estimate at k.
+ *
+ * @tparam Filter The underlying filter type
+ * @param [in] e The epoch k
+ * @param [in] e_next The epoch k+1
+ * @param [in,out] Xs The smoothed state at k+1, then at k
+ * @param [in,out] Ps The smoothed covariance at k+1, then at k
+ */
+template <typename Filter, typename State, typename StoredCovariance>
+void smoothEpoch(
+  const SmootherEpoch<State, StoredCovariance>& e,
+  const SmootherEpoch<State, StoredCovariance>& e_next,
+  State& Xs,
+  Covariance<State>& Ps
+) {
+  // Compute smoother gain
+  const Jacobian<State, State> Ks_ = smootherGain<Filter>(e, e_next);
+
+  // Compute smoothed states
+  if constexpr (!is_invariant<Filter>{}) {
+    // See [2]
+    Xs = e.x_est + (Ks_ * ( Xs - e_next.x_pred ));
+  // See [1]
+  } else if (is_right_invariant<Filter>{}) {
+    Xs = -(Ks_ * ( e_next.x_pred.lminus(Xs) )) + e.x_est;
+  } else {
+    Xs = e.x_est + (-(Ks_ * ( e_next.x_pred - Xs )));
+  }
+
+  // Compute smoothed covariances, see [2] Alg. 9.1 and [1],
+  // exactly symmetric so that round-off does not accumulate backward
+  Ps -= unpacked(e_next.P_pred);
+  Ps = covarianceProduct(Ks_, Ps, unpacked(e.P_est));
+}
+
+/**
+ * @brief Interpolate the smoothed estimate between two epochs,
+ * along the geodesic \f$ x = x_0 \oplus \alpha (x_1 \ominus x_0) \f$.
+ *
+ * The covariances are carried to the tangent space at x and blended,
+ * \f$ P = (1-\alpha) Ad_0 P_0 Ad_0^T + \alpha Ad_1 P_1 Ad_1^T \f$,
+ * a first order approximation between close epochs.
+ * The errors of the right-invariant filters being global,
+ * they need not be carried.
+ *
+ * @tparam Filter The underlying filter type
+ * @param [in] x0 The smoothed state before
+ * @param [in] P0 The smoothed covariance before
+ * @param [in] x1 The smoothed state after
+ * @param [in] P1 The smoothed covariance after
+ * @param [in] alpha The interpolation parameter, in [0, 1]
+ * @param [out] x The interpolated state
+ * @param [out] P The interpolated covariance
+ */
+template <typename Filter, typename State, typename Scalar>
+void interpolateSmoothed(
+  const State& x0, const Covariance<State>& P0,
+  const State& x1, const Covariance<State>& P1,
+  const Scalar alpha,
+  State& x, Covariance<State>& P
+) {
+  const auto d = x1 - x0;
+
+  x = x0 + (d * alpha);
+
+  if constexpr (is_right_invariant<Filter>{}) {
+    P = (Scalar(1) - alpha) * P0 + alpha * P1;
+  } else {
+    // x = x0.Exp(a.d) = x1.Exp(-(1-a).d)
+    const Jacobian<State, State> Ad0 = (d * -alpha).exp().adj();
+    const Jacobian<State, State> Ad1 = (d * (Scalar(1) - alpha)).exp().adj();
+    P = covarianceProduct(
+      Ad0, ((Scalar(1) - alpha) * P0).eval(), Ad1, (alpha * P1).eval()
+    );
+  }
+}
 
 } // namespace internal
 
+/**
+ * @brief The default smoother storage policy,
+ * keeping the epochs and the smoothed sequence in memory.
+ *
+ * A storage policy provides a 'container<T>' type with the subset of
+ * the std::vector interface used by the smoother, and a
+ * 'container<T> make<T>(const char* name) const' factory.
+ *
+ * @see MappedFileStorage
+ */
+struct InMemoryStorage {
+
+  template <typename T>
+  using container = std::vector<T, Eigen::aligned_allocator<T>>;
+
+  template <typename T>
+  container<T> make(const char* /*name*/) const {
+    return container<T>();
+  }
+};
+
+/**
+ * @brief A storage policy keeping the covariances of the epochs
+ * and of the smoothed sequence packed, see PackedCovariance.
+ *
+ * It cuts the memory (and bandwidth) of the covariances by
+ * about 45% for 9x9 covariances, they are unpacked on use.
+ *
+ * @tparam Storage The underlying storage policy
+ */
+template <typename Storage = InMemoryStorage>
+struct PackedStorage : Storage {
+
+  using Storage::Storage;
+
+  PackedStorage() = default;
+  PackedStorage(const Storage& storage) : Storage(storage) {}
+
+  template <typename State>
+  using covariance = PackedCovariance<State>;
+};
+
+/**
+ * @brief A storage policy keeping the covariances of the epochs
+ * and of the smoothed sequence compressed, see CompressedCovariance.
+ *
+ * The covariances are decoded on use, e.g. in the backward pass.
+ * For 9x9 covariances (e.g. SE_2_3), it cuts their memory by about
+ * 70% (Float and Cholesky) or 85% (Cholesky16), within
+ * CompressedCovariance::ErrorBound.
+ *
+ * @tparam Codec The covariances encoding
+ * @tparam Storage The underlying storage policy
+ */
+template <
+  CovarianceCodec Codec = CovarianceCodec::Cholesky,
+  typename Storage = InMemoryStorage
+>
+struct CompressedStorage : Storage {
+
+  using Storage::Storage;
+
+  CompressedStorage() = default;
+  CompressedStorage(const Storage& storage) : Storage(storage) {}
+
+  template <typename State>
+  using covariance = CompressedCovariance<State, Codec>;
+};
+
 /**
  * @brief The Rauch-Tung-Striebel Smoother
  *
@@ -47,24 +361,79 @@ struct is_right_invariant<
  * "The Invariant Rauch-Tung-Striebel Smoother" N. Laan et al. [1]
  * "Bayesian Filtering and Smoothing" S. Särkkä [2]
  *
+ * The epochs may be time-stamped, see update(const double t, ...),
+ * so that the smoothed estimate is queried at any time in between,
+ * see getSmoothed and smoothAt.
+ *
  * @tparam Filter The underlying filter type.
+ * @tparam Storage The storage policy of the epochs and smoothed sequence.
  */
-template <typename Filter>
+template <typename Filter, typename Storage = InMemoryStorage>
 struct RauchTungStriebelSmoother {
 
   template <typename T>
-  using deque_t = std::deque<T, Eigen::aligned_allocator<T>>;
+  using vector_t = InMemoryStorage::container<T>;
+
+  template <typename T>
+  using container_t = typename Storage::template container<T>;
 
   using State = typename Filter::State;
+  using Scalar = typename internal::traits<State>::Scalar;
+
+  //! The type the covariances are kept in, see PackedStorage
+  using StoredCovariance =
+    typename internal::storage_covariance<Storage, State>::type;
+
+protected:
+
+  using Epoch = internal::SmootherEpoch<State, StoredCovariance>;
+
+public:
+
+  /**
+   * @brief A snapshot of the smoother, see snapshot
+   */
+  struct Snapshot {
+    typename Filter::Snapshot filter;
+    //! The last epoch, the only one a propagation or update modifies
+    Epoch epoch;
+    std::size_t epochs = 0;
+    std::size_t estimated = 0;
+    bool propagated = false;
+    bool updated = true;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+  };
 
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
 
   KALMANIF_DEFAULT_CONSTRUCTOR(RauchTungStriebelSmoother);
 
+  /**
+   * @brief Construct a smoother
+   * @param state_init The initial state
+   * @param cov_init The initial covariance
+   * @param storage The storage policy instance
+   */
   RauchTungStriebelSmoother(
     const State& state_init,
-    const Eigen::Ref<const Covariance<State>>& cov_init
-  ) : filter_(state_init, cov_init) { }
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const Storage& storage = Storage()
+  ) : filter_(state_init, cov_init)
+    , epochs_(storage.template make<Epoch>("epochs"))
+    , Xsk_(storage.template make<State>("states"))
+    , Psk_(storage.template make<StoredCovariance>("covariances")) { }
+
+  /**
+   * @brief Reserve the storage for n epochs so that
+   * neither the forward nor the backward pass allocates.
+   * @param n The number of epochs
+   */
+  void reserve(const std::size_t n) {
+    epochs_.reserve(n);
+    Xsk_.reserve(n);
+    Psk_.reserve(n);
+  }
 
   /**
    * @brief Performs the underlying filter's propagation.
@@ -76,21 +445,34 @@ struct RauchTungStriebelSmoother {
     Args&&... args
   ) {
 
-    const State& xtmp = filter_.propagate(f, u, std::forward<Args>(args)...);
-    const Covariance<State> Ptmp = filter_.getCovariance();
-    const Jacobian<State, State>& Aktmp = filter_.getA();
+    {
+      // The filter records its transition in our storage
+      const internal::ScopedOutput<Jacobian<State, State>> transition(
+        filter_.transition_, &Ak_
+      );
+      filter_.propagate(f, u, std::forward<Args>(args)...);
+    }
+    const Jacobian<State, State>& Aktmp = Ak_;
+
+    // A lazy filter records the transition since the last update
+    const bool lazy = internal::isLazyPropagation(filter_);
+
+    modified(epochs_.size() + (updated_ ? 1 : 0));
 
     if (updated_) {
-      Xfk_pred_.emplace_back(xtmp);
-      Pfk_pred_.emplace_back(Ptmp);
-      Ak_.emplace_back(Aktmp);
+      epochs_.emplace_back();
+      epochs_.back().A = Aktmp;
       updated_ = false;
+    } else if (lazy) {
+      epochs_.back().A = Aktmp;
     } else {
-      Xfk_pred_.back() = xtmp;
-      Pfk_pred_.back() = Ptmp;
+      internal::composeTransition<Filter>(epochs_.back(), Aktmp);
+    }
 
-      // @todo This does not work
-      Ak_.back() = Aktmp * Ak_.back();
+    // A lazy filter prediction is only recorded before the update,
+    // so that its covariance is not materialized at each propagation
+    if (!lazy) {
+      recordPrediction();
     }
 
     propagated_ = true;
@@ -108,82 +490,233 @@ struct RauchTungStriebelSmoother {
     Args&&... args
   ) {
 
-    const State& xtmp = filter_.update(h, y, std::forward<Args>(args)...);
-    const Covariance<State>& Ptmp = filter_.getCovariance();
+    if (propagated_ && internal::isLazyPropagation(filter_)) {
+      recordPrediction();
+    }
 
-    if (propagated_) {
-      Xfk_est_.emplace_back(xtmp);
-      Pfk_est_.emplace_back(Ptmp);
-      propagated_ = false;
-    } else {
-      Xfk_est_.back() = xtmp;
-      Pfk_est_.back() = Ptmp;
+    filter_.update(h, y, std::forward<Args>(args)...);
+
+    recordUpdate();
+
+    return filter_.getState();
+  }
+
+  /**
+   * @brief Performs the underlying filter's stacked update.
+   */
+  template <
+    class MeasurementModelRange,
+    class MeasurementRange,
+    typename = internal::enable_if_is_measurement_model_range<
+      MeasurementModelRange
+    >
+  >
+  const State& update(
+    const MeasurementModelRange& hs,
+    const MeasurementRange& ys
+  ) {
+
+    if (propagated_ && internal::isLazyPropagation(filter_)) {
+      recordPrediction();
     }
 
-    updated_ = true;
+    filter_.update(hs, ys);
+
+    recordUpdate();
 
     return filter_.getState();
   }
 
+  /**
+   * @brief Performs the underlying filter's update
+   * and time-stamps its epoch.
+   *
+   * @param [in] t The measurement time
+   * @throw kalmanif::invalid_argument if t is before the previous epoch
+   */
+  template <typename MeasurementModelDerived, typename... Args>
+  const State& update(
+    const double t,
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    Args&&... args
+  ) {
+    checkTime(t);
+    update(h, y, std::forward<Args>(args)...);
+    epochs_.back().t = t;
+    return filter_.getState();
+  }
+
+  /**
+   * @brief Performs the underlying filter's stacked update
+   * and time-stamps its epoch.
+   *
+   * @param [in] t The measurements time
+   * @throw kalmanif::invalid_argument if t is before the previous epoch
+   */
+  template <
+    class MeasurementModelRange,
+    class MeasurementRange,
+    typename = internal::enable_if_is_measurement_model_range<
+      MeasurementModelRange
+    >
+  >
+  const State& update(
+    const double t,
+    const MeasurementModelRange& hs,
+    const MeasurementRange& ys
+  ) {
+    checkTime(t);
+    update(hs, ys);
+    epochs_.back().t = t;
+    return filter_.getState();
+  }
+
   /**
    * @brief Run the batch backward pass - the smoothing.
    * @return The smoothed state sequence.
+   *
+   * @note The epochs are streamed backward through contiguous memory
+   * and the smoothed sequence is written in place. It does not allocate
+   * if the storage was reserved beforehand.
    */
-  const deque_t<State>& smooth() {
+  const container_t<State>& smooth() {
 
-    Xsk_.clear();
-    Psk_.clear();
+    const std::size_t n = estimated_;
+
+    Xsk_.resize(n);
+    Psk_.resize(n);
 
-    if (Xfk_est_.empty())
+    if (n == 0)
       return Xsk_;
 
     // Initialize the smoother
-    Xsk_.emplace_back(Xfk_est_.back());
-    Psk_.emplace_back(Pfk_est_.back());
-
-    // smoother gain
-    Jacobian<State, State> Ks_;
+    State Xs = epochs_[n-1].x_est;
+    Covariance<State> Ps = internal::unpacked(epochs_[n-1].P_est);
+    Xsk_[n-1] = Xs;
+    Psk_[n-1] = Ps;
 
     // Smoothing routine
-    for (std::size_t j = Xfk_est_.size() - 1; j > 0; --j) {
-
-      std::size_t k = j - 1;
-
-      // Compute smoother gain
-      if constexpr (internal::is_unscented<Filter>{}) {
-        Ks_ = Ak_[k] * Pfk_pred_[k].inverse();
-      } else {
-        Ks_ = Pfk_est_[k] * Ak_[k].transpose() * Pfk_pred_[k+1].inverse();
-      }
-
-      // Compute smoothed states and covariances
-      if constexpr (!internal::is_invariant<Filter>{}) {
-        // See [2]
-        Xsk_.emplace_front(
-          Xfk_est_[k] + (Ks_ * ( Xsk_.front() - Xfk_pred_[k+1] ))
-        );
-        Psk_.emplace_front(
-          // See [2] Alg. 9.1
-          Pfk_est_[k] + Ks_ * ( Psk_.front() - Pfk_pred_[k+1] ) * Ks_.transpose()
-      );
-      // See [1]
-      } else if (internal::is_right_invariant<Filter>{}) {
-        Xsk_.emplace_front(
-          -(Ks_ * ( Xfk_pred_[k+1].lminus(Xsk_.front()) )) + Xfk_est_[k]
-        );
-        Psk_.emplace_front(
-          Pfk_est_[k] - Ks_ * ( Pfk_pred_[k+1] - Psk_.front() ) * Ks_.transpose() // paper
-      );
-      } else {
-        Xsk_.emplace_front(
-          Xfk_est_[k] + (-(Ks_ * ( Xfk_pred_[k+1] - Xsk_.front() )))
-        );
-        Psk_.emplace_front(
-          Pfk_est_[k] - Ks_ * ( Pfk_pred_[k+1] - Psk_.front() ) * Ks_.transpose() // paper
-      );
-      }
+    for (std::size_t k = n - 1; k-- > 0;) {
+      internal::smoothEpoch<Filter>(epochs_[k], epochs_[k+1], Xs, Ps);
+      Xsk_[k] = Xs;
+      Psk_[k] = Ps;
     }
 
+    stable_ = n;
+    fresh_ = 0;
+
+    return Xsk_;
+  }
+
+  /**
+   * @brief Run the backward pass incrementally, only as far back
+   * as the smoothed estimates change.
+   *
+   * The backward pass stops at the first epoch, already smoothed
+   * and unchanged since, whose smoothed state and covariance change
+   * by less than the tolerance - the earlier smoothed estimates
+   * being then left as is. Refreshing the smoothed sequence of
+   * a growing history thus costs about the new epochs only.
+   *
+   * @param [in] tolerance The largest change of the smoothed state
+   * (norm of the tangent) and covariance (largest coefficient)
+   * for the backward pass to stop
+   * @return The smoothed state sequence.
+   *
+   * @note With a zero tolerance, it is the batch smooth().
+   */
+  const container_t<State>& smooth(const Scalar tolerance) {
+
+    const std::size_t n = estimated_;
+
+    // The smoothed estimates the backward pass may stop at
+    const std::size_t stable = std::min(stable_, Xsk_.size());
+
+    Xsk_.resize(n);
+    Psk_.resize(n);
+
+    if (n == 0)
+      return Xsk_;
+
+    State Xs = epochs_[n-1].x_est;
+    Covariance<State> Ps = internal::unpacked(epochs_[n-1].P_est);
+    Xsk_[n-1] = Xs;
+    Psk_[n-1] = Ps;
+
+    for (std::size_t k = n - 1; k-- > 0;) {
+      internal::smoothEpoch<Filter>(epochs_[k], epochs_[k+1], Xs, Ps);
+
+      const bool converged = k < stable &&
+        (Xs - Xsk_[k]).coeffs().norm() <= tolerance &&
+        (Ps - internal::unpacked(Psk_[k])).cwiseAbs().maxCoeff() <= tolerance;
+
+      Xsk_[k] = Xs;
+      Psk_[k] = Ps;
+
+      if (converged)
+        break;
+    }
+
+    stable_ = n;
+    fresh_ = 0;
+
+    return Xsk_;
+  }
+
+  /**
+   * @brief Run the backward pass over the epochs [first, last) only.
+   *
+   * The window is smoothed given the measurements up to
+   * the epoch last-1, that is, from its filtered estimate.
+   * With last the number of epochs, the window is thus that of
+   * the batch smooth(). The other smoothed estimates are left as is.
+   *
+   * @param [in] first The first epoch of the window
+   * @param [in] last The epoch past the window
+   * @return The smoothed state sequence.
+   * @throw kalmanif::invalid_argument if the window is empty
+   * or past the last epoch
+   */
+  const container_t<State>& smooth(
+    const std::size_t first, const std::size_t last
+  ) {
+    const bool valid = first < last && last <= estimated_;
+    KALMANIF_CHECK(
+      valid,
+      "RauchTungStriebelSmoother: Invalid smoothing window!",
+      kalmanif::invalid_argument
+    );
+
+    // In real-time mode the check does not throw
+    if (!valid) {
+      return Xsk_;
+    }
+
+    if (Xsk_.size() < last) {
+      stable_ = std::min(stable_, Xsk_.size());
+      Xsk_.resize(last);
+      Psk_.resize(last);
+    }
+
+    State Xs = epochs_[last-1].x_est;
+    Covariance<State> Ps = internal::unpacked(epochs_[last-1].P_est);
+    Xsk_[last-1] = Xs;
+    Psk_[last-1] = Ps;
+
+    for (std::size_t k = last - 1; k-- > first;) {
+      internal::smoothEpoch<Filter>(epochs_[k], epochs_[k+1], Xs, Ps);
+      Xsk_[k] = Xs;
+      Psk_[k] = Ps;
+    }
+
+    // The window does not follow from the smoothed estimates after it
+    stable_ = std::min(stable_, first);
+
+    // Only a trailing window is smoothed given all the measurements
+    fresh_ = last == estimated_ ?
+      std::min(fresh_, first) : std::max(fresh_, last);
+
     return Xsk_;
   }
 
@@ -191,38 +724,260 @@ struct RauchTungStriebelSmoother {
     return filter_.getState();
   }
 
-  const Covariance<State>& getCovariance() const {
+  //! By value if the filter reconstructs it from its square root
+  decltype(auto) getCovariance() const {
     return filter_.getCovariance();
   }
 
-  const deque_t<State>& getStates() const {
+  const container_t<State>& getStates() const {
     return Xsk_;
   }
 
-  const deque_t<Covariance<State>>& getCovariances() const {
+  /**
+   * @brief The smoothed covariances,
+   * packed if the storage policy packs them, see PackedStorage.
+   */
+  const container_t<StoredCovariance>& getCovariances() const {
     return Psk_;
   }
 
+  /**
+   * @brief Get the smoothed estimate at the time t, interpolated
+   * between the smoothed estimates of the epochs around t,
+   * see internal::interpolateSmoothed.
+   *
+   * The epochs are found by bisection of their time-stamps,
+   * in O(log n). See smoothAt to smooth them as needed.
+   *
+   * @param [in] t The time
+   * @param [out] x The smoothed state at t
+   * @param [out] P The smoothed covariance at t
+   * @return Whether t is within the time-stamped epochs
+   * and the epochs around it are smoothed given all the measurements
+   */
+  bool getSmoothed(const double t, State& x, Covariance<State>& P) const {
+    const std::size_t k = findEpoch(t);
+    if (k >= estimated_ || k < fresh_) {
+      return false;
+    }
+
+    if (k + 1 == estimated_ || !(t > epochs_[k].t)) {
+      x = Xsk_[k];
+      P = internal::unpacked(Psk_[k]);
+      return true;
+    }
+
+    const double alpha = (t - epochs_[k].t) / (epochs_[k+1].t - epochs_[k].t);
+
+    internal::interpolateSmoothed<Filter>(
+      Xsk_[k], internal::unpacked(Psk_[k]),
+      Xsk_[k+1], internal::unpacked(Psk_[k+1]),
+      Scalar(alpha), x, P
+    );
+    return true;
+  }
+
+  /**
+   * @brief Get the smoothed estimate at the time t, smoothing first
+   * the epochs from t onward if they are not smoothed given
+   * all the measurements, see getSmoothed.
+   *
+   * Only the epochs from t onward are smoothed, see smooth(first, last).
+   *
+   * @param [in] t The time
+   * @param [out] x The smoothed state at t
+   * @param [out] P The smoothed covariance at t
+   * @return Whether t is within the time-stamped epochs
+   */
+  bool smoothAt(const double t, State& x, Covariance<State>& P) {
+    const std::size_t k = findEpoch(t);
+    if (k >= estimated_) {
+      return false;
+    }
+
+    if (k < fresh_) {
+      smooth(k, estimated_);
+    }
+
+    return getSmoothed(t, x, P);
+  }
+
+  /**
+   * @brief Record the smoother state, so that tentative
+   * propagations and updates can be rolled back.
+   *
+   * Only the filter estimate and the last epoch are recorded,
+   * the epochs added afterward are dropped on rollback.
+   * Neither allocates for fixed-size states.
+   *
+   * @param [out] snapshot The snapshot
+   * @see rollback, UndoBuffer
+   */
+  void snapshot(Snapshot& snapshot) const {
+    filter_.snapshot(snapshot.filter);
+    snapshot.epochs = epochs_.size();
+    if (!epochs_.empty()) {
+      snapshot.epoch = epochs_.back();
+    }
+    snapshot.estimated = estimated_;
+    snapshot.propagated = propagated_;
+    snapshot.updated = updated_;
+  }
+
+  /**
+   * @brief Roll the smoother back to a snapshot.
+   *
+   * The smoothed sequence is left as is until the next smooth().
+   *
+   * @param [in] snapshot The snapshot
+   * @throw kalmanif::invalid_argument if the smoother
+   * was cleared since the snapshot
+   */
+  void rollback(const Snapshot& snapshot) {
+    const bool valid = snapshot.epochs <= epochs_.size();
+    KALMANIF_CHECK(
+      valid,
+      "RauchTungStriebelSmoother: Cannot roll back past a clear!",
+      kalmanif::invalid_argument
+    );
+
+    // In real-time mode the check does not throw
+    if (!valid) {
+      return;
+    }
+
+    filter_.rollback(snapshot.filter);
+    epochs_.resize(snapshot.epochs);
+    if (!epochs_.empty()) {
+      epochs_.back() = snapshot.epoch;
+    }
+    estimated_ = snapshot.estimated;
+    propagated_ = snapshot.propagated;
+    updated_ = snapshot.updated;
+    modified(snapshot.epochs);
+    fresh_ = npos;
+  }
+
   void clear() {
-    Xfk_pred_.clear();
-    Xfk_est_.clear();
+    epochs_.clear();
     Xsk_.clear();
-    Pfk_pred_.clear();
-    Pfk_est_.clear();
     Psk_.clear();
-    Ak_.clear();
+    estimated_ = 0;
+    stable_ = 0;
+    fresh_ = npos;
+    propagated_ = false;
+    updated_ = true;
   }
 
 protected:
 
+  template <typename> friend struct FilterCheckpoint;
+
+  /**
+   * @brief Mark the last of n epochs modified,
+   * see smooth(const Scalar).
+   */
+  void modified(const std::size_t n) {
+    stable_ = std::min(stable_, n > 0 ? n - 1 : 0);
+
+    // Any estimated epoch modified changes all the smoothed estimates
+    if (n > 0 && n - 1 < estimated_) {
+      fresh_ = npos;
+    }
+  }
+
+  /**
+   * @brief Check that the time t does not precede the previous epoch.
+   */
+  void checkTime(const double t) const {
+    // The epoch to be updated, none if there was no propagation
+    const std::size_t k = propagated_ ? estimated_ : estimated_ - 1;
+    KALMANIF_CHECK(
+      k == 0 || k > estimated_ || !(t < epochs_[k-1].t),
+      "RauchTungStriebelSmoother::update: Epochs must be in sequence!",
+      kalmanif::invalid_argument
+    );
+  }
+
+  /**
+   * @brief The index k of the estimated epoch such that
+   * \f$ t_k \le t < t_{k+1} \f$, estimated_ if none.
+   */
+  std::size_t findEpoch(const double t) const {
+    if (estimated_ == 0 || t < epochs_[0].t || t > epochs_[estimated_-1].t) {
+      return estimated_;
+    }
+
+    const auto begin = epochs_.begin();
+    const auto it = std::upper_bound(
+      begin, begin + estimated_, t,
+      [](const double t, const Epoch& e) { return t < e.t; }
+    );
+    return std::size_t(std::distance(begin, it)) - 1;
+  }
+
+  /**
+   * @brief Record the underlying filter's predicted state and covariance.
+   */
+  void recordPrediction() {
+    modified(epochs_.size());
+    epochs_.back().x_pred = filter_.getState();
+    epochs_.back().P_pred = filter_.getCovariance();
+
+    if constexpr (internal::has_predicted_square_root<Filter>{}) {
+      epochs_.back().S_pred = filter_.getCovarianceSquareRoot();
+    }
+  }
+
+  /**
+   * @brief Record the underlying filter's updated state and covariance.
+   */
+  void recordUpdate() {
+    KALMANIF_ASSERT(
+      !epochs_.empty(),
+      "RauchTungStriebelSmoother: update before any propagation!"
+    );
+
+    if (propagated_) {
+      ++estimated_;
+      propagated_ = false;
+    }
+
+    modified(epochs_.size());
+
+    epochs_.back().x_est = filter_.getState();
+    epochs_.back().P_est = filter_.getCovariance();
+
+    updated_ = true;
+  }
+
   bool propagated_ = false;
   bool updated_ = true;
 
   Filter filter_;
 
-  deque_t<State> Xfk_pred_, Xfk_est_, Xsk_;
-  deque_t<Covariance<State>> Pfk_pred_, Pfk_est_, Psk_;
-  deque_t<Jacobian<State, State>> Ak_;
+  //! Filtering epochs, contiguous
+  container_t<Epoch> epochs_;
+
+  //! Number of epochs with an estimate
+  std::size_t estimated_ = 0;
+
+  //! Smoothed states and covariances
+  container_t<State> Xsk_;
+  container_t<StoredCovariance> Psk_;
+
+  //! Number of leading smoothed estimates that follow one another
+  //! through the epochs as they are, see smooth(const Scalar)
+  std::size_t stable_ = 0;
+
+  static constexpr std::size_t npos = std::size_t(-1);
+
+  //! The first of the trailing smoothed estimates given all
+  //! the measurements, see smoothAt
+  std::size_t fresh_ = npos;
+
+  //! The transition of the last propagation, recorded by the filter
+  Jacobian<State, State> Ak_ = Jacobian<State, State>::Zero();
 };
 
 } // kalmanif
@@ -0,0 +1,577 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_REPLAY_ENGINE_H_
+#define _KALMANIF_KALMANIF_IMPL_REPLAY_ENGINE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace kalmanif {
+
+/**
+ * @brief The options of a ReplayEngine.
+ */
+struct ReplayOptions {
+  //! The number of logs replayed concurrently
+  std::size_t concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+  //! The number of decoded inputs queued ahead of the filter of a log
+  std::size_t queue_capacity = 1024;
+  //! The number of finished trajectories queued ahead of the output
+  std::size_t output_capacity = 16;
+  //! Whether the trajectories are smoothed, filtered otherwise
+  bool smooth = true;
+};
+
+/**
+ * @brief A log to replay.
+ *
+ * @tparam State The state type
+ */
+template <typename State>
+struct ReplayJob {
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  //! The path of the measurement log
+  std::string input;
+  //! The path of the trajectory log written, none if empty
+  std::string output;
+  //! The time of the initial estimate
+  double t_init = 0;
+  //! The initial estimate
+  State x_init = State::Identity();
+  Covariance<State> P_init = Covariance<State>::Identity();
+};
+
+/**
+ * @brief The throughput of a replay.
+ */
+struct ReplayStatistics {
+  //! The number of logs replayed
+  std::size_t logs = 0;
+  //! The number of epochs, that is, of inputs replayed
+  std::size_t epochs = 0;
+  //! The wall time of the replay, in seconds
+  double seconds = 0;
+  //! The number of epochs of each log, in job order
+  std::vector<std::size_t> log_epochs;
+
+  //! The throughput in epochs per second
+  double epochsPerSecond() const {
+    return seconds > 0 ? double(epochs) / seconds : 0.;
+  }
+};
+
+namespace internal {
+
+/**
+ * @brief A decoded input of a replay, its coefficients copied
+ * out of the mapped log.
+ */
+template <typename Scalar>
+struct ReplayInput {
+  double t = 0;
+  std::uint32_t stream = 0;
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 1> coeffs;
+  //! Whether this marks the end of the log
+  bool end = false;
+};
+
+/**
+ * @brief A stream of inputs of a replay, applying them
+ * to the smoother of a log.
+ */
+template <typename Smoother>
+struct ReplayStreamBase {
+
+  using Scalar = typename internal::traits<
+    typename Smoother::State
+  >::Scalar;
+
+  virtual ~ReplayStreamBase() = default;
+
+  //! Whether the stream holds measurements, controls otherwise
+  virtual bool isMeasurement() const = 0;
+
+  /**
+   * @brief Apply an input
+   * @param smoother The smoother of the log
+   * @param t The input time
+   * @param dt The time elapsed since the last input
+   * @param coeffs The input coefficients
+   */
+  virtual void apply(
+    Smoother& smoother, const double t, const double dt,
+    const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& coeffs
+  ) const = 0;
+};
+
+//! Decode the coefficients of an input
+template <typename Input, typename Coeffs>
+Input decodeInput(const Coeffs& coeffs) {
+  KALMANIF_ENSURE(
+    coeffs.size() == internal::traits<Input>::Size,
+    "ReplayEngine: The record does not hold this stream input type!"
+  );
+
+  Input input;
+  if constexpr (is_eigen_matrix<Input>::value) {
+    input = coeffs.template cast<typename Input::Scalar>();
+  } else {
+    input.coeffs() = coeffs.template cast<typename Input::Scalar>();
+  }
+  return input;
+}
+
+} // namespace internal
+
+/**
+ * @brief An offline replay engine of recorded measurement logs.
+ *
+ * Each log is replayed through a pipeline of stages running
+ * concurrently,
+ * - decode: a thread reads the memory-mapped log and decodes its
+ *   records into a bounded lock-free queue,
+ * - propagate / update: the worker thread of the log pops the inputs
+ *   and runs them through a RauchTungStriebelSmoother,
+ * - smooth: the worker runs the backward pass once the log is done,
+ *   then hands the trajectory over and moves on to its next log,
+ * - output: a single thread writes the trajectories of all the workers
+ *   to their trajectory logs.
+ *
+ * Several logs are replayed at once, one per worker thread.
+ *
+ * @code
+ * ReplayEngine<EKF> replay;
+ * replay.addControlStream(system_model);         // stream 0
+ * replay.addMeasurementStream(measurement_model); // stream 1
+ * const auto statistics = replay.run(jobs);
+ * std::cout << statistics.epochsPerSecond() << std::endl;
+ * @endcode
+ *
+ * @note The models are held by reference for the engine lifetime
+ * and are used concurrently by the workers, they must thus be safe
+ * to evaluate concurrently (e.g. not caching a jacobian per dt).
+ *
+ * @tparam Filter The filter type
+ *
+ * @see MeasurementLogWriter
+ * @see TrajectoryLogWriter
+ */
+template <typename Filter>
+class ReplayEngine {
+
+public:
+
+  using State = typename internal::traits<Filter>::State;
+  using Scalar = typename internal::traits<State>::Scalar;
+  using Smoother = RauchTungStriebelSmoother<Filter>;
+  using Job = ReplayJob<State>;
+
+  explicit ReplayEngine(const ReplayOptions& options = ReplayOptions())
+    : options_(options) {
+    KALMANIF_ENSURE(
+      options_.concurrency > 0,
+      "ReplayEngine: The concurrency must be positive!",
+      kalmanif::invalid_argument
+    );
+  }
+
+  /**
+   * @brief Add a stream of controls propagating the filter,
+   * its index being the number of streams added before it.
+   * @param f The system model
+   * @return The stream index
+   */
+  template <typename SystemModel>
+  std::uint32_t addControlStream(const SystemModel& f) {
+    streams_.push_back(std::make_unique<ControlStream<SystemModel>>(f));
+    return std::uint32_t(streams_.size() - 1);
+  }
+
+  /**
+   * @brief Add a stream of measurements updating the filter,
+   * its index being the number of streams added before it.
+   * @param h The measurement model
+   * @return The stream index
+   */
+  template <typename MeasurementModel>
+  std::uint32_t addMeasurementStream(const MeasurementModel& h) {
+    streams_.push_back(
+      std::make_unique<MeasurementStream<MeasurementModel>>(h)
+    );
+    return std::uint32_t(streams_.size() - 1);
+  }
+
+  /**
+   * @brief Replay logs
+   *
+   * @param jobs The logs to replay
+   * @return The replay throughput
+   * @throw The first exception thrown by a stage,
+   * e.g. kalmanif::runtime_error if a log cannot be read.
+   */
+  ReplayStatistics run(const std::vector<Job>& jobs) {
+    const auto start = std::chrono::steady_clock::now();
+
+    ReplayStatistics statistics;
+    statistics.logs = jobs.size();
+    statistics.log_epochs.assign(jobs.size(), 0);
+
+    next_job_.store(0, std::memory_order_relaxed);
+    workers_left_.store(0, std::memory_order_relaxed);
+    failed_.store(false, std::memory_order_relaxed);
+    error_ = nullptr;
+
+    const std::size_t num_workers = std::min(options_.concurrency, jobs.size());
+
+    MpscQueue<std::shared_ptr<Output>> outputs(options_.output_capacity);
+
+    workers_left_.store(num_workers, std::memory_order_release);
+
+    std::thread output_thread([&](){ writeOutputs(outputs); });
+
+    std::vector<std::thread> workers;
+    workers.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; ++i) {
+      workers.emplace_back([&](){
+        work(jobs, outputs, statistics.log_epochs);
+        workers_left_.fetch_sub(1, std::memory_order_acq_rel);
+      });
+    }
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    output_thread.join();
+
+    if (error_) {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+    for (const std::size_t epochs : statistics.log_epochs) {
+      statistics.epochs += epochs;
+    }
+
+    statistics.seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start
+    ).count();
+
+    return statistics;
+  }
+
+  const ReplayOptions& getOptions() const {
+    return options_;
+  }
+
+protected:
+
+  using Input = internal::ReplayInput<Scalar>;
+  using Stream = internal::ReplayStreamBase<Smoother>;
+
+  template <typename SystemModel> class ControlStream;
+  template <typename MeasurementModel> class MeasurementStream;
+
+  //! A finished trajectory, handed to the output stage
+  struct Output {
+    std::string path;
+    std::vector<double> times;
+    std::vector<State, Eigen::aligned_allocator<State>> states;
+    std::vector<
+      Covariance<State>, Eigen::aligned_allocator<Covariance<State>>
+    > covariances;
+  };
+
+  //! Replay the jobs not claimed yet by another worker
+  void work(
+    const std::vector<Job>& jobs,
+    MpscQueue<std::shared_ptr<Output>>& outputs,
+    std::vector<std::size_t>& log_epochs
+  ) {
+    try {
+      std::size_t j;
+      while (!failed_.load(std::memory_order_acquire) &&
+             (j = next_job_.fetch_add(1, std::memory_order_acq_rel)) <
+               jobs.size()) {
+        std::shared_ptr<Output> output = replay(jobs[j], log_epochs[j]);
+        if (output) {
+          while (!outputs.push(output)) {
+            std::this_thread::yield();
+          }
+        }
+      }
+    } catch (...) {
+      fail(std::current_exception());
+    }
+  }
+
+  /**
+   * @brief Replay a log, decoded in a thread of its own
+   * @return The trajectory to write, if any
+   */
+  std::shared_ptr<Output> replay(const Job& job, std::size_t& epochs) {
+    MeasurementLogReader<Scalar> reader(job.input);
+
+    SpscQueue<Input> inputs(options_.queue_capacity);
+    std::atomic<bool> stop{false};
+
+    // decode
+    std::thread decoder([&](){
+      try {
+        Input input;
+        for (std::size_t i = 0; i < reader.size(); ++i) {
+          input.t = reader.time(i);
+          input.stream = reader.stream(i);
+          input.coeffs = reader.payload(i);
+          if (!pushInput(inputs, input, stop)) {
+            return;
+          }
+        }
+        input.end = true;
+        pushInput(inputs, input, stop);
+      } catch (...) {
+        fail(std::current_exception());
+        stop.store(true, std::memory_order_release);
+      }
+    });
+
+    // propagate / update
+    auto output = std::make_shared<Output>();
+    output->path = job.output;
+
+    Smoother smoother(job.x_init, job.P_init);
+    smoother.reserve(reader.size());
+    output->times.reserve(reader.size());
+
+    try {
+      double t = job.t_init;
+      bool propagated = false;
+      Input input;
+
+      while (true) {
+        if (!inputs.pop(input)) {
+          if (stop.load(std::memory_order_acquire)) {
+            break;
+          }
+          std::this_thread::yield();
+          continue;
+        }
+
+        if (input.end) {
+          break;
+        }
+
+        KALMANIF_ENSURE(
+          input.stream < streams_.size(),
+          "ReplayEngine: '" + job.input + "' holds an unknown stream!"
+        );
+
+        const Stream& stream = *streams_[input.stream];
+
+        if (stream.isMeasurement()) {
+          KALMANIF_ENSURE(
+            propagated || !output->times.empty(),
+            "ReplayEngine: '" + job.input + "' starts with a measurement!"
+          );
+
+          stream.apply(smoother, input.t, input.t - t, input.coeffs);
+
+          // Updates in a row share the epoch of the last propagation
+          if (propagated) {
+            output->times.push_back(input.t);
+          } else {
+            output->times.back() = input.t;
+          }
+          propagated = false;
+
+          if (!options_.smooth) {
+            if (output->states.size() < output->times.size()) {
+              output->states.push_back(smoother.getState());
+              output->covariances.push_back(smoother.getCovariance());
+            } else {
+              output->states.back() = smoother.getState();
+              output->covariances.back() = smoother.getCovariance();
+            }
+          }
+        } else {
+          stream.apply(smoother, input.t, input.t - t, input.coeffs);
+          propagated = true;
+        }
+
+        t = input.t;
+        ++epochs;
+      }
+    } catch (...) {
+      stop.store(true, std::memory_order_release);
+      decoder.join();
+      throw;
+    }
+
+    stop.store(true, std::memory_order_release);
+    decoder.join();
+
+    if (failed_.load(std::memory_order_acquire) || job.output.empty()) {
+      return nullptr;
+    }
+
+    // smooth
+    if (options_.smooth) {
+      smoother.smooth();
+      const auto& states = smoother.getStates();
+      output->states.assign(states.begin(), states.end());
+      output->covariances.reserve(output->states.size());
+      for (const auto& P : smoother.getCovariances()) {
+        output->covariances.push_back(internal::unpacked(P));
+      }
+    }
+
+    return output;
+  }
+
+  //! Push a decoded input, unless the replay of the log stopped
+  static bool pushInput(
+    SpscQueue<Input>& inputs, const Input& input, const std::atomic<bool>& stop
+  ) {
+    while (!inputs.push(input)) {
+      if (stop.load(std::memory_order_acquire)) {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+    return true;
+  }
+
+  //! Write the trajectories until all the workers are done
+  void writeOutputs(MpscQueue<std::shared_ptr<Output>>& outputs) {
+    std::shared_ptr<Output> output;
+    while (true) {
+      if (!outputs.pop(output)) {
+        // The outputs pushed before the last worker was done are popped
+        if (workers_left_.load(std::memory_order_acquire) > 0) {
+          std::this_thread::yield();
+          continue;
+        }
+        if (!outputs.pop(output)) {
+          break;
+        }
+      }
+
+      try {
+        TrajectoryLogWriter<State> writer(output->path);
+        for (std::size_t k = 0; k < output->states.size(); ++k) {
+          writer.write(
+            output->times[k], output->states[k], output->covariances[k]
+          );
+        }
+      } catch (...) {
+        fail(std::current_exception());
+      }
+
+      output.reset();
+    }
+  }
+
+  //! Record the first error and stop the workers
+  void fail(std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    if (!error_) {
+      error_ = error;
+    }
+    failed_.store(true, std::memory_order_release);
+  }
+
+  ReplayOptions options_;
+
+  std::vector<std::unique_ptr<Stream>> streams_;
+
+  std::atomic<std::size_t> next_job_{0};
+  std::atomic<std::size_t> workers_left_{0};
+  std::atomic<bool> failed_{false};
+
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+};
+
+/**
+ * @brief A replayed stream of controls
+ *
+ * The time elapsed since the last input is forwarded to the
+ * propagation if the system model propagates over a time step,
+ * see internal::has_time_step_evaluation.
+ *
+ * @tparam SystemModel The system model type
+ */
+template <typename Filter>
+template <typename SystemModel>
+class ReplayEngine<Filter>::ControlStream
+  : public internal::ReplayStreamBase<Smoother> {
+
+public:
+
+  using Control = typename internal::traits<SystemModel>::Control;
+
+  explicit ControlStream(const SystemModel& f) : f_(f) {}
+
+  bool isMeasurement() const override {
+    return false;
+  }
+
+  void apply(
+    Smoother& smoother, const double, const double dt,
+    const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& coeffs
+  ) const override {
+    const Control u = internal::decodeInput<Control>(coeffs);
+    if constexpr (internal::has_time_step_evaluation<SystemModel>::value) {
+      smoother.propagate(f_, u, dt);
+    } else {
+      (void)dt;
+      smoother.propagate(f_, u);
+    }
+  }
+
+protected:
+
+  const SystemModel& f_;
+};
+
+/**
+ * @brief A replayed stream of measurements
+ *
+ * @tparam MeasurementModel The measurement model type
+ */
+template <typename Filter>
+template <typename MeasurementModel>
+class ReplayEngine<Filter>::MeasurementStream
+  : public internal::ReplayStreamBase<Smoother> {
+
+public:
+
+  using Measurement = typename internal::traits<MeasurementModel>::Measurement;
+
+  explicit MeasurementStream(const MeasurementModel& h) : h_(h) {}
+
+  bool isMeasurement() const override {
+    return true;
+  }
+
+  void apply(
+    Smoother& smoother, const double t, const double,
+    const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& coeffs
+  ) const override {
+    smoother.update(t, h_, internal::decodeInput<Measurement>(coeffs));
+  }
+
+protected:
+
+  const MeasurementModel& h_;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_REPLAY_ENGINE_H_
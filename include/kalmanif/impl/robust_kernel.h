@@ -0,0 +1,161 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_ROBUST_KERNEL_H_
+#define _KALMANIF_KALMANIF_IMPL_ROBUST_KERNEL_H_
+
+namespace kalmanif {
+
+/**
+ * @brief Enum for the loss of a robust update
+ */
+enum class RobustLoss : char {
+  Huber = 0, // Quadratic then linear, weight k/r beyond the width
+  Cauchy     // Logarithmic, weight 1/(1 + (r/k)^2)
+};
+
+/**
+ * @brief An M-estimator kernel for the robust updates.
+ *
+ * Rather than rejecting an outlier as a MahalanobisGate does,
+ * a robust update inflates its noise \f$ R/w \f$ by the weight \f$ w \f$
+ * of the kernel at the residual \f$ r \f$ of the update, the norm of
+ * \f$ y - h(x^+) \f$ in the metric of \f$ R \f$.
+ * Since the residual depends on the weight, the latter is found
+ * by iteratively re-weighted least squares (IRLS), starting from
+ * the unweighted update, for a fixed number of iterations.
+ *
+ * The width is that of the residual norm, the usual 95% efficiency
+ * widths (Huber 1.345, Cauchy 2.3849) are those of a scalar measurement
+ * and may be scaled by the square root of the measurement size.
+ */
+struct RobustKernel {
+  //! The loss
+  RobustLoss loss = RobustLoss::Huber;
+  //! The residual norm from which measurements are down-weighted
+  double width = 1.345;
+  //! The number of re-weighting iterations, none is a plain update
+  unsigned int iterations = 3;
+
+  /**
+   * @brief The weight of the measurement noise at a residual norm.
+   * @param [in] r The residual norm
+   * @return The weight in ]0, 1]
+   */
+  double weight(const double r) const {
+    switch (loss) {
+      case RobustLoss::Huber:
+        return r <= width ? 1. : width / r;
+      case RobustLoss::Cauchy: {
+        const double u = r / width;
+        return 1. / (1. + u * u);
+      }
+    }
+    return 1.;
+  }
+};
+
+namespace internal {
+
+/**
+ * @brief The re-weighting iterations of a robust update.
+ *
+ * With \f$ R = L L^T \f$ and \f$ L^{-1} H P H^T L^{-T} = U D U^T \f$,
+ * the weighted innovation covariance is
+ * \f$ S_w = H P H^T + R/w = L U (D + I/w) U^T L^T \f$.
+ * This single factorization of the measurement size thus gives
+ * the residual norm of any weight in O(m) and the gain in O(m^2.n),
+ * without re-linearizing the model nor decomposing \f$ S_w \f$.
+ *
+ * @tparam StateType The state type, see use_closed_form
+ * @tparam _MatrixType The measurement covariance type
+ */
+template <typename StateType, typename _MatrixType>
+struct RobustReweighting {
+
+  using MatrixType = typename _MatrixType::PlainObject;
+  using Scalar = typename MatrixType::Scalar;
+  using Vector = Eigen::Matrix<
+    Scalar, MatrixType::RowsAtCompileTime, 1,
+    Eigen::ColMajor, MatrixType::MaxRowsAtCompileTime, 1
+  >;
+
+  /**
+   * @brief Factorize the innovation covariance.
+   *
+   * @param [in] HPHt The projected state covariance \f$ H P H^T \f$
+   * @param [in] R The measurement noise covariance
+   * @param [in] z The innovation
+   */
+  template <typename _DerivedHPHt, typename _DerivedR, typename _DerivedZ>
+  RobustReweighting(
+    const Eigen::MatrixBase<_DerivedHPHt>& HPHt,
+    const Eigen::MatrixBase<_DerivedR>& R,
+    const Eigen::MatrixBase<_DerivedZ>& z
+  ) {
+    const StateLLT<StateType, MatrixType> llt(R);
+
+    KALMANIF_ASSERT(
+      llt.info() == Eigen::Success,
+      "RobustReweighting: Measurement noise is not positive definite."
+    );
+
+    // A = L^-1.HPHt.L^-T, HPHt being symmetric
+    MatrixType A = llt.matrixL().solve(HPHt);
+    A = llt.matrixL().solve(A.transpose()).eval();
+
+    Eigen::SelfAdjointEigenSolver<MatrixType> eigensolver;
+    computeEigen<StateType>(eigensolver, A);
+
+    // G = L^-T.U so that S_w^-1 = G.(D + I/w)^-1.G^T
+    D_ = eigensolver.eigenvalues().cwiseMax(Scalar(0));
+    G_ = llt.matrixU().solve(eigensolver.eigenvectors());
+    y_ = G_.transpose() * z;
+  }
+
+  /**
+   * @brief The norm of the residual after an update of weight w,
+   * in the metric of R.
+   */
+  Scalar residualNorm(const Scalar w) const {
+    return (y_.array() / (Scalar(1) + w * D_.array())).matrix().norm();
+  }
+
+  /**
+   * @brief Iterate the weight of the measurement noise.
+   * @param [in] kernel The robust kernel
+   * @return The weight
+   */
+  Scalar reweight(const RobustKernel& kernel) {
+    w_ = Scalar(1);
+    for (unsigned int i = 0; i < kernel.iterations; ++i) {
+      w_ = Scalar(kernel.weight(double(residualNorm(w_))));
+    }
+    return w_;
+  }
+
+  /**
+   * @brief The transposed kalman gain \f$ S_w^{-1} H P \f$
+   * @param [in] HP The product of the measurement jacobian
+   * and the state covariance
+   */
+  template <typename _DerivedHP>
+  auto gain(const Eigen::MatrixBase<_DerivedHP>& HP) const {
+    return G_ * (
+      (D_.array() + Scalar(1) / w_).inverse().matrix().asDiagonal() *
+      (G_.transpose() * HP)
+    );
+  }
+
+  Scalar weight() const {
+    return w_;
+  }
+
+protected:
+
+  Vector D_, y_;
+  MatrixType G_;
+  Scalar w_ = Scalar(1);
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_ROBUST_KERNEL_H_
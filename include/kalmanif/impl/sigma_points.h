@@ -0,0 +1,506 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_SIGMA_POINTS_H_
+#define _KALMANIF_KALMANIF_IMPL_SIGMA_POINTS_H_
+
+#include <ratio>
+#include <type_traits>
+
+namespace kalmanif {
+
+/**
+ * @brief The symmetric set of 2n sigma points,
+ * \f$ \pm\sqrt{n} e_i \f$ of weights 1/(2n).
+ *
+ * A sigma point scheme provides 'count(n)', the number of sigma points,
+ * the mean excluded, and 'unit(points, weights)', the unit sigma points
+ * of zero weighted mean and identity weighted covariance, of weights
+ * summing to one. A scheme of 'UniformWeights' also provides their
+ * common weight 'unitWeight(n)', which the filters fold into their kernels.
+ *
+ * @see SigmaPointSet
+ */
+struct SymmetricSigmaPoints {
+
+  static constexpr bool UniformWeights = true;
+
+  static constexpr int count(const int n) {
+    return 2 * n;
+  }
+
+  static constexpr double unitWeight(const int n) {
+    return 1. / (2. * n);
+  }
+
+  template <typename _DerivedP, typename _DerivedW>
+  static void unit(
+    Eigen::MatrixBase<_DerivedP>& points,
+    Eigen::MatrixBase<_DerivedW>& weights
+  ) {
+    using Scalar = typename _DerivedP::Scalar;
+    using std::sqrt;
+
+    const int n = int(points.rows());
+    const Scalar s = sqrt(Scalar(n));
+
+    points.setZero();
+    points.leftCols(n).diagonal().setConstant(s);
+    points.rightCols(n).diagonal().setConstant(-s);
+    weights.setConstant(Scalar(1) / Scalar(2 * n));
+  }
+};
+
+/**
+ * @brief The spherical simplex set of n+1 sigma points,
+ * all of weight 1/(n+1) and at the same distance from the mean.
+ *
+ * Half the model evaluations of the symmetric set,
+ * for a third order error on the odd moments.
+ *
+ * @see S. Julier, The spherical simplex unscented transformation, 2003.
+ */
+struct SphericalSimplexSigmaPoints {
+
+  static constexpr bool UniformWeights = true;
+
+  static constexpr int count(const int n) {
+    return n + 1;
+  }
+
+  static constexpr double unitWeight(const int n) {
+    return 1. / (n + 1.);
+  }
+
+  template <typename _DerivedP, typename _DerivedW>
+  static void unit(
+    Eigen::MatrixBase<_DerivedP>& points,
+    Eigen::MatrixBase<_DerivedW>& weights
+  ) {
+    using Scalar = typename _DerivedP::Scalar;
+    using std::sqrt;
+
+    const int n = int(points.rows());
+    const Scalar w = Scalar(1) / Scalar(n + 1);
+
+    points.setZero();
+    points(0, 0) = -Scalar(1) / sqrt(Scalar(2) * w);
+    points(0, 1) = Scalar(1) / sqrt(Scalar(2) * w);
+
+    // each dimension j adds a point, spreading the previous ones along it
+    for (int j = 2; j <= n; ++j) {
+      const Scalar s = Scalar(1) / sqrt(Scalar(j * (j + 1)) * w);
+      points.row(j - 1).head(j).setConstant(-s);
+      points(j - 1, j) = Scalar(j) * s;
+    }
+
+    weights.setConstant(w);
+  }
+};
+
+/**
+ * @brief The minimal skew simplex set of n+1 sigma points,
+ * of zero skew but of weights spanning a 2^(n-1) ratio.
+ *
+ * @see S. Julier, J. Uhlmann, Reduced sigma point filters
+ * for the propagation of means and covariances
+ * through nonlinear transformations, 2002.
+ */
+struct MinimalSkewSigmaPoints {
+
+  static constexpr bool UniformWeights = false;
+
+  static constexpr int count(const int n) {
+    return n + 1;
+  }
+
+  template <typename _DerivedP, typename _DerivedW>
+  static void unit(
+    Eigen::MatrixBase<_DerivedP>& points,
+    Eigen::MatrixBase<_DerivedW>& weights
+  ) {
+    using Scalar = typename _DerivedP::Scalar;
+    using std::ldexp;
+    using std::sqrt;
+
+    const int n = int(points.rows());
+
+    weights(0) = ldexp(Scalar(1), -n);
+    weights(1) = weights(0);
+    for (int i = 2; i <= n; ++i) {
+      weights(i) = ldexp(weights(0), i - 1);
+    }
+
+    points.setZero();
+    points(0, 0) = -Scalar(1) / sqrt(Scalar(2) * weights(0));
+    points(0, 1) = Scalar(1) / sqrt(Scalar(2) * weights(0));
+
+    for (int j = 2; j <= n; ++j) {
+      const Scalar s = Scalar(1) / sqrt(Scalar(2) * weights(j));
+      points.row(j - 1).head(j).setConstant(-s);
+      points(j - 1, j) = s;
+    }
+  }
+};
+
+/**
+ * @brief A sigma point scheme of compile-time unscented parameters.
+ *
+ * Passed as the sigma point scheme of a filter, the weights of the sigma
+ * points are compile-time constants and the sigma points are computed
+ * once per filter type.
+ *
+ * @tparam Scheme The sigma point scheme
+ * @tparam AlphaD The propagation state sigma points spread, a std::ratio
+ * @tparam AlphaQ The propagation noise sigma points spread, a std::ratio
+ * @tparam AlphaU The update state sigma points spread, a std::ratio
+ */
+template <
+  typename Scheme,
+  typename AlphaD = std::ratio<1, 1000>,
+  typename AlphaQ = AlphaD,
+  typename AlphaU = AlphaD
+>
+struct StaticSigmaPoints {};
+
+namespace internal {
+
+//! A constexpr square root, by Newton iterations
+template <typename Scalar>
+constexpr Scalar constexprSqrt(const Scalar a) {
+  // decreasing from above the root until round-off
+  Scalar x = a < Scalar(1) ? Scalar(1) : a;
+  Scalar next = (x + a / x) / Scalar(2);
+  while (next < x) {
+    x = next;
+    next = (x + a / x) / Scalar(2);
+  }
+  return x;
+}
+
+//! The value of a std::ratio
+template <typename Ratio, typename Scalar>
+constexpr Scalar ratioValue() {
+  return Scalar(Ratio::num) / Scalar(Ratio::den);
+}
+
+/**
+ * @brief The sigma point scheme and unscented parameters of
+ * a filter sigma point argument, either a scheme, of runtime parameters,
+ * or StaticSigmaPoints.
+ */
+template <typename SigmaPoints, typename Scalar>
+struct sigma_point_parameters {
+  using Scheme = SigmaPoints;
+  using AlphaD = void;
+  using AlphaQ = void;
+  using AlphaU = void;
+  static constexpr bool Static = false;
+  static constexpr Scalar alpha_d = Constants<Scalar>::ukfm_alpha;
+  static constexpr Scalar alpha_q = Constants<Scalar>::ukfm_alpha;
+  static constexpr Scalar alpha_u = Constants<Scalar>::ukfm_alpha;
+};
+
+template <
+  typename _Scheme, typename _AlphaD, typename _AlphaQ, typename _AlphaU,
+  typename Scalar
+>
+struct sigma_point_parameters<
+  StaticSigmaPoints<_Scheme, _AlphaD, _AlphaQ, _AlphaU>, Scalar
+> {
+  using Scheme = _Scheme;
+  using AlphaD = _AlphaD;
+  using AlphaQ = _AlphaQ;
+  using AlphaU = _AlphaU;
+  static constexpr bool Static = true;
+  static constexpr Scalar alpha_d = ratioValue<AlphaD, Scalar>();
+  static constexpr Scalar alpha_q = ratioValue<AlphaQ, Scalar>();
+  static constexpr Scalar alpha_u = ratioValue<AlphaU, Scalar>();
+};
+
+/**
+ * @brief The weights of the scaled unscented transform, with beta = 2,
+ * for the sigma points of a scheme in dimension N.
+ */
+template <typename Scalar, int N, typename Scheme>
+struct SigmaPointSetBase {
+
+  static_assert(
+    N != Eigen::Dynamic,
+    "SigmaPointSet: The dimension must be fixed!"
+  );
+
+  static constexpr int Count = Scheme::count(N);
+  static constexpr bool UniformWeights = Scheme::UniformWeights;
+  static constexpr bool Symmetric =
+    std::is_same<Scheme, SymmetricSigmaPoints>::value;
+
+  using Points = Eigen::Matrix<Scalar, N, Count>;
+  using Weights = Eigen::Matrix<Scalar, Count, 1>;
+
+  //! The weight of the mean in the mean
+  static constexpr Scalar meanWeight(const Scalar alpha) {
+    return Scalar(1) - Scalar(1) / (alpha * alpha);
+  }
+
+  //! The weight of the mean in the covariance
+  static constexpr Scalar covarianceWeight(const Scalar alpha) {
+    return meanWeight(alpha) + Scalar(3) - alpha * alpha;
+  }
+
+  //! The common weight of the sigma points of a uniform scheme
+  static constexpr Scalar uniformWeight(const Scalar alpha) {
+    if constexpr (UniformWeights) {
+      return Scalar(Scheme::unitWeight(N)) / (alpha * alpha);
+    } else {
+      return Scalar(0);
+    }
+  }
+
+  //! The distance of the symmetric sigma points to the mean, in std
+  static constexpr Scalar symmetricSpread(const Scalar alpha) {
+    return alpha * constexprSqrt(Scalar(N));
+  }
+
+  //! The sigma points of the scheme scaled by alpha
+  static Points scaledPoints(const Scalar alpha) {
+    Points points;
+    Weights weights;
+    Scheme::unit(points, weights);
+    return points * alpha;
+  }
+
+  //! The weights of the scheme scaled by alpha
+  static Weights scaledWeights(const Scalar alpha) {
+    Points points;
+    Weights weights;
+    Scheme::unit(points, weights);
+    return weights / (alpha * alpha);
+  }
+};
+
+} // namespace internal
+
+/**
+ * @brief The precomputed sigma points and weights of a scheme
+ * in dimension N, scaled by alpha.
+ *
+ * Given the lower Cholesky factor L of a covariance P,
+ * the sigma points about the mean are L * points, of weights 'weights'.
+ * The mean has the weights wm in the mean and w0 in the covariance.
+ *
+ * If Alpha is a std::ratio, the spread is fixed at compile time,
+ * wm, w0, 'weight' and 'spread' are constexpr
+ * and the points and weights are static.
+ *
+ * @tparam Scalar The scalar type
+ * @tparam N The dimension
+ * @tparam Scheme The sigma point scheme
+ * @tparam Alpha The compile-time spread, void if set at runtime
+ *
+ * @see SymmetricSigmaPoints
+ * @see SphericalSimplexSigmaPoints
+ * @see MinimalSkewSigmaPoints
+ * @see StaticSigmaPoints
+ */
+template <typename Scalar, int N, typename Scheme, typename Alpha = void>
+struct SigmaPointSet : internal::SigmaPointSetBase<Scalar, N, Scheme> {
+
+  using Base = internal::SigmaPointSetBase<Scalar, N, Scheme>;
+  using typename Base::Points;
+  using typename Base::Weights;
+
+  static constexpr Scalar alpha = internal::ratioValue<Alpha, Scalar>();
+
+  static_assert(
+    alpha >= Scalar(1e-3) && alpha <= Scalar(1),
+    "SigmaPointSet: The spread must be in [1e-3, 1]!"
+  );
+
+  static constexpr Scalar wm = Base::meanWeight(alpha);
+  static constexpr Scalar w0 = Base::covarianceWeight(alpha);
+  static constexpr Scalar weight = Base::uniformWeight(alpha);
+  static constexpr Scalar spread = Base::symmetricSpread(alpha);
+
+  // computed once, shared by all the sets of that type
+  static inline const Points points = Base::scaledPoints(alpha);
+  static inline const Weights weights = Base::scaledWeights(alpha);
+};
+
+template <typename Scalar, int N, typename Scheme>
+struct SigmaPointSet<Scalar, N, Scheme, void>
+  : internal::SigmaPointSetBase<Scalar, N, Scheme> {
+
+  using Base = internal::SigmaPointSetBase<Scalar, N, Scheme>;
+  using typename Base::Points;
+  using typename Base::Weights;
+
+  SigmaPointSet() = default;
+
+  explicit SigmaPointSet(const Scalar alpha) {
+    KALMANIF_ASSERT(alpha >= Scalar(1e-3) && alpha <= Scalar(1));
+
+    Scheme::unit(points, weights);
+
+    // the scaled unscented transform, with beta = 2
+    points *= alpha;
+    weights /= alpha * alpha;
+    wm = Base::meanWeight(alpha);
+    w0 = Base::covarianceWeight(alpha);
+    weight = Base::uniformWeight(alpha);
+    spread = Base::symmetricSpread(alpha);
+  }
+
+  Points points;
+  Weights weights;
+  Scalar wm;
+  Scalar w0;
+  Scalar weight;
+  Scalar spread;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+};
+
+namespace internal {
+
+//! The points of a set, if they are read
+template <typename Points, bool Stored>
+struct SigmaPointStorage {
+  Points points;
+};
+
+template <typename Points>
+struct SigmaPointStorage<Points, false> {};
+
+//! The weights of a set, if they are read
+template <typename Weights, bool Stored>
+struct SigmaWeightStorage {
+  Weights weights;
+};
+
+template <typename Weights>
+struct SigmaWeightStorage<Weights, false> {};
+
+/**
+ * @brief A runtime SigmaPointSet holding only what sigmaPoints,
+ * sigmaSum and sigmaWeighted read: the points but for the symmetric
+ * scheme and the weights but for a uniform scheme.
+ *
+ * The filters keep their precomputed sets in it,
+ * the symmetric set is then a few scalars rather than
+ * an N x 2N matrix and 2N weights.
+ */
+template <typename Scalar, int N, typename Scheme>
+struct CompactSigmaPointSet
+  : SigmaPointSetBase<Scalar, N, Scheme>
+  , SigmaPointStorage<
+      typename SigmaPointSetBase<Scalar, N, Scheme>::Points,
+      !SigmaPointSetBase<Scalar, N, Scheme>::Symmetric
+    >
+  , SigmaWeightStorage<
+      typename SigmaPointSetBase<Scalar, N, Scheme>::Weights,
+      !SigmaPointSetBase<Scalar, N, Scheme>::UniformWeights
+    > {
+
+  using Base = SigmaPointSetBase<Scalar, N, Scheme>;
+
+  CompactSigmaPointSet() = default;
+
+  explicit CompactSigmaPointSet(const Scalar alpha) {
+    const SigmaPointSet<Scalar, N, Scheme> set(alpha);
+    if constexpr (!Base::Symmetric) {
+      this->points = set.points;
+    }
+    if constexpr (!Base::UniformWeights) {
+      this->weights = set.weights;
+    }
+    wm = set.wm;
+    w0 = set.w0;
+    weight = set.weight;
+    spread = set.spread;
+  }
+
+  Scalar wm;
+  Scalar w0;
+  Scalar weight;
+  Scalar spread;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+};
+
+/**
+ * @brief The set a filter stores, compact if its spread
+ * is set at runtime, see CompactSigmaPointSet.
+ */
+template <typename Scalar, int N, typename Scheme, typename Alpha>
+using StoredSigmaPointSet = std::conditional_t<
+  std::is_void<Alpha>::value,
+  CompactSigmaPointSet<Scalar, N, Scheme>,
+  SigmaPointSet<Scalar, N, Scheme, Alpha>
+>;
+
+/**
+ * @brief The sigma points about the mean given the lower Cholesky
+ * factor L of the covariance, \f$ \pm s L \f$ for the symmetric set.
+ */
+template <typename Set, typename CholeskyFactor>
+typename Set::Points sigmaPoints(const Set& set, const CholeskyFactor& L) {
+  constexpr int N = Set::Points::RowsAtCompileTime;
+  typename Set::Points xis;
+  if constexpr (Set::Symmetric) {
+    xis.template leftCols<N>() = L;
+    xis.template leftCols<N>() *= set.spread;
+    xis.template rightCols<N>() = -xis.template leftCols<N>();
+  } else {
+    xis.noalias() = L * set.points;
+  }
+  return xis;
+}
+
+/**
+ * @brief The weighted sum of the images of the sigma points,
+ * one per column of X.
+ */
+template <typename Set, typename _DerivedX>
+Eigen::Matrix<
+  typename _DerivedX::Scalar, _DerivedX::RowsAtCompileTime, 1
+> sigmaSum(const Set& set, const Eigen::MatrixBase<_DerivedX>& X) {
+  if constexpr (Set::UniformWeights) {
+    return set.weight * X.rowwise().sum();
+  } else {
+    return X * set.weights;
+  }
+}
+
+/**
+ * @brief The images of the sigma points weighted column-wise.
+ */
+template <typename Set, typename _DerivedX>
+typename _DerivedX::PlainObject sigmaWeighted(
+  const Set& set, const Eigen::MatrixBase<_DerivedX>& X
+) {
+  if constexpr (Set::UniformWeights) {
+    return set.weight * X;
+  } else {
+    return X * set.weights.asDiagonal();
+  }
+}
+
+/**
+ * @brief The images of the sigma points weighted column-wise by the
+ * square roots of the weights, so that Y Y^T = sigmaWeighted(X) X^T.
+ * The weights of the sigma points, but w0, are positive in all schemes.
+ */
+template <typename Set, typename _DerivedX>
+typename _DerivedX::PlainObject sigmaSquareRootWeighted(
+  const Set& set, const Eigen::MatrixBase<_DerivedX>& X
+) {
+  using std::sqrt;
+  if constexpr (Set::UniformWeights) {
+    return sqrt(set.weight) * X;
+  } else {
+    return X * set.weights.cwiseSqrt().asDiagonal();
+  }
+}
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_SIGMA_POINTS_H_
@@ -0,0 +1,521 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_SLIDING_WINDOW_SMOOTHER_H_
+#define _KALMANIF_KALMANIF_IMPL_SLIDING_WINDOW_SMOOTHER_H_
+
+#include <array>
+#include <vector>
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief Whether the system model's run_linearized takes
+ * the time step as last argument.
+ */
+template <typename Model, typename Enable = void>
+struct has_timed_linearization : std::false_type {};
+
+template <typename Model>
+struct has_timed_linearization<
+  Model,
+  std::void_t<decltype(
+    std::declval<const Model&>().run_linearized(
+      std::declval<const typename traits<Model>::State&>(),
+      std::declval<const typename traits<Model>::Control&>(),
+      std::declval<Jacobian<
+        typename traits<Model>::State, typename traits<Model>::State
+      >&>(),
+      std::declval<Jacobian<
+        typename traits<Model>::State, typename traits<Model>::Control
+      >&>(),
+      typename traits<Model>::State::Scalar(1)
+    )
+  )>
+> : std::true_type {};
+
+} // namespace internal
+
+/**
+ * @brief The sliding-window smoother
+ *
+ * A Gauss-Newton smoother over the last Window epochs, an epoch being
+ * a propagation followed by its measurements. On each update, all
+ * the epochs of the window are re-linearized around their current
+ * estimates until the iterations budget is met.
+ *
+ * The normal equations of the window are block-tridiagonal,
+ * the dynamics only relating consecutive epochs. They are solved by
+ * a block forward elimination and back substitution, whose backward
+ * recursion of the marginal covariances is that of the
+ * Rauch-Tung-Striebel smoother in information form.
+ * Once the window is full, the oldest epoch is marginalized into
+ * a prior on the next one by a Schur complement.
+ * The cost of an iteration is thus O(Window.n^3),
+ * regardless of the run length.
+ *
+ * Errors are defined on the right, \f$ x = \hat{x} \oplus \delta \f$,
+ * as for the ExtendedKalmanFilter. For linear models, the estimate of
+ * the last epoch is that of the Kalman filter, and those of the window
+ * are the ones the RauchTungStriebelSmoother would produce.
+ *
+ * @note The models are held by pointer and must outlive their epochs.
+ * The propagated noise \f$ W Q W^T \f$ must be positive definite.
+ *
+ * @tparam SystemModel The system model type
+ * @tparam MeasurementModel The measurement model type
+ * @tparam Window The number of epochs kept in the window
+ *
+ * @see RauchTungStriebelSmoother
+ * @see FixedLagSmoother
+ */
+template <typename SystemModel, typename MeasurementModel, std::size_t Window>
+struct SlidingWindowSmoother : public internal::IterationBase {
+
+  static_assert(Window > 1, "SlidingWindowSmoother: Window must be > 1.");
+
+  using State = typename internal::traits<SystemModel>::State;
+  using Control = typename internal::traits<SystemModel>::Control;
+  using Measurement =
+    typename internal::traits<MeasurementModel>::Measurement;
+  using Scalar = typename State::Scalar;
+  using Tangent = typename State::Tangent;
+
+  using internal::IterationBase::getIterationSummary;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(SlidingWindowSmoother);
+
+  /**
+   * @brief Construct a smoother
+   * @param state_init The initial state
+   * @param cov_init The initial covariance
+   * @param budget The Gauss-Newton iterations budget of an update
+   */
+  SlidingWindowSmoother(
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const IterationBudget& budget = IterationBudget()
+  ) : budget_(budget) {
+    Eigen::LLT<Covariance<State>> llt(cov_init);
+
+    KALMANIF_CHECK(
+      llt.info() == Eigen::Success,
+      "SlidingWindowSmoother: cov_init is not positive definite!",
+      kalmanif::invalid_argument
+    );
+
+    prior_x_ = state_init;
+    prior_info_ = llt.solve(Covariance<State>::Identity());
+
+    size_ = 1;
+    back().x = state_init;
+    back().P = cov_init;
+  }
+
+  /**
+   * @brief Set the Gauss-Newton iterations budget of an update.
+   */
+  void setIterationBudget(const IterationBudget& budget) {
+    budget_ = budget;
+  }
+
+  /**
+   * @brief Start a new epoch, predicting its state.
+   *
+   * The oldest epoch is marginalized if the window is full.
+   *
+   * @param [in] f The system model
+   * @param [in] u The control
+   * @param [in] dt The time step, if the model takes one
+   * @return The predicted state
+   */
+  const State& propagate(
+    const SystemModel& f, const Control& u, const Scalar dt = 1
+  ) {
+    if (size_ == Window) {
+      marginalize();
+    }
+
+    const Epoch& prev = back();
+    Epoch& e = at(size_++);
+
+    e.f = &f;
+    e.u = u;
+    e.dt = dt;
+    e.measurements.clear();
+
+    Jacobian<State, State> F;
+    Jacobian<State, Control> W;
+    e.x = linearizeModel(e, prev.x, F, W);
+    e.P = internal::covarianceProduct(F, prev.P, W, f.getCovariance());
+
+    return e.x;
+  }
+
+  /**
+   * @brief Add a measurement to the last epoch and re-estimate the window.
+   *
+   * @param [in] h The measurement model
+   * @param [in] y The measurement
+   * @return The estimate of the last epoch
+   */
+  const State& update(const MeasurementModel& h, const Measurement& y) {
+    back().measurements.push_back({&h, y});
+    solve();
+    return getState();
+  }
+
+  /**
+   * @brief Add a stack of measurements to the last epoch
+   * and re-estimate the window once.
+   */
+  template <
+    class MeasurementModelRange,
+    class MeasurementRange,
+    typename = internal::enable_if_is_measurement_model_range<
+      MeasurementModelRange
+    >
+  >
+  const State& update(
+    const MeasurementModelRange& hs,
+    const MeasurementRange& ys
+  ) {
+    auto y_it = std::begin(ys);
+    for (auto h_it = std::begin(hs); h_it != std::end(hs); ++h_it, ++y_it) {
+      const MeasurementModel& h = *h_it;
+      back().measurements.push_back({&h, *y_it});
+    }
+    solve();
+    return getState();
+  }
+
+  /**
+   * @brief The estimate of the last epoch.
+   */
+  const State& getState() const {
+    return at(size_ - 1).x;
+  }
+
+  /**
+   * @brief The marginal covariance of the last epoch.
+   */
+  const Covariance<State>& getCovariance() const {
+    return at(size_ - 1).P;
+  }
+
+  /**
+   * @brief The number of epochs in the window.
+   */
+  std::size_t size() const {
+    return size_;
+  }
+
+  /**
+   * @brief The estimate of the i-th epoch of the window,
+   * from the oldest.
+   */
+  const State& getWindowState(const std::size_t i) const {
+    KALMANIF_ASSERT(i < size_, "SlidingWindowSmoother: index out of range!");
+    return at(i).x;
+  }
+
+  /**
+   * @brief The marginal covariance of the i-th epoch of the window,
+   * from the oldest.
+   */
+  const Covariance<State>& getWindowCovariance(const std::size_t i) const {
+    KALMANIF_ASSERT(i < size_, "SlidingWindowSmoother: index out of range!");
+    return at(i).P;
+  }
+
+protected:
+
+  using TangentVector = typename Tangent::DataType;
+  using MeasurementNoise = Covariance<Measurement>;
+
+  //! A measurement of an epoch
+  struct MeasurementFactor {
+    const MeasurementModel* h = nullptr;
+    Measurement y;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+  };
+
+  struct Epoch {
+    //! The estimate and its marginal covariance
+    State x;
+    Covariance<State> P;
+
+    //! The propagation into the epoch
+    const SystemModel* f = nullptr;
+    Control u;
+    Scalar dt = 1;
+
+    //! The measurements of the epoch
+    std::vector<
+      MeasurementFactor, Eigen::aligned_allocator<MeasurementFactor>
+    > measurements;
+
+    //! The normal equations blocks, diagonal D,
+    //! with the next epoch B, and gradient g
+    Covariance<State> D;
+    Jacobian<State, State> B;
+    TangentVector g, delta;
+
+    //! The eliminated diagonal block and G = S^-1.B
+    Eigen::LLT<Covariance<State>> S;
+    Jacobian<State, State> G;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+  };
+
+  Epoch& at(const std::size_t i) {
+    return epochs_[(first_ + i) % Window];
+  }
+
+  const Epoch& at(const std::size_t i) const {
+    return epochs_[(first_ + i) % Window];
+  }
+
+  Epoch& back() {
+    return at(size_ - 1);
+  }
+
+  /**
+   * @brief The propagation into the epoch e from x, and its jacobians.
+   */
+  State linearizeModel(
+    const Epoch& e,
+    const State& x,
+    Jacobian<State, State>& F,
+    Jacobian<State, Control>& W
+  ) const {
+    if constexpr (internal::has_timed_linearization<SystemModel>{}) {
+      return e.f->run_linearized(x, e.u, F, W, e.dt);
+    } else {
+      return e.f->run_linearized(x, e.u, F, W);
+    }
+  }
+
+  /**
+   * @brief Accumulate the factor of residual \f$ r \approx r_0 + J\delta \f$
+   * and information Omega into the normal equations.
+   */
+  template <typename _DerivedJ, typename _DerivedO, typename _DerivedR>
+  static void addFactor(
+    Covariance<State>& D,
+    TangentVector& g,
+    const Eigen::MatrixBase<_DerivedJ>& J,
+    const Eigen::MatrixBase<_DerivedO>& Omega,
+    const Eigen::MatrixBase<_DerivedR>& r0
+  ) {
+    const auto JtO = (J.transpose() * Omega).eval();
+    D.noalias() += JtO * J;
+    g.noalias() -= JtO * r0;
+  }
+
+  /**
+   * @brief Accumulate the prior on the oldest epoch.
+   */
+  void linearizePrior(
+    const Epoch& e, Covariance<State>& D, TangentVector& g
+  ) const {
+    Jacobian<State, State> J;
+    const Tangent r = e.x.rminus(prior_x_, J);
+    addFactor(D, g, J, prior_info_, r.coeffs());
+  }
+
+  /**
+   * @brief Accumulate the measurements of an epoch,
+   * \f$ r = y - h(x) \approx r_0 - H\delta \f$.
+   */
+  void linearizeMeasurements(
+    const Epoch& e, Covariance<State>& D, TangentVector& g
+  ) const {
+    Jacobian<Measurement, State> H;
+    Jacobian<Measurement, Measurement> V;
+
+    for (const MeasurementFactor& m : e.measurements) {
+      const Measurement ye = m.h->run_linearized(e.x, H, V);
+
+      const MeasurementNoise Omega =
+        internal::covarianceProduct(V, m.h->getCovariance())
+          .llt().solve(MeasurementNoise::Identity());
+
+      addFactor(D, g, -H, Omega, m.y - ye);
+    }
+  }
+
+  /**
+   * @brief Accumulate the propagation from e_prev into e,
+   * \f$ r = x \ominus f(x_{prev}) \approx
+   * r_0 + J_x \delta + J_f F \delta_{prev} \f$.
+   */
+  void linearizePropagation(
+    const Epoch& e_prev,
+    const Epoch& e,
+    Covariance<State>& D_prev,
+    Jacobian<State, State>& B_prev,
+    Covariance<State>& D,
+    TangentVector& g_prev,
+    TangentVector& g
+  ) const {
+    Jacobian<State, State> F, J_x, J_f;
+    Jacobian<State, Control> W;
+
+    const State xf = linearizeModel(e, e_prev.x, F, W);
+    const Tangent r = e.x.rminus(xf, J_x, J_f);
+
+    const Jacobian<State, State> J_prev = J_f * F;
+    const Jacobian<State, Control> J_w = J_f * W;
+
+    const Covariance<State> Omega =
+      internal::covarianceProduct(J_w, e.f->getCovariance())
+        .llt().solve(Covariance<State>::Identity());
+
+    addFactor(D_prev, g_prev, J_prev, Omega, r.coeffs());
+    addFactor(D, g, J_x, Omega, r.coeffs());
+    B_prev.noalias() += J_prev.transpose() * Omega * J_x;
+  }
+
+  /**
+   * @brief Build the block-tridiagonal normal equations of the window.
+   */
+  void linearize() {
+    for (std::size_t i = 0; i < size_; ++i) {
+      Epoch& e = at(i);
+      e.D.setZero();
+      e.B.setZero();
+      e.g.setZero();
+    }
+
+    linearizePrior(at(0), at(0).D, at(0).g);
+
+    for (std::size_t i = 0; i < size_; ++i) {
+      Epoch& e = at(i);
+      linearizeMeasurements(e, e.D, e.g);
+
+      if (i > 0) {
+        Epoch& e_prev = at(i-1);
+        linearizePropagation(
+          e_prev, e, e_prev.D, e_prev.B, e.D, e_prev.g, e.g
+        );
+      }
+    }
+  }
+
+  /**
+   * @brief Solve the normal equations by block forward elimination,
+   * \f$ S_i = D_i - B_{i-1}^T S_{i-1}^{-1} B_{i-1} \f$,
+   * and back substitution.
+   */
+  void eliminate() {
+    for (std::size_t i = 0; i < size_; ++i) {
+      Epoch& e = at(i);
+
+      if (i > 0) {
+        const Epoch& e_prev = at(i-1);
+        e.D.noalias() -= e_prev.B.transpose() * e_prev.G;
+        e.g.noalias() -= e_prev.G.transpose() * e_prev.g;
+      }
+
+      e.S.compute(e.D);
+
+      KALMANIF_ASSERT(
+        e.S.info() == Eigen::Success,
+        "SlidingWindowSmoother: normal equations are not positive definite."
+      );
+
+      e.G = e.S.solve(e.B);
+    }
+
+    Epoch& last = back();
+    last.delta = last.S.solve(last.g);
+
+    for (std::size_t i = size_ - 1; i-- > 0;) {
+      Epoch& e = at(i);
+      e.delta = e.S.solve(e.g) - e.G * at(i+1).delta;
+    }
+  }
+
+  /**
+   * @brief Re-linearize and solve the window until the budget is met,
+   * then recover the marginal covariances backward,
+   * \f$ P_i = S_i^{-1} + G_i P_{i+1} G_i^T \f$.
+   */
+  void solve() {
+    const auto start = startIterations();
+
+    double step_norm = 0;
+    do {
+      linearize();
+      eliminate();
+
+      step_norm = 0;
+      for (std::size_t i = 0; i < size_; ++i) {
+        Epoch& e = at(i);
+        e.x = e.x + Tangent(e.delta);
+        step_norm = std::max(step_norm, double(e.delta.norm()));
+      }
+    } while (continueIterations(step_norm, start, budget_));
+
+    Epoch& last = back();
+    last.P = last.S.solve(Covariance<State>::Identity());
+
+    for (std::size_t i = size_ - 1; i-- > 0;) {
+      Epoch& e = at(i);
+      e.P = internal::covarianceProduct(
+        e.G, at(i+1).P, e.S.solve(Covariance<State>::Identity())
+      );
+    }
+  }
+
+  /**
+   * @brief Marginalize the oldest epoch into a prior on the next one,
+   * the Schur complement of the factors involving the oldest epoch,
+   * \f$ \Lambda = A_{11} - A_{01}^T A_{00}^{-1} A_{01} \f$ and
+   * \f$ b = g_1 - A_{01}^T A_{00}^{-1} g_0 \f$,
+   * so that the prior is \f$ \hat{x}_1 \oplus \Lambda^{-1} b \f$
+   * of information \f$ \Lambda \f$.
+   */
+  void marginalize() {
+    const Epoch& e0 = at(0);
+    const Epoch& e1 = at(1);
+
+    Covariance<State> A00 = Covariance<State>::Zero();
+    Covariance<State> A11 = Covariance<State>::Zero();
+    Jacobian<State, State> A01 = Jacobian<State, State>::Zero();
+    TangentVector g0 = TangentVector::Zero();
+    TangentVector g1 = TangentVector::Zero();
+
+    linearizePrior(e0, A00, g0);
+    linearizeMeasurements(e0, A00, g0);
+    linearizePropagation(e0, e1, A00, A01, A11, g0, g1);
+
+    const Eigen::LLT<Covariance<State>> llt(A00);
+    const Jacobian<State, State> G = llt.solve(A01);
+
+    prior_info_ = A11 - A01.transpose() * G;
+    g1.noalias() -= G.transpose() * g0;
+
+    prior_x_ = e1.x + Tangent(prior_info_.llt().solve(g1));
+
+    first_ = (first_ + 1) % Window;
+    --size_;
+  }
+
+  IterationBudget budget_;
+
+  //! The prior on the oldest epoch, and its information
+  State prior_x_ = State::Identity();
+  Covariance<State> prior_info_ = Covariance<State>::Identity();
+
+  //! Ring buffer of the epochs of the window
+  std::array<Epoch, Window> epochs_;
+  std::size_t first_ = 0;
+  std::size_t size_ = 0;
+};
+
+} // kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_SLIDING_WINDOW_SMOOTHER_H_
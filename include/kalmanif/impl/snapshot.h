@@ -0,0 +1,107 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_SNAPSHOT_H_
+#define _KALMANIF_KALMANIF_IMPL_SNAPSHOT_H_
+
+#include <array>
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief The estimate of a filter recorded by a snapshot:
+ * the state and the covariance as the filter holds it
+ * (see the CovarianceSnapshot of its covariance base).
+ *
+ * @tparam Filter The filter type
+ *
+ * @see KalmanFilterBase::snapshot
+ */
+template <typename Filter>
+struct FilterSnapshot {
+
+  using State = typename Filter::State;
+
+  State x;
+  typename Filter::CovarianceSnapshot covariance;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+};
+
+} // namespace internal
+
+/**
+ * @brief A fixed-capacity stack of snapshots of a filter (or smoother),
+ * to undo tentative propagations and updates, e.g. for speculative
+ * data association.
+ *
+ * Once full, a push overwrites the oldest snapshot.
+ * Neither push nor undo allocates for fixed-size states.
+ *
+ * @tparam Filter The filter (or smoother) type
+ * @tparam Depth The number of snapshots kept
+ */
+template <typename Filter, std::size_t Depth = 1>
+class UndoBuffer {
+
+  static_assert(Depth > 0, "UndoBuffer: Depth must be positive!");
+
+public:
+
+  using Snapshot = typename Filter::Snapshot;
+
+  /**
+   * @brief Record a snapshot of the filter
+   */
+  void push(const Filter& filter) {
+    filter.snapshot(snapshots_[(begin_ + size_) % Depth]);
+    if (size_ < Depth) {
+      ++size_;
+    } else {
+      begin_ = (begin_ + 1) % Depth;
+    }
+  }
+
+  /**
+   * @brief Roll the filter back to the latest snapshot and drop it
+   * @return false if there was no snapshot
+   */
+  bool undo(Filter& filter) {
+    if (size_ == 0) {
+      return false;
+    }
+    --size_;
+    filter.rollback(snapshots_[(begin_ + size_) % Depth]);
+    return true;
+  }
+
+  /**
+   * @brief Drop the latest snapshot, e.g. once the tentative
+   * update is accepted
+   */
+  void pop() {
+    if (size_ > 0) {
+      --size_;
+    }
+  }
+
+  void clear() {
+    begin_ = 0;
+    size_ = 0;
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  static constexpr std::size_t capacity() { return Depth; }
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+protected:
+
+  std::array<Snapshot, Depth> snapshots_;
+  std::size_t begin_ = 0;
+  std::size_t size_ = 0;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_SNAPSHOT_H_
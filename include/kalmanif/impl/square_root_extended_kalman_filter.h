@@ -5,14 +5,19 @@ namespace kalmanif {
 
 // Forward declaration
 template <typename Derived> struct SystemModelBase;
-template <typename Filter> struct RauchTungStriebelSmoother;
+template <typename Filter, typename Storage> struct RauchTungStriebelSmoother;
+template <typename Filter, typename Storage>
+struct SquareRootRauchTungStriebelSmoother;
+template <typename Filter, std::size_t Lag> struct FixedLagSmoother;
+template <typename Filter> struct FilterCheckpoint;
 
 template <typename StateType>
 struct SquareRootExtendedKalmanFilter
   : public internal::KalmanFilterBase<
       SquareRootExtendedKalmanFilter<StateType>
     >
-  , public internal::CovarianceSquareRootBase<StateType> {
+  , public internal::CovarianceSquareRootBase<StateType>
+  , public internal::TransitionBase<StateType> {
 
   using Base = internal::KalmanFilterBase<
     SquareRootExtendedKalmanFilter<StateType>
@@ -23,6 +28,9 @@ struct SquareRootExtendedKalmanFilter
   using typename Base::State;
   using Base::setState;
   using Base::getState;
+  using Base::setValidation;
+  using Base::getValidation;
+  using Base::getValidationPeriod;
   using CovarianceSqrtBase::setCovariance;
   using CovarianceSqrtBase::getCovariance;
 
@@ -41,16 +49,22 @@ struct SquareRootExtendedKalmanFilter
 protected:
 
   using Base::x;
+  using Base::validateCovariance;
+  using Base::instrument;
+  using Base::isValidationStep;
   using CovarianceSqrtBase::S;
+  using internal::TransitionBase<StateType>::recordTransition;
 
   friend Base;
-  friend RauchTungStriebelSmoother<SquareRootExtendedKalmanFilter<StateType>>;
+  template <typename, typename> friend struct RauchTungStriebelSmoother;
+  template <typename, typename>
+  friend struct SquareRootRauchTungStriebelSmoother;
+  template <typename, std::size_t> friend struct FixedLagSmoother;
+  template <typename> friend struct FilterCheckpoint;
 
-  Jacobian<State, State> A_ = Jacobian<State, State>::Zero();
-
-  const Jacobian<State, State>& getA() const {
-    return A_;
-  }
+  //! Square root of the process noise \f$ WQW^T \f$ of the propagation,
+  //! recorded if a smoother lent its storage, see internal::ScopedOutput
+  CovarianceSquareRoot<State>* process_noise_ = nullptr;
 
   template <class SystemModelDerived, typename... Args>
   const State& propagate_impl(
@@ -67,19 +81,33 @@ protected:
     Jacobian<State, Control> W;
 
     // propagate state
-    x = f(x, u, F, W, std::forward<Args>(args)...);
+    {
+      const auto stage = instrument(Stage::Model);
+      f.into(x, u, x, F, W, std::forward<Args>(args)...);
+    }
 
     // propagate covariance
-    computePropagatedCovarianceSquareRoot<State, Control>(
-      F, S, W, f.getCovarianceSquareRoot(), S
-    );
-
-    A_ = F.transpose();
-
-    KALMANIF_ASSERT(
-      isCovariance(getCovariance()),
-      "SEKF::propagate: Updated matrix P is not a covariance."
-    );
+    {
+      const auto stage = instrument(Stage::Covariance);
+      computePropagatedCovarianceSquareRoot<State, Control>(
+        F, S, W, f.getCovarianceSquareRoot(), S
+      );
+
+      if (process_noise_ != nullptr) {
+        computeNoiseSquareRoot<Control>(
+          W, f.getCovarianceSquareRoot(), *process_noise_
+        );
+      }
+    }
+
+    recordTransition(F.transpose());
+
+    if (isValidationStep()) {
+      validateCovariance(
+        getCovariance(),
+        "SEKF::propagate: Updated matrix P is not a covariance."
+      );
+    }
 
     // return state propagateion
     return getState();
@@ -105,43 +133,170 @@ protected:
     Jacobian<Measurement, Measurement> V;
 
     // compute expectation
-    Measurement e = h(x, H, V);
+    const Measurement e = [&]() {
+      const auto stage = instrument(Stage::Model);
+      return h(x, H, V);
+    }();
 
-    // compute innovation covariance
-    CovarianceSquareRoot<Measurement> S_y;
-    computePropagatedCovarianceSquareRoot<Measurement, Measurement>(
-      H, S, V, h.getCovarianceSquareRoot(), S_y
-    );
+    // measurement noise covariance (as square root)
+    Covariance<Measurement> VL = V * h.getCovarianceSquareRoot().matrixL();
 
-    // compute kalman gain, solve using backsubstitution
-    // AX=B with B = HSS^T and X = K^T and A = S_yS_y^T
-    KalmanGain<State, Measurement> K = S_y.solve(
-      H * S.reconstructedMatrix()
-    ).transpose();
+    correct(H, VL, y - e);
 
-    // Update state using computed kalman gain and innovation
-    // @todo Fix
-    x += typename State::Tangent(K * (y - e));
+    if (isValidationStep()) {
+      validateCovariance(
+        getCovariance(),
+        "SEKF::update: Updated matrix P is not a covariance."
+      );
+    }
+
+    // return updated state estimate
+    return getState();
+  }
+
+  /**
+   * @brief Perform a single filter update step using a stack of
+   * measurements \f$z_i\f$ and corresponding measurement models
+   *
+   * The square root of the stacked measurement noise
+   * \f$ V\sqrt{R} \f$ is block-diagonal.
+   *
+   * @tparam Count The number of measurements or Eigen::Dynamic
+   * @param [in] h_it Iterator to the first linearized measurement model
+   * @param [in] y_it Iterator to the first measurement vector
+   * @param [in] count The number of measurements
+   * @return The updated state estimate
+   */
+  template <
+    int Count, class MeasurementModelIterator, class MeasurementIterator
+  >
+  const State& update_stacked_impl(
+    MeasurementModelIterator h_it,
+    MeasurementIterator y_it,
+    const int count
+  ) {
+    using MeasurementModelDerived =
+      typename std::iterator_traits<MeasurementModelIterator>::value_type;
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+    using Stacked = StackedMeasurement<Measurement, Count>;
+    using StackedCov = StackedCovariance<Stacked>;
+    constexpr auto MeasSize = internal::traits<Measurement>::Size;
+    constexpr auto StateSize = internal::traits<State>::Size;
+    constexpr auto MaxStackedSize = Stacked::MaxRowsAtCompileTime;
+    const auto StackedSize = count * MeasSize;
+
+    Stacked z(StackedSize);
+    Jacobian<Stacked, State, 0, MaxStackedSize> H(StackedSize, StateSize);
+    StackedCov VL = StackedCov::Zero(StackedSize, StackedSize);
 
-    // Update covariance
-    // TODO: update covariance without using decomposition
-    SquareMatrix<Scalar, internal::traits<State>::Size> P = S.reconstructedMatrix();
-    S.compute(P - K * H * P);
+    Jacobian<Measurement, Measurement> V;
 
-    KALMANIF_ASSERT(
-      S.info() == Eigen::Success,
-      "Failed to compute updated square root matrix"
-    );
+    {
+      const auto stage = instrument(Stage::Model);
 
-    KALMANIF_ASSERT(
-      isCovariance(getCovariance()),
-      "SEKF::update: Updated matrix P is not a covariance."
-    );
+      for (int i = 0; i < count; ++i, ++h_it, ++y_it) {
+        const Linearized<MeasurementModelBase<MeasurementModelDerived>>& h = *h_it;
+        const auto b = i * MeasSize;
+
+        // compute expectation and stack innovation
+        z.template segment<MeasSize>(b) =
+          *y_it - h(x, H.template middleRows<MeasSize>(b), V);
+
+        VL.template block<MeasSize, MeasSize>(b, b).noalias() =
+          V * h.getCovarianceSquareRoot().matrixL();
+      }
+    }
+
+    correct(H, VL, z);
+
+    if (isValidationStep()) {
+      validateCovariance(
+        getCovariance(),
+        "SEKF::update: Updated matrix P is not a covariance."
+      );
+    }
 
-    // return updated state estimate
     return getState();
   }
 
+  /**
+   * @brief Correct the state estimate and its covariance square root
+   * given an innovation, its jacobian and noise square root.
+   *
+   * The update is performed in 'array' form, that is,
+   * only on the covariance square root and without ever forming
+   * the covariance. Following the same reasoning as
+   * computePropagatedCovarianceSquareRoot, the QR decomposition
+   *
+   *   \f[ \begin{bmatrix}
+   *        (V\sqrt{R})^T & 0 \\
+   *        S^T H^T & S^T
+   *       \end{bmatrix}
+   *       = O
+   *       \begin{bmatrix}
+   *        R_{11} & R_{12} \\
+   *        0 & R_{22}
+   *       \end{bmatrix} \f]
+   *
+   * gives \f$ R_{11}^T R_{11} = HSS^TH^T + V R V^T \f$ the innovation
+   * covariance, \f$ R_{12}^T R_{11} = SS^TH^T \f$ and
+   * \f$ R_{22}^T R_{22} = SS^T - R_{12}^T R_{12} \f$ the updated
+   * covariance. The Kalman gain is thus \f$ K = R_{12}^T R_{11}^{-T} \f$
+   * and the updated square root \f$ R_{22}^T \f$.
+   *
+   * @param [in] H The measurement jacobian
+   * @param [in] VL The measurement noise covariance (as square root)
+   * @param [in] z The innovation
+   *
+   * @see computePropagatedCovarianceSquareRoot
+   */
+  template <typename _DerivedH, typename _DerivedL, typename _DerivedZ>
+  void correct(
+    const Eigen::MatrixBase<_DerivedH>& H,
+    const Eigen::MatrixBase<_DerivedL>& VL,
+    const Eigen::MatrixBase<_DerivedZ>& z
+  ) {
+    using Innovation = typename _DerivedZ::PlainObject;
+    constexpr auto StateSize = internal::traits<State>::Size;
+    constexpr auto InnovSize = Innovation::RowsAtCompileTime;
+    constexpr auto MaxInnovSize = Innovation::MaxRowsAtCompileTime;
+    constexpr auto TmpSize =
+      (InnovSize == Eigen::Dynamic) ? Eigen::Dynamic : InnovSize + StateSize;
+    using TmpMat = SquareMatrix<
+      Scalar, TmpSize, 0, MaxInnovSize + StateSize, MaxInnovSize + StateSize
+    >;
+    const auto m = z.rows();
+
+    // The gain and the updated covariance come out of the same decomposition
+    const auto stage = instrument(Stage::Covariance);
+
+    // Compute QR decomposition of the pre-array
+    TmpMat tmp(m + StateSize, m + StateSize);
+    tmp.topLeftCorner(m, m).noalias() = VL.transpose();
+    tmp.topRightCorner(m, StateSize).setZero();
+    tmp.bottomLeftCorner(StateSize, m).noalias() = S.matrixU() * H.transpose();
+    tmp.bottomRightCorner(StateSize, StateSize) = S.matrixU();
+
+    // Use Ref<TmpMat> for inplace decomposition
+    Eigen::HouseholderQR<Eigen::Ref<TmpMat>> qr(tmp);
+    const auto& R = qr.matrixQR();
+
+    // compute kalman gain, solve using backsubstitution
+    // R_11 K^T = R_12
+    Eigen::Matrix<Scalar, InnovSize, StateSize, 0, MaxInnovSize, StateSize>
+      Kt = R.topRightCorner(m, StateSize);
+    R.topLeftCorner(m, m).template triangularView<Eigen::Upper>()
+      .solveInPlace(Kt);
+
+    // Update state using computed kalman gain and innovation
+    // @todo Fix
+    x += typename State::Tangent(Kt.transpose() * z);
+
+    // Update covariance square root
+    S.setU(R.bottomRightCorner(StateSize, StateSize));
+  }
+
   /**
    * @brief Compute the propagateed state or
    * innovation covariance (as square root).
@@ -238,6 +393,39 @@ protected:
 
     return true;
   }
+
+  /**
+   * @brief Compute the square root of the process noise
+   * mapped to the state, \f$ WQW^T \f$.
+   *
+   * As in computePropagatedCovarianceSquareRoot, the square root is
+   * the transposed upper triangular factor of the QR decomposition of
+   * \f$ (W\sqrt{Q})^T \f$, here padded with zeros so that the factor
+   * is square even if the noise is of lower dimension than the state.
+   *
+   * @param [in] W The jacobian of state transition w.r.t. the noise
+   * @param [in] R The system model noise covariance (as square root)
+   * @param [out] SQ The process noise covariance (as square root)
+   */
+  template <class Control>
+  void computeNoiseSquareRoot(
+    const Eigen::Ref<const Jacobian<State, Control>>& W,
+    const CovarianceSquareRoot<Control>& R,
+    CovarianceSquareRoot<State>& SQ
+  ) {
+    constexpr auto StateSize = internal::traits<State>::Size;
+    constexpr auto ControlSize = internal::traits<Control>::Size;
+    using TmpMat = Eigen::Matrix<Scalar, StateSize + ControlSize, StateSize>;
+
+    TmpMat tmp;
+    tmp.template topRows<StateSize>().setZero();
+    tmp.template bottomRows<ControlSize>().noalias() =
+      R.matrixU() * W.transpose();
+
+    Eigen::HouseholderQR<Eigen::Ref<TmpMat>> qr(tmp);
+
+    SQ.setU(qr.matrixQR().template topRows<StateSize>());
+  }
 };
 
 namespace internal {
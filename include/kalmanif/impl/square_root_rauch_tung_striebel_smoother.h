@@ -0,0 +1,386 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_SQUARE_ROOT_RAUCH_TUNG_STRIEBEL_SMOOTHER_H_
+#define _KALMANIF_KALMANIF_IMPL_SQUARE_ROOT_RAUCH_TUNG_STRIEBEL_SMOOTHER_H_
+
+namespace kalmanif {
+
+// Forward declaration
+template <typename Derived> struct SystemModelBase;
+
+namespace internal {
+
+/**
+ * @brief Whether the filter propagates and updates the square root
+ * of its covariance only, so that it can be smoothed in square root form.
+ */
+template <typename>
+struct is_square_root : std::false_type {};
+
+template <typename T>
+struct is_square_root<SquareRootExtendedKalmanFilter<T>>
+  : std::true_type {};
+
+/**
+ * @brief The filtering quantities of an epoch in square root form,
+ * i.e. of a propagation followed by an update.
+ *
+ * @tparam State The state type
+ */
+template <typename State>
+struct SquareRootSmootherEpoch {
+  State x_pred, x_est;
+
+  //! Square root of the estimated covariance
+  CovarianceSquareRoot<State> S_est;
+
+  //! Square root of the process noise of the propagations into the epoch
+  CovarianceSquareRoot<State> S_Q;
+
+  //! Transposed transition of the propagations into the epoch, A = F^T
+  Jacobian<State, State> A;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+};
+
+/**
+ * @brief A square root Rauch-Tung-Striebel backward step,
+ * from the smoothed estimate at k+1 to the smoothed estimate at k.
+ *
+ * Following the same reasoning as
+ * SquareRootExtendedKalmanFilter::correct, the QR decomposition
+ *
+ *   \f[ \begin{bmatrix}
+ *        S_k^T F^T & S_k^T \\
+ *        \sqrt{Q}^T & 0
+ *       \end{bmatrix}
+ *       = O
+ *       \begin{bmatrix}
+ *        R_{11} & R_{12} \\
+ *        0 & R_{22}
+ *       \end{bmatrix} \f]
+ *
+ * gives \f$ R_{11}^T R_{11} = FP_kF^T + Q \f$ the predicted covariance,
+ * \f$ R_{12}^T R_{11} = P_kF^T \f$ and
+ * \f$ R_{22}^T R_{22} = P_k - G R_{11}^T R_{11} G^T \f$.
+ * The smoother gain is thus \f$ G = R_{12}^T R_{11}^{-T} \f$ and
+ * the smoothed covariance
+ * \f$ P^s_k = R_{22}^T R_{22} + G S^s_{k+1} S^{sT}_{k+1} G^T \f$
+ * is in turn the product of the upper triangular factor of the QR
+ * decomposition of \f$ \begin{bmatrix} R_{22} \\ S^{sT}_{k+1} G^T
+ * \end{bmatrix} \f$, see "Bayesian Filtering and Smoothing" S. Särkkä.
+ *
+ * @param [in] e The epoch k
+ * @param [in] e_next The epoch k+1
+ * @param [in,out] Xs The smoothed state at k+1, then at k
+ * @param [in,out] Ss The smoothed covariance (as square root)
+ * at k+1, then at k
+ */
+template <typename State>
+void smoothSquareRootEpoch(
+  const SquareRootSmootherEpoch<State>& e,
+  const SquareRootSmootherEpoch<State>& e_next,
+  State& Xs,
+  CovarianceSquareRoot<State>& Ss
+) {
+  using Scalar = typename State::Scalar;
+  constexpr auto StateSize = traits<State>::Size;
+  using PreArray = SquareMatrix<Scalar, 2 * StateSize>;
+  using PostArray = Eigen::Matrix<Scalar, 2 * StateSize, StateSize>;
+
+  // Compute QR decomposition of the pre-array
+  PreArray pre;
+  pre.template topLeftCorner<StateSize, StateSize>().noalias() =
+    e.S_est.matrixU() * e_next.A;
+  pre.template topRightCorner<StateSize, StateSize>() = e.S_est.matrixU();
+  pre.template bottomLeftCorner<StateSize, StateSize>() =
+    e_next.S_Q.matrixU();
+  pre.template bottomRightCorner<StateSize, StateSize>().setZero();
+
+  // Use Ref<PreArray> for inplace decomposition
+  Eigen::HouseholderQR<Eigen::Ref<PreArray>> qr(pre);
+  const auto& R = qr.matrixQR();
+
+  // compute smoother gain, solve using backsubstitution
+  // R_11 G^T = R_12
+  Jacobian<State, State> Gt = R.template topRightCorner<StateSize, StateSize>();
+  R.template topLeftCorner<StateSize, StateSize>()
+    .template triangularView<Eigen::Upper>().solveInPlace(Gt);
+
+  const Jacobian<State, State> G = Gt.transpose();
+
+  // Compute smoothed state, see [2]
+  Xs = e.x_est + (G * ( Xs - e_next.x_pred ));
+
+  // Compute QR decomposition of the post-array
+  PostArray post;
+  post.template topRows<StateSize>() =
+    R.template bottomRightCorner<StateSize, StateSize>()
+      .template triangularView<Eigen::Upper>();
+  post.template bottomRows<StateSize>().noalias() = Ss.matrixU() * Gt;
+
+  Eigen::HouseholderQR<Eigen::Ref<PostArray>> qr_post(post);
+
+  // Set smoothed covariance as upper triangular square root
+  Ss.setU(qr_post.matrixQR().template topRows<StateSize>());
+}
+
+} // namespace internal
+
+/**
+ * @brief The square root Rauch-Tung-Striebel Smoother
+ *
+ * The epochs and the smoothed sequence keep the square roots of
+ * the covariances, as the SquareRootExtendedKalmanFilter does.
+ * Neither the forward nor the backward pass reconstruct a covariance,
+ * the backward recursion runs on QR decompositions of stacked
+ * square roots, see internal::smoothSquareRootEpoch.
+ *
+ * @note Based on,
+ * "Bayesian Filtering and Smoothing" S. Särkkä [2]
+ *
+ * @tparam Filter The underlying filter type,
+ * a SquareRootExtendedKalmanFilter.
+ * @tparam Storage The storage policy of the epochs and smoothed sequence.
+ *
+ * @see RauchTungStriebelSmoother
+ */
+template <typename Filter, typename Storage = InMemoryStorage>
+struct SquareRootRauchTungStriebelSmoother {
+
+  static_assert(
+    internal::is_square_root<Filter>{},
+    "SquareRootRauchTungStriebelSmoother: Filter must be a square root filter!"
+  );
+
+  template <typename T>
+  using container_t = typename Storage::template container<T>;
+
+  using State = typename Filter::State;
+
+protected:
+
+  using Epoch = internal::SquareRootSmootherEpoch<State>;
+
+public:
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(SquareRootRauchTungStriebelSmoother);
+
+  /**
+   * @brief Construct a smoother
+   * @param state_init The initial state
+   * @param cov_init The initial covariance
+   * @param storage The storage policy instance
+   */
+  SquareRootRauchTungStriebelSmoother(
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    const Storage& storage = Storage()
+  ) : filter_(state_init, cov_init)
+    , epochs_(storage.template make<Epoch>("epochs"))
+    , Xsk_(storage.template make<State>("states"))
+    , Ssk_(storage.template make<CovarianceSquareRoot<State>>("covariances")) { }
+
+  /**
+   * @brief Reserve the storage for n epochs so that
+   * neither the forward nor the backward pass allocates.
+   * @param n The number of epochs
+   */
+  void reserve(const std::size_t n) {
+    epochs_.reserve(n);
+    Xsk_.reserve(n);
+    Ssk_.reserve(n);
+  }
+
+  /**
+   * @brief Performs the underlying filter's propagation.
+   *
+   * The propagations between two updates are composed into
+   * a single transition and process noise square root.
+   */
+  template <class SystemModelDerived, typename... Args>
+  const State& propagate(
+    const SystemModelBase<SystemModelDerived>& f,
+    const typename internal::traits<SystemModelDerived>::Control& u,
+    Args&&... args
+  ) {
+
+    {
+      // The filter records the transition and the noise in our storage
+      const internal::ScopedOutput<Jacobian<State, State>> transition(
+        filter_.transition_, &A_
+      );
+      const internal::ScopedOutput<CovarianceSquareRoot<State>> noise(
+        filter_.process_noise_, &S_Q_
+      );
+      filter_.propagate(f, u, std::forward<Args>(args)...);
+    }
+
+    if (updated_) {
+      epochs_.emplace_back();
+      epochs_.back().A = A_;
+      epochs_.back().S_Q = S_Q_;
+      updated_ = false;
+    } else {
+      Epoch& e = epochs_.back();
+
+      // F_next Q F_next^T + Q_next
+      filter_.template computePropagatedCovarianceSquareRoot<State, State>(
+        A_.transpose(), e.S_Q,
+        Jacobian<State, State>::Identity(), S_Q_, e.S_Q
+      );
+
+      // (F_next.F)^T = F^T.F_next^T
+      e.A = e.A * A_;
+    }
+
+    epochs_.back().x_pred = filter_.getState();
+
+    propagated_ = true;
+
+    return filter_.getState();
+  }
+
+  /**
+   * @brief Performs the underlying filter's update.
+   */
+  template <typename MeasurementModelDerived, typename... Args>
+  const State& update(
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y,
+    Args&&... args
+  ) {
+    filter_.update(h, y, std::forward<Args>(args)...);
+
+    recordUpdate();
+
+    return filter_.getState();
+  }
+
+  /**
+   * @brief Performs the underlying filter's stacked update.
+   */
+  template <
+    class MeasurementModelRange,
+    class MeasurementRange,
+    typename = internal::enable_if_is_measurement_model_range<
+      MeasurementModelRange
+    >
+  >
+  const State& update(
+    const MeasurementModelRange& hs,
+    const MeasurementRange& ys
+  ) {
+    filter_.update(hs, ys);
+
+    recordUpdate();
+
+    return filter_.getState();
+  }
+
+  /**
+   * @brief Run the batch backward pass - the smoothing.
+   * @return The smoothed state sequence.
+   */
+  const container_t<State>& smooth() {
+
+    const std::size_t n = estimated_;
+
+    Xsk_.resize(n);
+    Ssk_.resize(n);
+
+    if (n == 0)
+      return Xsk_;
+
+    // Initialize the smoother
+    State Xs = epochs_[n-1].x_est;
+    CovarianceSquareRoot<State> Ss = epochs_[n-1].S_est;
+    Xsk_[n-1] = Xs;
+    Ssk_[n-1] = Ss;
+
+    // Smoothing routine
+    for (std::size_t k = n - 1; k-- > 0;) {
+      internal::smoothSquareRootEpoch(epochs_[k], epochs_[k+1], Xs, Ss);
+      Xsk_[k] = Xs;
+      Ssk_[k] = Ss;
+    }
+
+    return Xsk_;
+  }
+
+  const State& getState() const {
+    return filter_.getState();
+  }
+
+  const CovarianceSquareRoot<State>& getCovarianceSquareRoot() const {
+    return filter_.getCovarianceSquareRoot();
+  }
+
+  const container_t<State>& getStates() const {
+    return Xsk_;
+  }
+
+  /**
+   * @brief The smoothed covariances (as square roots).
+   */
+  const container_t<CovarianceSquareRoot<State>>&
+  getCovarianceSquareRoots() const {
+    return Ssk_;
+  }
+
+  void clear() {
+    epochs_.clear();
+    Xsk_.clear();
+    Ssk_.clear();
+    estimated_ = 0;
+    propagated_ = false;
+    updated_ = true;
+  }
+
+protected:
+
+  /**
+   * @brief Record the underlying filter's updated state
+   * and covariance square root.
+   */
+  void recordUpdate() {
+    KALMANIF_ASSERT(
+      !epochs_.empty(),
+      "SquareRootRauchTungStriebelSmoother: update before any propagation!"
+    );
+
+    if (propagated_) {
+      ++estimated_;
+      propagated_ = false;
+    }
+
+    epochs_.back().x_est = filter_.getState();
+    epochs_.back().S_est = filter_.getCovarianceSquareRoot();
+
+    updated_ = true;
+  }
+
+  bool propagated_ = false;
+  bool updated_ = true;
+
+  Filter filter_;
+
+  //! Filtering epochs, contiguous
+  container_t<Epoch> epochs_;
+
+  //! Number of epochs with an estimate
+  std::size_t estimated_ = 0;
+
+  //! Smoothed states and covariances (as square roots)
+  container_t<State> Xsk_;
+  container_t<CovarianceSquareRoot<State>> Ssk_;
+
+  //! The transposed transition and the process noise square root
+  //! of the last propagation, recorded by the filter
+  Jacobian<State, State> A_ = Jacobian<State, State>::Zero();
+  CovarianceSquareRoot<State> S_Q_ = CovarianceSquareRoot<State>::Identity();
+};
+
+} // kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_SQUARE_ROOT_RAUCH_TUNG_STRIEBEL_SMOOTHER_H_
@@ -0,0 +1,440 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_SQUARE_ROOT_UNSCENTED_KALMAN_FILTER_MANIFOLDS_H_
+#define _KALMANIF_KALMANIF_IMPL_SQUARE_ROOT_UNSCENTED_KALMAN_FILTER_MANIFOLDS_H_
+
+namespace kalmanif {
+
+// Forward declaration
+template <typename Derived> struct SystemModelBase;
+template <typename Filter, typename Storage> struct RauchTungStriebelSmoother;
+template <typename Filter, std::size_t Lag> struct FixedLagSmoother;
+
+/**
+ * @brief The square root Unscented Kalman Filter on Manifolds
+ *
+ * The UKFM propagating the lower Cholesky factor S of the covariance
+ * rather than the covariance itself, so that the covariance remains
+ * positive definite without being refactorized nor repaired at each step.
+ *
+ * The propagated square root is the triangular factor of the QR
+ * decomposition of the sigma points images weighted by the square roots
+ * of their weights, followed by a rank-one update of the mean image
+ * of weight w0. The update downdates S by the columns of
+ * \f$ K S_{yy} \f$, with \f$ S_{yy} \f$ the square root of the
+ * innovation covariance, obtained likewise. A downdate that loses
+ * the positive definiteness to round-off falls back to the
+ * factorization of the reconstructed covariance,
+ * see getRefactorizationCount.
+ *
+ * The sigma points and their evaluation are those of the UKFM,
+ * the two filters agree up to round-off.
+ *
+ * @tparam StateType The state type
+ * @tparam Iv The invariance of the filter
+ * @tparam Executor The executor evaluating the sigma points
+ * @tparam SigmaPoints The sigma point scheme, or StaticSigmaPoints
+ * to fix the unscented parameters at compile time
+ *
+ * @see UnscentedKalmanFilterManifolds
+ */
+template <
+  typename StateType,
+  Invariance Iv = Invariance::Right,
+  typename Executor = SequentialExecutor,
+  typename SigmaPoints = SymmetricSigmaPoints
+>
+struct SquareRootUnscentedKalmanFilterManifolds
+  : public internal::KalmanFilterBase<
+      SquareRootUnscentedKalmanFilterManifolds<
+        StateType, Iv, Executor, SigmaPoints
+      >
+    >
+  , public internal::CovarianceSquareRootBase<StateType>
+  , public internal::TransitionBase<StateType> {
+
+  using Base = internal::KalmanFilterBase<
+    SquareRootUnscentedKalmanFilterManifolds<
+      StateType, Iv, Executor, SigmaPoints
+    >
+  >;
+  using CovarianceSqrtBase = internal::CovarianceSquareRootBase<StateType>;
+
+  using typename Base::Scalar;
+  using typename Base::State;
+  using Base::setState;
+  using Base::getState;
+  using Base::setValidation;
+  using Base::getValidation;
+  using Base::getValidationPeriod;
+  using CovarianceSqrtBase::setCovariance;
+  using CovarianceSqrtBase::getCovariance;
+  using CovarianceSqrtBase::getCovarianceSquareRoot;
+
+  //! The sigma point scheme and unscented parameters
+  using SigmaPointParameters =
+    internal::sigma_point_parameters<SigmaPoints, Scalar>;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  SquareRootUnscentedKalmanFilterManifolds()
+    : Base(), CovarianceSqrtBase(), executor_() {
+    setSigmaPoints(
+      SigmaPointParameters::alpha_d,
+      SigmaPointParameters::alpha_q,
+      SigmaPointParameters::alpha_u
+    );
+  }
+
+  SquareRootUnscentedKalmanFilterManifolds(
+    const State& state_init,
+    const Eigen::Ref<const Covariance<State>>& cov_init,
+    Scalar alpha0 = SigmaPointParameters::alpha_d,
+    Scalar alpha1 = SigmaPointParameters::alpha_q,
+    Scalar alpha2 = SigmaPointParameters::alpha_u,
+    Executor executor = Executor()
+  ) : Base(), CovarianceSqrtBase(), executor_(std::move(executor)) {
+    setState(state_init);
+    setCovariance(cov_init);
+    setSigmaPoints(alpha0, alpha1, alpha2);
+  }
+
+  ~SquareRootUnscentedKalmanFilterManifolds() = default;
+
+  /**
+   * @brief Get the number of refactorizations,
+   * i.e. of rank-one downdates that failed to round-off
+   */
+  std::size_t getRefactorizationCount() const {
+    return refactorization_count_;
+  }
+
+protected:
+
+  using Base::x;
+  using Base::validateCovariance;
+  using Base::instrument;
+  using Base::isValidationStep;
+  using CovarianceSqrtBase::S;
+  using internal::TransitionBase<StateType>::recordsTransition;
+  using internal::TransitionBase<StateType>::transition_;
+
+  friend Base;
+  template <typename, typename> friend struct RauchTungStriebelSmoother;
+  template <typename, std::size_t> friend struct FixedLagSmoother;
+
+  using Scheme = typename SigmaPointParameters::Scheme;
+
+  //! The state sigma points, of the dimension of the state
+  template <typename Alpha>
+  using StateSigmaPoints = internal::StoredSigmaPointSet<
+    Scalar, internal::traits<State>::Size, Scheme, Alpha
+  >;
+
+  using PropagationSigmaPoints =
+    StateSigmaPoints<typename SigmaPointParameters::AlphaD>;
+  using UpdateSigmaPoints =
+    StateSigmaPoints<typename SigmaPointParameters::AlphaU>;
+
+  /**
+   * @brief Precompute the state sigma points and weights
+   *
+   * @param alpha0 The propagation state sigma points spread
+   * @param alpha1 The propagation noise sigma points spread
+   * @param alpha2 The update state sigma points spread
+   *
+   * @throws invalid_argument if the parameters are fixed at compile time
+   * to other values.
+   */
+  void setSigmaPoints(
+    const Scalar alpha0, const Scalar alpha1, const Scalar alpha2
+  ) {
+    alpha_d = alpha0;
+    alpha_q = alpha1;
+    alpha_u = alpha2;
+
+    if constexpr (SigmaPointParameters::Static) {
+      KALMANIF_CHECK(
+        alpha_d == SigmaPointParameters::alpha_d &&
+        alpha_q == SigmaPointParameters::alpha_q &&
+        alpha_u == SigmaPointParameters::alpha_u,
+        "SR-UKFM: The unscented parameters are fixed at compile time!",
+        invalid_argument
+      );
+    } else {
+      sigma_d = PropagationSigmaPoints(alpha_d);
+      sigma_u = UpdateSigmaPoints(alpha_u);
+    }
+  }
+
+  //! The noise sigma points, precomputed if the parameters are static
+  template <typename NoiseSigmaPoints>
+  NoiseSigmaPoints getNoiseSigmaPoints() const {
+    if constexpr (SigmaPointParameters::Static) {
+      return NoiseSigmaPoints();
+    } else {
+      return NoiseSigmaPoints(alpha_q);
+    }
+  }
+
+  /**
+   * @brief Update a square root L of M by the rank-one terms of
+   * the columns of V, to that of \f$ M + w VV^T \f$.
+   *
+   * If a downdate loses the positive definiteness to round-off,
+   * L is refactorized from the reconstructed matrix.
+   */
+  template <typename MatrixType, typename _DerivedV>
+  void rankUpdate(
+    Cholesky<MatrixType>& L,
+    const Eigen::MatrixBase<_DerivedV>& V,
+    const Scalar w
+  ) {
+    if (w == Scalar(0)) return;
+
+    const Cholesky<MatrixType> L_prev = L;
+    for (Eigen::Index i = 0; i < V.cols(); ++i) {
+      if (!L.rankOneUpdate(V.col(i), w)) {
+        MatrixType M = L_prev.reconstructedMatrix();
+        M.noalias() += w * V * V.transpose();
+        L.compute(M);
+        ++refactorization_count_;
+        return;
+      }
+    }
+  }
+
+  template <class SystemModelDerived, typename... Args>
+  const State& propagate_impl(
+    const SystemModelBase<SystemModelDerived>& f,
+    const typename internal::traits<SystemModelDerived>::Control& u,
+    Args&&... args
+  ) {
+    using Control = typename internal::traits<SystemModelDerived>::Control;
+    constexpr auto StateSize = internal::traits<State>::Size;
+    constexpr auto NoiseSize = internal::traits<Control>::Size;
+    constexpr auto StateCount = PropagationSigmaPoints::Count;
+    using NoiseSigmaPoints = SigmaPointSet<
+      Scalar, NoiseSize, Scheme, typename SigmaPointParameters::AlphaQ
+    >;
+    constexpr auto NoiseCount = NoiseSigmaPoints::Count;
+    using VectorDoF = Eigen::Matrix<Scalar, StateSize, 1>;
+    using TmpMat =
+      Eigen::Matrix<Scalar, StateCount + NoiseCount, StateSize>;
+
+    static_assert(
+      StateCount + NoiseCount >= StateSize,
+      "SR-UKFM: Not enough sigma points for a square root of the covariance!"
+    );
+
+    // propagate state
+    State x_new;
+    {
+      const auto stage = instrument(Stage::Model);
+      f.into(x, u, x_new, args...);
+    }
+
+    // the sigma points from the square root, no factorization
+    const Eigen::Matrix<Scalar, StateSize, StateCount> xis =
+      internal::sigmaPoints(sigma_d, S.matrixL());
+
+    const NoiseSigmaPoints sigma_q =
+      getNoiseSigmaPoints<NoiseSigmaPoints>();
+    const Eigen::Matrix<Scalar, NoiseSize, NoiseCount> w_ps =
+      internal::sigmaPoints(sigma_q, f.getCovarianceSquareRoot().matrixL());
+
+    Eigen::Matrix<Scalar, StateSize, StateCount> xis_new;
+    Eigen::Matrix<Scalar, StateSize, NoiseCount> xis_new2;
+
+    // Evaluate the system model at the sigma points on manifold
+    {
+      const auto stage = instrument(Stage::Model);
+      internal::propagateSigmaPoints<Iv>(
+        executor_, f, x, x_new, u, xis, w_ps, xis_new, xis_new2, args...
+      );
+    }
+
+    const VectorDoF xi_mean = internal::sigmaSum(sigma_d, xis_new);
+    xis_new.colwise() -= xi_mean;
+
+    const VectorDoF xi_mean2 = internal::sigmaSum(sigma_q, xis_new2);
+    xis_new2.colwise() -= xi_mean2;
+
+    {
+      const auto stage = instrument(Stage::Covariance);
+      // as in the UKFM, the statistical counterpart of P F^T
+      if (recordsTransition()) {
+        transition_->noalias() =
+          -internal::sigmaWeighted(sigma_d, xis) * xis_new.transpose();
+      }
+
+      // Compute QR decomposition of the (transposed) weighted images,
+      // see SquareRootExtendedKalmanFilter
+      TmpMat tmp;
+      tmp.template topRows<StateCount>() =
+        internal::sigmaSquareRootWeighted(sigma_d, xis_new).transpose();
+      tmp.template bottomRows<NoiseCount>() =
+        internal::sigmaSquareRootWeighted(sigma_q, xis_new2).transpose();
+
+      Eigen::HouseholderQR<Eigen::Ref<TmpMat>> qr(tmp);
+      S.setU(qr.matrixQR().template topRows<StateSize>());
+
+      // the mean images, of weights w0 possibly negative
+      rankUpdate(S, xi_mean, sigma_d.w0);
+      rankUpdate(S, xi_mean2, sigma_q.w0);
+    }
+
+    if (isValidationStep()) {
+      validateCovariance(
+        getCovariance(),
+        "SR-UKFM::propagate: Updated matrix P is not a covariance."
+      );
+    }
+
+    x = std::move(x_new);
+
+    // return propagated state
+    return getState();
+  }
+
+  /**
+   * @brief Perform filter update step using measurement \f$z\f$
+   * and corresponding measurement model
+   *
+   * @param [in] m The Measurement model
+   * @param [in] z The measurement vector
+   * @return The updated state estimate
+   */
+  template <class MeasurementModelDerived>
+  const State& update_impl(
+    const MeasurementModelBase<MeasurementModelDerived>& h,
+    const typename internal::traits<MeasurementModelDerived>::Measurement& y
+  ) {
+    using Measurement =
+      typename internal::traits<MeasurementModelDerived>::Measurement;
+    using Tangent = typename State::Tangent;
+    constexpr Invariance ModelInvariance =
+      MeasurementModelDerived::ModelInvariance;
+    constexpr auto MeasSize = internal::traits<Measurement>::Size;
+    constexpr auto DoF = internal::traits<State>::Size;
+    constexpr auto Count = UpdateSigmaPoints::Count;
+    using TmpMat = Eigen::Matrix<Scalar, Count + MeasSize, MeasSize>;
+
+    // compute expectation
+    Measurement e = [&]() {
+      const auto stage = instrument(Stage::Model);
+      return h(x);
+    }();
+
+    // set sigma points, in the measurement model invariance,
+    // Ad S being a square root of the mapped covariance Ad P Ad^T
+    Eigen::Matrix<Scalar, DoF, Count> xis;
+    if constexpr (ModelInvariance == Iv) {
+      xis = internal::sigmaPoints(sigma_u, S.matrixL());
+    } else {
+      const Jacobian<State, State> AdS =
+        internal::invarianceAdjoint<Iv, ModelInvariance>(x) * S.matrixL();
+      xis = internal::sigmaPoints(sigma_u, AdS);
+    }
+
+    // compute measurement sigma points
+    Eigen::Matrix<Scalar, MeasSize, Count> yj;
+    {
+      const auto stage = instrument(Stage::Model);
+      internal::updateSigmaPoints<ModelInvariance>(executor_, h, x, xis, yj);
+    }
+
+    // measurement mean
+    const Measurement y_bar =
+      sigma_u.wm * e + internal::sigmaSum(sigma_u, yj);
+
+    yj.colwise() -= y_bar;
+    e -= y_bar;
+
+    // square root of the innovation covariance
+    CovarianceSquareRoot<Measurement> Syy;
+    {
+      const auto stage = instrument(Stage::Covariance);
+      TmpMat tmp;
+      tmp.template topRows<Count>() =
+        internal::sigmaSquareRootWeighted(sigma_u, yj).transpose();
+      tmp.template bottomRows<MeasSize>() =
+        h.getCovarianceSquareRoot().matrixU();
+
+      Eigen::HouseholderQR<Eigen::Ref<TmpMat>> qr(tmp);
+      Syy.setU(qr.matrixQR().template topRows<MeasSize>());
+
+      rankUpdate(Syy, e, sigma_u.w0);
+    }
+
+    // compute kalman gain, solve using backsubstitution
+    KalmanGain<State, Measurement> K;
+    {
+      const auto stage = instrument(Stage::Gain);
+      const Eigen::Matrix<Scalar, MeasSize, DoF> P_yx =
+        internal::sigmaWeighted(sigma_u, yj) * xis.transpose();
+      K = Syy.solve(P_yx).transpose();
+    }
+
+    // Update state using computed kalman gain and innovation
+    if constexpr (ModelInvariance == Invariance::Right) {
+      x = Tangent((K * (y - y_bar))) + x;
+    } else {
+      x += Tangent((K * (y - y_bar)));
+    }
+
+    // Downdate the square root, P - K P_yy K^T = S S^T - U U^T
+    // with U = K Syy
+    {
+      const auto stage = instrument(Stage::Covariance);
+      if constexpr (ModelInvariance == Iv) {
+        const KalmanGain<State, Measurement> U = K * Syy.matrixL();
+        rankUpdate(S, U, Scalar(-1));
+      } else {
+        // Map the correction back to the filter invariance
+        const KalmanGain<State, Measurement> U =
+          internal::invarianceAdjoint<ModelInvariance, Iv>(x) *
+          K * Syy.matrixL();
+        rankUpdate(S, U, Scalar(-1));
+      }
+    }
+
+    if (isValidationStep()) {
+      validateCovariance(
+        getCovariance(),
+        "SR-UKFM::update: Updated matrix P is not a covariance."
+      );
+    }
+
+    // return updated state estimate
+    return getState();
+  }
+
+  //! Unscented transform parameters
+  Scalar alpha_d, alpha_q, alpha_u;
+
+  //! Precomputed state sigma points,
+  //! the noise ones depend on the system model
+  PropagationSigmaPoints sigma_d;
+  UpdateSigmaPoints sigma_u;
+
+  //! Sigma points evaluation executor
+  Executor executor_;
+
+  //! Number of failed downdates
+  std::size_t refactorization_count_ = 0;
+};
+
+namespace internal {
+
+template <
+  class StateType, Invariance Iv, typename Executor, typename SigmaPoints
+>
+struct traits<
+  SquareRootUnscentedKalmanFilterManifolds<StateType, Iv, Executor, SigmaPoints>
+> {
+  using State = StateType;
+};
+
+} // namespace internal
+} // kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_SQUARE_ROOT_UNSCENTED_KALMAN_FILTER_MANIFOLDS_H_
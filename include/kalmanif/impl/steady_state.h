@@ -0,0 +1,287 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_STEADY_STATE_H_
+#define _KALMANIF_KALMANIF_IMPL_STEADY_STATE_H_
+
+#include <vector>
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief The propagated noise \f$ W Q W^T \f$ given the noise jacobian
+ * and covariance, or as precomputed by the model.
+ */
+template <typename _DerivedN>
+const _DerivedN& propagatedNoise(const Eigen::MatrixBase<_DerivedN>& N) {
+  return N.derived();
+}
+
+template <typename _DerivedW, typename _DerivedQ>
+auto propagatedNoise(
+  const Eigen::MatrixBase<_DerivedW>& W,
+  const Eigen::MatrixBase<_DerivedQ>& Q
+) {
+  return covarianceProduct(W, Q);
+}
+
+/**
+ * @brief Base class for filters that may freeze their gains
+ * once their covariance reached a steady state.
+ *
+ * A filter cycle, from a propagation following an update to the next,
+ * is recorded step by step: the jacobian and noise of each propagation
+ * and update, the covariance after each, and the gain and innovation
+ * covariance of each update.
+ * For time-invariant jacobians and noises, e.g. a left invariant filter
+ * with a constant control and measurements of constant invariant noise,
+ * the covariance converges to the fixed point of the discrete Riccati
+ * equation of the cycle. Once two consecutive cycles match within
+ * a tolerance, the last one is frozen and the filter only
+ * propagates and corrects the state with the recorded gains.
+ *
+ * The change detector compares each step's jacobian and noise
+ * against the frozen ones, which is far cheaper than propagating or
+ * updating the covariance. On the first mismatch, the filter falls back
+ * to the full propagations and updates, and detects a new steady state.
+ *
+ * @tparam StateType The state type
+ * @tparam Solver The innovation solver
+ *
+ * @see setSteadyStateGain
+ */
+template <typename StateType, InnovationSolver Solver>
+struct SteadyStateBase {
+
+  using Scalar = typename internal::traits<StateType>::Scalar;
+
+  /**
+   * @brief Enable or disable the steady-state gains.
+   *
+   * @param [in] enable Whether to freeze the gains at steady state
+   * @param [in] tolerance The relative tolerance of the comparison
+   * of the jacobians, noises and covariances of two cycles
+   *
+   * @note The recorded cycles are discarded in either case.
+   * @note Not available in real-time mode, recording the cycles allocates.
+   */
+  void setSteadyStateGain(const bool enable, const Scalar tolerance = 1e-9) {
+    KALMANIF_CHECK(
+      tolerance >= 0,
+      "SteadyStateBase: tolerance must be non-negative!",
+      kalmanif::invalid_argument
+    );
+    KALMANIF_CHECK(
+      !(enable && detail::realtime),
+      "SteadyStateBase: Not available in real-time mode!",
+      kalmanif::invalid_argument
+    );
+    steady_state_gain_ = enable && !detail::realtime;
+    tolerance_ = tolerance;
+    resetSteadyState();
+  }
+
+  bool isSteadyStateGain() const {
+    return steady_state_gain_;
+  }
+
+  /**
+   * @brief Whether the gains are currently frozen.
+   */
+  bool isSteadyState() const {
+    return steady_;
+  }
+
+protected:
+
+  using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+  using InnovationDecomposition =
+    typename InnovationBase<StateType, Solver>::InnovationDecomposition;
+
+  /**
+   * @brief A recorded propagation or update.
+   */
+  struct Step {
+    bool update = false;
+
+    //! The jacobian F or H and noise W.Q.W^T or M.R.M^T
+    Matrix J, N;
+
+    //! The kalman gain and innovation covariance of an update
+    Matrix K;
+    InnovationDecomposition S;
+
+    //! The covariance after the step
+    Covariance<StateType> P;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+  };
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(SteadyStateBase);
+
+  /**
+   * @brief The frozen propagation matching F and N, if steady.
+   * @return The recorded step or nullptr
+   */
+  template <typename _DerivedF, typename _DerivedN>
+  const Step* steadyPropagation(
+    const Eigen::MatrixBase<_DerivedF>& F,
+    const Eigen::MatrixBase<_DerivedN>& N
+  ) {
+    if (updated_) {
+      startCycle();
+      updated_ = false;
+    }
+    return steadyStep(false, F, N);
+  }
+
+  /**
+   * @brief The frozen update matching H and MRMt, if steady.
+   * @return The recorded step or nullptr
+   */
+  template <typename _DerivedH, typename _DerivedR>
+  const Step* steadyUpdate(
+    const Eigen::MatrixBase<_DerivedH>& H,
+    const Eigen::MatrixBase<_DerivedR>& MRMt
+  ) {
+    updated_ = true;
+    return steadyStep(true, H, MRMt);
+  }
+
+  template <typename _DerivedF, typename _DerivedN, typename _DerivedP>
+  void recordPropagation(
+    const Eigen::MatrixBase<_DerivedF>& F,
+    const Eigen::MatrixBase<_DerivedN>& N,
+    const Eigen::MatrixBase<_DerivedP>& P
+  ) {
+    Step& step = nextStep();
+    step.update = false;
+    step.J = F;
+    step.N = N;
+    step.P = P;
+  }
+
+  template <
+    typename _DerivedH, typename _DerivedR,
+    typename _DerivedK, typename _DerivedP
+  >
+  void recordUpdate(
+    const Eigen::MatrixBase<_DerivedH>& H,
+    const Eigen::MatrixBase<_DerivedR>& MRMt,
+    const Eigen::MatrixBase<_DerivedK>& K,
+    const InnovationDecomposition& S,
+    const Eigen::MatrixBase<_DerivedP>& P
+  ) {
+    Step& step = nextStep();
+    step.update = true;
+    step.J = H;
+    step.N = MRMt;
+    step.K = K;
+    step.S = S;
+    step.P = P;
+  }
+
+  /**
+   * @brief Discard the recorded cycles, e.g. after a step
+   * that can not be recorded, and fall back to the full filter.
+   */
+  void resetSteadyState() {
+    steady_ = false;
+    recorded_ = previous_recorded_ = index_ = 0;
+  }
+
+  bool steady_state_gain_ = false;
+  bool steady_ = false;
+  Scalar tolerance_ = 1e-9;
+
+private:
+
+  /**
+   * @brief Close the current cycle: check that the frozen cycle
+   * was entirely replayed, or whether the last two recorded ones match.
+   */
+  void startCycle() {
+    if (steady_) {
+      if (index_ != recorded_) {
+        resetSteadyState();
+      }
+      index_ = 0;
+      return;
+    }
+
+    if (recorded_ > 0 && recorded_ == previous_recorded_) {
+      steady_ = true;
+      for (std::size_t i = 0; steady_ && i < recorded_; ++i) {
+        steady_ = matches(previous_[i], current_[i]);
+      }
+    }
+
+    if (steady_) {
+      index_ = 0;
+      return;
+    }
+
+    // storage is swapped rather than cleared to keep the allocations
+    std::swap(previous_, current_);
+    previous_recorded_ = recorded_;
+    recorded_ = 0;
+  }
+
+  template <typename _DerivedJ, typename _DerivedN>
+  const Step* steadyStep(
+    const bool update,
+    const Eigen::MatrixBase<_DerivedJ>& J,
+    const Eigen::MatrixBase<_DerivedN>& N
+  ) {
+    if (!steady_) {
+      return nullptr;
+    }
+
+    if (index_ < recorded_) {
+      const Step& step = current_[index_];
+      if (step.update == update && approx(step.J, J) && approx(step.N, N)) {
+        ++index_;
+        return &step;
+      }
+    }
+
+    // the configuration changed, fall back to the full filter
+    resetSteadyState();
+    return nullptr;
+  }
+
+  Step& nextStep() {
+    if (current_.size() == recorded_) {
+      current_.emplace_back();
+    }
+    return current_[recorded_++];
+  }
+
+  bool matches(const Step& a, const Step& b) const {
+    return
+      a.update == b.update &&
+      approx(a.J, b.J) && approx(a.N, b.N) && approx(a.P, b.P);
+  }
+
+  template <typename _DerivedA, typename _DerivedB>
+  bool approx(
+    const Eigen::MatrixBase<_DerivedA>& a,
+    const Eigen::MatrixBase<_DerivedB>& b
+  ) const {
+    return
+      a.rows() == b.rows() && a.cols() == b.cols() &&
+      (a - b).cwiseAbs().maxCoeff() <= tolerance_ * a.cwiseAbs().maxCoeff();
+  }
+
+  bool updated_ = true;
+
+  //! The cycle being recorded or frozen and the previous one
+  std::vector<Step, Eigen::aligned_allocator<Step>> current_, previous_;
+  std::size_t recorded_ = 0, previous_recorded_ = 0;
+
+  //! The next step of the frozen cycle
+  std::size_t index_ = 0;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_STEADY_STATE_H_
@@ -0,0 +1,168 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_STRAND_H_
+#define _KALMANIF_KALMANIF_IMPL_STRAND_H_
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if KALMANIF_HAS_COROUTINES
+#include <coroutine>
+#endif
+
+namespace kalmanif {
+
+/**
+ * @brief A strand serializes the tasks posted to it,
+ * in order, over a user scheduler.
+ *
+ * A scheduler is any copyable type providing
+ * 'void operator ()(std::function<void()> task)' which runs
+ * the task later, on any thread (e.g. by posting it to a thread pool).
+ *
+ * Posting is lock-free. A strand submits at most one task to the
+ * scheduler at a time, which then runs all the tasks posted until
+ * the strand is empty. Many strands, e.g. one per filter,
+ * may thus share a small thread pool without any mutex.
+ *
+ * @note Posted tasks must not throw.
+ * @note The strand must outlive the tasks posted to it.
+ *
+ * @tparam Scheduler The scheduler type
+ */
+template <typename Scheduler>
+class Strand {
+
+public:
+
+  using Task = std::function<void()>;
+
+  explicit Strand(Scheduler scheduler = Scheduler())
+    : scheduler_(std::move(scheduler)), head_(new Node), tail_(head_.load()) {}
+
+  Strand(const Strand&) = delete;
+  Strand& operator =(const Strand&) = delete;
+
+  ~Strand() {
+    while (tail_ != nullptr) {
+      Node* next = tail_->next.load(std::memory_order_relaxed);
+      delete tail_;
+      tail_ = next;
+    }
+  }
+
+  /**
+   * @brief Post a task to run after all the tasks posted before it
+   * @param [in] task The task
+   */
+  template <typename Function>
+  void post(Function&& task) {
+    Node* node = new Node;
+    node->task = Task(std::forward<Function>(task));
+
+    Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+
+    if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0) {
+      scheduler_([this]{ drain(); });
+    }
+  }
+
+  const Scheduler& getScheduler() const {
+    return scheduler_;
+  }
+
+protected:
+
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    Task task;
+  };
+
+  /**
+   * @brief Run the posted tasks until the strand is empty.
+   * Only one drain runs at a time.
+   */
+  void drain() {
+    do {
+      Node* next;
+      // a task may be counted before the node of an earlier post is linked
+      while ((next = tail_->next.load(std::memory_order_acquire)) == nullptr) {
+        std::this_thread::yield();
+      }
+      Task task = std::move(next->task);
+      delete tail_;
+      tail_ = next;
+      task();
+    } while (pending_.fetch_sub(1, std::memory_order_acq_rel) > 1);
+  }
+
+  Scheduler scheduler_;
+  // A Vyukov MPSC queue, tail_ is its consumed (dummy) node
+  std::atomic<Node*> head_;
+  Node* tail_;
+  std::atomic<std::size_t> pending_{0};
+};
+
+#if KALMANIF_HAS_COROUTINES
+
+namespace internal {
+
+/**
+ * @brief An awaitable running a function on a strand
+ * and resuming the awaiting coroutine there with its result.
+ *
+ * If the function throws, the exception is rethrown
+ * in the awaiting coroutine.
+ */
+template <typename Strand, typename Function>
+class StrandAwaitable {
+
+public:
+
+  using Result = std::invoke_result_t<Function&>;
+
+  StrandAwaitable(Strand& strand, Function function)
+    : strand_(strand), function_(std::move(function)) {}
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    strand_.post([this, handle]{
+      try {
+        result_.emplace(function_());
+      } catch (...) {
+        error_ = std::current_exception();
+      }
+      handle.resume();
+    });
+  }
+
+  Result await_resume() {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return std::move(*result_);
+  }
+
+protected:
+
+  Strand& strand_;
+  Function function_;
+  std::optional<Result> result_;
+  std::exception_ptr error_;
+};
+
+} // namespace internal
+
+#endif // KALMANIF_HAS_COROUTINES
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_STRAND_H_
@@ -22,6 +22,300 @@ template <typename T, class Enable = void> struct traits;
 template <typename T, class Enable>
 struct traits<const T, Enable> : traits<T, Enable> {};
 
+/**
+ * @brief Whether the measurement model T declares a diagonal noise,
+ * that is, traits<T>::DiagonalNoise exists and is true.
+ *
+ * @note The noise is the covariance as seen by the filter
+ * (e.g. \f$ MRM^T \f$ for the IEKF). It is diagonal for instance
+ * for a diagonal R with an identity noise jacobian M,
+ * or for an isotropic R.
+ */
+template <typename T, class Enable = void>
+struct has_diagonal_noise : std::false_type {};
+
+template <typename T>
+struct has_diagonal_noise<T, std::void_t<decltype(traits<T>::DiagonalNoise)>>
+  : std::integral_constant<bool, traits<T>::DiagonalNoise> {};
+
+/**
+ * @brief Whether the system model T declares a state-independent
+ * invariant jacobian, that is,
+ * traits<T>::StateIndependentInvariantJacobian exists and is true.
+ *
+ * Such a model provides
+ * - getInvariantJacobian(dt), its invariant jacobian F,
+ * - run_linearized_invariant(x, u, W, dt), which only computes
+ *   the propagated state and the noise jacobian.
+ */
+template <typename T, class Enable = void>
+struct has_state_independent_invariant_jacobian : std::false_type {};
+
+template <typename T>
+struct has_state_independent_invariant_jacobian<
+  T, std::void_t<decltype(traits<T>::StateIndependentInvariantJacobian)>
+> : std::integral_constant<
+      bool, traits<T>::StateIndependentInvariantJacobian
+    > {};
+
+/**
+ * @brief Whether the system model T provides its left invariant
+ * jacobians, that is,
+ * traits<T>::LeftInvariantJacobian exists and is true.
+ *
+ * Such a model provides
+ * run_linearized_invariant<Invariance::Left>(x, u, F, W, dt).
+ * The jacobians of the other models are mapped from their right
+ * invariant ones by a left invariant filter.
+ */
+template <typename T, class Enable = void>
+struct has_left_invariant_jacobian : std::false_type {};
+
+template <typename T>
+struct has_left_invariant_jacobian<
+  T, std::void_t<decltype(traits<T>::LeftInvariantJacobian)>
+> : std::integral_constant<bool, traits<T>::LeftInvariantJacobian> {};
+
+/**
+ * @brief Whether the system model T declares a state-independent
+ * noise jacobian W, that is,
+ * traits<T>::ConstantNoiseJacobian exists and is true.
+ *
+ * Such a model provides getPropagatedNoise(args...), its noise
+ * \f$ W Q W^T \f$ computed once and returned by const reference,
+ * args being the model's extra arguments (e.g. dt).
+ */
+template <typename T, class Enable = void>
+struct has_constant_noise_jacobian : std::false_type {};
+
+template <typename T>
+struct has_constant_noise_jacobian<
+  T, std::void_t<decltype(traits<T>::ConstantNoiseJacobian)>
+> : std::integral_constant<bool, traits<T>::ConstantNoiseJacobian> {};
+
+/**
+ * @brief Whether the system model T declares a state-independent
+ * invariant noise jacobian W, that is,
+ * traits<T>::ConstantInvariantNoiseJacobian exists and is true.
+ *
+ * Such a model provides getInvariantPropagatedNoise(dt), its invariant
+ * noise \f$ W Q W^T \f$ computed once and returned by const reference.
+ */
+template <typename T, class Enable = void>
+struct has_constant_invariant_noise_jacobian : std::false_type {};
+
+template <typename T>
+struct has_constant_invariant_noise_jacobian<
+  T, std::void_t<decltype(traits<T>::ConstantInvariantNoiseJacobian)>
+> : std::integral_constant<
+      bool, traits<T>::ConstantInvariantNoiseJacobian
+    > {};
+
+/**
+ * @brief Whether the model T on an AugmentedState declares a jacobian
+ * only non-zero on its pose block, that is,
+ * traits<T>::PoseBlockJacobian exists and is true.
+ *
+ * Such a system model has jacobians \f$ F = diag(F_{pose}, I) \f$ and
+ * \f$ W = [W_{pose}; 0] \f$ and provides
+ * run_linearized_pose(x, u, F_pose, W_pose, args...).
+ *
+ * Such a measurement model has a jacobian \f$ H = [H_{pose}, 0] \f$
+ * and provides run_linearized_pose(x, H_pose, V).
+ */
+template <typename T, class Enable = void>
+struct has_pose_block_jacobian : std::false_type {};
+
+template <typename T>
+struct has_pose_block_jacobian<
+  T, std::void_t<decltype(traits<T>::PoseBlockJacobian)>
+> : std::integral_constant<bool, traits<T>::PoseBlockJacobian> {};
+
+/**
+ * @brief Whether the measurement model T on an AugmentedState declares
+ * a jacobian only non-zero on its pose and one landmark blocks, that is,
+ * traits<T>::LandmarkBlockJacobian exists and is true.
+ *
+ * Such a model has a jacobian \f$ H = [H_{pose}, 0, H_{l}, 0] \f$,
+ * \f$ H_{l} \f$ starting at column getColumn(), and provides
+ * run_linearized_blocks(x, H_pose, H_landmark, V).
+ * The block is traits<T>::JacobianBlockSize columns wide,
+ * see jacobian_block_size, e.g. a landmark or a sensor calibration.
+ */
+template <typename T, class Enable = void>
+struct has_landmark_block_jacobian : std::false_type {};
+
+template <typename T>
+struct has_landmark_block_jacobian<
+  T, std::void_t<decltype(traits<T>::LandmarkBlockJacobian)>
+> : std::integral_constant<bool, traits<T>::LandmarkBlockJacobian> {};
+
+/**
+ * @brief The number of columns of the non-zero block, other than the
+ * pose, of a block jacobian on State, traits<T>::JacobianBlockSize
+ * if it exists, State::LandmarkDim otherwise.
+ *
+ * @see has_landmark_block_jacobian
+ */
+template <typename T, typename State, class Enable = void>
+struct jacobian_block_size
+  : std::integral_constant<int, State::LandmarkDim> {};
+
+template <typename T, typename State>
+struct jacobian_block_size<
+  T, State, std::void_t<decltype(traits<T>::JacobianBlockSize)>
+> : std::integral_constant<int, traits<T>::JacobianBlockSize> {};
+
+/**
+ * @brief Whether the model T evaluates batches of states
+ * in a single call, that is,
+ * traits<T>::BatchEvaluation exists and is true.
+ *
+ * Such a measurement model provides run_batch(xs, ys), with xs a random
+ * access range of states and ys.col(j) the measurement at xs[j],
+ * e.g. to vectorize across the sigma points of the UKFM.
+ *
+ * Such a system model provides run_batch(xs, us, xs_new, args...),
+ * with xs and us random access ranges of states and controls and
+ * xs_new[j] the propagation of xs[j] with us[j].
+ *
+ * @see MeasurementModelBase::batch
+ * @see SystemModelBase::batch
+ */
+template <typename T, class Enable = void>
+struct has_batch_evaluation : std::false_type {};
+
+template <typename T>
+struct has_batch_evaluation<
+  T, std::void_t<decltype(traits<T>::BatchEvaluation)>
+> : std::integral_constant<bool, traits<T>::BatchEvaluation> {};
+
+/**
+ * @brief Whether the system model T linearizes batches of states
+ * in a single call, that is,
+ * traits<T>::LinearizedBatchEvaluation exists and is true.
+ *
+ * Such a model provides run_linearized_batch(xs, us, xs_new, Fs, Ws, args...),
+ * xs_new[j], Fs[j] and Ws[j] being the propagation of xs[j] with us[j]
+ * and its jacobians, e.g. over the tracks of a FilterBank.
+ *
+ * @see Linearized<SystemModelBase<Derived>>::batch
+ */
+template <typename T, class Enable = void>
+struct has_linearized_batch_evaluation : std::false_type {};
+
+template <typename T>
+struct has_linearized_batch_evaluation<
+  T, std::void_t<decltype(traits<T>::LinearizedBatchEvaluation)>
+> : std::integral_constant<bool, traits<T>::LinearizedBatchEvaluation> {};
+
+/**
+ * @brief Whether the system model T propagates a state in place,
+ * that is, traits<T>::InPlaceEvaluation exists and is true.
+ *
+ * Such a model provides run_into(x, u, x_new, args...), and if linearized
+ * run_linearized_into(x, u, x_new, F, W, args...), if invariant
+ * run_linearized_invariant_into(x, u, x_new, F, W, dt) and, with a pose
+ * block jacobian, run_linearized_pose_into(x, u, x_new, F, W, args...),
+ * writing the propagated state in x_new rather than returning it.
+ * x_new may be x itself, the filters propagate their state in place,
+ * so that a state holding dynamic storage is neither copied nor
+ * reallocated at each step.
+ *
+ * @see SystemModelBase::into
+ * @see Linearized<SystemModelBase<Derived>>::into
+ * @see LinearizedInvariant<SystemModelBase<Derived>>::into
+ */
+template <typename T, class Enable = void>
+struct has_in_place_evaluation : std::false_type {};
+
+template <typename T>
+struct has_in_place_evaluation<
+  T, std::void_t<decltype(traits<T>::InPlaceEvaluation)>
+> : std::integral_constant<bool, traits<T>::InPlaceEvaluation> {};
+
+/**
+ * @brief Whether the system model T is evaluated as run(x, u, dt).
+ * @see has_time_step_evaluation
+ */
+template <typename T, class Enable = void>
+struct has_time_step_run : std::false_type {};
+
+template <typename T>
+struct has_time_step_run<
+  T, std::void_t<decltype(
+    std::declval<const T&>().run(
+      std::declval<const typename traits<T>::State&>(),
+      std::declval<const typename traits<T>::Control&>(),
+      std::declval<typename traits<T>::State::Scalar>()
+    )
+  )>
+> : std::true_type {};
+
+/**
+ * @brief Whether the system model T propagates over a time step,
+ * that is, traits<T>::TimeStep exists and is true or else
+ * T is evaluated as run(x, u, dt), e.g. the SimpleImuSystemModel.
+ *
+ * The time step of a propagation is forwarded to such models only,
+ * e.g. by the FusionFrontEnd or the ReplayEngine.
+ * A model forwarding its arguments to another,
+ * e.g. the AugmentedSystemModel, sets traits<T>::TimeStep.
+ */
+template <typename T, class Enable = void>
+struct has_time_step_evaluation : has_time_step_run<T> {};
+
+template <typename T>
+struct has_time_step_evaluation<
+  T, std::void_t<decltype(traits<T>::TimeStep)>
+> : std::integral_constant<bool, traits<T>::TimeStep> {};
+
+/**
+ * @brief Whether the filters of the state T use closed-form kernels
+ * for their small fixed-size decompositions, that is,
+ * traits<T>::ClosedFormKernels exists and is true.
+ *
+ * The Cholesky decompositions, inverses and eigen-decompositions
+ * of size at most 3 (e.g. the whole covariance of SO2, SE2 or SO3)
+ * are then computed in closed form rather than by the generic
+ * Eigen decompositions.
+ *
+ * @see ClosedFormLLT
+ */
+template <typename T, class Enable = void>
+struct has_closed_form_kernels : std::false_type {};
+
+template <typename T>
+struct has_closed_form_kernels<
+  T, std::void_t<decltype(traits<T>::ClosedFormKernels)>
+> : std::integral_constant<bool, traits<T>::ClosedFormKernels> {};
+
+/**
+ * @brief Whether the filter T may defer its covariance propagation,
+ * that is, T::isLazyPropagation() exists.
+ *
+ * @see LazyCovarianceBase
+ */
+template <typename T, class Enable = void>
+struct has_lazy_propagation : std::false_type {};
+
+template <typename T>
+struct has_lazy_propagation<
+  T, std::void_t<decltype(std::declval<const T&>().isLazyPropagation())>
+> : std::true_type {};
+
+/**
+ * @brief Whether the filter is in lazy propagation mode.
+ */
+template <typename Filter>
+bool isLazyPropagation(const Filter& filter) {
+  if constexpr (has_lazy_propagation<Filter>{}) {
+    return filter.isLazyPropagation();
+  } else {
+    return false;
+  }
+}
+
 } // namespace internal
 } // namespace manif
 
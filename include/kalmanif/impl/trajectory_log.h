@@ -0,0 +1,395 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_TRAJECTORY_LOG_H_
+#define _KALMANIF_KALMANIF_IMPL_TRAJECTORY_LOG_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kalmanif {
+
+/**
+ * @brief The header of a trajectory log file.
+ *
+ * A trajectory log is this header followed by fixed-size records,
+ * each one the time stamp (a double) followed by the
+ * encoded estimate (the state coefficients and the
+ * column-major upper triangle of its covariance),
+ * in the host byte order.
+ *
+ * @see EncodedEstimate
+ */
+struct TrajectoryLogHeader {
+
+  char magic[8];
+  std::uint32_t version;
+  //! The size in bytes of a scalar
+  std::uint32_t scalar_size;
+  //! The number of state coefficients
+  std::uint32_t rep_size;
+  //! The state degrees of freedom
+  std::uint32_t dof;
+  //! The size in bytes of a record
+  std::uint64_t record_size;
+  char reserved[32];
+};
+
+static_assert(
+  sizeof(TrajectoryLogHeader) == 64, "Unexpected TrajectoryLogHeader padding!"
+);
+
+namespace internal {
+
+template <typename State>
+TrajectoryLogHeader makeTrajectoryLogHeader() {
+  TrajectoryLogHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, "KALMANIF", sizeof(header.magic));
+  header.version = 1;
+  header.scalar_size = sizeof(typename internal::traits<State>::Scalar);
+  header.rep_size = State::RepSize;
+  header.dof = State::DoF;
+  header.record_size = sizeof(double) + encodedEstimateSize<State>();
+  return header;
+}
+
+} // namespace internal
+
+/**
+ * @brief A streaming writer of a filter trajectory.
+ *
+ * Each record is appended to a small buffer of fixed capacity,
+ * written to the file once full or on flush,
+ * so that the memory used does not grow with the trajectory length.
+ * The records written so far can be read while logging,
+ * e.g. by a TrajectoryLogReader in another process.
+ *
+ * @tparam _State The state type
+ *
+ * @see TrajectoryLogReader
+ */
+template <typename _State>
+class TrajectoryLogWriter {
+
+public:
+
+  using State = _State;
+  using StateCovariance = Covariance<State>;
+
+  //! The size in bytes of a record
+  static constexpr std::size_t RecordSize =
+    sizeof(double) + encodedEstimateSize<State>();
+
+  /**
+   * @brief Construct a writer to the file at path
+   * @param path The file path, created or truncated.
+   * @param buffered_records The number of records buffered
+   * before they are written to the file.
+   */
+  explicit TrajectoryLogWriter(
+    std::string path, const std::size_t buffered_records = 64
+  ) : path_(std::move(path))
+    , buffer_(std::max<std::size_t>(buffered_records, 1) * RecordSize) {
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    KALMANIF_ENSURE(
+      fd_ >= 0,
+      "TrajectoryLogWriter: cannot open '" + path_ + "': " + std::strerror(errno)
+    );
+
+    const TrajectoryLogHeader header = internal::makeTrajectoryLogHeader<State>();
+    writeAll(reinterpret_cast<const std::uint8_t*>(&header), sizeof(header));
+  }
+
+  TrajectoryLogWriter(const TrajectoryLogWriter&) = delete;
+  TrajectoryLogWriter& operator =(const TrajectoryLogWriter&) = delete;
+
+  TrajectoryLogWriter(TrajectoryLogWriter&& other) noexcept {
+    swap(other);
+  }
+
+  TrajectoryLogWriter& operator =(TrajectoryLogWriter&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~TrajectoryLogWriter() {
+    if (fd_ < 0) {
+      return;
+    }
+    try {
+      flush();
+    } catch (...) {
+      // nothing to do about it here
+    }
+    ::close(fd_);
+  }
+
+  /**
+   * @brief Append a record
+   * @param t The time stamp
+   * @param X The state
+   * @param P The state covariance
+   */
+  void write(const double t, const State& X, const StateCovariance& P) {
+    if (buffered_ == buffer_.size()) {
+      flush();
+    }
+    std::uint8_t* record = buffer_.data() + buffered_;
+    std::memcpy(record, &t, sizeof(double));
+    encodeEstimate(X, P, record + sizeof(double));
+    buffered_ += RecordSize;
+    ++size_;
+  }
+
+  /**
+   * @brief Append the current estimate of a filter
+   * @param t The time stamp
+   * @param filter The filter
+   */
+  template <typename Filter>
+  void write(const double t, const Filter& filter) {
+    write(t, filter.getState(), filter.getCovariance());
+  }
+
+  /**
+   * @brief Write the buffered records to the file.
+   */
+  void flush() {
+    writeAll(buffer_.data(), buffered_);
+    buffered_ = 0;
+  }
+
+  //! The number of records written, including the buffered ones
+  std::size_t size() const { return size_; }
+
+  const std::string& path() const { return path_; }
+
+protected:
+
+  void writeAll(const std::uint8_t* data, std::size_t bytes) {
+    while (bytes > 0) {
+      const ssize_t written = ::write(fd_, data, bytes);
+      if (written < 0 && errno == EINTR) {
+        continue;
+      }
+      KALMANIF_ENSURE(
+        written > 0,
+        "TrajectoryLogWriter: cannot write '" + path_ + "': " + std::strerror(errno)
+      );
+      data += written;
+      bytes -= std::size_t(written);
+    }
+  }
+
+  void swap(TrajectoryLogWriter& other) noexcept {
+    std::swap(path_, other.path_);
+    std::swap(fd_, other.fd_);
+    std::swap(buffer_, other.buffer_);
+    std::swap(buffered_, other.buffered_);
+    std::swap(size_, other.size_);
+  }
+
+  std::string path_;
+  int fd_ = -1;
+  std::vector<std::uint8_t> buffer_;
+  std::size_t buffered_ = 0;
+  std::size_t size_ = 0;
+};
+
+/**
+ * @brief A memory-mapped reader of a trajectory log.
+ *
+ * The records are decoded on access and paged in by the operating
+ * system, so that long logs can be analysed without being loaded.
+ * The log may still be written to, see refresh.
+ *
+ * @tparam _State The state type
+ *
+ * @see TrajectoryLogWriter
+ */
+template <typename _State>
+class TrajectoryLogReader {
+
+public:
+
+  using State = _State;
+  using StateCovariance = Covariance<State>;
+  using Record = Estimate<State>;
+
+  static constexpr std::size_t RecordSize =
+    TrajectoryLogWriter<State>::RecordSize;
+
+  /**
+   * @brief Construct a reader of the file at path
+   * @param path The file path
+   * @throw kalmanif::runtime_error if the file cannot be read
+   * or was not written for State.
+   */
+  explicit TrajectoryLogReader(std::string path) : path_(std::move(path)) {
+    fd_ = ::open(path_.c_str(), O_RDONLY);
+    KALMANIF_ENSURE(
+      fd_ >= 0,
+      "TrajectoryLogReader: cannot open '" + path_ + "': " + std::strerror(errno)
+    );
+
+    TrajectoryLogHeader header;
+    KALMANIF_ENSURE(
+      ::pread(fd_, &header, sizeof(header), 0) == ssize_t(sizeof(header)),
+      "TrajectoryLogReader: '" + path_ + "' has no header!"
+    );
+
+    const TrajectoryLogHeader expected =
+      internal::makeTrajectoryLogHeader<State>();
+    KALMANIF_ENSURE(
+      std::memcmp(header.magic, expected.magic, sizeof(header.magic)) == 0 &&
+      header.version == expected.version,
+      "TrajectoryLogReader: '" + path_ + "' is not a trajectory log!"
+    );
+    KALMANIF_ENSURE(
+      header.scalar_size == expected.scalar_size &&
+      header.rep_size == expected.rep_size &&
+      header.dof == expected.dof &&
+      header.record_size == expected.record_size,
+      "TrajectoryLogReader: '" + path_ + "' was not written for this state type!"
+    );
+
+    refresh();
+  }
+
+  TrajectoryLogReader(const TrajectoryLogReader&) = delete;
+  TrajectoryLogReader& operator =(const TrajectoryLogReader&) = delete;
+
+  TrajectoryLogReader(TrajectoryLogReader&& other) noexcept {
+    swap(other);
+  }
+
+  TrajectoryLogReader& operator =(TrajectoryLogReader&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~TrajectoryLogReader() {
+    unmap();
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  /**
+   * @brief Map the records appended since the last refresh.
+   *
+   * A partially written trailing record is ignored.
+   *
+   * @return The number of records
+   */
+  std::size_t refresh() {
+    struct stat st;
+    KALMANIF_ENSURE(
+      ::fstat(fd_, &st) == 0,
+      "TrajectoryLogReader: cannot stat '" + path_ + "': " + std::strerror(errno)
+    );
+
+    const std::size_t size =
+      (std::size_t(st.st_size) - sizeof(TrajectoryLogHeader)) / RecordSize;
+
+    if (size == size_) {
+      return size_;
+    }
+
+    unmap();
+
+    mapped_bytes_ = sizeof(TrajectoryLogHeader) + size * RecordSize;
+    void* data = ::mmap(
+      nullptr, mapped_bytes_, PROT_READ, MAP_SHARED, fd_, 0
+    );
+    KALMANIF_ENSURE(
+      data != MAP_FAILED,
+      "TrajectoryLogReader: cannot map '" + path_ + "': " + std::strerror(errno)
+    );
+
+    data_ = static_cast<const std::uint8_t*>(data);
+    size_ = size;
+
+    return size_;
+  }
+
+  //! The time stamp of the ith record
+  double time(const std::size_t i) const {
+    double t;
+    std::memcpy(&t, record(i), sizeof(double));
+    return t;
+  }
+
+  //! The estimate of the ith record
+  Record operator [](const std::size_t i) const {
+    return decodeEstimate<State>(
+      record(i) + sizeof(double), encodedEstimateSize<State>()
+    );
+  }
+
+  /**
+   * @brief The estimate of the ith record
+   * @throw kalmanif::invalid_argument if i is out of range
+   */
+  Record at(const std::size_t i) const {
+    KALMANIF_ENSURE(
+      i < size_,
+      "TrajectoryLogReader: Record index out of range!",
+      kalmanif::invalid_argument
+    );
+    return (*this)[i];
+  }
+
+  //! The state of the ith record
+  State state(const std::size_t i) const {
+    State X;
+    std::memcpy(
+      X.coeffs().data(), record(i) + sizeof(double),
+      State::RepSize * sizeof(typename internal::traits<State>::Scalar)
+    );
+    return X;
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const std::string& path() const { return path_; }
+
+protected:
+
+  const std::uint8_t* record(const std::size_t i) const {
+    return data_ + sizeof(TrajectoryLogHeader) + i * RecordSize;
+  }
+
+  void unmap() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<std::uint8_t*>(data_), mapped_bytes_);
+      data_ = nullptr;
+    }
+  }
+
+  void swap(TrajectoryLogReader& other) noexcept {
+    std::swap(path_, other.path_);
+    std::swap(fd_, other.fd_);
+    std::swap(data_, other.data_);
+    std::swap(mapped_bytes_, other.mapped_bytes_);
+    std::swap(size_, other.size_);
+  }
+
+  std::string path_;
+  int fd_ = -1;
+  const std::uint8_t* data_ = nullptr;
+  std::size_t mapped_bytes_ = 0;
+  std::size_t size_ = 0;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_TRAJECTORY_LOG_H_
@@ -0,0 +1,72 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_TRANSITION_H_
+#define _KALMANIF_KALMANIF_IMPL_TRANSITION_H_
+
+namespace kalmanif {
+namespace internal {
+
+/**
+ * @brief Lend an output to a filter for the lifetime of the guard,
+ * e.g. the storage of the transition of a propagation.
+ *
+ * @tparam T The output type
+ */
+template <typename T>
+struct ScopedOutput {
+
+  /**
+   * @param [in,out] output The filter output pointer
+   * @param [in] storage The storage lent, nullptr to not record
+   */
+  ScopedOutput(T*& output, T* storage) : output_(output) {
+    output_ = storage;
+  }
+
+  ~ScopedOutput() {
+    output_ = nullptr;
+  }
+
+  ScopedOutput(const ScopedOutput&) = delete;
+  ScopedOutput& operator =(const ScopedOutput&) = delete;
+
+protected:
+
+  T*& output_;
+};
+
+/**
+ * @brief Base class for filters recording the transition of their
+ * propagations, as the smoothers wrapping them need it.
+ *
+ * A filter does not hold the (dense) transition itself:
+ * a smoother lends its own storage for the time of a propagation,
+ * see ScopedOutput, so that a filter alone carries no
+ * smoother-only state, and skips computing the transition
+ * when it is not statistically given by the propagation.
+ */
+template <typename StateType>
+struct TransitionBase {
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(TransitionBase);
+
+protected:
+
+  //! Whether the transition of the propagation is recorded
+  bool recordsTransition() const {
+    return transition_ != nullptr;
+  }
+
+  //! Record the transition of the propagation, if lent a storage
+  template <typename _Derived>
+  void recordTransition(const Eigen::MatrixBase<_Derived>& A) {
+    if (transition_ != nullptr) {
+      *transition_ = A;
+    }
+  }
+
+  Jacobian<StateType, StateType>* transition_ = nullptr;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_TRANSITION_H_
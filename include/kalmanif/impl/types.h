@@ -91,6 +91,85 @@ using Jacobian = Eigen::Matrix<
   MaxCols
 >;
 
+/**
+ * @brief An alias for a jacobian J_A_B output argument of the models
+ *
+ * A plain fixed-size Jacobian<A, B> passed by non-const reference is
+ * written through that very reference, its sizes and strides being known
+ * at compile time. Any other argument (e.g. a block of a larger matrix,
+ * or a dynamic-size jacobian) is written through an Eigen::Ref.
+ *
+ * A model dispatches its outputs at compile time by taking them
+ * as forwarding references,
+ *
+ * @code
+ * template <typename _JacobianH, typename _JacobianV>
+ * Measurement run_linearized(
+ *   const State& x, _JacobianH&& H_out, _JacobianV&& V_out
+ * ) const {
+ *   JacobianOutput<_JacobianH, Measurement, State> H = H_out;
+ *   JacobianOutput<_JacobianV, Measurement, Measurement> V = V_out;
+ *   ...
+ * }
+ * @endcode
+ *
+ * @tparam J The deduced type of the argument
+ * @tparam A The 'input' vector type
+ * @tparam B The 'output' vector type
+ *
+ * @see Jacobian
+ */
+template <typename J, class A, class B>
+using JacobianOutput = std::conditional_t<
+  std::is_same<std::remove_reference_t<J>, Jacobian<A, B>>::value &&
+  Jacobian<A, B>::SizeAtCompileTime != Eigen::Dynamic,
+  Jacobian<A, B>&,
+  Eigen::Ref<Jacobian<A, B>>
+>;
+
+/**
+ * @brief An alias for a stack of measurements
+ *
+ * @tparam Measurement The measurement type
+ * @tparam Count The number of stacked measurements or Eigen::Dynamic
+ * @tparam MaxCount The maximum number of stacked measurements
+ *
+ * @note With Count == Eigen::Dynamic the stack is 'bounded-dynamic',
+ * that is, its storage is fixed-size (MaxCount measurements)
+ * and thus does not allocate.
+ */
+template <
+  class Measurement,
+  int Count,
+  int MaxCount = (Count == Eigen::Dynamic) ?
+    KALMANIF_MAX_STACKED_MEASUREMENTS : Count
+>
+using StackedMeasurement = Eigen::Matrix<
+  typename internal::traits<Measurement>::Scalar,
+  (Count == Eigen::Dynamic) ?
+    Eigen::Dynamic : Count * internal::traits<Measurement>::Size,
+  1,
+  0,
+  MaxCount * internal::traits<Measurement>::Size,
+  1
+>;
+
+/**
+ * @brief An alias for the covariance of a stack of measurements
+ *
+ * @tparam Stacked The stacked measurement type
+ *
+ * @see StackedMeasurement
+ */
+template <class Stacked>
+using StackedCovariance = SquareMatrix<
+  typename Stacked::Scalar,
+  Stacked::RowsAtCompileTime,
+  0,
+  Stacked::MaxRowsAtCompileTime,
+  Stacked::MaxRowsAtCompileTime
+>;
+
 } // namespace kalmanif
 
 #endif // _KALMANIF_KALMANIF_IMPL_TYPES_H_
@@ -1,72 +1,212 @@
 #ifndef _KALMANIF_KALMANIF_IMPL_UNSCENTED_KALMAN_FILTER_MANIFOLDS_H_
 #define _KALMANIF_KALMANIF_IMPL_UNSCENTED_KALMAN_FILTER_MANIFOLDS_H_
 
+#include <array>
+
 namespace kalmanif {
-namespace {
 
-template <typename Scalar>
-struct Weights {
-  KALMANIF_DEFAULT_CONSTRUCTOR(Weights);
-  KALMANIF_DEFAULT_OPERATOR(Weights);
+// Forward declaration
+template <typename Derived> struct SystemModelBase;
+template <typename Filter, typename Storage> struct RauchTungStriebelSmoother;
+template <typename Filter, std::size_t Lag> struct FixedLagSmoother;
+template <typename Filter> struct FilterCheckpoint;
 
-  Weights(const Scalar l, const Scalar alpha) {
-    using std::sqrt;
+namespace internal {
 
-    const Scalar m = (alpha * alpha - 1) * l;
-    const Scalar ml = m + l;
+/**
+ * @brief Propagate the state and noise sigma points of the UKFM,
+ * in two batch calls if the model evaluates batches, see
+ * internal::has_batch_evaluation. Otherwise the evaluations are
+ * independent, the executor may thus run them concurrently.
+ *
+ * @tparam Iv The invariance the sigma points are retracted in
+ * @param [in] executor The executor
+ * @param [in] f The system model
+ * @param [in] x The state
+ * @param [in] x_new The propagated state
+ * @param [in] u The control
+ * @param [in] xis The state sigma points, one per column
+ * @param [in] w_ps The noise sigma points, one per column
+ * @param [out] xis_new The errors of x_new w.r.t. the propagated xis
+ * @param [out] xis_new2 The errors of x_new w.r.t. the propagated w_ps
+ * @param [in] args The other arguments of the model, e.g. dt
+ */
+template <
+  Invariance Iv, typename Executor, class SystemModelDerived,
+  typename State, typename _DerivedX, typename _DerivedW,
+  typename _DerivedXN, typename _DerivedWN, typename... Args
+>
+void propagateSigmaPoints(
+  const Executor& executor,
+  const SystemModelBase<SystemModelDerived>& f,
+  const State& x,
+  const State& x_new,
+  const typename traits<SystemModelDerived>::Control& u,
+  const Eigen::MatrixBase<_DerivedX>& xis,
+  const Eigen::MatrixBase<_DerivedW>& w_ps,
+  Eigen::MatrixBase<_DerivedXN>& xis_new,
+  Eigen::MatrixBase<_DerivedWN>& xis_new2,
+  const Args&... args
+) {
+  using Control = typename traits<SystemModelDerived>::Control;
+  using Tangent = typename State::Tangent;
+  using MapTangent = Eigen::Map<const Tangent>;
+  using VectorCoF = Eigen::Matrix<
+    typename State::Scalar, _DerivedW::RowsAtCompileTime, 1
+  >;
+  constexpr int StateCount = _DerivedX::ColsAtCompileTime;
+  constexpr int NoiseCount = _DerivedW::ColsAtCompileTime;
+
+  // the state sigma point j
+  const auto sigma = [&](const int j) -> State {
+    const Tangent xi = Tangent(MapTangent(xis.col(j).data()));
+    if constexpr (Iv == Invariance::Right) {
+      return xi + x;
+    } else {
+      return x + xi;
+    }
+  };
 
-    sqrt_d_lambda = sqrt(ml);
-    wj = Scalar(1) / (Scalar(2) * (ml));
-    wm = m / (ml);
-    w0 = m / (ml) + Scalar(3) - alpha * alpha;
-  }
+  // the error of x_new w.r.t. a propagated sigma point
+  const auto error = [&](const State& x_j) -> typename Tangent::DataType {
+    if constexpr (Iv == Invariance::Right) {
+      return x_new.lminus(x_j).coeffs();
+    } else {
+      return x_new.rminus(x_j).coeffs();
+    }
+  };
+
+  if constexpr (has_batch_evaluation<SystemModelDerived>{}) {
+    std::array<State, StateCount> xjs, xjs_new;
+    std::array<Control, StateCount> ujs;
+    for (int j = 0; j < StateCount; ++j) {
+      xjs[j] = sigma(j);
+      ujs[j] = u;
+    }
+    f.batch(xjs, ujs, xjs_new, args...);
 
-  Scalar sqrt_d_lambda;
-  Scalar wj;
-  Scalar wm;
-  Scalar w0;
-};
+    std::array<State, NoiseCount> xks, xks_new;
+    std::array<Control, NoiseCount> uks;
+    for (int k = 0; k < NoiseCount; ++k) {
+      xks[k] = x;
+      uks[k] = u + VectorCoF(w_ps.col(k));
+    }
+    f.batch(xks, uks, xks_new, args...);
 
-template <typename Scalar>
-std::tuple<Weights<Scalar>, Weights<Scalar>, Weights<Scalar>>
-compute_sigma_weights(
-  const Scalar state_size,
-  const Scalar propagation_noise_size,
-  const Scalar alpha_0,
-  const Scalar alpha_1,
-  const Scalar alpha_2
-) {
-  KALMANIF_ASSERT(state_size > Scalar(0));
-  KALMANIF_ASSERT(propagation_noise_size > Scalar(0));
-  KALMANIF_ASSERT(alpha_0 >= Scalar(1e-3) && alpha_0 <= Scalar(1));
-  KALMANIF_ASSERT(alpha_1 >= Scalar(1e-3) && alpha_1 <= Scalar(1));
-  KALMANIF_ASSERT(alpha_2 >= Scalar(1e-3) && alpha_2 <= Scalar(1));
-
-  return std::make_tuple(
-    Weights<Scalar>(state_size, alpha_0),
-    Weights<Scalar>(propagation_noise_size, alpha_1),
-    Weights<Scalar>(state_size, alpha_2)
-  );
+    for (int j = 0; j < StateCount; ++j) {
+      xis_new.col(j) = error(xjs_new[j]);
+    }
+    for (int k = 0; k < NoiseCount; ++k) {
+      xis_new2.col(k) = error(xks_new[k]);
+    }
+  } else {
+    runTasks<StateCount + NoiseCount>(executor, [&](const int j) {
+      if (j < StateCount) {
+        // state sigma points, propagated in place
+        State x_j = sigma(j);
+        f.into(x_j, u, x_j, args...);
+        xis_new.col(j) = error(x_j);
+      } else {
+        // noise sigma points
+        const int k = j - StateCount;
+        const Control u_k = u + VectorCoF(w_ps.col(k));
+        State x_k;
+        f.into(x, u_k, x_k, args...);
+        xis_new2.col(k) = error(x_k);
+      }
+    });
+  }
 }
 
-} // namespace
+/**
+ * @brief Evaluate the measurement model at the state sigma points,
+ * in a single call if the model evaluates batches, otherwise the
+ * executor may run the evaluations concurrently.
+ *
+ * @tparam ModelInvariance The invariance the sigma points are retracted in
+ * @param [in] executor The executor
+ * @param [in] h The measurement model
+ * @param [in] x The state
+ * @param [in] xis The state sigma points, one per column
+ * @param [out] yj The measurement sigma points, one per column
+ */
+template <
+  Invariance ModelInvariance, typename Executor,
+  class MeasurementModelDerived, typename State,
+  typename _DerivedX, typename _DerivedY
+>
+void updateSigmaPoints(
+  const Executor& executor,
+  const MeasurementModelBase<MeasurementModelDerived>& h,
+  const State& x,
+  const Eigen::MatrixBase<_DerivedX>& xis,
+  Eigen::MatrixBase<_DerivedY>& yj
+) {
+  using Tangent = typename State::Tangent;
+  using MapTangent = Eigen::Map<const Tangent>;
+  constexpr int Count = _DerivedX::ColsAtCompileTime;
+
+  // the state sigma point j
+  const auto sigma = [&](const int j) -> State {
+    const Tangent xi = Tangent(MapTangent(xis.col(j).data()));
+    if constexpr (ModelInvariance == Invariance::Right) {
+      return xi + x;
+    } else {
+      return x + xi;
+    }
+  };
+
+  if constexpr (has_batch_evaluation<MeasurementModelDerived>{}) {
+    std::array<State, Count> xjs;
+    for (int j = 0; j < Count; ++j) {
+      xjs[j] = sigma(j);
+    }
+    h.batch(xjs, yj);
+  } else {
+    runTasks<Count>(executor, [&](const int j) {
+      yj.col(j) = h(sigma(j));
+    });
+  }
+}
 
-// Forward declaration
-template <typename Derived> struct SystemModelBase;
-template <typename Filter> struct RauchTungStriebelSmoother;
+} // namespace internal
 
-template <typename StateType, Invariance Iv = Invariance::Right>
+/**
+ * @brief The Unscented Kalman Filter on Manifolds
+ *
+ * The covariance is that of the invariant error of the filter invariance,
+ * the state sigma points are retracted on that side.
+ * An update by a measurement model of the other invariance maps it
+ * through the adjoint.
+ *
+ * @tparam StateType The state type
+ * @tparam Iv The invariance of the filter
+ * @tparam Executor The executor evaluating the sigma points
+ * @tparam SigmaPoints The sigma point scheme, or StaticSigmaPoints
+ * to fix the unscented parameters at compile time
+ *
+ * @see SequentialExecutor
+ * @see ThreadPoolExecutor
+ * @see SymmetricSigmaPoints
+ * @see SphericalSimplexSigmaPoints
+ * @see MinimalSkewSigmaPoints
+ * @see StaticSigmaPoints
+ */
+template <
+  typename StateType,
+  Invariance Iv = Invariance::Right,
+  typename Executor = SequentialExecutor,
+  typename SigmaPoints = SymmetricSigmaPoints
+>
 struct UnscentedKalmanFilterManifolds
-  : public internal::KalmanFilterBase<UnscentedKalmanFilterManifolds<StateType>>
-  , public internal::CovarianceBase<StateType> {
-
-  static_assert(
-    Iv == Invariance::Right,
-    "UKFM: Only Right invariance supported at the moment."
-  );
+  : public internal::KalmanFilterBase<
+      UnscentedKalmanFilterManifolds<StateType, Iv, Executor, SigmaPoints>
+    >
+  , public internal::CovarianceBase<StateType>
+  , public internal::TransitionBase<StateType> {
 
   using Base = internal::KalmanFilterBase<
-    UnscentedKalmanFilterManifolds<StateType>
+    UnscentedKalmanFilterManifolds<StateType, Iv, Executor, SigmaPoints>
   >;
   using CovarianceBase = internal::CovarianceBase<StateType>;
 
@@ -74,57 +214,130 @@ struct UnscentedKalmanFilterManifolds
   using typename Base::State;
   using Base::setState;
   using CovarianceBase::setCovariance;
+  using CovarianceBase::getCovarianceSquareRoot;
   using Base::getState;
+  using Base::setValidation;
+  using Base::getValidation;
+  using Base::getValidationPeriod;
+
+  //! The sigma point scheme and unscented parameters
+  using SigmaPointParameters =
+    internal::sigma_point_parameters<SigmaPoints, Scalar>;
 
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
 
   UnscentedKalmanFilterManifolds()
-    : Base(), CovarianceBase() {
-    std::tie(w_d, w_q, w_u) = compute_sigma_weights<Scalar>(
-      internal::traits<State>::Size,
-      // @todo fix. This is propagation_noise_size
-      internal::traits<State>::Size,
-      1e-3,
-      1e-3,
-      1e-3
+    : Base(), CovarianceBase(), executor_() {
+    setSigmaPoints(
+      SigmaPointParameters::alpha_d,
+      SigmaPointParameters::alpha_q,
+      SigmaPointParameters::alpha_u
     );
   }
 
   UnscentedKalmanFilterManifolds(
     const State& state_init,
     const Eigen::Ref<const Covariance<State>>& cov_init,
-    Scalar alpha0 = 1e-3,
-    Scalar alpha1 = 1e-3,
-    Scalar alpha2 = 1e-3
-  ) : Base(), CovarianceBase() {
+    Scalar alpha0 = SigmaPointParameters::alpha_d,
+    Scalar alpha1 = SigmaPointParameters::alpha_q,
+    Scalar alpha2 = SigmaPointParameters::alpha_u,
+    Executor executor = Executor()
+  ) : Base(), CovarianceBase(), executor_(std::move(executor)) {
     setState(state_init);
     setCovariance(cov_init);
-
-    std::tie(w_d, w_q, w_u) = compute_sigma_weights<Scalar>(
-      internal::traits<State>::Size,
-      // @todo fix. This is propagation_noise_size
-      internal::traits<State>::Size,
-      alpha0,
-      alpha1,
-      alpha2
-    );
+    setSigmaPoints(alpha0, alpha1, alpha2);
   }
 
   ~UnscentedKalmanFilterManifolds() = default;
 
+  /**
+   * @brief Get the number of covariance repairs,
+   * i.e. of steps whose covariance had to be repaired
+   */
+  std::size_t getCovarianceRepairCount() const {
+    return repair_count_;
+  }
+
+  /**
+   * @brief Get the outcome of the last covariance repair
+   */
+  CovarianceRepair getLastCovarianceRepair() const {
+    return last_repair_;
+  }
+
 protected:
 
   using Base::x;
+  using Base::validateCovariance;
+  using Base::instrument;
   using CovarianceBase::P;
+  using internal::TransitionBase<StateType>::recordsTransition;
+  using internal::TransitionBase<StateType>::transition_;
 
   friend Base;
-  friend RauchTungStriebelSmoother<UnscentedKalmanFilterManifolds<StateType, Iv>>;
+  template <typename, typename> friend struct RauchTungStriebelSmoother;
+  template <typename, std::size_t> friend struct FixedLagSmoother;
+  template <typename> friend struct FilterCheckpoint;
+
+  //! Repair the covariance and keep count of the repairs
+  void repairCovariance() {
+    const auto stage = instrument(Stage::Repair);
+    last_repair_ = CovarianceBase::repairCovariance();
+    if (last_repair_ != CovarianceRepair::None) ++repair_count_;
+  }
+
+  using Scheme = typename SigmaPointParameters::Scheme;
+
+  //! The state sigma points, of the dimension of the state
+  template <typename Alpha>
+  using StateSigmaPoints = internal::StoredSigmaPointSet<
+    Scalar, internal::traits<State>::Size, Scheme, Alpha
+  >;
 
-  Jacobian<State, State> A_ = Jacobian<State, State>::Zero();
+  using PropagationSigmaPoints =
+    StateSigmaPoints<typename SigmaPointParameters::AlphaD>;
+  using UpdateSigmaPoints =
+    StateSigmaPoints<typename SigmaPointParameters::AlphaU>;
 
-  // @todo this definitely is an inelegant workaround
-  const Jacobian<State, State>& getA() const {
-    return A_;
+  /**
+   * @brief Precompute the state sigma points and weights
+   *
+   * @param alpha0 The propagation state sigma points spread
+   * @param alpha1 The propagation noise sigma points spread
+   * @param alpha2 The update state sigma points spread
+   *
+   * @throws invalid_argument if the parameters are fixed at compile time
+   * to other values.
+   */
+  void setSigmaPoints(
+    const Scalar alpha0, const Scalar alpha1, const Scalar alpha2
+  ) {
+    alpha_d = alpha0;
+    alpha_q = alpha1;
+    alpha_u = alpha2;
+
+    if constexpr (SigmaPointParameters::Static) {
+      KALMANIF_CHECK(
+        alpha_d == SigmaPointParameters::alpha_d &&
+        alpha_q == SigmaPointParameters::alpha_q &&
+        alpha_u == SigmaPointParameters::alpha_u,
+        "UKFM: The unscented parameters are fixed at compile time!",
+        invalid_argument
+      );
+    } else {
+      sigma_d = PropagationSigmaPoints(alpha_d);
+      sigma_u = UpdateSigmaPoints(alpha_u);
+    }
+  }
+
+  //! The noise sigma points, precomputed if the parameters are static
+  template <typename NoiseSigmaPoints>
+  NoiseSigmaPoints getNoiseSigmaPoints() const {
+    if constexpr (SigmaPointParameters::Static) {
+      return NoiseSigmaPoints();
+    } else {
+      return NoiseSigmaPoints(alpha_q);
+    }
   }
 
   template <class SystemModelDerived, typename... Args>
@@ -134,104 +347,81 @@ protected:
     Args&&... args
   ) {
     using Control = typename internal::traits<SystemModelDerived>::Control;
-    using Tangent = typename State::Tangent;
-    using MapTangent = Eigen::Map<Tangent>;
     constexpr auto StateSize = internal::traits<State>::Size;
     constexpr auto NoiseSize = internal::traits<Control>::Size;
+    constexpr auto StateCount = PropagationSigmaPoints::Count;
+    using NoiseSigmaPoints = SigmaPointSet<
+      Scalar, NoiseSize, Scheme, typename SigmaPointParameters::AlphaQ
+    >;
+    constexpr auto NoiseCount = NoiseSigmaPoints::Count;
     using VectorDoF = Eigen::Matrix<Scalar, StateSize, 1>;
-    using VectorCoF = Eigen::Matrix<Scalar, NoiseSize, 1>;
-    using MatrixDoF = SquareMatrix<Scalar, StateSize>;
 
     // propagate state
-    const State x_new = f(x, u, std::forward<Args>(args)...);
+    State x_new;
+    {
+      const auto stage = instrument(Stage::Model);
+      f.into(x, u, x_new, args...);
+    }
 
-    KALMANIF_ASSERT(
-      isPositiveDefinite(P),
+    validateCovariance(
+      P,
       "UKFM::propagate: Matrix P is not positive definite."
     );
 
-    MatrixDoF xis = w_d.sqrt_d_lambda * P.llt().matrixL().toDenseMatrix();
-
-    // sigma points on manifold
-    State s_j_p, s_j_m;
-    Eigen::Matrix<Scalar, StateSize, StateSize*2> xis_new;
-    for (int i = 0; i < StateSize; ++i) {
-      if constexpr (Iv == Invariance::Right) {
-        s_j_p = MapTangent(xis.col(i).data()) + x;
-        s_j_m = Tangent(-xis.col(i)) + x;
-
-        xis_new.col(i) = x_new.lminus(
-          f(s_j_p, u, std::forward<Args>(args)...)
-        ).coeffs();
+    // reuses the square root of P if it did not change since it was computed
+    const Eigen::Matrix<Scalar, StateSize, StateCount> xis =
+      internal::sigmaPoints(sigma_d, getCovarianceSquareRoot().matrixL());
 
-        xis_new.col(i + StateSize) = x_new.lminus(
-          f(s_j_m, u, std::forward<Args>(args)...)
-        ).coeffs();
-      } else {
-        s_j_p = x + MapTangent(xis.col(i).data());
-        s_j_m = x + Tangent(-xis.col(i));
+    const NoiseSigmaPoints sigma_q =
+      getNoiseSigmaPoints<NoiseSigmaPoints>();
+    const Eigen::Matrix<Scalar, NoiseSize, NoiseCount> w_ps =
+      internal::sigmaPoints(sigma_q, f.getCovarianceSquareRoot().matrixL());
 
-        xis_new.col(i) = x_new.rminus(
-          f(s_j_p, u, std::forward<Args>(args)...)
-        ).coeffs();
+    Eigen::Matrix<Scalar, StateSize, StateCount> xis_new;
+    Eigen::Matrix<Scalar, StateSize, NoiseCount> xis_new2;
 
-        xis_new.col(i + StateSize) = x_new.rminus(
-          f(s_j_m, u, std::forward<Args>(args)...)
-        ).coeffs();
-      }
+    // Evaluate the system model at the sigma points on manifold
+    {
+      const auto stage = instrument(Stage::Model);
+      internal::propagateSigmaPoints<Iv>(
+        executor_, f, x, x_new, u, xis, w_ps, xis_new, xis_new2, args...
+      );
     }
 
     // compute covariance
-    VectorDoF xi_mean = w_d.wj * xis_new.rowwise().sum();
+    const VectorDoF xi_mean = internal::sigmaSum(sigma_d, xis_new);
     xis_new.colwise() -= xi_mean;
 
-    // sigma points on manifold
-    VectorCoF w_p;
-    Covariance<Control> Uchol = f.getCovarianceSquareRoot().matrixL();
-
-    Eigen::Matrix<Scalar, StateSize, 2*NoiseSize> xis_new2;
-    for (int i = 0; i < NoiseSize; ++i) {
-      w_p.noalias() = w_q.sqrt_d_lambda * Uchol.col(i);
-
-      if constexpr (Iv == Invariance::Right) {
-        xis_new2.col(i) = x_new.lminus(
-          f(x, u + w_p, std::forward<Args>(args)...)
-        ).coeffs();
-
-        xis_new2.col(i + NoiseSize) = x_new.lminus(
-          f(x, u - w_p, std::forward<Args>(args)...)
-        ).coeffs();
-      } else {
-        xis_new2.col(i) = x_new.rminus(
-          f(x, u + w_p, std::forward<Args>(args)...)
-        ).coeffs();
-
-        xis_new2.col(i + NoiseSize) = x_new.rminus(
-          f(x, u - w_p, std::forward<Args>(args)...)
-        ).coeffs();
-      }
-    }
-
-    VectorDoF xi_mean2 = w_q.wj * xis_new2.rowwise().sum();
+    const VectorDoF xi_mean2 = internal::sigmaSum(sigma_q, xis_new2);
     xis_new2.colwise() -= xi_mean2;
 
-    P.noalias() =
-      w_d.wj * xis_new * xis_new.transpose()   +  // P new
-      w_d.w0 * xi_mean * xi_mean.transpose()   +
-      w_q.wj * xis_new2 * xis_new2.transpose() +  // U
-      w_q.w0 * xi_mean2 * xi_mean2.transpose();
+    {
+      const auto stage = instrument(Stage::Covariance);
+      // The cross-covariance of the errors before and after propagation,
+      // the statistical counterpart of P F^T, only if a smoother records it.
+      // The images xis_new are the errors of x_new w.r.t. the propagated
+      // sigma points, of opposite sign to the sigma points xis
+      if (recordsTransition()) {
+        transition_->noalias() =
+          -internal::sigmaWeighted(sigma_d, xis) * xis_new.transpose();
+      }
 
-    enforceCovariance(P);
+      P.noalias() =
+        internal::sigmaWeighted(sigma_d, xis_new) * xis_new.transpose();
+      P.noalias() += sigma_d.w0 * xi_mean * xi_mean.transpose();
+      P.noalias() +=
+        internal::sigmaWeighted(sigma_q, xis_new2) * xis_new2.transpose();
+      P.noalias() += sigma_q.w0 * xi_mean2 * xi_mean2.transpose();
+    }
 
-    A_.noalias() = w_d.wj * xis_new * xis_new.transpose() +
-                   w_d.w0 * xi_mean * xi_mean.transpose();
+    repairCovariance();
 
-    KALMANIF_ASSERT(
-      isPositiveDefinite(P),
+    validateCovariance(
+      P,
       "UKFM::propagate: Updated matrix P is not positive definite."
     );
 
-    setState(x_new);
+    x = std::move(x_new);
 
     // return propagated state
     return getState();
@@ -253,89 +443,97 @@ protected:
     using Measurement =
       typename internal::traits<MeasurementModelDerived>::Measurement;
     using Tangent = typename State::Tangent;
-    using MapTangent = Eigen::Map<const Tangent>;
-    // using MapConstTangent = Eigen::Map<const Tangent>;
+    constexpr Invariance ModelInvariance =
+      MeasurementModelDerived::ModelInvariance;
     constexpr auto MeasSize = internal::traits<Measurement>::Size;
     constexpr auto DoF = internal::traits<State>::Size;
-    using MatrixDoF = SquareMatrix<Scalar, DoF>;
 
     // compute expectation
-    Measurement e = h(x);
+    Measurement e = [&]() {
+      const auto stage = instrument(Stage::Model);
+      return h(x);
+    }();
 
-    KALMANIF_ASSERT(
-      isPositiveDefinite(P),
+    validateCovariance(
+      P,
       "UKFM::update: Matrix P is not positive definite."
     );
 
-    const Covariance<State>& Ptmp = [&]() {
-      if constexpr (MeasurementModelDerived::ModelInvariance == Invariance::Right) {
-        return P;
-      } else {
-        // Map covariance to Left invariant (from Right thus)
-        auto AdXinv = x.inverse().adj();
-        return (AdXinv * P * AdXinv.transpose()).eval();
-      }
-    }();
-
-    // set sigma points
-    MatrixDoF xis = w_u.sqrt_d_lambda * Ptmp.llt().matrixL().toDenseMatrix();
+    // set sigma points, in the measurement model invariance
+    constexpr auto Count = UpdateSigmaPoints::Count;
+    Eigen::Matrix<Scalar, DoF, Count> xis;
+    if constexpr (ModelInvariance == Iv) {
+      xis = internal::sigmaPoints(sigma_u, getCovarianceSquareRoot().matrixL());
+    } else {
+      const Covariance<State> Ptmp = internal::covarianceProduct(
+        internal::invarianceAdjoint<Iv, ModelInvariance>(x), P
+      );
+      xis = internal::sigmaPoints(
+        sigma_u, internal::StateLLT<State, Covariance<State>>(Ptmp).matrixL()
+      );
+    }
 
     // compute measurement sigma points
-    Eigen::Matrix<Scalar, MeasSize, 2 * DoF> yj;
-    for (int i = 0; i < DoF; ++i) {
-      if constexpr (MeasurementModelDerived::ModelInvariance == Invariance::Right) {
-        yj.col(i) = h( MapTangent(xis.col(i).data()) + x );
-        yj.col(i + DoF) = h( Tangent(-xis.col(i)) + x );
-      } else {
-        yj.col(i) = h( x + MapTangent(xis.col(i).data()) );
-        yj.col(i + DoF) = h( x + Tangent(-xis.col(i)) );
-      }
+    Eigen::Matrix<Scalar, MeasSize, Count> yj;
+    {
+      const auto stage = instrument(Stage::Model);
+      internal::updateSigmaPoints<ModelInvariance>(executor_, h, x, xis, yj);
     }
 
     // measurement mean
-    Measurement y_bar = w_u.wm * e + w_u.wj * yj.rowwise().sum();
+    Measurement y_bar = sigma_u.wm * e + internal::sigmaSum(sigma_u, yj);
 
     yj.colwise() -= y_bar;
     e -= y_bar;
 
     // compute covariance and cross covariance matrices
+    const Eigen::Matrix<Scalar, MeasSize, Count> wyj =
+      internal::sigmaWeighted(sigma_u, yj);
+
     SquareMatrix<Scalar, MeasSize> P_yy =
-      w_u.w0 * e * e.transpose()   +
-      w_u.wj * yj * yj.transpose() +
+      sigma_u.w0 * e * e.transpose() +
+      wyj * yj.transpose()           +
       h.getCovariance();
 
-    xis.transposeInPlace();
-    // @todo replace xis with xij (topRows<DoF>())
-    Eigen::Matrix<Scalar, 2 * DoF, DoF> xij;
-    xij.template topRows<DoF>() = xis;
-    xij.template bottomRows<DoF>() = -xis;
-
-    // Kalman gain
-    KalmanGain<State, Measurement> K =
-      P_yy.colPivHouseholderQr().solve(w_u.wj * yj * xij).transpose();
+    // Kalman gain, P_yy being a covariance it is solved by Cholesky,
+    // with a QR fallback if round-off made it indefinite
+    KalmanGain<State, Measurement> K;
+    {
+      const auto stage = instrument(Stage::Gain);
+      const Eigen::Matrix<Scalar, MeasSize, DoF> P_yx = wyj * xis.transpose();
+      const internal::StateLLT<State, SquareMatrix<Scalar, MeasSize>>
+        llt(P_yy);
+      if (llt.info() == Eigen::Success) {
+        K = llt.solve(P_yx).transpose();
+      } else {
+        K = P_yy.colPivHouseholderQr().solve(P_yx).transpose();
+      }
+    }
 
     // Update state using computed kalman gain and innovation
-    if constexpr (MeasurementModelDerived::ModelInvariance == Invariance::Right) {
+    if constexpr (ModelInvariance == Invariance::Right) {
       x = Tangent((K * (y - y_bar))) + x;
     } else {
-      x = x + Tangent((K * (y - y_bar)));
+      x += Tangent((K * (y - y_bar)));
     }
 
     // Update covariance
-    P.noalias() -= [&]() {
-      if constexpr (MeasurementModelDerived::ModelInvariance == Invariance::Right) {
-        return (K * P_yy * K.transpose()).eval();
+    {
+      const auto stage = instrument(Stage::Covariance);
+      if constexpr (ModelInvariance == Iv) {
+        P -= internal::covarianceProduct(K, P_yy);
       } else {
-        // Map covariance to Left invariant (from Right thus)
-        auto AdX = x.adj();
-        return (AdX * K * P_yy * K.transpose() * AdX.transpose()).eval();
+        // Map the correction back to the filter invariance
+        const KalmanGain<State, Measurement> AdK =
+          internal::invarianceAdjoint<ModelInvariance, Iv>(x) * K;
+        P -= internal::covarianceProduct(AdK, P_yy);
       }
-    }();
+    }
 
-    enforceCovariance(P);
+    repairCovariance();
 
-    KALMANIF_ASSERT(
-      isCovariance(P),
+    validateCovariance(
+      P,
       "UKFM::update: Updated matrix P is not positive definite."
     );
 
@@ -343,14 +541,30 @@ protected:
     return getState();
   }
 
-  //! Unscented transform weights
-  Weights<Scalar> w_d, w_q, w_u;
+  //! Unscented transform parameters
+  Scalar alpha_d, alpha_q, alpha_u;
+
+  //! Precomputed state sigma points,
+  //! the noise ones depend on the system model
+  PropagationSigmaPoints sigma_d;
+  UpdateSigmaPoints sigma_u;
+
+  //! Sigma points evaluation executor
+  Executor executor_;
+
+  //! Covariance repairs bookkeeping
+  std::size_t repair_count_ = 0;
+  CovarianceRepair last_repair_ = CovarianceRepair::None;
 };
 
 namespace internal {
 
-template <class StateType>
-struct traits<UnscentedKalmanFilterManifolds<StateType>> {
+template <
+  class StateType, Invariance Iv, typename Executor, typename SigmaPoints
+>
+struct traits<
+  UnscentedKalmanFilterManifolds<StateType, Iv, Executor, SigmaPoints>
+> {
   using State = StateType;
 };
 
@@ -0,0 +1,164 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_VALIDATION_H_
+#define _KALMANIF_KALMANIF_IMPL_VALIDATION_H_
+
+namespace kalmanif {
+
+/**
+ * @brief Enum for the runtime validation level of the covariance
+ */
+enum class Validation : char {
+  None = 0, // No validation
+  Cheap,    // Finite, symmetric and Cholesky decomposable, O(n^3/3)
+  Full      // Symmetric with all eigenvalues positive (eigen-solve)
+};
+
+// The default validation level of the filters.
+// It can be set by defining KALMANIF_VALIDATION to one of
+// None, Cheap or Full before including kalmanif headers.
+// It defaults to None if KALMANIF_NO_DEBUG is defined, Full otherwise.
+#ifndef KALMANIF_VALIDATION
+# ifdef KALMANIF_NO_DEBUG
+#  define KALMANIF_VALIDATION None
+# else
+#  define KALMANIF_VALIDATION Full
+# endif
+#endif
+
+/**
+ * @brief Check cheaply if the input matrix is a covariance matrix,
+ * i.e. finite, symmetric and with a successful Cholesky decomposition.
+ *
+ * @tparam _EigenDerived The EigenDerived type of the matrix
+ * @param M The matrix to test
+ * @param eps The symmetry test tolerance
+ * @return true if the matrix passes the test
+ *
+ * @note Unlike isCovariance, a matrix with tiny
+ * positive eigenvalues (< eps) passes this test.
+ *
+ * @see isCovariance
+ */
+template <typename _EigenDerived>
+bool isCovarianceCheap(
+  const Eigen::MatrixBase<_EigenDerived>& M,
+  const typename _EigenDerived::Scalar eps =
+    Constants<typename _EigenDerived::Scalar>::eps
+) {
+  return M.allFinite() && isSymmetric(M, eps) &&
+    Eigen::LLT<typename _EigenDerived::PlainObject>(M).info() == Eigen::Success;
+}
+
+/**
+ * @brief Check if the input matrix is a covariance matrix
+ * at a given validation level.
+ *
+ * @tparam _EigenDerived The EigenDerived type of the matrix
+ * @param M The matrix to test
+ * @param level The validation level
+ * @param eps The test tolerance
+ * @return true if the matrix passes the test
+ *
+ * @see isCovarianceCheap
+ * @see isCovariance
+ */
+template <typename _EigenDerived>
+bool isCovariance(
+  const Eigen::MatrixBase<_EigenDerived>& M,
+  const Validation level,
+  const typename _EigenDerived::Scalar eps =
+    Constants<typename _EigenDerived::Scalar>::eps
+) {
+  switch (level) {
+    case Validation::Cheap:
+      return isCovarianceCheap(M, eps);
+    case Validation::Full:
+      return isCovariance(M, eps);
+    default:
+      return true;
+  }
+}
+
+namespace internal {
+
+/**
+ * @brief Base class for filters validating their covariance at runtime.
+ *
+ * The validation level and its period are set per filter instance.
+ * With a period N, the covariance is validated once every N steps
+ * (propagations and updates), so that the health checks can be kept
+ * on without paying for them on every step.
+ */
+struct ValidationBase {
+
+  /**
+   * @brief Set the runtime validation of the covariance
+   * @param level The validation level
+   * @param period Validate once every 'period' steps
+   */
+  void setValidation(const Validation level, const unsigned int period = 1) {
+    KALMANIF_CHECK(
+      period > 0,
+      "ValidationBase::setValidation: period must be positive!",
+      kalmanif::invalid_argument
+    );
+    validation_ = level;
+    validation_period_ = period;
+  }
+
+  /**
+   * @brief Get the validation level
+   */
+  Validation getValidation() const {
+    return validation_;
+  }
+
+  /**
+   * @brief Get the validation period
+   */
+  unsigned int getValidationPeriod() const {
+    return validation_period_;
+  }
+
+protected:
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(ValidationBase);
+
+  /**
+   * @brief Count a filter step
+   */
+  void step() {
+    if (++validation_step_ >= validation_period_) validation_step_ = 0;
+  }
+
+  /**
+   * @brief Whether the current step is to be validated
+   */
+  bool isValidationStep() const {
+    return validation_ != Validation::None && validation_step_ == 0;
+  }
+
+  /**
+   * @brief Validate the covariance if the current step is due
+   *
+   * @param [in] P The covariance
+   * @param [in] msg The error message
+   * @throw kalmanif::runtime_error if the validation fails
+   */
+  template <typename _EigenDerived>
+  void validateCovariance(
+    const Eigen::MatrixBase<_EigenDerived>& P, const char* msg
+  ) const {
+    if (isValidationStep()) {
+      KALMANIF_CHECK(isCovariance(P, validation_), msg);
+    }
+  }
+
+  Validation validation_ = Validation::KALMANIF_VALIDATION;
+  unsigned int validation_period_ = 1;
+  unsigned int validation_step_ = 0;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_VALIDATION_H_
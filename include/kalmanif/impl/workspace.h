@@ -0,0 +1,138 @@
+#ifndef _KALMANIF_KALMANIF_IMPL_WORKSPACE_H_
+#define _KALMANIF_KALMANIF_IMPL_WORKSPACE_H_
+
+namespace kalmanif {
+
+/**
+ * @brief A preallocated workspace for the temporaries
+ * of a filter on a dynamic-size state.
+ *
+ * Each buffer is allocated once at its capacity and the filter
+ * works on its top-left corner of the current size. Since the buffers
+ * are column-major with an outer stride of their capacity, views of
+ * any size up to the capacity neither allocate nor move data.
+ * The state dimension may thus change from one step to the next
+ * without any heap allocation as long as it stays within the capacity.
+ *
+ * @tparam _Scalar The scalar type
+ *
+ * @see DynamicExtendedKalmanFilter
+ */
+template <typename _Scalar>
+struct Workspace {
+
+  using Scalar = _Scalar;
+  using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+  using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+  using MatrixView = Eigen::Block<Matrix>;
+  using VectorView = Eigen::VectorBlock<Vector>;
+
+  Workspace() = default;
+
+  /**
+   * @brief Construct a workspace of given capacities.
+   *
+   * @param [in] state_capacity The maximum state dimension
+   * @param [in] measurement_capacity The maximum measurement dimension
+   * @param [in] control_capacity The maximum control dimension
+   */
+  Workspace(
+    const int state_capacity,
+    const int measurement_capacity,
+    const int control_capacity
+  ) {
+    reserve(state_capacity, measurement_capacity, control_capacity);
+  }
+
+  /**
+   * @brief Allocate the buffers if their capacities must grow.
+   *
+   * @note This is the only function that allocates.
+   */
+  void reserve(
+    const int state_capacity,
+    const int measurement_capacity,
+    const int control_capacity
+  ) {
+    const int n = std::max(state_capacity, n_);
+    const int m = std::max(measurement_capacity, m_);
+    const int c = std::max(control_capacity, c_);
+
+    if (n == n_ && m == m_ && c == c_) {
+      return;
+    }
+
+    F_.resize(n, n);
+    NN_.resize(n, n);
+    W_.resize(n, c);
+    NC_.resize(n, c);
+    H_.resize(m, n);
+    MN_.resize(m, n);
+    K_.resize(n, m);
+    dx_.resize(n);
+
+    n_ = n;
+    m_ = m;
+    c_ = c;
+  }
+
+  int stateCapacity() const { return n_; }
+  int measurementCapacity() const { return m_; }
+  int controlCapacity() const { return c_; }
+
+  //! The n x n system jacobian F
+  MatrixView F(const int n) { return view(F_, n, n); }
+
+  //! An n x n temporary, e.g. F.P or (I - K.H)
+  MatrixView NN(const int n) { return view(NN_, n, n); }
+
+  //! An up to n x n temporary, e.g. the pose rows of F.P
+  MatrixView NN(const int rows, const int cols) {
+    return view(NN_, rows, cols);
+  }
+
+  //! The n x c noise jacobian W
+  MatrixView W(const int n, const int c) { return view(W_, n, c); }
+
+  //! An n x c temporary, e.g. W.Q
+  MatrixView NC(const int n, const int c) { return view(NC_, n, c); }
+
+  //! The m x n measurement jacobian H
+  MatrixView H(const int m, const int n) { return view(H_, m, n); }
+
+  //! An m x n temporary, e.g. H.P
+  MatrixView MN(const int m, const int n) { return view(MN_, m, n); }
+
+  //! The n x m Kalman gain K
+  MatrixView K(const int n, const int m) { return view(K_, n, m); }
+
+  //! The n state correction dx
+  VectorView dx(const int n) {
+    KALMANIF_ASSERT(
+      n <= n_, "Workspace: Not enough capacity, call reserve first!"
+    );
+    return dx_.head(n);
+  }
+
+protected:
+
+  MatrixView view(Matrix& buffer, const int rows, const int cols) {
+    KALMANIF_ASSERT(
+      rows <= buffer.rows() && cols <= buffer.cols(),
+      "Workspace: Not enough capacity, call reserve first!"
+    );
+    return buffer.topLeftCorner(rows, cols);
+  }
+
+  Matrix F_, NN_, W_, NC_, H_, MN_, K_;
+  Vector dx_;
+
+  int n_ = 0;
+  int m_ = 0;
+  int c_ = 0;
+};
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_IMPL_WORKSPACE_H_
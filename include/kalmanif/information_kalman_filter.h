@@ -0,0 +1,36 @@
+#ifndef _KALMANIF_KALMANIF_INFORMATION_KALMAN_FILTER_H_
+#define _KALMANIF_KALMANIF_INFORMATION_KALMAN_FILTER_H_
+
+#include <stdexcept> // for std::runtime_error
+#include <type_traits>
+
+#include "kalmanif/impl/macro.h"
+#include "kalmanif/impl/traits.h"
+#include "kalmanif/impl/crtp.h"
+#include "kalmanif/impl/eigen.h"
+#include "kalmanif/impl/block_sparsity.h"
+#include "kalmanif/impl/validation.h"
+#include "kalmanif/impl/instrumentation.h"
+#include "kalmanif/impl/cholesky.h"
+#include "kalmanif/impl/closed_form.h"
+#include "kalmanif/impl/types.h"
+#include "kalmanif/impl/range.h"
+#include "kalmanif/impl/invariance.h"
+
+#include "kalmanif/impl/covariance_base.h"
+#include "kalmanif/impl/innovation_solver.h"
+
+#include "kalmanif/system_models/system_model_base.h"
+
+#include "kalmanif/measurement_models/measurement_model_base.h"
+
+#include "kalmanif/impl/linearized.h"
+#include "kalmanif/impl/linearized_invariant.h"
+
+#include "kalmanif/impl/snapshot.h"
+#include "kalmanif/impl/transition.h"
+#include "kalmanif/impl/strand.h"
+#include "kalmanif/impl/kalman_filter_base.h"
+#include "kalmanif/impl/information_kalman_filter.h"
+
+#endif // _KALMANIF_KALMANIF_INFORMATION_KALMAN_FILTER_H_
@@ -0,0 +1,16 @@
+#ifndef _KALMANIF_KALMANIF_INTERACTING_MULTIPLE_MODEL_H_
+#define _KALMANIF_KALMANIF_INTERACTING_MULTIPLE_MODEL_H_
+
+#include "kalmanif/extended_kalman_filter.h"
+#include "kalmanif/invariant_extended_kalman_filter.h"
+#include "kalmanif/unscented_kalman_filter_manifolds.h"
+#include "kalmanif/square_root_unscented_kalman_filter_manifolds.h"
+#include "kalmanif/square_root_extended_kalman_filter.h"
+#include "kalmanif/information_kalman_filter.h"
+#include "kalmanif/rauch_tung_striebel_smoother.h"
+#include "kalmanif/health_monitor.h"
+
+#include "kalmanif/impl/executor.h"
+#include "kalmanif/impl/interacting_multiple_model.h"
+
+#endif // _KALMANIF_KALMANIF_INTERACTING_MULTIPLE_MODEL_H_
@@ -8,11 +8,22 @@
 #include "kalmanif/impl/traits.h"
 #include "kalmanif/impl/crtp.h"
 #include "kalmanif/impl/eigen.h"
+#include "kalmanif/impl/block_sparsity.h"
+#include "kalmanif/impl/validation.h"
+#include "kalmanif/impl/instrumentation.h"
 #include "kalmanif/impl/cholesky.h"
+#include "kalmanif/impl/closed_form.h"
 #include "kalmanif/impl/types.h"
+#include "kalmanif/impl/range.h"
 #include "kalmanif/impl/invariance.h"
 
 #include "kalmanif/impl/covariance_base.h"
+#include "kalmanif/impl/lazy_covariance_base.h"
+#include "kalmanif/impl/innovation_solver.h"
+#include "kalmanif/impl/steady_state.h"
+#include "kalmanif/impl/iterated_update.h"
+#include "kalmanif/impl/gating.h"
+#include "kalmanif/impl/robust_kernel.h"
 
 #include "kalmanif/system_models/system_model_base.h"
 
@@ -21,7 +32,17 @@
 #include "kalmanif/impl/linearized.h"
 #include "kalmanif/impl/linearized_invariant.h"
 
+#include "kalmanif/impl/snapshot.h"
+#include "kalmanif/impl/transition.h"
+#include "kalmanif/impl/strand.h"
 #include "kalmanif/impl/kalman_filter_base.h"
 #include "kalmanif/impl/invariant_extended_kalman_filter.h"
 
+// The instantiations compiled in kalmanif_instantiations
+#include "kalmanif/impl/instantiations.h"
+
+#if KALMANIF_HAS_EXTERN_TEMPLATES
+KALMANIF_INSTANTIATE_INVARIANT_FILTER(extern, kalmanif::InvariantExtendedKalmanFilter)
+#endif
+
 #endif // _KALMANIF_KALMANIF_INVARIANT_EXTENDED_KALMAN_FILTER_H_
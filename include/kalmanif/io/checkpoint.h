@@ -0,0 +1,10 @@
+#ifndef _KALMANIF_KALMANIF_IO_CHECKPOINT_H_
+#define _KALMANIF_KALMANIF_IO_CHECKPOINT_H_
+
+// POSIX only, not included by kalmanif.h
+
+#include "kalmanif/checkpoint.h"
+
+#include "kalmanif/impl/mapped_checkpoint.h"
+
+#endif // _KALMANIF_KALMANIF_IO_CHECKPOINT_H_
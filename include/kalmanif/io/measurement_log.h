@@ -0,0 +1,12 @@
+#ifndef _KALMANIF_KALMANIF_IO_MEASUREMENT_LOG_H_
+#define _KALMANIF_KALMANIF_IO_MEASUREMENT_LOG_H_
+
+// POSIX only, not included by kalmanif.h
+
+#include "kalmanif/impl/macro.h"
+#include "kalmanif/impl/traits.h"
+#include "kalmanif/impl/eigen.h"
+
+#include "kalmanif/impl/measurement_log.h"
+
+#endif // _KALMANIF_KALMANIF_IO_MEASUREMENT_LOG_H_
@@ -0,0 +1,15 @@
+#ifndef _KALMANIF_KALMANIF_IO_REPLAY_ENGINE_H_
+#define _KALMANIF_KALMANIF_IO_REPLAY_ENGINE_H_
+
+// POSIX only, not included by kalmanif.h
+
+#include "kalmanif/rauch_tung_striebel_smoother.h"
+#include "kalmanif/fusion_front_end.h"
+#include "kalmanif/io/measurement_log.h"
+#include "kalmanif/io/trajectory_log.h"
+
+#include "kalmanif/impl/lock_free.h"
+
+#include "kalmanif/impl/replay_engine.h"
+
+#endif // _KALMANIF_KALMANIF_IO_REPLAY_ENGINE_H_
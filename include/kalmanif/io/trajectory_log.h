@@ -0,0 +1,10 @@
+#ifndef _KALMANIF_KALMANIF_IO_TRAJECTORY_LOG_H_
+#define _KALMANIF_KALMANIF_IO_TRAJECTORY_LOG_H_
+
+// POSIX only, not included by kalmanif.h
+
+#include "kalmanif/covariance_intersection.h"
+
+#include "kalmanif/impl/trajectory_log.h"
+
+#endif // _KALMANIF_KALMANIF_IO_TRAJECTORY_LOG_H_
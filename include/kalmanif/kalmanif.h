@@ -5,10 +5,34 @@
 #include "kalmanif/square_root_extended_kalman_filter.h"
 #include "kalmanif/invariant_extended_kalman_filter.h"
 #include "kalmanif/unscented_kalman_filter_manifolds.h"
+#include "kalmanif/square_root_unscented_kalman_filter_manifolds.h"
+#include "kalmanif/ensemble_kalman_filter_manifolds.h"
+#include "kalmanif/information_kalman_filter.h"
+#include "kalmanif/dynamic_extended_kalman_filter.h"
+#include "kalmanif/particle_filter.h"
 
 #include "kalmanif/rauch_tung_striebel_smoother.h"
+#include "kalmanif/square_root_rauch_tung_striebel_smoother.h"
+#include "kalmanif/fixed_lag_smoother.h"
+#include "kalmanif/sliding_window_smoother.h"
+#include "kalmanif/parallel_rauch_tung_striebel_smoother.h"
+
+#include "kalmanif/filter_bank.h"
+#include "kalmanif/filter_ensemble.h"
+#include "kalmanif/interacting_multiple_model.h"
+#include "kalmanif/out_of_sequence_filter.h"
+#include "kalmanif/covariance_intersection.h"
+#include "kalmanif/consistency_monitor.h"
+#include "kalmanif/adaptive_noise.h"
+#include "kalmanif/metrics.h"
+#include "kalmanif/health_monitor.h"
+#include "kalmanif/checkpoint.h"
+#include "kalmanif/footprint.h"
+#include "kalmanif/fusion_front_end.h"
+#include "kalmanif/measurement_scheduler.h"
 
 #include "kalmanif/measurement_models/landmark_measurement_model.h"
+#include "kalmanif/measurement_models/landmark_set_measurement_model.h"
 #include "kalmanif/measurement_models/dummy_gps_measurement_model.h"
 
 #include "kalmanif/enable_manif.h"
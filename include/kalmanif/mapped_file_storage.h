@@ -0,0 +1,12 @@
+#ifndef _KALMANIF_KALMANIF_MAPPED_FILE_STORAGE_H_
+#define _KALMANIF_KALMANIF_MAPPED_FILE_STORAGE_H_
+
+// POSIX only, not included by kalmanif.h
+
+#include <stdexcept> // for std::runtime_error
+
+#include "kalmanif/impl/macro.h"
+
+#include "kalmanif/impl/mapped_file_storage.h"
+
+#endif // _KALMANIF_KALMANIF_MAPPED_FILE_STORAGE_H_
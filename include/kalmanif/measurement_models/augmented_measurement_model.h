@@ -0,0 +1,224 @@
+#ifndef _KALMANIF_KALMANIF_MEASUREMENT_MODELS_AUGMENTED_MEASUREMENT_MODEL_H_
+#define _KALMANIF_KALMANIF_MEASUREMENT_MODELS_AUGMENTED_MEASUREMENT_MODEL_H_
+
+namespace kalmanif {
+
+/**
+ * @brief A measurement model on an AugmentedState
+ * observing its pose only with a pose measurement model.
+ *
+ * It applies as well to any state bundling a pose with other parts,
+ * e.g. a CalibratedState (see CalibratedPoseMeasurementModel).
+ *
+ * @tparam _PoseModel The pose measurement model type
+ * @tparam LandmarkDim The landmark dimension
+ * @tparam _State The state type, providing PoseDoF and pose()
+ *
+ * @see AugmentedState
+ */
+template <
+  typename _PoseModel,
+  int LandmarkDim = _PoseModel::State::Dim,
+  typename _State = AugmentedState<
+    typename internal::traits<_PoseModel>::State, LandmarkDim
+  >
+>
+struct AugmentedMeasurementModel
+  : MeasurementModelBase<
+      AugmentedMeasurementModel<_PoseModel, LandmarkDim, _State>
+    >
+  , Linearized<
+      MeasurementModelBase<
+        AugmentedMeasurementModel<_PoseModel, LandmarkDim, _State>
+      >
+    > {
+
+  using Base = MeasurementModelBase<
+    AugmentedMeasurementModel<_PoseModel, LandmarkDim, _State>
+  >;
+  using typename Base::State;
+  using typename Base::Measurement;
+  using Base::operator ();
+
+  using PoseModel = _PoseModel;
+  using Pose = typename internal::traits<PoseModel>::State;
+
+  AugmentedMeasurementModel(const PoseModel& pose_model)
+    : pose_model_(pose_model) {}
+
+  Measurement run(const State& x) const {
+    return pose_model_(x.pose());
+  }
+
+  /**
+   * @brief The expected measurement and its jacobians,
+   * \f$ H = [H_{pose}, 0] \f$.
+   */
+  Measurement run_linearized(
+    const State& x,
+    Eigen::Ref<Jacobian<Measurement, State>> H,
+    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+  ) const {
+    constexpr int DoF = State::PoseDoF;
+
+    H.rightCols(H.cols() - DoF).setZero();
+
+    return run_linearized_pose(x, H.template leftCols<DoF>(), V);
+  }
+
+  /**
+   * @brief The expected measurement and the pose block of its jacobian.
+   * @see internal::has_pose_block_jacobian
+   */
+  Measurement run_linearized_pose(
+    const State& x,
+    Eigen::Ref<Jacobian<Measurement, Pose>> H_pose,
+    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+  ) const {
+    const Linearized<MeasurementModelBase<PoseModel>>& h = pose_model_;
+    return h(x.pose(), H_pose, V);
+  }
+
+  decltype(auto) getCovariance() const {
+    return pose_model_.getCovariance();
+  }
+
+  decltype(auto) getCovarianceSquareRoot() const {
+    return pose_model_.getCovarianceSquareRoot();
+  }
+
+protected:
+
+  PoseModel pose_model_;
+};
+
+/**
+ * @brief A measurement model on an AugmentedState observing one of
+ * its landmarks from its pose, \f$ y = X^{-1} \cdot l_i \f$.
+ *
+ * Its jacobian is only non-zero in the pose and the i-th landmark
+ * columns, \f$ H = [H_{pose}, 0, H_{l_i}, 0] \f$.
+ *
+ * @tparam _State The AugmentedState type
+ *
+ * @see AugmentedState
+ */
+template <typename _State>
+struct AugmentedLandmarkMeasurementModel
+  : MeasurementModelBase<AugmentedLandmarkMeasurementModel<_State>>
+  , Linearized<
+      MeasurementModelBase<AugmentedLandmarkMeasurementModel<_State>>
+    > {
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  using Base = MeasurementModelBase<AugmentedLandmarkMeasurementModel<_State>>;
+  using Base::setCovariance;
+  using Base::getCovariance;
+  using Base::getCovarianceSquareRoot;
+  using Base::operator ();
+
+  using State = _State;
+  using Scalar = typename State::Scalar;
+  using Pose = typename State::Group;
+  using Landmark = typename State::Landmark;
+  using Measurement = Landmark;
+
+  static constexpr int Dim = State::LandmarkDim;
+
+  AugmentedLandmarkMeasurementModel(
+    const int landmark_index,
+    const Eigen::Ref<Covariance<Measurement>>& R
+  ) : landmark_index_(landmark_index) {
+    setCovariance(R);
+  }
+
+  Measurement run(const State& x) const {
+    return x.pose().inverse().act(x.landmark(landmark_index_));
+  }
+
+  Measurement run_linearized(
+    const State& x,
+    Eigen::Ref<Jacobian<Measurement, State>> H,
+    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+  ) const {
+    constexpr int DoF = State::PoseDoF;
+
+    H.setZero();
+
+    return run_linearized_blocks(
+      x,
+      H.template leftCols<DoF>(),
+      H.template middleCols<Dim>(getColumn()),
+      V
+    );
+  }
+
+  /**
+   * @brief The expected measurement and the non-zero blocks
+   * of its jacobian, \f$ H_{pose} \f$ and \f$ H_{l_i} = V \f$.
+   * @see internal::has_landmark_block_jacobian
+   */
+  Measurement run_linearized_blocks(
+    const State& x,
+    Eigen::Ref<Jacobian<Measurement, Pose>> H_pose,
+    Eigen::Ref<Jacobian<Measurement, Landmark>> H_landmark,
+    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+  ) const {
+    Jacobian<Pose, Pose> J_xi_x;
+    Jacobian<Measurement, Pose> J_e_xi;
+    const Measurement e = x.pose().inverse(J_xi_x).act(
+      Landmark(x.landmark(landmark_index_)), J_e_xi, V
+    );
+
+    H_pose.noalias() = J_e_xi * J_xi_x;
+    H_landmark = V;
+
+    return e;
+  }
+
+  void setLandmarkIndex(const int landmark_index) {
+    landmark_index_ = landmark_index;
+  }
+
+  int getLandmarkIndex() const {
+    return landmark_index_;
+  }
+
+  //! The first state column of the observed landmark
+  int getColumn() const {
+    return State::PoseDoF + landmark_index_ * Dim;
+  }
+
+protected:
+
+  int landmark_index_;
+};
+
+namespace internal {
+
+template <typename PoseModel, int LandmarkDim, typename StateType>
+struct traits<AugmentedMeasurementModel<PoseModel, LandmarkDim, StateType>> {
+  using State = StateType;
+  using Scalar = typename State::Scalar;
+  using Measurement = typename traits<PoseModel>::Measurement;
+
+  // H = [H_pose, 0]
+  static constexpr bool PoseBlockJacobian = true;
+};
+
+template <typename StateType>
+struct traits<AugmentedLandmarkMeasurementModel<StateType>> {
+  using State = StateType;
+  using Scalar = typename State::Scalar;
+  using Measurement = typename State::Landmark;
+
+  // H = [H_pose, 0, H_l, 0]
+  static constexpr bool LandmarkBlockJacobian = true;
+  static constexpr int JacobianBlockSize = State::LandmarkDim;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_MEASUREMENT_MODELS_AUGMENTED_MEASUREMENT_MODEL_H_
@@ -0,0 +1,163 @@
+#ifndef _KALMANIF_KALMANIF_MEASUREMENT_MODELS_CALIBRATED_MEASUREMENT_MODEL_H_
+#define _KALMANIF_KALMANIF_MEASUREMENT_MODELS_CALIBRATED_MEASUREMENT_MODEL_H_
+
+namespace kalmanif {
+
+/**
+ * @brief A measurement model on a CalibratedState observing the pose
+ * of one of its sensors, \f$ y = h(X T_i) \f$, with a sensor
+ * measurement model h.
+ *
+ * Its jacobian is only non-zero in the pose and the i-th calibration
+ * columns, \f$ H = [H_{pose}, 0, H_{T_i}, 0] \f$, with
+ * \f$ H_{pose} = H_s J^{X T_i}_X \f$ and \f$ H_{T_i} = H_s J^{X T_i}_{T_i} \f$.
+ *
+ * @tparam _SensorModel The sensor measurement model type,
+ * on the pose group
+ * @tparam _State The CalibratedState type
+ *
+ * @see CalibratedState
+ */
+template <
+  typename _SensorModel,
+  typename _State = CalibratedState<
+    typename internal::traits<_SensorModel>::State
+  >
+>
+struct CalibratedMeasurementModel
+  : MeasurementModelBase<CalibratedMeasurementModel<_SensorModel, _State>>
+  , Linearized<
+      MeasurementModelBase<CalibratedMeasurementModel<_SensorModel, _State>>
+    > {
+
+  using Base =
+    MeasurementModelBase<CalibratedMeasurementModel<_SensorModel, _State>>;
+  using typename Base::State;
+  using typename Base::Measurement;
+  using Base::operator ();
+
+  using SensorModel = _SensorModel;
+  using Pose = typename State::Group;
+  using Calibration = typename State::Calibration;
+
+  static_assert(
+    std::is_same<Pose, Calibration>::value,
+    "CalibratedMeasurementModel: The calibration must compose with the pose."
+  );
+
+  CalibratedMeasurementModel(
+    const SensorModel& sensor_model, const int sensor_index
+  ) : sensor_model_(sensor_model), sensor_index_(sensor_index) {}
+
+  Measurement run(const State& x) const {
+    return sensor_model_(x.pose().compose(x.calibration(sensor_index_)));
+  }
+
+  Measurement run_linearized(
+    const State& x,
+    Eigen::Ref<Jacobian<Measurement, State>> H,
+    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+  ) const {
+    constexpr int DoF = State::PoseDoF;
+    constexpr int Dim = State::CalibrationDoF;
+
+    H.setZero();
+
+    return run_linearized_blocks(
+      x,
+      H.template leftCols<DoF>(),
+      H.template middleCols<Dim>(getColumn()),
+      V
+    );
+  }
+
+  /**
+   * @brief The expected measurement and the non-zero blocks
+   * of its jacobian, \f$ H_{pose} \f$ and \f$ H_{T_i} \f$.
+   * @see internal::has_landmark_block_jacobian
+   */
+  Measurement run_linearized_blocks(
+    const State& x,
+    Eigen::Ref<Jacobian<Measurement, Pose>> H_pose,
+    Eigen::Ref<Jacobian<Measurement, Calibration>> H_calibration,
+    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+  ) const {
+    Jacobian<Pose, Pose> J_s_x;
+    Jacobian<Pose, Calibration> J_s_t;
+    const Pose sensor = x.pose().compose(
+      x.calibration(sensor_index_), J_s_x, J_s_t
+    );
+
+    Jacobian<Measurement, Pose> H_sensor;
+    const Linearized<MeasurementModelBase<SensorModel>>& h = sensor_model_;
+    const Measurement e = h(sensor, H_sensor, V);
+
+    H_pose.noalias() = H_sensor * J_s_x;
+    H_calibration.noalias() = H_sensor * J_s_t;
+
+    return e;
+  }
+
+  decltype(auto) getCovariance() const {
+    return sensor_model_.getCovariance();
+  }
+
+  decltype(auto) getCovarianceSquareRoot() const {
+    return sensor_model_.getCovarianceSquareRoot();
+  }
+
+  void setSensorIndex(const int sensor_index) {
+    sensor_index_ = sensor_index;
+  }
+
+  int getSensorIndex() const {
+    return sensor_index_;
+  }
+
+  //! The first state column of the observed calibration
+  int getColumn() const {
+    return State::column(sensor_index_);
+  }
+
+protected:
+
+  SensorModel sensor_model_;
+  int sensor_index_;
+};
+
+/**
+ * @brief A measurement model on a CalibratedState
+ * observing its pose only with a pose measurement model.
+ *
+ * @tparam PoseModel The pose measurement model type
+ * @tparam Calibration The calibration Lie group type
+ *
+ * @see CalibratedState
+ */
+template <
+  typename PoseModel,
+  typename Calibration = typename internal::traits<PoseModel>::State
+>
+using CalibratedPoseMeasurementModel = AugmentedMeasurementModel<
+  PoseModel,
+  internal::traits<PoseModel>::State::Dim,
+  CalibratedState<typename internal::traits<PoseModel>::State, Calibration>
+>;
+
+namespace internal {
+
+template <typename SensorModel, typename StateType>
+struct traits<CalibratedMeasurementModel<SensorModel, StateType>> {
+  using State = StateType;
+  using Scalar = typename State::Scalar;
+  using Measurement = typename traits<SensorModel>::Measurement;
+
+  // H = [H_pose, 0, H_T, 0]
+  static constexpr bool LandmarkBlockJacobian = true;
+  static constexpr int JacobianBlockSize = State::CalibrationDoF;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_MEASUREMENT_MODELS_CALIBRATED_MEASUREMENT_MODEL_H_
@@ -30,22 +30,26 @@ struct DummyGPSMeasurementModel
     return x.translation();
   }
 
+  template <typename _JacobianH, typename _JacobianV>
   Measurement run_linearized(
-    const State& x,
-    Eigen::Ref<Jacobian<Measurement, State>> H,
-    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+    const State& x, _JacobianH&& H_out, _JacobianV&& V_out
   ) const {
+    JacobianOutput<_JacobianH, Measurement, State> H = H_out;
+    JacobianOutput<_JacobianV, Measurement, Measurement> V = V_out;
+
     V = x.rotation();
     H.template topLeftCorner<Dim, Dim>() = V;
     H.template topRightCorner<Dim, State::DoF-Dim>().setZero();
     return x.translation();
   }
 
+  template <typename _JacobianH, typename _JacobianV>
   Measurement run_linearized_invariant(
-    const State& x,
-    Eigen::Ref<Jacobian<Measurement, State>> H,
-    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+    const State& x, _JacobianH&& H_out, _JacobianV&& V_out
   ) const {
+    JacobianOutput<_JacobianH, Measurement, State> H = H_out;
+    JacobianOutput<_JacobianV, Measurement, Measurement> V = V_out;
+
     // H.setZero();
     H.template topLeftCorner<Dim, Dim>() = -Eigen::Matrix<Scalar, Dim, Dim>::Identity();
     H.template topRightCorner<Dim, State::DoF-Dim>().setZero();
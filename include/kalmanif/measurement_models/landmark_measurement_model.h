@@ -40,11 +40,25 @@ struct LandmarkMeasurementModel
     return x.inverse().act(landmark_);
   }
 
+  /**
+   * @brief The measurements at a batch of states,
+   * \f$ y_j = R_j^T (l - t_j) \f$ without forming the inverses.
+   */
+  template <typename States, typename _DerivedY>
+  void run_batch(const States& xs, Eigen::MatrixBase<_DerivedY>& ys) const {
+    for (Eigen::Index j = 0; j < ys.cols(); ++j) {
+      ys.col(j).noalias() =
+        xs[j].rotation().transpose() * (landmark_ - xs[j].translation());
+    }
+  }
+
+  template <typename _JacobianH, typename _JacobianV>
   Measurement run_linearized(
-    const State& x,
-    Eigen::Ref<Jacobian<Measurement, State>> H,
-    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+    const State& x, _JacobianH&& H_out, _JacobianV&& V_out
   ) const {
+    JacobianOutput<_JacobianH, Measurement, State> H = H_out;
+    JacobianOutput<_JacobianV, Measurement, Measurement> V = V_out;
+
     Jacobian<State, State> J_xi_x;
     Jacobian<Measurement, State> J_e_xi;
     Measurement m = x.inverse(J_xi_x).act(landmark_, J_e_xi, V);
@@ -52,11 +66,13 @@ struct LandmarkMeasurementModel
     return m;
   }
 
+  template <typename _JacobianH, typename _JacobianV>
   Measurement run_linearized_invariant(
-    const State& x,
-    Eigen::Ref<Jacobian<Measurement, State>> H,
-    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+    const State& x, _JacobianH&& H_out, _JacobianV&& V_out
   ) const {
+    JacobianOutput<_JacobianH, Measurement, State> H = H_out;
+    JacobianOutput<_JacobianV, Measurement, Measurement> V = V_out;
+
     H.setIdentity();
     if constexpr (Dim == 2) {
       H(0, 2) = -landmark_(1);
@@ -98,6 +114,20 @@ struct traits<LandmarkMeasurementModel<StateType, Dim>> {
   using Scalar = typename State::Scalar;
   using Measurement = Eigen::Matrix<Scalar, Dim, 1>;
   static constexpr Invariance invariance = Invariance::Right;
+  static constexpr bool BatchEvaluation = true;
+
+  // The velocity of an SE_2_3 state is not observed
+  static constexpr bool is_se_2_3 = Dim == 3 && traits<State>::Size == 9;
+
+  // H = | X X 0 |
+  using JacobianSparsity = std::conditional_t<
+    is_se_2_3, BlockSparsity<3, 3, 1, 3, 0b011>, DenseJacobian
+  >;
+
+  // H = | I [-l]x 0 |
+  using InvariantJacobianSparsity = std::conditional_t<
+    is_se_2_3, BlockSparsity<3, 3, 1, 3, 0b011, 0b001>, DenseJacobian
+  >;
 };
 
 } // namespace internal
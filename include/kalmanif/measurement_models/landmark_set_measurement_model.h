@@ -0,0 +1,227 @@
+#ifndef _KALMANIF_KALMANIF_MEASUREMENT_MODELS_LANDMARK_SET_MEASUREMENT_MODEL_H_
+#define _KALMANIF_KALMANIF_MEASUREMENT_MODELS_LANDMARK_SET_MEASUREMENT_MODEL_H_
+
+namespace kalmanif {
+
+/**
+ * @brief A measurement model of N landmarks observed at once.
+ *
+ * The landmarks are stored contiguously as the columns of a Dim x N matrix
+ * and the measurement is the stack of the N landmarks expressed
+ * in the state frame, \f$ y = [R^T (l_0 - t), ..., R^T (l_{N-1} - t)] \f$.
+ * The predictions are thus computed with a single matrix product and
+ * a single update processes the N landmarks as one stacked measurement.
+ *
+ * It is equivalent to, but cheaper than, a stacked update over
+ * N LandmarkMeasurementModel.
+ *
+ * @tparam _State The state type
+ * @tparam Dim The landmark dimension, 2 or 3
+ * @tparam N The number of landmarks
+ *
+ * @see LandmarkMeasurementModel
+ */
+template <typename _State, unsigned int Dim, unsigned int N>
+struct LandmarkSetMeasurementModel
+  : MeasurementModelBase<LandmarkSetMeasurementModel<_State, Dim, N>>
+  , Linearized<
+      MeasurementModelBase<LandmarkSetMeasurementModel<_State, Dim, N>>
+    >
+  , LinearizedInvariant<
+      MeasurementModelBase<LandmarkSetMeasurementModel<_State, Dim, N>>
+    > {
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+  static_assert(
+    Dim == 2 || Dim == 3,
+    "Unknown Landmark Dim."
+  );
+
+  static_assert(
+    N > 0,
+    "LandmarkSetMeasurementModel: Empty landmark set."
+  );
+
+  using Base =
+    MeasurementModelBase<LandmarkSetMeasurementModel<_State, Dim, N>>;
+  using Base::setCovariance;
+  using Base::getCovariance;
+  using Base::getCovarianceSquareRoot;
+  using Base::operator ();
+
+  using State = _State;
+  using Scalar = typename State::Scalar;
+  using Landmark = Eigen::Matrix<Scalar, Dim, 1>;
+  using Landmarks = Eigen::Matrix<Scalar, Dim, N>;
+  using Measurement = Eigen::Matrix<Scalar, Dim * N, 1>;
+  using Rotation = Eigen::Matrix<Scalar, Dim, Dim>;
+
+  /**
+   * @brief Constructor
+   *
+   * @param [in] landmarks The landmarks, one per column
+   * @param [in] R The covariance of a single landmark measurement
+   */
+  LandmarkSetMeasurementModel(
+    const Landmarks& landmarks,
+    const Eigen::Ref<Covariance<Landmark>>& R
+  ) : landmarks_(landmarks) {
+    Covariance<Measurement> Rs = Covariance<Measurement>::Zero();
+    for (unsigned int i = 0; i < N; ++i) {
+      Rs.template block<Dim, Dim>(i * Dim, i * Dim) = R;
+    }
+    setCovariance(Rs);
+  }
+
+  Measurement run(const State& x) const {
+    Measurement m;
+    predict(x, m);
+    return m;
+  }
+
+  template <typename _JacobianH, typename _JacobianV>
+  Measurement run_linearized(
+    const State& x, _JacobianH&& H_out, _JacobianV&& V_out
+  ) const {
+    JacobianOutput<_JacobianH, Measurement, State> H = H_out;
+    JacobianOutput<_JacobianV, Measurement, Measurement> V = V_out;
+
+    Measurement m;
+    const auto p = predict(x, m);
+
+    // H_i = | -I [p_i]x 0 |
+    H.setZero();
+    V.setZero();
+    const Rotation Rt = x.rotation().transpose();
+    for (unsigned int i = 0; i < N; ++i) {
+      const auto b = i * Dim;
+      H.template block<Dim, Dim>(b, 0) = -Rotation::Identity();
+      if constexpr (Dim == 2) {
+        H(b, 2)     = +p(1, i);
+        H(b + 1, 2) = -p(0, i);
+      } else {
+        // This indexing suits SE3 && SE_2_3
+        H.template block<3, 3>(b, 3) = skew(p.col(i));
+      }
+      V.template block<Dim, Dim>(b, b) = Rt;
+    }
+
+    return m;
+  }
+
+  template <typename _JacobianH, typename _JacobianV>
+  Measurement run_linearized_invariant(
+    const State& x, _JacobianH&& H_out, _JacobianV&& V_out
+  ) const {
+    JacobianOutput<_JacobianH, Measurement, State> H = H_out;
+    JacobianOutput<_JacobianV, Measurement, Measurement> V = V_out;
+
+    Measurement m;
+    predict(x, m);
+
+    // H_i = | I [-l_i]x 0 |
+    H.setZero();
+    V.setZero();
+    const Rotation R = x.rotation();
+    for (unsigned int i = 0; i < N; ++i) {
+      const auto b = i * Dim;
+      H.template block<Dim, Dim>(b, 0).setIdentity();
+      if constexpr (Dim == 2) {
+        H(b, 2)     = -landmarks_(1, i);
+        H(b + 1, 2) = +landmarks_(0, i);
+      } else {
+        // This indexing suits SE3 && SE_2_3
+        H.template block<3, 3>(b, 3) = skew(-landmarks_.col(i));
+      }
+      V.template block<Dim, Dim>(b, b) = R;
+    }
+
+    return m;
+  }
+
+  void setLandmarks(const Landmarks& landmarks) {
+    landmarks_ = landmarks;
+  }
+
+  const Landmarks& getLandmarks() const {
+    return landmarks_;
+  }
+
+protected:
+
+  /**
+   * @brief Express all landmarks in the state frame at once,
+   * \f$ P = R^T (L - t 1^T) \f$.
+   *
+   * @param [in] x The state
+   * @param [out] m The stacked measurement
+   * @return A Dim x N view of the measurement
+   */
+  Eigen::Map<Landmarks> predict(const State& x, Measurement& m) const {
+    Eigen::Map<Landmarks> p(m.data());
+    p.noalias() =
+      x.rotation().transpose() * (landmarks_.colwise() - x.translation());
+    return p;
+  }
+
+  Landmarks landmarks_;
+};
+
+template <typename State, unsigned int N>
+using Landmark2DSetMeasurementModel = LandmarkSetMeasurementModel<State, 2, N>;
+
+template <typename State, unsigned int N>
+using Landmark3DSetMeasurementModel = LandmarkSetMeasurementModel<State, 3, N>;
+
+namespace internal {
+
+/**
+ * @brief Repeat the block row pattern of a single landmark
+ * over the N block rows of a landmark set.
+ */
+constexpr std::uint64_t repeatBlockRow(
+  const std::uint64_t row, const int cols, const unsigned int n
+) {
+  std::uint64_t mask = 0;
+  for (unsigned int i = 0; i < n && i * cols < 64; ++i) {
+    mask |= row << (i * cols);
+  }
+  return mask;
+}
+
+template <class StateType, unsigned int Dim, unsigned int N>
+struct traits<LandmarkSetMeasurementModel<StateType, Dim, N>> {
+  using State = StateType;
+  using Scalar = typename State::Scalar;
+  using Measurement = Eigen::Matrix<Scalar, Dim * N, 1>;
+  static constexpr Invariance invariance = Invariance::Right;
+
+  // The velocity of an SE_2_3 state is not observed
+  static constexpr bool is_se_2_3 =
+    Dim == 3 && traits<State>::Size == 9 && 3 * N <= 64;
+
+  // H = | X X 0 |
+  //     | ...   |
+  using JacobianSparsity = std::conditional_t<
+    is_se_2_3,
+    BlockSparsity<3, 3, N, 3, repeatBlockRow(0b011, 3, N)>,
+    DenseJacobian
+  >;
+
+  // H = | I [-l]x 0 |
+  //     | ...       |
+  using InvariantJacobianSparsity = std::conditional_t<
+    is_se_2_3,
+    BlockSparsity<
+      3, 3, N, 3,
+      repeatBlockRow(0b011, 3, N), repeatBlockRow(0b001, 3, N)
+    >,
+    DenseJacobian
+  >;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_MEASUREMENT_MODELS_LANDMARK_SET_MEASUREMENT_MODEL_H_
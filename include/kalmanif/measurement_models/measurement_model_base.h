@@ -4,7 +4,7 @@
 namespace kalmanif {
 
 namespace internal {
-template <typename _Derived> struct KalmanFilterBase;
+template <typename _Derived, typename _Instrumentation> struct KalmanFilterBase;
 } // namespace internal
 
 /**
@@ -23,7 +23,7 @@ struct MeasurementModelBase
 
 protected:
 
-  template <typename> friend struct internal::KalmanFilterBase;
+  template <typename, typename> friend struct internal::KalmanFilterBase;
 
   using internal::crtp<_Derived>::derived;
 
@@ -47,6 +47,27 @@ public:
   Measurement operator ()(const State& x, Args&&... args) const {
     return derived().run(x, std::forward<Args>(args)...);
   }
+
+  /**
+   * @brief Evaluate the measurement model at a batch of states,
+   * ys.col(j) = h(xs[j]).
+   *
+   * In a single run_batch call if the model evaluates batches,
+   * see internal::has_batch_evaluation, one state at a time otherwise.
+   *
+   * @param [in] xs A random access range of states
+   * @param [out] ys The measurements, one per column
+   */
+  template <typename States, typename _DerivedY>
+  void batch(const States& xs, Eigen::MatrixBase<_DerivedY>& ys) const {
+    if constexpr (internal::has_batch_evaluation<_Derived>{}) {
+      derived().run_batch(xs, ys);
+    } else {
+      for (Eigen::Index j = 0; j < ys.cols(); ++j) {
+        ys.col(j) = derived().run(xs[j]);
+      }
+    }
+  }
 };
 
 } // namespace kalmanif
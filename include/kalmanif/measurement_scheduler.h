@@ -0,0 +1,10 @@
+#ifndef _KALMANIF_KALMANIF_MEASUREMENT_SCHEDULER_H_
+#define _KALMANIF_KALMANIF_MEASUREMENT_SCHEDULER_H_
+
+#include "kalmanif/unscented_kalman_filter_manifolds.h"
+#include "kalmanif/square_root_unscented_kalman_filter_manifolds.h"
+#include "kalmanif/dynamic_extended_kalman_filter.h"
+
+#include "kalmanif/impl/measurement_scheduler.h"
+
+#endif // _KALMANIF_KALMANIF_MEASUREMENT_SCHEDULER_H_
@@ -0,0 +1,14 @@
+#ifndef _KALMANIF_KALMANIF_METRICS_H_
+#define _KALMANIF_KALMANIF_METRICS_H_
+
+#include "kalmanif/extended_kalman_filter.h"
+#include "kalmanif/invariant_extended_kalman_filter.h"
+#include "kalmanif/unscented_kalman_filter_manifolds.h"
+#include "kalmanif/square_root_unscented_kalman_filter_manifolds.h"
+#include "kalmanif/square_root_extended_kalman_filter.h"
+#include "kalmanif/information_kalman_filter.h"
+#include "kalmanif/rauch_tung_striebel_smoother.h"
+
+#include "kalmanif/impl/metrics.h"
+
+#endif // _KALMANIF_KALMANIF_METRICS_H_
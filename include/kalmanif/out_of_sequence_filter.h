@@ -0,0 +1,8 @@
+#ifndef _KALMANIF_KALMANIF_OUT_OF_SEQUENCE_FILTER_H_
+#define _KALMANIF_KALMANIF_OUT_OF_SEQUENCE_FILTER_H_
+
+#include "kalmanif/invariant_extended_kalman_filter.h"
+
+#include "kalmanif/impl/out_of_sequence_filter.h"
+
+#endif // _KALMANIF_KALMANIF_OUT_OF_SEQUENCE_FILTER_H_
@@ -0,0 +1,23 @@
+#ifndef _KALMANIF_KALMANIF_PARTICLE_FILTER_H_
+#define _KALMANIF_KALMANIF_PARTICLE_FILTER_H_
+
+#include <stdexcept> // for std::runtime_error
+#include <type_traits>
+
+#include "kalmanif/impl/macro.h"
+#include "kalmanif/impl/traits.h"
+#include "kalmanif/impl/crtp.h"
+#include "kalmanif/impl/eigen.h"
+#include "kalmanif/impl/cholesky.h"
+#include "kalmanif/impl/types.h"
+#include "kalmanif/impl/executor.h"
+
+#include "kalmanif/impl/covariance_base.h"
+
+#include "kalmanif/system_models/system_model_base.h"
+
+#include "kalmanif/measurement_models/measurement_model_base.h"
+
+#include "kalmanif/impl/particle_filter.h"
+
+#endif // _KALMANIF_KALMANIF_PARTICLE_FILTER_H_
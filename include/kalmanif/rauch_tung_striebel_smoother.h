@@ -8,7 +8,10 @@
 #include "kalmanif/impl/traits.h"
 #include "kalmanif/impl/crtp.h"
 #include "kalmanif/impl/eigen.h"
+#include "kalmanif/impl/block_sparsity.h"
 
+#include "kalmanif/impl/packed_covariance.h"
+#include "kalmanif/impl/compressed_covariance.h"
 #include "kalmanif/impl/rauch_tung_striebel_smoother.h"
 
 #endif // _KALMANIF_KALMANIF_RAUCH_TUNG_STRIEBEL_SMOOTHER_H_
@@ -0,0 +1,15 @@
+#ifndef _KALMANIF_KALMANIF_SLIDING_WINDOW_SMOOTHER_H_
+#define _KALMANIF_KALMANIF_SLIDING_WINDOW_SMOOTHER_H_
+
+#include "kalmanif/impl/macro.h"
+#include "kalmanif/impl/traits.h"
+#include "kalmanif/impl/crtp.h"
+#include "kalmanif/impl/eigen.h"
+#include "kalmanif/impl/block_sparsity.h"
+#include "kalmanif/impl/types.h"
+#include "kalmanif/impl/range.h"
+#include "kalmanif/impl/iterated_update.h"
+
+#include "kalmanif/impl/sliding_window_smoother.h"
+
+#endif // _KALMANIF_KALMANIF_SLIDING_WINDOW_SMOOTHER_H_
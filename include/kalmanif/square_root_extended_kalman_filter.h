@@ -8,8 +8,12 @@
 #include "kalmanif/impl/traits.h"
 #include "kalmanif/impl/crtp.h"
 #include "kalmanif/impl/eigen.h"
+#include "kalmanif/impl/block_sparsity.h"
+#include "kalmanif/impl/validation.h"
+#include "kalmanif/impl/instrumentation.h"
 #include "kalmanif/impl/cholesky.h"
 #include "kalmanif/impl/types.h"
+#include "kalmanif/impl/range.h"
 #include "kalmanif/impl/invariance.h"
 
 #include "kalmanif/impl/covariance_square_root_base.h"
@@ -21,7 +25,17 @@
 #include "kalmanif/impl/linearized.h"
 #include "kalmanif/impl/linearized_invariant.h"
 
+#include "kalmanif/impl/snapshot.h"
+#include "kalmanif/impl/transition.h"
+#include "kalmanif/impl/strand.h"
 #include "kalmanif/impl/kalman_filter_base.h"
 #include "kalmanif/impl/square_root_extended_kalman_filter.h"
 
+// The instantiations compiled in kalmanif_instantiations
+#include "kalmanif/impl/instantiations.h"
+
+#if KALMANIF_HAS_EXTERN_TEMPLATES
+KALMANIF_INSTANTIATE_FILTER(extern, kalmanif::SquareRootExtendedKalmanFilter)
+#endif
+
 #endif // _KALMANIF_KALMANIF_SQUARE_ROOT_EXTENDED_KALMAN_FILTER_H_
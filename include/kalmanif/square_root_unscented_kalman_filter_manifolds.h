@@ -0,0 +1,11 @@
+#ifndef _KALMANIF_KALMANIF_SQUARE_ROOT_UNSCENTED_KALMAN_FILTER_MANIFOLDS_H_
+#define _KALMANIF_KALMANIF_SQUARE_ROOT_UNSCENTED_KALMAN_FILTER_MANIFOLDS_H_
+
+// The sigma points evaluation shared with the UKFM
+#include "kalmanif/unscented_kalman_filter_manifolds.h"
+
+#include "kalmanif/impl/covariance_square_root_base.h"
+
+#include "kalmanif/impl/square_root_unscented_kalman_filter_manifolds.h"
+
+#endif // _KALMANIF_KALMANIF_SQUARE_ROOT_UNSCENTED_KALMAN_FILTER_MANIFOLDS_H_
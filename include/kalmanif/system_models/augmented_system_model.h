@@ -0,0 +1,209 @@
+#ifndef _KALMANIF_KALMANIF_SYSTEM_MODELS_AUGMENTED_SYSTEM_MODEL_H_
+#define _KALMANIF_KALMANIF_SYSTEM_MODELS_AUGMENTED_SYSTEM_MODEL_H_
+
+namespace kalmanif {
+
+/**
+ * @brief A system model on an AugmentedState,
+ * propagating its pose with a pose system model,
+ * its landmarks being static.
+ *
+ * It applies as well to any state bundling a pose with static parts,
+ * e.g. the calibrations of a CalibratedState (see CalibratedSystemModel).
+ *
+ * @tparam _PoseModel The pose system model type
+ * @tparam LandmarkDim The landmark dimension
+ * @tparam _State The state type, providing PoseDoF, pose() and setPose()
+ *
+ * @see AugmentedState
+ */
+template <
+  typename _PoseModel,
+  int LandmarkDim = _PoseModel::State::Dim,
+  typename _State = AugmentedState<
+    typename internal::traits<_PoseModel>::State, LandmarkDim
+  >
+>
+struct AugmentedSystemModel
+  : SystemModelBase<AugmentedSystemModel<_PoseModel, LandmarkDim, _State>>
+  , Linearized<
+      SystemModelBase<AugmentedSystemModel<_PoseModel, LandmarkDim, _State>>
+    > {
+
+  using Base =
+    SystemModelBase<AugmentedSystemModel<_PoseModel, LandmarkDim, _State>>;
+  using typename Base::State;
+  using typename Base::Control;
+  using Base::operator ();
+
+  using PoseModel = _PoseModel;
+  using Pose = typename internal::traits<PoseModel>::State;
+
+  AugmentedSystemModel(const PoseModel& pose_model)
+    : pose_model_(pose_model) {}
+
+  template <typename... Args>
+  State run(const State& x, const Control& u, Args&&... args) const {
+    State x_next = x;
+    run_into(x_next, u, x_next, std::forward<Args>(args)...);
+    return x_next;
+  }
+
+  /**
+   * @brief Propagate the pose of x into x_new, in place if x_new is x,
+   * the landmarks are then neither copied nor reallocated.
+   * @see internal::has_in_place_evaluation
+   */
+  template <typename... Args>
+  void run_into(
+    const State& x, const Control& u, State& x_new, Args&&... args
+  ) const {
+    if (&x_new != &x) x_new = x;
+    x_new.setPose(pose_model_(x_new.pose(), u, std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief The propagated state and its jacobians,
+   * \f$ F = diag(F_{pose}, I) \f$ and \f$ W = [W_{pose}; 0] \f$.
+   */
+  template <typename... Args>
+  State run_linearized(
+    const State& x,
+    const Control& u,
+    Eigen::Ref<Jacobian<State, State>> F,
+    Eigen::Ref<Jacobian<State, Control>> W,
+    Args&&... args
+  ) const {
+    State x_next = x;
+    run_linearized_into(x_next, u, x_next, F, W, std::forward<Args>(args)...);
+    return x_next;
+  }
+
+  /**
+   * @brief The propagated state into x_new and its jacobians.
+   * @see run_linearized
+   */
+  template <typename... Args>
+  void run_linearized_into(
+    const State& x,
+    const Control& u,
+    State& x_new,
+    Eigen::Ref<Jacobian<State, State>> F,
+    Eigen::Ref<Jacobian<State, Control>> W,
+    Args&&... args
+  ) const {
+    constexpr int DoF = State::PoseDoF;
+
+    F.setIdentity();
+    W.setZero();
+
+    run_linearized_pose_into(
+      x,
+      u,
+      x_new,
+      F.template topLeftCorner<DoF, DoF>(),
+      W.template topRows<DoF>(),
+      std::forward<Args>(args)...
+    );
+  }
+
+  /**
+   * @brief The propagated state and the pose blocks of its jacobians.
+   * @see internal::has_pose_block_jacobian
+   */
+  template <typename... Args>
+  State run_linearized_pose(
+    const State& x,
+    const Control& u,
+    Eigen::Ref<Jacobian<Pose, Pose>> F_pose,
+    Eigen::Ref<Jacobian<Pose, Control>> W_pose,
+    Args&&... args
+  ) const {
+    State x_next = x;
+    run_linearized_pose_into(
+      x_next, u, x_next, F_pose, W_pose, std::forward<Args>(args)...
+    );
+    return x_next;
+  }
+
+  /**
+   * @brief The propagated state into x_new and the pose blocks
+   * of its jacobians.
+   * @see run_linearized_pose
+   */
+  template <typename... Args>
+  void run_linearized_pose_into(
+    const State& x,
+    const Control& u,
+    State& x_new,
+    Eigen::Ref<Jacobian<Pose, Pose>> F_pose,
+    Eigen::Ref<Jacobian<Pose, Control>> W_pose,
+    Args&&... args
+  ) const {
+    const Linearized<SystemModelBase<PoseModel>>& f = pose_model_;
+
+    if (&x_new != &x) x_new = x;
+    x_new.setPose(
+      f(x_new.pose(), u, F_pose, W_pose, std::forward<Args>(args)...)
+    );
+  }
+
+  decltype(auto) getCovariance() const {
+    return pose_model_.getCovariance();
+  }
+
+  decltype(auto) getCovarianceSquareRoot() const {
+    return pose_model_.getCovarianceSquareRoot();
+  }
+
+  const PoseModel& getPoseModel() const {
+    return pose_model_;
+  }
+
+protected:
+
+  PoseModel pose_model_;
+};
+
+namespace internal {
+
+template <typename PoseModel, int LandmarkDim, typename StateType>
+struct traits<AugmentedSystemModel<PoseModel, LandmarkDim, StateType>> {
+  using State = StateType;
+  using Control = typename traits<PoseModel>::Control;
+
+  // F = diag(F_pose, I), W = [W_pose; 0]
+  static constexpr bool PoseBlockJacobian = true;
+
+  // The landmarks are left in place
+  static constexpr bool InPlaceEvaluation = true;
+
+  // The arguments are forwarded to the pose model
+  static constexpr bool TimeStep = has_time_step_evaluation<PoseModel>::value;
+};
+
+} // namespace internal
+
+/**
+ * @brief A system model on a CalibratedState,
+ * propagating its pose with a pose system model,
+ * the calibrations having identity dynamics.
+ *
+ * @tparam PoseModel The pose system model type
+ * @tparam Calibration The calibration Lie group type
+ *
+ * @see CalibratedState
+ */
+template <
+  typename PoseModel,
+  typename Calibration = typename internal::traits<PoseModel>::State
+>
+using CalibratedSystemModel = AugmentedSystemModel<
+  PoseModel,
+  internal::traits<PoseModel>::State::Dim,
+  CalibratedState<typename internal::traits<PoseModel>::State, Calibration>
+>;
+
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_SYSTEM_MODELS_AUGMENTED_SYSTEM_MODEL_H_
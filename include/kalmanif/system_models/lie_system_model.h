@@ -49,20 +49,42 @@ struct LieSystemModel final
     Eigen::Ref<Jacobian<State, Control>> W,
     Scalar dt
   ) const {
+    (void)dt;
     if constexpr (Iv == Invariance::Right) {
       F.setIdentity();
       // F *= dt;
-      (void)dt;
       W = -(x.adj());
       return x + u;
     } else {
-      // @todo double check
+      // The right invariant jacobians mapped by the adjoints,
+      // F = Ad_{x+u}^-1 Ad_x = Ad_{Exp(-u)}, W = -F
       F = (-u).exp().adj();
-      W.setIdentity();
-      W *= -dt;
+      W = -F;
       return x + u;
     }
   }
+
+  /**
+   * @brief The right invariant propagated state and noise jacobian,
+   * the invariant jacobian being the identity.
+   * @see getInvariantJacobian
+   */
+  State run_linearized_invariant(
+    const State& x,
+    const Control& u,
+    Eigen::Ref<Jacobian<State, Control>> W,
+    Scalar /*dt*/
+  ) const {
+    W = -(x.adj());
+    return x + u;
+  }
+
+  /**
+   * @brief Get the right invariant jacobian, the identity.
+   */
+  auto getInvariantJacobian(Scalar /*dt*/) const {
+    return Jacobian<State, State>::Identity();
+  }
 };
 
 namespace internal {
@@ -71,6 +93,13 @@ template <class StateType>
 struct traits<LieSystemModel<StateType>> {
   using State = StateType;
   using Control = typename State::Tangent;
+
+  // The right invariant jacobian is the identity
+  static constexpr int DoF = State::DoF;
+  using InvariantJacobianSparsity = BlockSparsity<DoF, DoF, 1, 1, 1, 1>;
+
+  static constexpr bool StateIndependentInvariantJacobian = true;
+  static constexpr bool LeftInvariantJacobian = true;
 };
 
 } // namespace internal
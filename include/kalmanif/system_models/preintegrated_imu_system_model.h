@@ -0,0 +1,290 @@
+#ifndef _KALMANIF_KALMANIF_SYSTEM_MODELS_PREINTEGRATED_IMU_SYSTEM_MODEL_H_
+#define _KALMANIF_KALMANIF_SYSTEM_MODELS_PREINTEGRATED_IMU_SYSTEM_MODEL_H_
+
+#include <manif/SO3.h>
+#include <manif/SE_2_3.h>
+
+#include <limits>
+
+namespace kalmanif {
+
+/**
+ * @brief A strap-down IMU system model preintegrating
+ * the raw IMU samples between two filter propagations.
+ *
+ * The samples are accumulated into the relative motion increment
+ * \f$ \Upsilon = (\Delta p, \Delta R, \Delta v) \f$ on SE_2_3,
+ * \f$ \Upsilon_{k+1} = \Phi_{\delta t}(\Upsilon_k) \Xi_k \f$,
+ * together with the covariance of its right perturbation
+ * \f$ \Sigma_{k+1} = A_k \Sigma_k A_k^T + B_k Q B_k^T \f$,
+ * each sample costing a few 9x9 products.
+ *
+ * The filter then propagates once over the whole increment,
+ * \f$ X' = G(\Delta t) \Phi_{\Delta t}(X) \Upsilon \f$, with
+ * \f$ \Phi_t(p, R, v) = (p + t v, R, v) \f$ and
+ * \f$ G(t) = (\frac{1}{2} g t^2, I, g t) \f$:
+ *
+ * @code
+ * for (const auto& sample : imu_samples) {
+ *   imu.integrate(sample, dt);
+ * }
+ * filter.propagate(imu, imu.getIncrement(), imu.getDeltaTime());
+ * imu.reset();
+ * @endcode
+ *
+ * The control is the increment logarithm, its covariance
+ * (see getCovariance) the covariance accumulated since the last reset.
+ *
+ * @note Both the EKF jacobians and the right-invariant ones are exact.
+ * The invariant jacobian only depends on \f$ \Delta t \f$.
+ *
+ * @tparam Scalar The scalar type
+ */
+template <typename Scalar>
+struct PreintegratedImuSystemModel final
+  : SystemModelBase<PreintegratedImuSystemModel<Scalar>>
+  , Linearized<SystemModelBase<PreintegratedImuSystemModel<Scalar>>>
+  , LinearizedInvariant<
+      SystemModelBase<PreintegratedImuSystemModel<Scalar>>
+    > {
+
+  //! System model base
+  using Base = SystemModelBase<PreintegratedImuSystemModel<Scalar>>;
+  using typename Base::State;
+  using typename Base::Control;
+  using Base::getCovariance;
+  using Base::getCovarianceSquareRoot;
+  using Base::operator ();
+
+  //! A raw IMU sample, the acceleration then the angular velocity
+  using ImuMeasurement = Eigen::Matrix<Scalar, 6, 1>;
+
+  KALMANIF_DEFAULT_CONSTRUCTOR(PreintegratedImuSystemModel);
+
+  /**
+   * @brief Construct a new preintegrating IMU model
+   * @param imu_noise The covariance of a raw IMU sample
+   */
+  PreintegratedImuSystemModel(
+    const Eigen::Ref<const Covariance<ImuMeasurement>>& imu_noise
+  ) : imu_noise_(imu_noise) {
+    reset();
+  }
+
+  void setImuNoise(
+    const Eigen::Ref<const Covariance<ImuMeasurement>>& imu_noise
+  ) {
+    imu_noise_ = imu_noise;
+  }
+
+  const Covariance<ImuMeasurement>& getImuNoise() const {
+    return imu_noise_;
+  }
+
+  /**
+   * @brief Restart the preintegration from a null increment.
+   */
+  void reset() {
+    increment_ = State::Identity();
+    dt_ = 0;
+    P.setZero();
+    invalidateCovarianceSquareRoot();
+  }
+
+  /**
+   * @brief Accumulate a raw IMU sample
+   * @param [in] u The IMU sample, the acceleration then the angular velocity
+   * @param [in] dt The sample duration
+   */
+  void integrate(const ImuMeasurement& u, const Scalar dt) {
+    const Vec3 acc = u.template head<3>();
+    const Tangent3 omega(u.template tail<3>() * dt);
+
+    const Mat3 Rs = omega.exp().rotation();
+
+    // The sample increment Xi = (1/2 a dt^2, Exp(w dt), a dt)
+    const State Xi(
+      Scalar(0.5) * dt * dt * acc, omega.exp().quat(), dt * acc
+    );
+
+    // The increment first order error, A = Ad(Xi^-1) Phi(dt)
+    const Jacobian<State, State> A = Xi.inverse().adj() * shiftJacobian(dt);
+
+    // The sample noise jacobian
+    Jacobian<State, ImuMeasurement> B = Jacobian<State, ImuMeasurement>::Zero();
+    B.template block<3, 3>(0, 0) = Scalar(0.5) * dt * dt * Rs.transpose();
+    B.template block<3, 3>(3, 3) = dt * omega.rjac();
+    B.template block<3, 3>(6, 0) = dt * Rs.transpose();
+
+    increment_ = shift(increment_, dt).compose(Xi);
+    dt_ += dt;
+
+    P = internal::covarianceProduct(A, P, B, imu_noise_);
+    invalidateCovarianceSquareRoot();
+  }
+
+  /**
+   * @brief Get the preintegrated increment, the control of the model.
+   */
+  Control getIncrement() const {
+    return increment_.log();
+  }
+
+  /**
+   * @brief Get the preintegrated time span.
+   */
+  Scalar getDeltaTime() const {
+    return dt_;
+  }
+
+  State run(const State& x, const Control& u, const Scalar dt) const {
+    return gravity(dt).compose(shift(x, dt)).compose(u.exp());
+  }
+
+  template <typename _JacobianF, typename _JacobianW>
+  State run_linearized(
+    const State& x,
+    const Control& u,
+    _JacobianF&& F_out,
+    _JacobianW&& W_out,
+    const Scalar dt
+  ) const {
+    JacobianOutput<_JacobianF, State, State> F = F_out;
+    JacobianOutput<_JacobianW, State, Control> W = W_out;
+
+    const State U = u.exp();
+
+    // X'.Exp(dx') = G.Phi(X).Exp(Phi.dx).U
+    F.noalias() = U.inverse().adj() * shiftJacobian(dt);
+
+    // The noise is the right perturbation of the increment
+    W.setIdentity();
+
+    return gravity(dt).compose(shift(x, dt)).compose(U);
+  }
+
+  template <typename _JacobianF, typename _JacobianW>
+  State run_linearized_invariant(
+    const State& x,
+    const Control& u,
+    _JacobianF&& F_out,
+    _JacobianW&& W_out,
+    const Scalar dt
+  ) const {
+    JacobianOutput<_JacobianF, State, State> F = F_out;
+    JacobianOutput<_JacobianW, State, Control> W = W_out;
+
+    F = getInvariantJacobian(dt);
+    return run_linearized_invariant(x, u, W, dt);
+  }
+
+  /**
+   * @brief The propagated state and noise jacobian,
+   * the state-independent invariant jacobian being cached.
+   * @see getInvariantJacobian
+   */
+  template <typename _JacobianW>
+  State run_linearized_invariant(
+    const State& x,
+    const Control& u,
+    _JacobianW&& W_out,
+    const Scalar dt
+  ) const {
+    JacobianOutput<_JacobianW, State, Control> W = W_out;
+
+    const State x_next = run(x, u, dt);
+
+    // X'.Exp(dx) = Exp(Ad(X').dx).X'
+    W = x_next.adj();
+
+    return x_next;
+  }
+
+  /**
+   * @brief Get the right invariant jacobian \f$ Ad(G) \Phi \f$,
+   * which only depends on dt.
+   *
+   * It is built on the first call and again whenever dt changes.
+   *
+   * @note The cache makes concurrent calls with different dt unsafe.
+   */
+  const Jacobian<State, State>& getInvariantJacobian(const Scalar dt) const {
+
+    if (dt == F_dt_) {
+      return F_;
+    }
+
+    // Exp(dx').X' = G.Exp(Phi.dx).Phi(X).U
+    F_.noalias() = gravity(dt).adj() * shiftJacobian(dt);
+    F_dt_ = dt;
+
+    return F_;
+  }
+
+protected:
+
+  using Tangent3 = manif::SO3Tangent<Scalar>;
+  using Vec3 = Eigen::Matrix<Scalar, 3, 1>;
+  using Mat3 = Eigen::Matrix<Scalar, 3, 3>;
+  using Base::P;
+  using Base::invalidateCovarianceSquareRoot;
+
+  //! The automorphism Phi_t(p, R, v) = (p + t v, R, v)
+  static State shift(const State& x, const Scalar t) {
+    return State(
+      x.translation() + t * x.linearVelocity(), x.quat(), x.linearVelocity()
+    );
+  }
+
+  //! The differential of Phi_t, Phi(Exp(dx)) = Exp(Phi.dx)
+  static Jacobian<State, State> shiftJacobian(const Scalar t) {
+    Jacobian<State, State> J = Jacobian<State, State>::Identity();
+    J.template block<3, 3>(0, 6).diagonal().setConstant(t);
+    return J;
+  }
+
+  //! The gravity contribution G(t) = (1/2 g t^2, I, g t)
+  State gravity(const Scalar t) const {
+    return State(
+      Scalar(0.5) * t * t * gravity_,
+      Eigen::Quaternion<Scalar>::Identity(),
+      t * gravity_
+    );
+  }
+
+  const Vec3 gravity_ = Vec3(0, 0, -9.80665);
+
+  //! The raw IMU sample covariance
+  Covariance<ImuMeasurement> imu_noise_ =
+    Covariance<ImuMeasurement>::Identity();
+
+  //! The preintegrated increment and its time span
+  State increment_ = State::Identity();
+  Scalar dt_ = 0;
+
+  //! The cached invariant jacobian and its dt
+  mutable Jacobian<State, State> F_ = Jacobian<State, State>::Identity();
+  mutable Scalar F_dt_ = std::numeric_limits<Scalar>::quiet_NaN();
+};
+
+namespace internal {
+
+template <typename Scalar>
+struct traits<PreintegratedImuSystemModel<Scalar>> {
+  using State = manif::SE_2_3<Scalar>;
+  using Tangent = manif::SE_2_3Tangent<Scalar>;
+  using Control = manif::SE_2_3Tangent<Scalar>;
+
+  // F = | I  [g.dt^2/2]x  dt.I |
+  //     | 0       I        0   |
+  //     | 0   [g.dt]x      I   |
+  using InvariantJacobianSparsity =
+    BlockSparsity<3, 3, 3, 3, 0b110'010'111, 0b100'010'001>;
+
+  static constexpr bool StateIndependentInvariantJacobian = true;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+#endif // _KALMANIF_KALMANIF_SYSTEM_MODELS_PREINTEGRATED_IMU_SYSTEM_MODEL_H_
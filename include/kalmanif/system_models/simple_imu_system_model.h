@@ -3,6 +3,9 @@
 
 #include <manif/SE_2_3.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace kalmanif {
 
 /**
@@ -50,13 +53,64 @@ public:
     return x + tau;
   }
 
+  /**
+   * @brief The propagated batch xs_new[j] = f(xs[j], us[j], dt).
+   *
+   * The increments are assembled in chunks of 3 x BatchChunk matrices,
+   * one column per state, so that their arithmetic is vectorized across
+   * the batch without allocating, only the rotations and the retractions
+   * being evaluated per state.
+   *
+   * @see SystemModelBase::batch
+   */
+  template <typename States, typename Controls, typename NewStates>
+  void run_batch(
+    const States& xs, const Controls& us, NewStates& xs_new, const Scalar dt
+  ) const {
+    using Chunk = Eigen::Matrix<Scalar, 3, BatchChunk>;
+
+    const Scalar dt22 = Scalar(0.5) * dt * dt;
+    const std::size_t n = std::size(xs_new);
+
+    for (std::size_t begin = 0; begin < n; begin += BatchChunk) {
+      const Eigen::Index count =
+        Eigen::Index(std::min<std::size_t>(BatchChunk, n - begin));
+
+      // The body frame velocities and accelerations
+      Chunk velocity, acc, gyro;
+      for (Eigen::Index c = 0; c < count; ++c) {
+        const std::size_t j = begin + std::size_t(c);
+        const Mat3 Rt = xs[j].rotation().transpose();
+        velocity.col(c).noalias() = Rt * xs[j].linearVelocity();
+        acc.col(c).noalias() = Rt * gravity;
+        acc.col(c) += us[j].template head<3>();
+        gyro.col(c) = us[j].template tail<3>();
+      }
+
+      Eigen::Matrix<Scalar, 9, BatchChunk> taus;
+      taus.template topRows<3>().leftCols(count) =
+        dt * velocity.leftCols(count) + dt22 * acc.leftCols(count);
+      taus.template middleRows<3>(3).leftCols(count) = dt * gyro.leftCols(count);
+      taus.template bottomRows<3>().leftCols(count) = dt * acc.leftCols(count);
+
+      for (Eigen::Index c = 0; c < count; ++c) {
+        xs_new[begin + std::size_t(c)] = xs[begin + std::size_t(c)] +
+                                         Tangent(taus.col(c));
+      }
+    }
+  }
+
+  template <typename _JacobianF, typename _JacobianW>
   State run_linearized(
     const State& x,
     const Control& u,
-    Eigen::Ref<Jacobian<State, State>> F,
-    Eigen::Ref<Jacobian<State, Control>> W,
+    _JacobianF&& F_out,
+    _JacobianW&& W_out,
     const Scalar dt
   ) const {
+    JacobianOutput<_JacobianF, State, State> F = F_out;
+    JacobianOutput<_JacobianW, State, Control> W = W_out;
+
     Mat3 Rt = x.rotation().transpose();
     Vec3 lin = x.linearVelocity();
     Vec3 Rtg = Rt * gravity;
@@ -71,62 +125,69 @@ public:
            dt * u.template tail<3>(),
            dt * acc_k;
 
-    Jacobian<Tangent, Control> J_tau_u = Jacobian<Tangent, Control>::Zero();
-
-    J_tau_u(0, 0) = dt;
-    J_tau_u(1, 1) = dt;
-    J_tau_u(2, 2) = dt;
-
-    J_tau_u(3, 3) = dt;
-    J_tau_u(4, 4) = dt;
-    J_tau_u(5, 5) = dt;
-
-    J_tau_u(6, 0) = dt22;
-    J_tau_u(7, 1) = dt22;
-    J_tau_u(8, 2) = dt22;
-
     Jacobian<State, State> J_xnew_x, J_xnew_tau;
     State x_plus_u = x.plus(tau, J_xnew_x, J_xnew_tau);
 
-    Jacobian<State, State> J_u_x = Jacobian<State, State>::Zero();
-    J_u_x.template block<3, 3>(0, 3) = skew(accLin);
-    J_u_x(0, 6) = dt;
-    J_u_x(1, 7) = dt;
-    J_u_x(2, 8) = dt;
-    J_u_x.template block<3, 3>(6, 3) = skew(Rtg * dt);
+    // The products with the sparse J_u_x and J_tau_u
+    // are computed block-wise
+    const auto J_xnew_tau_0 = J_xnew_tau.template middleCols<3>(0);
+    const auto J_xnew_tau_1 = J_xnew_tau.template middleCols<3>(3);
+    const auto J_xnew_tau_2 = J_xnew_tau.template middleCols<3>(6);
 
-    F.noalias() = J_xnew_tau * J_u_x;
-    F.noalias() += J_xnew_x;
-
-    W.noalias() = J_xnew_tau * J_tau_u;
+    // J_u_x = | 0  [accLin]x   dt.I |
+    //         | 0      0        0   |
+    //         | 0  [Rtg.dt]x    0   |
+    //
+    // F = J_xnew_tau * J_u_x + J_xnew_x
+    F = J_xnew_x;
+    F.template middleCols<3>(3).noalias() +=
+      J_xnew_tau_0 * skew(accLin) + J_xnew_tau_2 * skew(Rtg * dt);
+    F.template middleCols<3>(6).noalias() += dt * J_xnew_tau_0;
+
+    // J_tau_u = |  dt.I    0   |
+    //           |   0     dt.I |
+    //           | dt22.I   0   |
+    //
+    // W = J_xnew_tau * J_tau_u
+    W.template middleCols<3>(0).noalias() =
+      dt * J_xnew_tau_0 + dt22 * J_xnew_tau_2;
+    W.template middleCols<3>(3).noalias() = dt * J_xnew_tau_1;
 
     return x_plus_u;
   }
 
+  template <typename _JacobianF, typename _JacobianW>
   State run_linearized_invariant(
     const State& x,
     const Control& u,
-    Eigen::Ref<Jacobian<State, State>> F,
-    Eigen::Ref<Jacobian<State, Control>> W,
+    _JacobianF&& F_out,
+    _JacobianW&& W_out,
     const Scalar dt
   ) const {
+    JacobianOutput<_JacobianF, State, State> F = F_out;
+    JacobianOutput<_JacobianW, State, Control> W = W_out;
 
-    using std::sqrt;
+    F = getInvariantJacobian(dt);
+    return run_linearized_invariant(x, u, W, dt);
+  }
 
-    // Continuous
-    //
-    // Fc = | 0   0  I |
-    //      | 0   0  0 |
-    //      | 0 [g]x 0 |
-    //
-    // Discrete
-    //
-    // F ~= exp(Fc dt)
-    //    = I + Fc * dt
+  /**
+   * @brief The propagated state and noise jacobian,
+   * the state-independent invariant jacobian being cached.
+   * @see getInvariantJacobian
+   */
+  template <typename _JacobianW>
+  State run_linearized_invariant(
+    const State& x,
+    const Control& u,
+    _JacobianW&& W_out,
+    const Scalar dt
+  ) const {
+    JacobianOutput<_JacobianW, State, Control> W = W_out;
+
+    using std::sqrt;
 
-    F.setIdentity();
-    F.template block<3, 3>(0, 6).setIdentity() *= dt;
-    F.template block<3, 3>(6, 3) = dt * skew(gravity);
+    const Jacobian<State, State>& F = getInvariantJacobian(dt);
 
     // Continuous
     //
@@ -146,7 +207,9 @@ public:
     W.template block<3, 3>(3, 3) = R;
     W.template block<3, 3>(6, 0).setZero();
     W.template block<3, 3>(6, 3).noalias() = skew(velocity) * R;
-    W = sqrt(dt) * F * W;
+    W = sqrt(dt) * internal::sparseProduct<
+      typename internal::traits<SimpleImuSystemModel>::InvariantJacobianSparsity
+    >(F, W);
 
     R.transposeInPlace();
 
@@ -160,9 +223,49 @@ public:
     return x + tau;
   }
 
+  /**
+   * @brief Get the invariant jacobian, which only depends on dt.
+   *
+   * It is built on the first call and again whenever dt changes.
+   *
+   * @note The cache makes concurrent calls with different dt unsafe.
+   */
+  const Jacobian<State, State>& getInvariantJacobian(const Scalar dt) const {
+
+    if (dt == F_dt_) {
+      return F_;
+    }
+
+    // Continuous
+    //
+    // Fc = | 0   0  I |
+    //      | 0   0  0 |
+    //      | 0 [g]x 0 |
+    //
+    // Discrete
+    //
+    // F ~= exp(Fc dt)
+    //    = I + Fc * dt
+
+    F_.setIdentity();
+    F_.template block<3, 3>(0, 6).setIdentity() *= dt;
+    F_.template block<3, 3>(6, 3) = dt * skew(gravity);
+
+    F_dt_ = dt;
+
+    return F_;
+  }
+
 protected:
 
+  //! The number of states whose increments are assembled at once
+  static constexpr int BatchChunk = 16;
+
   const Vec3 gravity = Vec3(0, 0, -9.80665);
+
+  //! The cached invariant jacobian and its dt
+  mutable Jacobian<State, State> F_ = Jacobian<State, State>::Identity();
+  mutable Scalar F_dt_ = std::numeric_limits<Scalar>::quiet_NaN();
 };
 
 namespace internal {
@@ -172,6 +275,16 @@ struct traits<SimpleImuSystemModel<Scalar>> {
   using State = manif::SE_2_3<Scalar>;
   using Tangent = manif::SE_2_3Tangent<Scalar>;
   using Control = Eigen::Matrix<Scalar, 6, 1>;
+
+  // F = | I    0     dt.I |
+  //     | 0    I      0   |
+  //     | 0 dt.[g]x   I   |
+  using InvariantJacobianSparsity =
+    BlockSparsity<3, 3, 3, 3, 0b110'010'101, 0b100'010'001>;
+
+  static constexpr bool StateIndependentInvariantJacobian = true;
+
+  static constexpr bool BatchEvaluation = true;
 };
 
 } // namespace internal
@@ -1,11 +1,13 @@
 #ifndef _KALMANIF_KALMANIF_SYSTEM_MODELS_SYSTEM_MODEL_BASE_H_
 #define _KALMANIF_KALMANIF_SYSTEM_MODELS_SYSTEM_MODEL_BASE_H_
 
+#include <iterator>
+
 namespace kalmanif {
 
 namespace internal {
 // Forward declaration
-template <typename _Derived> struct KalmanFilterBase;
+template <typename _Derived, typename _Instrumentation> struct KalmanFilterBase;
 } // namespace internal
 
 /**
@@ -29,7 +31,7 @@ protected:
     typename internal::traits<_Derived>::Control
   >;
 
-  template <typename> friend struct internal::KalmanFilterBase;
+  template <typename, typename> friend struct internal::KalmanFilterBase;
 
   using internal::crtp<_Derived>::derived;
   using Base::Base;
@@ -59,6 +61,54 @@ public:
   State operator ()(Args&&... args) const {
     return derived().run(std::forward<Args>(args)...);
   }
+
+  /**
+   * @brief Propagate a state into x_new, x_new = f(x, u, args...).
+   *
+   * In place if the model evaluates in place,
+   * see internal::has_in_place_evaluation, by assignment otherwise.
+   *
+   * @param [in] x The state
+   * @param [in] u The control
+   * @param [out] x_new The propagated state, possibly x itself
+   * @param [in] args The other arguments of the model, e.g. dt
+   */
+  template <typename... Args>
+  void into(
+    const State& x, const Control& u, State& x_new, Args&&... args
+  ) const {
+    if constexpr (internal::has_in_place_evaluation<_Derived>{}) {
+      derived().run_into(x, u, x_new, std::forward<Args>(args)...);
+    } else {
+      x_new = derived().run(x, u, std::forward<Args>(args)...);
+    }
+  }
+
+  /**
+   * @brief Propagate a batch of states, xs_new[j] = f(xs[j], us[j], args...).
+   *
+   * In a single run_batch call if the model evaluates batches,
+   * see internal::has_batch_evaluation, one state at a time otherwise.
+   *
+   * @param [in] xs A random access range of states
+   * @param [in] us A random access range of controls
+   * @param [out] xs_new The propagated states, its size being the batch size
+   * @param [in] args The other arguments of the model, e.g. dt
+   */
+  template <
+    typename States, typename Controls, typename NewStates, typename... Args
+  >
+  void batch(
+    const States& xs, const Controls& us, NewStates& xs_new, Args&&... args
+  ) const {
+    if constexpr (internal::has_batch_evaluation<_Derived>{}) {
+      derived().run_batch(xs, us, xs_new, std::forward<Args>(args)...);
+    } else {
+      for (std::size_t j = 0; j < std::size(xs_new); ++j) {
+        xs_new[j] = derived().run(xs[j], us[j], args...);
+      }
+    }
+  }
 };
 
 } // namespace kalmanif
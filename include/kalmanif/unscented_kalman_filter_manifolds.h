@@ -8,9 +8,16 @@
 #include "kalmanif/impl/traits.h"
 #include "kalmanif/impl/crtp.h"
 #include "kalmanif/impl/eigen.h"
+#include "kalmanif/impl/block_sparsity.h"
+#include "kalmanif/impl/validation.h"
+#include "kalmanif/impl/instrumentation.h"
 #include "kalmanif/impl/cholesky.h"
+#include "kalmanif/impl/closed_form.h"
 #include "kalmanif/impl/types.h"
+#include "kalmanif/impl/range.h"
 #include "kalmanif/impl/invariance.h"
+#include "kalmanif/impl/executor.h"
+#include "kalmanif/impl/sigma_points.h"
 
 #include "kalmanif/impl/covariance_base.h"
 
@@ -21,7 +28,17 @@
 #include "kalmanif/impl/linearized.h"
 #include "kalmanif/impl/linearized_invariant.h"
 
+#include "kalmanif/impl/snapshot.h"
+#include "kalmanif/impl/transition.h"
+#include "kalmanif/impl/strand.h"
 #include "kalmanif/impl/kalman_filter_base.h"
 #include "kalmanif/impl/unscented_kalman_filter_manifolds.h"
 
+// The instantiations compiled in kalmanif_instantiations
+#include "kalmanif/impl/instantiations.h"
+
+#if KALMANIF_HAS_EXTERN_TEMPLATES
+KALMANIF_INSTANTIATE_FILTER(extern, kalmanif::UnscentedKalmanFilterManifolds)
+#endif
+
 #endif // _KALMANIF_KALMANIF_UNSCENTED_KALMAN_FILTER_MANIFOLDS_H_
@@ -0,0 +1,297 @@
+#ifndef _KALMANIF_PYTHON_BINDINGS_FILTERS_H_
+#define _KALMANIF_PYTHON_BINDINGS_FILTERS_H_
+
+#include <kalmanif/kalmanif.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <cmath>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace kalmanif {
+namespace python {
+
+namespace py = pybind11;
+
+/**
+ * @brief The types bound for a state group.
+ */
+template <typename _State>
+struct GroupTypes {
+
+  using State = _State;
+  using Scalar = typename State::Scalar;
+
+  static constexpr int Dim = State::Dim;
+  static constexpr int DoF = State::DoF;
+  static constexpr int RepSize = State::RepSize;
+
+  using StateCovariance = Covariance<State>;
+  using Coefficients = typename State::DataType;
+
+  using SystemModel = LieSystemModel<State>;
+  using Control = typename SystemModel::Control;
+
+  using LandmarkModel = LandmarkMeasurementModel<State, Dim>;
+  using GPSModel = DummyGPSMeasurementModel<State>;
+  using MeasurementModel = std::variant<LandmarkModel, GPSModel>;
+  using Measurement = Eigen::Matrix<Scalar, Dim, 1>;
+
+  //! The input arrays, converted to contiguous row-major buffers if needed
+  using Array = py::array_t<Scalar, py::array::c_style | py::array::forcecast>;
+};
+
+/**
+ * @brief A NumPy array viewing a buffer it takes ownership of,
+ * so that the results of a batch are not copied.
+ */
+template <typename Scalar>
+py::array_t<Scalar> toArray(
+  std::vector<Scalar>&& buffer, const std::vector<py::ssize_t>& shape
+) {
+  auto* owned = new std::vector<Scalar>(std::move(buffer));
+  py::capsule owner(owned, [](void* p) {
+    delete static_cast<std::vector<Scalar>*>(p);
+  });
+  return py::array_t<Scalar>(shape, owned->data(), owner);
+}
+
+/**
+ * @brief Run a filter over a whole sequence, in C++ with the GIL released.
+ *
+ * At each step t the filter is propagated with the control
+ * controls[t] * dts[t], or controls[t] over dts[t] if the system model
+ * propagates over a time step, then updated with the measurements[t, k] of
+ * each measurement model k. A measurement whose first coefficient
+ * is NaN is missing and skipped.
+ *
+ * @param controls The controls, T x DoF
+ * @param measurements The measurements, T x K x Dim
+ * @param dts The time steps, T
+ * @return The states coefficients (T x RepSize) and
+ * covariances (T x DoF x DoF) after each step
+ */
+template <typename Filter>
+py::tuple run(
+  Filter& filter,
+  const typename GroupTypes<typename internal::traits<Filter>::State>::SystemModel& f,
+  const std::vector<
+    typename GroupTypes<typename internal::traits<Filter>::State>::MeasurementModel
+  >& hs,
+  const typename GroupTypes<typename internal::traits<Filter>::State>::Array& controls,
+  const typename GroupTypes<typename internal::traits<Filter>::State>::Array& measurements,
+  const typename GroupTypes<typename internal::traits<Filter>::State>::Array& dts
+) {
+  using Types = GroupTypes<typename internal::traits<Filter>::State>;
+  using Scalar = typename Types::Scalar;
+  using Control = typename Types::Control;
+  using Measurement = typename Types::Measurement;
+  using StateCovariance = typename Types::StateCovariance;
+  using SystemModel = typename Types::SystemModel;
+
+  constexpr int Dim = Types::Dim;
+  constexpr int DoF = Types::DoF;
+  constexpr int RepSize = Types::RepSize;
+
+  const py::ssize_t T = dts.ndim() == 1 ? dts.shape(0) : -1;
+  const py::ssize_t K = py::ssize_t(hs.size());
+
+  KALMANIF_CHECK(
+    T >= 0, "run: dts must be of shape (T,)!", invalid_argument
+  );
+  KALMANIF_CHECK(
+    controls.ndim() == 2 && controls.shape(0) == T && controls.shape(1) == DoF,
+    "run: controls must be of shape (T, " + std::to_string(DoF) + ")!",
+    invalid_argument
+  );
+  KALMANIF_CHECK(
+    measurements.ndim() == 3 && measurements.shape(0) == T &&
+    measurements.shape(1) == K && measurements.shape(2) == Dim,
+    "run: measurements must be of shape (T, K, " + std::to_string(Dim) +
+    ") with K the number of measurement models!",
+    invalid_argument
+  );
+
+  const Scalar* u_data = controls.data();
+  const Scalar* y_data = measurements.data();
+  const Scalar* dt_data = dts.data();
+
+  std::vector<Scalar> xs(std::size_t(T * RepSize));
+  std::vector<Scalar> Ps(std::size_t(T * DoF * DoF));
+
+  {
+    py::gil_scoped_release release;
+
+    for (py::ssize_t t = 0; t < T; ++t) {
+      const Control u =
+        Control(Eigen::Map<const typename Control::DataType>(u_data + t * DoF));
+
+      if constexpr (internal::has_time_step_evaluation<SystemModel>::value) {
+        filter.propagate(f, u, dt_data[t]);
+      } else {
+        filter.propagate(f, Control(u * dt_data[t]));
+      }
+
+      for (py::ssize_t k = 0; k < K; ++k) {
+        const Scalar* y_k = y_data + (t * K + k) * Dim;
+        if (std::isnan(y_k[0])) continue;
+
+        const Measurement y = Eigen::Map<const Measurement>(y_k);
+        std::visit([&](const auto& h) { filter.update(h, y); }, hs[k]);
+      }
+
+      Eigen::Map<typename Types::Coefficients>(xs.data() + t * RepSize) =
+        filter.getState().coeffs();
+      // symmetric, the storage order does not matter
+      Eigen::Map<StateCovariance>(Ps.data() + t * DoF * DoF) =
+        filter.getCovariance();
+    }
+  }
+
+  return py::make_tuple(
+    toArray(std::move(xs), {T, RepSize}),
+    toArray(std::move(Ps), {T, DoF, DoF})
+  );
+}
+
+/**
+ * @brief Bind a filter on a state group.
+ */
+template <typename Filter>
+void bindFilter(py::module_& m, const char* name) {
+  using Types = GroupTypes<typename internal::traits<Filter>::State>;
+  using State = typename Types::State;
+  using Scalar = typename Types::Scalar;
+  using StateCovariance = typename Types::StateCovariance;
+  using Coefficients = typename Types::Coefficients;
+  using SystemModel = typename Types::SystemModel;
+  using Control = typename Types::Control;
+  using Measurement = typename Types::Measurement;
+
+  py::class_<Filter>(m, name)
+    .def(
+      py::init([](const Coefficients& x, const StateCovariance& P) {
+        return Filter(State(x), P);
+      }),
+      py::arg("x0"), py::arg("P0")
+    )
+    .def(
+      "propagate",
+      [](Filter& filter, const SystemModel& f,
+         const typename Control::DataType& u, const Scalar dt) {
+        if constexpr (internal::has_time_step_evaluation<SystemModel>::value) {
+          filter.propagate(f, Control(u), dt);
+        } else {
+          filter.propagate(f, Control(u) * dt);
+        }
+      },
+      py::arg("f"), py::arg("u"), py::arg("dt") = Scalar(1)
+    )
+    .def(
+      "update",
+      [](Filter& filter, const typename Types::MeasurementModel& model,
+         const Measurement& y) {
+        std::visit([&](const auto& h) { filter.update(h, y); }, model);
+      },
+      py::arg("h"), py::arg("y")
+    )
+    .def(
+      "run", &run<Filter>,
+      py::arg("f"), py::arg("hs"),
+      py::arg("controls"), py::arg("measurements"), py::arg("dts"),
+      "Run the filter over a whole sequence, returns the states "
+      "coefficients (T x RepSize) and covariances (T x DoF x DoF) "
+      "after each step."
+    )
+    .def_property(
+      "state",
+      [](const Filter& filter) -> Coefficients {
+        return filter.getState().coeffs();
+      },
+      [](Filter& filter, const Coefficients& x) {
+        filter.setState(State(x));
+      }
+    )
+    .def_property(
+      "covariance",
+      [](const Filter& filter) -> StateCovariance {
+        return filter.getCovariance();
+      },
+      [](Filter& filter, const StateCovariance& P) {
+        filter.setCovariance(P);
+      }
+    );
+}
+
+/**
+ * @brief Bind the filters and models of a state group,
+ * in a submodule, e.g. kalmanifpy.se2.EKF.
+ */
+template <typename State>
+void bindGroup(py::module_& parent, const char* name) {
+  using Types = GroupTypes<State>;
+  using SystemModel = typename Types::SystemModel;
+  using LandmarkModel = typename Types::LandmarkModel;
+  using GPSModel = typename Types::GPSModel;
+  using Measurement = typename Types::Measurement;
+
+  py::module_ m = parent.def_submodule(name);
+
+  m.attr("Dim") = int(Types::Dim);
+  m.attr("DoF") = int(Types::DoF);
+  m.attr("RepSize") = int(Types::RepSize);
+
+  py::class_<SystemModel>(m, "SystemModel")
+    .def(
+      py::init<const Covariance<State>&>(), py::arg("Q"),
+      "The model x_{k+1} = x_k + u * dt, with the control noise covariance Q."
+    )
+    .def(
+      "__call__",
+      [](const SystemModel& f, const typename State::DataType& x,
+         const typename State::Tangent::DataType& u) {
+        return typename State::DataType(f(State(x), u).coeffs());
+      }
+    );
+
+  py::class_<LandmarkModel>(m, "LandmarkModel")
+    .def(
+      py::init([](const Measurement& landmark, Covariance<Measurement> R) {
+        return LandmarkModel(landmark, R);
+      }),
+      py::arg("landmark"), py::arg("R")
+    )
+    .def(
+      "__call__",
+      [](const LandmarkModel& h, const typename State::DataType& x) {
+        return Measurement(h(State(x)));
+      }
+    );
+
+  py::class_<GPSModel>(m, "GPSModel")
+    .def(
+      py::init([](Covariance<Measurement> R) { return GPSModel(R); }),
+      py::arg("R")
+    )
+    .def(
+      "__call__",
+      [](const GPSModel& h, const typename State::DataType& x) {
+        return Measurement(h(State(x)));
+      }
+    );
+
+  bindFilter<ExtendedKalmanFilter<State>>(m, "EKF");
+  bindFilter<SquareRootExtendedKalmanFilter<State>>(m, "SEKF");
+  bindFilter<InvariantExtendedKalmanFilter<State>>(m, "IEKF");
+  bindFilter<UnscentedKalmanFilterManifolds<State>>(m, "UKFM");
+}
+
+} // namespace python
+} // namespace kalmanif
+
+#endif // _KALMANIF_PYTHON_BINDINGS_FILTERS_H_
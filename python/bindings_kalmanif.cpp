@@ -0,0 +1,16 @@
+#include "bindings_filters.h"
+
+#include <manif/SE2.h>
+#include <manif/SE3.h>
+#include <manif/SE_2_3.h>
+
+PYBIND11_MODULE(kalmanifpy, m) {
+  m.doc() =
+    "Python bindings of kalmanif, the Kalman filters on Lie groups. "
+    "The states are exchanged as their coefficients, e.g. "
+    "[x, y, cos(theta), sin(theta)] for SE2.";
+
+  kalmanif::python::bindGroup<manif::SE2d>(m, "se2");
+  kalmanif::python::bindGroup<manif::SE3d>(m, "se3");
+  kalmanif::python::bindGroup<manif::SE_2_3d>(m, "se_2_3");
+}
@@ -0,0 +1,70 @@
+import numpy as np
+import pytest
+
+import kalmanifpy
+from kalmanifpy import se2
+
+
+def _scenario(T=50, seed=0):
+    rng = np.random.default_rng(seed)
+
+    f = se2.SystemModel(np.eye(3) * 1e-3)
+    R = np.eye(2) * 1e-2
+    hs = [
+        se2.LandmarkModel(np.array([2.0, 0.0]), R),
+        se2.LandmarkModel(np.array([2.0, 1.0]), R),
+        se2.GPSModel(R),
+    ]
+
+    dts = np.full(T, 0.1)
+    controls = np.tile([1.0, 0.0, 0.2], (T, 1))
+
+    x = np.array([0.0, 0.0, 1.0, 0.0])
+    measurements = np.empty((T, len(hs), 2))
+    for t in range(T):
+        x = f(x, controls[t] * dts[t])
+        for k, h in enumerate(hs):
+            measurements[t, k] = h(x) + rng.normal(0, 0.1, 2)
+
+    # the gps is only available every other step
+    measurements[1::2, 2] = np.nan
+
+    return f, hs, controls, measurements, dts
+
+
+@pytest.mark.parametrize("Filter", [se2.EKF, se2.SEKF, se2.IEKF, se2.UKFM])
+def test_run_matches_steps(Filter):
+    f, hs, controls, measurements, dts = _scenario()
+
+    x0 = np.array([0.0, 0.0, 1.0, 0.0])
+    P0 = np.eye(3) * 0.1
+
+    batch = Filter(x0, P0)
+    xs, Ps = batch.run(f, hs, controls, measurements, dts)
+
+    assert xs.shape == (len(dts), se2.RepSize)
+    assert Ps.shape == (len(dts), se2.DoF, se2.DoF)
+    assert xs.flags["C_CONTIGUOUS"] and not xs.flags["OWNDATA"]
+
+    step = Filter(x0, P0)
+    for t in range(len(dts)):
+        step.propagate(f, controls[t], dts[t])
+        for k, h in enumerate(hs):
+            if not np.isnan(measurements[t, k, 0]):
+                step.update(h, measurements[t, k])
+
+        np.testing.assert_allclose(xs[t], step.state, atol=1e-12)
+        np.testing.assert_allclose(Ps[t], step.covariance, atol=1e-12)
+
+    np.testing.assert_allclose(batch.state, step.state, atol=1e-12)
+
+
+def test_run_shapes():
+    f, hs, controls, measurements, dts = _scenario(T=5)
+    ekf = se2.EKF(np.array([0.0, 0.0, 1.0, 0.0]), np.eye(3))
+
+    with pytest.raises(ValueError):
+        ekf.run(f, hs, controls[:, :2], measurements, dts)
+
+    with pytest.raises(ValueError):
+        ekf.run(f, hs[:2], controls, measurements, dts)
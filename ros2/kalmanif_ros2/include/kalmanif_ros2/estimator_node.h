@@ -0,0 +1,121 @@
+#ifndef _KALMANIF_ROS2_ESTIMATOR_NODE_H_
+#define _KALMANIF_ROS2_ESTIMATOR_NODE_H_
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/system_models/simple_imu_system_model.h>
+
+#include <manif/SE_2_3.h>
+
+#include <rclcpp/rclcpp.hpp>
+#include <geometry_msgs/msg/point_stamped.hpp>
+#include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
+#include <sensor_msgs/msg/imu.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace kalmanif_ros2 {
+
+/**
+ * @brief A ROS 2 component estimating the pose of an IMU
+ * from its measurements and the relative positions of known landmarks,
+ * running the kalmanif FusionFrontEnd.
+ *
+ * The IMU drives the propagation of a filter on SE_2_3
+ * (see SimpleImuSystemModel), by default a right-invariant EKF,
+ * and each landmark topic
+ * ("landmarks/<i>", a geometry_msgs/PointStamped in the IMU frame)
+ * its updates. The callbacks only push the inputs to the lock-free
+ * queues of the front end, whose own thread runs the filter.
+ * The pose is published at a fixed rate, from the latest estimate.
+ *
+ * With intra-process communication enabled (the default of this node),
+ * the messages of the publishers in the same process are received
+ * without copy. The pose is published in a loaned message when the
+ * middleware can loan it, else from a message allocated once.
+ *
+ * Parameters:
+ * - filter: the filter, "iekf" (InvariantExtendedKalmanFilter),
+ *   "ekf" (ExtendedKalmanFilter) or "ukfm" (UnscentedKalmanFilterManifolds)
+ * - frame_id: the frame of the published pose, "map"
+ * - publish_rate: the pose publication rate [Hz], 100
+ * - landmarks: the landmarks positions, flattened [x0, y0, z0, x1, ...]
+ * - imu.acc_sigma, imu.gyro_sigma: the IMU noise standard deviations
+ * - landmark_sigma: the landmark measurement noise standard deviation
+ * - queue_capacity: the capacity of the front end queue of each stream
+ */
+class ImuLandmarkEstimator : public rclcpp::Node {
+
+public:
+
+  using State = manif::SE_2_3d;
+  using StateCovariance = kalmanif::Covariance<State>;
+  using SystemModel = kalmanif::SimpleImuSystemModel<double>;
+  using Control = SystemModel::Control;
+  using MeasurementModel = kalmanif::Landmark3DMeasurementModel<State>;
+  using Measurement = MeasurementModel::Measurement;
+
+  using Imu = sensor_msgs::msg::Imu;
+  using PointStamped = geometry_msgs::msg::PointStamped;
+  using PoseWithCovarianceStamped = geometry_msgs::msg::PoseWithCovarianceStamped;
+
+  explicit ImuLandmarkEstimator(const rclcpp::NodeOptions& options);
+
+  ~ImuLandmarkEstimator() override;
+
+protected:
+
+  //! The front end, whatever its filter
+  class FrontEndBase;
+
+  //! The front end of a Filter
+  template <typename Filter>
+  class FrontEnd;
+
+  //! Create the front end of the filter named by the 'filter' parameter
+  std::unique_ptr<FrontEndBase> makeFrontEnd(const double t) const;
+
+  //! Start the front end at the first IMU message
+  void start(const double t);
+
+  void onImu(const Imu::ConstSharedPtr& msg);
+
+  void onLandmark(const std::size_t i, const PointStamped::ConstSharedPtr& msg);
+
+  void publish();
+
+  template <typename Pose>
+  void fill(Pose& pose, const kalmanif::TimedEstimate<State>& estimate) const;
+
+  // The models are held by reference by the front end, declared first
+  SystemModel system_model_;
+  std::vector<MeasurementModel, Eigen::aligned_allocator<MeasurementModel>>
+    measurement_models_;
+
+  StateCovariance P_init_;
+  std::size_t capacity_;
+  std::string filter_;
+
+  std::unique_ptr<FrontEndBase> front_end_;
+
+  std::once_flag started_once_;
+  std::atomic<bool> started_{false};
+  std::atomic<std::size_t> dropped_{0};
+  std::size_t published_steps_ = 0;
+
+  std::string frame_id_;
+  PoseWithCovarianceStamped pose_;
+
+  rclcpp::Subscription<Imu>::SharedPtr imu_subscription_;
+  std::vector<rclcpp::Subscription<PointStamped>::SharedPtr>
+    landmark_subscriptions_;
+  rclcpp::Publisher<PoseWithCovarianceStamped>::SharedPtr publisher_;
+  rclcpp::TimerBase::SharedPtr timer_;
+};
+
+} // namespace kalmanif_ros2
+
+#endif // _KALMANIF_ROS2_ESTIMATOR_NODE_H_
@@ -0,0 +1,289 @@
+#include "kalmanif_ros2/estimator_node.h"
+
+#include <rclcpp_components/register_node_macro.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace kalmanif_ros2 {
+
+namespace {
+
+double seconds(const builtin_interfaces::msg::Time& stamp) {
+  return rclcpp::Time(stamp).seconds();
+}
+
+} // namespace
+
+class ImuLandmarkEstimator::FrontEndBase {
+
+public:
+
+  virtual ~FrontEndBase() = default;
+
+  virtual bool pushImu(const double t, const Control& u) = 0;
+
+  virtual bool pushLandmark(
+    const std::size_t i, const double t, const Measurement& y
+  ) = 0;
+
+  virtual bool isRunning() const = 0;
+
+  virtual void stop() = 0;
+
+  virtual kalmanif::TimedEstimate<State> getEstimate() const = 0;
+};
+
+template <typename Filter>
+class ImuLandmarkEstimator::FrontEnd final : public FrontEndBase {
+
+public:
+
+  FrontEnd(
+    const double t,
+    const StateCovariance& P_init,
+    const SystemModel& system_model,
+    const std::vector<
+      MeasurementModel, Eigen::aligned_allocator<MeasurementModel>
+    >& measurement_models,
+    const std::size_t capacity
+  ) : front_end_(t, State::Identity(), P_init) {
+    imu_stream_ = &front_end_.addControlStream(system_model, capacity);
+    for (const auto& h : measurement_models) {
+      landmark_streams_.push_back(
+        &front_end_.addMeasurementStream(h, capacity)
+      );
+    }
+    front_end_.start();
+  }
+
+  bool pushImu(const double t, const Control& u) override {
+    return imu_stream_->push(t, u);
+  }
+
+  bool pushLandmark(
+    const std::size_t i, const double t, const Measurement& y
+  ) override {
+    return landmark_streams_[i]->push(t, y);
+  }
+
+  bool isRunning() const override {
+    return front_end_.isRunning();
+  }
+
+  void stop() override {
+    front_end_.stop();
+  }
+
+  kalmanif::TimedEstimate<State> getEstimate() const override {
+    return front_end_.getEstimate();
+  }
+
+protected:
+
+  using Base = kalmanif::FusionFrontEnd<Filter>;
+
+  Base front_end_;
+  typename Base::template ControlStream<SystemModel>* imu_stream_ = nullptr;
+  std::vector<typename Base::template MeasurementStream<MeasurementModel>*>
+    landmark_streams_;
+};
+
+ImuLandmarkEstimator::ImuLandmarkEstimator(const rclcpp::NodeOptions& options)
+  : rclcpp::Node(
+      "imu_landmark_estimator",
+      rclcpp::NodeOptions(options).use_intra_process_comms(true)
+    ) {
+
+  filter_ = declare_parameter<std::string>("filter", "iekf");
+  frame_id_ = declare_parameter<std::string>("frame_id", "map");
+  const double publish_rate = declare_parameter<double>("publish_rate", 100.);
+  const auto landmarks =
+    declare_parameter<std::vector<double>>("landmarks", std::vector<double>());
+  const double acc_sigma = declare_parameter<double>("imu.acc_sigma", 0.01);
+  const double gyro_sigma = declare_parameter<double>("imu.gyro_sigma", 0.01);
+  const double landmark_sigma = declare_parameter<double>("landmark_sigma", 0.01);
+  const auto initial_variances = declare_parameter<std::vector<double>>(
+    "initial_variances",
+    {1e-3, 1e-3, 1e-3, 1e-2, 1e-2, 1e-2, 1e-3, 1e-3, 1e-3}
+  );
+  capacity_ = std::size_t(declare_parameter<int>("queue_capacity", 1024));
+
+  if (filter_ != "iekf" && filter_ != "ekf" && filter_ != "ukfm") {
+    throw std::invalid_argument(
+      "ImuLandmarkEstimator: 'filter' must be one of 'iekf', 'ekf', 'ukfm'!"
+    );
+  }
+  if (landmarks.size() % 3 != 0) {
+    throw std::invalid_argument(
+      "ImuLandmarkEstimator: 'landmarks' must hold 3 coordinates per landmark!"
+    );
+  }
+  if (initial_variances.size() != std::size_t(State::DoF)) {
+    throw std::invalid_argument(
+      "ImuLandmarkEstimator: 'initial_variances' must hold 9 variances!"
+    );
+  }
+
+  Eigen::Matrix<double, 6, 1> u_sigmas;
+  u_sigmas << acc_sigma, acc_sigma, acc_sigma, gyro_sigma, gyro_sigma, gyro_sigma;
+  system_model_.setCovariance(u_sigmas.array().square().matrix().asDiagonal());
+
+  Eigen::Matrix3d R = Eigen::Matrix3d::Identity() * landmark_sigma * landmark_sigma;
+  for (std::size_t i = 0; i < landmarks.size(); i += 3) {
+    measurement_models_.emplace_back(
+      Measurement(landmarks[i], landmarks[i + 1], landmarks[i + 2]), R
+    );
+  }
+
+  P_init_ = Eigen::Map<const Eigen::Matrix<double, State::DoF, 1>>(
+    initial_variances.data()
+  ).asDiagonal();
+
+  pose_.header.frame_id = frame_id_;
+
+  publisher_ = create_publisher<PoseWithCovarianceStamped>("pose", 10);
+
+  imu_subscription_ = create_subscription<Imu>(
+    "imu", rclcpp::SensorDataQoS(),
+    [this](const Imu::ConstSharedPtr msg) { onImu(msg); }
+  );
+
+  for (std::size_t i = 0; i < measurement_models_.size(); ++i) {
+    landmark_subscriptions_.push_back(create_subscription<PointStamped>(
+      "landmarks/" + std::to_string(i), rclcpp::SensorDataQoS(),
+      [this, i](const PointStamped::ConstSharedPtr msg) { onLandmark(i, msg); }
+    ));
+  }
+
+  timer_ = create_wall_timer(
+    std::chrono::duration<double>(1. / publish_rate), [this]() { publish(); }
+  );
+}
+
+ImuLandmarkEstimator::~ImuLandmarkEstimator() {
+  if (front_end_) {
+    try {
+      front_end_->stop();
+    } catch (const std::exception& e) {
+      RCLCPP_ERROR(get_logger(), "The filter stopped: %s", e.what());
+    }
+  }
+}
+
+std::unique_ptr<ImuLandmarkEstimator::FrontEndBase>
+ImuLandmarkEstimator::makeFrontEnd(const double t) const {
+  if (filter_ == "ekf") {
+    return std::make_unique<
+      FrontEnd<kalmanif::ExtendedKalmanFilter<State>>
+    >(t, P_init_, system_model_, measurement_models_, capacity_);
+  }
+  if (filter_ == "ukfm") {
+    return std::make_unique<
+      FrontEnd<kalmanif::UnscentedKalmanFilterManifolds<State>>
+    >(t, P_init_, system_model_, measurement_models_, capacity_);
+  }
+  return std::make_unique<
+    FrontEnd<kalmanif::InvariantExtendedKalmanFilter<State>>
+  >(t, P_init_, system_model_, measurement_models_, capacity_);
+}
+
+void ImuLandmarkEstimator::start(const double t) {
+  std::call_once(started_once_, [this, t]() {
+    front_end_ = makeFrontEnd(t);
+    started_.store(true, std::memory_order_release);
+  });
+}
+
+void ImuLandmarkEstimator::onImu(const Imu::ConstSharedPtr& msg) {
+  const double t = seconds(msg->header.stamp);
+  start(t);
+
+  Control u;
+  u << msg->linear_acceleration.x,
+       msg->linear_acceleration.y,
+       msg->linear_acceleration.z,
+       msg->angular_velocity.x,
+       msg->angular_velocity.y,
+       msg->angular_velocity.z;
+
+  if (!front_end_->pushImu(t, u)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void ImuLandmarkEstimator::onLandmark(
+  const std::size_t i, const PointStamped::ConstSharedPtr& msg
+) {
+  // Nothing to update before the first propagation
+  if (!started_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  const Measurement y(msg->point.x, msg->point.y, msg->point.z);
+
+  if (!front_end_->pushLandmark(i, seconds(msg->header.stamp), y)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void ImuLandmarkEstimator::publish() {
+  if (!started_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  if (!front_end_->isRunning()) {
+    // rethrows the error that stopped the filter thread
+    front_end_->stop();
+  }
+
+  const std::size_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+  if (dropped > 0) {
+    RCLCPP_WARN(
+      get_logger(), "%zu inputs dropped, the filter queues are full.", dropped
+    );
+  }
+
+  const kalmanif::TimedEstimate<State> estimate = front_end_->getEstimate();
+  if (estimate.steps == published_steps_) {
+    return;
+  }
+  published_steps_ = estimate.steps;
+
+  if (publisher_->can_loan_messages()) {
+    auto loaned = publisher_->borrow_loaned_message();
+    loaned.get().header.frame_id = frame_id_;
+    fill(loaned.get(), estimate);
+    publisher_->publish(std::move(loaned));
+  } else {
+    fill(pose_, estimate);
+    publisher_->publish(pose_);
+  }
+}
+
+template <typename Pose>
+void ImuLandmarkEstimator::fill(
+  Pose& pose, const kalmanif::TimedEstimate<State>& estimate
+) const {
+  pose.header.stamp = rclcpp::Time(static_cast<int64_t>(estimate.t * 1e9));
+
+  const Eigen::Vector3d t = estimate.state.translation();
+  const Eigen::Quaterniond q = estimate.state.quat();
+
+  pose.pose.pose.position.x = t.x();
+  pose.pose.pose.position.y = t.y();
+  pose.pose.pose.position.z = t.z();
+  pose.pose.pose.orientation.x = q.x();
+  pose.pose.pose.orientation.y = q.y();
+  pose.pose.pose.orientation.z = q.z();
+  pose.pose.pose.orientation.w = q.w();
+
+  // The position and orientation block, in the tangent space of the filter
+  Eigen::Map<Eigen::Matrix<double, 6, 6, Eigen::RowMajor>>(
+    pose.pose.covariance.data()
+  ) = estimate.covariance.topLeftCorner<6, 6>();
+}
+
+} // namespace kalmanif_ros2
+
+RCLCPP_COMPONENTS_REGISTER_NODE(kalmanif_ros2::ImuLandmarkEstimator)
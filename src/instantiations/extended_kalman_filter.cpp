@@ -0,0 +1,6 @@
+// The instantiations of the ExtendedKalmanFilter, see kalmanif/impl/instantiations.h
+#define KALMANIF_INSTANTIATING
+
+#include "kalmanif/extended_kalman_filter.h"
+
+KALMANIF_INSTANTIATE_FILTER(, kalmanif::ExtendedKalmanFilter)
@@ -0,0 +1,6 @@
+// The instantiations of the InvariantExtendedKalmanFilter, see kalmanif/impl/instantiations.h
+#define KALMANIF_INSTANTIATING
+
+#include "kalmanif/invariant_extended_kalman_filter.h"
+
+KALMANIF_INSTANTIATE_INVARIANT_FILTER(, kalmanif::InvariantExtendedKalmanFilter)
@@ -0,0 +1,6 @@
+// The instantiations of the SquareRootExtendedKalmanFilter, see kalmanif/impl/instantiations.h
+#define KALMANIF_INSTANTIATING
+
+#include "kalmanif/square_root_extended_kalman_filter.h"
+
+KALMANIF_INSTANTIATE_FILTER(, kalmanif::SquareRootExtendedKalmanFilter)
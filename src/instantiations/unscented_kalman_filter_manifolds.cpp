@@ -0,0 +1,6 @@
+// The instantiations of the UnscentedKalmanFilterManifolds, see kalmanif/impl/instantiations.h
+#define KALMANIF_INSTANTIATING
+
+#include "kalmanif/unscented_kalman_filter_manifolds.h"
+
+KALMANIF_INSTANTIATE_FILTER(, kalmanif::UnscentedKalmanFilterManifolds)
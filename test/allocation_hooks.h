@@ -0,0 +1,108 @@
+#ifndef _KALMANIF_TEST_ALLOCATION_HOOKS_H_
+#define _KALMANIF_TEST_ALLOCATION_HOOKS_H_
+
+/**
+ * \file allocation_hooks.h
+ *
+ * Count the heap allocations performed in between
+ * startCounting() and stopCounting().
+ *
+ * With glibc, malloc & co are hooked, otherwise the global operator new.
+ * The hooks are defined here, to be included by a single
+ * translation unit of a test executable.
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<bool> counting(false);
+std::atomic<std::size_t> allocations(0);
+
+void countAllocation() {
+  if (counting.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void startCounting() {
+  allocations = 0;
+  counting = true;
+}
+
+std::size_t stopCounting() {
+  counting = false;
+  return allocations;
+}
+
+} // namespace
+
+#if defined(__GLIBC__)
+// Hook the C allocation functions, which Eigen and operator new rely on.
+extern "C" {
+
+void* __libc_malloc(std::size_t);
+void* __libc_calloc(std::size_t, std::size_t);
+void* __libc_realloc(void*, std::size_t);
+void* __libc_memalign(std::size_t, std::size_t);
+
+void* malloc(std::size_t size) {
+  countAllocation();
+  return __libc_malloc(size);
+}
+
+void* calloc(std::size_t num, std::size_t size) {
+  countAllocation();
+  return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, std::size_t size) {
+  countAllocation();
+  return __libc_realloc(ptr, size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) {
+  countAllocation();
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, std::size_t alignment, std::size_t size) {
+  countAllocation();
+  *ptr = __libc_memalign(alignment, size);
+  return *ptr ? 0 : ENOMEM;
+}
+
+} // extern "C"
+#else
+// Hook the replaceable allocation functions.
+void* operator new(std::size_t size) {
+  countAllocation();
+  if (void* ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  countAllocation();
+  return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+  return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+#endif
+
+#endif // _KALMANIF_TEST_ALLOCATION_HOOKS_H_
@@ -0,0 +1,167 @@
+/**
+ * \file gtest_adaptive_noise.cpp
+ *
+ * Check the online estimation of the measurement and process noises
+ * by covariance matching.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <random>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = DummyGPSMeasurementModel<State>;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+
+class TEST_ADAPTIVE_NOISE : public testing::Test {
+protected:
+
+  //! Simulate a step, the filter models noising the truth
+  void step(EKF& ekf, const Control& u, const double sigma_u) {
+    X_true = X_true + (u + Control(sigma_u * noise3()));
+
+    const Measurement y =
+      X_true.translation() + X_true.rotation() * (sigma_y * noise2());
+
+    if (adaptive_Q) {
+      adaptive_Q->propagate(ekf, f, u);
+    } else {
+      ekf.propagate(f, u);
+    }
+
+    adaptive_R.update(ekf, h, y);
+  }
+
+  Eigen::Vector3d noise3() {
+    return Eigen::Vector3d(normal(gen), normal(gen), normal(gen));
+  }
+
+  Eigen::Vector2d noise2() {
+    return Eigen::Vector2d(normal(gen), normal(gen));
+  }
+
+  std::mt19937 gen = std::mt19937(42);
+  std::normal_distribution<double> normal;
+
+  const double sigma_y = 0.2;
+
+  State X_true = State::Identity();
+
+  SystemModel f;
+  MeasurementModel h = MeasurementModel(Covariance<Measurement>::Identity());
+
+  AdaptiveMeasurementNoise<MeasurementModel> adaptive_R;
+  AdaptiveProcessNoise<SystemModel>* adaptive_Q = nullptr;
+};
+
+TEST_F(TEST_ADAPTIVE_NOISE, TEST_MEASUREMENT_NOISE)
+{
+  f.setCovariance(Covariance<Control>::Identity() * 1e-4);
+
+  EKF ekf(X_true, Covariance<State>::Identity() * 1e-2);
+
+  // R is over-estimated 25 times
+  const Control u(0.1, 0, 0.05);
+  for (int i = 0; i < 500; ++i) {
+    step(ekf, u, 1e-2);
+  }
+
+  const Covariance<Measurement> R_true =
+    Covariance<Measurement>::Identity() * sigma_y * sigma_y;
+
+  EXPECT_EQ(500u, adaptive_R.getCount());
+  EXPECT_EIGEN_NEAR(R_true, adaptive_R.getEstimate(), 2e-2);
+
+  // The model is only refactorized past the threshold
+  EXPECT_GT(adaptive_R.getApplyCount(), 0u);
+  EXPECT_LT(adaptive_R.getApplyCount(), adaptive_R.getCount() / 4);
+
+  // and holds the estimate within the threshold
+  const double relative_change =
+    (h.getCovariance() - adaptive_R.getEstimate()).norm() /
+    h.getCovariance().norm();
+  EXPECT_LE(relative_change, 0.1);
+
+  EXPECT_TRUE(isCovariance(h.getCovariance()));
+}
+
+TEST_F(TEST_ADAPTIVE_NOISE, TEST_PROCESS_NOISE)
+{
+  AdaptiveProcessNoise<SystemModel> Q_estimator;
+  adaptive_Q = &Q_estimator;
+
+  // Q is under-estimated 100 times
+  const Covariance<Control> Q_init = Covariance<Control>::Identity() * 1e-6;
+  f.setCovariance(Q_init);
+  h.setCovariance(Covariance<Measurement>::Identity() * sigma_y * sigma_y);
+
+  EKF ekf(X_true, Covariance<State>::Identity() * 1e-2);
+
+  const Control u(0.1, 0, 0.05);
+  for (int i = 0; i < 300; ++i) {
+    step(ekf, u, 1e-2);
+  }
+
+  // The first propagation has no correction yet
+  EXPECT_EQ(299u, Q_estimator.getCount());
+  EXPECT_GT(
+    Q_estimator.getEstimate().topLeftCorner<2, 2>().trace(),
+    10 * Q_init.topLeftCorner<2, 2>().trace()
+  );
+  EXPECT_TRUE(isCovariance(f.getCovariance()));
+}
+
+TEST_F(TEST_ADAPTIVE_NOISE, TEST_THRESHOLD)
+{
+  f.setCovariance(Covariance<Control>::Identity() * 1e-4);
+  const Covariance<Measurement> R_init = h.getCovariance();
+
+  AdaptiveNoiseOptions options;
+  options.threshold = 1e6;
+  adaptive_R = AdaptiveMeasurementNoise<MeasurementModel>(options);
+
+  EKF ekf(X_true, Covariance<State>::Identity() * 1e-2);
+
+  const Control u(0.1, 0, 0.05);
+  for (int i = 0; i < 50; ++i) {
+    step(ekf, u, 1e-2);
+  }
+
+  // The estimate moves, the model is left untouched
+  EXPECT_EQ(50u, adaptive_R.getCount());
+  EXPECT_EQ(0u, adaptive_R.getApplyCount());
+  EXPECT_LT(adaptive_R.getEstimate().trace(), R_init.trace());
+  EXPECT_EIGEN_NEAR(R_init, h.getCovariance());
+}
+
+TEST(TEST_ADAPTIVE_NOISE_OPTIONS, TEST_INVALID_OPTIONS)
+{
+  AdaptiveNoiseOptions options;
+  options.forgetting = 1;
+  EXPECT_THROW(
+    AdaptiveMeasurementNoise<MeasurementModel>{options},
+    kalmanif::invalid_argument
+  );
+
+  options.forgetting = 0.9;
+  options.threshold = -1;
+  EXPECT_THROW(
+    AdaptiveProcessNoise<SystemModel>{options}, kalmanif::invalid_argument
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,239 @@
+/**
+ * \file gtest_async.cpp
+ *
+ * Check the strands and the awaitable propagate and update.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+
+/**
+ * A minimal thread pool scheduler, as a middleware would provide.
+ */
+class PoolScheduler {
+public:
+
+  explicit PoolScheduler(const int num_threads)
+    : pool_(std::make_shared<Pool>()) {
+    for (int i = 0; i < num_threads; ++i) {
+      pool_->threads.emplace_back([pool = pool_]{ pool->run(); });
+    }
+  }
+
+  void operator ()(std::function<void()> task) const {
+    {
+      std::lock_guard<std::mutex> lock(pool_->mutex);
+      pool_->tasks.push_back(std::move(task));
+    }
+    pool_->condition.notify_one();
+  }
+
+  void join() {
+    {
+      std::lock_guard<std::mutex> lock(pool_->mutex);
+      pool_->stop = true;
+    }
+    pool_->condition.notify_all();
+    for (auto& thread : pool_->threads) {
+      thread.join();
+    }
+    pool_->threads.clear();
+  }
+
+protected:
+
+  struct Pool {
+    void run() {
+      for (;;) {
+        std::function<void()> task;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          condition.wait(lock, [this]{ return stop || !tasks.empty(); });
+          if (tasks.empty()) {
+            return;
+          }
+          task = std::move(tasks.front());
+          tasks.pop_front();
+        }
+        task();
+      }
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> threads;
+    bool stop = false;
+  };
+
+  std::shared_ptr<Pool> pool_;
+};
+
+/**
+ * A fire-and-forget coroutine.
+ */
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+class TEST_ASYNC : public testing::Test {
+protected:
+
+  void TearDown() override {
+    scheduler.join();
+  }
+
+  // Wait for count coroutines to be done, then for the strands to be idle
+  void join(const int count) {
+    while (done.load() < count) {
+      std::this_thread::yield();
+    }
+    scheduler.join();
+  }
+
+  Control control(const int t) const {
+    return Control(0.1, 0.01 * t, 0.05);
+  }
+
+  Measurement measure(const int t, const int k) const {
+    return Measurement(2.0 - 0.1 * k, 1.0 + 0.01 * t);
+  }
+
+  Detached track(EKF& filter, Strand<PoolScheduler>& strand, const int t) {
+    for (int k = 0; k < epochs; ++k) {
+      co_await filter.propagateAsync(strand, system_model, control(t));
+      const State x = co_await filter.updateAsync(
+        strand, measurement_model, measure(t, k)
+      );
+      EXPECT_MANIF_NEAR(filter.getState(), x);
+    }
+    ++done;
+  }
+
+  static constexpr int epochs = 20;
+
+  PoolScheduler scheduler{3};
+  std::atomic<int> done{0};
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+
+  State X_init = State(0.05, -0.05, 0.02);
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+};
+
+TEST_F(TEST_ASYNC, TEST_SHARED_POOL)
+{
+  // many filters share a small pool, each through its own strand
+  constexpr int tracks = 16;
+
+  std::vector<EKF> filters(tracks, EKF(X_init, P_init));
+  std::vector<std::unique_ptr<Strand<PoolScheduler>>> strands;
+  for (int t = 0; t < tracks; ++t) {
+    strands.push_back(std::make_unique<Strand<PoolScheduler>>(scheduler));
+  }
+
+  for (int t = 0; t < tracks; ++t) {
+    track(filters[t], *strands[t], t);
+  }
+  join(tracks);
+
+  for (int t = 0; t < tracks; ++t) {
+    EKF reference(X_init, P_init);
+    for (int k = 0; k < epochs; ++k) {
+      reference.propagate(system_model, control(t));
+      reference.update(measurement_model, measure(t, k));
+    }
+    EXPECT_MANIF_NEAR(reference.getState(), filters[t].getState());
+    EXPECT_EIGEN_NEAR(reference.getCovariance(), filters[t].getCovariance());
+  }
+}
+
+TEST_F(TEST_ASYNC, TEST_STRAND_SERIALIZES)
+{
+  Strand<PoolScheduler> strand(scheduler);
+
+  // not atomic, the strand serializes the increments
+  long counter = 0;
+  std::vector<int> order;
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < 4; ++p) {
+    producers.emplace_back([&]{
+      for (int i = 0; i < 10000; ++i) {
+        strand.post([&]{ ++counter; });
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  // tasks posted from one thread run in order
+  for (int i = 0; i < 100; ++i) {
+    strand.post([&order, i]{ order.push_back(i); });
+  }
+  strand.post([this]{ ++done; });
+  join(1);
+
+  EXPECT_EQ(40000, counter);
+  ASSERT_EQ(100u, order.size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, order[i]);
+  }
+}
+
+TEST_F(TEST_ASYNC, TEST_EXCEPTION)
+{
+  Strand<PoolScheduler> strand(scheduler);
+  bool caught = false;
+
+  [](Strand<PoolScheduler>& strand, bool& caught, std::atomic<int>& done)
+    -> Detached {
+    try {
+      co_await internal::StrandAwaitable(strand, []() -> int {
+        throw kalmanif::runtime_error("TEST_EXCEPTION: thrown on the strand!");
+      });
+    } catch (const kalmanif::runtime_error&) {
+      caught = true;
+    }
+    ++done;
+  }(strand, caught, done);
+
+  join(1);
+  EXPECT_TRUE(caught);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
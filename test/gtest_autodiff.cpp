@@ -0,0 +1,182 @@
+/**
+ * \file gtest_autodiff.cpp
+ *
+ * Check the jacobians derived by forward-mode automatic differentiation
+ * against the analytic ones.
+ */
+
+#include <kalmanif/autodiff.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+/**
+ * The Lie system model, x + u, of automatic jacobians.
+ */
+struct AutoDiffSystemModel;
+
+/**
+ * The 2D landmark model, of automatic jacobians.
+ */
+struct AutoDiffLandmark;
+
+namespace kalmanif {
+namespace internal {
+
+template <>
+struct traits<AutoDiffSystemModel> {
+  using State = ::State;
+  using Control = ::Control;
+};
+
+template <>
+struct traits<AutoDiffLandmark> {
+  using State = ::State;
+  using Scalar = double;
+  using Measurement = ::Measurement;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+struct AutoDiffSystemModel
+  : SystemModelBase<AutoDiffSystemModel>
+  , Linearized<SystemModelBase<AutoDiffSystemModel>>
+  , AutoDiffLinearized<SystemModelBase<AutoDiffSystemModel>> {
+
+  using Base = SystemModelBase<AutoDiffSystemModel>;
+  using Base::getCovariance;
+  using Base::getCovarianceSquareRoot;
+  using Base::operator ();
+
+  AutoDiffSystemModel(const Eigen::Ref<const Covariance<Control>>& Q)
+    : Base(Q) {}
+
+  template <typename _State, typename _Control>
+  _State run(const _State& x, const _Control& u) const {
+    return x + u;
+  }
+};
+
+struct AutoDiffLandmark
+  : MeasurementModelBase<AutoDiffLandmark>
+  , Linearized<MeasurementModelBase<AutoDiffLandmark>>
+  , AutoDiffLinearized<MeasurementModelBase<AutoDiffLandmark>> {
+
+  using Base = MeasurementModelBase<AutoDiffLandmark>;
+  using Base::setCovariance;
+  using Base::getCovariance;
+  using Base::getCovarianceSquareRoot;
+  using Base::operator ();
+
+  AutoDiffLandmark(
+    const Landmark& landmark, const Eigen::Ref<Covariance<Measurement>>& R
+  ) : landmark_(landmark) {
+    setCovariance(R);
+  }
+
+  template <typename _State>
+  Eigen::Matrix<typename _State::Scalar, 2, 1> run(const _State& x) const {
+    using Scalar = typename _State::Scalar;
+    return x.inverse().act(landmark_.template cast<Scalar>());
+  }
+
+  Landmark landmark_;
+};
+
+TEST(TEST_AUTODIFF, TEST_SYSTEM_MODEL)
+{
+  const StateCovariance Q = StateCovariance::Identity() * 1e-3;
+  const SystemModel system_model(Q);
+  const AutoDiffSystemModel autodiff_model(Q);
+
+  for (int i = 0; i < 10; ++i) {
+    const State X = State::Random();
+    const Control u = Control::Random();
+
+    Jacobian<State, State> F, F_ad;
+    Jacobian<State, Control> W, W_ad;
+
+    const State X_new = system_model.run_linearized(X, u, F, W);
+    const State X_new_ad = autodiff_model.run_linearized(X, u, F_ad, W_ad);
+
+    EXPECT_MANIF_NEAR(X_new, X_new_ad);
+    EXPECT_EIGEN_NEAR(F, F_ad);
+    EXPECT_EIGEN_NEAR(W, W_ad);
+  }
+}
+
+TEST(TEST_AUTODIFF, TEST_MEASUREMENT_MODEL)
+{
+  const Eigen::Matrix2d R = Eigen::Matrix2d::Identity() * 1e-2;
+  const MeasurementModel measurement_model(Landmark(2.0, 1.0), R);
+  const AutoDiffLandmark autodiff_model(Landmark(2.0, 1.0), R);
+
+  for (int i = 0; i < 10; ++i) {
+    const State X = State::Random();
+
+    Jacobian<Measurement, State> H, H_ad;
+    Jacobian<Measurement, Measurement> V, V_ad;
+
+    const Measurement y = measurement_model.run_linearized(X, H, V);
+    const Measurement y_ad = autodiff_model.run_linearized(X, H_ad, V_ad);
+
+    EXPECT_EIGEN_NEAR(y, y_ad);
+    EXPECT_EIGEN_NEAR(H, H_ad);
+
+    // additive noise
+    EXPECT_EIGEN_NEAR(Eigen::Matrix2d::Identity(), V_ad);
+  }
+}
+
+TEST(TEST_AUTODIFF, TEST_EKF)
+{
+  const StateCovariance Q = StateCovariance::Identity() * 1e-3;
+  const SystemModel system_model(Q);
+  const AutoDiffSystemModel autodiff_system_model(Q);
+
+  // the analytic landmark model has the noise in the robot frame,
+  // the additive noise is isotropic to match it
+  const Eigen::Matrix2d R = Eigen::Matrix2d::Identity() * 1e-2;
+  const MeasurementModel measurement_model(Landmark(2.0, 1.0), R);
+  const AutoDiffLandmark autodiff_measurement_model(Landmark(2.0, 1.0), R);
+
+  const State X_init(0.05, -0.05, 0.02);
+  const StateCovariance P_init = StateCovariance::Identity() * 1e-2;
+
+  ExtendedKalmanFilter<State> ekf(X_init, P_init);
+  ExtendedKalmanFilter<State> ekf_ad(X_init, P_init);
+
+  State X = X_init;
+  const Control u(0.1, 0.0, 0.05);
+  for (int k = 0; k < 20; ++k) {
+    X = X + u;
+    ekf.propagate(system_model, u);
+    ekf_ad.propagate(autodiff_system_model, u);
+
+    const Measurement y =
+      measurement_model(X) + Measurement(0.01, -0.02) * (k % 3);
+    ekf.update(measurement_model, y);
+    ekf_ad.update(autodiff_measurement_model, y);
+
+    EXPECT_MANIF_NEAR(ekf.getState(), ekf_ad.getState(), 1e-12);
+    EXPECT_EIGEN_NEAR(ekf.getCovariance(), ekf_ad.getCovariance(), 1e-12);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
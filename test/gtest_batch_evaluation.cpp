@@ -0,0 +1,235 @@
+/**
+ * \file gtest_batch_evaluation.cpp
+ *
+ * Check the batched evaluation of the measurement and system models.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/SE3.h>
+#include <manif/SE_2_3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <array>
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using UKFM = UnscentedKalmanFilterManifolds<State>;
+
+/**
+ * The 2D landmark model, evaluated one state at a time.
+ */
+struct PointwiseLandmark;
+
+namespace kalmanif {
+namespace internal {
+
+template <>
+struct traits<PointwiseLandmark> {
+  using State = ::State;
+  using Scalar = double;
+  using Measurement = ::Measurement;
+  static constexpr Invariance invariance = Invariance::Right;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+struct PointwiseLandmark
+  : MeasurementModelBase<PointwiseLandmark>
+  , LinearizedInvariant<MeasurementModelBase<PointwiseLandmark>> {
+
+  PointwiseLandmark(
+    const Landmark& landmark, const Eigen::Ref<Covariance<Measurement>>& R
+  ) : model_(landmark, R) {
+    setCovariance(R);
+  }
+
+  Measurement run(const State& x) const {
+    return model_.run(x);
+  }
+
+  MeasurementModel model_;
+};
+
+using ImuModel = SimpleImuSystemModel<double>;
+using ImuControl = ImuModel::Control;
+
+/**
+ * The IMU model, evaluated one state at a time.
+ */
+struct PointwiseImu;
+
+namespace kalmanif {
+namespace internal {
+
+template <>
+struct traits<PointwiseImu> {
+  using State = SE_2_3d;
+  using Control = ImuControl;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+struct PointwiseImu : SystemModelBase<PointwiseImu> {
+
+  PointwiseImu(const Covariance<ImuControl>& Q) {
+    setCovariance(Q);
+  }
+
+  SE_2_3d run(const SE_2_3d& x, const ImuControl& u, const double dt) const {
+    return model_.run(x, u, dt);
+  }
+
+  ImuModel model_;
+};
+
+TEST(TEST_BATCH_EVALUATION, TEST_HAS_BATCH_EVALUATION)
+{
+  EXPECT_TRUE(internal::has_batch_evaluation<MeasurementModel>::value);
+  EXPECT_TRUE(
+    internal::has_batch_evaluation<Landmark3DMeasurementModel<SE3d>>::value
+  );
+  EXPECT_FALSE(internal::has_batch_evaluation<PointwiseLandmark>::value);
+
+  EXPECT_TRUE(internal::has_batch_evaluation<ImuModel>::value);
+  EXPECT_FALSE(internal::has_batch_evaluation<SystemModel>::value);
+  EXPECT_FALSE(internal::has_batch_evaluation<PointwiseImu>::value);
+  EXPECT_FALSE(internal::has_linearized_batch_evaluation<ImuModel>::value);
+}
+
+TEST(TEST_BATCH_EVALUATION, TEST_LANDMARK_BATCH)
+{
+  const Eigen::Matrix2d R = Eigen::Matrix2d::Identity() * 1e-2;
+  const MeasurementModel model(Landmark(2.0, 1.0), R);
+  const PointwiseLandmark pointwise(Landmark(2.0, 1.0), R);
+
+  std::array<State, 6> xs;
+  for (std::size_t j = 0; j < xs.size(); ++j) {
+    xs[j] = State(0.3 * j, -0.2 * j, 0.4 * j - 1.0);
+  }
+
+  Eigen::Matrix<double, 2, 6> ys, ys_pointwise;
+  model.batch(xs, ys);
+  pointwise.batch(xs, ys_pointwise);
+
+  for (std::size_t j = 0; j < xs.size(); ++j) {
+    EXPECT_EIGEN_NEAR(model(xs[j]), ys.col(j));
+    EXPECT_EIGEN_NEAR(model(xs[j]), ys_pointwise.col(j));
+  }
+
+  using Model3D = Landmark3DMeasurementModel<SE3d>;
+  const Model3D model_3d(
+    Model3D::Landmark(2.0, 1.0, -1.0), Eigen::Matrix3d::Identity()
+  );
+
+  std::array<SE3d, 4> xs_3d;
+  for (auto& x : xs_3d) {
+    x = SE3d::Random();
+  }
+
+  Eigen::Matrix<double, 3, 4> ys_3d;
+  model_3d.batch(xs_3d, ys_3d);
+
+  for (std::size_t j = 0; j < xs_3d.size(); ++j) {
+    EXPECT_EIGEN_NEAR(model_3d(xs_3d[j]), ys_3d.col(j));
+  }
+}
+
+TEST(TEST_BATCH_EVALUATION, TEST_UKFM)
+{
+  const SystemModel system_model(StateCovariance::Identity() * 1e-3);
+  const Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  const MeasurementModel model(Landmark(2.0, 1.0), R);
+  const PointwiseLandmark pointwise(Landmark(2.0, 1.0), R);
+
+  const State X_init(0.05, -0.05, 0.02);
+  const StateCovariance P_init = StateCovariance::Identity() * 0.1;
+
+  UKFM ukfm(X_init, P_init);
+  UKFM reference(X_init, P_init);
+
+  State X = X_init;
+  const Control u(0.1, 0.0, 0.05);
+  for (int k = 0; k < 20; ++k) {
+    X = X + u;
+    ukfm.propagate(system_model, u);
+    reference.propagate(system_model, u);
+
+    const Measurement y = model(X) + Measurement(0.01, -0.02) * (k % 3);
+    ukfm.update(model, y);
+    reference.update(pointwise, y);
+
+    EXPECT_MANIF_NEAR(reference.getState(), ukfm.getState(), 1e-12);
+    EXPECT_EIGEN_NEAR(
+      reference.getCovariance(), ukfm.getCovariance(), 1e-12
+    );
+  }
+}
+
+TEST(TEST_BATCH_EVALUATION, TEST_IMU_BATCH)
+{
+  const double dt = 0.01;
+  ImuModel model;
+  model.setCovariance(Covariance<ImuControl>::Identity() * 1e-4);
+
+  // More states than a chunk of the batch
+  std::vector<SE_2_3d, Eigen::aligned_allocator<SE_2_3d>> xs(37), xs_new(37);
+  std::vector<ImuControl, Eigen::aligned_allocator<ImuControl>> us(37);
+  for (std::size_t j = 0; j < xs.size(); ++j) {
+    xs[j] = SE_2_3d::Random();
+    us[j] = ImuControl::Random();
+  }
+
+  model.batch(xs, us, xs_new, dt);
+
+  for (std::size_t j = 0; j < xs.size(); ++j) {
+    EXPECT_MANIF_NEAR(model(xs[j], us[j], dt), xs_new[j], 1e-12);
+  }
+}
+
+TEST(TEST_BATCH_EVALUATION, TEST_UKFM_SYSTEM_MODEL)
+{
+  using ImuUKFM = UnscentedKalmanFilterManifolds<SE_2_3d>;
+
+  const double dt = 0.01;
+  const Covariance<ImuControl> Q = Covariance<ImuControl>::Identity() * 1e-4;
+  ImuModel model;
+  model.setCovariance(Q);
+  const PointwiseImu pointwise(Q);
+
+  const Covariance<SE_2_3d> P_init = Covariance<SE_2_3d>::Identity() * 1e-2;
+
+  ImuUKFM ukfm(SE_2_3d::Identity(), P_init);
+  ImuUKFM reference(SE_2_3d::Identity(), P_init);
+
+  ImuControl u;
+  u << 0.1, 0.0, 9.80665, 0.0, 0.05, 0.1;
+  for (int k = 0; k < 20; ++k) {
+    ukfm.propagate(model, u, dt);
+    reference.propagate(pointwise, u, dt);
+
+    EXPECT_MANIF_NEAR(reference.getState(), ukfm.getState(), 1e-12);
+    EXPECT_EIGEN_NEAR(
+      reference.getCovariance(), ukfm.getCovariance(), 1e-12
+    );
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
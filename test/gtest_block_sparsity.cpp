@@ -0,0 +1,194 @@
+/**
+ * \file gtest_block_sparsity.cpp
+ *
+ * Check the block-sparse product kernels
+ * and the sparsity patterns declared by the models.
+ */
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/system_models/simple_imu_system_model.h>
+
+#include <manif/SE_2_3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE_2_3d;
+using Tangent = State::Tangent;
+using SystemModel = SimpleImuSystemModel<State::Scalar>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark3DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using ImuSparsity = internal::traits<SystemModel>::InvariantJacobianSparsity;
+using LandmarkSparsity = internal::traits<MeasurementModel>::JacobianSparsity;
+using LandmarkInvariantSparsity =
+  internal::traits<MeasurementModel>::InvariantJacobianSparsity;
+
+/**
+ * @brief Check that a matrix matches a sparsity pattern.
+ */
+template <typename Sparsity, typename Matrix>
+void expectPattern(const Matrix& A) {
+  constexpr int R = Sparsity::BlockRowSize;
+  constexpr int C = Sparsity::BlockColSize;
+
+  for (int i = 0; i < Sparsity::Rows; ++i) {
+    for (int j = 0; j < Sparsity::Cols; ++j) {
+      const auto block = A.template block<R, C>(i * R, j * C);
+      if (Sparsity::isIdentity(i, j)) {
+        EXPECT_TRUE(block.isIdentity()) << "block " << i << ", " << j;
+      } else if (!Sparsity::isNonZero(i, j)) {
+        EXPECT_TRUE(block.isZero()) << "block " << i << ", " << j;
+      }
+    }
+  }
+}
+
+/**
+ * @brief A random matrix matching a sparsity pattern.
+ */
+template <typename Sparsity, typename Matrix>
+Matrix randomPattern() {
+  constexpr int R = Sparsity::BlockRowSize;
+  constexpr int C = Sparsity::BlockColSize;
+
+  Matrix A = Matrix::Random();
+  for (int i = 0; i < Sparsity::Rows; ++i) {
+    for (int j = 0; j < Sparsity::Cols; ++j) {
+      auto block = A.template block<R, C>(i * R, j * C);
+      if (Sparsity::isIdentity(i, j)) {
+        block.setIdentity();
+      } else if (!Sparsity::isNonZero(i, j)) {
+        block.setZero();
+      }
+    }
+  }
+  return A;
+}
+
+TEST(TEST_BLOCK_SPARSITY, TEST_SPARSE_PRODUCT)
+{
+  const auto A = randomPattern<ImuSparsity, Eigen::Matrix<double, 9, 9>>();
+  const Eigen::Matrix<double, 9, 6> B = Eigen::Matrix<double, 9, 6>::Random();
+
+  EXPECT_EIGEN_NEAR(A * B, internal::sparseProduct<ImuSparsity>(A, B), 1e-14);
+  EXPECT_EIGEN_NEAR(
+    A * B, internal::sparseProduct<DenseJacobian>(A, B), 1e-14
+  );
+
+  const auto H =
+    randomPattern<LandmarkSparsity, Eigen::Matrix<double, 3, 9>>();
+  const Eigen::Matrix<double, 9, 9> P = Eigen::Matrix<double, 9, 9>::Random();
+
+  EXPECT_EIGEN_NEAR(
+    H * P, internal::sparseProduct<LandmarkSparsity>(H, P), 1e-14
+  );
+}
+
+TEST(TEST_BLOCK_SPARSITY, TEST_COVARIANCE_PRODUCT)
+{
+  const auto F = randomPattern<ImuSparsity, Eigen::Matrix<double, 9, 9>>();
+  const Eigen::Matrix<double, 9, 6> W = Eigen::Matrix<double, 9, 6>::Random();
+
+  Eigen::Matrix<double, 9, 9> P = Eigen::Matrix<double, 9, 9>::Random();
+  P = P * P.transpose();
+
+  Eigen::Matrix<double, 6, 6> Q = Eigen::Matrix<double, 6, 6>::Random();
+  Q = Q * Q.transpose();
+
+  EXPECT_EIGEN_NEAR(
+    internal::covarianceProduct(F, P, W, Q),
+    internal::sparseCovarianceProduct<ImuSparsity>(F, P, W, Q),
+    1e-12
+  );
+}
+
+TEST(TEST_BLOCK_SPARSITY, TEST_IMU_PATTERN)
+{
+  const SystemModel system_model;
+  const LinearizedInvariant<SystemModelBase<SystemModel>>& f = system_model;
+
+  Control u;
+  u << 0.1, 0.01, 9.9, 0.01, 0.1, 0.;
+
+  Jacobian<State, State> F;
+  Jacobian<State, Control> W;
+
+  f(State::Random(), u, F, W, 0.01);
+
+  expectPattern<ImuSparsity>(F);
+}
+
+TEST(TEST_BLOCK_SPARSITY, TEST_IMU_LINEARIZED)
+{
+  // The block-wise jacobians against the dense products
+  const SystemModel system_model;
+  const Linearized<SystemModelBase<SystemModel>>& f = system_model;
+
+  constexpr double dt = 0.01;
+  constexpr double dt22 = 0.5 * dt * dt;
+
+  const State x = State::Random();
+  const Eigen::Vector3d gravity(0, 0, -9.80665);
+
+  Control u;
+  u << 0.1, 0.01, 9.9, 0.01, 0.1, 0.;
+
+  Jacobian<State, State> F;
+  Jacobian<State, Control> W;
+
+  f(x, u, F, W, dt);
+
+  const Eigen::Matrix3d Rt = x.rotation().transpose();
+  const Eigen::Vector3d Rtg = Rt * gravity;
+  const Eigen::Vector3d acc_k = u.head<3>() + Rtg;
+  const Eigen::Vector3d accLin = dt * Rt * x.linearVelocity() + dt22 * acc_k;
+
+  Tangent tau;
+  tau << accLin, dt * u.tail<3>(), dt * acc_k;
+
+  Jacobian<State, State> J_xnew_x, J_xnew_tau;
+  x.plus(tau, J_xnew_x, J_xnew_tau);
+
+  Jacobian<Tangent, Control> J_tau_u = Jacobian<Tangent, Control>::Zero();
+  J_tau_u.block<3, 3>(0, 0).diagonal().setConstant(dt);
+  J_tau_u.block<3, 3>(3, 3).diagonal().setConstant(dt);
+  J_tau_u.block<3, 3>(6, 0).diagonal().setConstant(dt22);
+
+  Jacobian<State, State> J_u_x = Jacobian<State, State>::Zero();
+  J_u_x.block<3, 3>(0, 3) = skew(accLin);
+  J_u_x.block<3, 3>(0, 6).diagonal().setConstant(dt);
+  J_u_x.block<3, 3>(6, 3) = skew(Rtg * dt);
+
+  EXPECT_EIGEN_NEAR(J_xnew_tau * J_u_x + J_xnew_x, F, 1e-14);
+  EXPECT_EIGEN_NEAR(J_xnew_tau * J_tau_u, W, 1e-14);
+}
+
+TEST(TEST_BLOCK_SPARSITY, TEST_LANDMARK_PATTERN)
+{
+  Eigen::Matrix3d R = Eigen::Matrix3d::Identity() * 0.01;
+  const MeasurementModel measurement_model(Landmark(2.0, 1.0, -0.5), R);
+
+  const Linearized<MeasurementModelBase<MeasurementModel>>& h =
+    measurement_model;
+  const LinearizedInvariant<MeasurementModelBase<MeasurementModel>>& hi =
+    measurement_model;
+
+  Jacobian<Measurement, State> H;
+  Jacobian<Measurement, Measurement> M;
+
+  h(State::Random(), H, M);
+  expectPattern<LandmarkSparsity>(H);
+
+  hi(State::Random(), H, M);
+  expectPattern<LandmarkInvariantSparsity>(H);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
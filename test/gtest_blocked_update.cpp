@@ -0,0 +1,192 @@
+/**
+ * \file gtest_blocked_update.cpp
+ *
+ * Check that the block-aware propagation and updates of the
+ * DynamicExtendedKalmanFilter match the dense ones.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using Pose = SE2d;
+using State = AugmentedState<Pose>;
+using SystemModel = AugmentedSystemModel<LieSystemModel<Pose>>;
+using LandmarkModel = AugmentedLandmarkMeasurementModel<State>;
+using Control = SystemModel::Control;
+using Landmark = State::Landmark;
+using Measurement = LandmarkModel::Measurement;
+
+using DEKF = DynamicExtendedKalmanFilter<State>;
+using Matrix = DEKF::Matrix;
+
+namespace kalmanif {
+
+/**
+ * @brief A model only exposing the dense jacobians of a wrapped model.
+ */
+template <typename Model>
+struct DenseSystemModel
+  : SystemModelBase<DenseSystemModel<Model>>
+  , Linearized<SystemModelBase<DenseSystemModel<Model>>> {
+
+  using Base = SystemModelBase<DenseSystemModel<Model>>;
+  using typename Base::State;
+  using typename Base::Control;
+  using Base::operator ();
+
+  DenseSystemModel(const Model& model) : model_(model) {}
+
+  State run(const State& x, const Control& u) const {
+    return model_(x, u);
+  }
+
+  State run_linearized(
+    const State& x,
+    const Control& u,
+    Eigen::Ref<Jacobian<State, State>> F,
+    Eigen::Ref<Jacobian<State, Control>> W
+  ) const {
+    return model_.run_linearized(x, u, F, W);
+  }
+
+  decltype(auto) getCovariance() const {
+    return model_.getCovariance();
+  }
+
+  const Model& model_;
+};
+
+template <typename Model>
+struct DenseMeasurementModel
+  : MeasurementModelBase<DenseMeasurementModel<Model>>
+  , Linearized<MeasurementModelBase<DenseMeasurementModel<Model>>> {
+
+  using Base = MeasurementModelBase<DenseMeasurementModel<Model>>;
+  using typename Base::State;
+  using typename Base::Measurement;
+  using Base::operator ();
+
+  DenseMeasurementModel(const Model& model) : model_(model) {}
+
+  Measurement run(const State& x) const {
+    return model_(x);
+  }
+
+  Measurement run_linearized(
+    const State& x,
+    Eigen::Ref<Jacobian<Measurement, State>> H,
+    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+  ) const {
+    return model_.run_linearized(x, H, V);
+  }
+
+  decltype(auto) getCovariance() const {
+    return model_.getCovariance();
+  }
+
+  const Model& model_;
+};
+
+namespace internal {
+
+template <typename Model>
+struct traits<DenseSystemModel<Model>> {
+  using State = typename traits<Model>::State;
+  using Control = typename traits<Model>::Control;
+};
+
+template <typename Model>
+struct traits<DenseMeasurementModel<Model>> {
+  using State = typename traits<Model>::State;
+  using Scalar = typename traits<Model>::Scalar;
+  using Measurement = typename traits<Model>::Measurement;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+TEST(TEST_BLOCKED_UPDATE, TEST_BLOCKED_MATCHES_DENSE)
+{
+  constexpr int num_landmarks = 50;
+  constexpr int n = Pose::DoF + num_landmarks * State::LandmarkDim;
+
+  LieSystemModel<Pose> pose_model;
+  pose_model.setCovariance(Covariance<Control>::Identity() * 1e-3);
+
+  const SystemModel f(pose_model);
+  const DenseSystemModel<SystemModel> f_dense(f);
+
+  Covariance<Measurement> R = Covariance<Measurement>::Identity() * 1e-2;
+
+  State x(Pose(0.1, -0.2, 0.3));
+  x.reserve(num_landmarks);
+
+  DEKF dekf(x, Covariance<Pose>::Identity() * 0.1, n, 2, 3);
+
+  // Landmarks correlated with the pose
+  Matrix G = Matrix::Zero(State::LandmarkDim, n);
+  G.leftCols(Pose::DoF) << 1, 0, 0.5,
+                           0, 1, -0.2;
+  const Covariance<Landmark> R_landmark = Covariance<Landmark>::Identity();
+
+  for (int i = 0; i < num_landmarks; ++i) {
+    dekf.addLandmark(
+      Landmark(std::cos(i), std::sin(i)) * (2 + i % 5),
+      G.leftCols(dekf.getState().dim()),
+      R_landmark
+    );
+  }
+
+  DEKF dekf_dense = dekf;
+
+  const Control u(0.1, 0.02, 0.05);
+
+  for (int k = 0; k < 20; ++k) {
+    dekf.propagate(f, u);
+    dekf_dense.propagate(f_dense, u);
+
+    // Observe a few landmarks
+    for (int i = k % 7; i < num_landmarks; i += 7) {
+      const LandmarkModel h(i, R);
+      const DenseMeasurementModel<LandmarkModel> h_dense(h);
+
+      const Measurement y = h(dekf.getState()) + Measurement(0.01, -0.02);
+
+      dekf.update(h, y);
+      dekf_dense.update(h_dense, y);
+    }
+  }
+
+  EXPECT_MANIF_NEAR(dekf_dense.getState().pose(), dekf.getState().pose());
+  EXPECT_EIGEN_NEAR(
+    dekf_dense.getState().landmarks(), dekf.getState().landmarks()
+  );
+  EXPECT_EIGEN_NEAR(dekf_dense.getCovariance(), dekf.getCovariance());
+
+  const Matrix P = dekf.getCovariance();
+  EXPECT_TRUE(P.isApprox(P.transpose()));
+  EXPECT_TRUE(isCovariance(P));
+}
+
+TEST(TEST_BLOCKED_UPDATE, TEST_TRAITS)
+{
+  EXPECT_TRUE(internal::has_pose_block_jacobian<SystemModel>{});
+  EXPECT_TRUE(internal::has_landmark_block_jacobian<LandmarkModel>{});
+  EXPECT_FALSE(
+    internal::has_pose_block_jacobian<DenseSystemModel<SystemModel>>{}
+  );
+  EXPECT_FALSE(
+    internal::has_landmark_block_jacobian<DenseMeasurementModel<LandmarkModel>>{}
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
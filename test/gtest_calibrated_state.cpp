@@ -0,0 +1,218 @@
+/**
+ * \file gtest_calibrated_state.cpp
+ *
+ * Check the DynamicExtendedKalmanFilter on a CalibratedState
+ * against dense reference steps, and that it estimates
+ * the calibration of a sensor.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using Pose = SE2d;
+using State = CalibratedState<Pose>;
+using PoseSystemModel = LieSystemModel<Pose>;
+using SensorModel = DummyGPSMeasurementModel<Pose>;
+using SystemModel = CalibratedSystemModel<PoseSystemModel>;
+using MeasurementModel = CalibratedMeasurementModel<SensorModel>;
+using BodyModel = CalibratedPoseMeasurementModel<SensorModel>;
+using Control = SystemModel::Control;
+using Measurement = MeasurementModel::Measurement;
+
+using DEKF = DynamicExtendedKalmanFilter<State>;
+
+using Matrix = DEKF::Matrix;
+using Vector = Eigen::VectorXd;
+
+class TEST_CALIBRATED_STATE : public testing::Test {
+protected:
+
+  void SetUp() override {
+    system_model.setCovariance(Covariance<Control>::Identity() * 1e-4);
+
+    x_init.addSensor(Pose(0.3, -0.2, 0.1));
+    x_init.addSensor(Pose(-0.1, 0.4, -0.3));
+
+    P_init = Matrix::Identity(x_init.dim(), x_init.dim()) * 1e-2;
+    P_init.bottomRightCorner(6, 6) *= 10;
+    P_init(0, 3) = P_init(3, 0) = 2e-3;
+  }
+
+  //! The dense jacobian of h at x, by finite differences
+  template <typename Model>
+  Matrix numericalJacobian(const Model& h, const State& x) const {
+    constexpr double eps = 1e-7;
+    const Measurement e = h(x);
+
+    Matrix H(Measurement::RowsAtCompileTime, x.dim());
+    for (int j = 0; j < x.dim(); ++j) {
+      State x_plus = x;
+      x_plus += Vector(Vector::Unit(x.dim(), j) * eps);
+      H.col(j) = (h(x_plus) - e) / eps;
+    }
+    return H;
+  }
+
+  PoseSystemModel system_model;
+  Covariance<Measurement> R = Covariance<Measurement>::Identity() * 1e-4;
+  SensorModel sensor_model = SensorModel(R);
+
+  State x_init = State(Pose(0.1, -0.2, 0.3));
+  Matrix P_init;
+};
+
+TEST_F(TEST_CALIBRATED_STATE, TEST_STATE)
+{
+  ASSERT_EQ(2, x_init.numSensors());
+  ASSERT_EQ(Pose::DoF * 3, x_init.dim());
+  EXPECT_EQ(Pose::DoF * 2, State::column(1));
+
+  Vector dx(x_init.dim());
+  dx << 0.1, 0.2, 0.3, 0.01, 0.02, 0.03, -0.1, 0, 0.2;
+
+  State x = x_init;
+  x += dx;
+
+  EXPECT_MANIF_NEAR(x_init.pose() + Pose::Tangent(dx.head<3>()), x.pose());
+  EXPECT_MANIF_NEAR(
+    x_init.calibration(0) + Pose::Tangent(dx.segment<3>(3)), x.calibration(0)
+  );
+  EXPECT_MANIF_NEAR(
+    x_init.calibration(1) + Pose::Tangent(dx.tail<3>()), x.calibration(1)
+  );
+}
+
+TEST_F(TEST_CALIBRATED_STATE, TEST_JACOBIANS)
+{
+  const MeasurementModel h(sensor_model, 1);
+
+  Matrix H(Measurement::RowsAtCompileTime, x_init.dim());
+  Jacobian<Measurement, Measurement> V;
+  const Linearized<MeasurementModelBase<MeasurementModel>>& h_lin = h;
+  const Measurement e = h_lin(x_init, H, V);
+
+  EXPECT_EIGEN_NEAR(h(x_init), e);
+  EXPECT_EIGEN_NEAR(numericalJacobian(h, x_init), H, 1e-5);
+
+  // The other sensor calibration is not observed
+  EXPECT_TRUE(H.middleCols(State::column(0), Pose::DoF).isZero());
+
+  const BodyModel h_body(sensor_model);
+
+  const Linearized<MeasurementModelBase<BodyModel>>& h_body_lin = h_body;
+  h_body_lin(x_init, H, V);
+
+  EXPECT_EIGEN_NEAR(numericalJacobian(h_body, x_init), H, 1e-5);
+  EXPECT_TRUE(H.rightCols(6).isZero());
+}
+
+TEST_F(TEST_CALIBRATED_STATE, TEST_IDENTITY_DYNAMICS)
+{
+  DEKF dekf(x_init, P_init, x_init.dim(), 2, 3);
+
+  const SystemModel f(system_model);
+  const Control u(0.1, 0.02, 0.05);
+
+  // Dense reference propagation
+  const int n = x_init.dim();
+  Matrix F(n, n);
+  Matrix W(n, Control::DoF);
+  const Linearized<SystemModelBase<SystemModel>>& f_lin = f;
+  const State x_ref = f_lin(x_init, u, F, W);
+
+  EXPECT_TRUE(F.bottomRightCorner(6, 6).isIdentity());
+  EXPECT_TRUE(F.topRightCorner(3, 6).isZero());
+
+  const Matrix P_ref =
+    F * P_init * F.transpose() +
+    W * system_model.getCovariance() * W.transpose();
+
+  dekf.propagate(f, u);
+
+  EXPECT_MANIF_NEAR(x_ref.pose(), dekf.getState().pose());
+  EXPECT_EIGEN_NEAR(P_ref, dekf.getCovariance());
+
+  // The calibrations and their covariance are left untouched
+  EXPECT_MANIF_NEAR(x_init.calibration(0), dekf.getState().calibration(0));
+  EXPECT_MANIF_NEAR(x_init.calibration(1), dekf.getState().calibration(1));
+  EXPECT_EIGEN_NEAR(
+    P_init.bottomRightCorner(6, 6), dekf.getCovariance().bottomRightCorner(6, 6)
+  );
+}
+
+TEST_F(TEST_CALIBRATED_STATE, TEST_BLOCK_UPDATE)
+{
+  DEKF dekf(x_init, P_init, x_init.dim(), 2, 3);
+
+  const int n = x_init.dim();
+
+  const MeasurementModel h(sensor_model, 1);
+  const Measurement y(0.05, 0.2);
+
+  // Dense reference update
+  Matrix H(Measurement::RowsAtCompileTime, n);
+  Jacobian<Measurement, Measurement> V;
+  const Linearized<MeasurementModelBase<MeasurementModel>>& h_lin = h;
+  const Measurement e = h_lin(x_init, H, V);
+
+  const Matrix S =
+    H * P_init * H.transpose() + V * h.getCovariance() * V.transpose();
+  const Matrix K = P_init * H.transpose() * S.inverse();
+  const Matrix P_ref = (Matrix::Identity(n, n) - K * H) * P_init;
+
+  State x_ref = x_init;
+  x_ref += Vector(K * (y - e));
+
+  dekf.update(h, y);
+
+  EXPECT_MANIF_NEAR(x_ref.pose(), dekf.getState().pose());
+  EXPECT_MANIF_NEAR(x_ref.calibration(0), dekf.getState().calibration(0));
+  EXPECT_MANIF_NEAR(x_ref.calibration(1), dekf.getState().calibration(1));
+  EXPECT_EIGEN_NEAR(P_ref, dekf.getCovariance());
+  EXPECT_TRUE(isCovariance(dekf.getCovariance()));
+}
+
+TEST_F(TEST_CALIBRATED_STATE, TEST_CALIBRATION)
+{
+  const Pose T_true(0.3, -0.2, 0.1);
+
+  // The initial calibration is off by 0.25 in translation
+  State x = State(x_init.pose());
+  x.addSensor(Pose(0.1, -0.05, 0.1));
+
+  Matrix P = Matrix::Identity(x.dim(), x.dim()) * 1e-4;
+  P.bottomRightCorner(3, 3) = Matrix::Identity(3, 3) * 0.1;
+
+  DEKF dekf(x, P, x.dim(), 2, 3);
+
+  const SystemModel f(system_model);
+  const MeasurementModel h(sensor_model, 0);
+  const BodyModel h_body(sensor_model);
+
+  const Control u(0.1, 0, 0.1);
+  Pose X_true = x_init.pose();
+
+  for (int i = 0; i < 100; ++i) {
+    X_true = X_true + u;
+    dekf.propagate(f, u);
+
+    dekf.update(h_body, Measurement(X_true.translation()));
+    dekf.update(h, Measurement(X_true.compose(T_true).translation()));
+  }
+
+  EXPECT_EIGEN_NEAR(
+    T_true.translation(), dekf.getState().calibration(0).translation(), 2e-2
+  );
+  EXPECT_TRUE(isCovariance(dekf.getCovariance()));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,216 @@
+/**
+ * \file gtest_checkpoint.cpp
+ *
+ * Check the filter checkpoints.
+ */
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/io/checkpoint.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <unistd.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using SEKF = SquareRootExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+using UKFM = UnscentedKalmanFilterManifolds<State>;
+using IKF = InformationKalmanFilter<State>;
+using ERTS = RauchTungStriebelSmoother<EKF>;
+
+class TEST_CHECKPOINT : public testing::Test {
+protected:
+
+  template <typename Filter>
+  void run(Filter& filter, const int epochs, const int offset = 0) const {
+    State X = X_init;
+    for (int k = offset; k < offset + epochs; ++k) {
+      X = X + u;
+      filter.propagate(system_model, u);
+      filter.update(
+        measurement_model,
+        measurement_model(X) + Measurement(0.01, -0.02) * (k % 3)
+      );
+    }
+  }
+
+  /**
+   * Checkpoint a filter, restore it in another one constructed elsewhere
+   * and check both estimate the same thereafter.
+   */
+  template <typename Filter>
+  void checkRoundTrip(const double tolerance = 1e-12) const {
+    Filter filter(X_init, P_init);
+    run(filter, 10);
+    // a pending propagation is saved too
+    filter.propagate(system_model, u);
+
+    const std::vector<std::uint8_t> checkpoint = saveCheckpoint(filter);
+    EXPECT_EQ(checkpointSize(filter), checkpoint.size());
+
+    const CheckpointView<Filter> view(checkpoint.data(), checkpoint.size());
+    EXPECT_MANIF_NEAR(filter.getState(), view.getState(), tolerance);
+    EXPECT_EIGEN_NEAR(filter.getCovariance(), view.getCovariance(), tolerance);
+
+    Filter restored(State::Identity(), StateCovariance::Identity());
+    loadCheckpoint(restored, checkpoint);
+
+    EXPECT_MANIF_NEAR(filter.getState(), restored.getState(), tolerance);
+    EXPECT_EIGEN_NEAR(
+      filter.getCovariance(), restored.getCovariance(), tolerance
+    );
+
+    run(filter, 5, 10);
+    run(restored, 5, 10);
+
+    EXPECT_MANIF_NEAR(filter.getState(), restored.getState(), tolerance);
+    EXPECT_EIGEN_NEAR(
+      filter.getCovariance(), restored.getCovariance(), tolerance
+    );
+  }
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+  Control u = Control(0.1, 0.0, 0.05);
+
+  State X_init = State(0.05, -0.05, 0.02);
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+};
+
+TEST_F(TEST_CHECKPOINT, TEST_EKF)
+{
+  checkRoundTrip<EKF>();
+}
+
+TEST_F(TEST_CHECKPOINT, TEST_SEKF)
+{
+  checkRoundTrip<SEKF>();
+}
+
+TEST_F(TEST_CHECKPOINT, TEST_IEKF)
+{
+  checkRoundTrip<IEKF>();
+}
+
+TEST_F(TEST_CHECKPOINT, TEST_UKFM)
+{
+  checkRoundTrip<UKFM>();
+}
+
+TEST_F(TEST_CHECKPOINT, TEST_IKF)
+{
+  // the information matrix is inverted on the way
+  checkRoundTrip<IKF>(1e-10);
+}
+
+TEST_F(TEST_CHECKPOINT, TEST_SMOOTHER)
+{
+  ERTS smoother(X_init, P_init);
+  run(smoother, 20);
+
+  const std::vector<std::uint8_t> checkpoint = saveCheckpoint(smoother);
+  EXPECT_EQ(
+    20u, CheckpointView<ERTS>(checkpoint.data(), checkpoint.size()).getEpochCount()
+  );
+
+  ERTS restored(State::Identity(), StateCovariance::Identity());
+  run(restored, 3);
+  loadCheckpoint(restored, checkpoint);
+
+  run(smoother, 5, 20);
+  run(restored, 5, 20);
+
+  const auto& Xs = smoother.smooth();
+  const auto& Xr = restored.smooth();
+
+  ASSERT_EQ(Xs.size(), Xr.size());
+  for (std::size_t k = 0; k < Xs.size(); ++k) {
+    EXPECT_MANIF_NEAR(Xs[k], Xr[k], 1e-12);
+    EXPECT_EIGEN_NEAR(
+      smoother.getCovariances()[k], restored.getCovariances()[k], 1e-12
+    );
+  }
+}
+
+TEST_F(TEST_CHECKPOINT, TEST_INVALID_CHECKPOINT)
+{
+  EKF ekf(X_init, P_init);
+  std::vector<std::uint8_t> checkpoint = saveCheckpoint(ekf);
+
+  IEKF iekf(X_init, P_init);
+  EXPECT_THROW(loadCheckpoint(iekf, checkpoint), kalmanif::invalid_argument);
+
+  ERTS smoother(X_init, P_init);
+  EXPECT_THROW(
+    loadCheckpoint(smoother, checkpoint), kalmanif::invalid_argument
+  );
+
+  EXPECT_THROW(
+    loadCheckpoint(ekf, checkpoint.data(), checkpoint.size() - 1),
+    kalmanif::invalid_argument
+  );
+  EXPECT_THROW(
+    loadCheckpoint(ekf, checkpoint.data(), 8), kalmanif::invalid_argument
+  );
+
+  checkpoint[0] = 'X';
+  EXPECT_THROW(loadCheckpoint(ekf, checkpoint), kalmanif::invalid_argument);
+}
+
+TEST_F(TEST_CHECKPOINT, TEST_MAPPED_CHECKPOINT)
+{
+  const std::string path = testing::TempDir() + "kalmanif_checkpoint";
+
+  ERTS smoother(X_init, P_init);
+  run(smoother, 10);
+  writeCheckpoint(path, smoother);
+
+  {
+    const MappedCheckpoint<ERTS> mapped(path);
+    EXPECT_EQ(10u, mapped.view().getEpochCount());
+    EXPECT_MANIF_NEAR(smoother.getState(), mapped.view().getState(), 1e-12);
+
+    ERTS restored(X_init, P_init);
+    mapped.restore(restored);
+
+    EXPECT_EQ(smoother.smooth().size(), restored.smooth().size());
+    EXPECT_MANIF_NEAR(
+      smoother.smooth().front(), restored.smooth().front(), 1e-12
+    );
+
+    // the checkpoint is replaced atomically, the mapping is left untouched
+    run(smoother, 5, 10);
+    writeCheckpoint(path, smoother, true);
+    EXPECT_EQ(10u, mapped.view().getEpochCount());
+    EXPECT_EQ(15u, MappedCheckpoint<ERTS>(path).view().getEpochCount());
+  }
+
+  EXPECT_THROW(
+    MappedCheckpoint<EKF>(path), kalmanif::invalid_argument
+  );
+  EXPECT_THROW(
+    MappedCheckpoint<EKF>("/nonexistent/directory/file"),
+    kalmanif::runtime_error
+  );
+
+  EXPECT_EQ(0, ::unlink(path.c_str()));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
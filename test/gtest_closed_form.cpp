@@ -0,0 +1,172 @@
+/**
+ * \file gtest_closed_form.cpp
+ *
+ * Check the closed-form kernels against the generic Eigen decompositions
+ * and their selection through the state traits.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/SE3.h>
+#include <manif/SO3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+template <typename MatrixType>
+class TEST_CLOSED_FORM_LLT : public testing::Test {
+protected:
+
+  using Scalar = typename MatrixType::Scalar;
+
+  static constexpr Scalar tol = std::is_same<Scalar, float>::value ?
+    Scalar(1e-4) : Scalar(1e-10);
+
+  TEST_CLOSED_FORM_LLT() {
+    const MatrixType B = MatrixType::Random();
+    A = B * B.transpose() + MatrixType::Identity() * Scalar(0.1);
+  }
+
+  MatrixType A;
+};
+
+using Matrices = testing::Types<
+  Eigen::Matrix<double, 1, 1>,
+  Eigen::Matrix2d,
+  Eigen::Matrix3d,
+  Eigen::Matrix2f,
+  Eigen::Matrix3f
+>;
+
+TYPED_TEST_SUITE(TEST_CLOSED_FORM_LLT, Matrices);
+
+TYPED_TEST(TEST_CLOSED_FORM_LLT, TEST_VS_EIGEN)
+{
+  using Scalar = typename TestFixture::Scalar;
+  constexpr int N = TypeParam::RowsAtCompileTime;
+
+  const internal::ClosedFormLLT<TypeParam> llt(this->A);
+  const Eigen::LLT<TypeParam> eigen_llt(this->A);
+
+  ASSERT_EQ(Eigen::Success, llt.info());
+
+  const TypeParam L = eigen_llt.matrixL();
+  EXPECT_EIGEN_NEAR(L, TypeParam(llt.matrixL()), this->tol);
+  EXPECT_EIGEN_NEAR(L, llt.matrixLLT(), this->tol);
+  EXPECT_EIGEN_NEAR(
+    TypeParam(L.transpose()), TypeParam(llt.matrixU()), this->tol
+  );
+  EXPECT_EIGEN_NEAR(this->A, llt.reconstructedMatrix(), this->tol);
+
+  using RightHandSide = Eigen::Matrix<Scalar, N, 4>;
+
+  const RightHandSide B = RightHandSide::Random();
+  EXPECT_EIGEN_NEAR(eigen_llt.solve(B), llt.solve(B), this->tol);
+
+  EXPECT_EIGEN_NEAR(
+    TypeParam(this->A * llt.inverse()), TypeParam::Identity(), this->tol
+  );
+}
+
+TYPED_TEST(TEST_CLOSED_FORM_LLT, TEST_NOT_POSITIVE_DEFINITE)
+{
+  using Scalar = typename TestFixture::Scalar;
+  using LLT = internal::ClosedFormLLT<TypeParam>;
+  constexpr int N = TypeParam::RowsAtCompileTime;
+
+  TypeParam A = this->A;
+  A(N - 1, N - 1) = -Scalar(1);
+  EXPECT_EQ(Eigen::NumericalIssue, LLT(A).info());
+
+  A(N - 1, N - 1) = std::numeric_limits<Scalar>::quiet_NaN();
+  EXPECT_EQ(Eigen::NumericalIssue, LLT(A).info());
+}
+
+TEST(TEST_CLOSED_FORM, TEST_SELECTION)
+{
+  static_assert(internal::has_closed_form_kernels<SE2d>::value, "");
+  static_assert(internal::has_closed_form_kernels<SO3d>::value, "");
+  static_assert(!internal::has_closed_form_kernels<SE3d>::value, "");
+
+  static_assert(
+    std::is_same<
+      internal::StateLLT<SE2d, Eigen::Matrix2d>,
+      internal::ClosedFormLLT<Eigen::Matrix2d>
+    >::value, ""
+  );
+  static_assert(
+    std::is_same<
+      internal::StateLLT<SE3d, Eigen::Matrix3d>,
+      Eigen::LLT<Eigen::Matrix3d>
+    >::value, ""
+  );
+  // Neither dynamic nor too large matrices
+  static_assert(
+    std::is_same<
+      internal::StateLLT<SE2d, Eigen::MatrixXd>,
+      Eigen::LLT<Eigen::MatrixXd>
+    >::value, ""
+  );
+  static_assert(
+    std::is_same<
+      internal::StateLLT<SE2d, Eigen::Matrix4d>,
+      Eigen::LLT<Eigen::Matrix4d>
+    >::value, ""
+  );
+}
+
+TEST(TEST_CLOSED_FORM, TEST_EIGEN)
+{
+  const Eigen::Matrix3d B = Eigen::Matrix3d::Random();
+  const Eigen::Matrix3d A = B * B.transpose();
+
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> closed_form, generic;
+  internal::computeEigen<SE2d>(closed_form, A);
+  internal::computeEigen<SE3d>(generic, A);
+
+  EXPECT_EIGEN_NEAR(generic.eigenvalues(), closed_form.eigenvalues(), 1e-8);
+
+  const Eigen::Matrix3d V = closed_form.eigenvectors();
+  EXPECT_EIGEN_NEAR(
+    A, V * closed_form.eigenvalues().asDiagonal() * V.transpose(), 1e-8
+  );
+}
+
+TEST(TEST_CLOSED_FORM, TEST_INNOVATION_DECOMPOSITION)
+{
+  using State = SE2d;
+  using MeasurementModel = Landmark2DMeasurementModel<State>;
+  using Landmark = MeasurementModel::Landmark;
+  using Measurement = MeasurementModel::Measurement;
+
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  const MeasurementModel measurement_model(Landmark(2.0, 1.0), R);
+
+  ExtendedKalmanFilter<State> filter(
+    State(0.15, -0.1, 0.1), Covariance<State>::Identity() * 0.1
+  );
+  filter.update(measurement_model, Measurement(0.8, 1.3));
+
+  // The decomposition set in closed form is a valid Eigen::LLT
+  const auto& S = filter.getInnovationDecomposition();
+  ASSERT_EQ(Eigen::Success, S.info());
+
+  const Eigen::LLT<Eigen::MatrixXd> llt(S.reconstructedMatrix());
+  EXPECT_EIGEN_NEAR(
+    Eigen::MatrixXd(llt.matrixL()), Eigen::MatrixXd(S.matrixL()), 1e-10
+  );
+  EXPECT_NEAR(llt.rcond(), S.rcond(), 1e-10);
+
+  const Eigen::VectorXd z = filter.getInnovation();
+  EXPECT_NEAR(
+    z.dot(llt.solve(z)), filter.getNormalizedInnovationSquared(), 1e-10
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,187 @@
+/**
+ * \file gtest_consistency_monitor.cpp
+ *
+ * Check the online NIS/NEES consistency monitor.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <random>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+
+TEST(TEST_CONSISTENCY_MONITOR, TEST_CHI_SQUARED_QUANTILE)
+{
+  // Tabulated values, the approximation is coarser for few dof
+  EXPECT_NEAR(9.210, internal::chiSquaredQuantile(0.99, 2), 0.1);
+  EXPECT_NEAR(0.216, internal::chiSquaredQuantile(0.025, 3), 0.05);
+  EXPECT_NEAR(20.48, internal::chiSquaredQuantile(0.975, 10), 0.05);
+  EXPECT_NEAR(349.87, internal::chiSquaredQuantile(0.975, 300), 0.1);
+}
+
+TEST(TEST_CONSISTENCY_MONITOR, TEST_WINDOW)
+{
+  ConsistencyTest test(3, 0.95);
+
+  EXPECT_EQ(0u, test.getStatistics().window);
+
+  for (int i = 1; i <= 5; ++i) {
+    test.add(i, i % 2 + 1);
+  }
+
+  const ConsistencyStatistics statistics = test.getStatistics();
+
+  EXPECT_EQ(5u, statistics.count);
+  EXPECT_DOUBLE_EQ(3., statistics.mean);
+  EXPECT_EQ(3u, statistics.window);
+  EXPECT_DOUBLE_EQ(4., statistics.window_mean);
+  EXPECT_DOUBLE_EQ(5. / 3., statistics.window_dof);
+  EXPECT_LT(statistics.lower, statistics.window_dof);
+  EXPECT_GT(statistics.upper, statistics.window_dof);
+
+  test.reset();
+  EXPECT_EQ(0u, test.getStatistics().count);
+
+  EXPECT_THROW(ConsistencyTest(0), kalmanif::invalid_argument);
+  EXPECT_THROW(ConsistencyTest(10, 1.), kalmanif::invalid_argument);
+}
+
+template <typename Filter>
+class TEST_CONSISTENCY_MONITOR_FILTER : public testing::Test {
+protected:
+
+  void propagate(Filter& filter) {
+    if constexpr (std::is_same<Filter, IEKF>::value) {
+      filter.propagate(system_model, u, 0.1);
+    } else {
+      filter.propagate(system_model, u);
+    }
+  }
+
+  /**
+   * @brief Run the filter on noisy data and monitor it
+   * @param noise_scale The scale of the simulated measurement noise
+   * w.r.t. the modeled one
+   */
+  ConsistencyMonitor run(const double noise_scale) {
+    std::mt19937 generator(42);
+    std::normal_distribution<double> n(0., 1.);
+
+    Filter filter(X_true, P_init);
+    ConsistencyMonitor monitor(200, 0.99);
+
+    for (int k = 0; k < 400; ++k) {
+      const Control w(
+        std::sqrt(q) * n(generator),
+        std::sqrt(q) * n(generator),
+        std::sqrt(q) * n(generator)
+      );
+      X_true = X_true + (u + w);
+      propagate(filter);
+
+      for (const auto& h : measurement_models) {
+        const Measurement v(n(generator), n(generator));
+        filter.update(
+          h, h(X_true) + noise_scale * std::sqrt(r) * v
+        );
+        monitor.addNIS(filter);
+      }
+
+      monitor.addNEES(filter, X_true);
+    }
+
+    return monitor;
+  }
+
+  double q = 1e-4, r = 1e-3;
+
+  SystemModel system_model{StateCovariance::Identity() * q};
+  Control u = Control(0.1, 0.0, 0.05);
+
+  Eigen::Matrix2d R = Eigen::Matrix2d::Identity() * r;
+  std::vector<MeasurementModel> measurement_models = {
+    MeasurementModel(Landmark(2.0,  0.0), R),
+    MeasurementModel(Landmark(2.0,  1.0), R),
+    MeasurementModel(Landmark(2.0, -1.0), R)
+  };
+
+  State X_true = State::Identity();
+  StateCovariance P_init = StateCovariance::Identity() * 1e-6;
+};
+
+using Filters = testing::Types<EKF, IEKF>;
+TYPED_TEST_SUITE(TEST_CONSISTENCY_MONITOR_FILTER, Filters);
+
+TYPED_TEST(TEST_CONSISTENCY_MONITOR_FILTER, TEST_READS_FILTER)
+{
+  TypeParam filter(this->X_true, StateCovariance::Identity() * 0.1);
+  filter.update(this->measurement_models[1], Measurement(1.9, 1.2));
+
+  ConsistencyMonitor monitor(10);
+  monitor.addNIS(filter);
+
+  const ConsistencyStatistics nis = monitor.getNIS();
+  EXPECT_EQ(1u, nis.count);
+  EXPECT_DOUBLE_EQ(filter.getNormalizedInnovationSquared(), nis.window_mean);
+  EXPECT_DOUBLE_EQ(2., nis.window_dof);
+
+  const State X_true(0.1, -0.1, 0.05);
+  monitor.addNEES(filter, X_true);
+
+  const Eigen::Vector3d e = internal::is_right_invariant<TypeParam>::value ?
+    filter.getState().lminus(X_true).coeffs() :
+    filter.getState().rminus(X_true).coeffs();
+
+  EXPECT_NEAR(
+    e.dot(filter.getCovariance().ldlt().solve(e)),
+    monitor.getNEES().window_mean,
+    1e-9
+  );
+  EXPECT_DOUBLE_EQ(3., monitor.getNEES().window_dof);
+}
+
+TYPED_TEST(TEST_CONSISTENCY_MONITOR_FILTER, TEST_CONSISTENT)
+{
+  const ConsistencyMonitor monitor = this->run(1.);
+
+  const ConsistencyStatistics nis = monitor.getNIS();
+  EXPECT_EQ(1200u, nis.count);
+  EXPECT_EQ(200u, nis.window);
+  EXPECT_NEAR(2., nis.mean, 0.3);
+  EXPECT_TRUE(nis.isConsistent());
+
+  const ConsistencyStatistics nees = monitor.getNEES();
+  EXPECT_EQ(400u, nees.count);
+  EXPECT_NEAR(3., nees.mean, 1.);
+}
+
+TYPED_TEST(TEST_CONSISTENCY_MONITOR_FILTER, TEST_INCONSISTENT)
+{
+  // The measurements are much noisier than modeled
+  const ConsistencyMonitor monitor = this->run(5.);
+
+  const ConsistencyStatistics nis = monitor.getNIS();
+  EXPECT_GT(nis.window_mean, nis.upper);
+  EXPECT_FALSE(nis.isConsistent());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+/**
+ * \file gtest_covariance_intersection.cpp
+ *
+ * Check the covariance intersection fusion of estimates
+ * and their compact wire format.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SE2Estimate = Estimate<State>;
+
+class TEST_COVARIANCE_INTERSECTION : public testing::Test {
+protected:
+
+  void SetUp() override {
+    a.state = State(0.1, -0.2, 0.3);
+    a.covariance << 0.1,  0.02, 0.01,
+                    0.02, 0.2, -0.03,
+                    0.01, -0.03, 0.05;
+
+    b.state = State(0.15, -0.1, 0.25);
+    b.covariance << 0.3, 0.0, 0.0,
+                    0.0, 0.05, 0.01,
+                    0.0, 0.01, 0.02;
+  }
+
+  SE2Estimate a;
+  SE2Estimate b;
+};
+
+TEST_F(TEST_COVARIANCE_INTERSECTION, TEST_SAME_ESTIMATE)
+{
+  const SE2Estimate fused = covarianceIntersection(a, a);
+
+  EXPECT_MANIF_NEAR(a.state, fused.state);
+  EXPECT_EIGEN_NEAR(a.covariance, fused.covariance);
+}
+
+TEST_F(TEST_COVARIANCE_INTERSECTION, TEST_FAST_WEIGHT)
+{
+  const StateCovariance I_a = a.covariance.inverse();
+  const StateCovariance I_b = b.covariance.inverse();
+
+  const double w = fastIntersectionWeight(I_a, I_b);
+
+  EXPECT_LT(0, w);
+  EXPECT_GT(1, w);
+  EXPECT_NEAR(1 - w, fastIntersectionWeight(I_b, I_a), 1e-12);
+  EXPECT_NEAR(0.5, fastIntersectionWeight(I_a, I_a), 1e-12);
+
+  // The more informative estimate weighs more
+  EXPECT_LT(0.5, fastIntersectionWeight(I_a, StateCovariance(I_a * 0.1)));
+}
+
+TEST_F(TEST_COVARIANCE_INTERSECTION, TEST_CONSISTENT)
+{
+  const SE2Estimate fused = covarianceIntersection(a, b);
+
+  // The fused estimate lies between a and b
+  const double d_ab = (b.state - a.state).coeffs().norm();
+  EXPECT_GT(d_ab, (fused.state - a.state).coeffs().norm());
+  EXPECT_GT(d_ab, (b.state - fused.state).coeffs().norm());
+
+  // CI never claims more information than the independent fusion
+  const StateCovariance P_kf =
+    (a.covariance.inverse() + b.covariance.inverse()).inverse();
+
+  EXPECT_LT(P_kf.trace(), fused.covariance.trace());
+  EXPECT_TRUE(isCovariance(fused.covariance));
+
+  EXPECT_THROW(covarianceIntersection(a, b, 1.5), kalmanif::invalid_argument);
+}
+
+TEST_F(TEST_COVARIANCE_INTERSECTION, TEST_SPLIT)
+{
+  const StateCovariance zero = StateCovariance::Zero();
+
+  // Fully dependent, split CI is CI
+  const SE2Estimate ci = covarianceIntersection(a, b, 0.3);
+  const SplitEstimate<State> split_ci =
+    splitCovarianceIntersection(a, zero, b, zero, 0.3);
+
+  EXPECT_MANIF_NEAR(ci.state, split_ci.state);
+  EXPECT_EIGEN_NEAR(ci.covariance, split_ci.covariance);
+  EXPECT_EIGEN_NEAR(zero, split_ci.independent);
+
+  // Fully independent, split CI is the independent fusion
+  const SplitEstimate<State> split_kf =
+    splitCovarianceIntersection(a, a.covariance, b, b.covariance);
+
+  EXPECT_EIGEN_NEAR(split_kf.covariance, split_kf.independent);
+  EXPECT_LT(split_kf.covariance.trace(), ci.covariance.trace());
+
+  EXPECT_THROW(
+    splitCovarianceIntersection(a, zero, b, zero, 1.),
+    kalmanif::invalid_argument
+  );
+}
+
+TEST_F(TEST_COVARIANCE_INTERSECTION, TEST_WIRE_FORMAT)
+{
+  static_assert(
+    sizeof(EncodedEstimate<State>) == (State::RepSize + 6) * sizeof(double),
+    "Unexpected encoded estimate size."
+  );
+
+  const EncodedEstimate<State> buffer = encodeEstimate(a);
+  const SE2Estimate decoded = decodeEstimate<State>(buffer);
+
+  EXPECT_TRUE(a.state.coeffs() == decoded.state.coeffs());
+  EXPECT_TRUE(a.covariance == decoded.covariance);
+
+  EXPECT_THROW(
+    decodeEstimate<State>(buffer.data(), buffer.size() - 1),
+    kalmanif::invalid_argument
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,115 @@
+/**
+ * \file gtest_covariance_product.cpp
+ *
+ * Check the symmetric covariance products.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+using IRTS = RauchTungStriebelSmoother<IEKF>;
+
+template <typename Matrix>
+void checkProducts(const int n) {
+  const Matrix A = Matrix::Random(n, n);
+  const Matrix B = Matrix::Random(n, n);
+  Matrix P = Matrix::Random(n, n);
+  P = (P * P.transpose()).eval();
+  Matrix Q = Matrix::Random(n, n);
+  Q = (Q * Q.transpose()).eval();
+
+  const Matrix APAt = A * P * A.transpose();
+
+  const Matrix C2 = internal::covarianceProduct(A, P);
+  const Matrix C3 = internal::covarianceProduct(A, P, Q);
+  const Matrix C4 = internal::covarianceProduct(A, P, B, Q);
+
+  EXPECT_EIGEN_NEAR(APAt, C2, 1e-12);
+  EXPECT_EIGEN_NEAR(Matrix(APAt + Q), C3, 1e-12);
+  EXPECT_EIGEN_NEAR(Matrix(APAt + B * Q * B.transpose()), C4, 1e-12);
+
+  // exactly symmetric
+  EXPECT_TRUE(C2 == C2.transpose());
+  EXPECT_TRUE(C3 == C3.transpose());
+  EXPECT_TRUE(C4 == C4.transpose());
+}
+
+TEST(TEST_COVARIANCE_PRODUCT, TEST_FIXED_SIZE)
+{
+  checkProducts<Eigen::Matrix3d>(3);
+  checkProducts<Eigen::Matrix<double, 9, 9>>(9);
+}
+
+TEST(TEST_COVARIANCE_PRODUCT, TEST_DYNAMIC_SIZE)
+{
+  // both the full and lower triangular products
+  checkProducts<Eigen::MatrixXd>(internal::SymmetricProductMinSize - 1);
+  checkProducts<Eigen::MatrixXd>(internal::SymmetricProductMinSize + 6);
+}
+
+TEST(TEST_COVARIANCE_PRODUCT, TEST_RECTANGULAR)
+{
+  // e.g. an innovation covariance H.P.H^T + R
+  const Eigen::Matrix<double, 2, 3> H = Eigen::Matrix<double, 2, 3>::Random();
+  Eigen::Matrix3d P = Eigen::Matrix3d::Random();
+  P = (P * P.transpose()).eval();
+  const Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+
+  const Eigen::Matrix2d S = internal::covarianceProduct(H, P, R);
+
+  EXPECT_EIGEN_NEAR(Eigen::Matrix2d(H * P * H.transpose() + R), S, 1e-14);
+  EXPECT_TRUE(S == S.transpose());
+}
+
+TEST(TEST_COVARIANCE_PRODUCT, TEST_FILTERS_SYMMETRIC)
+{
+  SystemModel system_model(StateCovariance::Identity() * 1e-3);
+  Eigen::Matrix2d R = (Eigen::Matrix2d() << 1e-2, 2e-3, 2e-3, 2e-2).finished();
+  MeasurementModel measurement_model(Landmark(2.0, 1.0), R);
+
+  const State X_init(0.05, -0.05, 0.02);
+  StateCovariance P_init = StateCovariance::Random();
+  P_init = 0.1 * P_init * P_init.transpose() + 0.01 * StateCovariance::Identity();
+
+  EKF ekf(X_init, P_init);
+  IRTS smoother(X_init, P_init);
+
+  const Control u(0.1, 0.0, 0.05);
+  for (int k = 0; k < 20; ++k) {
+    ekf.propagate(system_model, u);
+    smoother.propagate(system_model, u);
+    EXPECT_TRUE(ekf.getCovariance() == ekf.getCovariance().transpose());
+
+    const Measurement y =
+      measurement_model(ekf.getState()) + Measurement(0.01, -0.02) * (k % 3);
+    ekf.update(measurement_model, y);
+    smoother.update(measurement_model, y);
+    EXPECT_TRUE(ekf.getCovariance() == ekf.getCovariance().transpose());
+  }
+
+  smoother.smooth();
+  for (const auto& P : smoother.getCovariances()) {
+    EXPECT_TRUE(P == P.transpose());
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,99 @@
+/**
+ * \file gtest_covariance_repair.cpp
+ *
+ * Check the bounded covariance repair strategies.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <limits>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+
+TEST(TEST_COVARIANCE_REPAIR, TEST_NONE)
+{
+  const StateCovariance P = (StateCovariance() << 0.1,  0.02, 0.01,
+                                                  0.02, 0.2,  0.03,
+                                                  0.01, 0.03, 0.05).finished();
+
+  StateCovariance P_repaired = P;
+  Eigen::LLT<StateCovariance> llt;
+
+  EXPECT_EQ(CovarianceRepair::None, repairCovariance(P_repaired, llt));
+  EXPECT_EIGEN_NEAR(P, P_repaired);
+  EXPECT_EIGEN_NEAR(P, llt.reconstructedMatrix());
+}
+
+TEST(TEST_COVARIANCE_REPAIR, TEST_JITTER)
+{
+  StateCovariance P = Eigen::Vector3d(0.1, -1e-12, 0.1).asDiagonal();
+
+  Eigen::LLT<StateCovariance> llt;
+
+  EXPECT_EQ(CovarianceRepair::Jitter, repairCovariance(P, llt));
+  EXPECT_TRUE(isCovariance(P, Validation::Cheap));
+  EXPECT_EIGEN_NEAR(P, llt.reconstructedMatrix());
+  EXPECT_NEAR(0.1, P(0, 0), 1e-6);
+}
+
+TEST(TEST_COVARIANCE_REPAIR, TEST_EIGEN)
+{
+  StateCovariance P = Eigen::Vector3d(0.1, -1., 0.1).asDiagonal();
+
+  Eigen::LLT<StateCovariance> llt;
+
+  EXPECT_EQ(CovarianceRepair::Eigen, repairCovariance(P, llt));
+  EXPECT_TRUE(isCovariance(P, Validation::Cheap));
+  EXPECT_EIGEN_NEAR(P, llt.reconstructedMatrix());
+  EXPECT_NEAR(0.1, P(0, 0), 1e-8);
+  EXPECT_NEAR(1e-8, P(1, 1), 1e-12);
+}
+
+TEST(TEST_COVARIANCE_REPAIR, TEST_FAILED)
+{
+  StateCovariance P = StateCovariance::Identity();
+  P(1, 1) = std::numeric_limits<double>::quiet_NaN();
+
+  EXPECT_EQ(CovarianceRepair::Failed, repairCovariance(P));
+}
+
+TEST(TEST_COVARIANCE_REPAIR, TEST_ENFORCE_BOUNDED)
+{
+  StateCovariance P = Eigen::Vector3d(0.1, -1., 0.1).asDiagonal();
+
+  EXPECT_TRUE(enforcePositiveDefinite(P, 1e-8, 1));
+  EXPECT_TRUE(isCovariance(P, Validation::Cheap));
+}
+
+TEST(TEST_COVARIANCE_REPAIR, TEST_UKFM_COUNT)
+{
+  using SystemModel = LieSystemModel<State>;
+
+  UnscentedKalmanFilterManifolds<State> ukfm(
+    State(0.15, -0.1, 0.1), StateCovariance::Identity() * 0.1
+  );
+
+  EXPECT_EQ(0u, ukfm.getCovarianceRepairCount());
+
+  ukfm.propagate(
+    SystemModel(StateCovariance::Identity() * 1e-3),
+    SystemModel::Control(0.1, 0., 0.05)
+  );
+
+  EXPECT_EQ(CovarianceRepair::None, ukfm.getLastCovarianceRepair());
+  EXPECT_EQ(0u, ukfm.getCovarianceRepairCount());
+  EXPECT_TRUE(isCovariance(ukfm.getCovariance(), Validation::Cheap));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
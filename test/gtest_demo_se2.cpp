@@ -7,6 +7,7 @@
 
 #include <kalmanif/kalmanif.h>
 #include "../examples/utils/rand.h"
+#include "perf_recorder.h"
 
 #include <manif/SE2.h>
 #include <manif/gtest/gtest_manif_utils.h>
@@ -31,6 +32,8 @@ using UKFM = UnscentedKalmanFilterManifolds<State>;
 
 TEST(TEST_DEMO_SE2, TEST_DEMO_SE2)
 {
+  KALMANIF_PERF_SCENARIO("demo_se2");
+
   // START CONFIGURATION
 
   constexpr double dt = 0.01;                 // s
@@ -147,13 +150,13 @@ TEST(TEST_DEMO_SE2, TEST_DEMO_SE2)
 
     /// First we move
 
-    ekf.propagate(system_model, u_est);
+    KALMANIF_PERF(ekf, ekf.propagate(system_model, u_est));
 
-    sekf.propagate(system_model, u_est);
+    KALMANIF_PERF(sekf, sekf.propagate(system_model, u_est));
 
-    iekf.propagate(system_model, u_est, dt);
+    KALMANIF_PERF(iekf, iekf.propagate(system_model, u_est, dt));
 
-    ukfm.propagate(system_model, u_est);
+    KALMANIF_PERF(ukfm, ukfm.propagate(system_model, u_est));
 
     /// Then we correct using the measurements of each lmk
 
@@ -167,13 +170,13 @@ TEST(TEST_DEMO_SE2, TEST_DEMO_SE2)
         y = measurements[i];
 
         // filter update
-        ekf.update(measurement_model, y);
+        KALMANIF_PERF(ekf, ekf.update(measurement_model, y));
 
-        sekf.update(measurement_model, y);
+        KALMANIF_PERF(sekf, sekf.update(measurement_model, y));
 
-        iekf.update(measurement_model, y);
+        KALMANIF_PERF(iekf, iekf.update(measurement_model, y));
 
-        ukfm.update(measurement_model, y);
+        KALMANIF_PERF(ukfm, ukfm.update(measurement_model, y));
 
       }
     }
@@ -191,13 +194,13 @@ TEST(TEST_DEMO_SE2, TEST_DEMO_SE2)
       y_gps = y_gps + y_gps_noise;                                  // gps measurement, noisy
 
       // filter update
-      ekf.update(gps_measurement_model, y_gps);
+      KALMANIF_PERF(ekf, ekf.update(gps_measurement_model, y_gps));
 
-      sekf.update(gps_measurement_model, y_gps);
+      KALMANIF_PERF(sekf, sekf.update(gps_measurement_model, y_gps));
 
-      iekf.update(gps_measurement_model, y_gps);
+      KALMANIF_PERF(iekf, iekf.update(gps_measurement_model, y_gps));
 
-      ukfm.update(gps_measurement_model, y_gps);
+      KALMANIF_PERF(ukfm, ukfm.update(gps_measurement_model, y_gps));
     }
 
     //// III. Next iteration
@@ -206,6 +209,8 @@ TEST(TEST_DEMO_SE2, TEST_DEMO_SE2)
              0.0,
              std::exp(-0.03 * (t)) * std::cos(t);
 
+    KALMANIF_PERF_STEP();
+
     //// IV. Results
 
     EXPECT_MANIF_NEAR(X_simulation, ekf.getState(), 5e-1);
@@ -213,6 +218,8 @@ TEST(TEST_DEMO_SE2, TEST_DEMO_SE2)
     EXPECT_MANIF_NEAR(X_simulation, iekf.getState(), 5e-1);
     EXPECT_MANIF_NEAR(X_simulation, ukfm.getState(), 5e-1);
   }
+
+  KALMANIF_PERF_CHECK();
 }
 
 int main(int argc, char** argv)
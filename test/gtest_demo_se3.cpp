@@ -7,6 +7,7 @@
 
 #include <kalmanif/kalmanif.h>
 #include "../examples/utils/rand.h"
+#include "perf_recorder.h"
 
 #include <manif/SE3.h>
 #include <manif/gtest/gtest_manif_utils.h>
@@ -34,6 +35,8 @@ using UKFM = UnscentedKalmanFilterManifolds<State>;
 
 TEST(TEST_DEMO_SE3, TEST_DEMO_SE3)
 {
+  KALMANIF_PERF_SCENARIO("demo_se3");
+
   // START CONFIGURATION
 
   constexpr double dt = 0.01;                 // s
@@ -147,13 +150,13 @@ TEST(TEST_DEMO_SE3, TEST_DEMO_SE3)
 
     /// First we move
 
-    ekf.propagate(system_model, u_est);
+    KALMANIF_PERF(ekf, ekf.propagate(system_model, u_est));
 
-    sekf.propagate(system_model, u_est);
+    KALMANIF_PERF(sekf, sekf.propagate(system_model, u_est));
 
-    iekf.propagate(system_model, u_est, dt);
+    KALMANIF_PERF(iekf, iekf.propagate(system_model, u_est, dt));
 
-    ukfm.propagate(system_model, u_est);
+    KALMANIF_PERF(ukfm, ukfm.propagate(system_model, u_est));
 
     /// Then we correct using the measurements of each lmk
 
@@ -166,13 +169,13 @@ TEST(TEST_DEMO_SE3, TEST_DEMO_SE3)
         y = measurements[i];
 
         // filter update
-        ekf.update(measurement_model, y);
+        KALMANIF_PERF(ekf, ekf.update(measurement_model, y));
 
-        sekf.update(measurement_model, y);
+        KALMANIF_PERF(sekf, sekf.update(measurement_model, y));
 
-        iekf.update(measurement_model, y);
+        KALMANIF_PERF(iekf, iekf.update(measurement_model, y));
 
-        ukfm.update(measurement_model, y);
+        KALMANIF_PERF(ukfm, ukfm.update(measurement_model, y));
       }
     }
 
@@ -188,15 +191,17 @@ TEST(TEST_DEMO_SE3, TEST_DEMO_SE3)
       y_gps = y_gps + y_gps_noise;                                  // gps measurement, noisy
 
       // filter update
-      ekf.update(gps_measurement_model, y_gps);
+      KALMANIF_PERF(ekf, ekf.update(gps_measurement_model, y_gps));
 
-      sekf.update(gps_measurement_model, y_gps);
+      KALMANIF_PERF(sekf, sekf.update(gps_measurement_model, y_gps));
 
-      iekf.update(gps_measurement_model, y_gps);
+      KALMANIF_PERF(iekf, iekf.update(gps_measurement_model, y_gps));
 
-      ukfm.update(gps_measurement_model, y_gps);
+      KALMANIF_PERF(ukfm, ukfm.update(gps_measurement_model, y_gps));
     }
 
+    KALMANIF_PERF_STEP();
+
     //// III. Results
 
     EXPECT_MANIF_NEAR(X_simulation, ekf.getState(), 5e-1);
@@ -204,6 +209,8 @@ TEST(TEST_DEMO_SE3, TEST_DEMO_SE3)
     EXPECT_MANIF_NEAR(X_simulation, iekf.getState(), 5e-1);
     EXPECT_MANIF_NEAR(X_simulation, ukfm.getState(), 5e-1);
   }
+
+  KALMANIF_PERF_CHECK();
 }
 
 int main(int argc, char** argv)
@@ -8,6 +8,7 @@
 #include <kalmanif/kalmanif.h>
 #include <kalmanif/system_models/simple_imu_system_model.h>
 #include "../examples/utils/rand.h"
+#include "perf_recorder.h"
 
 #include <manif/SE_2_3.h>
 #include <manif/gtest/gtest_manif_utils.h>
@@ -37,6 +38,8 @@ using UKFM = UnscentedKalmanFilterManifolds<State>;
 
 TEST(TEST_DEMO_SE_2_3, TEST_DEMO_SE_2_3)
 {
+  KALMANIF_PERF_SCENARIO("demo_se_2_3");
+
   // START CONFIGURATION
 
   constexpr int control_freq = 100;           // Hz
@@ -154,13 +157,13 @@ TEST(TEST_DEMO_SE_2_3, TEST_DEMO_SE_2_3)
 
     /// First we move
 
-    ekf.propagate(system_model, u_est, dt);
+    KALMANIF_PERF(ekf, ekf.propagate(system_model, u_est, dt));
 
-    sekf.propagate(system_model, u_est, dt);
+    KALMANIF_PERF(sekf, sekf.propagate(system_model, u_est, dt));
 
-    iekf.propagate(system_model, u_est, dt);
+    KALMANIF_PERF(iekf, iekf.propagate(system_model, u_est, dt));
 
-    ukfm.propagate(system_model, u_est, dt);
+    KALMANIF_PERF(ukfm, ukfm.propagate(system_model, u_est, dt));
 
     /// Then we correct using the measurements of each lmk
 
@@ -173,19 +176,21 @@ TEST(TEST_DEMO_SE_2_3, TEST_DEMO_SE_2_3)
         y = measurements[i];
 
         // filter update
-        ekf.update(measurement_model, y);
+        KALMANIF_PERF(ekf, ekf.update(measurement_model, y));
 
-        sekf.update(measurement_model, y);
+        KALMANIF_PERF(sekf, sekf.update(measurement_model, y));
 
-        iekf.update(measurement_model, y);
+        KALMANIF_PERF(iekf, iekf.update(measurement_model, y));
 
-        ukfm.update(measurement_model, y);
+        KALMANIF_PERF(ukfm, ukfm.update(measurement_model, y));
       }
     }
 
     alpha_prev = alpha;
     omega_prev = omega;
 
+    KALMANIF_PERF_STEP();
+
     //// III. Results
 
     EXPECT_MANIF_NEAR(X_simulation, ekf.getState(), 5e-1);
@@ -193,6 +198,8 @@ TEST(TEST_DEMO_SE_2_3, TEST_DEMO_SE_2_3)
     EXPECT_MANIF_NEAR(X_simulation, iekf.getState(), 5e-1);
     EXPECT_MANIF_NEAR(X_simulation, ukfm.getState(), 1);
   }
+
+  KALMANIF_PERF_CHECK();
 }
 
 int main(int argc, char** argv)
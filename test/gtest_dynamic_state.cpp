@@ -0,0 +1,237 @@
+/**
+ * \file gtest_dynamic_state.cpp
+ *
+ * Check the DynamicExtendedKalmanFilter on an AugmentedState
+ * against the fixed-size EKF and a dense reference update,
+ * and that its storage does not move within its capacity.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using Pose = SE2d;
+using State = AugmentedState<Pose>;
+using PoseSystemModel = LieSystemModel<Pose>;
+using PoseMeasurementModel = DummyGPSMeasurementModel<Pose>;
+using SystemModel = AugmentedSystemModel<PoseSystemModel>;
+using MeasurementModel = AugmentedMeasurementModel<PoseMeasurementModel>;
+using LandmarkModel = AugmentedLandmarkMeasurementModel<State>;
+using Control = SystemModel::Control;
+using Landmark = State::Landmark;
+using Measurement = LandmarkModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<Pose>;
+using DEKF = DynamicExtendedKalmanFilter<State>;
+
+using Matrix = DEKF::Matrix;
+
+class TEST_DYNAMIC_STATE : public testing::Test {
+protected:
+
+  void SetUp() override {
+    system_model.setCovariance(Covariance<Control>::Identity() * 1e-3);
+    R_landmark = Covariance<Landmark>::Identity() * 0.5;
+    G_pose << 1, 0, 0.5,
+              0, 1, -0.2;
+  }
+
+  //! Add a landmark initialized from the pose with jacobian G_pose
+  void addLandmark(const Landmark& landmark, const bool correlated = true) {
+    Matrix G = Matrix::Zero(State::LandmarkDim, dekf.getState().dim());
+    if (correlated) {
+      G.leftCols(Pose::DoF) = G_pose;
+    }
+    dekf.addLandmark(landmark, G, R_landmark);
+  }
+
+  const Pose X_init = Pose(0.1, -0.2, 0.3);
+  const Covariance<Pose> P_init = Covariance<Pose>::Identity() * 0.1;
+
+  static constexpr int capacity = Pose::DoF + 4 * State::LandmarkDim;
+
+  PoseSystemModel system_model;
+  Covariance<Measurement> R = Covariance<Measurement>::Identity() * 1e-2;
+  PoseMeasurementModel gps_model = PoseMeasurementModel(R);
+  Covariance<Landmark> R_landmark;
+  Jacobian<Landmark, Pose> G_pose;
+
+  DEKF dekf = DEKF(State(X_init), P_init, capacity, 2, 3);
+};
+
+TEST_F(TEST_DYNAMIC_STATE, TEST_POSE_ONLY_MATCHES_EKF)
+{
+  EKF ekf(X_init, P_init);
+
+  addLandmark(Landmark(2, 1), false);
+  addLandmark(Landmark(-1, 3), false);
+
+  ASSERT_EQ(Pose::DoF + 4, dekf.getState().dim());
+
+  const SystemModel f(system_model);
+  const MeasurementModel h(gps_model);
+
+  const Control u(0.1, 0.02, 0.05);
+
+  for (int i = 0; i < 10; ++i) {
+    ekf.propagate(system_model, u);
+    dekf.propagate(f, u);
+
+    const Measurement y(0.1 * i, 0.02 * i);
+    ekf.update(gps_model, y);
+    dekf.update(h, y);
+  }
+
+  EXPECT_MANIF_NEAR(ekf.getState(), dekf.getState().pose());
+  EXPECT_EIGEN_NEAR(
+    ekf.getCovariance(),
+    dekf.getCovariance().topLeftCorner(Pose::DoF, Pose::DoF)
+  );
+
+  // The independent landmarks are left untouched
+  EXPECT_EIGEN_NEAR(Landmark(2, 1), dekf.getState().landmark(0));
+  EXPECT_EIGEN_NEAR(Landmark(-1, 3), dekf.getState().landmark(1));
+  EXPECT_EIGEN_NEAR(R_landmark, dekf.getCovariance().block(3, 3, 2, 2));
+  EXPECT_TRUE(dekf.getCovariance().topRightCorner(3, 4).isZero());
+}
+
+TEST_F(TEST_DYNAMIC_STATE, TEST_LANDMARK_UPDATE)
+{
+  // Landmarks initialized from the pose, correlated with it
+  addLandmark(Landmark(2, 1));
+  addLandmark(Landmark(-1, 3));
+
+  const int n = dekf.getState().dim();
+
+  const LandmarkModel h(1, R);
+  const Measurement y(-1.2, 3.1);
+
+  // Dense reference update
+  const State x = dekf.getState();
+  const Matrix P = dekf.getCovariance();
+
+  Matrix H(Measurement::RowsAtCompileTime, n);
+  Jacobian<Measurement, Measurement> V;
+  const Linearized<MeasurementModelBase<LandmarkModel>>& h_lin = h;
+  const Measurement e = h_lin(x, H, V);
+
+  EXPECT_TRUE(H.middleCols(Pose::DoF, State::LandmarkDim).isZero());
+
+  const Matrix S = H * P * H.transpose() + V * h.getCovariance() * V.transpose();
+  const Matrix K = P * H.transpose() * S.inverse();
+  const Matrix IKH = Matrix::Identity(n, n) - K * H;
+  const Matrix P_ref = IKH * P;
+
+  State x_ref = x;
+  x_ref += K * (y - e);
+
+  dekf.update(h, y);
+
+  EXPECT_MANIF_NEAR(x_ref.pose(), dekf.getState().pose());
+  EXPECT_EIGEN_NEAR(x_ref.landmarks(), dekf.getState().landmarks());
+  EXPECT_EIGEN_NEAR(P_ref, dekf.getCovariance());
+  EXPECT_TRUE(isCovariance(dekf.getCovariance()));
+  EXPECT_LT(dekf.getCovariance().trace(), P.trace());
+}
+
+TEST_F(TEST_DYNAMIC_STATE, TEST_REMOVE_LANDMARK)
+{
+  addLandmark(Landmark(2, 1));
+  addLandmark(Landmark(-1, 3));
+  addLandmark(Landmark(4, -2));
+
+  const Matrix P = dekf.getCovariance();
+
+  dekf.removeLandmark(1);
+
+  ASSERT_EQ(Pose::DoF + 4, dekf.getState().dim());
+  EXPECT_EIGEN_NEAR(Landmark(2, 1), dekf.getState().landmark(0));
+  EXPECT_EIGEN_NEAR(Landmark(4, -2), dekf.getState().landmark(1));
+
+  // P without the rows and columns 5 & 6
+  Matrix P_ref(7, 7);
+  P_ref << P.topLeftCorner(5, 5), P.topRightCorner(5, 2),
+           P.bottomLeftCorner(2, 5), P.bottomRightCorner(2, 2);
+
+  EXPECT_EIGEN_NEAR(P_ref, dekf.getCovariance());
+}
+
+TEST_F(TEST_DYNAMIC_STATE, TEST_NO_REALLOCATION)
+{
+  const SystemModel f(system_model);
+  const LandmarkModel h(0, R);
+
+  addLandmark(Landmark(2, 1));
+
+  const double* P_data = dekf.getCovariance().data();
+
+  for (int i = 0; i < 3; ++i) {
+    addLandmark(Landmark(i, 1));
+    dekf.propagate(f, Control(0.1, 0, 0.05));
+    dekf.update(h, Measurement(1.9, 1.1));
+  }
+
+  EXPECT_EQ(capacity, dekf.getState().dim());
+
+  for (int i = 0; i < 3; ++i) {
+    dekf.removeLandmark(1);
+    dekf.propagate(f, Control(0.1, 0, 0.05));
+    dekf.update(h, Measurement(1.9, 1.1));
+  }
+
+  EXPECT_EQ(Pose::DoF + State::LandmarkDim, dekf.getState().dim());
+  EXPECT_EQ(P_data, dekf.getCovariance().data());
+  EXPECT_EQ(capacity, dekf.getWorkspace().stateCapacity());
+  EXPECT_TRUE(isCovariance(dekf.getCovariance()));
+}
+
+TEST_F(TEST_DYNAMIC_STATE, TEST_IN_PLACE_PROPAGATION)
+{
+  static_assert(internal::has_in_place_evaluation<SystemModel>{}, "");
+
+  const SystemModel f(system_model);
+  const Control u(0.1, 0.02, 0.05);
+
+  addLandmark(Landmark(2, 1));
+  addLandmark(Landmark(-1, 3));
+
+  // The model evaluated in place matches its evaluation by value
+  State x = dekf.getState();
+  const State x_ref = f(x, u);
+  const double* landmarks_data = x.landmarks().data();
+
+  const SystemModelBase<SystemModel>& f_base = f;
+  f_base.into(x, u, x);
+
+  EXPECT_MANIF_NEAR(x_ref.pose(), x.pose());
+  EXPECT_EIGEN_NEAR(x_ref.landmarks(), x.landmarks());
+  EXPECT_EQ(landmarks_data, x.landmarks().data());
+
+  // The filter propagates its state in place,
+  // the landmarks are neither copied nor moved
+  landmarks_data = dekf.getState().landmarks().data();
+  for (int i = 0; i < 3; ++i) {
+    dekf.propagate(f, u);
+  }
+
+  EXPECT_EQ(landmarks_data, dekf.getState().landmarks().data());
+  EXPECT_EIGEN_NEAR(Landmark(2, 1), dekf.getState().landmark(0));
+  EXPECT_EIGEN_NEAR(Landmark(-1, 3), dekf.getState().landmark(1));
+}
+
+TEST_F(TEST_DYNAMIC_STATE, TEST_SET_COVARIANCE_SIZE_MISMATCH)
+{
+  EXPECT_THROW(
+    dekf.setCovariance(Matrix::Identity(4, 4)), kalmanif::invalid_argument
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
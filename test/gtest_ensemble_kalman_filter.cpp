@@ -0,0 +1,160 @@
+/**
+ * \file gtest_ensemble_kalman_filter.cpp
+ *
+ * Check the Ensemble Kalman Filter on Manifolds.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <array>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using UKFM = UnscentedKalmanFilterManifolds<State>;
+using EnKF = EnsembleKalmanFilterManifolds<State>;
+using LeftEnKF = EnsembleKalmanFilterManifolds<State, Invariance::Left>;
+
+class TEST_ENSEMBLE_KALMAN_FILTER : public testing::Test {
+protected:
+
+  std::array<Measurement, 3> measurements(const State& X) const {
+    std::array<Measurement, 3> ys;
+    for (int i = 0; i < 3; ++i) {
+      ys[i] = X.inverse().act(landmarks[i].getLandmark());
+    }
+    return ys;
+  }
+
+  template <typename Filter>
+  State run(Filter& filter, const bool stacked = false) const {
+    State X = X_init;
+    for (int k = 0; k < 20; ++k) {
+      X = X + u;
+      filter.propagate(system_model, u);
+
+      const auto ys = measurements(X);
+      if (stacked) {
+        filter.update(landmarks, ys);
+      } else {
+        for (int i = 0; i < 3; ++i) {
+          filter.update(landmarks[i], ys[i]);
+        }
+      }
+    }
+    return X;
+  }
+
+  Control u = Control(Eigen::Vector3d(0.1, 0.0, 0.05));
+
+  SystemModel system_model = SystemModel(StateCovariance::Identity() * 1e-4);
+
+  Eigen::Matrix2d R = Eigen::Matrix2d::Identity() * 1e-2;
+  std::array<MeasurementModel, 3> landmarks = {
+    MeasurementModel(Landmark(2.0,  0.0), R),
+    MeasurementModel(Landmark(2.0,  1.0), R),
+    MeasurementModel(Landmark(2.0, -1.0), R)
+  };
+
+  State X_init = State(0.5, -0.2, 0.1);
+  StateCovariance P_init = StateCovariance::Identity() * 1e-2;
+};
+
+TEST_F(TEST_ENSEMBLE_KALMAN_FILTER, TEST_SAMPLING)
+{
+  EnKF enkf(X_init, P_init, 20000, 1);
+
+  EXPECT_EQ(20000, enkf.getEnsembleSize());
+  EXPECT_MANIF_NEAR(X_init, enkf.getState());
+  EXPECT_EIGEN_NEAR(
+    Eigen::Vector3d::Zero(), enkf.getAnomalies().rowwise().mean(), 1e-12
+  );
+  EXPECT_EIGEN_NEAR(P_init, enkf.getCovariance(), 1e-3);
+}
+
+TEST_F(TEST_ENSEMBLE_KALMAN_FILTER, TEST_UKFM)
+{
+  EnKF enkf(X_init, P_init, 2000, 2);
+  UKFM ukfm(X_init, P_init);
+
+  const State X = run(enkf);
+  run(ukfm);
+
+  EXPECT_MANIF_NEAR(X, enkf.getState(), 1e-2);
+  EXPECT_MANIF_NEAR(ukfm.getState(), enkf.getState(), 1e-2);
+  EXPECT_EIGEN_NEAR(ukfm.getCovariance(), enkf.getCovariance(), 1e-3);
+}
+
+TEST_F(TEST_ENSEMBLE_KALMAN_FILTER, TEST_LEFT_INVARIANT)
+{
+  LeftEnKF enkf(X_init, P_init, 2000, 3);
+
+  const State X = run(enkf);
+
+  EXPECT_MANIF_NEAR(X, enkf.getState(), 1e-2);
+  EXPECT_MANIF_NEAR(
+    enkf.getState() + SE2Tangentd(enkf.getAnomalies().col(0)),
+    enkf.getMember(0)
+  );
+}
+
+TEST_F(TEST_ENSEMBLE_KALMAN_FILTER, TEST_STACKED_UPDATE)
+{
+  EnKF enkf(X_init, P_init, 500, 4);
+  EnKF enkf_stacked(X_init, P_init, 500, 4);
+
+  const State X = run(enkf_stacked, true);
+
+  EXPECT_MANIF_NEAR(X, enkf_stacked.getState(), 1e-2);
+
+  // a single update with the stacked measurements of uncorrelated noise
+  // matches the sequential updates, up to the ensemble approximation
+  run(enkf);
+  EXPECT_MANIF_NEAR(enkf.getState(), enkf_stacked.getState(), 1e-2);
+}
+
+TEST_F(TEST_ENSEMBLE_KALMAN_FILTER, TEST_EXECUTOR)
+{
+  // the random draws do not depend on the executor
+  EnKF enkf(X_init, P_init, 300, 5);
+  EnsembleKalmanFilterManifolds<State, Invariance::Right, ThreadPoolExecutor>
+    enkf_mt(X_init, P_init, 300, 5, ThreadPoolExecutor(4));
+
+  run(enkf);
+  run(enkf_mt);
+
+  EXPECT_MANIF_NEAR(enkf.getState(), enkf_mt.getState(), 1e-12);
+  EXPECT_EIGEN_NEAR(enkf.getAnomalies(), enkf_mt.getAnomalies(), 1e-12);
+}
+
+TEST_F(TEST_ENSEMBLE_KALMAN_FILTER, TEST_INVALID_ARGUMENTS)
+{
+  EXPECT_THROW((EnKF(X_init, P_init, 1)), kalmanif::invalid_argument);
+
+  EnKF enkf(X_init, P_init, 10);
+
+  EXPECT_THROW(enkf.setInflation(0.5), kalmanif::invalid_argument);
+  EXPECT_THROW(
+    enkf.setAnomalies(EnKF::Anomalies::Zero(3, 1)), kalmanif::invalid_argument
+  );
+
+  enkf.setInflation(1.1);
+  EXPECT_DOUBLE_EQ(1.1, enkf.getInflation());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
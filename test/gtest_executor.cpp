@@ -0,0 +1,109 @@
+/**
+ * \file gtest_executor.cpp
+ *
+ * Check the executors and that the UKFM
+ * gives the same results whatever the executor.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+TEST(TEST_EXECUTOR, TEST_THREAD_POOL_EXECUTOR)
+{
+  ThreadPoolExecutor executor(4);
+
+  EXPECT_EQ(4u, executor.size());
+
+  for (int n : {0, 1, 3, 100}) {
+    std::vector<std::atomic<int>> counts(n);
+    for (auto& count : counts) count = 0;
+
+    executor(n, [&](const int i) { ++counts[i]; });
+
+    for (const auto& count : counts) {
+      EXPECT_EQ(1, count);
+    }
+  }
+}
+
+TEST(TEST_EXECUTOR, TEST_THREAD_POOL_EXECUTOR_THROW)
+{
+  ThreadPoolExecutor executor(3);
+
+  EXPECT_THROW(
+    executor(10, [](const int i) {
+      if (i == 5) throw kalmanif::runtime_error("task");
+    }),
+    kalmanif::runtime_error
+  );
+
+  // The pool is still usable
+  std::atomic<int> count{0};
+  executor(10, [&](const int) { ++count; });
+  EXPECT_EQ(10, count);
+}
+
+TEST(TEST_EXECUTOR, TEST_UKFM_EXECUTORS)
+{
+  using UKFM = UnscentedKalmanFilterManifolds<State>;
+  using UKFMParallel = UnscentedKalmanFilterManifolds<
+    State, Invariance::Right, ThreadPoolExecutor
+  >;
+
+  const StateCovariance P_init = StateCovariance::Identity() * 0.01;
+  const State X_init = State::Identity();
+
+  Eigen::Matrix3d U = Eigen::Vector3d(1e-3, 1e-3, 1e-2).asDiagonal();
+  SystemModel system_model(U);
+
+  Eigen::Matrix2d R = Eigen::Matrix2d::Identity() * 1e-2;
+  MeasurementModel measurement_model(Landmark(2.0, 1.0), R);
+
+  UKFM ukfm(X_init, P_init);
+  UKFMParallel ukfm_parallel(
+    X_init, P_init, 1e-3, 1e-3, 1e-3, ThreadPoolExecutor(4)
+  );
+
+  const Control u = Control(0.1, 0.0, 0.05);
+  State X_simulation = X_init;
+
+  for (int i = 0; i < 10; ++i) {
+    X_simulation = system_model(X_simulation, u);
+
+    ukfm.propagate(system_model, u);
+    ukfm_parallel.propagate(system_model, u);
+
+    EXPECT_MANIF_NEAR(ukfm.getState(), ukfm_parallel.getState());
+    EXPECT_EIGEN_NEAR(ukfm.getCovariance(), ukfm_parallel.getCovariance());
+
+    const Measurement y = measurement_model(X_simulation);
+
+    ukfm.update(measurement_model, y);
+    ukfm_parallel.update(measurement_model, y);
+
+    EXPECT_MANIF_NEAR(ukfm.getState(), ukfm_parallel.getState());
+    EXPECT_EIGEN_NEAR(ukfm.getCovariance(), ukfm_parallel.getCovariance());
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
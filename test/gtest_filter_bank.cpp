@@ -0,0 +1,203 @@
+/**
+ * \file gtest_filter_bank.cpp
+ *
+ * Check that a filter bank matches independent filters.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using GPSModel = DummyGPSMeasurementModel<State>;
+using GPS = GPSModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+using Bank = FilterBank<EKF>;
+using InvariantBank = FilterBank<IEKF>;
+
+class TEST_FILTER_BANK : public testing::Test {
+protected:
+
+  void SetUp() override {
+    for (int t = 0; t < tracks; ++t) {
+      X_inits.emplace_back(0.1 * t, -0.05 * t, 0.02 * t);
+      filters.emplace_back(X_inits.back(), P_init);
+      us.emplace_back(0.1, 0.01 * t, 0.05 - 0.01 * t);
+    }
+  }
+
+  std::vector<Measurement> measure(const int k) const {
+    std::vector<Measurement> ys;
+    for (int t = 0; t < tracks; ++t) {
+      ys.push_back(
+        measurement_model(filters[t].getState()) +
+        Measurement(0.01, -0.02) * ((k + t) % 3)
+      );
+    }
+    return ys;
+  }
+
+  static constexpr int tracks = 7;
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = (Eigen::Matrix2d() << 1e-2, 2e-3, 2e-3, 2e-2).finished();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+
+  std::vector<State> X_inits;
+  std::vector<EKF> filters;
+  std::vector<Control> us;
+};
+
+TEST_F(TEST_FILTER_BANK, TEST_VS_FILTERS)
+{
+  Bank bank(tracks, State::Identity(), P_init);
+
+  for (int t = 0; t < tracks; ++t) {
+    bank.setState(t, X_inits[t]);
+  }
+
+  for (int k = 0; k < 10; ++k) {
+    bank.propagate(system_model, us);
+    for (int t = 0; t < tracks; ++t) {
+      filters[t].propagate(system_model, us[t]);
+      EXPECT_MANIF_NEAR(filters[t].getState(), bank.getState(t));
+      EXPECT_EIGEN_NEAR(filters[t].getCovariance(), bank.getCovariance(t));
+    }
+
+    const std::vector<Measurement> ys = measure(k);
+    bank.update(measurement_model, ys);
+    for (int t = 0; t < tracks; ++t) {
+      filters[t].update(measurement_model, ys[t]);
+      EXPECT_MANIF_NEAR(filters[t].getState(), bank.getState(t));
+      EXPECT_EIGEN_NEAR(filters[t].getCovariance(), bank.getCovariance(t));
+    }
+  }
+}
+
+TEST_F(TEST_FILTER_BANK, TEST_IEKF_VS_FILTERS)
+{
+  InvariantBank bank(tracks, State::Identity(), P_init);
+  std::vector<IEKF> iekfs;
+
+  for (int t = 0; t < tracks; ++t) {
+    bank.setState(t, X_inits[t]);
+    iekfs.emplace_back(X_inits[t], P_init);
+  }
+
+  Eigen::Matrix2d R_gps = Eigen::Vector2d(4e-2, 3e-2).asDiagonal();
+  GPSModel gps_model(R_gps);
+
+  for (int k = 0; k < 10; ++k) {
+    bank.propagate(system_model, us);
+    for (int t = 0; t < tracks; ++t) {
+      iekfs[t].propagate(system_model, us[t]);
+      EXPECT_MANIF_NEAR(iekfs[t].getState(), bank.getState(t));
+      EXPECT_EIGEN_NEAR(iekfs[t].getCovariance(), bank.getCovariance(t));
+    }
+
+    // a right invariant model
+    const std::vector<Measurement> ys = measure(k);
+    bank.update(measurement_model, ys);
+
+    // a left invariant model
+    std::vector<GPS> gs;
+    for (int t = 0; t < tracks; ++t) {
+      gs.push_back(
+        iekfs[t].getState().translation() + GPS(0.1, -0.1) * (t % 2)
+      );
+    }
+    bank.update(gps_model, gs);
+
+    for (int t = 0; t < tracks; ++t) {
+      iekfs[t].update(measurement_model, ys[t]);
+      iekfs[t].update(gps_model, gs[t]);
+      EXPECT_MANIF_NEAR(iekfs[t].getState(), bank.getState(t));
+      EXPECT_EIGEN_NEAR(iekfs[t].getCovariance(), bank.getCovariance(t));
+    }
+  }
+}
+
+TEST_F(TEST_FILTER_BANK, TEST_EXECUTOR)
+{
+  // several blocks of tracks
+  const std::size_t size = 3 * Bank::BlockSize + 5;
+
+  Bank bank(size, X_inits[3], P_init);
+  FilterBank<EKF, ThreadPoolExecutor> bank_mt(
+    size, X_inits[3], P_init, ThreadPoolExecutor(4)
+  );
+
+  std::vector<Control> controls;
+  std::vector<Measurement> ys;
+  for (std::size_t t = 0; t < size; ++t) {
+    controls.emplace_back(0.1, 1e-4 * t, 0.05);
+    ys.push_back(Measurement(1.0 + 1e-4 * t, 0.5));
+  }
+
+  for (int k = 0; k < 3; ++k) {
+    bank.propagate(system_model, controls);
+    bank_mt.propagate(system_model, controls);
+    bank.update(measurement_model, ys);
+    bank_mt.update(measurement_model, ys);
+  }
+
+  for (std::size_t t = 0; t < size; ++t) {
+    EXPECT_TRUE(bank.getState(t).coeffs() == bank_mt.getState(t).coeffs());
+    EXPECT_TRUE(bank.getCovariance(t) == bank_mt.getCovariance(t));
+  }
+}
+
+TEST_F(TEST_FILTER_BANK, TEST_INACTIVE)
+{
+  Bank bank(tracks, State::Identity(), P_init);
+  bank.propagate(system_model, us);
+
+  std::vector<bool> active(tracks, false);
+  active[2] = true;
+
+  const State x0 = bank.getState(0);
+  const StateCovariance P0 = bank.getCovariance(0);
+
+  bank.update(measurement_model, measure(0), active);
+
+  EXPECT_TRUE(x0.coeffs() == bank.getState(0).coeffs());
+  EXPECT_TRUE(P0 == bank.getCovariance(0));
+  EXPECT_FALSE(bank.getCovariance(2).isApprox(P0));
+}
+
+TEST_F(TEST_FILTER_BANK, TEST_SIZE_MISMATCH)
+{
+  Bank bank(tracks, State::Identity(), P_init);
+
+  EXPECT_THROW(
+    bank.propagate(system_model, std::vector<Control>(tracks - 1)),
+    kalmanif::invalid_argument
+  );
+  EXPECT_THROW(
+    bank.update(measurement_model, std::vector<Measurement>(tracks + 1)),
+    kalmanif::invalid_argument
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,167 @@
+/**
+ * \file gtest_filter_ensemble.cpp
+ *
+ * Check that an ensemble of filters run concurrently
+ * matches the filters run one after the other.
+ */
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/system_models/simple_imu_system_model.h>
+
+#include <manif/SE_2_3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <array>
+#include <tuple>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE_2_3d;
+using StateCovariance = Covariance<State>;
+using SystemModel = SimpleImuSystemModel<State::Scalar>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark3DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+using UKFM = UnscentedKalmanFilterManifolds<State>;
+using RTS = RauchTungStriebelSmoother<EKF>;
+
+class TEST_FILTER_ENSEMBLE : public testing::Test {
+protected:
+
+  void SetUp() override {
+    system_model.setCovariance(
+      Eigen::Matrix<double, 6, 6>::Identity() * 1e-6
+    );
+  }
+
+  Control control(const int k) const {
+    Control u;
+    u << 0.1, 0.01 * k, 9.80665, 0.01, 0.1, 0.;
+    return u;
+  }
+
+  Measurement measurement(const int i, const int k) const {
+    return landmarks[i].getLandmark() + Measurement::Constant(0.001 * k);
+  }
+
+  double dt = 0.01;
+  SystemModel system_model;
+
+  Eigen::Matrix3d R = Eigen::Matrix3d::Identity() * 1e-4;
+  std::array<MeasurementModel, 3> landmarks = {
+    MeasurementModel(Landmark(2.0,  0.0,  0.0), R),
+    MeasurementModel(Landmark(3.0, -1.0, -1.0), R),
+    MeasurementModel(Landmark(2.0, -1.0,  1.0), R)
+  };
+
+  State X_init = State::Identity();
+  StateCovariance P_init = StateCovariance::Identity() * 1e-3;
+};
+
+TEST_F(TEST_FILTER_ENSEMBLE, TEST_MATCHES_SERIAL)
+{
+  constexpr int Steps = 50;
+
+  FilterEnsemble<std::tuple<EKF, IEKF, UKFM, RTS>> ensemble(
+    X_init, P_init, ThreadPoolExecutor(4)
+  );
+
+  EKF ekf(X_init, P_init);
+  IEKF iekf(X_init, P_init);
+  UKFM ukfm(X_init, P_init);
+  RTS rts(X_init, P_init);
+
+  for (int k = 0; k < Steps; ++k) {
+    const Control u = control(k);
+
+    ensemble.propagate(system_model, u, dt);
+    ekf.propagate(system_model, u, dt);
+    iekf.propagate(system_model, u, dt);
+    ukfm.propagate(system_model, u, dt);
+    rts.propagate(system_model, u, dt);
+
+    for (int i = 0; i < 3; ++i) {
+      const Measurement y = measurement(i, k);
+
+      ensemble.update(landmarks[i], y);
+      ekf.update(landmarks[i], y);
+      iekf.update(landmarks[i], y);
+      ukfm.update(landmarks[i], y);
+      rts.update(landmarks[i], y);
+    }
+  }
+
+  EXPECT_MANIF_NEAR(ekf.getState(), ensemble.get<0>().getState(), 1e-12);
+  EXPECT_MANIF_NEAR(iekf.getState(), ensemble.get<1>().getState(), 1e-12);
+  EXPECT_MANIF_NEAR(ukfm.getState(), ensemble.get<2>().getState(), 1e-12);
+  EXPECT_MANIF_NEAR(rts.getState(), ensemble.get<3>().getState(), 1e-12);
+
+  EXPECT_EIGEN_NEAR(
+    iekf.getCovariance(), ensemble.get<1>().getCovariance(), 1e-12
+  );
+  EXPECT_EIGEN_NEAR(
+    ukfm.getCovariance(), ensemble.get<2>().getCovariance(), 1e-12
+  );
+
+  const auto states = ensemble.getStates();
+  EXPECT_MANIF_NEAR(ekf.getState(), states[0], 1e-12);
+  EXPECT_MANIF_NEAR(ukfm.getState(), states[2], 1e-12);
+}
+
+TEST_F(TEST_FILTER_ENSEMBLE, TEST_STACKED_UPDATE)
+{
+  FilterEnsemble<std::tuple<EKF, IEKF>, SequentialExecutor> ensemble(
+    std::make_tuple(EKF(X_init, P_init), IEKF(X_init, P_init * 2))
+  );
+
+  EKF ekf(X_init, P_init);
+  IEKF iekf(X_init, P_init * 2);
+
+  const std::array<Measurement, 3> ys = {
+    measurement(0, 1), measurement(1, 1), measurement(2, 1)
+  };
+
+  ensemble.propagate(system_model, control(0), dt);
+  ensemble.update(landmarks, ys);
+
+  ekf.propagate(system_model, control(0), dt);
+  ekf.update(landmarks, ys);
+  iekf.propagate(system_model, control(0), dt);
+  iekf.update(landmarks, ys);
+
+  EXPECT_MANIF_NEAR(ekf.getState(), ensemble.get<0>().getState(), 1e-12);
+  EXPECT_MANIF_NEAR(iekf.getState(), ensemble.get<1>().getState(), 1e-12);
+}
+
+TEST_F(TEST_FILTER_ENSEMBLE, TEST_FOR_EACH)
+{
+  FilterEnsemble<std::tuple<EKF, IEKF, UKFM>> ensemble(
+    X_init, P_init, ThreadPoolExecutor(3)
+  );
+
+  std::atomic<int> count{0};
+  ensemble.forEach([&](auto& filter){
+    filter.setCovariance(P_init * 2);
+    ++count;
+  });
+
+  EXPECT_EQ(3, count.load());
+  EXPECT_EIGEN_NEAR(P_init * 2, ensemble.get<2>().getCovariance(), 1e-12);
+
+  // the first error is rethrown
+  EXPECT_THROW(
+    ensemble.forEach([](auto&){ throw kalmanif::runtime_error("error"); }),
+    kalmanif::runtime_error
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,106 @@
+/**
+ * \file gtest_fixed_lag_smoother.cpp
+ *
+ * Check that the fixed-lag smoother matches
+ * the batch Rauch-Tung-Striebel smoother.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+using UKFM = UnscentedKalmanFilterManifolds<State>;
+
+template <typename Filter>
+class TEST_FIXED_LAG_SMOOTHER : public testing::Test {
+protected:
+
+  template <typename Smoother>
+  void propagate(Smoother& smoother) const {
+    if constexpr (std::is_same<Filter, IEKF>{}) {
+      smoother.propagate(system_model, u, dt);
+    } else {
+      smoother.propagate(system_model, u);
+    }
+  }
+
+  template <typename Smoother>
+  void step(Smoother& smoother, const int k) const {
+    propagate(smoother);
+    if (k % 4 == 1) propagate(smoother);
+    smoother.update(measurement_model, y(k));
+  }
+
+  Measurement y(const int k) const {
+    State X_simulation = State::Identity();
+    for (int i = 0; i <= k; ++i) X_simulation = X_simulation + u;
+    return measurement_model(X_simulation) + Measurement(0.01, -0.02) * (k % 3);
+  }
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+  Control u = Control(0.1, 0.0, 0.05);
+  double dt = 0.1;
+
+  State X_init = State(0.05, -0.05, 0.02);
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+};
+
+using Filters = testing::Types<EKF, IEKF, UKFM>;
+TYPED_TEST_SUITE(TEST_FIXED_LAG_SMOOTHER, Filters);
+
+TYPED_TEST(TEST_FIXED_LAG_SMOOTHER, TEST_VS_BATCH)
+{
+  constexpr std::size_t Lag = 4;
+  constexpr int epochs = 12;
+
+  FixedLagSmoother<TypeParam, Lag> smoother(this->X_init, this->P_init);
+  RauchTungStriebelSmoother<TypeParam> batch(this->X_init, this->P_init);
+
+  for (int k = 0; k < epochs; ++k) {
+    this->step(smoother, k);
+    this->step(batch, k);
+
+    EXPECT_MANIF_NEAR(batch.getState(), smoother.getState());
+
+    if (k < int(Lag)) {
+      EXPECT_FALSE(smoother.hasLaggedEstimate());
+      continue;
+    }
+
+    ASSERT_TRUE(smoother.hasLaggedEstimate());
+
+    batch.smooth();
+
+    EXPECT_MANIF_NEAR(
+      batch.getStates()[k - Lag], smoother.getLaggedState()
+    );
+    EXPECT_EIGEN_NEAR(
+      batch.getCovariances()[k - Lag], smoother.getLaggedCovariance()
+    );
+  }
+
+  smoother.clear();
+  EXPECT_FALSE(smoother.hasLaggedEstimate());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
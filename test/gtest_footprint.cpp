@@ -0,0 +1,168 @@
+/**
+ * \file gtest_footprint.cpp
+ *
+ * Check the filter footprints, the compact sigma point sets
+ * and that the smoothers still get the transitions
+ * the filters no longer hold.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <memory>
+#include <vector>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+using UKFM = UnscentedKalmanFilterManifolds<State>;
+
+// The footprints are known at compile time
+static_assert(footprint<EKF>() == sizeof(EKF), "");
+static_assert(FilterFootprint<UKFM>::Alignment == alignof(UKFM), "");
+static_assert(FilterFootprint<IEKF>::bytes(1000) == 1000 * sizeof(IEKF), "");
+
+class TEST_FOOTPRINT : public testing::Test {
+protected:
+
+  Measurement measure(const State& X, const int k) const {
+    return measurement_model(X) + Measurement(0.01, -0.02) * (k % 3);
+  }
+
+  /**
+   * Run a filter alone and wrapped by a smoother on the same steps,
+   * the smoother recording the transitions.
+   */
+  template <typename Filter>
+  void checkSmoother() const {
+    Filter filter(X_init, P_init);
+    RauchTungStriebelSmoother<Filter> rts(X_init, P_init);
+
+    State X = X_init;
+    for (int k = 0; k < 20; ++k) {
+      X = X + u;
+      filter.propagate(system_model, u);
+      rts.propagate(system_model, u);
+
+      filter.update(measurement_model, measure(X, k));
+      rts.update(measurement_model, measure(X, k));
+
+      // Recording the transition does not change the estimate
+      EXPECT_MANIF_NEAR(filter.getState(), rts.getState(), 1e-12);
+      EXPECT_EIGEN_NEAR(filter.getCovariance(), rts.getCovariance(), 1e-12);
+    }
+
+    rts.smooth();
+
+    // The last smoothed estimate is the filtered one
+    EXPECT_MANIF_NEAR(filter.getState(), rts.getStates().back(), 1e-12);
+
+    // Smoothing reduces the uncertainty of the earlier estimates
+    EXPECT_LT(rts.getCovariances().front().trace(), P_init.trace());
+  }
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+
+  const Control u = Control(0.1, 0.0, 0.05);
+  const State X_init = State(0.05, -0.05, 0.02);
+  const StateCovariance P_init = StateCovariance::Identity() * 0.1;
+};
+
+TEST_F(TEST_FOOTPRINT, TEST_ARENA)
+{
+  using Footprint = FilterFootprint<UKFM>;
+
+  EXPECT_EQ(0u, Footprint::arenaBytes(0));
+  EXPECT_EQ(
+    Footprint::bytes(10) + Footprint::Alignment - 1, Footprint::arenaBytes(10)
+  );
+
+  // n filters fit in an arena at any of its offsets
+  std::vector<std::uint8_t> arena(Footprint::arenaBytes(4) + 1);
+  void* data = arena.data() + 1;
+  std::size_t space = arena.size() - 1;
+  EXPECT_NE(
+    nullptr,
+    std::align(Footprint::Alignment, Footprint::bytes(4), data, space)
+  );
+}
+
+TEST_F(TEST_FOOTPRINT, TEST_COMPACT_SIGMA_POINTS)
+{
+  using Symmetric = internal::CompactSigmaPointSet<
+    double, 3, SymmetricSigmaPoints
+  >;
+  using Simplex = internal::CompactSigmaPointSet<
+    double, 3, SphericalSimplexSigmaPoints
+  >;
+
+  // Neither the symmetric points nor uniform weights are stored
+  EXPECT_LT(
+    sizeof(Symmetric), sizeof(SigmaPointSet<double, 3, SymmetricSigmaPoints>)
+  );
+  EXPECT_LT(
+    sizeof(Simplex),
+    sizeof(SigmaPointSet<double, 3, SphericalSimplexSigmaPoints>)
+  );
+
+  const Eigen::Matrix3d L =
+    (Eigen::Matrix3d() << 1, 0, 0, 0.2, 0.5, 0, -0.1, 0.3, 0.7).finished();
+
+  const auto check = [&](const auto& compact, const auto& set) {
+    const auto xis = internal::sigmaPoints(set, L);
+    EXPECT_EIGEN_NEAR(xis, internal::sigmaPoints(compact, L), 1e-12);
+    EXPECT_EIGEN_NEAR(
+      internal::sigmaSum(set, xis), internal::sigmaSum(compact, xis), 1e-12
+    );
+    EXPECT_EIGEN_NEAR(
+      internal::sigmaWeighted(set, xis),
+      internal::sigmaWeighted(compact, xis),
+      1e-12
+    );
+    EXPECT_EQ(set.w0, compact.w0);
+  };
+
+  check(Symmetric(0.5), SigmaPointSet<double, 3, SymmetricSigmaPoints>(0.5));
+  check(
+    Simplex(0.5), SigmaPointSet<double, 3, SphericalSimplexSigmaPoints>(0.5)
+  );
+  check(
+    internal::CompactSigmaPointSet<double, 3, MinimalSkewSigmaPoints>(0.5),
+    SigmaPointSet<double, 3, MinimalSkewSigmaPoints>(0.5)
+  );
+}
+
+TEST_F(TEST_FOOTPRINT, TEST_EKF_SMOOTHER)
+{
+  checkSmoother<EKF>();
+}
+
+TEST_F(TEST_FOOTPRINT, TEST_IEKF_SMOOTHER)
+{
+  checkSmoother<IEKF>();
+}
+
+TEST_F(TEST_FOOTPRINT, TEST_UKFM_SMOOTHER)
+{
+  checkSmoother<UKFM>();
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
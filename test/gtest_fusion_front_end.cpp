@@ -0,0 +1,258 @@
+/**
+ * \file gtest_fusion_front_end.cpp
+ *
+ * Check the lock-free queues and the asynchronous fusion front end.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <thread>
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+
+TEST(TEST_FUSION_FRONT_END, TEST_SPSC_QUEUE)
+{
+  SpscQueue<int> queue(5);
+  EXPECT_EQ(8u, queue.capacity());
+
+  constexpr int N = 100000;
+
+  std::thread producer([&](){
+    for (int i = 0; i < N; ++i) {
+      while (!queue.push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int expected = 0, value;
+  while (expected < N) {
+    if (queue.pop(value)) {
+      ASSERT_EQ(expected, value);
+      ++expected;
+    }
+  }
+  producer.join();
+
+  EXPECT_EQ(nullptr, queue.front());
+  EXPECT_EQ(0u, queue.size());
+}
+
+TEST(TEST_FUSION_FRONT_END, TEST_MPSC_QUEUE)
+{
+  MpscQueue<int> queue(64);
+
+  constexpr int Producers = 4, N = 20000;
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < Producers; ++p) {
+    producers.emplace_back([&, p](){
+      for (int i = 0; i < N; ++i) {
+        while (!queue.push(p * N + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // each producer order is preserved
+  std::vector<int> last(Producers, -1);
+  int popped = 0, value;
+  while (popped < Producers * N) {
+    if (queue.pop(value)) {
+      const int p = value / N;
+      ASSERT_LT(last[p], value % N);
+      last[p] = value % N;
+      ++popped;
+    }
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  EXPECT_EQ(std::vector<int>(Producers, N - 1), last);
+  EXPECT_EQ(nullptr, queue.front());
+
+  MpscQueue<int> full(2);
+  EXPECT_TRUE(full.push(0));
+  EXPECT_TRUE(full.push(1));
+  EXPECT_FALSE(full.push(2));
+}
+
+TEST(TEST_FUSION_FRONT_END, TEST_SEQLOCK)
+{
+  struct Pair { long a, b; };
+
+  SeqLock<Pair> lock(Pair{0, 0});
+
+  constexpr long N = 100000;
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  std::atomic<int> torn{0};
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&](){
+      while (!done.load()) {
+        const Pair pair = lock.load();
+        if (pair.b != -pair.a) {
+          ++torn;
+        }
+      }
+    });
+  }
+
+  for (long i = 1; i <= N; ++i) {
+    lock.store(Pair{i, -i});
+  }
+  done = true;
+
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(0, torn.load());
+  EXPECT_EQ(std::size_t(N), lock.version());
+  EXPECT_EQ(N, lock.load().a);
+}
+
+class TEST_FUSION_FRONT_END_FILTER : public testing::Test {
+protected:
+
+  double dt = 0.1;
+  SystemModel system_model{StateCovariance::Identity() * 1e-4};
+  Control u = Control(0.1, 0.0, 0.05);
+
+  Eigen::Matrix2d R = Eigen::Matrix2d::Identity() * 1e-3;
+  MeasurementModel h0{Landmark(2.0, 0.0), R};
+  MeasurementModel h1{Landmark(2.0, 1.0), R};
+
+  State X_init = State::Identity();
+  StateCovariance P_init = StateCovariance::Identity() * 1e-3;
+
+  // the measurement of the landmark h at step i
+  Measurement measurement(const MeasurementModel& h, const int i) const {
+    State X = X_init;
+    for (int k = 0; k < i; ++k) {
+      X = X + u;
+    }
+    return h(X) + Measurement(0.01 * std::sin(i), 0.01 * std::cos(i));
+  }
+};
+
+TEST_F(TEST_FUSION_FRONT_END_FILTER, TEST_TIME_ORDER)
+{
+  constexpr int Steps = 50;
+
+  FusionFrontEnd<EKF> fusion(0., X_init, P_init);
+  auto& controls = fusion.addControlStream(system_model);
+  auto& landmarks_0 = fusion.addMeasurementStream(h0);
+  auto& landmarks_1 = fusion.addMeasurementStream(h1);
+
+  // pushed per stream, to be merged in time order
+  for (int i = 1; i <= Steps; ++i) {
+    ASSERT_TRUE(controls.push(i * dt, u));
+  }
+  for (int i = 1; i <= Steps; ++i) {
+    ASSERT_TRUE(landmarks_0.push(i * dt + 0.01, measurement(h0, i)));
+    ASSERT_TRUE(landmarks_1.push(i * dt + 0.02, measurement(h1, i)));
+  }
+
+  fusion.start();
+  fusion.stop();
+
+  EKF ekf(X_init, P_init);
+  for (int i = 1; i <= Steps; ++i) {
+    ekf.propagate(system_model, u);
+    ekf.update(h0, measurement(h0, i));
+    ekf.update(h1, measurement(h1, i));
+  }
+
+  const auto estimate = fusion.getEstimate();
+
+  EXPECT_EQ(3u * Steps, fusion.getStepCount());
+  EXPECT_EQ(3u * Steps, estimate.steps);
+  EXPECT_EQ(0u, fusion.getLateCount());
+  EXPECT_DOUBLE_EQ(Steps * dt + 0.02, estimate.t);
+
+  EXPECT_MANIF_NEAR(ekf.getState(), estimate.state, 1e-12);
+  EXPECT_EIGEN_NEAR(ekf.getCovariance(), estimate.covariance, 1e-12);
+  EXPECT_MANIF_NEAR(ekf.getState(), fusion.getFilter().getState(), 1e-12);
+}
+
+TEST_F(TEST_FUSION_FRONT_END_FILTER, TEST_CONCURRENT_DRIVERS)
+{
+  constexpr int Steps = 200;
+
+  FusionFrontEnd<EKF> fusion(0., X_init, P_init);
+  auto& controls = fusion.addControlStream(system_model, 16);
+  auto& landmarks = fusion.addMeasurementStream(h0, 16);
+
+  fusion.start(std::chrono::microseconds(10));
+
+  EXPECT_TRUE(fusion.isRunning());
+  EXPECT_THROW(fusion.start(), runtime_error);
+  EXPECT_THROW(fusion.addMeasurementStream(h1), runtime_error);
+
+  std::thread control_driver([&](){
+    for (int i = 1; i <= Steps; ++i) {
+      while (!controls.push(i * dt, u)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::thread landmark_driver([&](){
+    for (int i = 1; i <= Steps; ++i) {
+      while (!landmarks.push(i * dt + 0.01, measurement(h0, i))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  // read while the filter runs
+  std::size_t steps = 0;
+  while (steps < 2u * Steps) {
+    const auto estimate = fusion.getEstimate();
+    EXPECT_LE(steps, estimate.steps);
+    EXPECT_TRUE(estimate.state.coeffs().allFinite());
+    steps = estimate.steps;
+    std::this_thread::yield();
+  }
+
+  control_driver.join();
+  landmark_driver.join();
+  fusion.stop();
+
+  EXPECT_FALSE(fusion.isRunning());
+  EXPECT_EQ(2u * Steps, fusion.getStepCount());
+  EXPECT_LE(fusion.getLateCount(), 2u * Steps);
+
+  // the estimate ends near the true trajectory whatever the interleaving
+  State X = X_init;
+  for (int i = 0; i < Steps; ++i) {
+    X = X + u;
+  }
+  EXPECT_MANIF_NEAR(X, fusion.getEstimate().state, 0.1);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,96 @@
+/**
+ * \file gtest_gating.cpp
+ *
+ * Check the Mahalanobis gating of the EKF and IEKF updates.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+
+template <typename Filter>
+class TEST_GATING : public testing::Test {
+protected:
+
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+
+  State X_true = State(0.1, -0.2, 0.05);
+  State X_init = State(0.15, -0.1, 0.);
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+
+  Measurement inlier = measurement_model(X_true) + Measurement(0.05, -0.1);
+  Measurement outlier = measurement_model(X_true) + Measurement(3.0, -2.0);
+
+  // 99% chi-squared quantile, 2 degrees of freedom
+  MahalanobisGate gate{9.21};
+};
+
+using Filters = testing::Types<EKF, IEKF>;
+TYPED_TEST_SUITE(TEST_GATING, Filters);
+
+TYPED_TEST(TEST_GATING, TEST_INLIER)
+{
+  TypeParam filter(this->X_init, this->P_init);
+  TypeParam gated(this->X_init, this->P_init);
+
+  filter.update(this->measurement_model, this->inlier);
+  gated.update(this->measurement_model, this->inlier, this->gate);
+
+  EXPECT_TRUE(gated.isInnovationAccepted());
+  EXPECT_GE(this->gate.threshold, gated.getNormalizedInnovationSquared());
+
+  EXPECT_MANIF_NEAR(filter.getState(), gated.getState(), 1e-12);
+  EXPECT_EIGEN_NEAR(filter.getCovariance(), gated.getCovariance(), 1e-12);
+}
+
+TYPED_TEST(TEST_GATING, TEST_OUTLIER)
+{
+  TypeParam gated(this->X_init, this->P_init);
+
+  gated.update(this->measurement_model, this->outlier, this->gate);
+
+  EXPECT_FALSE(gated.isInnovationAccepted());
+  EXPECT_LT(this->gate.threshold, gated.getNormalizedInnovationSquared());
+
+  // The estimate is untouched
+  EXPECT_TRUE(gated.getState().coeffs() == this->X_init.coeffs());
+  EXPECT_TRUE(gated.getCovariance() == this->P_init);
+
+  // The next inlier is accepted
+  gated.update(this->measurement_model, this->inlier, this->gate);
+  EXPECT_TRUE(gated.isInnovationAccepted());
+}
+
+TYPED_TEST(TEST_GATING, TEST_DEFAULT_GATE)
+{
+  TypeParam filter(this->X_init, this->P_init);
+  TypeParam gated(this->X_init, this->P_init);
+
+  // The default gate accepts everything
+  filter.update(this->measurement_model, this->outlier);
+  gated.update(this->measurement_model, this->outlier, MahalanobisGate());
+
+  EXPECT_TRUE(gated.isInnovationAccepted());
+  EXPECT_MANIF_NEAR(filter.getState(), gated.getState(), 1e-12);
+  EXPECT_EIGEN_NEAR(filter.getCovariance(), gated.getCovariance(), 1e-12);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
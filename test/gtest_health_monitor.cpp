@@ -0,0 +1,161 @@
+/**
+ * \file gtest_health_monitor.cpp
+ *
+ * Check the sampled numerical health monitor.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+
+TEST(TEST_HEALTH_MONITOR, TEST_CONDITION_ESTIMATE)
+{
+  const Eigen::Matrix3d M = Eigen::Vector3d(4., 1e-2, 0.5).asDiagonal();
+
+  // exact for diagonal matrices
+  EXPECT_NEAR(400., internal::conditionEstimate(M.llt()), 1e-9);
+  EXPECT_NEAR(400., internal::conditionEstimate(M.ldlt()), 1e-9);
+  EXPECT_NEAR(400., internal::conditionEstimate(M.colPivHouseholderQr()), 1e-9);
+
+  // a lower bound otherwise
+  Eigen::Matrix3d A;
+  A << 2, 1, 0,
+       1, 2, 1,
+       0, 1, 2;
+  const Eigen::Vector3d eigenvalues =
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d>(A).eigenvalues();
+  const double condition = eigenvalues.maxCoeff() / eigenvalues.minCoeff();
+
+  EXPECT_LE(internal::conditionEstimate(A.llt()), condition);
+  EXPECT_LE(internal::conditionEstimate(A.ldlt()), condition);
+}
+
+TEST(TEST_HEALTH_MONITOR, TEST_SAMPLING)
+{
+  EKF ekf(State::Identity(), StateCovariance::Identity() * 0.1);
+  HealthMonitor monitor(3);
+
+  std::vector<bool> sampled;
+  for (int i = 0; i < 7; ++i) {
+    sampled.push_back(monitor.check(ekf));
+  }
+
+  EXPECT_EQ(
+    std::vector<bool>({false, false, true, false, false, true, false}), sampled
+  );
+  EXPECT_EQ(2u, monitor.getStatistics().samples);
+  EXPECT_NEAR(1., monitor.getStatistics().covariance_condition, 1e-12);
+
+  // no innovation yet
+  EXPECT_EQ(0., monitor.getStatistics().innovation_condition);
+
+  MeasurementModel h(Landmark(2.0, 1.0), Eigen::Matrix2d::Identity() * 1e-2);
+  ekf.update(h, Measurement(1.9, 1.2));
+  monitor.sample(ekf);
+
+  EXPECT_EQ(3u, monitor.getStatistics().samples);
+  EXPECT_LE(1., monitor.getStatistics().innovation_condition);
+
+  EXPECT_THROW(HealthMonitor(0), kalmanif::invalid_argument);
+}
+
+TEST(TEST_HEALTH_MONITOR, TEST_CALLBACK)
+{
+  // condition number of 1e11
+  const StateCovariance P_bad = Eigen::Vector3d(1e4, 1e4, 1e-7).asDiagonal();
+
+  EKF ekf(State::Identity(), P_bad);
+
+  HealthThresholds thresholds;
+  thresholds.covariance_condition = 1e10;
+
+  std::vector<HealthEvent> events;
+  HealthMonitor monitor(1, thresholds);
+  monitor.setCallback([&](const HealthEvent& e){ events.push_back(e); });
+
+  monitor.check(ekf);
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ(HealthIssue::CovarianceConditioning, events[0].issue);
+  EXPECT_NEAR(1e11, events[0].value, 1e-1);
+  EXPECT_EQ(1e10, events[0].threshold);
+
+  // raised once until it recovers
+  monitor.check(ekf);
+  EXPECT_EQ(1u, events.size());
+
+  ekf.setCovariance(StateCovariance::Identity());
+  monitor.check(ekf);
+  EXPECT_EQ(1u, events.size());
+
+  ekf.setCovariance(P_bad);
+  monitor.check(ekf);
+  EXPECT_EQ(2u, events.size());
+
+  EXPECT_EQ(4u, monitor.getStatistics().samples);
+  EXPECT_NEAR(1e11, monitor.getStatistics().max_covariance_condition, 1e-1);
+}
+
+// A filter counting its covariance repairs
+struct RepairingFilter {
+  const CovarianceSquareRoot<State>& getCovarianceSquareRoot() const {
+    return S;
+  }
+
+  std::size_t getCovarianceRepairCount() const {
+    return repairs;
+  }
+
+  CovarianceSquareRoot<State> S = CovarianceSquareRoot<State>::Identity();
+  std::size_t repairs = 0;
+};
+
+TEST(TEST_HEALTH_MONITOR, TEST_REPAIRS)
+{
+  RepairingFilter filter;
+
+  std::vector<HealthEvent> events;
+  HealthMonitor monitor(2);
+  monitor.setCallback([&](const HealthEvent& e){ events.push_back(e); });
+
+  monitor.check(filter);
+  monitor.check(filter);
+  EXPECT_TRUE(events.empty());
+
+  filter.repairs = 3;
+  monitor.check(filter);
+  monitor.check(filter);
+
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ(HealthIssue::CovarianceRepairs, events[0].issue);
+  EXPECT_EQ(3., events[0].value);
+  EXPECT_EQ(3u, monitor.getStatistics().repairs);
+
+  // no new repair
+  monitor.check(filter);
+  monitor.check(filter);
+  EXPECT_EQ(1u, events.size());
+  EXPECT_EQ(3u, monitor.getStatistics().repairs);
+
+  monitor.reset();
+  EXPECT_EQ(0u, monitor.getStatistics().samples);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,158 @@
+/**
+ * \file gtest_information_filter.cpp
+ *
+ * Check that the information filter matches the EKF.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <array>
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IKF = InformationKalmanFilter<State>;
+
+class TEST_INFORMATION_FILTER : public testing::Test {
+protected:
+
+  Measurement y(const MeasurementModel& h, const int k) const {
+    return h(X_simulation) + Measurement(0.01, -0.02) * double(k % 3);
+  }
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+
+  Eigen::Matrix2d R = (Eigen::Matrix2d() << 1e-2, 4e-3, 4e-3, 2e-2).finished();
+
+  std::vector<MeasurementModel> measurement_models = {
+    MeasurementModel(Landmark(2.0,  0.0), R),
+    MeasurementModel(Landmark(2.0,  1.0), R),
+    MeasurementModel(Landmark(2.0, -1.0), R),
+    MeasurementModel(Landmark(3.0,  0.5), R)
+  };
+
+  Control u = Control(0.1, 0.0, 0.05);
+
+  State X_simulation = State::Identity();
+  State X_init = State(0.05, -0.05, 0.02);
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+};
+
+TEST_F(TEST_INFORMATION_FILTER, TEST_VS_EKF)
+{
+  EKF ekf(X_init, P_init);
+  IKF ikf(X_init, P_init);
+
+  for (int k = 0; k < 30; ++k) {
+    X_simulation = X_simulation + u;
+
+    ekf.propagate(system_model, u);
+    ikf.propagate(system_model, u);
+
+    if (k % 2) {
+      ekf.propagate(system_model, u);
+      ikf.propagate(system_model, u);
+      continue;
+    }
+
+    const auto& h = measurement_models[k % measurement_models.size()];
+    ekf.update(h, y(h, k));
+    ikf.update(h, y(h, k));
+
+    EXPECT_MANIF_NEAR(ekf.getState(), ikf.getState(), 1e-8);
+    EXPECT_EIGEN_NEAR(ekf.getCovariance(), ikf.getCovariance(), 1e-8);
+  }
+}
+
+TEST_F(TEST_INFORMATION_FILTER, TEST_STACKED_VS_EKF)
+{
+  EKF ekf(X_init, P_init);
+  IKF ikf(X_init, P_init);
+
+  std::vector<Measurement> ys(measurement_models.size());
+
+  for (int k = 0; k < 10; ++k) {
+    X_simulation = X_simulation + u;
+
+    ekf.propagate(system_model, u);
+    ikf.propagate(system_model, u);
+
+    for (std::size_t i = 0; i < ys.size(); ++i) {
+      ys[i] = y(measurement_models[i], k + int(i));
+    }
+
+    ekf.update(measurement_models, ys);
+    ikf.update(measurement_models, ys);
+
+    EXPECT_MANIF_NEAR(ekf.getState(), ikf.getState(), 1e-8);
+    EXPECT_EIGEN_NEAR(ekf.getCovariance(), ikf.getCovariance(), 1e-8);
+  }
+}
+
+TEST_F(TEST_INFORMATION_FILTER, TEST_INFORMATION)
+{
+  IKF ikf(X_init, P_init);
+
+  EXPECT_EIGEN_NEAR(P_init.inverse(), ikf.getInformation());
+
+  const StateCovariance Y = StateCovariance::Identity() * 4.;
+  ikf.setInformation(Y);
+
+  EXPECT_EIGEN_NEAR(Y, ikf.getInformation());
+  EXPECT_EIGEN_NEAR(StateCovariance::Identity() * 0.25, ikf.getCovariance());
+
+  // The information only grows with the updates
+  const auto& h = measurement_models.front();
+  ikf.update(h, h(X_init));
+
+  const Eigen::Vector3d eig =
+    (ikf.getInformation() - Y).selfadjointView<Eigen::Lower>().eigenvalues();
+  EXPECT_GE(eig.minCoeff(), -1e-12);
+}
+
+TEST_F(TEST_INFORMATION_FILTER, TEST_SMOOTHER)
+{
+  RauchTungStriebelSmoother<EKF> ekf_smoother(X_init, P_init);
+  RauchTungStriebelSmoother<IKF> ikf_smoother(X_init, P_init);
+
+  for (int k = 0; k < 10; ++k) {
+    X_simulation = X_simulation + u;
+
+    ekf_smoother.propagate(system_model, u);
+    ikf_smoother.propagate(system_model, u);
+
+    const auto& h = measurement_models[k % measurement_models.size()];
+    ekf_smoother.update(h, y(h, k));
+    ikf_smoother.update(h, y(h, k));
+  }
+
+  const auto& Xe = ekf_smoother.smooth();
+  const auto& Xi = ikf_smoother.smooth();
+
+  ASSERT_EQ(Xe.size(), Xi.size());
+  for (std::size_t k = 0; k < Xe.size(); ++k) {
+    EXPECT_MANIF_NEAR(Xe[k], Xi[k], 1e-8);
+    EXPECT_EIGEN_NEAR(
+      ekf_smoother.getCovariances()[k], ikf_smoother.getCovariances()[k], 1e-8
+    );
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
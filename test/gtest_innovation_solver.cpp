@@ -0,0 +1,226 @@
+/**
+ * \file gtest_innovation_solver.cpp
+ *
+ * Check that the innovation solvers agree with each other,
+ * that the innovation is available after an update and
+ * that the LLT solver falls back to QR.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+/**
+ * @brief A position measurement model whose noise is not checked,
+ * e.g. negative to make the innovation covariance indefinite.
+ */
+struct UncheckedPositionModel
+  : MeasurementModelBase<UncheckedPositionModel>
+  , Linearized<MeasurementModelBase<UncheckedPositionModel>> {
+
+  using Base = MeasurementModelBase<UncheckedPositionModel>;
+  using Base::operator ();
+
+  using Measurement = Eigen::Vector2d;
+
+  explicit UncheckedPositionModel(const Eigen::Matrix2d& R) : R_(R) {}
+
+  const Eigen::Matrix2d& getCovariance() const {
+    return R_;
+  }
+
+  Measurement run(const State& x) const {
+    return x.translation();
+  }
+
+  Measurement run_linearized(
+    const State& x,
+    Eigen::Ref<Jacobian<Measurement, State>> H,
+    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+  ) const {
+    V.setIdentity();
+    H.template topLeftCorner<2, 2>() = x.rotation();
+    H.template topRightCorner<2, 1>().setZero();
+    return x.translation();
+  }
+
+  Eigen::Matrix2d R_;
+};
+
+namespace kalmanif {
+namespace internal {
+
+template <>
+struct traits<UncheckedPositionModel> {
+  using State = SE2d;
+  using Scalar = double;
+  using Measurement = Eigen::Vector2d;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+template <typename Filter>
+class TEST_INNOVATION_SOLVER : public testing::Test {
+protected:
+
+  template <typename F>
+  F run() const {
+    F filter(X_init, P_init);
+    filter.update(measurement_model, y);
+    return filter;
+  }
+
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+  Measurement y = Measurement(0.8, 1.3);
+
+  State X_init = State(0.15, -0.1, 0.1);
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+};
+
+template <InnovationSolver Solver>
+using EKF = ExtendedKalmanFilter<State, Solver>;
+
+template <InnovationSolver Solver>
+using IEKF = InvariantExtendedKalmanFilter<State, Invariance::Right, Solver>;
+
+template <template <InnovationSolver> class F>
+struct FilterTemplate {
+  template <InnovationSolver Solver>
+  using type = F<Solver>;
+};
+
+using Filters = testing::Types<FilterTemplate<EKF>, FilterTemplate<IEKF>>;
+TYPED_TEST_SUITE(TEST_INNOVATION_SOLVER, Filters);
+
+TYPED_TEST(TEST_INNOVATION_SOLVER, TEST_SOLVERS_AGREE)
+{
+  using LLT = typename TypeParam::template type<InnovationSolver::LLT>;
+  using LDLT = typename TypeParam::template type<InnovationSolver::LDLT>;
+  using QR = typename TypeParam::template type<InnovationSolver::QR>;
+
+  const auto llt = this->template run<LLT>();
+  const auto ldlt = this->template run<LDLT>();
+  const auto qr = this->template run<QR>();
+
+  EXPECT_MANIF_NEAR(llt.getState(), ldlt.getState());
+  EXPECT_MANIF_NEAR(llt.getState(), qr.getState());
+
+  EXPECT_EIGEN_NEAR(llt.getCovariance(), ldlt.getCovariance());
+  EXPECT_EIGEN_NEAR(llt.getCovariance(), qr.getCovariance());
+
+  EXPECT_NEAR(
+    llt.getNormalizedInnovationSquared(),
+    ldlt.getNormalizedInnovationSquared(),
+    1e-8
+  );
+  EXPECT_NEAR(
+    llt.getNormalizedInnovationSquared(),
+    qr.getNormalizedInnovationSquared(),
+    1e-8
+  );
+}
+
+TYPED_TEST(TEST_INNOVATION_SOLVER, TEST_INNOVATION)
+{
+  using LLT = typename TypeParam::template type<InnovationSolver::LLT>;
+
+  const auto filter = this->template run<LLT>();
+
+  ASSERT_EQ(2, filter.getInnovation().size());
+
+  const Eigen::Vector2d z = filter.getInnovation();
+  const Eigen::Matrix2d S =
+    filter.getInnovationDecomposition().reconstructedMatrix();
+
+  EXPECT_NEAR(
+    z.transpose() * S.inverse() * z,
+    filter.getNormalizedInnovationSquared(),
+    1e-8
+  );
+}
+
+struct Innovation : internal::InnovationBase<State, InnovationSolver::LLT> {
+  Innovation() = default;
+  using InnovationBase::setInnovation;
+  using InnovationBase::solveInnovation;
+};
+
+TEST(TEST_INNOVATION_FALLBACK, TEST_QR_FALLBACK)
+{
+  Innovation innovation;
+
+  const Eigen::Vector2d z(1, 1);
+
+  innovation.setInnovation(z, Eigen::Matrix2d::Identity());
+  EXPECT_FALSE(innovation.isInnovationFallback());
+
+  // Not positive definite, the Cholesky decomposition fails
+  const Eigen::Matrix2d S = (Eigen::Matrix2d() << 1, 2, 2, 1).finished();
+  innovation.setInnovation(z, S);
+  EXPECT_TRUE(innovation.isInnovationFallback());
+
+  EXPECT_NEAR(
+    z.dot(S.inverse() * z), innovation.getNormalizedInnovationSquared(), 1e-8
+  );
+
+  const Eigen::Matrix<double, 2, 3> HP =
+    (Eigen::Matrix<double, 2, 3>() << 1, 2, 3, 4, 5, 6).finished();
+  Eigen::Matrix<double, 3, 2> K;
+  innovation.solveInnovation(HP, K.transpose());
+  EXPECT_EIGEN_NEAR(Eigen::Matrix<double, 2, 3>(S.inverse() * HP), K.transpose());
+}
+
+TEST(TEST_INNOVATION_FALLBACK, TEST_FALLBACK_CLEARED)
+{
+  const State X_init(0.15, -0.1, 0.1);
+  const StateCovariance P_init = StateCovariance::Identity() * 0.1;
+  const Eigen::Vector2d y(0.2, -0.1);
+
+  ExtendedKalmanFilter<State> filter(X_init, P_init);
+  filter.setValidation(Validation::None);
+
+  // S = H.P.H^T + R is indefinite, the update falls back to QR
+  const UncheckedPositionModel indefinite(
+    Eigen::Vector2d(-1.0, 0.05).asDiagonal()
+  );
+  filter.update(indefinite, y);
+  EXPECT_TRUE(filter.isInnovationFallback());
+
+  // A well-conditioned update, decomposed in closed form,
+  // no longer uses the fallback
+  filter.setCovariance(P_init);
+  ExtendedKalmanFilter<State, InnovationSolver::LDLT> ldlt(
+    filter.getState(), P_init
+  );
+
+  const UncheckedPositionModel model(Eigen::Vector2d(1e-2, 2e-2).asDiagonal());
+  filter.update(model, y);
+  ldlt.update(model, y);
+
+  EXPECT_FALSE(filter.isInnovationFallback());
+  EXPECT_MANIF_NEAR(ldlt.getState(), filter.getState());
+  EXPECT_EIGEN_NEAR(ldlt.getCovariance(), filter.getCovariance());
+  EXPECT_NEAR(
+    ldlt.getNormalizedInnovationSquared(),
+    filter.getNormalizedInnovationSquared(),
+    1e-8
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
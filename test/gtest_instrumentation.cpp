@@ -0,0 +1,179 @@
+/**
+ * \file gtest_instrumentation.cpp
+ *
+ * Check the stages reported by the filters instrumentation.
+ */
+
+#define KALMANIF_INSTRUMENTATION kalmanif::HookInstrumentation
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/system_models/lie_system_model.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <sstream>
+#include <utility>
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+using UKFM = UnscentedKalmanFilterManifolds<State>;
+
+// The recorded stage boundaries, (stage, begins)
+using Events = std::vector<std::pair<Stage, bool>>;
+
+template <typename Filter>
+class TEST_INSTRUMENTATION : public testing::Test {
+protected:
+
+  void SetUp() override {
+    filter.getInstrumentation().setHooks(
+      [this](const Stage s){ events.emplace_back(s, true); },
+      [this](const Stage s){ events.emplace_back(s, false); }
+    );
+  }
+
+  void propagate() {
+    if constexpr (std::is_same<Filter, IEKF>::value) {
+      filter.propagate(system_model, u, 0.1);
+    } else {
+      filter.propagate(system_model, u);
+    }
+  }
+
+  //! Whether the events are well nested and contain the stage
+  bool contains(const Stage stage) const {
+    for (const auto& e : events) {
+      if (e.first == stage) return true;
+    }
+    return false;
+  }
+
+  bool isNested() const {
+    std::vector<Stage> stack;
+    for (const auto& e : events) {
+      if (e.second) {
+        stack.push_back(e.first);
+      } else {
+        if (stack.empty() || stack.back() != e.first) return false;
+        stack.pop_back();
+      }
+    }
+    return stack.empty();
+  }
+
+  Filter filter{State(0.1, -0.2, 0.05), StateCovariance::Identity() * 0.1};
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Control u = Control(0.1, 0.0, 0.05);
+
+  MeasurementModel measurement_model{
+    Landmark(2.0, 1.0), Eigen::Matrix2d::Identity() * 1e-2
+  };
+
+  Events events;
+};
+
+using Filters = testing::Types<EKF, IEKF, UKFM>;
+TYPED_TEST_SUITE(TEST_INSTRUMENTATION, Filters);
+
+TYPED_TEST(TEST_INSTRUMENTATION, TEST_PROPAGATE)
+{
+  this->propagate();
+
+  ASSERT_FALSE(this->events.empty());
+  EXPECT_TRUE(this->isNested());
+
+  EXPECT_EQ(Stage::Propagation, this->events.front().first);
+  EXPECT_EQ(Stage::Propagation, this->events.back().first);
+
+  EXPECT_TRUE(this->contains(Stage::Model));
+  EXPECT_TRUE(this->contains(Stage::Covariance));
+  EXPECT_FALSE(this->contains(Stage::Update));
+}
+
+TYPED_TEST(TEST_INSTRUMENTATION, TEST_UPDATE)
+{
+  this->filter.update(this->measurement_model, Measurement(1.9, 1.2));
+
+  ASSERT_FALSE(this->events.empty());
+  EXPECT_TRUE(this->isNested());
+
+  EXPECT_EQ(Stage::Update, this->events.front().first);
+  EXPECT_EQ(Stage::Update, this->events.back().first);
+
+  EXPECT_TRUE(this->contains(Stage::Model));
+  EXPECT_TRUE(this->contains(Stage::Gain));
+  EXPECT_TRUE(this->contains(Stage::Covariance));
+  EXPECT_FALSE(this->contains(Stage::Propagation));
+}
+
+TEST(TEST_INSTRUMENTATION_UKFM, TEST_REPAIR)
+{
+  UKFM filter(State::Identity(), StateCovariance::Identity() * 0.1);
+
+  std::size_t repairs = 0;
+  filter.getInstrumentation().setHooks(
+    nullptr, [&](const Stage s){ if (s == Stage::Repair) ++repairs; }
+  );
+
+  filter.propagate(
+    SystemModel(StateCovariance::Identity() * 1e-3), Control::Zero()
+  );
+
+  // the repair stage is timed even if no repair was needed
+  EXPECT_EQ(1u, repairs);
+}
+
+TEST(TEST_INSTRUMENTATION, TEST_TIMING)
+{
+  resetStageStatistics();
+
+  TimingInstrumentation timing;
+  for (int i = 0; i < 10; ++i) {
+    timing.begin(Stage::Gain);
+    timing.end(Stage::Gain);
+  }
+
+  const StagesStatistics statistics = collectStageStatistics();
+  const StageStatistics& gain =
+    statistics[static_cast<std::size_t>(Stage::Gain)];
+
+  EXPECT_EQ(10u, gain.count);
+  EXPECT_LE(gain.max_ns, gain.total_ns);
+
+  std::uint64_t binned = 0;
+  for (const auto c : gain.histogram) binned += c;
+  EXPECT_EQ(gain.count, binned);
+
+  EXPECT_EQ(
+    0u, statistics[static_cast<std::size_t>(Stage::Update)].count
+  );
+
+  std::ostringstream json;
+  writeJson(json, statistics);
+  EXPECT_NE(std::string::npos, json.str().find("\"gain\": {\"count\": 10"));
+
+  resetStageStatistics();
+  EXPECT_EQ(
+    0u, collectStageStatistics()[static_cast<std::size_t>(Stage::Gain)].count
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
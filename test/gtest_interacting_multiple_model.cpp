@@ -0,0 +1,215 @@
+/**
+ * \file gtest_interacting_multiple_model.cpp
+ *
+ * Check the Interacting Multiple Model estimator.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <array>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+
+class TEST_INTERACTING_MULTIPLE_MODEL : public testing::Test {
+protected:
+
+  // the measurements of the state X
+  std::array<Measurement, 3> measurements(const State& X) const {
+    std::array<Measurement, 3> ys;
+    for (int i = 0; i < 3; ++i) {
+      ys[i] = X.inverse().act(landmarks[i].getLandmark());
+    }
+    return ys;
+  }
+
+  Control u = Control(Eigen::Vector3d(0.1, 0.0, 0.05));
+
+  StateCovariance Q_quiet = StateCovariance::Identity() * 1e-6;
+  StateCovariance Q_loud = StateCovariance::Identity() * 1e-2;
+
+  SystemModel quiet = SystemModel(Q_quiet);
+  SystemModel loud = SystemModel(Q_loud);
+
+  Eigen::Matrix2d R = Eigen::Matrix2d::Identity() * 1e-4;
+  std::array<MeasurementModel, 3> landmarks = {
+    MeasurementModel(Landmark(2.0,  0.0), R),
+    MeasurementModel(Landmark(2.0,  1.0), R),
+    MeasurementModel(Landmark(2.0, -1.0), R)
+  };
+
+  State X_init = State::Identity();
+  StateCovariance P_init = StateCovariance::Identity() * 1e-3;
+};
+
+TEST_F(TEST_INTERACTING_MULTIPLE_MODEL, TEST_SINGLE_MODE)
+{
+  using IMM = InteractingMultipleModel<EKF, SystemModel>;
+
+  IMM imm(X_init, P_init, IMM::TransitionMatrix::Ones(), quiet);
+  EKF ekf(X_init, P_init);
+
+  State X = X_init;
+  for (int k = 0; k < 20; ++k) {
+    X = X + u;
+    imm.propagate(u);
+    ekf.propagate(quiet, u);
+
+    const auto ys = measurements(X);
+    for (int i = 0; i < 3; ++i) {
+      imm.update(landmarks[i], ys[i]);
+      ekf.update(landmarks[i], ys[i]);
+    }
+  }
+
+  EXPECT_DOUBLE_EQ(1., imm.getModeProbabilities()(0));
+  EXPECT_MANIF_NEAR(ekf.getState(), imm.getState(), 1e-10);
+  EXPECT_EIGEN_NEAR(ekf.getCovariance(), imm.getCovariance(), 1e-10);
+}
+
+TEST_F(TEST_INTERACTING_MULTIPLE_MODEL, TEST_IDENTICAL_MODES)
+{
+  using IMM = InteractingMultipleModel<EKF, SystemModel, SystemModel>;
+
+  IMM::TransitionMatrix Pi;
+  Pi << 0.9, 0.1,
+        0.2, 0.8;
+
+  IMM imm(X_init, P_init, Pi, quiet, quiet);
+  EKF ekf(X_init, P_init);
+
+  State X = X_init;
+  for (int k = 0; k < 20; ++k) {
+    X = X + u;
+    imm.propagate(u);
+    ekf.propagate(quiet, u);
+
+    const auto ys = measurements(X);
+    for (int i = 0; i < 3; ++i) {
+      imm.update(landmarks[i], ys[i]);
+      ekf.update(landmarks[i], ys[i]);
+    }
+  }
+
+  // the probabilities only follow the transitions,
+  // towards the stationary distribution
+  EXPECT_NEAR(2. / 3., imm.getModeProbabilities()(0), 1e-3);
+  EXPECT_NEAR(1., imm.getModeProbabilities().sum(), 1e-12);
+
+  EXPECT_MANIF_NEAR(ekf.getState(), imm.getState(), 1e-10);
+  EXPECT_EIGEN_NEAR(ekf.getCovariance(), imm.getCovariance(), 1e-10);
+}
+
+TEST_F(TEST_INTERACTING_MULTIPLE_MODEL, TEST_MANEUVER)
+{
+  using IMM = InteractingMultipleModel<EKF, SystemModel, SystemModel>;
+
+  IMM::TransitionMatrix Pi;
+  Pi << 0.95, 0.05,
+        0.05, 0.95;
+
+  IMM imm(X_init, P_init, Pi, quiet, loud);
+
+  EXPECT_EIGEN_NEAR(quiet.getCovariance(), imm.getModel<0>().getCovariance());
+  EXPECT_EIGEN_NEAR(loud.getCovariance(), imm.getModel<1>().getCovariance());
+
+  // the truth swerves at k = 20, unlike the control
+  const Control swerve(Eigen::Vector3d(0.3, 0.2, 0.3));
+
+  State X = X_init;
+  for (int k = 0; k < 40; ++k) {
+    X = X + (k == 20 ? swerve : u);
+    imm.propagate(u);
+
+    const auto ys = measurements(X);
+    for (int i = 0; i < 3; ++i) {
+      imm.update(landmarks[i], ys[i]);
+    }
+
+    if (k == 19) {
+      EXPECT_GT(imm.getModeProbabilities()(0), 0.5);
+    } else if (k == 20) {
+      EXPECT_GT(imm.getModeProbabilities()(1), 0.9);
+    }
+  }
+
+  // back to cruising
+  EXPECT_GT(imm.getModeProbabilities()(0), 0.5);
+  EXPECT_MANIF_NEAR(X, imm.getState(), 1e-2);
+}
+
+TEST_F(TEST_INTERACTING_MULTIPLE_MODEL, TEST_INVARIANT)
+{
+  using IMM = InteractingMultipleModel<IEKF, SystemModel, SystemModel>;
+
+  IMM::TransitionMatrix Pi;
+  Pi << 0.9, 0.1,
+        0.1, 0.9;
+
+  IMM imm(X_init, P_init, Pi, quiet, quiet);
+  IEKF iekf(X_init, P_init);
+
+  // the modes run concurrently
+  imm.setExecutor(ThreadPoolExecutor(2));
+
+  State X = X_init;
+  for (int k = 0; k < 20; ++k) {
+    X = X + u;
+    imm.propagate(u);
+    iekf.propagate(quiet, u);
+
+    const auto ys = measurements(X);
+    for (int i = 0; i < 3; ++i) {
+      imm.update(landmarks[i], ys[i]);
+      iekf.update(landmarks[i], ys[i]);
+    }
+  }
+
+  EXPECT_NEAR(0.5, imm.getModeProbabilities()(0), 1e-10);
+  EXPECT_MANIF_NEAR(iekf.getState(), imm.getState(), 1e-10);
+  EXPECT_EIGEN_NEAR(iekf.getCovariance(), imm.getCovariance(), 1e-10);
+  EXPECT_MANIF_NEAR(imm.getFilter(0).getState(), imm.getFilter(1).getState(), 1e-10);
+}
+
+TEST_F(TEST_INTERACTING_MULTIPLE_MODEL, TEST_INVALID_PROBABILITIES)
+{
+  using IMM = InteractingMultipleModel<EKF, SystemModel, SystemModel>;
+
+  IMM::TransitionMatrix Pi;
+  Pi << 0.9, 0.2,
+        0.1, 0.9;
+
+  EXPECT_THROW(
+    (IMM(X_init, P_init, Pi, quiet, loud)), kalmanif::invalid_argument
+  );
+
+  IMM imm(X_init, P_init, IMM::TransitionMatrix::Identity(), quiet, loud);
+
+  EXPECT_THROW(
+    imm.setModeProbabilities(IMM::ModeVector(0.7, 0.7)),
+    kalmanif::invalid_argument
+  );
+
+  imm.setModeProbabilities(IMM::ModeVector(0.25, 0.75));
+  EXPECT_EIGEN_NEAR(IMM::ModeVector(0.25, 0.75), imm.getModeProbabilities());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
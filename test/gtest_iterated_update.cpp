@@ -0,0 +1,107 @@
+/**
+ * \file gtest_iterated_update.cpp
+ *
+ * Check the iterated update of the EKF and IEKF.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+
+template <typename Filter>
+class TEST_ITERATED_UPDATE : public testing::Test {
+protected:
+
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-4, 2e-4).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+
+  // A prior far from the truth, the model is strongly nonlinear there
+  State X_true = State(0.1, -0.2, 0.05);
+  State X_init = State(0.4, 0.3, 0.6);
+  StateCovariance P_init = StateCovariance::Identity() * 0.5;
+
+  Measurement y = measurement_model(X_true);
+};
+
+using Filters = testing::Types<EKF, IEKF>;
+TYPED_TEST_SUITE(TEST_ITERATED_UPDATE, Filters);
+
+TYPED_TEST(TEST_ITERATED_UPDATE, TEST_SINGLE_ITERATION)
+{
+  TypeParam filter(this->X_init, this->P_init);
+  TypeParam iterated(this->X_init, this->P_init);
+
+  IterationBudget budget;
+  budget.max_iterations = 1;
+
+  filter.update(this->measurement_model, this->y);
+  iterated.update(this->measurement_model, this->y, budget);
+
+  EXPECT_MANIF_NEAR(filter.getState(), iterated.getState(), 1e-12);
+  EXPECT_EIGEN_NEAR(filter.getCovariance(), iterated.getCovariance(), 1e-12);
+
+  EXPECT_EQ(1u, iterated.getIterationSummary().iterations);
+  EXPECT_EQ(IterationStop::MaxIterations, iterated.getIterationSummary().stop);
+}
+
+TYPED_TEST(TEST_ITERATED_UPDATE, TEST_CONVERGENCE)
+{
+  TypeParam filter(this->X_init, this->P_init);
+  TypeParam iterated(this->X_init, this->P_init);
+
+  IterationBudget budget;
+  budget.max_iterations = 50;
+  budget.step_tolerance = 1e-10;
+
+  filter.update(this->measurement_model, this->y);
+  iterated.update(this->measurement_model, this->y, budget);
+
+  const IterationSummary& summary = iterated.getIterationSummary();
+  EXPECT_EQ(IterationStop::Converged, summary.stop);
+  EXPECT_LT(1u, summary.iterations);
+  EXPECT_GE(budget.step_tolerance, summary.step_norm);
+
+  // The iterated estimate explains the measurement better
+  const double r =
+    (this->y - this->measurement_model(filter.getState())).norm();
+  const double ri =
+    (this->y - this->measurement_model(iterated.getState())).norm();
+  EXPECT_LT(ri, r);
+
+  EXPECT_TRUE(isCovariance(iterated.getCovariance()));
+}
+
+TYPED_TEST(TEST_ITERATED_UPDATE, TEST_TIME_BUDGET)
+{
+  TypeParam iterated(this->X_init, this->P_init);
+
+  IterationBudget budget;
+  budget.max_iterations = 50;
+  budget.step_tolerance = 0;
+  budget.time_budget = std::chrono::steady_clock::duration::zero();
+
+  iterated.update(this->measurement_model, this->y, budget);
+
+  // The first linearization is always performed
+  EXPECT_EQ(1u, iterated.getIterationSummary().iterations);
+  EXPECT_EQ(IterationStop::TimeBudget, iterated.getIterationSummary().stop);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,110 @@
+/**
+ * \file gtest_jacobian_cache.cpp
+ *
+ * Check the state-independent invariant jacobians of the system models
+ * and the IEKF propagation using them.
+ */
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/system_models/simple_imu_system_model.h>
+
+#include <manif/SE2.h>
+#include <manif/SE_2_3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+TEST(TEST_JACOBIAN_CACHE, TEST_IMU_CACHE)
+{
+  using SystemModel = SimpleImuSystemModel<double>;
+  using State = SE_2_3d;
+
+  const SystemModel system_model;
+
+  const Jacobian<State, State>& F = system_model.getInvariantJacobian(0.01);
+  const Jacobian<State, State> F0 = F;
+
+  // Same dt, same cached jacobian
+  EXPECT_EQ(&F, &system_model.getInvariantJacobian(0.01));
+  EXPECT_TRUE(F0 == system_model.getInvariantJacobian(0.01));
+
+  // Rebuilt on a dt change
+  const Jacobian<State, State> F1 = system_model.getInvariantJacobian(0.02);
+  EXPECT_FALSE(F0 == F1);
+  EXPECT_EIGEN_NEAR(
+    (F1 - Jacobian<State, State>::Identity()),
+    2 * (F0 - Jacobian<State, State>::Identity()),
+    1e-15
+  );
+}
+
+TEST(TEST_JACOBIAN_CACHE, TEST_IMU_PROPAGATION)
+{
+  using SystemModel = SimpleImuSystemModel<double>;
+  using State = SE_2_3d;
+  using Control = SystemModel::Control;
+  using IEKF = InvariantExtendedKalmanFilter<State>;
+
+  constexpr double dt = 0.01;
+
+  SystemModel system_model;
+  system_model.setCovariance(Covariance<Control>::Identity() * 1e-3);
+
+  const State X_init = State::Random();
+  const Covariance<State> P_init = Covariance<State>::Identity() * 0.1;
+
+  Control u;
+  u << 0.1, 0.01, 9.9, 0.01, 0.1, 0.;
+
+  IEKF filter(X_init, P_init);
+
+  // The full linearization, as a reference
+  const LinearizedInvariant<SystemModelBase<SystemModel>>& f = system_model;
+  Jacobian<State, State> F;
+  Jacobian<State, Control> W;
+  State X = X_init;
+  Covariance<State> P = P_init;
+
+  for (int k = 0; k < 10; ++k) {
+    filter.propagate(system_model, u, dt);
+
+    X = f(X, u, F, W, dt);
+    P = F * P * F.transpose() +
+        W * system_model.getCovariance() * W.transpose();
+  }
+
+  EXPECT_MANIF_NEAR(X, filter.getState(), 1e-12);
+  EXPECT_EIGEN_NEAR(P, filter.getCovariance(), 1e-12);
+}
+
+TEST(TEST_JACOBIAN_CACHE, TEST_LIE_PROPAGATION)
+{
+  using State = SE2d;
+  using SystemModel = LieSystemModel<State>;
+  using Control = SystemModel::Control;
+  using IEKF = InvariantExtendedKalmanFilter<State>;
+
+  const SystemModel system_model(Covariance<State>::Identity() * 1e-3);
+
+  const State X_init(0.1, -0.2, 0.3);
+  const Covariance<State> P_init = Covariance<State>::Identity() * 0.1;
+  const Control u(0.1, 0.0, 0.05);
+
+  IEKF filter(X_init, P_init);
+  filter.propagate(system_model, u, 1.);
+
+  // The identity jacobian leaves only the noise term
+  const Jacobian<State, State> W = -(X_init.adj());
+  const Covariance<State> P =
+    P_init + W * system_model.getCovariance() * W.transpose();
+
+  EXPECT_MANIF_NEAR(X_init + u, filter.getState(), 1e-15);
+  EXPECT_EIGEN_NEAR(P, filter.getCovariance(), 1e-15);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
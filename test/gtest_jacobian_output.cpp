@@ -0,0 +1,124 @@
+/**
+ * \file gtest_jacobian_output.cpp
+ *
+ * Check the compile-time dispatch of the models' jacobian outputs,
+ * fixed-size jacobians being written through a concrete reference
+ * and any other argument through an Eigen::Ref.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/SE_2_3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <type_traits>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using ImuModel = SimpleImuSystemModel<double>;
+using ImuState = ImuModel::State;
+using ImuControl = ImuModel::Control;
+
+TEST(TEST_JACOBIAN_OUTPUT, TEST_DISPATCH)
+{
+  using H = Jacobian<Measurement, State>;
+
+  // A fixed-size jacobian is written through a concrete reference
+  EXPECT_TRUE((std::is_same<
+    JacobianOutput<H&, Measurement, State>, H&
+  >::value));
+  EXPECT_TRUE((std::is_same<
+    JacobianOutput<H, Measurement, State>, H&
+  >::value));
+
+  // Anything else through an Eigen::Ref
+  EXPECT_TRUE((std::is_same<
+    JacobianOutput<Eigen::Ref<H>&, Measurement, State>, Eigen::Ref<H>
+  >::value));
+  EXPECT_TRUE((std::is_same<
+    JacobianOutput<const H&, Measurement, State>, Eigen::Ref<H>
+  >::value));
+  EXPECT_TRUE((std::is_same<
+    JacobianOutput<
+      Eigen::Block<Eigen::MatrixXd, 2, 3>, Measurement, State
+    >,
+    Eigen::Ref<H>
+  >::value));
+}
+
+TEST(TEST_JACOBIAN_OUTPUT, TEST_LANDMARK_REF_FALLBACK)
+{
+  const MeasurementModel h(
+    Landmark(2.0, 1.0), Covariance<Measurement>::Identity() * 1e-2
+  );
+  const State x(0.5, -0.3, 0.7);
+
+  Jacobian<Measurement, State> H;
+  Jacobian<Measurement, Measurement> V;
+
+  // Blocks of a larger matrix, e.g. stacked measurements
+  Eigen::MatrixXd J = Eigen::MatrixXd::Zero(4, 5);
+
+  const Measurement e = h.run_linearized(x, H, V);
+  const Measurement e_ref = h.run_linearized(
+    x, J.block<2, 3>(2, 0), J.block<2, 2>(2, 3)
+  );
+
+  EXPECT_EIGEN_NEAR(e, e_ref);
+  EXPECT_EIGEN_NEAR(H, J.block(2, 0, 2, 3));
+  EXPECT_EIGEN_NEAR(V, J.block(2, 3, 2, 2));
+  EXPECT_TRUE(J.topRows(2).isZero());
+
+  const Measurement ei = h.run_linearized_invariant(x, H, V);
+  const Measurement ei_ref = h.run_linearized_invariant(
+    x, J.block<2, 3>(0, 0), J.block<2, 2>(0, 3)
+  );
+
+  EXPECT_EIGEN_NEAR(ei, ei_ref);
+  EXPECT_EIGEN_NEAR(H, J.block(0, 0, 2, 3));
+  EXPECT_EIGEN_NEAR(V, J.block(0, 3, 2, 2));
+}
+
+TEST(TEST_JACOBIAN_OUTPUT, TEST_IMU_REF_FALLBACK)
+{
+  const ImuModel f;
+  const ImuState x = ImuState::Random();
+  const ImuControl u = ImuControl::Random();
+  const double dt = 0.01;
+
+  Jacobian<ImuState, ImuState> F;
+  Jacobian<ImuState, ImuControl> W;
+
+  Eigen::MatrixXd J = Eigen::MatrixXd::Zero(9, 15);
+
+  const ImuState x_new = f.run_linearized(x, u, F, W, dt);
+  const ImuState x_ref = f.run_linearized(
+    x, u, J.leftCols<9>(), J.rightCols<6>(), dt
+  );
+
+  EXPECT_MANIF_NEAR(x_new, x_ref);
+  EXPECT_EIGEN_NEAR(F, J.leftCols(9));
+  EXPECT_EIGEN_NEAR(W, J.rightCols(6));
+
+  const ImuState xi_new = f.run_linearized_invariant(x, u, F, W, dt);
+  const ImuState xi_ref = f.run_linearized_invariant(
+    x, u, J.leftCols<9>(), J.rightCols<6>(), dt
+  );
+
+  EXPECT_MANIF_NEAR(xi_new, xi_ref);
+  EXPECT_EIGEN_NEAR(F, J.leftCols(9));
+  EXPECT_EIGEN_NEAR(W, J.rightCols(6));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,150 @@
+/**
+ * \file gtest_landmark_set.cpp
+ *
+ * Check that a landmark set measurement model is equivalent to
+ * a stacked update over the corresponding landmark measurement models.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/SE3.h>
+#include <manif/SE_2_3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <array>
+
+using namespace kalmanif;
+using namespace manif;
+
+template <typename _State, unsigned int Dim>
+struct LandmarkSetCase {
+  using State = _State;
+  using MeasurementModel = LandmarkMeasurementModel<State, Dim>;
+  using SetMeasurementModel = LandmarkSetMeasurementModel<State, Dim, 3>;
+  using Landmark = typename MeasurementModel::Landmark;
+  using Measurement = typename MeasurementModel::Measurement;
+
+  static typename SetMeasurementModel::Landmarks landmarks() {
+    typename SetMeasurementModel::Landmarks L;
+    if constexpr (Dim == 2) {
+      L << 2.0, 2.0,  1.0,
+           0.0, 1.0, -2.0;
+    } else {
+      L << 2.0,  3.0,  2.0,
+           0.0, -1.0,  1.0,
+           0.0, -1.0, -1.0;
+    }
+    return L;
+  }
+};
+
+template <typename Case>
+class TEST_LANDMARK_SET : public testing::Test {
+protected:
+
+  using State = typename Case::State;
+  using MeasurementModel = typename Case::MeasurementModel;
+  using SetMeasurementModel = typename Case::SetMeasurementModel;
+  using Landmark = typename Case::Landmark;
+  using Measurement = typename Case::Measurement;
+
+  void SetUp() override {
+    X_true = State::Random();
+    X_init = X_true + State::Tangent::Random() * 0.1;
+    P_init = Covariance<State>::Identity() * 0.1;
+
+    for (int i = 0; i < 3; ++i) {
+      measurements[i] = measurement_models[i](X_true);
+      y.template segment<Landmark::RowsAtCompileTime>(
+        i * Landmark::RowsAtCompileTime
+      ) = measurements[i];
+    }
+  }
+
+  Covariance<Landmark> R = Landmark::Constant(1e-2).asDiagonal();
+
+  std::array<MeasurementModel, 3> measurement_models = {
+    MeasurementModel(Case::landmarks().col(0), R),
+    MeasurementModel(Case::landmarks().col(1), R),
+    MeasurementModel(Case::landmarks().col(2), R)
+  };
+  std::array<Measurement, 3> measurements;
+
+  SetMeasurementModel set_measurement_model{Case::landmarks(), R};
+  typename SetMeasurementModel::Measurement y;
+
+  State X_true, X_init;
+  Covariance<State> P_init;
+};
+
+using Cases = testing::Types<
+  LandmarkSetCase<SE2d, 2>,
+  LandmarkSetCase<SE3d, 3>,
+  LandmarkSetCase<SE_2_3d, 3>
+>;
+TYPED_TEST_SUITE(TEST_LANDMARK_SET, Cases);
+
+TYPED_TEST(TEST_LANDMARK_SET, TEST_PREDICTION)
+{
+  using State = typename TypeParam::State;
+  using Landmark = typename TypeParam::Landmark;
+  using SetMeasurementModel = typename TypeParam::SetMeasurementModel;
+  using SetMeasurement = typename SetMeasurementModel::Measurement;
+  using MeasurementModel = typename TypeParam::MeasurementModel;
+  using Measurement = typename TypeParam::Measurement;
+  constexpr int Dim = Landmark::RowsAtCompileTime;
+
+  const State X = State::Random();
+
+  Jacobian<SetMeasurement, State> Hs;
+  Jacobian<SetMeasurement, SetMeasurement> Vs;
+  Jacobian<Measurement, State> H;
+  Jacobian<Measurement, Measurement> V;
+
+  const Linearized<MeasurementModelBase<SetMeasurementModel>>& hs =
+    this->set_measurement_model;
+  const SetMeasurement ys = hs(X, Hs, Vs);
+
+  for (int i = 0; i < 3; ++i) {
+    const Linearized<MeasurementModelBase<MeasurementModel>>& h =
+      this->measurement_models[i];
+    const Measurement y = h(X, H, V);
+
+    EXPECT_EIGEN_NEAR(y, ys.template segment<Dim>(i * Dim));
+    EXPECT_EIGEN_NEAR(H, Hs.template middleRows<Dim>(i * Dim));
+    EXPECT_EIGEN_NEAR(V, Vs.block(i * Dim, i * Dim, Dim, Dim));
+  }
+
+  EXPECT_EIGEN_NEAR(ys, this->set_measurement_model(X));
+}
+
+TYPED_TEST(TEST_LANDMARK_SET, TEST_VS_STACKED)
+{
+  using EKF = ExtendedKalmanFilter<typename TypeParam::State>;
+  using IEKF = InvariantExtendedKalmanFilter<typename TypeParam::State>;
+
+  EKF ekf_stacked(this->X_init, this->P_init);
+  EKF ekf_set(this->X_init, this->P_init);
+
+  ekf_stacked.update(this->measurement_models, this->measurements);
+  ekf_set.update(this->set_measurement_model, this->y);
+
+  EXPECT_MANIF_NEAR(ekf_stacked.getState(), ekf_set.getState());
+  EXPECT_EIGEN_NEAR(ekf_stacked.getCovariance(), ekf_set.getCovariance());
+
+  IEKF iekf_stacked(this->X_init, this->P_init);
+  IEKF iekf_set(this->X_init, this->P_init);
+
+  iekf_stacked.update(this->measurement_models, this->measurements);
+  iekf_set.update(this->set_measurement_model, this->y);
+
+  EXPECT_MANIF_NEAR(iekf_stacked.getState(), iekf_set.getState());
+  EXPECT_EIGEN_NEAR(iekf_stacked.getCovariance(), iekf_set.getCovariance());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,202 @@
+/**
+ * \file gtest_lazy_propagation.cpp
+ *
+ * Check that the lazy covariance propagation matches the eager one,
+ * including the transitions recorded by the smoother.
+ */
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/system_models/simple_imu_system_model.h>
+
+#include <manif/SE2.h>
+#include <manif/SE_2_3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE_2_3d;
+using SystemModel = SimpleImuSystemModel<double>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark3DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+
+template <typename Filter>
+struct ExposedSmoother : RauchTungStriebelSmoother<Filter> {
+  using RauchTungStriebelSmoother<Filter>::RauchTungStriebelSmoother;
+  using RauchTungStriebelSmoother<Filter>::epochs_;
+  using RauchTungStriebelSmoother<Filter>::filter_;
+};
+
+template <typename Filter>
+class TEST_LAZY_PROPAGATION : public testing::Test {
+protected:
+
+  void SetUp() override {
+    system_model.setCovariance(Covariance<Control>::Identity() * 1e-3);
+    u << 0.1, 0.01, 9.9, 0.01, 0.1, -0.02;
+  }
+
+  //! Propagations at a high rate, updates at a low rate
+  template <typename Estimator>
+  void run(Estimator& estimator, const int epochs) {
+    for (int k = 0; k < epochs; ++k) {
+      for (int i = 0; i < propagations; ++i) {
+        estimator.propagate(system_model, u, dt);
+      }
+      estimator.update(
+        measurement_model,
+        Measurement(1.9, 1.1, -0.4) + Measurement(0.01, -0.02, 0.) * (k % 3)
+      );
+    }
+  }
+
+  static constexpr int propagations = 5;
+  static constexpr double dt = 0.01;
+
+  SystemModel system_model;
+  Control u;
+
+  Eigen::Matrix3d R = Eigen::Matrix3d::Identity() * 1e-2;
+  MeasurementModel measurement_model{Landmark(2.0, 1.0, -0.5), R};
+
+  State X_init = State(0.05, -0.05, 0.02, 0.1, -0.2, 0.3, 0.5, -0.1, 0.2);
+  Covariance<State> P_init = Covariance<State>::Identity() * 0.1;
+};
+
+using Filters = testing::Types<EKF, IEKF>;
+TYPED_TEST_SUITE(TEST_LAZY_PROPAGATION, Filters);
+
+TYPED_TEST(TEST_LAZY_PROPAGATION, TEST_VS_EAGER)
+{
+  TypeParam eager(this->X_init, this->P_init);
+  TypeParam lazy(this->X_init, this->P_init);
+
+  EXPECT_FALSE(lazy.isLazyPropagation());
+  lazy.setLazyPropagation(true);
+  EXPECT_TRUE(lazy.isLazyPropagation());
+
+  for (int k = 0; k < 3; ++k) {
+    for (int i = 0; i < this->propagations; ++i) {
+      eager.propagate(this->system_model, this->u, this->dt);
+      lazy.propagate(this->system_model, this->u, this->dt);
+
+      // The state is propagated right away
+      EXPECT_MANIF_NEAR(eager.getState(), lazy.getState(), 1e-12);
+    }
+
+    // The covariance is materialized on query
+    EXPECT_EIGEN_NEAR(eager.getCovariance(), lazy.getCovariance(), 1e-12);
+    EXPECT_EIGEN_NEAR(
+      eager.getCovarianceSquareRoot().reconstructedMatrix(),
+      lazy.getCovarianceSquareRoot().reconstructedMatrix(),
+      1e-12
+    );
+
+    // and applied on update
+    const Measurement y(1.9, 1.1, -0.4);
+    eager.update(this->measurement_model, y);
+    lazy.update(this->measurement_model, y);
+
+    EXPECT_MANIF_NEAR(eager.getState(), lazy.getState(), 1e-12);
+    EXPECT_EIGEN_NEAR(eager.getCovariance(), lazy.getCovariance(), 1e-12);
+  }
+}
+
+TYPED_TEST(TEST_LAZY_PROPAGATION, TEST_SET_COVARIANCE)
+{
+  TypeParam filter(this->X_init, this->P_init);
+  filter.setLazyPropagation(true);
+
+  filter.propagate(this->system_model, this->u, this->dt);
+  EXPECT_FALSE(filter.getCovariance().isApprox(this->P_init));
+
+  // Setting the covariance discards the pending propagations
+  filter.setCovariance(this->P_init);
+  EXPECT_TRUE(filter.getCovariance() == this->P_init);
+
+  // Disabling the lazy mode applies them on the next propagation
+  TypeParam eager(filter.getState(), this->P_init);
+
+  filter.propagate(this->system_model, this->u, this->dt);
+  eager.propagate(this->system_model, this->u, this->dt);
+
+  filter.setLazyPropagation(false);
+
+  filter.propagate(this->system_model, this->u, this->dt);
+  eager.propagate(this->system_model, this->u, this->dt);
+
+  EXPECT_EIGEN_NEAR(eager.getCovariance(), filter.getCovariance(), 1e-12);
+}
+
+TYPED_TEST(TEST_LAZY_PROPAGATION, TEST_SMOOTHER_TRANSITION)
+{
+  constexpr int epochs = 10;
+
+  ExposedSmoother<TypeParam> eager(this->X_init, this->P_init);
+  ExposedSmoother<TypeParam> lazy(this->X_init, this->P_init);
+  lazy.filter_.setLazyPropagation(true);
+
+  this->run(eager, epochs);
+  this->run(lazy, epochs);
+
+  ASSERT_EQ(eager.epochs_.size(), lazy.epochs_.size());
+
+  // The transitions composed by the smoother
+  // match the transitions accumulated by the lazy filter
+  for (std::size_t k = 0; k < eager.epochs_.size(); ++k) {
+    const auto& e = eager.epochs_[k];
+    const auto& l = lazy.epochs_[k];
+
+    EXPECT_EIGEN_NEAR(e.A, l.A, 1e-12);
+    EXPECT_MANIF_NEAR(e.x_pred, l.x_pred, 1e-12);
+    EXPECT_EIGEN_NEAR(e.P_pred, l.P_pred, 1e-12);
+    EXPECT_EIGEN_NEAR(e.P_est, l.P_est, 1e-12);
+  }
+
+  const auto& Xs_eager = eager.smooth();
+  const auto& Xs_lazy = lazy.smooth();
+
+  ASSERT_EQ(std::size_t(epochs), Xs_lazy.size());
+  for (std::size_t k = 0; k < Xs_lazy.size(); ++k) {
+    EXPECT_MANIF_NEAR(Xs_eager[k], Xs_lazy[k], 1e-10);
+  }
+}
+
+TEST(TEST_SMOOTHER_TRANSITION, TEST_EKF_COMPOSITION)
+{
+  // The smoother transition is the product of the propagation jacobians
+  using SE2Model = LieSystemModel<SE2d>;
+
+  const SE2Model system_model(Covariance<SE2d>::Identity() * 1e-3);
+  const SE2Model::Control u(0.1, 0.0, 0.05);
+
+  ExposedSmoother<ExtendedKalmanFilter<SE2d>> smoother(
+    SE2d(0.1, -0.2, 0.3), Covariance<SE2d>::Identity() * 0.1
+  );
+
+  Jacobian<SE2d, SE2d> F, F_total = Jacobian<SE2d, SE2d>::Identity();
+  Jacobian<SE2d, SE2Model::Control> W;
+
+  const Linearized<SystemModelBase<SE2Model>>& f = system_model;
+  SE2d X(0.1, -0.2, 0.3);
+
+  for (int i = 0; i < 3; ++i) {
+    smoother.propagate(system_model, u);
+    X = f(X, u, F, W);
+    F_total = F * F_total;
+  }
+
+  // The EKF holds the transposed transition
+  EXPECT_EIGEN_NEAR(F_total.transpose(), smoother.epochs_.back().A, 1e-14);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
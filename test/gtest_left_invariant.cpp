@@ -0,0 +1,193 @@
+/**
+ * \file gtest_left_invariant.cpp
+ *
+ * Check the left invariant IEKF and UKFM against the right invariant ones.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using LandmarkModel = Landmark2DMeasurementModel<State>;
+using Landmark = LandmarkModel::Landmark;
+using GPSModel = DummyGPSMeasurementModel<State>;
+using Measurement = LandmarkModel::Measurement;
+
+template <Invariance Iv>
+using IEKF = InvariantExtendedKalmanFilter<State, Iv>;
+
+template <Invariance Iv>
+using UKFM = UnscentedKalmanFilterManifolds<State, Iv>;
+
+// The right invariant covariance given the left invariant one
+StateCovariance toRight(const State& X, const StateCovariance& P_left)
+{
+  const StateCovariance AdX = X.adj();
+  return AdX * P_left * AdX.transpose();
+}
+
+class TEST_LEFT_INVARIANT_F : public testing::Test
+{
+public:
+
+  TEST_LEFT_INVARIANT_F()
+    : system_model(StateCovariance::Identity() * 1e-3)
+    , R(Eigen::Vector2d(1e-2, 2e-2).asDiagonal())
+    , landmark_model(Landmark(2.0, 1.0), R)
+    , gps_model(R)
+    , X_init(0.05, -0.05, 0.02)
+    , P_init(StateCovariance::Identity() * 1e-2)
+    , P_init_left(
+        X_init.inverse().adj() * P_init * X_init.inverse().adj().transpose()
+      )
+  {}
+
+  /**
+   * Run both filters on the same sequence,
+   * a landmark every other step and two GPS fixes every step.
+   */
+  template <typename FilterRight, typename FilterLeft>
+  void run(
+    FilterRight& right, FilterLeft& left, const double tol_x, const double tol_P
+  ) {
+    State X = X_init;
+    const Control u(0.1, 0.0, 0.05);
+    for (int k = 0; k < 20; ++k) {
+      X = X + u;
+      right.propagate(system_model, u);
+      left.propagate(system_model, u);
+
+      if (k % 2) {
+        const Measurement y =
+          landmark_model(X) + Measurement(0.01, -0.02) * (k % 3);
+        right.update(landmark_model, y);
+        left.update(landmark_model, y);
+      }
+
+      const Measurement g = gps_model(X) + Measurement(-0.02, 0.01) * (k % 2);
+      for (int i = 0; i < 2; ++i) {
+        right.update(gps_model, g);
+        left.update(gps_model, g);
+      }
+
+      EXPECT_MANIF_NEAR(right.getState(), left.getState(), tol_x);
+      EXPECT_EIGEN_NEAR(
+        right.getCovariance(),
+        toRight(left.getState(), left.getCovariance()),
+        tol_P
+      );
+    }
+  }
+
+  SystemModel system_model;
+  Eigen::Matrix2d R;
+  LandmarkModel landmark_model;
+  GPSModel gps_model;
+
+  State X_init;
+  StateCovariance P_init;
+  StateCovariance P_init_left;
+};
+
+TEST(TEST_LEFT_INVARIANT, TEST_LIE_SYSTEM_MODEL_JACOBIANS)
+{
+  const SystemModel system_model(StateCovariance::Identity());
+  const State X(0.3, -0.2, 0.7);
+  const Control u(0.1, 0.2, -0.3);
+
+  Jacobian<State, State> F_R, F_L;
+  Jacobian<State, Control> W_R, W_L;
+
+  const State X_R = system_model.run_linearized_invariant(X, u, F_R, W_R, 1.);
+  const State X_L =
+    system_model.run_linearized_invariant<Invariance::Left>(X, u, F_L, W_L, 1.);
+
+  EXPECT_MANIF_NEAR(X_R, X_L);
+
+  // F_L = Ad_X'^-1 F_R Ad_X, W_L = Ad_X'^-1 W_R
+  const StateCovariance AdXinv = X_L.inverse().adj();
+  EXPECT_EIGEN_NEAR(AdXinv * F_R * X.adj(), F_L);
+  EXPECT_EIGEN_NEAR(AdXinv * W_R, W_L);
+
+  EXPECT_TRUE(internal::has_left_invariant_jacobian<SystemModel>::value);
+}
+
+TEST_F(TEST_LEFT_INVARIANT_F, TEST_IEKF)
+{
+  IEKF<Invariance::Right> right(X_init, P_init);
+  IEKF<Invariance::Left> left(X_init, P_init_left);
+
+  // the invariant errors only differ by the adjoint,
+  // both filters are the same to round-off
+  run(right, left, 1e-9, 1e-9);
+}
+
+TEST_F(TEST_LEFT_INVARIANT_F, TEST_IEKF_LAZY)
+{
+  IEKF<Invariance::Right> right(X_init, P_init);
+  IEKF<Invariance::Right> right_lazy(X_init, P_init);
+  right_lazy.setLazyPropagation(true);
+
+  IEKF<Invariance::Left> left(X_init, P_init_left);
+  IEKF<Invariance::Left> left_lazy(X_init, P_init_left);
+  left_lazy.setLazyPropagation(true);
+
+  // the consecutive GPS fixes only map the covariance once
+  State X = X_init;
+  const Control u(0.1, 0.0, 0.05);
+  for (int k = 0; k < 20; ++k) {
+    X = X + u;
+    right.propagate(system_model, u);
+    right_lazy.propagate(system_model, u);
+    left.propagate(system_model, u);
+    left_lazy.propagate(system_model, u);
+
+    const Measurement g = gps_model(X) + Measurement(-0.02, 0.01) * (k % 2);
+    for (int i = 0; i < 2; ++i) {
+      right.update(gps_model, g);
+      right_lazy.update(gps_model, g);
+      left.update(gps_model, g);
+      left_lazy.update(gps_model, g);
+    }
+
+    EXPECT_MANIF_NEAR(right.getState(), right_lazy.getState(), 1e-12);
+    EXPECT_EIGEN_NEAR(
+      right.getCovariance(), right_lazy.getCovariance(), 1e-12
+    );
+
+    if (k % 2) {
+      const Measurement y = landmark_model(X);
+      right.update(landmark_model, y);
+      right_lazy.update(landmark_model, y);
+      left.update(landmark_model, y);
+      left_lazy.update(landmark_model, y);
+    }
+
+    EXPECT_MANIF_NEAR(left.getState(), left_lazy.getState(), 1e-12);
+    EXPECT_EIGEN_NEAR(left.getCovariance(), left_lazy.getCovariance(), 1e-12);
+  }
+}
+
+TEST_F(TEST_LEFT_INVARIANT_F, TEST_UKFM)
+{
+  UKFM<Invariance::Right> right(X_init, P_init);
+  UKFM<Invariance::Left> left(X_init, P_init_left);
+
+  // the sigma points are retracted on either side,
+  // both filters only agree to second order
+  run(right, left, 1e-3, 1e-3);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
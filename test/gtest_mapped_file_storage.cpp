@@ -0,0 +1,135 @@
+/**
+ * \file gtest_mapped_file_storage.cpp
+ *
+ * Check the Rauch-Tung-Striebel smoother memory-mapped storage.
+ */
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/mapped_file_storage.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <sys/stat.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using ERTS = RauchTungStriebelSmoother<EKF>;
+using MappedERTS = RauchTungStriebelSmoother<EKF, MappedFileStorage>;
+
+bool fileExists(const std::string& path) {
+  struct stat buffer;
+  return ::stat(path.c_str(), &buffer) == 0;
+}
+
+class TEST_MAPPED_FILE_STORAGE : public testing::Test {
+protected:
+
+  template <typename Smoother>
+  void run(Smoother& smoother, const int epochs) const {
+    State X_simulation = State::Identity();
+    for (int k = 0; k < epochs; ++k) {
+      X_simulation = X_simulation + u;
+      smoother.propagate(system_model, u);
+      smoother.update(
+        measurement_model,
+        measurement_model(X_simulation) + Measurement(0.01, -0.02) * (k % 3)
+      );
+    }
+  }
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+  Control u = Control(0.1, 0.0, 0.05);
+
+  State X_init = State(0.05, -0.05, 0.02);
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+
+  std::string prefix = testing::TempDir() + "kalmanif_mapped_rts";
+};
+
+TEST_F(TEST_MAPPED_FILE_STORAGE, TEST_VS_IN_MEMORY)
+{
+  // More epochs than initially mapped, to remap while recording
+  constexpr int epochs = 1500;
+
+  ERTS smoother(X_init, P_init);
+  MappedERTS smoother_mapped(X_init, P_init, MappedFileStorage(prefix));
+
+  run(smoother, epochs);
+  run(smoother_mapped, epochs);
+
+  const auto& Xs = smoother.smooth();
+  const auto& Xm = smoother_mapped.smooth();
+
+  ASSERT_EQ(Xs.size(), Xm.size());
+
+  for (std::size_t k = 0; k < Xs.size(); ++k) {
+    // Same binary layout, same results
+    EXPECT_TRUE(Xs[k].coeffs() == Xm[k].coeffs());
+    EXPECT_TRUE(
+      smoother.getCovariances()[k] == smoother_mapped.getCovariances()[k]
+    );
+  }
+
+  smoother_mapped.clear();
+  EXPECT_TRUE(smoother_mapped.smooth().empty());
+}
+
+TEST_F(TEST_MAPPED_FILE_STORAGE, TEST_FILES)
+{
+  {
+    MappedERTS smoother(X_init, P_init, MappedFileStorage(prefix));
+    run(smoother, 10);
+    smoother.smooth();
+
+    EXPECT_TRUE(fileExists(prefix + ".epochs"));
+    EXPECT_TRUE(fileExists(prefix + ".states"));
+    EXPECT_TRUE(fileExists(prefix + ".covariances"));
+  }
+
+  // Removed by default
+  EXPECT_FALSE(fileExists(prefix + ".epochs"));
+  EXPECT_FALSE(fileExists(prefix + ".states"));
+  EXPECT_FALSE(fileExists(prefix + ".covariances"));
+
+  {
+    MappedERTS smoother(X_init, P_init, MappedFileStorage(prefix, true));
+    run(smoother, 10);
+    smoother.smooth();
+  }
+
+  // Kept on request, the smoothed states in their binary layout
+  struct stat buffer;
+  ASSERT_EQ(0, ::stat((prefix + ".states").c_str(), &buffer));
+  EXPECT_GE(std::size_t(buffer.st_size), 10 * sizeof(State));
+
+  for (const char* name : {".epochs", ".states", ".covariances"}) {
+    EXPECT_EQ(0, ::unlink((prefix + name).c_str()));
+  }
+}
+
+TEST(TEST_MAPPED_VECTOR, TEST_OPEN_FAILURE)
+{
+  EXPECT_THROW(
+    MappedVector<double>("/nonexistent/directory/file"),
+    kalmanif::runtime_error
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,191 @@
+/**
+ * \file gtest_measurement_scheduler.cpp
+ *
+ * Check the time-ordered measurement scheduler.
+ */
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/system_models/simple_imu_system_model.h>
+
+#include <manif/SE_2_3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <array>
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE_2_3d;
+using StateCovariance = Covariance<State>;
+using SystemModel = SimpleImuSystemModel<State::Scalar>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark3DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using UKFM = UnscentedKalmanFilterManifolds<State>;
+
+class TEST_MEASUREMENT_SCHEDULER : public testing::Test {
+protected:
+
+  void SetUp() override {
+    system_model.setCovariance(
+      Eigen::Matrix<double, 6, 6>::Identity() * 1e-6
+    );
+  }
+
+  // the control of the step k, at k * dt
+  Control control(const int k) const {
+    Control u;
+    u << 0.1, 0.01 * k, 9.80665, 0.01, 0.1, 0.;
+    return u;
+  }
+
+  // the measurements of the step k, at k * dt + dt / 2
+  std::array<Measurement, 3> measurements(const int k) const {
+    std::array<Measurement, 3> ys;
+    for (int i = 0; i < 3; ++i) {
+      ys[i] = landmarks[i].getLandmark() + Measurement::Constant(0.01 * k);
+    }
+    return ys;
+  }
+
+  double dt = 0.01;
+  SystemModel system_model;
+
+  Eigen::Matrix3d R = Eigen::Matrix3d::Identity() * 1e-4;
+  std::array<MeasurementModel, 3> landmarks = {
+    MeasurementModel(Landmark(2.0,  0.0,  0.0), R),
+    MeasurementModel(Landmark(3.0, -1.0, -1.0), R),
+    MeasurementModel(Landmark(2.0, -1.0,  1.0), R)
+  };
+
+  State X_init = State::Identity();
+  StateCovariance P_init = StateCovariance::Identity() * 1e-3;
+};
+
+TEST_F(TEST_MEASUREMENT_SCHEDULER, TEST_TIME_ORDER)
+{
+  constexpr int Steps = 20;
+
+  MeasurementScheduler<EKF, SystemModel> scheduler(
+    system_model, 0., 0.05, X_init, P_init
+  );
+  auto& stream = scheduler.addMeasurementStream<MeasurementModel>();
+
+  // the measurements are delayed by 2 steps, within the latency
+  for (int k = 0; k < Steps + 2; ++k) {
+    if (k < Steps) {
+      ASSERT_TRUE(scheduler.pushControl(k * dt, control(k)));
+    }
+    if (k >= 2) {
+      const auto ys = measurements(k - 2);
+      for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(stream.push((k - 2) * dt + dt / 2, landmarks[i], ys[i]));
+      }
+    }
+    scheduler.process();
+  }
+  scheduler.flush();
+
+  EXPECT_EQ(0u, scheduler.size());
+  EXPECT_EQ(0u, scheduler.getDroppedCount());
+  EXPECT_EQ(std::size_t(Steps), scheduler.getUpdateCount());
+  EXPECT_DOUBLE_EQ((Steps - 1) * dt + dt / 2, scheduler.getTime());
+
+  // the time steps are split at the measurements
+  EKF ekf(X_init, P_init);
+  for (int k = 0; k < Steps; ++k) {
+    if (k > 0) {
+      ekf.propagate(system_model, control(k - 1), dt / 2);
+    }
+    ekf.propagate(system_model, control(k), dt / 2);
+    ekf.update(landmarks, measurements(k));
+  }
+
+  EXPECT_EQ(std::size_t(2 * Steps - 1), scheduler.getPropagationCount());
+  EXPECT_MANIF_NEAR(ekf.getState(), scheduler.getState(), 1e-8);
+  EXPECT_EIGEN_NEAR(ekf.getCovariance(), scheduler.getCovariance(), 1e-8);
+
+  // propagated with the held control
+  scheduler.propagateTo(Steps * dt);
+  ekf.propagate(system_model, control(Steps - 1), dt / 2);
+
+  EXPECT_DOUBLE_EQ(Steps * dt, scheduler.getTime());
+  EXPECT_MANIF_NEAR(ekf.getState(), scheduler.getState(), 1e-8);
+}
+
+TEST_F(TEST_MEASUREMENT_SCHEDULER, TEST_LATENCY)
+{
+  MeasurementScheduler<EKF, SystemModel> scheduler(
+    system_model, 0., 0.05, X_init, P_init
+  );
+  auto& stream = scheduler.addMeasurementStream<MeasurementModel>();
+
+  const auto ys = measurements(0);
+
+  EXPECT_TRUE(scheduler.pushControl(0., control(0)));
+  EXPECT_TRUE(stream.push(0.02, landmarks[0], ys[0]));
+  EXPECT_TRUE(scheduler.pushControl(0.06, control(1)));
+
+  // only the inputs older than 0.06 - 0.05
+  EXPECT_EQ(1u, scheduler.process());
+  EXPECT_EQ(2u, scheduler.size());
+  EXPECT_EQ(0u, scheduler.getUpdateCount());
+
+  EXPECT_TRUE(scheduler.pushControl(0.08, control(2)));
+  EXPECT_EQ(1u, scheduler.process());
+  EXPECT_EQ(1u, scheduler.getUpdateCount());
+  EXPECT_DOUBLE_EQ(0.02, scheduler.getTime());
+
+  // older than the processed time
+  EXPECT_FALSE(stream.push(0.01, landmarks[1], ys[1]));
+  EXPECT_EQ(1u, scheduler.getDroppedCount());
+
+  EXPECT_EQ(2u, scheduler.flush());
+  EXPECT_DOUBLE_EQ(0.08, scheduler.getTime());
+
+  EXPECT_THROW(
+    (MeasurementScheduler<EKF, SystemModel>(system_model, 0., -1., X_init, P_init)),
+    kalmanif::invalid_argument
+  );
+}
+
+TEST_F(TEST_MEASUREMENT_SCHEDULER, TEST_SEQUENTIAL_FALLBACK)
+{
+  // The UKFM has no stacked update
+  EXPECT_FALSE(internal::has_stacked_update<UKFM>::value);
+  EXPECT_TRUE(internal::has_stacked_update<EKF>::value);
+
+  MeasurementScheduler<UKFM, SystemModel> scheduler(
+    system_model, 0., 0., X_init, P_init
+  );
+  auto& stream = scheduler.addMeasurementStream<MeasurementModel>();
+
+  const auto ys = measurements(0);
+
+  UKFM ukfm(X_init, P_init);
+
+  scheduler.pushControl(0., control(0));
+  for (int i = 0; i < 3; ++i) {
+    stream.push(dt, landmarks[i], ys[i]);
+  }
+  scheduler.process();
+
+  ukfm.propagate(system_model, control(0), dt);
+  for (int i = 0; i < 3; ++i) {
+    ukfm.update(landmarks[i], ys[i]);
+  }
+
+  EXPECT_EQ(1u, scheduler.getUpdateCount());
+  EXPECT_MANIF_NEAR(ukfm.getState(), scheduler.getState(), 1e-10);
+  EXPECT_EIGEN_NEAR(ukfm.getCovariance(), scheduler.getCovariance(), 1e-10);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
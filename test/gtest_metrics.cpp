@@ -0,0 +1,212 @@
+/**
+ * \file gtest_metrics.cpp
+ *
+ * Check the streaming trajectory metrics against their post-hoc definitions.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/SE3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+namespace {
+
+template <typename LieGroup>
+using Trajectory = std::vector<LieGroup, Eigen::aligned_allocator<LieGroup>>;
+
+template <typename LieGroup>
+struct Trajectories {
+  Trajectory<LieGroup> Xs_true, Xs_est;
+  std::vector<double> time;
+};
+
+template <typename LieGroup>
+Trajectories<LieGroup> randomTrajectories(const int n, const double dt) {
+  using Tangent = typename LieGroup::Tangent;
+
+  Trajectories<LieGroup> trajectories;
+  LieGroup X = LieGroup::Identity();
+  for (int i = 0; i < n; ++i) {
+    X = X + Tangent::Random() * 0.1;
+    trajectories.Xs_true.push_back(X);
+    trajectories.Xs_est.push_back(X + Tangent::Random() * 0.05);
+    trajectories.time.push_back(i * dt);
+  }
+  return trajectories;
+}
+
+template <typename LieGroup>
+void checkPostHoc(const Trajectories<LieGroup>& tr, const double window) {
+  using Tangent = typename LieGroup::Tangent;
+  using pose_error = internal::pose_error<LieGroup>;
+
+  TrajectoryMetrics<LieGroup> metrics(window);
+  for (std::size_t i = 0; i < tr.time.size(); ++i) {
+    metrics.add(tr.Xs_true[i], tr.Xs_est[i], tr.time[i]);
+  }
+
+  double se = 0, te = 0, oe = 0;
+  for (std::size_t i = 0; i < tr.time.size(); ++i) {
+    const Tangent dX = tr.Xs_est[i] - tr.Xs_true[i];
+    se += dX.squaredWeightedNorm();
+    te += pose_error::squaredTranslation(dX);
+    oe += pose_error::orientation(dX);
+  }
+
+  const double n = double(tr.time.size());
+  EXPECT_NEAR(std::sqrt(se / n), metrics.rmse(), 1e-12);
+  EXPECT_NEAR(std::sqrt(te / n), metrics.ate(), 1e-12);
+  EXPECT_NEAR(oe / n, metrics.aoe(), 1e-12);
+
+  // The relative errors since a reference renewed once older than the window
+  double rse = 0, rte = 0, roe = 0;
+  std::size_t ref = 0, m = 0;
+  for (std::size_t i = 1; i < tr.time.size(); ++i) {
+    if (tr.time[i] - tr.time[ref] > window) {
+      ref = i;
+      continue;
+    }
+    const Tangent dX = tr.Xs_est[ref].between(tr.Xs_est[i]) -
+                       tr.Xs_true[ref].between(tr.Xs_true[i]);
+    rse += dX.squaredWeightedNorm();
+    rte += pose_error::squaredTranslation(dX);
+    roe += pose_error::orientation(dX);
+    ++m;
+  }
+
+  ASSERT_GT(m, 0u);
+  EXPECT_NEAR(std::sqrt(rse / m), metrics.rrmse(), 1e-12);
+  EXPECT_NEAR(std::sqrt(rte / m), metrics.rte(), 1e-12);
+  EXPECT_NEAR(roe / m, metrics.roe(), 1e-12);
+
+  EXPECT_NEAR(
+    (tr.Xs_est.back() - tr.Xs_true.back()).weightedNorm(), metrics.fpe(), 1e-12
+  );
+
+  EXPECT_EQ(tr.time.size(), metrics.count());
+}
+
+} // namespace
+
+TEST(TEST_METRICS, TEST_RUNNING_STATISTICS_MERGE)
+{
+  const Eigen::VectorXd x = Eigen::VectorXd::Random(101);
+
+  RunningStatistics all, lhs, rhs;
+  for (Eigen::Index i = 0; i < x.size(); ++i) {
+    all.add(x(i));
+    (i < 40 ? lhs : rhs).add(x(i));
+  }
+  lhs.merge(rhs);
+
+  EXPECT_EQ(all.count, lhs.count);
+  EXPECT_NEAR(x.mean(), all.mean, 1e-14);
+  EXPECT_NEAR(all.mean, lhs.mean, 1e-14);
+  EXPECT_NEAR(all.variance(), lhs.variance(), 1e-14);
+  EXPECT_NEAR(
+    (x.array() - x.mean()).square().sum() / double(x.size() - 1),
+    all.variance(), 1e-14
+  );
+}
+
+TEST(TEST_METRICS, TEST_POST_HOC_SE2)
+{
+  checkPostHoc(randomTrajectories<SE2d>(200, 0.1), 1.);
+}
+
+TEST(TEST_METRICS, TEST_POST_HOC_SE3)
+{
+  checkPostHoc(randomTrajectories<SE3d>(200, 0.1), 0.35);
+}
+
+TEST(TEST_METRICS, TEST_MERGE_TRIALS)
+{
+  using State = SE3d;
+
+  const auto tr0 = randomTrajectories<State>(100, 0.1);
+  const auto tr1 = randomTrajectories<State>(150, 0.1);
+
+  // Sequentially, ending the trajectories
+  TrajectoryMetrics<State> sequential;
+  for (std::size_t i = 0; i < tr0.time.size(); ++i) {
+    sequential.add(tr0.Xs_true[i], tr0.Xs_est[i], tr0.time[i]);
+  }
+  sequential.endTrajectory();
+  for (std::size_t i = 0; i < tr1.time.size(); ++i) {
+    sequential.add(tr1.Xs_true[i], tr1.Xs_est[i], tr1.time[i]);
+  }
+
+  // Per trial, then reduced
+  TrajectoryMetrics<State> m0, m1, reduced;
+  for (std::size_t i = 0; i < tr0.time.size(); ++i) {
+    m0.add(tr0.Xs_true[i], tr0.Xs_est[i], tr0.time[i]);
+  }
+  for (std::size_t i = 0; i < tr1.time.size(); ++i) {
+    m1.add(tr1.Xs_true[i], tr1.Xs_est[i], tr1.time[i]);
+  }
+  reduced.merge(m1);
+  reduced.merge(m0);
+
+  EXPECT_EQ(sequential.count(), reduced.count());
+  EXPECT_NEAR(sequential.rmse(), reduced.rmse(), 1e-12);
+  EXPECT_NEAR(sequential.ate(), reduced.ate(), 1e-12);
+  EXPECT_NEAR(sequential.aoe(), reduced.aoe(), 1e-12);
+  EXPECT_NEAR(sequential.rrmse(), reduced.rrmse(), 1e-12);
+  EXPECT_NEAR(sequential.rte(), reduced.rte(), 1e-12);
+  EXPECT_NEAR(sequential.roe(), reduced.roe(), 1e-12);
+  EXPECT_NEAR(
+    sequential.squaredError().variance(),
+    reduced.squaredError().variance(), 1e-12
+  );
+
+  EXPECT_EQ(2u, reduced.finalError().count);
+  EXPECT_NEAR(
+    0.5 * (m0.fpe() + m1.fpe()), reduced.fpe(), 1e-12
+  );
+  EXPECT_NEAR(sequential.fpe(), reduced.fpe(), 1e-12);
+}
+
+TEST(TEST_METRICS, TEST_NEES)
+{
+  using State = SE2d;
+  using StateCovariance = Covariance<State>;
+  using EKF = ExtendedKalmanFilter<State>;
+  using IEKF = InvariantExtendedKalmanFilter<State>;
+
+  StateCovariance P = StateCovariance::Identity() * 0.1;
+  P(0, 1) = P(1, 0) = 0.02;
+
+  const State X_true(0.1, -0.2, 0.3);
+  const State X_est(0.15, -0.1, 0.25);
+
+  EKF ekf(X_est, P);
+  IEKF iekf(X_est, P);
+
+  TrajectoryMetrics<State> m_ekf, m_iekf;
+  m_ekf.collect(X_true, ekf, 0.);
+  m_iekf.collect(X_true, iekf, 0.);
+
+  const Eigen::Vector3d e_r = X_est.rminus(X_true).coeffs();
+  const Eigen::Vector3d e_l = X_est.lminus(X_true).coeffs();
+
+  EXPECT_NEAR(e_r.dot(P.ldlt().solve(e_r)), m_ekf.nees(), 1e-10);
+  EXPECT_NEAR(e_l.dot(P.ldlt().solve(e_l)), m_iekf.nees(), 1e-10);
+  EXPECT_NEAR(m_ekf.rmse(), m_iekf.rmse(), 1e-14);
+}
+
+TEST(TEST_METRICS, TEST_INVALID_WINDOW)
+{
+  EXPECT_THROW(TrajectoryMetrics<SE2d>(-1), kalmanif::invalid_argument);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
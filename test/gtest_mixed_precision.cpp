@@ -0,0 +1,132 @@
+/**
+ * \file gtest_mixed_precision.cpp
+ *
+ * Check the filters on float states accumulating in double.
+ */
+
+#define KALMANIF_MIXED_PRECISION
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+static_assert(
+  std::is_same<internal::accumulator<float>::type, double>{},
+  "Expected float to accumulate in double."
+);
+static_assert(
+  std::is_same<internal::accumulator<double>::type, double>{},
+  "Expected double to accumulate in double."
+);
+
+template <typename _Scalar>
+struct Models {
+  using Scalar = _Scalar;
+  using State = SE2<Scalar>;
+  using StateCovariance = Covariance<State>;
+  using SystemModel = LieSystemModel<State>;
+  using Control = typename SystemModel::Control;
+  using MeasurementModel = Landmark2DMeasurementModel<State>;
+  using Landmark = typename MeasurementModel::Landmark;
+  using Measurement = typename MeasurementModel::Measurement;
+
+  SystemModel system_model{StateCovariance::Identity() * Scalar(1e-3)};
+  Eigen::Matrix<Scalar, 2, 2> R =
+    Eigen::Matrix<Scalar, 2, 1>(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+  Control u = Control(0.1, 0.0, 0.05);
+  Scalar dt = 0.1;
+
+  State X_init = State(0.05, -0.05, 0.02);
+  StateCovariance P_init = StateCovariance::Identity() * Scalar(0.1);
+
+  template <typename Filter>
+  void run(Filter& filter, const int epochs) const {
+    State X_simulation = State::Identity();
+    for (int k = 0; k < epochs; ++k) {
+      X_simulation = X_simulation + u;
+
+      if constexpr (std::is_base_of<
+        InvariantExtendedKalmanFilter<State>, Filter
+      >{}) {
+        filter.propagate(system_model, u, dt);
+      } else {
+        filter.propagate(system_model, u);
+      }
+
+      filter.update(
+        measurement_model,
+        measurement_model(X_simulation) +
+          Measurement(0.01, -0.02) * Scalar(k % 3)
+      );
+    }
+  }
+};
+
+template <template <typename> class Filter>
+struct FilterTemplate {
+  template <typename Scalar>
+  using type = Filter<SE2<Scalar>>;
+};
+
+template <typename State>
+using EKF = ExtendedKalmanFilter<State>;
+
+template <typename Filter>
+class TEST_MIXED_PRECISION : public testing::Test {
+protected:
+  Models<float> float_models;
+  Models<double> double_models;
+};
+
+using Filters = testing::Types<
+  FilterTemplate<EKF>,
+  FilterTemplate<InvariantExtendedKalmanFilter>
+>;
+TYPED_TEST_SUITE(TEST_MIXED_PRECISION, Filters);
+
+TYPED_TEST(TEST_MIXED_PRECISION, TEST_VS_DOUBLE)
+{
+  using FilterF = typename TypeParam::template type<float>;
+  using FilterD = typename TypeParam::template type<double>;
+
+  constexpr int epochs = 50;
+
+  FilterF filter_f(this->float_models.X_init, this->float_models.P_init);
+  FilterD filter_d(this->double_models.X_init, this->double_models.P_init);
+
+  this->float_models.run(filter_f, epochs);
+  this->double_models.run(filter_d, epochs);
+
+  // Stored in float
+  static_assert(
+    std::is_same<
+      typename std::decay<decltype(filter_f.getCovariance())>::type,
+      Covariance<SE2f>
+    >{},
+    "Expected a float covariance."
+  );
+
+  EXPECT_TRUE(isCovariance(filter_f.getCovariance()));
+
+  EXPECT_EIGEN_NEAR(
+    filter_f.getState().coeffs().template cast<double>(),
+    filter_d.getState().coeffs(),
+    1e-4
+  );
+  EXPECT_EIGEN_NEAR(
+    filter_f.getCovariance().template cast<double>(),
+    filter_d.getCovariance(),
+    1e-5
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
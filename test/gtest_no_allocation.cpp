@@ -0,0 +1,122 @@
+/**
+ * \file gtest_no_allocation.cpp
+ *
+ * Check that the filters steady-state propagation and updates
+ * do not allocate on the heap.
+ *
+ * The allocations are counted by the hooks of allocation_hooks.h.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/SE3.h>
+#include <manif/SE_2_3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include "allocation_hooks.h"
+
+using namespace kalmanif;
+using namespace manif;
+
+/**
+ * @brief The models of the steady-state loop for a given state.
+ */
+template <typename State, typename = void>
+struct Setup {
+  using SystemModel = LieSystemModel<State>;
+  using MeasurementModel = Landmark3DMeasurementModel<State>;
+};
+
+template <typename State>
+struct Setup<State, std::enable_if_t<State::Dim == 2>> {
+  using SystemModel = LieSystemModel<State>;
+  using MeasurementModel = Landmark2DMeasurementModel<State>;
+};
+
+template <typename Filter>
+class TEST_NO_ALLOCATION : public testing::Test {
+protected:
+
+  using State = typename Filter::State;
+  using SystemModel = typename Setup<State>::SystemModel;
+  using MeasurementModel = typename Setup<State>::MeasurementModel;
+  using Control = typename SystemModel::Control;
+  using Landmark = typename MeasurementModel::Landmark;
+  using Measurement = typename MeasurementModel::Measurement;
+
+  static constexpr bool Invariant =
+    std::is_same<Filter, InvariantExtendedKalmanFilter<State>>::value;
+
+  //! One steady-state step, a propagation and two updates
+  void step(Filter& filter) {
+    if constexpr (Invariant) {
+      filter.propagate(system_model, u, dt);
+    } else {
+      filter.propagate(system_model, u);
+    }
+
+    for (std::size_t i = 0; i < measurement_models.size(); ++i) {
+      filter.update(measurement_models[i], measurements[i]);
+    }
+  }
+
+  const double dt = 0.01;
+
+  const SystemModel system_model{Covariance<State>::Identity() * 1e-4};
+  const Control u = Control::Random() * 0.01;
+
+  Covariance<Measurement> R = Covariance<Measurement>::Identity() * 1e-2;
+  const std::array<MeasurementModel, 2> measurement_models{{
+    MeasurementModel(Landmark::Ones(), R),
+    MeasurementModel(-Landmark::Ones(), R)
+  }};
+  const std::array<Measurement, 2> measurements{{
+    Measurement::Ones() * 0.9, -Measurement::Ones() * 1.1
+  }};
+
+  Filter filter{State::Identity(), Covariance<State>::Identity() * 0.1};
+};
+
+#define __KALMANIF_FILTERS(State)                \
+  ExtendedKalmanFilter<State>,                   \
+  SquareRootExtendedKalmanFilter<State>,         \
+  InvariantExtendedKalmanFilter<State>,          \
+  UnscentedKalmanFilterManifolds<State>
+
+using Filters = testing::Types<
+  __KALMANIF_FILTERS(SE2d),
+  __KALMANIF_FILTERS(SE3d),
+  __KALMANIF_FILTERS(SE_2_3d)
+>;
+
+#undef __KALMANIF_FILTERS
+
+TYPED_TEST_SUITE(TEST_NO_ALLOCATION, Filters);
+
+TYPED_TEST(TEST_NO_ALLOCATION, TEST_HOOK)
+{
+  startCounting();
+  std::unique_ptr<int> ptr(new int(1));
+  EXPECT_LT(0u, stopCounting());
+}
+
+TYPED_TEST(TEST_NO_ALLOCATION, TEST_STEADY_STATE)
+{
+  // Warm up
+  this->step(this->filter);
+
+  startCounting();
+  for (int i = 0; i < 10; ++i) {
+    this->step(this->filter);
+  }
+  EXPECT_EQ(0u, stopCounting());
+
+  EXPECT_TRUE(isCovariance(this->filter.getCovariance()));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,167 @@
+/**
+ * \file gtest_out_of_sequence.cpp
+ *
+ * Check that out-of-sequence measurements are applied
+ * as if they had arrived in sequence.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+
+template <typename Filter>
+class TEST_OUT_OF_SEQUENCE : public testing::Test {
+protected:
+
+  void SetUp() override {
+    State X_simulation = State::Identity();
+    for (int k = 0; k < epochs; ++k) {
+      X_simulation = X_simulation + u;
+      X.push_back(X_simulation);
+    }
+  }
+
+  template <typename F>
+  void propagate(F& filter, const int k) const {
+    if constexpr (std::is_same<Filter, IEKF>{}) {
+      filter.propagate(time(k), system_model, u, dt);
+    } else {
+      filter.propagate(time(k), system_model, u);
+    }
+  }
+
+  void propagate(Filter& filter) const {
+    if constexpr (std::is_same<Filter, IEKF>{}) {
+      filter.propagate(system_model, u, dt);
+    } else {
+      filter.propagate(system_model, u);
+    }
+  }
+
+  double time(const int k) const {
+    return dt * (k + 1);
+  }
+
+  Measurement y(const MeasurementModel& h, const int k) const {
+    return h(X[k]) + Measurement(0.01, -0.02) * double(k % 3);
+  }
+
+  static constexpr int epochs = 20;
+  static constexpr int delay = 3;
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel camera{Landmark(2.0, 1.0), R};
+  MeasurementModel beacon{Landmark(-1.0, 3.0), R};
+  Control u = Control(0.1, 0.0, 0.05);
+  double dt = 0.1;
+
+  std::vector<State> X;
+
+  State X_init = State(0.05, -0.05, 0.02);
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+};
+
+using Filters = testing::Types<EKF, IEKF>;
+TYPED_TEST_SUITE(TEST_OUT_OF_SEQUENCE, Filters);
+
+TYPED_TEST(TEST_OUT_OF_SEQUENCE, TEST_VS_IN_SEQUENCE)
+{
+  // The in sequence reference
+  TypeParam reference(this->X_init, this->P_init);
+
+  OutOfSequenceFilter<TypeParam> filter(
+    this->X_init, this->P_init, 0, 1.0
+  );
+
+  for (int k = 0; k < this->epochs; ++k) {
+    this->propagate(reference);
+    this->propagate(filter, k);
+
+    // In sequence beacon, every other step
+    if (k % 2 == 0) {
+      reference.update(this->beacon, this->y(this->beacon, k));
+      EXPECT_TRUE(filter.update(
+        this->time(k), this->beacon, this->y(this->beacon, k)
+      ));
+    }
+
+    // Camera frame of the step k, in sequence for the reference
+    reference.update(this->camera, this->y(this->camera, k));
+
+    // and delayed for the filter, between two propagations
+    if (k >= this->delay) {
+      const int kd = k - this->delay;
+      EXPECT_TRUE(filter.update(
+        this->time(kd) + 0.5 * this->dt, this->camera,
+        this->y(this->camera, kd)
+      ));
+    }
+  }
+
+  // Flush the last delayed frames, before checking
+  for (int kd = this->epochs - this->delay; kd < this->epochs; ++kd) {
+    EXPECT_TRUE(filter.update(
+      this->time(kd) + 0.5 * this->dt, this->camera, this->y(this->camera, kd)
+    ));
+  }
+
+  // Re-linearized replay is exact, the IEKF replay with the stored
+  // jacobians is to first order on the corrections
+  const double tol = std::is_same<TypeParam, IEKF>{} ? 1e-3 : 1e-10;
+
+  EXPECT_MANIF_NEAR(reference.getState(), filter.getState(), tol);
+  EXPECT_EIGEN_NEAR(reference.getCovariance(), filter.getCovariance(), tol);
+}
+
+TYPED_TEST(TEST_OUT_OF_SEQUENCE, TEST_HORIZON)
+{
+  OutOfSequenceFilter<TypeParam> filter(
+    this->X_init, this->P_init, 0, 0.35
+  );
+
+  for (int k = 0; k < 10; ++k) {
+    this->propagate(filter, k);
+  }
+
+  EXPECT_EQ(4u, filter.size());
+
+  const State X = filter.getState();
+
+  // Older than the horizon, dropped
+  EXPECT_FALSE(
+    filter.update(this->time(3), this->camera, this->y(this->camera, 3))
+  );
+  EXPECT_TRUE(X.coeffs() == filter.getState().coeffs());
+
+  EXPECT_TRUE(
+    filter.update(this->time(7), this->camera, this->y(this->camera, 7))
+  );
+  EXPECT_EQ(5u, filter.size());
+
+  // Propagations must be in sequence
+  EXPECT_THROW(this->propagate(filter, 5), kalmanif::invalid_argument);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+/**
+ * \file gtest_parallel_smoother.cpp
+ *
+ * Check that the parallel-in-time smoother matches
+ * the sequential Rauch-Tung-Striebel smoother.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using SEKF = SquareRootExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+using UKFM = UnscentedKalmanFilterManifolds<State>;
+
+template <typename Filter>
+class TEST_PARALLEL_SMOOTHER : public testing::Test {
+protected:
+
+  template <typename Smoother>
+  void run(Smoother& smoother, const int epochs) const {
+    State X_simulation = State::Identity();
+    for (int k = 0; k < epochs; ++k) {
+      X_simulation = X_simulation + u;
+
+      if constexpr (std::is_same<Filter, IEKF>{}) {
+        smoother.propagate(system_model, u, dt);
+      } else {
+        smoother.propagate(system_model, u);
+      }
+
+      smoother.update(
+        measurement_models[k % 2],
+        measurement_models[k % 2](X_simulation) +
+          Measurement(0.05, -0.1) * ((k % 3) - 1)
+      );
+    }
+  }
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_models[2] = {
+    MeasurementModel(Landmark(2.0, 1.0), R),
+    MeasurementModel(Landmark(-1.0, 2.0), R)
+  };
+  Control u = Control(0.1, 0.0, 0.05);
+  double dt = 0.1;
+
+  State X_init = State(0.2, -0.2, 0.1);
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+};
+
+using Filters = testing::Types<EKF, SEKF, IEKF, UKFM>;
+TYPED_TEST_SUITE(TEST_PARALLEL_SMOOTHER, Filters);
+
+TYPED_TEST(TEST_PARALLEL_SMOOTHER, TEST_VS_SEQUENTIAL)
+{
+  // Odd size, not a power of two
+  constexpr int epochs = 37;
+
+  RauchTungStriebelSmoother<TypeParam> sequential(this->X_init, this->P_init);
+  ParallelRauchTungStriebelSmoother<TypeParam> parallel(
+    this->X_init, this->P_init, 3, ThreadPoolExecutor(4)
+  );
+
+  this->run(sequential, epochs);
+  this->run(parallel, epochs);
+
+  const auto& Xs = sequential.smooth();
+  const auto& Xp = parallel.smooth();
+
+  ASSERT_EQ(Xs.size(), Xp.size());
+
+  for (std::size_t k = 0; k < Xs.size(); ++k) {
+    EXPECT_MANIF_NEAR(Xs[k], Xp[k], 1e-8);
+    EXPECT_EIGEN_NEAR(
+      sequential.getCovariances()[k], parallel.getCovariances()[k], 1e-8
+    );
+  }
+}
+
+TYPED_TEST(TEST_PARALLEL_SMOOTHER, TEST_SIZES)
+{
+  for (int epochs : {0, 1, 2, 3, 8, 9}) {
+    RauchTungStriebelSmoother<TypeParam> sequential(this->X_init, this->P_init);
+    ParallelRauchTungStriebelSmoother<TypeParam, SequentialExecutor> parallel(
+      this->X_init, this->P_init
+    );
+
+    this->run(sequential, epochs);
+    this->run(parallel, epochs);
+
+    const auto& Xs = sequential.smooth();
+    const auto& Xp = parallel.smooth();
+
+    ASSERT_EQ(std::size_t(epochs), Xp.size());
+
+    for (std::size_t k = 0; k < Xs.size(); ++k) {
+      EXPECT_MANIF_NEAR(Xs[k], Xp[k], 1e-8);
+    }
+  }
+}
+
+TEST(TEST_PARALLEL_SMOOTHER_ARGS, TEST_ITERATIONS)
+{
+  using Smoother = ParallelRauchTungStriebelSmoother<EKF, SequentialExecutor>;
+
+  EXPECT_THROW(
+    Smoother(State::Identity(), StateCovariance::Identity(), 0),
+    kalmanif::invalid_argument
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,176 @@
+/**
+ * \file gtest_particle_filter.cpp
+ *
+ * Check the particle filter on Lie groups.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <array>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using PF = ParticleFilter<State>;
+
+class TEST_PARTICLE_FILTER : public testing::Test {
+protected:
+
+  std::array<Measurement, 3> measurements(const State& X) const {
+    std::array<Measurement, 3> ys;
+    for (int i = 0; i < 3; ++i) {
+      ys[i] = X.inverse().act(landmarks[i].getLandmark());
+    }
+    return ys;
+  }
+
+  Control u = Control(Eigen::Vector3d(0.1, 0.0, 0.05));
+
+  SystemModel system_model = SystemModel(StateCovariance::Identity() * 1e-4);
+
+  Eigen::Matrix2d R = Eigen::Matrix2d::Identity() * 1e-2;
+  std::array<MeasurementModel, 3> landmarks = {
+    MeasurementModel(Landmark(2.0,  0.0), R),
+    MeasurementModel(Landmark(2.0,  1.0), R),
+    MeasurementModel(Landmark(2.0, -1.0), R)
+  };
+
+  State X_init = State(0.5, -0.2, 0.1);
+  StateCovariance P_init = StateCovariance::Identity() * 1e-2;
+};
+
+TEST_F(TEST_PARTICLE_FILTER, TEST_SAMPLING)
+{
+  PF pf(X_init, P_init, 20000, 1);
+
+  EXPECT_EQ(20000, pf.size());
+  EXPECT_NEAR(20000., pf.getEffectiveSampleSize(), 1e-6);
+
+  EXPECT_MANIF_NEAR(X_init, pf.getState(), 5e-3);
+  EXPECT_EIGEN_NEAR(P_init, pf.getCovariance(), 1e-3);
+}
+
+TEST_F(TEST_PARTICLE_FILTER, TEST_TRACKING)
+{
+  PF pf(X_init, P_init, 5000, 2);
+  EKF ekf(X_init, P_init);
+
+  State X = X_init;
+  for (int k = 0; k < 20; ++k) {
+    X = X + u;
+    pf.propagate(system_model, u);
+    ekf.propagate(system_model, u);
+
+    const auto ys = measurements(X);
+    for (int i = 0; i < 3; ++i) {
+      pf.update(landmarks[i], ys[i]);
+      ekf.update(landmarks[i], ys[i]);
+    }
+  }
+
+  EXPECT_GT(pf.getResampleCount(), 0u);
+  EXPECT_MANIF_NEAR(X, pf.getState(), 2e-2);
+  EXPECT_MANIF_NEAR(ekf.getState(), pf.getState(), 2e-2);
+  EXPECT_EIGEN_NEAR(ekf.getCovariance(), pf.getCovariance(), 5e-3);
+}
+
+TEST_F(TEST_PARTICLE_FILTER, TEST_MULTIMODAL)
+{
+  // half the particles at each of two hypotheses
+  const State X_a(0.0, 0.0, 0.0);
+  const State X_b(0.0, 0.0, 3.0);
+
+  PF::Particles particles(State::RepSize, 2000);
+  for (int i = 0; i < particles.cols(); ++i) {
+    particles.col(i) = (i % 2 ? X_a : X_b).coeffs();
+  }
+
+  PF pf(X_a, 1, 3);
+  pf.setParticles(particles);
+
+  EXPECT_NEAR(1., pf.getWeights().sum(), 1e-12);
+
+  const auto ys = measurements(X_a);
+  pf.update(landmarks[0], ys[0]);
+
+  EXPECT_EQ(1u, pf.getResampleCount());
+  EXPECT_MANIF_NEAR(X_a, pf.getState(), 1e-10);
+  EXPECT_MANIF_NEAR(X_a, pf.getParticle(1999), 1e-10);
+}
+
+TEST_F(TEST_PARTICLE_FILTER, TEST_RESAMPLE)
+{
+  PF pf(X_init, P_init, 1000, 4);
+
+  // with uniform weights, each particle is kept once
+  const PF::Particles particles = pf.getParticles();
+  pf.resample();
+
+  EXPECT_EIGEN_NEAR(particles, pf.getParticles());
+  EXPECT_EQ(1u, pf.getResampleCount());
+
+  // no resampling
+  pf.setResamplingThreshold(0);
+  pf.update(landmarks[0], measurements(X_init)[0]);
+
+  EXPECT_EQ(1u, pf.getResampleCount());
+  EXPECT_LT(pf.getEffectiveSampleSize(), 1000.);
+  EXPECT_NEAR(1., pf.getWeights().sum(), 1e-12);
+}
+
+TEST_F(TEST_PARTICLE_FILTER, TEST_EXECUTOR)
+{
+  // the random draws do not depend on the executor
+  PF pf(X_init, P_init, 3000, 5);
+  ParticleFilter<State, ThreadPoolExecutor> pf_mt(
+    X_init, P_init, 3000, 5, ThreadPoolExecutor(4)
+  );
+
+  State X = X_init;
+  for (int k = 0; k < 10; ++k) {
+    X = X + u;
+    pf.propagate(system_model, u);
+    pf_mt.propagate(system_model, u);
+
+    const auto ys = measurements(X);
+    for (int i = 0; i < 3; ++i) {
+      pf.update(landmarks[i], ys[i]);
+      pf_mt.update(landmarks[i], ys[i]);
+    }
+  }
+
+  EXPECT_EIGEN_NEAR(pf.getParticles(), pf_mt.getParticles(), 1e-12);
+  EXPECT_EIGEN_NEAR(pf.getWeights(), pf_mt.getWeights(), 1e-12);
+  EXPECT_MANIF_NEAR(pf.getState(), pf_mt.getState(), 1e-12);
+}
+
+TEST_F(TEST_PARTICLE_FILTER, TEST_INVALID_ARGUMENTS)
+{
+  EXPECT_THROW((PF(X_init, 0)), kalmanif::invalid_argument);
+
+  PF pf(X_init, 10);
+
+  EXPECT_THROW(pf.setResamplingThreshold(2), kalmanif::invalid_argument);
+  EXPECT_THROW(
+    pf.setParticles(PF::Particles(State::RepSize, 0)),
+    kalmanif::invalid_argument
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,189 @@
+/**
+ * \file gtest_precomputed_noise.cpp
+ *
+ * Check that the filters propagate a model's precomputed noise
+ * as they would its noise jacobian and covariance.
+ */
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/system_models/lie_system_model.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <limits>
+
+using namespace kalmanif;
+using namespace manif;
+
+/**
+ * @brief A constant velocity model whose noise jacobian
+ * W = dt.I is state-independent, optionally declared as such.
+ */
+template <bool Precomputed>
+struct ConstantNoiseSystemModel
+  : SystemModelBase<ConstantNoiseSystemModel<Precomputed>>
+  , Linearized<SystemModelBase<ConstantNoiseSystemModel<Precomputed>>>
+  , LinearizedInvariant<
+      SystemModelBase<ConstantNoiseSystemModel<Precomputed>>
+    > {
+
+  using Base = SystemModelBase<ConstantNoiseSystemModel<Precomputed>>;
+  using typename Base::State;
+  using typename Base::Control;
+  using Base::getCovariance;
+  using Base::getCovarianceSquareRoot;
+  using Base::operator ();
+
+  ConstantNoiseSystemModel(const Covariance<Control>& Q) : Base(Q) {}
+
+  State run(const State& x, const Control& u, const double dt) const {
+    return x + Control(u * dt);
+  }
+
+  State run_linearized(
+    const State& x,
+    const Control& u,
+    Eigen::Ref<Jacobian<State, State>> F,
+    Eigen::Ref<Jacobian<State, Control>> W,
+    const double dt
+  ) const {
+    W.setIdentity() *= dt;
+    return x.plus(Control(u * dt), F);
+  }
+
+  State run_linearized_invariant(
+    const State& x,
+    const Control& u,
+    Eigen::Ref<Jacobian<State, State>> F,
+    Eigen::Ref<Jacobian<State, Control>> W,
+    const double dt
+  ) const {
+    F = Control(-u * dt).exp().adj();
+    W.setIdentity() *= dt;
+    return x + Control(u * dt);
+  }
+
+  const Covariance<State>& getPropagatedNoise(const double dt) const {
+    ++evaluations;
+    if (dt != dt_) {
+      WQWt_ = dt * dt * getCovariance();
+      dt_ = dt;
+    }
+    return WQWt_;
+  }
+
+  const Covariance<State>& getInvariantPropagatedNoise(const double dt) const {
+    return getPropagatedNoise(dt);
+  }
+
+  mutable int evaluations = 0;
+
+protected:
+
+  mutable Covariance<State> WQWt_;
+  mutable double dt_ = std::numeric_limits<double>::quiet_NaN();
+};
+
+namespace kalmanif {
+namespace internal {
+
+template <bool Precomputed>
+struct traits<ConstantNoiseSystemModel<Precomputed>> {
+  using State = SE2d;
+  using Control = typename State::Tangent;
+
+  static constexpr bool ConstantNoiseJacobian = Precomputed;
+  static constexpr bool ConstantInvariantNoiseJacobian = Precomputed;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+using EKF = ExtendedKalmanFilter<SE2d>;
+using IEKF = InvariantExtendedKalmanFilter<SE2d>;
+
+template <typename Filter>
+class TEST_PRECOMPUTED_NOISE : public testing::Test {
+protected:
+
+  const Covariance<SE2d> Q =
+    Eigen::Vector3d(1e-2, 2e-2, 5e-3).asDiagonal();
+
+  const SE2d::Tangent u = SE2d::Tangent(0.1, 0.02, 0.05);
+  const double dt = 0.1;
+
+  const SE2d X_init = SE2d(0.1, -0.2, 0.3);
+  const Covariance<SE2d> P_init = Covariance<SE2d>::Identity() * 0.1;
+};
+
+using Filters = testing::Types<EKF, IEKF>;
+TYPED_TEST_SUITE(TEST_PRECOMPUTED_NOISE, Filters);
+
+TYPED_TEST(TEST_PRECOMPUTED_NOISE, TEST_VS_NOISE_JACOBIAN)
+{
+  const ConstantNoiseSystemModel<true> precomputed(this->Q);
+  const ConstantNoiseSystemModel<false> reference(this->Q);
+
+  TypeParam filter(this->X_init, this->P_init);
+  TypeParam filter_reference(this->X_init, this->P_init);
+
+  for (int i = 0; i < 10; ++i) {
+    filter.propagate(precomputed, this->u, this->dt);
+    filter_reference.propagate(reference, this->u, this->dt);
+  }
+
+  EXPECT_MANIF_NEAR(filter_reference.getState(), filter.getState());
+  EXPECT_EIGEN_NEAR(
+    filter_reference.getCovariance(), filter.getCovariance(), 1e-14
+  );
+
+  // The precomputed noise is used, the other one is not
+  EXPECT_EQ(10, precomputed.evaluations);
+  EXPECT_EQ(0, reference.evaluations);
+}
+
+TYPED_TEST(TEST_PRECOMPUTED_NOISE, TEST_LAZY)
+{
+  const ConstantNoiseSystemModel<true> precomputed(this->Q);
+  const ConstantNoiseSystemModel<false> reference(this->Q);
+
+  TypeParam filter(this->X_init, this->P_init);
+  TypeParam filter_reference(this->X_init, this->P_init);
+  filter.setLazyPropagation(true);
+
+  for (int i = 0; i < 10; ++i) {
+    filter.propagate(precomputed, this->u, this->dt);
+    filter_reference.propagate(reference, this->u, this->dt);
+  }
+
+  EXPECT_EIGEN_NEAR(
+    filter_reference.getCovariance(), filter.getCovariance(), 1e-14
+  );
+}
+
+TEST(TEST_COVARIANCE_ACCESS, TEST_COVARIANCE_REFERENCES)
+{
+  // The model covariances are accessed by reference,
+  // through the linearized interfaces as well
+  const LieSystemModel<SE2d> model(Covariance<SE2d>::Identity());
+
+  const Linearized<SystemModelBase<LieSystemModel<SE2d>>>& f = model;
+  const LinearizedInvariant<SystemModelBase<LieSystemModel<SE2d>>>& fi =
+    model;
+
+  EXPECT_EQ(&model.getCovariance(), &f.getCovariance());
+  EXPECT_EQ(&model.getCovariance(), &fi.getCovariance());
+  EXPECT_EQ(
+    &model.getCovarianceSquareRoot(), &f.getCovarianceSquareRoot()
+  );
+  EXPECT_EQ(
+    &model.getCovarianceSquareRoot(), &fi.getCovarianceSquareRoot()
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
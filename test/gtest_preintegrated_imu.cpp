@@ -0,0 +1,121 @@
+/**
+ * \file gtest_preintegrated_imu.cpp
+ *
+ * Check that propagating once over a preintegrated IMU increment
+ * matches propagating over each IMU sample.
+ */
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/system_models/preintegrated_imu_system_model.h>
+
+#include <manif/SE_2_3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE_2_3d;
+using SystemModel = PreintegratedImuSystemModel<double>;
+using ImuMeasurement = SystemModel::ImuMeasurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+
+template <typename Filter>
+class TEST_PREINTEGRATED_IMU : public testing::Test {
+protected:
+
+  void SetUp() override {
+    for (int k = 0; k < samples; ++k) {
+      ImuMeasurement u;
+      u << 0.1, 0.01 * k, 9.9, 0.01, 0.1 - 0.005 * k, 0.02;
+      imu.push_back(u);
+    }
+  }
+
+  static constexpr int samples = 20;
+  static constexpr double dt = 0.001;
+
+  Covariance<ImuMeasurement> imu_noise =
+    Eigen::Matrix<double, 6, 1>(1e-3, 1e-3, 1e-3, 1e-4, 1e-4, 1e-4)
+      .asDiagonal();
+
+  std::vector<ImuMeasurement> imu;
+
+  State X_init = State(1, 2, 0.5, 0.1, -0.2, 0.3, 0.5, -0.1, 0.2);
+  Covariance<State> P_init = Covariance<State>::Identity() * 0.1;
+};
+
+using Filters = testing::Types<EKF, IEKF>;
+TYPED_TEST_SUITE(TEST_PREINTEGRATED_IMU, Filters);
+
+TYPED_TEST(TEST_PREINTEGRATED_IMU, TEST_VS_SAMPLE_RATE)
+{
+  SystemModel preintegrated(this->imu_noise);
+  SystemModel sample_rate(this->imu_noise);
+
+  TypeParam filter(this->X_init, this->P_init);
+  TypeParam reference(this->X_init, this->P_init);
+
+  for (const auto& u : this->imu) {
+    preintegrated.integrate(u, this->dt);
+
+    // Propagate the reference at every sample
+    sample_rate.integrate(u, this->dt);
+    reference.propagate(
+      sample_rate, sample_rate.getIncrement(), sample_rate.getDeltaTime()
+    );
+    sample_rate.reset();
+  }
+
+  EXPECT_DOUBLE_EQ(this->samples * this->dt, preintegrated.getDeltaTime());
+
+  // A single propagation over the whole increment
+  filter.propagate(
+    preintegrated, preintegrated.getIncrement(), preintegrated.getDeltaTime()
+  );
+
+  EXPECT_MANIF_NEAR(reference.getState(), filter.getState(), 1e-10);
+  EXPECT_EIGEN_NEAR(reference.getCovariance(), filter.getCovariance(), 1e-10);
+}
+
+TEST(TEST_PREINTEGRATED_IMU_MODEL, TEST_RESET)
+{
+  SystemModel imu(Covariance<ImuMeasurement>::Identity() * 1e-3);
+
+  ImuMeasurement u;
+  u << 0.1, 0.2, 9.9, 0.01, 0.1, 0.02;
+
+  imu.integrate(u, 0.01);
+  EXPECT_FALSE(imu.getIncrement().coeffs().isZero());
+  EXPECT_FALSE(imu.getCovariance().isZero());
+
+  imu.reset();
+  EXPECT_TRUE(imu.getIncrement().coeffs().isZero());
+  EXPECT_TRUE(imu.getCovariance().isZero());
+  EXPECT_EQ(0, imu.getDeltaTime());
+}
+
+TEST(TEST_PREINTEGRATED_IMU_MODEL, TEST_STATIONARY)
+{
+  // At rest, the accelerometer measures the opposite of the gravity
+  SystemModel imu(Covariance<ImuMeasurement>::Identity() * 1e-3);
+
+  ImuMeasurement u;
+  u << 0, 0, 9.80665, 0, 0, 0;
+
+  for (int k = 0; k < 100; ++k) {
+    imu.integrate(u, 0.01);
+  }
+
+  const State x = State::Identity();
+  EXPECT_MANIF_NEAR(x, imu(x, imu.getIncrement(), imu.getDeltaTime()), 1e-12);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,217 @@
+/**
+ * \file gtest_realtime.cpp
+ *
+ * Check the real-time mode: the filter steps are noexcept,
+ * do not allocate and report the failed checks as error codes,
+ * returning early rather than accessing memory out of bounds.
+ */
+
+// Any Eigen allocation within a filter step asserts
+#define EIGEN_RUNTIME_NO_MALLOC
+#define KALMANIF_REALTIME
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+template <typename Filter>
+class TEST_REALTIME : public testing::Test {
+protected:
+
+  using State = typename Filter::State;
+  using SystemModel = LieSystemModel<State>;
+  using MeasurementModel = Landmark2DMeasurementModel<State>;
+  using Control = typename SystemModel::Control;
+  using Landmark = typename MeasurementModel::Landmark;
+  using Measurement = typename MeasurementModel::Measurement;
+
+  static constexpr bool Invariant =
+    std::is_same<Filter, InvariantExtendedKalmanFilter<State>>::value;
+
+  // The UKFM has no stacked update
+  static constexpr bool Stacked =
+    !std::is_same<Filter, UnscentedKalmanFilterManifolds<State>>::value;
+
+  void SetUp() override {
+    clearLastError();
+  }
+
+  void propagate() {
+    if constexpr (Invariant) {
+      filter.propagate(system_model, u, dt);
+    } else {
+      filter.propagate(system_model, u);
+    }
+  }
+
+  const double dt = 0.01;
+
+  const SystemModel system_model{Covariance<State>::Identity() * 1e-4};
+  const Control u = Control::Random() * 0.01;
+
+  Covariance<Measurement> R = Covariance<Measurement>::Identity() * 1e-2;
+  const std::array<MeasurementModel, 2> measurement_models{{
+    MeasurementModel(Landmark::Ones(), R),
+    MeasurementModel(-Landmark::Ones(), R)
+  }};
+  const std::array<Measurement, 2> measurements{{
+    Measurement::Ones() * 0.9, -Measurement::Ones() * 1.1
+  }};
+
+  Filter filter{State::Identity(), Covariance<State>::Identity() * 0.1};
+};
+
+#define __KALMANIF_FILTERS(State)                \
+  ExtendedKalmanFilter<State>,                   \
+  SquareRootExtendedKalmanFilter<State>,         \
+  InvariantExtendedKalmanFilter<State>,          \
+  UnscentedKalmanFilterManifolds<State>
+
+using Filters = testing::Types<__KALMANIF_FILTERS(SE2d)>;
+
+#undef __KALMANIF_FILTERS
+
+TYPED_TEST_SUITE(TEST_REALTIME, Filters);
+
+TYPED_TEST(TEST_REALTIME, TEST_NOEXCEPT)
+{
+  static_assert(
+    noexcept(
+      this->filter.update(
+        this->measurement_models[0], this->measurements[0]
+      )
+    ),
+    "The update must be noexcept in real-time mode!"
+  );
+  static_assert(
+    !TestFixture::Stacked || noexcept(
+      this->filter.update(this->measurement_models, this->measurements)
+    ),
+    "The stacked update must be noexcept in real-time mode!"
+  );
+}
+
+TYPED_TEST(TEST_REALTIME, TEST_NO_ALLOCATION)
+{
+  // No warm up, even the first update of a size does not allocate
+  for (int i = 0; i < 10; ++i) {
+    this->propagate();
+    for (std::size_t j = 0; j < this->measurement_models.size(); ++j) {
+      this->filter.update(
+        this->measurement_models[j], this->measurements[j]
+      );
+    }
+  }
+
+  EXPECT_FALSE(getLastError());
+  EXPECT_TRUE(isCovariance(this->filter.getCovariance()));
+}
+
+TYPED_TEST(TEST_REALTIME, TEST_ERROR_CODE)
+{
+  using Measurement = typename TestFixture::Measurement;
+
+  const auto X = this->filter.getState();
+  const auto P = this->filter.getCovariance();
+
+  if constexpr (TestFixture::Stacked) {
+    // The sizes mismatch, the update records an error and is skipped
+    const std::vector<Measurement> measurements(1, this->measurements[0]);
+    EXPECT_NO_THROW(
+      this->filter.update(this->measurement_models, measurements)
+    );
+
+    EXPECT_TRUE(getLastError());
+    EXPECT_EQ(ErrorCode::InvalidArgument, getLastError().code);
+    EXPECT_STREQ(
+      "KalmanFilterBase::update: Ranges size mismatch!", getLastError().what
+    );
+
+    EXPECT_MANIF_NEAR(X, this->filter.getState());
+    EXPECT_EIGEN_NEAR(P, this->filter.getCovariance());
+  }
+
+  clearLastError();
+  EXPECT_FALSE(getLastError());
+  EXPECT_EQ(ErrorCode::None, getLastError().code);
+}
+
+TEST(TEST_REALTIME_STEADY_STATE, TEST_NOT_AVAILABLE)
+{
+  clearLastError();
+
+  InvariantExtendedKalmanFilter<SE2d> filter(
+    SE2d::Identity(), Covariance<SE2d>::Identity()
+  );
+
+  // Recording the cycles would allocate
+  EXPECT_NO_THROW(filter.setSteadyStateGain(true));
+  EXPECT_FALSE(filter.isSteadyStateGain());
+  EXPECT_EQ(ErrorCode::InvalidArgument, getLastError().code);
+  EXPECT_STREQ(
+    "SteadyStateBase: Not available in real-time mode!", getLastError().what
+  );
+
+  // The first error is kept
+  EXPECT_NO_THROW(filter.setSteadyStateGain(false, -1.));
+  EXPECT_STREQ(
+    "SteadyStateBase: Not available in real-time mode!", getLastError().what
+  );
+
+  clearLastError();
+}
+
+TEST(TEST_REALTIME_EARLY_RETURN, TEST_DYNAMIC_STATE)
+{
+  using State = AugmentedState<SE2d>;
+  using DEKF = DynamicExtendedKalmanFilter<State>;
+  using Matrix = DEKF::Matrix;
+
+  clearLastError();
+
+  DEKF dekf(
+    State(SE2d::Identity()), Covariance<SE2d>::Identity(),
+    SE2d::DoF + 2 * State::LandmarkDim, 2, 3
+  );
+
+  // Writing past the state would corrupt the covariance storage
+  EXPECT_FALSE(dekf.setCovariance(Matrix::Identity(5, 5)));
+  EXPECT_EQ(ErrorCode::InvalidArgument, getLastError().code);
+  EXPECT_STREQ("DEKF: Covariance size mismatch!", getLastError().what);
+  EXPECT_EIGEN_NEAR(Matrix::Identity(3, 3), Matrix(dekf.getCovariance()));
+
+  EXPECT_EQ(
+    -1,
+    dekf.addLandmark(
+      State::Landmark(1, 2), Matrix::Zero(State::LandmarkDim, 5),
+      Covariance<State::Landmark>::Identity()
+    )
+  );
+  EXPECT_EQ(SE2d::DoF, dekf.getState().dim());
+
+  clearLastError();
+}
+
+TEST(TEST_REALTIME_ENSURE, TEST_THROWS)
+{
+  clearLastError();
+
+  // Outside of the filter steps, the checks still throw
+  const std::vector<std::uint8_t> data(3);
+  EXPECT_THROW(
+    decodeEstimate<SE2d>(data.data(), data.size()), kalmanif::invalid_argument
+  );
+  EXPECT_FALSE(getLastError());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,219 @@
+/**
+ * \file gtest_replay_engine.cpp
+ *
+ * Check the measurement log and the offline replay engine
+ * against a hand-written replay loop.
+ */
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/io/replay_engine.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using RTS = RauchTungStriebelSmoother<EKF>;
+using Replay = ReplayEngine<EKF>;
+
+class TEST_REPLAY_ENGINE : public testing::Test {
+protected:
+
+  static constexpr int steps = 100;
+
+  //! The ith log path
+  std::string input(const int i) const {
+    return testing::TempDir() + "kalmanif_replay_" + std::to_string(i) + ".log";
+  }
+
+  std::string output(const int i) const {
+    return input(i) + ".trajectory";
+  }
+
+  //! The control and measurement of step k of log i
+  Control control(const int i, const int k) const {
+    return Control(0.1, 0.01 * i, 0.05 + 0.01 * (k % 3));
+  }
+
+  Measurement measurement(const int i, const int k) const {
+    return Measurement(2.0 - 0.01 * k, 1.0 + 0.02 * i) +
+           Measurement(0.01, -0.02) * (k % 4);
+  }
+
+  //! Record the ith log, a control then a measurement at each step
+  void record(const int i) const {
+    MeasurementLogWriter<double> writer(input(i), 3, 16);
+    for (int k = 0; k < steps; ++k) {
+      writer.write(0.1 * k + 0.05, 0, control(i, k));
+      writer.write(0.1 * (k + 1), 1, measurement(i, k));
+    }
+  }
+
+  //! The hand-written replay of the ith log
+  RTS reference(const int i) const {
+    RTS rts(x_init, P_init);
+    for (int k = 0; k < steps; ++k) {
+      rts.propagate(system_model, control(i, k));
+      rts.update(0.1 * (k + 1), measurement_model, measurement(i, k));
+    }
+    return rts;
+  }
+
+  Replay::Job job(const int i) const {
+    Replay::Job job;
+    job.input = input(i);
+    job.output = output(i);
+    job.x_init = x_init;
+    job.P_init = P_init;
+    return job;
+  }
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+
+  const State x_init = State(0.05, -0.05, 0.02);
+  const StateCovariance P_init = StateCovariance::Identity() * 0.1;
+};
+
+TEST_F(TEST_REPLAY_ENGINE, TEST_MEASUREMENT_LOG)
+{
+  record(0);
+
+  MeasurementLogReader<double> reader(input(0));
+
+  ASSERT_EQ(std::size_t(2 * steps), reader.size());
+  EXPECT_EQ(3u, reader.payloadSize());
+
+  for (int k = 0; k < steps; ++k) {
+    EXPECT_EQ(0.1 * k + 0.05, reader.time(2 * k));
+    EXPECT_EQ(0u, reader.stream(2 * k));
+    EXPECT_EQ(3, reader.payload(2 * k).size());
+    EXPECT_TRUE(
+      control(0, k).coeffs() == reader.input<Control>(2 * k).coeffs()
+    );
+
+    EXPECT_EQ(1u, reader.stream(2 * k + 1));
+    EXPECT_EQ(2, reader.payload(2 * k + 1).size());
+    EXPECT_TRUE(measurement(0, k) == reader.input<Measurement>(2 * k + 1));
+  }
+
+  EXPECT_THROW(reader.input<Measurement>(0), kalmanif::runtime_error);
+
+  MeasurementLogWriter<double> writer(input(1), 2);
+  EXPECT_THROW(writer.write(0, 0, control(0, 0)), kalmanif::invalid_argument);
+
+  EXPECT_THROW(MeasurementLogReader<float>{input(0)}, kalmanif::runtime_error);
+}
+
+TEST_F(TEST_REPLAY_ENGINE, TEST_REPLAY_LOGS)
+{
+  constexpr int logs = 4;
+
+  std::vector<Replay::Job> jobs;
+  for (int i = 0; i < logs; ++i) {
+    record(i);
+    jobs.push_back(job(i));
+  }
+
+  ReplayOptions options;
+  options.concurrency = 2;
+  options.queue_capacity = 8;
+
+  Replay replay(options);
+  EXPECT_EQ(0u, replay.addControlStream(system_model));
+  EXPECT_EQ(1u, replay.addMeasurementStream(measurement_model));
+
+  const ReplayStatistics statistics = replay.run(jobs);
+
+  EXPECT_EQ(std::size_t(logs), statistics.logs);
+  EXPECT_EQ(std::size_t(2 * steps * logs), statistics.epochs);
+  ASSERT_EQ(std::size_t(logs), statistics.log_epochs.size());
+  EXPECT_EQ(std::size_t(2 * steps), statistics.log_epochs[2]);
+  EXPECT_GT(statistics.epochsPerSecond(), 0.);
+
+  for (int i = 0; i < logs; ++i) {
+    RTS rts = reference(i);
+    rts.smooth();
+
+    TrajectoryLogReader<State> trajectory(output(i));
+    ASSERT_EQ(std::size_t(steps), trajectory.size());
+
+    for (int k = 0; k < steps; ++k) {
+      EXPECT_EQ(0.1 * (k + 1), trajectory.time(k));
+      EXPECT_MANIF_NEAR(rts.getStates()[k], trajectory.state(k), 1e-12);
+      EXPECT_EIGEN_NEAR(rts.getCovariances()[k], trajectory[k].covariance, 1e-12);
+    }
+  }
+}
+
+TEST_F(TEST_REPLAY_ENGINE, TEST_REPLAY_FILTERED)
+{
+  record(0);
+
+  ReplayOptions options;
+  options.smooth = false;
+
+  Replay replay(options);
+  replay.addControlStream(system_model);
+  replay.addMeasurementStream(measurement_model);
+
+  replay.run({job(0)});
+
+  EKF ekf(x_init, P_init);
+
+  TrajectoryLogReader<State> trajectory(output(0));
+  ASSERT_EQ(std::size_t(steps), trajectory.size());
+
+  for (int k = 0; k < steps; ++k) {
+    ekf.propagate(system_model, control(0, k));
+    ekf.update(measurement_model, measurement(0, k));
+
+    EXPECT_MANIF_NEAR(ekf.getState(), trajectory.state(k), 1e-12);
+    EXPECT_EIGEN_NEAR(ekf.getCovariance(), trajectory[k].covariance, 1e-12);
+  }
+}
+
+TEST_F(TEST_REPLAY_ENGINE, TEST_REPLAY_ERRORS)
+{
+  record(0);
+
+  Replay replay;
+  replay.addControlStream(system_model);
+
+  // The measurement stream is unknown
+  EXPECT_THROW(replay.run({job(0)}), kalmanif::runtime_error);
+
+  Replay::Job missing = job(0);
+  missing.input += ".missing";
+  EXPECT_THROW(replay.run({missing}), kalmanif::runtime_error);
+
+  // The log starts with a measurement
+  {
+    MeasurementLogWriter<double> writer(input(1), 3);
+    writer.write(0.1, 1, measurement(0, 0));
+    writer.write(0.15, 0, control(0, 0));
+  }
+  replay.addMeasurementStream(measurement_model);
+  EXPECT_THROW(replay.run({job(1)}), kalmanif::runtime_error);
+
+  ReplayOptions options;
+  options.concurrency = 0;
+  EXPECT_THROW(Replay{options}, kalmanif::invalid_argument);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,167 @@
+/**
+ * \file gtest_robust_update.cpp
+ *
+ * Check the robust updates of the EKF and IEKF: the re-weighted update
+ * is the plain update of the inflated noise, down-weighting outliers.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+template <typename Filter>
+class TEST_ROBUST_UPDATE : public testing::Test {
+protected:
+
+  using State = typename Filter::State;
+  using MeasurementModel = Landmark2DMeasurementModel<State>;
+  using Landmark = typename MeasurementModel::Landmark;
+  using Measurement = typename MeasurementModel::Measurement;
+
+  TEST_ROBUST_UPDATE()
+    : R(Eigen::Vector2d(1e-2, 2e-2).asDiagonal())
+    , measurement_model(Landmark(2.0, 1.0), R)
+    , X_true(0.1, -0.2, 0.05)
+    , X_init(0.15, -0.25, 0.02)
+    , P_init(Eigen::Vector3d(1e-2, 2e-2, 5e-3).asDiagonal())
+  {}
+
+  //! The plain update of a filter with the noise R/w
+  Filter weightedUpdate(const Measurement& y, const double w) const {
+    Eigen::Matrix2d R_w = R / w;
+    const MeasurementModel weighted(Landmark(2.0, 1.0), R_w);
+    Filter filter(X_init, P_init);
+    filter.update(weighted, y);
+    return filter;
+  }
+
+  Eigen::Matrix2d R;
+  MeasurementModel measurement_model;
+
+  State X_true, X_init;
+  Covariance<State> P_init;
+};
+
+using Filters = testing::Types<
+  ExtendedKalmanFilter<SE2d>,
+  InvariantExtendedKalmanFilter<SE2d>
+>;
+
+TYPED_TEST_SUITE(TEST_ROBUST_UPDATE, Filters);
+
+TYPED_TEST(TEST_ROBUST_UPDATE, TEST_INLIER)
+{
+  const auto y = this->measurement_model(this->X_true);
+
+  TypeParam plain(this->X_init, this->P_init);
+  TypeParam robust(this->X_init, this->P_init);
+
+  RobustKernel kernel;
+  kernel.width = 1e3;
+
+  plain.update(this->measurement_model, y);
+  robust.update(this->measurement_model, y, kernel);
+
+  EXPECT_DOUBLE_EQ(1., robust.getInnovationWeight());
+  EXPECT_MANIF_NEAR(plain.getState(), robust.getState(), 1e-10);
+  EXPECT_EIGEN_NEAR(plain.getCovariance(), robust.getCovariance(), 1e-10);
+  EXPECT_EIGEN_NEAR(plain.getInnovation(), robust.getInnovation(), 1e-10);
+}
+
+TYPED_TEST(TEST_ROBUST_UPDATE, TEST_NO_ITERATION)
+{
+  using Measurement = typename TestFixture::Measurement;
+
+  const Measurement y =
+    this->measurement_model(this->X_true) + Measurement(3.0, -2.0);
+
+  TypeParam plain(this->X_init, this->P_init);
+  TypeParam robust(this->X_init, this->P_init);
+
+  RobustKernel kernel;
+  kernel.iterations = 0;
+
+  plain.update(this->measurement_model, y);
+  robust.update(this->measurement_model, y, kernel);
+
+  EXPECT_DOUBLE_EQ(1., robust.getInnovationWeight());
+  EXPECT_MANIF_NEAR(plain.getState(), robust.getState(), 1e-10);
+  EXPECT_EIGEN_NEAR(plain.getCovariance(), robust.getCovariance(), 1e-10);
+}
+
+TYPED_TEST(TEST_ROBUST_UPDATE, TEST_OUTLIER)
+{
+  using Measurement = typename TestFixture::Measurement;
+
+  const Measurement y =
+    this->measurement_model(this->X_true) + Measurement(3.0, -2.0);
+
+  TypeParam plain(this->X_init, this->P_init);
+  plain.update(this->measurement_model, y);
+
+  for (const RobustLoss loss : {RobustLoss::Huber, RobustLoss::Cauchy}) {
+    RobustKernel kernel;
+    kernel.loss = loss;
+    kernel.width = loss == RobustLoss::Huber ? 1.345 : 2.3849;
+
+    TypeParam robust(this->X_init, this->P_init);
+    robust.update(this->measurement_model, y, kernel);
+
+    const double w = robust.getInnovationWeight();
+    EXPECT_GT(0.1, w);
+    EXPECT_LT(0., w);
+
+    // The plain update of the weighted noise
+    const TypeParam weighted = this->weightedUpdate(y, w);
+    EXPECT_MANIF_NEAR(weighted.getState(), robust.getState(), 1e-10);
+    EXPECT_EIGEN_NEAR(
+      weighted.getCovariance(), robust.getCovariance(), 1e-10
+    );
+
+    // The outlier pulls the estimate far less
+    EXPECT_GT(
+      (plain.getState() - this->X_init).coeffs().norm(),
+      5 * (robust.getState() - this->X_init).coeffs().norm()
+    );
+
+    // The innovation is the unweighted one
+    EXPECT_EIGEN_NEAR(plain.getInnovation(), robust.getInnovation(), 1e-10);
+    EXPECT_NEAR(
+      plain.getNormalizedInnovationSquared(),
+      robust.getNormalizedInnovationSquared(),
+      1e-8
+    );
+  }
+
+  // A plain update resets the weight
+  plain.update(this->measurement_model, y);
+  EXPECT_DOUBLE_EQ(1., plain.getInnovationWeight());
+}
+
+TEST(TEST_ROBUST_KERNEL, TEST_WEIGHT)
+{
+  RobustKernel huber;
+  huber.width = 2.;
+
+  EXPECT_DOUBLE_EQ(1., huber.weight(0.));
+  EXPECT_DOUBLE_EQ(1., huber.weight(2.));
+  EXPECT_DOUBLE_EQ(0.5, huber.weight(4.));
+
+  RobustKernel cauchy;
+  cauchy.loss = RobustLoss::Cauchy;
+  cauchy.width = 2.;
+
+  EXPECT_DOUBLE_EQ(1., cauchy.weight(0.));
+  EXPECT_DOUBLE_EQ(0.5, cauchy.weight(2.));
+  EXPECT_DOUBLE_EQ(0.2, cauchy.weight(4.));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
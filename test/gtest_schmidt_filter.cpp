@@ -0,0 +1,152 @@
+/**
+ * \file gtest_schmidt_filter.cpp
+ *
+ * Check the Schmidt (consider-state) mode of the EKF.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+
+class TEST_SCHMIDT_FILTER : public testing::Test {
+protected:
+
+  void SetUp() override {
+    P_init << 0.1,  0.02, 0.01,
+              0.02, 0.2, -0.03,
+              0.01, -0.03, 0.05;
+  }
+
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+
+  State X_init = State(0.15, -0.1, 0.2);
+  StateCovariance P_init;
+
+  Measurement y = measurement_model(State(0.1, -0.2, 0.05));
+
+  // Consider the heading
+  static constexpr int heading = 2;
+};
+
+TEST_F(TEST_SCHMIDT_FILTER, TEST_CONSIDERED_NOT_UPDATED)
+{
+  EKF ekf(X_init, P_init);
+  ekf.setConsideredStates(heading, 1);
+
+  ASSERT_TRUE(ekf.hasConsideredStates());
+
+  ekf.update(measurement_model, y);
+
+  const StateCovariance& P = ekf.getCovariance();
+
+  // The heading mean and variance are untouched
+  EXPECT_DOUBLE_EQ(X_init.angle(), ekf.getState().angle());
+  EXPECT_DOUBLE_EQ(P_init(heading, heading), P(heading, heading));
+
+  // The translation and the cross-covariances are updated
+  EXPECT_FALSE(X_init.translation().isApprox(ekf.getState().translation()));
+  EXPECT_FALSE(P_init.col(heading).isApprox(P.col(heading)));
+
+  EXPECT_TRUE(isCovariance(P));
+}
+
+TEST_F(TEST_SCHMIDT_FILTER, TEST_CONSISTENT)
+{
+  EKF ekf(X_init, P_init);
+  EKF schmidt(X_init, P_init);
+  schmidt.setConsideredStates(heading, 1);
+
+  ekf.update(measurement_model, y);
+  schmidt.update(measurement_model, y);
+
+  // With its suboptimal gain, the Schmidt filter
+  // is less confident than the EKF
+  const StateCovariance dP = schmidt.getCovariance() - ekf.getCovariance();
+
+  EXPECT_LT(-1e-12, Eigen::SelfAdjointEigenSolver<StateCovariance>(
+    dP
+  ).eigenvalues().minCoeff());
+  EXPECT_LT(ekf.getCovariance().trace(), schmidt.getCovariance().trace());
+
+  // Propagating keeps the considered uncertainty in the estimated states
+  const SystemModel system_model(StateCovariance::Identity() * 1e-3);
+  schmidt.propagate(system_model, Control(0.1, 0.0, 0.05));
+  schmidt.update(measurement_model, y);
+
+  EXPECT_TRUE(isCovariance(schmidt.getCovariance()));
+}
+
+TEST_F(TEST_SCHMIDT_FILTER, TEST_CLEAR)
+{
+  EKF ekf(X_init, P_init);
+  EKF schmidt(X_init, P_init);
+
+  schmidt.setConsideredStates(heading, 1);
+  schmidt.clearConsideredStates();
+
+  EXPECT_FALSE(schmidt.hasConsideredStates());
+
+  ekf.update(measurement_model, y);
+  schmidt.update(measurement_model, y);
+
+  EXPECT_MANIF_NEAR(ekf.getState(), schmidt.getState());
+  EXPECT_EIGEN_NEAR(ekf.getCovariance(), schmidt.getCovariance());
+}
+
+TEST_F(TEST_SCHMIDT_FILTER, TEST_ITERATED_CONSIDERED_NOT_UPDATED)
+{
+  EKF ekf(X_init, P_init);
+  EKF iterated(X_init, P_init);
+  ekf.setConsideredStates(heading, 1);
+  iterated.setConsideredStates(heading, 1);
+
+  IterationBudget budget;
+  budget.max_iterations = 10;
+  budget.step_tolerance = 0;
+
+  ekf.update(measurement_model, y);
+  iterated.update(measurement_model, y, budget);
+
+  const StateCovariance& P = iterated.getCovariance();
+
+  // The heading mean and variance are untouched
+  EXPECT_DOUBLE_EQ(X_init.angle(), iterated.getState().angle());
+  EXPECT_DOUBLE_EQ(P_init(heading, heading), P(heading, heading));
+
+  // Iterating falls back to the usual Schmidt update
+  EXPECT_EQ(1u, iterated.getIterationSummary().iterations);
+  EXPECT_MANIF_NEAR(ekf.getState(), iterated.getState(), 1e-12);
+  EXPECT_EIGEN_NEAR(ekf.getCovariance(), P, 1e-12);
+
+  EXPECT_TRUE(isCovariance(P));
+}
+
+TEST_F(TEST_SCHMIDT_FILTER, TEST_INVALID_BLOCK)
+{
+  EKF ekf(X_init, P_init);
+
+  EXPECT_THROW(ekf.setConsideredStates(2, 2), kalmanif::invalid_argument);
+  EXPECT_THROW(ekf.setConsideredStates(-1, 1), kalmanif::invalid_argument);
+  EXPECT_FALSE(ekf.hasConsideredStates());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
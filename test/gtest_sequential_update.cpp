@@ -0,0 +1,158 @@
+/**
+ * \file gtest_sequential_update.cpp
+ *
+ * Check that the sequential update of measurement models
+ * with diagonal noise matches the batch update.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <array>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+
+/**
+ * @brief A position measurement model whose
+ * noise may be declared diagonal.
+ */
+template <bool Diagonal>
+struct PositionMeasurementModel
+  : MeasurementModelBase<PositionMeasurementModel<Diagonal>>
+  , Linearized<MeasurementModelBase<PositionMeasurementModel<Diagonal>>>
+  , LinearizedInvariant<
+      MeasurementModelBase<PositionMeasurementModel<Diagonal>>
+    > {
+
+  using Base = MeasurementModelBase<PositionMeasurementModel<Diagonal>>;
+  using Base::setCovariance;
+  using Base::getCovariance;
+  using Base::getCovarianceSquareRoot;
+  using Base::operator ();
+
+  using Measurement = Eigen::Vector2d;
+
+  PositionMeasurementModel(const Eigen::Ref<Covariance<Measurement>>& R) {
+    setCovariance(R);
+  }
+
+  Measurement run(const State& x) const {
+    return x.translation();
+  }
+
+  Measurement run_linearized(
+    const State& x,
+    Eigen::Ref<Jacobian<Measurement, State>> H,
+    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+  ) const {
+    V.setIdentity();
+    H.template topLeftCorner<2, 2>() = x.rotation();
+    H.template topRightCorner<2, 1>().setZero();
+    return x.translation();
+  }
+
+  Measurement run_linearized_invariant(
+    const State& x,
+    Eigen::Ref<Jacobian<Measurement, State>> H,
+    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+  ) const {
+    H.template topLeftCorner<2, 2>() = -Eigen::Matrix2d::Identity();
+    H.template topRightCorner<2, 1>().setZero();
+    V = x.inverse().rotation();
+    return x.translation();
+  }
+};
+
+namespace kalmanif {
+namespace internal {
+
+template <bool Diagonal>
+struct traits<PositionMeasurementModel<Diagonal>> {
+  using State = SE2d;
+  using Scalar = double;
+  using Measurement = Eigen::Vector2d;
+  static constexpr Invariance invariance = Invariance::Left;
+  static constexpr bool DiagonalNoise = Diagonal;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+template <typename Filter>
+class TEST_SEQUENTIAL_UPDATE : public testing::Test {
+protected:
+
+  // The IEKF 'sees' the noise M.R.M^T where M is a rotation,
+  // it is thus diagonal only for an isotropic R.
+  Eigen::Matrix2d R = std::is_same<Filter, ExtendedKalmanFilter<State>>{} ?
+    Eigen::Matrix2d(Eigen::Vector2d(1e-2, 4e-2).asDiagonal()) :
+    Eigen::Matrix2d(Eigen::Matrix2d::Identity() * 1e-2);
+
+  PositionMeasurementModel<true> sequential_model{R};
+  PositionMeasurementModel<false> batch_model{R};
+
+  Eigen::Vector2d y = Eigen::Vector2d(0.2, -0.15);
+
+  State X_init = State(0.15, -0.1, 0.3);
+  StateCovariance P_init = (StateCovariance() << 0.1,  0.02, 0.01,
+                                                 0.02, 0.2,  0.03,
+                                                 0.01, 0.03, 0.05).finished();
+};
+
+using Filters = testing::Types<
+  ExtendedKalmanFilter<State>, InvariantExtendedKalmanFilter<State>
+>;
+TYPED_TEST_SUITE(TEST_SEQUENTIAL_UPDATE, Filters);
+
+TYPED_TEST(TEST_SEQUENTIAL_UPDATE, TEST_SEQUENTIAL_VS_BATCH)
+{
+  EXPECT_TRUE(internal::has_diagonal_noise<PositionMeasurementModel<true>>{});
+  EXPECT_FALSE(internal::has_diagonal_noise<PositionMeasurementModel<false>>{});
+
+  TypeParam filter_sequential(this->X_init, this->P_init);
+  TypeParam filter_batch(this->X_init, this->P_init);
+
+  filter_sequential.update(this->sequential_model, this->y);
+  filter_batch.update(this->batch_model, this->y);
+
+  EXPECT_MANIF_NEAR(filter_sequential.getState(), filter_batch.getState());
+  EXPECT_EIGEN_NEAR(
+    filter_sequential.getCovariance(), filter_batch.getCovariance()
+  );
+}
+
+TYPED_TEST(TEST_SEQUENTIAL_UPDATE, TEST_STACKED_SEQUENTIAL_VS_BATCH)
+{
+  TypeParam filter_sequential(this->X_init, this->P_init);
+  TypeParam filter_batch(this->X_init, this->P_init);
+
+  const std::array<PositionMeasurementModel<true>, 2> sequential_models = {
+    this->sequential_model, this->sequential_model
+  };
+  const std::array<PositionMeasurementModel<false>, 2> batch_models = {
+    this->batch_model, this->batch_model
+  };
+  const std::array<Eigen::Vector2d, 2> ys = {
+    this->y, Eigen::Vector2d(0.25, -0.1)
+  };
+
+  filter_sequential.update(sequential_models, ys);
+  filter_batch.update(batch_models, ys);
+
+  EXPECT_MANIF_NEAR(filter_sequential.getState(), filter_batch.getState());
+  EXPECT_EIGEN_NEAR(
+    filter_sequential.getCovariance(), filter_batch.getCovariance()
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
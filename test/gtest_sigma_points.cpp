@@ -0,0 +1,181 @@
+/**
+ * \file gtest_sigma_points.cpp
+ *
+ * Check the sigma point schemes of the UKFM.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+template <typename SigmaPoints>
+using UKFM = UnscentedKalmanFilterManifolds<
+  State, Invariance::Right, SequentialExecutor, SigmaPoints
+>;
+
+template <typename Scheme, int N>
+void checkMoments(const double alpha)
+{
+  using Set = SigmaPointSet<double, N, Scheme>;
+  const Set set(alpha);
+
+  EXPECT_EQ(Scheme::count(N), Set::Count);
+  EXPECT_NEAR(1.0, set.wm + set.weights.sum(), 1e-12);
+
+  // zero mean and identity covariance
+  const Eigen::Matrix<double, N, 1> mean = set.points * set.weights;
+  const Eigen::Matrix<double, N, N> cov =
+    set.points * set.weights.asDiagonal() * set.points.transpose();
+
+  EXPECT_EIGEN_NEAR(Eigen::Matrix<double, N, 1>::Zero(), mean, 1e-12);
+  EXPECT_EIGEN_NEAR(Eigen::Matrix<double, N, N>::Identity(), cov, 1e-12);
+}
+
+TEST(TEST_SIGMA_POINTS, TEST_SYMMETRIC)
+{
+  checkMoments<SymmetricSigmaPoints, 1>(1.0);
+  checkMoments<SymmetricSigmaPoints, 3>(0.5);
+  checkMoments<SymmetricSigmaPoints, 9>(0.1);
+}
+
+TEST(TEST_SIGMA_POINTS, TEST_SPHERICAL_SIMPLEX)
+{
+  checkMoments<SphericalSimplexSigmaPoints, 1>(1.0);
+  checkMoments<SphericalSimplexSigmaPoints, 3>(0.5);
+  checkMoments<SphericalSimplexSigmaPoints, 9>(0.1);
+
+  // all at the same distance from the mean
+  const SigmaPointSet<double, 6, SphericalSimplexSigmaPoints> set(1.0);
+  const Eigen::Matrix<double, 1, 7> norms = set.points.colwise().norm();
+  EXPECT_NEAR(norms.minCoeff(), norms.maxCoeff(), 1e-12);
+}
+
+TEST(TEST_SIGMA_POINTS, TEST_MINIMAL_SKEW)
+{
+  checkMoments<MinimalSkewSigmaPoints, 1>(1.0);
+  checkMoments<MinimalSkewSigmaPoints, 3>(0.5);
+  checkMoments<MinimalSkewSigmaPoints, 9>(0.1);
+}
+
+TEST(TEST_SIGMA_POINTS, TEST_UKFM)
+{
+  const SystemModel system_model(StateCovariance::Identity() * 1e-3);
+  const Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  const MeasurementModel measurement_model(Landmark(2.0, 1.0), R);
+
+  const State X_init(0.05, -0.05, 0.02);
+  const StateCovariance P_init = StateCovariance::Identity() * 1e-2;
+
+  UKFM<SymmetricSigmaPoints> symmetric(X_init, P_init);
+  UKFM<SphericalSimplexSigmaPoints> simplex(X_init, P_init);
+  UKFM<MinimalSkewSigmaPoints> skew(X_init, P_init);
+
+  // the reduced sets only differ from the symmetric one
+  // by their odd moments, scaled down by alpha
+  State X = X_init;
+  const Control u(0.1, 0.0, 0.05);
+  for (int k = 0; k < 20; ++k) {
+    X = X + u;
+    symmetric.propagate(system_model, u);
+    simplex.propagate(system_model, u);
+    skew.propagate(system_model, u);
+
+    const Measurement y =
+      measurement_model(X) + Measurement(0.01, -0.02) * (k % 3);
+    symmetric.update(measurement_model, y);
+    simplex.update(measurement_model, y);
+    skew.update(measurement_model, y);
+
+    EXPECT_MANIF_NEAR(symmetric.getState(), simplex.getState(), 1e-4);
+    EXPECT_MANIF_NEAR(symmetric.getState(), skew.getState(), 1e-4);
+    EXPECT_EIGEN_NEAR(
+      symmetric.getCovariance(), simplex.getCovariance(), 1e-4
+    );
+    EXPECT_EIGEN_NEAR(symmetric.getCovariance(), skew.getCovariance(), 1e-4);
+  }
+}
+
+TEST(TEST_SIGMA_POINTS, TEST_STATIC_SET)
+{
+  using Alpha = std::ratio<1, 2>;
+  using Set = SigmaPointSet<double, 4, SymmetricSigmaPoints, Alpha>;
+
+  // the weights are compile-time constants
+  static_assert(Set::spread == 1.0, "");
+  static_assert(Set::weight == 0.5, "");
+  static_assert(Set::wm == -3.0, "");
+  static_assert(Set::w0 == -0.25, "");
+
+  const SigmaPointSet<double, 4, SymmetricSigmaPoints> set(0.5);
+  EXPECT_EIGEN_NEAR(set.points, Set::points, 1e-15);
+  EXPECT_EIGEN_NEAR(set.weights, Set::weights, 1e-15);
+  EXPECT_DOUBLE_EQ(set.wm, Set::wm);
+  EXPECT_DOUBLE_EQ(set.w0, Set::w0);
+
+  EXPECT_DOUBLE_EQ(std::sqrt(7.), internal::constexprSqrt(7.));
+  EXPECT_DOUBLE_EQ(std::sqrt(0.3), internal::constexprSqrt(0.3));
+}
+
+template <typename Scheme>
+void checkStaticUKFM()
+{
+  using Static = StaticSigmaPoints<
+    Scheme, std::ratio<1, 1000>, std::ratio<1, 100>, std::ratio<1, 2>
+  >;
+
+  const SystemModel system_model(StateCovariance::Identity() * 1e-3);
+  const Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  const MeasurementModel measurement_model(Landmark(2.0, 1.0), R);
+
+  const State X_init(0.05, -0.05, 0.02);
+  const StateCovariance P_init = StateCovariance::Identity() * 1e-2;
+
+  UKFM<Scheme> dynamic(X_init, P_init, 1e-3, 1e-2, 0.5);
+  UKFM<Static> fixed(X_init, P_init);
+
+  State X = X_init;
+  const Control u(0.1, 0.0, 0.05);
+  for (int k = 0; k < 20; ++k) {
+    X = X + u;
+    dynamic.propagate(system_model, u);
+    fixed.propagate(system_model, u);
+
+    const Measurement y =
+      measurement_model(X) + Measurement(0.01, -0.02) * (k % 3);
+    dynamic.update(measurement_model, y);
+    fixed.update(measurement_model, y);
+
+    EXPECT_MANIF_NEAR(dynamic.getState(), fixed.getState(), 1e-12);
+    EXPECT_EIGEN_NEAR(dynamic.getCovariance(), fixed.getCovariance(), 1e-12);
+  }
+
+  // the parameters can not be changed at runtime
+  EXPECT_THROW(
+    UKFM<Static>(X_init, P_init, 1e-2, 1e-2, 1e-2), kalmanif::invalid_argument
+  );
+}
+
+TEST(TEST_SIGMA_POINTS, TEST_STATIC_UKFM)
+{
+  checkStaticUKFM<SymmetricSigmaPoints>();
+  checkStaticUKFM<SphericalSimplexSigmaPoints>();
+  checkStaticUKFM<MinimalSkewSigmaPoints>();
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,240 @@
+/**
+ * \file gtest_sliding_window_smoother.cpp
+ *
+ * Check the sliding-window smoother against the Rauch-Tung-Striebel
+ * smoother on a linear system, and its marginalization on SE2.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/Rn.h>
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+/**
+ * @brief A linear system model on R2, x_{k+1} = F(u).x_k + u
+ */
+struct LinearSystemModel;
+
+/**
+ * @brief A linear measurement model on R2, y = C.x
+ */
+struct LinearMeasurementModel;
+
+namespace kalmanif {
+namespace internal {
+
+template <>
+struct traits<LinearSystemModel> {
+  using State = R2d;
+  using Control = R2d::Tangent;
+};
+
+template <>
+struct traits<LinearMeasurementModel> {
+  using State = R2d;
+  using Measurement = Eigen::Vector2d;
+};
+
+} // namespace internal
+} // namespace kalmanif
+
+struct LinearSystemModel
+  : SystemModelBase<LinearSystemModel>
+  , Linearized<SystemModelBase<LinearSystemModel>> {
+
+  using Base = SystemModelBase<LinearSystemModel>;
+  using Base::getCovariance;
+  using Base::getCovarianceSquareRoot;
+  using Base::operator ();
+
+  using State = R2d;
+  using Control = R2d::Tangent;
+
+  LinearSystemModel(const Eigen::Ref<const Covariance<Control>>& Q)
+    : Base(Q) {}
+
+  static Eigen::Matrix2d F(const Control& u) {
+    return (Eigen::Matrix2d() << 1, u.coeffs()(1), -0.3 * u.coeffs()(1), 1)
+      .finished();
+  }
+
+  State run(const State& x, const Control& u) const {
+    return State(F(u) * x.coeffs() + u.coeffs());
+  }
+
+  State run_linearized(
+    const State& x,
+    const Control& u,
+    Eigen::Ref<Jacobian<State, State>> J_x,
+    Eigen::Ref<Jacobian<State, Control>> J_u
+  ) const {
+    J_x = F(u);
+    J_u.setIdentity();
+    return run(x, u);
+  }
+};
+
+struct LinearMeasurementModel
+  : MeasurementModelBase<LinearMeasurementModel>
+  , Linearized<MeasurementModelBase<LinearMeasurementModel>> {
+
+  using Base = MeasurementModelBase<LinearMeasurementModel>;
+  using Base::setCovariance;
+  using Base::getCovariance;
+  using Base::getCovarianceSquareRoot;
+  using Base::operator ();
+
+  using Measurement = Eigen::Vector2d;
+
+  LinearMeasurementModel(const Eigen::Ref<Covariance<Measurement>>& R) {
+    setCovariance(R);
+  }
+
+  static Eigen::Matrix2d C() {
+    return (Eigen::Matrix2d() << 1, 0.5, 0, 1).finished();
+  }
+
+  Measurement run(const R2d& x) const {
+    return C() * x.coeffs();
+  }
+
+  Measurement run_linearized(
+    const R2d& x,
+    Eigen::Ref<Jacobian<Measurement, R2d>> H,
+    Eigen::Ref<Jacobian<Measurement, Measurement>> V
+  ) const {
+    H = C();
+    V.setIdentity();
+    return run(x);
+  }
+};
+
+TEST(TEST_SLIDING_WINDOW_SMOOTHER, TEST_LINEAR)
+{
+  using State = R2d;
+  using Control = State::Tangent;
+  using Measurement = LinearMeasurementModel::Measurement;
+
+  constexpr std::size_t Window = 5;
+
+  const LinearSystemModel system_model(Covariance<State>::Identity() * 1e-2);
+  Eigen::Matrix2d R = Eigen::Matrix2d::Identity() * 1e-1;
+  const LinearMeasurementModel measurement_model(R);
+
+  const State X_init(Eigen::Vector2d(0.1, -0.2));
+  const Covariance<State> P_init =
+    (Covariance<State>() << 1, 0.2, 0.2, 0.5).finished();
+
+  RauchTungStriebelSmoother<ExtendedKalmanFilter<State>> rts(X_init, P_init);
+  SlidingWindowSmoother<LinearSystemModel, LinearMeasurementModel, Window>
+    sws(X_init, P_init);
+
+  EXPECT_EQ(1u, sws.size());
+
+  for (int k = 0; k < 12; ++k) {
+    const Control u(Eigen::Vector2d(0.1, 0.05 * (k % 4)));
+    rts.propagate(system_model, u);
+    sws.propagate(system_model, u);
+
+    const Measurement y(std::sin(k * 0.3), 0.1 * k);
+    rts.update(measurement_model, y);
+    sws.update(measurement_model, y);
+
+    // the estimate of the last epoch is the filtered one
+    EXPECT_MANIF_NEAR(rts.getState(), sws.getState(), 1e-10);
+    EXPECT_EIGEN_NEAR(rts.getCovariance(), sws.getCovariance(), 1e-10);
+  }
+
+  // linear, a single step converges
+  EXPECT_EQ(IterationStop::Converged, sws.getIterationSummary().stop);
+
+  // the window is that of the RTS smoothed sequence
+  ASSERT_EQ(Window, sws.size());
+
+  const auto& states = rts.smooth();
+  const auto& covariances = rts.getCovariances();
+  const std::size_t offset = states.size() - Window;
+
+  for (std::size_t i = 0; i < Window; ++i) {
+    EXPECT_MANIF_NEAR(states[offset + i], sws.getWindowState(i), 1e-10);
+    EXPECT_EIGEN_NEAR(
+      covariances[offset + i], sws.getWindowCovariance(i), 1e-10
+    );
+  }
+}
+
+TEST(TEST_SLIDING_WINDOW_SMOOTHER, TEST_MARGINALIZATION)
+{
+  using State = SE2d;
+  using SystemModel = LieSystemModel<State>;
+  using Control = SystemModel::Control;
+  using MeasurementModel = Landmark2DMeasurementModel<State>;
+  using Landmark = MeasurementModel::Landmark;
+  using Measurement = MeasurementModel::Measurement;
+
+  const SystemModel system_model(Covariance<State>::Identity() * 1e-3);
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+
+  const std::vector<MeasurementModel> measurement_models = {
+    MeasurementModel(Landmark(2.0, 1.0), R),
+    MeasurementModel(Landmark(-1.0, 3.0), R),
+  };
+
+  const State X_init(0.05, -0.05, 0.02);
+  const Covariance<State> P_init = Covariance<State>::Identity() * 1e-2;
+
+  // the same run, marginalized or not
+  SlidingWindowSmoother<SystemModel, MeasurementModel, 4> sliding(
+    X_init, P_init
+  );
+  SlidingWindowSmoother<SystemModel, MeasurementModel, 32> full(
+    X_init, P_init
+  );
+
+  State X = X_init;
+  const Control u(0.1, 0.0, 0.05);
+  std::vector<Measurement> ys(measurement_models.size());
+  for (int k = 0; k < 20; ++k) {
+    X = X + u;
+    sliding.propagate(system_model, u);
+    full.propagate(system_model, u);
+
+    for (std::size_t i = 0; i < ys.size(); ++i) {
+      ys[i] = measurement_models[i](X) + Measurement(0.01, -0.02) * (k % 3);
+    }
+
+    sliding.update(measurement_models, ys);
+    full.update(measurement_models, ys);
+
+    EXPECT_EQ(
+      IterationStop::Converged, sliding.getIterationSummary().stop
+    );
+  }
+
+  EXPECT_EQ(4u, sliding.size());
+  EXPECT_EQ(21u, full.size());
+
+  // the marginalized epochs are linearized once and for all
+  EXPECT_MANIF_NEAR(full.getState(), sliding.getState(), 1e-4);
+  EXPECT_EIGEN_NEAR(full.getCovariance(), sliding.getCovariance(), 1e-4);
+
+  for (std::size_t i = 0; i < sliding.size(); ++i) {
+    EXPECT_MANIF_NEAR(
+      full.getWindowState(full.size() - sliding.size() + i),
+      sliding.getWindowState(i),
+      1e-4
+    );
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,589 @@
+/**
+ * \file gtest_smoother.cpp
+ *
+ * Check the Rauch-Tung-Striebel smoothers epochs storage and gains.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using ERTS = RauchTungStriebelSmoother<EKF>;
+
+template <typename T>
+using vector_t = ERTS::vector_t<T>;
+
+class TEST_SMOOTHER : public testing::Test {
+protected:
+
+  template <typename Smoother>
+  void run(Smoother& smoother, const int epochs) const {
+    State X_simulation = State::Identity();
+    for (int k = 0; k < epochs; ++k) {
+      X_simulation = X_simulation + u;
+      smoother.propagate(system_model, u);
+      smoother.update(
+        measurement_model,
+        measurement_model(X_simulation) + Measurement(0.01, -0.02) * (k % 3)
+      );
+    }
+  }
+
+  /**
+   * Smooth several propagations of varying controls between updates,
+   * once composed into an epoch per update and once as an epoch per
+   * propagation, the intermediate ones updated by an uninformative
+   * measurement.
+   */
+  template <typename Filter>
+  void checkComposition() const {
+    const MeasurementModel uninformative{
+      Landmark(2.0, 1.0), Eigen::Matrix2d::Identity() * 1e12
+    };
+
+    RauchTungStriebelSmoother<Filter> composed(X_init, P_init);
+    RauchTungStriebelSmoother<Filter> stepped(X_init, P_init);
+
+    // The epochs of stepped updated by a measurement
+    std::vector<std::size_t> updated;
+    std::size_t propagations = 0;
+
+    State X_simulation = State::Identity();
+    for (int k = 0; k < 20; ++k) {
+      for (int i = 0; i <= k % 3; ++i) {
+        if (i > 0) {
+          stepped.update(uninformative, uninformative(stepped.getState()));
+        }
+
+        const Control u_i(0.1, 0.0, 0.05 + 0.1 * ((k + i) % 4));
+        X_simulation = X_simulation + u_i;
+        composed.propagate(system_model, u_i);
+        stepped.propagate(system_model, u_i);
+        ++propagations;
+      }
+
+      const Measurement y =
+        measurement_model(X_simulation) + Measurement(0.01, -0.02) * (k % 3);
+      composed.update(measurement_model, y);
+      stepped.update(measurement_model, y);
+      updated.push_back(propagations - 1);
+    }
+
+    const auto& Xs = composed.smooth();
+    const auto& Xs_stepped = stepped.smooth();
+
+    ASSERT_EQ(updated.size(), Xs.size());
+    ASSERT_EQ(propagations, Xs_stepped.size());
+
+    for (std::size_t k = 0; k < Xs.size(); ++k) {
+      EXPECT_MANIF_NEAR(Xs[k], Xs_stepped[updated[k]], 1e-8);
+      EXPECT_EIGEN_NEAR(
+        composed.getCovariances()[k],
+        stepped.getCovariances()[updated[k]],
+        1e-8
+      );
+    }
+  }
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+  Control u = Control(0.1, 0.0, 0.05);
+
+  State X_init = State(0.05, -0.05, 0.02);
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+};
+
+TEST_F(TEST_SMOOTHER, TEST_EPOCHS)
+{
+  constexpr int epochs = 20;
+
+  ERTS smoother(X_init, P_init);
+  run(smoother, epochs);
+
+  // A trailing propagation without update is not an epoch
+  smoother.propagate(system_model, u);
+
+  const auto& Xs = smoother.smooth();
+  const auto& Ps = smoother.getCovariances();
+
+  ASSERT_EQ(std::size_t(epochs), Xs.size());
+  ASSERT_EQ(std::size_t(epochs), Ps.size());
+
+  // The last smoothed estimate is the last filtered estimate
+  EKF ekf(X_init, P_init);
+  run(ekf, epochs);
+
+  EXPECT_MANIF_NEAR(ekf.getState(), Xs.back());
+  EXPECT_EIGEN_NEAR(ekf.getCovariance(), Ps.back());
+}
+
+TEST_F(TEST_SMOOTHER, TEST_RESERVE)
+{
+  constexpr int epochs = 50;
+
+  ERTS smoother(X_init, P_init);
+  ERTS smoother_reserved(X_init, P_init);
+
+  smoother_reserved.reserve(epochs);
+  const State* data = smoother_reserved.getStates().data();
+
+  run(smoother, epochs);
+  run(smoother_reserved, epochs);
+
+  smoother.smooth();
+  smoother_reserved.smooth();
+
+  // No reallocation
+  EXPECT_EQ(data, smoother_reserved.getStates().data());
+
+  ASSERT_EQ(smoother.getStates().size(), smoother_reserved.getStates().size());
+  for (std::size_t k = 0; k < smoother.getStates().size(); ++k) {
+    EXPECT_MANIF_NEAR(
+      smoother.getStates()[k], smoother_reserved.getStates()[k]
+    );
+  }
+}
+
+TEST_F(TEST_SMOOTHER, TEST_SMOOTH_TWICE)
+{
+  ERTS smoother(X_init, P_init);
+  run(smoother, 10);
+
+  const vector_t<State> Xs = smoother.smooth();
+
+  // Smoothing does not modify the recorded epochs
+  EXPECT_EQ(Xs.size(), smoother.smooth().size());
+  for (std::size_t k = 0; k < Xs.size(); ++k) {
+    EXPECT_MANIF_NEAR(Xs[k], smoother.getStates()[k]);
+  }
+
+  run(smoother, 5);
+  smoother.smooth();
+
+  ASSERT_EQ(15u, smoother.getStates().size());
+
+  smoother.clear();
+  EXPECT_TRUE(smoother.smooth().empty());
+}
+
+TEST_F(TEST_SMOOTHER, TEST_SMOOTH_INCREMENTAL)
+{
+  ERTS smoother(X_init, P_init);
+  ERTS incremental(X_init, P_init);
+
+  for (int i = 0; i < 4; ++i) {
+    run(smoother, 25);
+    run(incremental, 25);
+
+    const auto& Xs = smoother.smooth();
+    const auto& Xs_incremental = incremental.smooth(1e-12);
+
+    ASSERT_EQ(Xs.size(), Xs_incremental.size());
+    for (std::size_t k = 0; k < Xs.size(); ++k) {
+      EXPECT_MANIF_NEAR(Xs[k], Xs_incremental[k], 1e-10);
+      EXPECT_EIGEN_NEAR(
+        smoother.getCovariances()[k], incremental.getCovariances()[k], 1e-10
+      );
+    }
+  }
+
+  // A rolled back epoch is smoothed anew
+  ERTS::Snapshot snapshot;
+  incremental.snapshot(snapshot);
+  run(incremental, 3);
+  incremental.smooth(1e-12);
+  incremental.rollback(snapshot);
+  run(incremental, 2);
+  run(smoother, 2);
+
+  const auto& Xs = smoother.smooth();
+  const auto& Xs_incremental = incremental.smooth(1e-12);
+
+  ASSERT_EQ(Xs.size(), Xs_incremental.size());
+  for (std::size_t k = 0; k < Xs.size(); ++k) {
+    EXPECT_MANIF_NEAR(Xs[k], Xs_incremental[k], 1e-10);
+  }
+}
+
+TEST_F(TEST_SMOOTHER, TEST_SMOOTH_WINDOW)
+{
+  ERTS smoother(X_init, P_init);
+  run(smoother, 30);
+
+  EXPECT_THROW(smoother.smooth(10, 10), kalmanif::invalid_argument);
+  EXPECT_THROW(smoother.smooth(10, 31), kalmanif::invalid_argument);
+
+  const vector_t<State> Xs = smoother.smooth();
+  const vector_t<StateCovariance> Ps(
+    smoother.getCovariances().begin(), smoother.getCovariances().end()
+  );
+
+  // The trailing window is that of the batch smoothing
+  ERTS windowed(X_init, P_init);
+  run(windowed, 30);
+  windowed.smooth(20, 30);
+
+  ASSERT_EQ(30u, windowed.getStates().size());
+  for (std::size_t k = 20; k < 30; ++k) {
+    EXPECT_MANIF_NEAR(Xs[k], windowed.getStates()[k], 1e-12);
+    EXPECT_EIGEN_NEAR(Ps[k], windowed.getCovariances()[k], 1e-12);
+  }
+
+  // An inner window is smoothed from the filtered estimate
+  // of its last epoch, as a smoother stopped there
+  ERTS stopped(X_init, P_init);
+  run(stopped, 15);
+  const auto& Xs_stopped = stopped.smooth();
+
+  smoother.smooth(5, 15);
+  for (std::size_t k = 5; k < 15; ++k) {
+    EXPECT_MANIF_NEAR(Xs_stopped[k], smoother.getStates()[k], 1e-12);
+  }
+
+  // The incremental smoothing does not stop past the window
+  smoother.smooth(1e-12);
+  for (std::size_t k = 0; k < 30; ++k) {
+    EXPECT_MANIF_NEAR(Xs[k], smoother.getStates()[k], 1e-10);
+  }
+}
+
+TEST_F(TEST_SMOOTHER, TEST_TIMESTAMPS)
+{
+  constexpr double dt = 0.1;
+
+  ERTS smoother(X_init, P_init);
+  ERTS lazy(X_init, P_init);
+
+  State X_simulation = State::Identity();
+  for (int k = 0; k < 20; ++k) {
+    X_simulation = X_simulation + u;
+    const Measurement y =
+      measurement_model(X_simulation) + Measurement(0.01, -0.02) * (k % 3);
+
+    smoother.propagate(system_model, u);
+    smoother.update(dt * k, measurement_model, y);
+    lazy.propagate(system_model, u);
+    lazy.update(dt * k, measurement_model, y);
+  }
+
+  // Out of sequence
+  ERTS::Snapshot snapshot;
+  smoother.snapshot(snapshot);
+  smoother.propagate(system_model, u);
+  EXPECT_THROW(
+    smoother.update(dt, measurement_model, Measurement(1, 1)),
+    kalmanif::invalid_argument
+  );
+  smoother.rollback(snapshot);
+
+  const auto& Xs = smoother.smooth();
+  const auto& Ps = smoother.getCovariances();
+
+  State x;
+  StateCovariance P;
+
+  EXPECT_FALSE(smoother.getSmoothed(-dt, x, P));
+  EXPECT_FALSE(smoother.getSmoothed(dt * 20, x, P));
+  EXPECT_FALSE(lazy.getSmoothed(dt * 5, x, P));
+
+  // At the epochs
+  for (std::size_t k = 0; k < Xs.size(); ++k) {
+    ASSERT_TRUE(smoother.getSmoothed(dt * k, x, P));
+    EXPECT_MANIF_NEAR(Xs[k], x);
+    EXPECT_EIGEN_NEAR(Ps[k], P);
+  }
+
+  // Along the geodesic in between, the covariances in the tangent
+  // space of the interpolated state
+  ASSERT_TRUE(smoother.getSmoothed(dt * 4.25, x, P));
+  EXPECT_MANIF_NEAR(Xs[4] + (Xs[5] - Xs[4]) * 0.25, x);
+  EXPECT_MANIF_NEAR(Xs[5] + (Xs[4] - Xs[5]) * 0.75, x);
+
+  const StateCovariance P4 = (Xs[4] - x).exp().adj() * Ps[4] *
+    (Xs[4] - x).exp().adj().transpose();
+  const StateCovariance P5 = (Xs[5] - x).exp().adj() * Ps[5] *
+    (Xs[5] - x).exp().adj().transpose();
+  EXPECT_EIGEN_NEAR(StateCovariance(0.75 * P4 + 0.25 * P5), P, 1e-10);
+
+  // Lazily smoothed from the needed epoch onward
+  ASSERT_TRUE(lazy.smoothAt(dt * 12.5, x, P));
+  EXPECT_FALSE(lazy.getSmoothed(dt * 11.5, x, P));
+
+  ASSERT_TRUE(lazy.smoothAt(dt * 2.5, x, P));
+  for (double t = 0; t <= dt * 19; t += dt / 3) {
+    State x_lazy;
+    StateCovariance P_lazy;
+    ASSERT_TRUE(lazy.smoothAt(t, x_lazy, P_lazy));
+    ASSERT_TRUE(smoother.getSmoothed(t, x, P));
+    EXPECT_MANIF_NEAR(x, x_lazy, 1e-12);
+    EXPECT_EIGEN_NEAR(P, P_lazy, 1e-12);
+  }
+}
+
+template <typename Filter>
+struct ExposedSmoother : RauchTungStriebelSmoother<Filter> {
+  using RauchTungStriebelSmoother<Filter>::RauchTungStriebelSmoother;
+  using RauchTungStriebelSmoother<Filter>::epochs_;
+};
+
+template <typename Filter>
+void checkGains(const ExposedSmoother<Filter>& smoother) {
+  const auto& epochs = smoother.epochs_;
+  for (std::size_t k = 0; k + 1 < epochs.size(); ++k) {
+    // The gains of the explicit inverse formulation, of the transition
+    // into the epoch k+1, A = P F^T if unscented and A = F^T otherwise
+    const Jacobian<State, State> Ks =
+      internal::is_unscented<Filter>{} ?
+        Jacobian<State, State>(
+          epochs[k+1].A * epochs[k+1].P_pred.inverse()
+        ) :
+        Jacobian<State, State>(
+          epochs[k].P_est * epochs[k+1].A * epochs[k+1].P_pred.inverse()
+        );
+
+    EXPECT_EIGEN_NEAR(
+      Ks, internal::smootherGain<Filter>(epochs[k], epochs[k+1]), 1e-10
+    );
+  }
+}
+
+TEST_F(TEST_SMOOTHER, TEST_GAINS)
+{
+  using SEKF = SquareRootExtendedKalmanFilter<State>;
+  using UKFM = UnscentedKalmanFilterManifolds<State>;
+
+  ExposedSmoother<EKF> ekf(X_init, P_init);
+  ExposedSmoother<SEKF> sekf(X_init, P_init);
+  ExposedSmoother<UKFM> ukfm(X_init, P_init);
+
+  run(ekf, 10);
+  run(sekf, 10);
+  run(ukfm, 10);
+
+  checkGains(ekf);
+  // The predicted covariance square roots are copied from the filters
+  checkGains(sekf);
+  checkGains(ukfm);
+
+  // The smoothed covariances are exactly symmetric
+  sekf.smooth();
+  for (const auto& P : sekf.getCovariances()) {
+    EXPECT_EQ(P, P.transpose());
+  }
+}
+
+TEST_F(TEST_SMOOTHER, TEST_COMPOSED_TRANSITIONS)
+{
+  checkComposition<EKF>();
+  checkComposition<SquareRootExtendedKalmanFilter<State>>();
+  checkComposition<InvariantExtendedKalmanFilter<State>>();
+  checkComposition<UnscentedKalmanFilterManifolds<State>>();
+}
+
+TEST_F(TEST_SMOOTHER, TEST_PACKED_COVARIANCE)
+{
+  using Packed = PackedCovariance<State>;
+
+  EXPECT_EQ(6, Packed::PackedSize);
+  EXPECT_EQ(6 * sizeof(double), sizeof(Packed));
+
+  // exactly symmetric
+  const StateCovariance P = internal::covarianceProduct(
+    StateCovariance::Random(), StateCovariance::Identity()
+  );
+
+  const Packed packed(P);
+  EXPECT_TRUE(P == packed.unpack());
+
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_EQ(P(i, j), packed(i, j));
+    }
+  }
+}
+
+TEST_F(TEST_SMOOTHER, TEST_PACKED_STORAGE)
+{
+  using PackedERTS = RauchTungStriebelSmoother<EKF, PackedStorage<>>;
+
+  ERTS smoother(X_init, P_init);
+  PackedERTS smoother_packed(X_init, P_init);
+
+  run(smoother, 20);
+  run(smoother_packed, 20);
+
+  const auto& Xs = smoother.smooth();
+  const auto& Xs_packed = smoother_packed.smooth();
+
+  const auto& Ps_packed = smoother_packed.getCovariances();
+  static_assert(
+    std::is_same<
+      PackedCovariance<State>, std::decay_t<decltype(Ps_packed[0])>
+    >::value,
+    "The smoothed covariances are packed"
+  );
+
+  ASSERT_EQ(Xs.size(), Xs_packed.size());
+  for (std::size_t k = 0; k < Xs.size(); ++k) {
+    EXPECT_MANIF_NEAR(Xs[k], Xs_packed[k], 1e-12);
+    EXPECT_EIGEN_NEAR(
+      smoother.getCovariances()[k], Ps_packed[k].unpack(), 1e-12
+    );
+  }
+}
+
+TEST_F(TEST_SMOOTHER, TEST_COMPRESSED_COVARIANCE)
+{
+  const StateCovariance B = StateCovariance::Random();
+  const StateCovariance P = B * B.transpose() + StateCovariance::Identity();
+
+  const auto check = [&P](const auto& compressed) {
+    using Compressed = std::decay_t<decltype(compressed)>;
+    const double tol =
+      2 * 3 * Compressed::ErrorBound * P.diagonal().maxCoeff();
+
+    const StateCovariance decoded = compressed.unpack();
+    EXPECT_EIGEN_NEAR(P, decoded, tol);
+    EXPECT_EQ(decoded, decoded.transpose());
+  };
+
+  check(CompressedCovariance<State, CovarianceCodec::Float>(P));
+  check(CompressedCovariance<State, CovarianceCodec::Cholesky>(P));
+  check(CompressedCovariance<State, CovarianceCodec::Cholesky16>(P));
+
+  // A semi-definite covariance
+  const StateCovariance Q = Eigen::Vector3d(1, 1, 0).asDiagonal();
+  EXPECT_EIGEN_NEAR(
+    Q, (CompressedCovariance<State, CovarianceCodec::Cholesky16>(Q).unpack()),
+    1e-4
+  );
+
+  EXPECT_EQ(
+    6 * sizeof(std::int16_t) + sizeof(float),
+    sizeof(CompressedCovariance<State, CovarianceCodec::Cholesky16>)
+  );
+}
+
+TEST_F(TEST_SMOOTHER, TEST_COMPRESSED_STORAGE)
+{
+  using CompressedERTS = RauchTungStriebelSmoother<
+    EKF, CompressedStorage<CovarianceCodec::Cholesky>
+  >;
+  using Compressed16ERTS = RauchTungStriebelSmoother<
+    EKF, CompressedStorage<CovarianceCodec::Cholesky16>
+  >;
+
+  ERTS smoother(X_init, P_init);
+  CompressedERTS compressed(X_init, P_init);
+  Compressed16ERTS compressed16(X_init, P_init);
+
+  run(smoother, 50);
+  run(compressed, 50);
+  run(compressed16, 50);
+
+  const auto& Xs = smoother.smooth();
+  const auto& Xs_compressed = compressed.smooth();
+  const auto& Xs_compressed16 = compressed16.smooth();
+
+  ASSERT_EQ(Xs.size(), Xs_compressed.size());
+  ASSERT_EQ(Xs.size(), Xs_compressed16.size());
+  for (std::size_t k = 0; k < Xs.size(); ++k) {
+    const StateCovariance& P = smoother.getCovariances()[k];
+
+    EXPECT_MANIF_NEAR(Xs[k], Xs_compressed[k], 1e-6);
+    EXPECT_EIGEN_NEAR(
+      P, compressed.getCovariances()[k].unpack(), 1e-6 * P.norm()
+    );
+
+    EXPECT_MANIF_NEAR(Xs[k], Xs_compressed16[k], 1e-3);
+    EXPECT_EIGEN_NEAR(
+      P, compressed16.getCovariances()[k].unpack(), 1e-3 * P.norm()
+    );
+  }
+}
+
+TEST_F(TEST_SMOOTHER, TEST_SQUARE_ROOT)
+{
+  using SEKF = SquareRootExtendedKalmanFilter<State>;
+  using SRTS = SquareRootRauchTungStriebelSmoother<SEKF>;
+
+  SRTS smoother(X_init, P_init);
+  EKF ekf(X_init, P_init);
+
+  // The filtering quantities of the explicit formulation,
+  // over several propagations of varying controls between updates
+  vector_t<State> X_pred, X_est;
+  vector_t<StateCovariance> P_pred, P_est, F;
+
+  State X_simulation = State::Identity();
+  for (int k = 0; k < 20; ++k) {
+    StateCovariance F_k = StateCovariance::Identity();
+    for (int i = 0; i <= k % 3; ++i) {
+      const Control u_i(0.1, 0.0, 0.05 + 0.1 * ((k + i) % 4));
+
+      StateCovariance F_i;
+      Jacobian<State, Control> W_i;
+      system_model.run_linearized(ekf.getState(), u_i, F_i, W_i);
+      F_k = F_i * F_k;
+
+      X_simulation = X_simulation + u_i;
+      smoother.propagate(system_model, u_i);
+      ekf.propagate(system_model, u_i);
+    }
+
+    X_pred.push_back(ekf.getState());
+    P_pred.push_back(ekf.getCovariance());
+    F.push_back(F_k);
+
+    const Measurement y =
+      measurement_model(X_simulation) + Measurement(0.01, -0.02) * (k % 3);
+    smoother.update(measurement_model, y);
+    ekf.update(measurement_model, y);
+
+    X_est.push_back(ekf.getState());
+    P_est.push_back(ekf.getCovariance());
+  }
+
+  const auto& Xs = smoother.smooth();
+  const auto& Ss = smoother.getCovarianceSquareRoots();
+
+  const std::size_t n = X_est.size();
+  ASSERT_EQ(n, Xs.size());
+  ASSERT_EQ(n, Ss.size());
+
+  State Xs_k = X_est[n-1];
+  StateCovariance Ps_k = P_est[n-1];
+  for (std::size_t k = n; k-- > 0;) {
+    if (k + 1 < n) {
+      const StateCovariance Ks =
+        P_est[k] * F[k+1].transpose() * P_pred[k+1].inverse();
+      Xs_k = X_est[k] + (Ks * (Xs_k - X_pred[k+1]));
+      Ps_k = P_est[k] + Ks * (Ps_k - P_pred[k+1]) * Ks.transpose();
+    }
+
+    EXPECT_MANIF_NEAR(Xs_k, Xs[k], 1e-8);
+    EXPECT_EIGEN_NEAR(Ps_k, Ss[k].reconstructedMatrix(), 1e-8);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
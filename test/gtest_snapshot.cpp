@@ -0,0 +1,196 @@
+/**
+ * \file gtest_snapshot.cpp
+ *
+ * Check the filter snapshots and rollbacks.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using SEKF = SquareRootExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+using UKFM = UnscentedKalmanFilterManifolds<State>;
+using IKF = InformationKalmanFilter<State>;
+using ERTS = RauchTungStriebelSmoother<EKF>;
+
+class TEST_SNAPSHOT : public testing::Test {
+protected:
+
+  Measurement measure(const State& X, const int k) const {
+    return measurement_model(X) + Measurement(0.01, -0.02) * (k % 3);
+  }
+
+  /**
+   * Roll back a tentative update, and a propagation after it,
+   * at each epoch and check the filter estimates as if
+   * they never happened.
+   */
+  template <typename Filter>
+  void checkRollback(const bool lazy = false) const {
+    Filter filter(X_init, P_init);
+    Filter reference(X_init, P_init);
+
+    if constexpr (internal::has_lazy_propagation<Filter>::value) {
+      filter.setLazyPropagation(lazy);
+      reference.setLazyPropagation(lazy);
+    }
+
+    UndoBuffer<Filter> undo;
+
+    State X = X_init;
+    for (int k = 0; k < 10; ++k) {
+      X = X + u;
+      filter.propagate(system_model, u);
+      reference.propagate(system_model, u);
+
+      undo.push(filter);
+      filter.update(outlier_model, measure(X, k));
+      filter.propagate(system_model, u);
+      EXPECT_TRUE(undo.undo(filter));
+
+      EXPECT_MANIF_NEAR(reference.getState(), filter.getState(), 1e-12);
+      EXPECT_EIGEN_NEAR(
+        reference.getCovariance(), filter.getCovariance(), 1e-12
+      );
+
+      filter.update(measurement_model, measure(X, k));
+      reference.update(measurement_model, measure(X, k));
+    }
+
+    EXPECT_TRUE(undo.empty());
+    EXPECT_MANIF_NEAR(reference.getState(), filter.getState(), 1e-12);
+    EXPECT_EIGEN_NEAR(reference.getCovariance(), filter.getCovariance(), 1e-12);
+  }
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+  MeasurementModel outlier_model{Landmark(-3.0, 2.0), R};
+  Control u = Control(0.1, 0.0, 0.05);
+
+  State X_init = State(0.05, -0.05, 0.02);
+  StateCovariance P_init = StateCovariance::Identity() * 0.1;
+};
+
+TEST_F(TEST_SNAPSHOT, TEST_EKF)
+{
+  checkRollback<EKF>();
+}
+
+TEST_F(TEST_SNAPSHOT, TEST_LAZY_EKF)
+{
+  checkRollback<EKF>(true);
+}
+
+TEST_F(TEST_SNAPSHOT, TEST_SEKF)
+{
+  checkRollback<SEKF>();
+}
+
+TEST_F(TEST_SNAPSHOT, TEST_IEKF)
+{
+  checkRollback<IEKF>(true);
+}
+
+TEST_F(TEST_SNAPSHOT, TEST_UKFM)
+{
+  checkRollback<UKFM>();
+}
+
+TEST_F(TEST_SNAPSHOT, TEST_IKF)
+{
+  checkRollback<IKF>();
+}
+
+TEST_F(TEST_SNAPSHOT, TEST_SMOOTHER)
+{
+  ERTS smoother(X_init, P_init);
+  ERTS reference(X_init, P_init);
+
+  UndoBuffer<ERTS, 2> undo;
+
+  State X = X_init;
+  for (int k = 0; k < 20; ++k) {
+    X = X + u;
+    smoother.propagate(system_model, u);
+    reference.propagate(system_model, u);
+
+    // two nested tentative updates, the epochs they add are dropped
+    undo.push(smoother);
+    smoother.update(outlier_model, measure(X, k));
+    undo.push(smoother);
+    smoother.propagate(system_model, u);
+    smoother.update(outlier_model, measure(X, k));
+    EXPECT_TRUE(undo.undo(smoother));
+    EXPECT_TRUE(undo.undo(smoother));
+
+    smoother.update(measurement_model, measure(X, k));
+    reference.update(measurement_model, measure(X, k));
+  }
+
+  const auto& Xs = smoother.smooth();
+  const auto& Xr = reference.smooth();
+
+  ASSERT_EQ(Xr.size(), Xs.size());
+  for (std::size_t k = 0; k < Xs.size(); ++k) {
+    EXPECT_MANIF_NEAR(Xr[k], Xs[k], 1e-12);
+    EXPECT_EIGEN_NEAR(
+      reference.getCovariances()[k], smoother.getCovariances()[k], 1e-12
+    );
+  }
+
+  ERTS::Snapshot snapshot;
+  smoother.snapshot(snapshot);
+  smoother.clear();
+  EXPECT_THROW(smoother.rollback(snapshot), kalmanif::invalid_argument);
+}
+
+TEST_F(TEST_SNAPSHOT, TEST_UNDO_BUFFER)
+{
+  EKF ekf(X_init, P_init);
+
+  UndoBuffer<EKF, 2> undo;
+  EXPECT_EQ(2u, undo.capacity());
+  EXPECT_FALSE(undo.undo(ekf));
+
+  // the oldest snapshot is overwritten once full
+  std::vector<State> states;
+  for (int k = 0; k < 3; ++k) {
+    ekf.propagate(system_model, u);
+    states.push_back(ekf.getState());
+    undo.push(ekf);
+  }
+  EXPECT_EQ(2u, undo.size());
+
+  ekf.propagate(system_model, u);
+
+  EXPECT_TRUE(undo.undo(ekf));
+  EXPECT_MANIF_NEAR(states[2], ekf.getState());
+  EXPECT_TRUE(undo.undo(ekf));
+  EXPECT_MANIF_NEAR(states[1], ekf.getState());
+  EXPECT_FALSE(undo.undo(ekf));
+
+  undo.push(ekf);
+  undo.pop();
+  EXPECT_TRUE(undo.empty());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
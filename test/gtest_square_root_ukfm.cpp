@@ -0,0 +1,175 @@
+/**
+ * \file gtest_square_root_ukfm.cpp
+ *
+ * Check the square root UKFM against the UKFM.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using LandmarkModel = Landmark2DMeasurementModel<State>;
+using Landmark = LandmarkModel::Landmark;
+using GPSModel = DummyGPSMeasurementModel<State>;
+using Measurement = LandmarkModel::Measurement;
+
+template <typename SigmaPoints = SymmetricSigmaPoints>
+using UKFM = UnscentedKalmanFilterManifolds<
+  State, Invariance::Right, SequentialExecutor, SigmaPoints
+>;
+
+template <typename SigmaPoints = SymmetricSigmaPoints>
+using SRUKFM = SquareRootUnscentedKalmanFilterManifolds<
+  State, Invariance::Right, SequentialExecutor, SigmaPoints
+>;
+
+class TEST_SQUARE_ROOT_UKFM_F : public testing::Test
+{
+public:
+
+  TEST_SQUARE_ROOT_UKFM_F()
+    : system_model(StateCovariance::Identity() * 1e-3)
+    , R(Eigen::Vector2d(1e-2, 2e-2).asDiagonal())
+    , landmark_model(Landmark(2.0, 1.0), R)
+    , gps_model(R)
+    , X_init(0.05, -0.05, 0.02)
+    , P_init(StateCovariance::Identity() * 1e-2)
+  {}
+
+  /**
+   * Run both filters on the same sequence, a landmark every step
+   * and, if with_gps, a GPS fix every other step.
+   */
+  template <typename Filter, typename SquareRootFilter>
+  void run(
+    Filter& filter, SquareRootFilter& sqrt_filter,
+    const bool with_gps, const double tol
+  ) {
+    State X = X_init;
+    const Control u(0.1, 0.0, 0.05);
+    for (int k = 0; k < 20; ++k) {
+      X = X + u;
+      filter.propagate(system_model, u);
+      sqrt_filter.propagate(system_model, u);
+
+      EXPECT_MANIF_NEAR(filter.getState(), sqrt_filter.getState(), tol);
+      EXPECT_EIGEN_NEAR(
+        filter.getCovariance(), sqrt_filter.getCovariance(), tol
+      );
+
+      const Measurement y =
+        landmark_model(X) + Measurement(0.01, -0.02) * (k % 3);
+      filter.update(landmark_model, y);
+      sqrt_filter.update(landmark_model, y);
+
+      if (with_gps && k % 2) {
+        const Measurement g = gps_model(X) + Measurement(-0.02, 0.01);
+        filter.update(gps_model, g);
+        sqrt_filter.update(gps_model, g);
+      }
+
+      EXPECT_MANIF_NEAR(filter.getState(), sqrt_filter.getState(), tol);
+      EXPECT_EIGEN_NEAR(
+        filter.getCovariance(), sqrt_filter.getCovariance(), tol
+      );
+    }
+  }
+
+  SystemModel system_model;
+  Eigen::Matrix2d R;
+  LandmarkModel landmark_model;
+  GPSModel gps_model;
+
+  State X_init;
+  StateCovariance P_init;
+};
+
+TEST(TEST_SQUARE_ROOT_UKFM, TEST_RANK_ONE_UPDATE)
+{
+  using Matrix = Eigen::Matrix<double, 6, 6>;
+  using Vector = Eigen::Matrix<double, 6, 1>;
+
+  const Matrix A = Matrix::Random();
+  const Matrix P = A * A.transpose() + Matrix::Identity();
+  const Vector v = Vector::Random();
+
+  Cholesky<Matrix> L(P);
+
+  ASSERT_TRUE(L.rankOneUpdate(v, 0.5));
+  EXPECT_EIGEN_NEAR(
+    Matrix(P + 0.5 * v * v.transpose()), L.reconstructedMatrix(), 1e-10
+  );
+  EXPECT_TRUE((L.matrixLLT().diagonal().array() > 0).all());
+
+  ASSERT_TRUE(L.rankOneUpdate(v, -0.5));
+  EXPECT_EIGEN_NEAR(P, L.reconstructedMatrix(), 1e-10);
+  EXPECT_EQ(Eigen::Success, L.info());
+
+  // downdating below positive definiteness fails
+  Cholesky<Matrix> I;
+  I.setIdentity();
+  EXPECT_FALSE(I.rankOneUpdate(Vector::Unit(2) * 2., -1.));
+  EXPECT_EQ(Eigen::NumericalIssue, I.info());
+}
+
+TEST_F(TEST_SQUARE_ROOT_UKFM_F, TEST_SYMMETRIC)
+{
+  UKFM<> ukfm(X_init, P_init);
+  SRUKFM<> srukfm(X_init, P_init);
+
+  run(ukfm, srukfm, false, 1e-8);
+
+  EXPECT_EQ(0u, srukfm.getRefactorizationCount());
+}
+
+TEST_F(TEST_SQUARE_ROOT_UKFM_F, TEST_MINIMAL_SKEW)
+{
+  // of non-uniform weights
+  UKFM<MinimalSkewSigmaPoints> ukfm(X_init, P_init);
+  SRUKFM<MinimalSkewSigmaPoints> srukfm(X_init, P_init);
+
+  run(ukfm, srukfm, false, 1e-8);
+}
+
+TEST_F(TEST_SQUARE_ROOT_UKFM_F, TEST_MIXED_INVARIANCE)
+{
+  UKFM<> ukfm(X_init, P_init);
+  SRUKFM<> srukfm(X_init, P_init);
+
+  // the sigma points of the other invariance are those of another
+  // square root of the mapped covariance, of the same two first moments
+  run(ukfm, srukfm, true, 1e-6);
+}
+
+TEST_F(TEST_SQUARE_ROOT_UKFM_F, TEST_SMOOTHER)
+{
+  RauchTungStriebelSmoother<UKFM<>> smoother(X_init, P_init);
+  RauchTungStriebelSmoother<SRUKFM<>> sqrt_smoother(X_init, P_init);
+
+  run(smoother, sqrt_smoother, false, 1e-8);
+
+  const auto& Xs = smoother.smooth();
+  const auto& Xs_sqrt = sqrt_smoother.smooth();
+
+  ASSERT_EQ(Xs.size(), Xs_sqrt.size());
+  for (std::size_t k = 0; k < Xs.size(); ++k) {
+    EXPECT_MANIF_NEAR(Xs[k], Xs_sqrt[k], 1e-8);
+    EXPECT_EIGEN_NEAR(
+      smoother.getCovariances()[k], sqrt_smoother.getCovariances()[k], 1e-8
+    );
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,197 @@
+/**
+ * \file gtest_stacked_update.cpp
+ *
+ * Check that a stacked update over a range of measurements
+ * is equivalent to successive updates, one per measurement.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <array>
+#include <vector>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+using SEKF = SquareRootExtendedKalmanFilter<State>;
+using IEKF = InvariantExtendedKalmanFilter<State>;
+
+template <typename Filter>
+class TEST_STACKED_UPDATE : public testing::Test {
+protected:
+
+  void SetUp() override {
+    const State X_true(0.1, -0.2, 0.05);
+
+    for (std::size_t i = 0; i < measurements.size(); ++i) {
+      measurements[i] = measurement_models[i](X_true) +
+        Measurement(0.01 * double(i), -0.02);
+    }
+
+    X_init = State(0.15, -0.1, 0.);
+    P_init = StateCovariance::Identity() * 0.1;
+  }
+
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+
+  std::array<MeasurementModel, 3> measurement_models = {
+    MeasurementModel(Landmark(2.0,  0.0), R),
+    MeasurementModel(Landmark(2.0,  1.0), R),
+    MeasurementModel(Landmark(2.0, -1.0), R)
+  };
+  std::array<Measurement, 3> measurements;
+
+  State X_init;
+  StateCovariance P_init;
+};
+
+using Filters = testing::Types<EKF, SEKF, IEKF>;
+TYPED_TEST_SUITE(TEST_STACKED_UPDATE, Filters);
+
+TYPED_TEST(TEST_STACKED_UPDATE, TEST_STATIC_VS_DYNAMIC)
+{
+  TypeParam filter_static(this->X_init, this->P_init);
+  TypeParam filter_dynamic(this->X_init, this->P_init);
+
+  const std::vector<MeasurementModel> models(
+    this->measurement_models.begin(), this->measurement_models.end()
+  );
+  const std::vector<Measurement> measurements(
+    this->measurements.begin(), this->measurements.end()
+  );
+
+  filter_static.update(this->measurement_models, this->measurements);
+  filter_dynamic.update(models, measurements);
+
+  EXPECT_MANIF_NEAR(filter_static.getState(), filter_dynamic.getState());
+  EXPECT_EIGEN_NEAR(
+    filter_static.getCovariance(), filter_dynamic.getCovariance()
+  );
+}
+
+TYPED_TEST(TEST_STACKED_UPDATE, TEST_STACKED_VS_SEQUENTIAL)
+{
+  TypeParam filter_stacked(this->X_init, this->P_init);
+  TypeParam filter_sequential(this->X_init, this->P_init);
+
+  filter_stacked.update(this->measurement_models, this->measurements);
+
+  for (std::size_t i = 0; i < this->measurements.size(); ++i) {
+    filter_sequential.update(
+      this->measurement_models[i], this->measurements[i]
+    );
+  }
+
+  // The models are non-linear thus both differ
+  // only by the relinearization point
+  EXPECT_MANIF_NEAR(
+    filter_stacked.getState(), filter_sequential.getState(), 1e-2
+  );
+  EXPECT_EIGEN_NEAR(
+    filter_stacked.getCovariance(), filter_sequential.getCovariance(), 1e-3
+  );
+}
+
+TYPED_TEST(TEST_STACKED_UPDATE, TEST_LARGE_RANGE)
+{
+  TypeParam filter_stacked(this->X_init, this->P_init);
+  TypeParam filter_chunked(this->X_init, this->P_init);
+
+  // More than KALMANIF_MAX_STACKED_MEASUREMENTS measurements
+  // are processed in successive stacks
+  std::vector<MeasurementModel> models;
+  std::vector<Measurement> measurements;
+  for (int i = 0; i < KALMANIF_MAX_STACKED_MEASUREMENTS + 3; ++i) {
+    models.push_back(this->measurement_models[i % 3]);
+    measurements.push_back(this->measurements[i % 3]);
+  }
+
+  filter_stacked.update(models, measurements);
+
+  filter_chunked.update(
+    std::vector<MeasurementModel>(
+      models.begin(), models.begin() + KALMANIF_MAX_STACKED_MEASUREMENTS
+    ),
+    std::vector<Measurement>(
+      measurements.begin(),
+      measurements.begin() + KALMANIF_MAX_STACKED_MEASUREMENTS
+    )
+  );
+  filter_chunked.update(
+    std::vector<MeasurementModel>(
+      models.begin() + KALMANIF_MAX_STACKED_MEASUREMENTS, models.end()
+    ),
+    std::vector<Measurement>(
+      measurements.begin() + KALMANIF_MAX_STACKED_MEASUREMENTS,
+      measurements.end()
+    )
+  );
+
+  EXPECT_MANIF_NEAR(filter_stacked.getState(), filter_chunked.getState());
+  EXPECT_EIGEN_NEAR(
+    filter_stacked.getCovariance(), filter_chunked.getCovariance()
+  );
+}
+
+TYPED_TEST(TEST_STACKED_UPDATE, TEST_SIZE_MISMATCH)
+{
+  TypeParam filter(this->X_init, this->P_init);
+
+  const std::vector<Measurement> measurements(2);
+
+  EXPECT_THROW(
+    filter.update(this->measurement_models, measurements),
+    kalmanif::invalid_argument
+  );
+}
+
+TEST(TEST_SQUARE_ROOT_UPDATE, TEST_SEKF_VS_EKF)
+{
+  // The SEKF updates the covariance square root only,
+  // it must agree with the EKF Joseph form
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+
+  const std::array<MeasurementModel, 2> measurement_models = {
+    MeasurementModel(Landmark(2.0, 1.0), R),
+    MeasurementModel(Landmark(1.0, -2.0), R)
+  };
+  const std::array<Measurement, 2> measurements = {
+    Measurement(0.8, 1.3), Measurement(1.1, -1.8)
+  };
+
+  const State X_init(0.15, -0.1, 0.1);
+  const StateCovariance P_init = (StateCovariance() << 0.1,  0.02, 0.01,
+                                                       0.02, 0.2,  0.03,
+                                                       0.01, 0.03, 0.05).finished();
+
+  EKF ekf(X_init, P_init);
+  SEKF sekf(X_init, P_init);
+
+  ekf.update(measurement_models[0], measurements[0]);
+  sekf.update(measurement_models[0], measurements[0]);
+
+  EXPECT_MANIF_NEAR(ekf.getState(), sekf.getState());
+  EXPECT_EIGEN_NEAR(ekf.getCovariance(), sekf.getCovariance());
+
+  ekf.update(measurement_models, measurements);
+  sekf.update(measurement_models, measurements);
+
+  EXPECT_MANIF_NEAR(ekf.getState(), sekf.getState());
+  EXPECT_EIGEN_NEAR(ekf.getCovariance(), sekf.getCovariance());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
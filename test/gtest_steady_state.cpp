@@ -0,0 +1,156 @@
+/**
+ * \file gtest_steady_state.cpp
+ *
+ * Check that the IEKF steady-state gains match the full filter,
+ * and that it falls back to it when the configuration changes.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using LandmarkModel = Landmark2DMeasurementModel<State>;
+using Landmark = LandmarkModel::Landmark;
+using GPSModel = DummyGPSMeasurementModel<State>;
+using Measurement = GPSModel::Measurement;
+
+using IEKF = InvariantExtendedKalmanFilter<State, Invariance::Left>;
+
+class TEST_STEADY_STATE_F : public testing::Test
+{
+public:
+
+  // With a constant control, the left invariant jacobians are constant,
+  // so are the GPS invariant jacobian and, R being isotropic, its noise.
+  TEST_STEADY_STATE_F()
+    : system_model(StateCovariance::Identity() * 1e-3)
+    , R(Eigen::Matrix2d::Identity() * 1e-2)
+    , gps_model(R)
+    , landmark_model(Landmark(2.0, 1.0), R)
+    , X_init(0.05, -0.05, 0.02)
+    , P_init(StateCovariance::Identity() * 1e-2)
+    , full(X_init, P_init)
+    , steady(X_init, P_init)
+  {
+    steady.setSteadyStateGain(true, 1e-6);
+  }
+
+  /**
+   * Propagate both filters and update them with two GPS fixes.
+   * @return Whether the steady filter replayed its gains
+   */
+  bool step(const Control& u, const int k)
+  {
+    X = X + u;
+    full.propagate(system_model, u);
+    steady.propagate(system_model, u);
+
+    const Measurement y = gps_model(X) + Measurement(-0.02, 0.01) * (k % 3);
+    for (int i = 0; i < 2; ++i) {
+      full.update(gps_model, y);
+      steady.update(gps_model, y);
+    }
+
+    EXPECT_MANIF_NEAR(full.getState(), steady.getState(), 1e-6);
+    EXPECT_EIGEN_NEAR(full.getCovariance(), steady.getCovariance(), 1e-6);
+
+    return steady.isSteadyState();
+  }
+
+  SystemModel system_model;
+  Eigen::Matrix2d R;
+  GPSModel gps_model;
+  LandmarkModel landmark_model;
+
+  State X_init;
+  StateCovariance P_init;
+
+  State X = X_init;
+
+  IEKF full, steady;
+};
+
+TEST_F(TEST_STEADY_STATE_F, TEST_CONVERGENCE)
+{
+  EXPECT_FALSE(full.isSteadyStateGain());
+  EXPECT_TRUE(steady.isSteadyStateGain());
+
+  const Control u(0.1, 0.0, 0.05);
+
+  int k = 0;
+  while (k < 200 && !step(u, k)) {
+    ++k;
+  }
+  ASSERT_LT(k, 200);
+
+  // the gains remain frozen
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_TRUE(step(u, ++k));
+  }
+
+  EXPECT_NEAR(
+    full.getNormalizedInnovationSquared(),
+    steady.getNormalizedInnovationSquared(),
+    1e-6
+  );
+}
+
+TEST_F(TEST_STEADY_STATE_F, TEST_FALLBACK)
+{
+  const Control u(0.1, 0.0, 0.05);
+
+  int k = 0;
+  while (k < 200 && !step(u, k)) {
+    ++k;
+  }
+  ASSERT_TRUE(steady.isSteadyState());
+
+  // a new control changes the propagation jacobians
+  const Control u_new(0.2, 0.05, -0.05);
+  EXPECT_FALSE(step(u_new, ++k));
+
+  // and a new steady state is reached
+  int n = 0;
+  while (n < 200 && !step(u_new, ++k)) {
+    ++n;
+  }
+  ASSERT_TRUE(steady.isSteadyState());
+
+  // an update by a right invariant model depends on the state
+  full.update(landmark_model, landmark_model(X));
+  steady.update(landmark_model, landmark_model(X));
+  EXPECT_FALSE(steady.isSteadyState());
+
+  n = 0;
+  while (n < 200 && !step(u_new, ++k)) {
+    ++n;
+  }
+  ASSERT_TRUE(steady.isSteadyState());
+
+  // setting the covariance discards it
+  full.setCovariance(P_init);
+  steady.setCovariance(P_init);
+  EXPECT_FALSE(steady.isSteadyState());
+  EXPECT_FALSE(step(u_new, ++k));
+}
+
+TEST_F(TEST_STEADY_STATE_F, TEST_INVALID_TOLERANCE)
+{
+  EXPECT_THROW(
+    steady.setSteadyStateGain(true, -1.), kalmanif::invalid_argument
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,139 @@
+/**
+ * \file gtest_trajectory_log.cpp
+ *
+ * Check the streaming trajectory log writer and its memory-mapped reader.
+ */
+
+#include <kalmanif/kalmanif.h>
+#include <kalmanif/io/trajectory_log.h>
+
+#include <manif/SE2.h>
+#include <manif/SE3.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+using MeasurementModel = Landmark2DMeasurementModel<State>;
+using Landmark = MeasurementModel::Landmark;
+using Measurement = MeasurementModel::Measurement;
+
+using EKF = ExtendedKalmanFilter<State>;
+
+class TEST_TRAJECTORY_LOG : public testing::Test {
+protected:
+
+  void step(EKF& ekf, const int k) {
+    X_simulation = X_simulation + u;
+    ekf.propagate(system_model, u);
+    ekf.update(
+      measurement_model,
+      measurement_model(X_simulation) + Measurement(0.01, -0.02) * (k % 3)
+    );
+  }
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Eigen::Matrix2d R = Eigen::Vector2d(1e-2, 2e-2).asDiagonal();
+  MeasurementModel measurement_model{Landmark(2.0, 1.0), R};
+  Control u = Control(0.1, 0.0, 0.05);
+
+  State X_simulation = State::Identity();
+
+  std::string path = testing::TempDir() + "kalmanif_trajectory.log";
+};
+
+TEST_F(TEST_TRAJECTORY_LOG, TEST_WRITE_READ)
+{
+  constexpr int steps = 200;
+
+  EKF ekf(State(0.05, -0.05, 0.02), StateCovariance::Identity() * 0.1);
+
+  std::vector<State, Eigen::aligned_allocator<State>> Xs;
+  std::vector<StateCovariance, Eigen::aligned_allocator<StateCovariance>> Ps;
+
+  {
+    TrajectoryLogWriter<State> writer(path, 16);
+    for (int k = 0; k < steps; ++k) {
+      step(ekf, k);
+      writer.write(0.1 * k, ekf);
+      Xs.push_back(ekf.getState());
+      Ps.push_back(ekf.getCovariance());
+    }
+    EXPECT_EQ(std::size_t(steps), writer.size());
+  }
+
+  TrajectoryLogReader<State> reader(path);
+
+  ASSERT_EQ(std::size_t(steps), reader.size());
+
+  for (int k = 0; k < steps; ++k) {
+    EXPECT_EQ(0.1 * k, reader.time(k));
+
+    // Same binary representation
+    const auto record = reader[k];
+    EXPECT_TRUE(Xs[k].coeffs() == record.state.coeffs());
+    EXPECT_TRUE(Xs[k].coeffs() == reader.state(k).coeffs());
+    // Symmetrized from the upper triangle
+    EXPECT_EIGEN_NEAR(Ps[k], record.covariance, 1e-12);
+  }
+
+  EXPECT_THROW(reader.at(steps), kalmanif::invalid_argument);
+}
+
+TEST_F(TEST_TRAJECTORY_LOG, TEST_READ_IN_PROGRESS)
+{
+  EKF ekf(State::Identity(), StateCovariance::Identity() * 0.1);
+
+  TrajectoryLogWriter<State> writer(path, 8);
+  TrajectoryLogReader<State> reader(path);
+
+  EXPECT_TRUE(reader.empty());
+
+  for (int k = 0; k < 5; ++k) {
+    step(ekf, k);
+    writer.write(k, ekf);
+  }
+
+  // Still buffered
+  EXPECT_EQ(0u, reader.refresh());
+
+  writer.flush();
+  EXPECT_EQ(5u, reader.refresh());
+
+  for (int k = 5; k < 20; ++k) {
+    step(ekf, k);
+    writer.write(k, ekf);
+  }
+
+  // The buffer was written once full
+  EXPECT_EQ(13u, reader.refresh());
+
+  writer.flush();
+  EXPECT_EQ(20u, reader.refresh());
+  EXPECT_EQ(19., reader.time(19));
+  EXPECT_TRUE(ekf.getState().coeffs() == reader.state(19).coeffs());
+}
+
+TEST_F(TEST_TRAJECTORY_LOG, TEST_WRONG_STATE)
+{
+  {
+    TrajectoryLogWriter<State> writer(path);
+    writer.write(0, State::Identity(), StateCovariance::Identity());
+  }
+
+  EXPECT_THROW(TrajectoryLogReader<SE3d>{path}, kalmanif::runtime_error);
+  EXPECT_THROW(TrajectoryLogReader<SE2f>{path}, kalmanif::runtime_error);
+  EXPECT_THROW(
+    TrajectoryLogReader<State>{path + ".missing"}, kalmanif::runtime_error
+  );
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,127 @@
+/**
+ * \file gtest_validation.cpp
+ *
+ * Check the runtime validation levels of the covariance
+ * and the sampled validation of the filters.
+ */
+
+#include <kalmanif/kalmanif.h>
+
+#include <manif/SE2.h>
+#include <manif/gtest/gtest_manif_utils.h>
+
+#include <limits>
+
+using namespace kalmanif;
+using namespace manif;
+
+using State = SE2d;
+using StateCovariance = Covariance<State>;
+using SystemModel = LieSystemModel<State>;
+using Control = SystemModel::Control;
+
+TEST(TEST_VALIDATION, TEST_IS_COVARIANCE_LEVELS)
+{
+  const StateCovariance P = (StateCovariance() << 0.1,  0.02, 0.01,
+                                                  0.02, 0.2,  0.03,
+                                                  0.01, 0.03, 0.05).finished();
+
+  EXPECT_TRUE(isCovariance(P, Validation::None));
+  EXPECT_TRUE(isCovariance(P, Validation::Cheap));
+  EXPECT_TRUE(isCovariance(P, Validation::Full));
+
+  StateCovariance P_non_symmetric = P;
+  P_non_symmetric(0, 1) += 0.01;
+
+  EXPECT_TRUE(isCovariance(P_non_symmetric, Validation::None));
+  EXPECT_FALSE(isCovariance(P_non_symmetric, Validation::Cheap));
+  EXPECT_FALSE(isCovariance(P_non_symmetric, Validation::Full));
+
+  const StateCovariance P_indefinite = Eigen::Vector3d(0.1, -0.1, 0.1).asDiagonal();
+
+  EXPECT_TRUE(isCovariance(P_indefinite, Validation::None));
+  EXPECT_FALSE(isCovariance(P_indefinite, Validation::Cheap));
+  EXPECT_FALSE(isCovariance(P_indefinite, Validation::Full));
+
+  StateCovariance P_nan = P;
+  P_nan(2, 2) = std::numeric_limits<double>::quiet_NaN();
+
+  EXPECT_TRUE(isCovariance(P_nan, Validation::None));
+  EXPECT_FALSE(isCovariance(P_nan, Validation::Cheap));
+
+  // The cheap validation only checks the decomposition,
+  // it accepts eigenvalues below the tolerance
+  const StateCovariance P_tiny = Eigen::Vector3d(0.1, 1e-10, 0.1).asDiagonal();
+
+  EXPECT_TRUE(isCovariance(P_tiny, Validation::Cheap));
+  EXPECT_FALSE(isCovariance(P_tiny, Validation::Full));
+}
+
+template <typename Filter>
+class TEST_FILTER_VALIDATION : public testing::Test {
+protected:
+
+  void SetUp() override {
+    P_nan = StateCovariance::Identity() * 0.1;
+    P_nan(2, 2) = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  SystemModel system_model{StateCovariance::Identity() * 1e-3};
+  Control u = Control(0.1, 0.0, 0.05);
+
+  State X_init = State(0.15, -0.1, 0.1);
+  StateCovariance P_nan;
+};
+
+using Filters = testing::Types<
+  ExtendedKalmanFilter<State>, SquareRootExtendedKalmanFilter<State>
+>;
+TYPED_TEST_SUITE(TEST_FILTER_VALIDATION, Filters);
+
+TYPED_TEST(TEST_FILTER_VALIDATION, TEST_LEVELS)
+{
+  TypeParam filter(this->X_init, StateCovariance::Identity() * 0.1);
+
+  filter.setValidation(Validation::Full);
+  EXPECT_EQ(Validation::Full, filter.getValidation());
+  EXPECT_EQ(1u, filter.getValidationPeriod());
+  EXPECT_NO_THROW(filter.propagate(this->system_model, this->u));
+
+  filter.setValidation(Validation::Cheap);
+  EXPECT_NO_THROW(filter.propagate(this->system_model, this->u));
+
+  filter.setCovariance(this->P_nan);
+
+  filter.setValidation(Validation::None);
+  EXPECT_NO_THROW(filter.propagate(this->system_model, this->u));
+
+  filter.setValidation(Validation::Cheap);
+  EXPECT_THROW(
+    filter.propagate(this->system_model, this->u), kalmanif::runtime_error
+  );
+
+  EXPECT_THROW(
+    filter.setValidation(Validation::Cheap, 0), kalmanif::invalid_argument
+  );
+}
+
+TYPED_TEST(TEST_FILTER_VALIDATION, TEST_PERIOD)
+{
+  TypeParam filter(this->X_init, this->P_nan);
+
+  // Validate once every 3 steps
+  filter.setValidation(Validation::Cheap, 3);
+
+  EXPECT_NO_THROW(filter.propagate(this->system_model, this->u));
+  EXPECT_NO_THROW(filter.propagate(this->system_model, this->u));
+  EXPECT_THROW(
+    filter.propagate(this->system_model, this->u), kalmanif::runtime_error
+  );
+  EXPECT_NO_THROW(filter.propagate(this->system_model, this->u));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,192 @@
+#ifndef _KALMANIF_TEST_PERF_RECORDER_H_
+#define _KALMANIF_TEST_PERF_RECORDER_H_
+
+/**
+ * \file perf_recorder.h
+ *
+ * The performance mode of the demo tests, built with KALMANIF_PERF_TEST.
+ *
+ * The demo scenarios then run with a fixed seed, and each filter's
+ * propagations and updates are timed and their heap allocations counted,
+ * see KALMANIF_PERF. Per step, they must not exceed the baselines
+ * recorded for the platform (KALMANIF_PERF_PLATFORM) in the baselines
+ * file (KALMANIF_PERF_BASELINES) by more than a tolerance,
+ * the environment variable KALMANIF_PERF_TOLERANCE (default 0.25)
+ * for the time, none for the allocations.
+ *
+ * With the environment variable KALMANIF_PERF_RECORD set,
+ * the measures are written to the baselines file instead.
+ * A filter without baseline for the platform fails the test,
+ * the gate cannot pass unchecked.
+ *
+ * Otherwise, the macros are no-ops and the demo tests check accuracy only.
+ */
+
+#ifdef KALMANIF_PERF_TEST
+
+#include "allocation_hooks.h"
+#include "../examples/utils/rand.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace kalmanif {
+namespace test {
+
+/**
+ * @brief Accumulate the time and allocations of each filter
+ * over the steps of a scenario, and check them against the baselines.
+ */
+class PerfRecorder {
+
+public:
+
+  struct Measure {
+    double ns = 0;
+    double allocations = 0;
+  };
+
+  explicit PerfRecorder(std::string scenario)
+    : scenario_(std::move(scenario)) {
+    seedThreadGenerator(Seed);
+  }
+
+  /**
+   * @brief Time a call of a filter and count its allocations.
+   */
+  template <typename Function>
+  void measure(const std::string& filter, Function&& f) {
+    startCounting();
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto stop = std::chrono::steady_clock::now();
+    const std::size_t allocations = stopCounting();
+
+    Measure& m = measures_[filter];
+    m.ns += std::chrono::duration<double, std::nano>(stop - start).count();
+    m.allocations += double(allocations);
+  }
+
+  void step() {
+    ++steps_;
+  }
+
+  /**
+   * @brief Check the per-step measures against the baselines,
+   * or record them.
+   */
+  void check() const {
+    ASSERT_LT(0u, steps_);
+
+    std::map<std::string, Measure> per_step;
+    for (const auto& [filter, m] : measures_) {
+      per_step[filter] = {m.ns / steps_, m.allocations / steps_};
+      std::cout << "[ PERF     ] " << key(filter) << ": "
+                << per_step[filter].ns << " ns/step, "
+                << per_step[filter].allocations << " allocations/step\n";
+    }
+
+    if (std::getenv("KALMANIF_PERF_RECORD")) {
+      record(per_step);
+      return;
+    }
+
+    const std::map<std::string, Measure> baselines = read();
+    const double tolerance = std::getenv("KALMANIF_PERF_TOLERANCE") ?
+      std::atof(std::getenv("KALMANIF_PERF_TOLERANCE")) : 0.25;
+
+    for (const auto& [filter, m] : per_step) {
+      const auto it = baselines.find(key(filter));
+      if (it == baselines.end()) {
+        ADD_FAILURE() << "No baseline for " << key(filter)
+                      << ", record them with KALMANIF_PERF_RECORD=1.";
+        continue;
+      }
+      EXPECT_LE(m.ns, it->second.ns * (1 + tolerance)) << key(filter);
+      EXPECT_LE(m.allocations, it->second.allocations) << key(filter);
+    }
+  }
+
+protected:
+
+  static constexpr std::uint64_t Seed = 42;
+
+  std::string key(const std::string& filter) const {
+    return std::string(KALMANIF_PERF_PLATFORM) + " " + scenario_ + " " + filter;
+  }
+
+  //! The baselines, 'platform scenario filter ns allocations' per line
+  static std::map<std::string, Measure> read() {
+    std::map<std::string, Measure> baselines;
+    std::ifstream file(KALMANIF_PERF_BASELINES);
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      std::istringstream fields(line);
+      std::string platform, scenario, filter;
+      Measure m;
+      if (fields >> platform >> scenario >> filter >> m.ns >> m.allocations) {
+        baselines[platform + " " + scenario + " " + filter] = m;
+      }
+    }
+    return baselines;
+  }
+
+  //! Replace the baselines of the platform and scenario
+  void record(const std::map<std::string, Measure>& per_step) const {
+    std::vector<std::string> lines;
+    {
+      std::ifstream file(KALMANIF_PERF_BASELINES);
+      const std::string prefix = key("");
+      std::string line;
+      while (std::getline(file, line)) {
+        if (line.compare(0, prefix.size(), prefix) != 0) {
+          lines.push_back(line);
+        }
+      }
+    }
+
+    std::ofstream file(KALMANIF_PERF_BASELINES);
+    for (const auto& line : lines) {
+      file << line << '\n';
+    }
+    for (const auto& [filter, m] : per_step) {
+      file << key(filter) << ' ' << m.ns << ' ' << m.allocations << '\n';
+    }
+  }
+
+  std::string scenario_;
+  std::map<std::string, Measure> measures_;
+  std::size_t steps_ = 0;
+};
+
+} // namespace test
+} // namespace kalmanif
+
+#define KALMANIF_PERF_SCENARIO(name) \
+  kalmanif::test::PerfRecorder kalmanif_perf_recorder(name)
+#define KALMANIF_PERF(filter, ...) \
+  kalmanif_perf_recorder.measure(#filter, [&] { __VA_ARGS__; })
+#define KALMANIF_PERF_STEP() kalmanif_perf_recorder.step()
+#define KALMANIF_PERF_CHECK() kalmanif_perf_recorder.check()
+
+#else
+
+#define KALMANIF_PERF_SCENARIO(name) static_cast<void>(0)
+#define KALMANIF_PERF(filter, ...) __VA_ARGS__
+#define KALMANIF_PERF_STEP() static_cast<void>(0)
+#define KALMANIF_PERF_CHECK() static_cast<void>(0)
+
+#endif // KALMANIF_PERF_TEST
+
+#endif // _KALMANIF_TEST_PERF_RECORDER_H_